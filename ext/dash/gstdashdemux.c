@@ -384,6 +384,8 @@ static GstFlowReturn gst_dash_demux_stream_seek (GstAdaptiveDemuxStream *
     GstClockTime * final_ts);
 static gboolean gst_dash_demux_stream_has_next_fragment (GstAdaptiveDemuxStream
     * stream);
+static gboolean gst_dash_demux_stream_peek_fragment (GstAdaptiveDemuxStream *
+    stream, guint n, GstAdaptiveDemuxStreamFragment * fragment);
 static GstFlowReturn
 gst_dash_demux_stream_advance_fragment (GstAdaptiveDemuxStream * stream);
 static gboolean
@@ -669,6 +671,8 @@ gst_dash_demux_init (GstDashDemux * demux)
 
   gst_adaptive_demux_set_stream_struct_size (GST_ADAPTIVE_DEMUX_CAST (demux),
       sizeof (GstDashDemuxStream));
+  gst_adaptive_demux_set_stream_peek_fragment_func (GST_ADAPTIVE_DEMUX_CAST
+      (demux), gst_dash_demux_stream_peek_fragment);
 }
 
 static void
@@ -1742,6 +1746,71 @@ gst_dash_demux_stream_has_next_fragment (GstAdaptiveDemuxStream * stream)
       dashstream->active_stream, stream->demux->segment.rate > 0.0);
 }
 
+static gboolean
+gst_dash_demux_stream_peek_fragment (GstAdaptiveDemuxStream * stream, guint n,
+    GstAdaptiveDemuxStreamFragment * fragment)
+{
+  GstDashDemux *dashdemux = GST_DASH_DEMUX_CAST (stream->demux);
+  GstDashDemuxStream *dashstream = (GstDashDemuxStream *) stream;
+  GstActiveStream *active_stream = dashstream->active_stream;
+  GstMediaFragmentInfo info = { 0, };
+  gint segment_index, repeat_index;
+  gboolean ret = TRUE;
+
+  /* subsegments and keyframe trick modes are downloaded in parts of the
+   * current segment instead */
+  if (stream->demux->segment.rate < 0.0
+      || GST_ADAPTIVE_DEMUX_IN_TRICKMODE_KEY_UNITS (dashdemux)
+      || gst_mpd_client_has_isoff_ondemand_profile (dashdemux->client))
+    return FALSE;
+
+  /* the segments of a live stream are only known to be available if they are
+   * listed in the timeline, otherwise they are computed from the time */
+  if (gst_mpd_client_is_live (dashdemux->client)
+      && active_stream->segments == NULL)
+    return FALSE;
+
+  segment_index = active_stream->segment_index;
+  repeat_index = active_stream->segment_repeat_index;
+
+  while (n-- > 0 && ret) {
+    ret = gst_mpd_client_has_next_segment (dashdemux->client, active_stream,
+        TRUE)
+        && gst_mpd_client_advance_segment (dashdemux->client, active_stream,
+        TRUE) == GST_FLOW_OK;
+  }
+
+  if (ret && active_stream->segments && gst_mpd_client_is_live
+      (dashdemux->client)) {
+    GstMediaSegment *segment = g_ptr_array_index (active_stream->segments,
+        active_stream->segment_index);
+
+    /* an open ended repeat runs up to the live edge */
+    ret = segment->repeat >= 0;
+  }
+
+  if (ret)
+    ret = gst_mpd_client_get_next_fragment (dashdemux->client,
+        dashstream->index, &info);
+
+  active_stream->segment_index = segment_index;
+  active_stream->segment_repeat_index = repeat_index;
+
+  if (!ret) {
+    gst_media_fragment_info_clear (&info);
+    return FALSE;
+  }
+
+  fragment->uri = info.uri;
+  info.uri = NULL;
+  fragment->range_start = MAX (info.range_start, dashstream->sidx_base_offset);
+  fragment->range_end = info.range_end;
+  fragment->duration = info.duration;
+  gst_media_fragment_info_clear (&info);
+
+  return TRUE;
+}
+
 /* The goal here is to figure out, once we have pushed a keyframe downstream,
  * what the next ideal keyframe to download is.
  * 
@@ -2387,6 +2456,41 @@ gst_dash_demux_get_manifest_update_interval (GstAdaptiveDemux * demux)
       SLOW_CLOCK_UPDATE_INTERVAL);
 }
 
+/* Puts @stream back to where playback starts: the segment closest to the
+ * current time for live streams, like on startup, the first one otherwise */
+static void
+gst_dash_demux_reset_stream_position (GstDashDemux * dashdemux,
+    GstMpdClient * client, GstActiveStream * stream)
+{
+  GDateTime *now, *start;
+  GTimeSpan diff;
+  gint64 delay = 0;
+
+  stream->segment_index = 0;
+  stream->segment_repeat_index = 0;
+
+  if (!gst_mpd_client_is_live (client)
+      || client->mpd_node->availabilityStartTime == NULL)
+    return;
+
+  if (client->mpd_node->suggestedPresentationDelay != -1)
+    delay = client->mpd_node->suggestedPresentationDelay;
+  else if (dashdemux->default_presentation_delay)
+    delay = gst_mpd_client_parse_default_presentation_delay (client,
+        dashdemux->default_presentation_delay);
+
+  now = gst_dash_demux_get_server_now_utc (dashdemux);
+  start = gst_date_time_to_g_date_time (client->mpd_node->
+      availabilityStartTime);
+  diff = g_date_time_difference (now, start) - delay * 1000;
+  g_date_time_unref (start);
+  g_date_time_unref (now);
+
+  /* past the last segment the stream waits for the next one to appear */
+  gst_mpd_client_stream_seek (client, stream, TRUE, 0,
+      MAX (diff, 0) * GST_USECOND, NULL);
+}
+
 static GstFlowReturn
 gst_dash_demux_update_manifest_data (GstAdaptiveDemux * demux,
     GstBuffer * buffer)
@@ -2410,6 +2514,8 @@ gst_dash_demux_update_manifest_data (GstAdaptiveDemux * demux,
     GList *iter;
     GList *streams_iter;
     GList *streams;
+    GstClockTime *positions;
+    guint i;
 
     /* prepare the new manifest and try to transfer the stream position
      * status from the old manifest client  */
@@ -2441,13 +2547,6 @@ gst_dash_demux_update_manifest_data (GstAdaptiveDemux * demux,
       }
     }
 
-    if (!gst_dash_demux_setup_mpdparser_streams (dashdemux, new_client)) {
-      GST_ERROR_OBJECT (demux, "Failed to setup streams on manifest " "update");
-      gst_mpd_client_free (new_client);
-      gst_buffer_unmap (buffer, &mapinfo);
-      return GST_FLOW_ERROR;
-    }
-
     /* If no pads have been exposed yet, need to use those */
     streams = NULL;
     if (demux->streams == NULL) {
@@ -2458,51 +2557,97 @@ gst_dash_demux_update_manifest_data (GstAdaptiveDemux * demux,
       streams = demux->streams;
     }
 
+    /* remember the position of the streams in the old manifest */
+    positions = g_new (GstClockTime, g_list_length (streams));
+    for (iter = streams, i = 0; iter; iter = g_list_next (iter), i++) {
+      GstDashDemuxStream *demux_stream = iter->data;
+      GstClockTime ts;
+
+      if (gst_mpd_client_get_next_fragment_timestamp (dashdemux->client,
+              demux_stream->index, &ts)
+          || gst_mpd_client_get_last_fragment_timestamp_end (dashdemux->client,
+              demux_stream->index, &ts)) {
+        /* _get_next_fragment_timestamp() returned relative timestamp to
+         * corresponding period start, but _client_stream_seek expects absolute
+         * MPD time. */
+        positions[i] =
+            ts + gst_mpd_parser_get_period_start_time (dashdemux->client);
+      } else {
+        positions[i] = GST_CLOCK_TIME_NONE;
+      }
+    }
+
+    /* Usually only a few segments were added to the end of the timelines
+     * and a few expired at the start, so try to update the existing streams
+     * instead of building all their segment lists again. If that fails the
+     * current client is left as it was and the streams are set up from
+     * scratch on the new one */
+    if (gst_mpd_client_update_active_streams (new_client, dashdemux->client)) {
+      GST_DEBUG_OBJECT (demux, "Updated the existing streams");
+    } else if (!gst_dash_demux_setup_mpdparser_streams (dashdemux, new_client)) {
+      GST_ERROR_OBJECT (demux, "Failed to setup streams on manifest " "update");
+      g_free (positions);
+      gst_mpd_client_free (new_client);
+      gst_buffer_unmap (buffer, &mapinfo);
+      return GST_FLOW_ERROR;
+    }
+
     /* update the streams to play from the next segment */
-    for (iter = streams, streams_iter = new_client->active_streams;
+    for (iter = streams, streams_iter = new_client->active_streams, i = 0;
         iter && streams_iter;
-        iter = g_list_next (iter), streams_iter = g_list_next (streams_iter)) {
+        iter = g_list_next (iter), streams_iter = g_list_next (streams_iter),
+        i++) {
       GstDashDemuxStream *demux_stream = iter->data;
       GstActiveStream *new_stream = streams_iter->data;
       GstClockTime ts;
+      gboolean forward, mapped;
 
       if (!new_stream) {
         GST_DEBUG_OBJECT (demux,
             "Stream of index %d is missing from manifest update",
             demux_stream->index);
+        g_free (positions);
         gst_mpd_client_free (new_client);
         gst_buffer_unmap (buffer, &mapinfo);
         return GST_FLOW_EOS;
       }
 
-      if (gst_mpd_client_get_next_fragment_timestamp (dashdemux->client,
-              demux_stream->index, &ts)
-          || gst_mpd_client_get_last_fragment_timestamp_end (dashdemux->client,
-              demux_stream->index, &ts)) {
-
+      ts = positions[i];
+      if (GST_CLOCK_TIME_IS_VALID (ts)) {
         /* Due to rounding when doing the timescale conversions it might happen
          * that the ts falls back to a previous segment, leading the same data
          * to be downloaded twice. We try to work around this by always adding
          * 10 microseconds to get back to the correct segment. The errors are
          * usually on the order of nanoseconds so it should be enough.
          */
-
-        /* _get_next_fragment_timestamp() returned relative timestamp to
-         * corresponding period start, but _client_stream_seek expects absolute
-         * MPD time. */
-        ts += gst_mpd_parser_get_period_start_time (dashdemux->client);
-
         GST_DEBUG_OBJECT (GST_ADAPTIVE_DEMUX_STREAM_PAD (demux_stream),
             "Current position: %" GST_TIME_FORMAT ", updating to %"
             GST_TIME_FORMAT, GST_TIME_ARGS (ts),
             GST_TIME_ARGS (ts + (10 * GST_USECOND)));
         ts += 10 * GST_USECOND;
-        gst_mpd_client_stream_seek (new_client, new_stream,
-            demux->segment.rate >= 0, 0, ts, NULL);
+
+        /* Failing to seek past the last segment still leaves the stream
+         * there, live streams wait for the next segment to appear */
+        forward = demux->segment.rate >= 0;
+        mapped = gst_mpd_client_stream_seek (new_client, new_stream, forward,
+            0, ts, NULL)
+            || !gst_mpd_client_has_next_segment (new_client, new_stream,
+            forward);
+      } else {
+        mapped = FALSE;
+      }
+
+      /* The segment index of the old timeline means nothing in the new one */
+      if (!mapped) {
+        GST_DEBUG_OBJECT (GST_ADAPTIVE_DEMUX_STREAM_PAD (demux_stream),
+            "Position not in the updated manifest, restarting the stream");
+        gst_dash_demux_reset_stream_position (dashdemux, new_client,
+            new_stream);
       }
 
       demux_stream->active_stream = new_stream;
     }
+    g_free (positions);
 
     gst_mpd_client_free (dashdemux->client);
     dashdemux->client = new_client;
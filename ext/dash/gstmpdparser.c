@@ -3933,6 +3933,163 @@ gst_mpd_client_add_media_segment (GstActiveStream * stream,
   return TRUE;
 }
 
+/* The segment list of a stream from the previous version of a live
+ * manifest, which is resumed instead of being built again when the
+ * SegmentTimeline is updated, see gst_mpd_client_update_active_streams() */
+typedef struct
+{
+  /* the previous segments, and what they were built with */
+  const GPtrArray *known;
+  guint timescale;
+  guint64 presentation_time_offset;
+  GstClockTime period_start;
+
+  /* set by gst_mpdparser_resume_segment_timeline(). The new segment list
+   * then starts with the replacement of the last known segment */
+  gboolean resumed;
+  guint n_expired;              /* known segments that left the timeline */
+  guint n_trimmed;              /* expired repeats of the first one kept */
+  GstClockTime trimmed_start;   /* start of the first one kept, if trimmed */
+} GstMpdTimelineResume;
+
+/* Finds where the segments of @timeline go beyond the known ones. The
+ * entries of a live timeline don't change once published, except for the
+ * repeat count of the last one, so the last known segment is rebuilt from
+ * its S node on and the ones before it are kept.
+ *
+ * Only the S nodes after the last known segment and the ones up to the
+ * closest preceding @t are walked. Returns the S node of the last known
+ * segment, or NULL if the timeline can't be resumed and the segment list
+ * has to be built from scratch */
+static GList *
+gst_mpdparser_resume_segment_timeline (GstSegmentTimelineNode * timeline,
+    GstMpdTimelineResume * resume, GstClockTime presentationTimeOffset)
+{
+  const GstMediaSegment *last, *segment;
+  GstSNode *S;
+  GList *list;
+  guint64 first_start, start, resume_start, end;
+
+  if (resume->known->len == 0 || g_queue_is_empty (&timeline->S))
+    return NULL;
+
+  last = g_ptr_array_index (resume->known, resume->known->len - 1);
+  resume_start = last->scale_start;
+
+  /* look back for a start that is known without walking further */
+  for (list = g_queue_peek_tail_link (&timeline->S); list->prev;
+      list = list->prev) {
+    S = list->data;
+    if (S->t > 0 && S->t <= resume_start)
+      break;
+  }
+
+  S = list->data;
+  if (S->t > resume_start) {
+    GST_DEBUG ("Last known segment expired");
+    return NULL;
+  }
+
+  /* and walk forward to the S node of the last known segment */
+  start = 0;
+  for (; list; list = g_list_next (list)) {
+    S = list->data;
+    if (S->t > 0)
+      start = S->t;
+    if (start >= resume_start || S->r < 0)
+      break;
+    start += S->d * (S->r + 1);
+  }
+  if (list == NULL || start != resume_start) {
+    GST_DEBUG ("Timeline doesn't continue the known segments");
+    return NULL;
+  }
+
+  /* the segments before the first S node expired */
+  S = g_queue_peek_head (&timeline->S);
+  first_start = S->t;
+  resume->n_expired = 0;
+  resume->n_trimmed = 0;
+  for (; resume->n_expired < resume->known->len - 1; resume->n_expired++) {
+    segment = g_ptr_array_index (resume->known, resume->n_expired);
+    if (segment->scale_start >= first_start)
+      break;
+
+    end = segment->scale_start +
+        segment->scale_duration * (MAX (segment->repeat, 0) + 1);
+    if (end > first_start) {
+      /* some repeats of it are still there */
+      if (segment->repeat < 0 || segment->scale_duration == 0
+          || (first_start - segment->scale_start) %
+          segment->scale_duration != 0) {
+        GST_DEBUG ("Timeline starts within a segment");
+        return NULL;
+      }
+      resume->n_trimmed =
+          (first_start - segment->scale_start) / segment->scale_duration;
+      resume->trimmed_start =
+          gst_util_uint64_scale (first_start, GST_SECOND, resume->timescale)
+          + resume->period_start - presentationTimeOffset;
+      break;
+    }
+  }
+
+  resume->resumed = TRUE;
+
+  return list;
+}
+
+/* Clips the segments of @stream to stop at @PeriodEnd */
+static void
+gst_mpd_client_stream_clip_segments (GstActiveStream * stream,
+    GstClockTime PeriodEnd)
+{
+  if (stream->segments == NULL || stream->segments->len == 0)
+    return;
+
+  if (GST_CLOCK_TIME_IS_VALID (PeriodEnd)) {
+    guint n;
+
+    for (n = 0; n < stream->segments->len; ++n) {
+      GstMediaSegment *media_segment = g_ptr_array_index (stream->segments, n);
+      if (media_segment) {
+        if (media_segment->start + media_segment->duration > PeriodEnd) {
+          GstClockTime stop = PeriodEnd;
+          if (n < stream->segments->len - 1) {
+            GstMediaSegment *next_segment =
+                g_ptr_array_index (stream->segments, n + 1);
+            if (next_segment && next_segment->start < PeriodEnd)
+              stop = next_segment->start;
+          }
+          media_segment->duration =
+              media_segment->start > stop ? 0 : stop - media_segment->start;
+          GST_LOG ("Fixed duration of segment %u: %" GST_TIME_FORMAT, n,
+              GST_TIME_ARGS (media_segment->duration));
+
+          /* If the segment was clipped entirely, we discard it and all
+           * subsequent ones */
+          if (media_segment->duration == 0) {
+            GST_WARNING ("Discarding %u segments outside period",
+                stream->segments->len - n);
+            /* _set_size should properly unref elements */
+            g_ptr_array_set_size (stream->segments, n);
+            break;
+          }
+        }
+      }
+    }
+  }
+#ifndef GST_DISABLE_GST_DEBUG
+  if (stream->segments->len > 0) {
+    GstMediaSegment *last_media_segment =
+        g_ptr_array_index (stream->segments, stream->segments->len - 1);
+    GST_LOG ("Built a list of %d segments", last_media_segment->number);
+  } else {
+    GST_LOG ("All media segments were clipped");
+  }
+#endif
+}
+
 static void
 gst_mpd_client_stream_update_presentation_time_offset (GstMpdClient * client,
     GstActiveStream * stream)
@@ -3961,9 +4118,14 @@ gst_mpd_client_stream_update_presentation_time_offset (GstMpdClient * client,
       GST_TIME_ARGS (stream->presentationTimeOffset));
 }
 
-gboolean
-gst_mpd_client_setup_representation (GstMpdClient * client,
-    GstActiveStream * stream, GstRepresentationNode * representation)
+/* If @resume is given and the representation uses a SegmentTimeline with a
+ * SegmentTemplate, the segment list of the stream only gets the segments from
+ * the last known one on, if the timeline continues the known ones. See
+ * gst_mpdparser_resume_segment_timeline() */
+static gboolean
+gst_mpd_client_setup_representation_full (GstMpdClient * client,
+    GstActiveStream * stream, GstRepresentationNode * representation,
+    GstMpdTimelineResume * resume)
 {
   GstStreamPeriod *stream_period;
   GList *rep_list;
@@ -4145,11 +4307,32 @@ gst_mpd_client_setup_representation (GstMpdClient * client,
         GstSegmentTimelineNode *timeline;
         GstSNode *S;
         GList *list;
+        GstMediaSegment run = { NULL, 0, -1, 0, 0, 0, 0 };
+        gboolean have_run = FALSE;
 
         timeline = mult_seg->SegmentTimeline;
         gst_mpdparser_init_active_stream_segments (stream);
-        for (list = g_queue_peek_head_link (&timeline->S); list;
-            list = g_list_next (list)) {
+
+        list = NULL;
+        if (resume && resume->timescale == mult_seg->SegBaseType->timescale
+            && resume->presentation_time_offset ==
+            mult_seg->SegBaseType->presentationTimeOffset
+            && resume->period_start == PeriodStart) {
+          list = gst_mpdparser_resume_segment_timeline (timeline, resume,
+              presentationTimeOffset);
+        }
+        if (list) {
+          const GstMediaSegment *last = g_ptr_array_index (resume->known,
+              resume->known->len - 1);
+
+          i = last->number;
+          start = last->scale_start;
+          start_time = last->start;
+        } else {
+          list = g_queue_peek_head_link (&timeline->S);
+        }
+
+        for (; list; list = g_list_next (list)) {
           guint timescale;
 
           S = (GstSNode *) list->data;
@@ -4163,14 +4346,40 @@ gst_mpd_client_setup_representation (GstMpdClient * client,
                 + PeriodStart - presentationTimeOffset;
           }
 
-          if (!gst_mpd_client_add_media_segment (stream, NULL, i, S->r, start,
-                  S->d, start_time, duration)) {
-            return FALSE;
+          /* Many packagers write one S per segment instead of using @r.
+           * Contiguous S of the same duration are folded into a single run
+           * so that the list only grows with the number of duration
+           * changes, unless the run would then cross the period end and
+           * escape the clipping below */
+          if (have_run && run.repeat >= 0 && S->r >= 0
+              && S->d == run.scale_duration
+              && start == run.scale_start + run.scale_duration * (run.repeat +
+                  1) && (!GST_CLOCK_TIME_IS_VALID (PeriodEnd)
+                  || start_time + duration * (S->r + 1) <= PeriodEnd)) {
+            run.repeat += S->r + 1;
+          } else {
+            if (have_run && !gst_mpd_client_add_media_segment (stream, NULL,
+                    run.number, run.repeat, run.scale_start,
+                    run.scale_duration, run.start, run.duration)) {
+              return FALSE;
+            }
+            run.number = i;
+            run.repeat = S->r;
+            run.scale_start = start;
+            run.scale_duration = S->d;
+            run.start = start_time;
+            run.duration = duration;
+            have_run = TRUE;
           }
           i += S->r + 1;
           start += S->d * (S->r + 1);
           start_time += duration * (S->r + 1);
         }
+        if (have_run && !gst_mpd_client_add_media_segment (stream, NULL,
+                run.number, run.repeat, run.scale_start, run.scale_duration,
+                run.start, run.duration)) {
+          return FALSE;
+        }
       } else {
         /* NOP - The segment is created on demand with the template, no need
          * to build a list */
@@ -4178,51 +4387,10 @@ gst_mpd_client_setup_representation (GstMpdClient * client,
     }
   }
 
-  /* clip duration of segments to stop at period end */
-  if (stream->segments && stream->segments->len) {
-    if (GST_CLOCK_TIME_IS_VALID (PeriodEnd)) {
-      guint n;
-
-      for (n = 0; n < stream->segments->len; ++n) {
-        GstMediaSegment *media_segment =
-            g_ptr_array_index (stream->segments, n);
-        if (media_segment) {
-          if (media_segment->start + media_segment->duration > PeriodEnd) {
-            GstClockTime stop = PeriodEnd;
-            if (n < stream->segments->len - 1) {
-              GstMediaSegment *next_segment =
-                  g_ptr_array_index (stream->segments, n + 1);
-              if (next_segment && next_segment->start < PeriodEnd)
-                stop = next_segment->start;
-            }
-            media_segment->duration =
-                media_segment->start > stop ? 0 : stop - media_segment->start;
-            GST_LOG ("Fixed duration of segment %u: %" GST_TIME_FORMAT, n,
-                GST_TIME_ARGS (media_segment->duration));
-
-            /* If the segment was clipped entirely, we discard it and all
-             * subsequent ones */
-            if (media_segment->duration == 0) {
-              GST_WARNING ("Discarding %u segments outside period",
-                  stream->segments->len - n);
-              /* _set_size should properly unref elements */
-              g_ptr_array_set_size (stream->segments, n);
-              break;
-            }
-          }
-        }
-      }
-    }
-#ifndef GST_DISABLE_GST_DEBUG
-    if (stream->segments->len > 0) {
-      GstMediaSegment *last_media_segment =
-          g_ptr_array_index (stream->segments, stream->segments->len - 1);
-      GST_LOG ("Built a list of %d segments", last_media_segment->number);
-    } else {
-      GST_LOG ("All media segments were clipped");
-    }
-#endif
-  }
+  /* clip duration of segments to stop at period end. A resumed list is
+   * only complete once it was merged with the known segments */
+  if (resume == NULL || !resume->resumed)
+    gst_mpd_client_stream_clip_segments (stream, PeriodEnd);
 
   g_free (stream->baseURL);
   g_free (stream->queryURL);
@@ -4234,6 +4402,14 @@ gst_mpd_client_setup_representation (GstMpdClient * client,
   return TRUE;
 }
 
+gboolean
+gst_mpd_client_setup_representation (GstMpdClient * client,
+    GstActiveStream * stream, GstRepresentationNode * representation)
+{
+  return gst_mpd_client_setup_representation_full (client, stream,
+      representation, NULL);
+}
+
 #define CUSTOM_WRAPPER_START "<custom_wrapper>"
 #define CUSTOM_WRAPPER_END "</custom_wrapper>"
 
@@ -4825,6 +5001,215 @@ gst_mpd_client_setup_streaming (GstMpdClient * client,
   return TRUE;
 }
 
+static GstRepresentationNode *
+gst_mpdparser_get_representation_with_id (GList * Representations,
+    const gchar * id)
+{
+  GList *list;
+
+  if (id == NULL)
+    return NULL;
+
+  for (list = Representations; list; list = g_list_next (list)) {
+    GstRepresentationNode *representation = list->data;
+
+    if (g_strcmp0 (representation->id, id) == 0)
+      return representation;
+  }
+
+  return NULL;
+}
+
+/* Merges the segments built from where the known ones of @resume end into
+ * @known_segments, which is consumed. Returns the complete segment list */
+static GPtrArray *
+gst_mpd_client_merge_resumed_segments (GPtrArray * known_segments,
+    GPtrArray * segments, GstMpdTimelineResume * resume)
+{
+  GstMediaSegment *segment;
+  guint n;
+
+  if (resume->n_expired > 0)
+    g_ptr_array_remove_range (known_segments, 0, resume->n_expired);
+
+  if (resume->n_trimmed > 0) {
+    segment = g_ptr_array_index (known_segments, 0);
+    segment->number += resume->n_trimmed;
+    segment->repeat -= resume->n_trimmed;
+    segment->scale_start += resume->n_trimmed * segment->scale_duration;
+    segment->start = resume->trimmed_start;
+  }
+
+  /* the first new segment replaces the last known one */
+  segment = g_ptr_array_index (known_segments, known_segments->len - 1);
+  *segment = *(GstMediaSegment *) g_ptr_array_index (segments, 0);
+  g_ptr_array_remove_index (segments, 0);
+
+  for (n = 0; n < segments->len; n++)
+    g_ptr_array_add (known_segments, g_ptr_array_index (segments, n));
+  g_ptr_array_set_free_func (segments, NULL);
+  g_ptr_array_unref (segments);
+
+  GST_DEBUG ("Updated segment list: %u expired, %u new, %u segments in total",
+      resume->n_expired, n, known_segments->len);
+
+  return known_segments;
+}
+
+/**
+ * gst_mpd_client_update_active_streams:
+ * @client: the #GstMpdClient of an updated manifest, with the period set
+ * @old_client: the #GstMpdClient of the previous version of the manifest
+ *
+ * Moves the active streams of @old_client to the corresponding adaptation
+ * sets of @client. Each stream keeps its current representation, found by
+ * id, and its position.
+ *
+ * Segment lists built from a SegmentTimeline are resumed: expired segments
+ * are dropped, the known ones are kept and only the S nodes from the last
+ * known segment on are turned into segments. Only these S nodes are walked,
+ * and the ones before them back to the closest @t. @client is still parsed
+ * from the whole manifest, but with timelines that give the @t of their S
+ * nodes, updating a segment list scales with the number of new and expired
+ * segments instead of the length of the timeline.
+ *
+ * All streams are set up for @client before any of them is modified.
+ *
+ * Returns: %FALSE if the adaptation sets or representations of the two
+ * manifests don't match, or if a stream failed to be set up. @old_client is
+ * left untouched then, and the streams have to be set up again from scratch
+ * on @client.
+ */
+gboolean
+gst_mpd_client_update_active_streams (GstMpdClient * client,
+    GstMpdClient * old_client)
+{
+  GList *adapt_sets, *a, *s;
+  GstActiveStream **updates;
+  GstMpdTimelineResume *resumes;
+  GstStreamPeriod *stream_period, *old_stream_period;
+  GstClockTime period_end;
+  gboolean ret = FALSE;
+  guint n_streams, i;
+
+  g_return_val_if_fail (client != NULL, FALSE);
+  g_return_val_if_fail (old_client != NULL, FALSE);
+  g_return_val_if_fail (client->active_streams == NULL, FALSE);
+
+  n_streams = g_list_length (old_client->active_streams);
+  adapt_sets = gst_mpd_client_get_adaptation_sets (client);
+  if (adapt_sets == NULL || g_list_length (adapt_sets) != n_streams) {
+    GST_DEBUG ("Number of adaptation sets changed");
+    return FALSE;
+  }
+
+  stream_period = gst_mpdparser_get_stream_period (client);
+  old_stream_period = gst_mpdparser_get_stream_period (old_client);
+  g_return_val_if_fail (stream_period != NULL, FALSE);
+  g_return_val_if_fail (old_stream_period != NULL, FALSE);
+  if (GST_CLOCK_TIME_IS_VALID (stream_period->duration))
+    period_end = stream_period->start + stream_period->duration;
+  else
+    period_end = GST_CLOCK_TIME_NONE;
+
+  /* set up every stream for the new manifest on a copy first, so that
+   * nothing has to be undone if one of them fails */
+  updates = g_new0 (GstActiveStream *, n_streams);
+  resumes = g_new0 (GstMpdTimelineResume, n_streams);
+  for (a = adapt_sets, s = old_client->active_streams, i = 0; a && s;
+      a = g_list_next (a), s = g_list_next (s), i++) {
+    GstAdaptationSetNode *adapt_set = a->data;
+    GstActiveStream *stream = s->data;
+    GstRepresentationNode *representation = NULL;
+    GstMpdTimelineResume *resume = NULL;
+    GstActiveStream *update;
+
+    if (stream->cur_representation)
+      representation =
+          gst_mpdparser_get_representation_with_id
+          (adapt_set->Representations, stream->cur_representation->id);
+    if (representation == NULL
+        || gst_mpdparser_representation_get_mimetype (adapt_set,
+            representation) != stream->mimeType) {
+      GST_DEBUG ("Representation of stream %p not found in the update",
+          stream);
+      goto done;
+    }
+
+    if (stream->segments && stream->cur_seg_template
+        && stream->cur_seg_template->MultSegBaseType
+        && stream->cur_seg_template->MultSegBaseType->SegmentTimeline) {
+      GstSegmentBaseType *segbase =
+          stream->cur_seg_template->MultSegBaseType->SegBaseType;
+
+      resume = &resumes[i];
+      resume->known = stream->segments;
+      resume->timescale = segbase->timescale;
+      resume->presentation_time_offset = segbase->presentationTimeOffset;
+      resume->period_start = old_stream_period->start;
+    }
+
+    update = updates[i] = g_slice_new0 (GstActiveStream);
+    update->mimeType = stream->mimeType;
+    update->baseURL_idx = stream->baseURL_idx;
+    update->max_bandwidth = stream->max_bandwidth;
+    update->cur_adapt_set = adapt_set;
+
+    if (!gst_mpd_client_setup_representation_full (client, update,
+            representation, resume)) {
+      GST_WARNING ("Failed to update the representation of stream %p",
+          stream);
+      goto done;
+    }
+  }
+
+  /* then move the streams over, this can't fail anymore */
+  for (i = 0; i < n_streams; i++) {
+    GstActiveStream *stream = old_client->active_streams->data;
+    GstActiveStream *update = updates[i];
+
+    old_client->active_streams =
+        g_list_delete_link (old_client->active_streams,
+        old_client->active_streams);
+    client->active_streams = g_list_append (client->active_streams, stream);
+
+    if (resumes[i].resumed) {
+      update->segments =
+          gst_mpd_client_merge_resumed_segments (stream->segments,
+          update->segments, &resumes[i]);
+      stream->segments = NULL;
+      gst_mpd_client_stream_clip_segments (update, period_end);
+    }
+
+    g_free (stream->baseURL);
+    g_free (stream->queryURL);
+    if (stream->segments)
+      g_ptr_array_unref (stream->segments);
+
+    stream->cur_adapt_set = update->cur_adapt_set;
+    stream->representation_idx = update->representation_idx;
+    stream->cur_representation = update->cur_representation;
+    stream->cur_segment_base = update->cur_segment_base;
+    stream->cur_segment_list = update->cur_segment_list;
+    stream->cur_seg_template = update->cur_seg_template;
+    stream->segments = update->segments;
+    stream->baseURL = update->baseURL;
+    stream->queryURL = update->queryURL;
+    stream->presentationTimeOffset = update->presentationTimeOffset;
+
+    g_slice_free (GstActiveStream, update);
+    updates[i] = NULL;
+  }
+  ret = TRUE;
+
+done:
+  for (i = 0; i < n_streams; i++)
+    gst_mpdparser_free_active_stream (updates[i]);
+  g_free (updates);
+  g_free (resumes);
+  return ret;
+}
+
 gboolean
 gst_mpd_client_stream_seek (GstMpdClient * client, GstActiveStream * stream,
     gboolean forward, GstSeekFlags flags, GstClockTime ts,
@@ -4837,67 +5222,74 @@ gst_mpd_client_stream_seek (GstMpdClient * client, GstActiveStream * stream,
   g_return_val_if_fail (stream != NULL, 0);
 
   if (stream->segments) {
-    for (index = 0; index < stream->segments->len; index++) {
-      gboolean in_segment = FALSE;
-      GstMediaSegment *segment = g_ptr_array_index (stream->segments, index);
-      GstClockTime end_time;
+    guint lo = 0, hi = stream->segments->len;
 
-      GST_DEBUG ("Looking at fragment sequence chunk %d / %d", index,
-          stream->segments->len);
+    /* binary search for the first run of segments that ends after ts */
+    while (lo < hi) {
+      guint mid = lo + (hi - lo) / 2;
+      GstMediaSegment *segment = g_ptr_array_index (stream->segments, mid);
+      GstClockTime end_time;
 
       end_time =
           gst_mpdparser_get_segment_end_time (client, stream->segments,
-          segment, index);
+          segment, mid);
 
       /* avoid downloading another fragment just for 1ns in reverse mode */
-      if (forward)
-        in_segment = ts < end_time;
+      if (forward ? ts < end_time : ts <= end_time)
+        hi = mid;
       else
-        in_segment = ts <= end_time;
+        lo = mid + 1;
+    }
 
-      if (in_segment) {
-        GstClockTime chunk_time;
+    index = lo;
+    GST_DEBUG ("Found fragment sequence chunk %d / %d", index,
+        stream->segments->len);
 
-        selectedChunk = segment;
-        repeat_index = (ts - segment->start) / segment->duration;
+    if (index < stream->segments->len) {
+      GstMediaSegment *segment = g_ptr_array_index (stream->segments, index);
+      GstClockTime chunk_time;
 
-        chunk_time = segment->start + segment->duration * repeat_index;
+      selectedChunk = segment;
+      /* positions that expired from the timeline start at its first segment */
+      if (ts < segment->start)
+        ts = segment->start;
+      repeat_index = (ts - segment->start) / segment->duration;
 
-        /* At the end of a segment in reverse mode, start from the previous fragment */
-        if (!forward && repeat_index > 0
-            && ((ts - segment->start) % segment->duration == 0))
-          repeat_index--;
+      chunk_time = segment->start + segment->duration * repeat_index;
 
-        if ((flags & GST_SEEK_FLAG_SNAP_NEAREST) == GST_SEEK_FLAG_SNAP_NEAREST) {
-          if (repeat_index + 1 < segment->repeat) {
-            if (ts - chunk_time > chunk_time + segment->duration - ts)
-              repeat_index++;
-          } else if (index + 1 < stream->segments->len) {
-            GstMediaSegment *next_segment =
-                g_ptr_array_index (stream->segments, index + 1);
+      /* At the end of a segment in reverse mode, start from the previous fragment */
+      if (!forward && repeat_index > 0
+          && ((ts - segment->start) % segment->duration == 0))
+        repeat_index--;
 
-            if (ts - chunk_time > next_segment->start - ts) {
-              repeat_index = 0;
-              selectedChunk = next_segment;
-              index++;
-            }
+      if ((flags & GST_SEEK_FLAG_SNAP_NEAREST) == GST_SEEK_FLAG_SNAP_NEAREST) {
+        if (repeat_index < segment->repeat) {
+          if (ts - chunk_time > chunk_time + segment->duration - ts)
+            repeat_index++;
+        } else if (index + 1 < stream->segments->len) {
+          GstMediaSegment *next_segment =
+              g_ptr_array_index (stream->segments, index + 1);
+
+          if (ts - chunk_time > next_segment->start - ts) {
+            repeat_index = 0;
+            selectedChunk = next_segment;
+            index++;
           }
-        } else if (((forward && flags & GST_SEEK_FLAG_SNAP_AFTER) ||
-                (!forward && flags & GST_SEEK_FLAG_SNAP_BEFORE)) &&
-            ts != chunk_time) {
+        }
+      } else if (((forward && flags & GST_SEEK_FLAG_SNAP_AFTER) ||
+              (!forward && flags & GST_SEEK_FLAG_SNAP_BEFORE)) &&
+          ts != chunk_time) {
 
-          if (repeat_index + 1 < segment->repeat) {
-            repeat_index++;
+        if (repeat_index < segment->repeat) {
+          repeat_index++;
+        } else {
+          repeat_index = 0;
+          if (index + 1 >= stream->segments->len) {
+            selectedChunk = NULL;
           } else {
-            repeat_index = 0;
-            if (index + 1 >= stream->segments->len) {
-              selectedChunk = NULL;
-            } else {
-              selectedChunk = g_ptr_array_index (stream->segments, ++index);
-            }
+            selectedChunk = g_ptr_array_index (stream->segments, ++index);
           }
         }
-        break;
       }
     }
 
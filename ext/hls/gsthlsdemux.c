@@ -108,6 +108,8 @@ static GstFlowReturn gst_hls_demux_advance_fragment (GstAdaptiveDemuxStream *
     stream);
 static GstFlowReturn gst_hls_demux_update_fragment_info (GstAdaptiveDemuxStream
     * stream);
+static gboolean gst_hls_demux_stream_peek_fragment (GstAdaptiveDemuxStream *
+    stream, guint n, GstAdaptiveDemuxStreamFragment * fragment);
 static gboolean gst_hls_demux_select_bitrate (GstAdaptiveDemuxStream * stream,
     guint64 bitrate);
 static void gst_hls_demux_reset (GstAdaptiveDemux * demux);
@@ -191,6 +193,8 @@ gst_hls_demux_init (GstHLSDemux * demux)
 {
   gst_adaptive_demux_set_stream_struct_size (GST_ADAPTIVE_DEMUX_CAST (demux),
       sizeof (GstHLSDemuxStream));
+  gst_adaptive_demux_set_stream_peek_fragment_func (GST_ADAPTIVE_DEMUX_CAST
+      (demux), gst_hls_demux_stream_peek_fragment);
 
   demux->keys = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
   g_mutex_init (&demux->keys_lock);
@@ -282,7 +286,7 @@ gst_hls_demux_set_current (GstHLSDemux * self, GstM3U8 * m3u8)
   if (m3u8 != self->current) {
     self->current = m3u8;
     self->current->duration = GST_CLOCK_TIME_NONE;
-    self->current->current_file = NULL;
+    self->current->current_file_idx = -1;
 
 #if 0
     // FIXME: this makes no sense after we just set self->current=m3u8 above (tpm)
@@ -402,7 +406,8 @@ gst_hls_demux_stream_seek (GstAdaptiveDemuxStream * stream, gboolean forward,
     GstSeekFlags flags, GstClockTime ts, GstClockTime * final_ts)
 {
   GstHLSDemuxStream *hls_stream = GST_HLS_DEMUX_STREAM_CAST (stream);
-  GList *walk;
+  GPtrArray *files;
+  guint i;
   GstClockTime current_pos;
   gint64 current_sequence;
   gboolean snap_after, snap_nearest;
@@ -419,8 +424,9 @@ gst_hls_demux_stream_seek (GstAdaptiveDemuxStream * stream, gboolean forward,
 
   GST_M3U8_CLIENT_LOCK (hlsdemux->client);
   /* FIXME: Here we need proper discont handling */
-  for (walk = hls_stream->playlist->files; walk; walk = walk->next) {
-    file = walk->data;
+  files = hls_stream->playlist->files;
+  for (i = 0; i < files->len; i++) {
+    file = g_ptr_array_index (files, i);
 
     current_sequence = file->sequence;
     if ((forward && snap_after) || snap_nearest) {
@@ -442,7 +448,7 @@ gst_hls_demux_stream_seek (GstAdaptiveDemuxStream * stream, gboolean forward,
     current_pos += file->duration;
   }
 
-  if (walk == NULL) {
+  if (i == files->len) {
     GST_DEBUG_OBJECT (stream->pad, "seeking further than track duration");
     current_sequence++;
   }
@@ -451,7 +457,7 @@ gst_hls_demux_stream_seek (GstAdaptiveDemuxStream * stream, gboolean forward,
       (guint) current_sequence);
   hls_stream->reset_pts = TRUE;
   hls_stream->playlist->sequence = current_sequence;
-  hls_stream->playlist->current_file = walk;
+  hls_stream->playlist->current_file_idx = i < files->len ? i : -1;
   hls_stream->playlist->sequence_position = current_pos;
   GST_M3U8_CLIENT_UNLOCK (hlsdemux->client);
 
@@ -1147,6 +1153,32 @@ gst_hls_demux_update_fragment_info (GstAdaptiveDemuxStream * stream)
   return GST_FLOW_OK;
 }
 
+static gboolean
+gst_hls_demux_stream_peek_fragment (GstAdaptiveDemuxStream * stream, guint n,
+    GstAdaptiveDemuxStreamFragment * fragment)
+{
+  GstM3U8MediaFile *file;
+  GstM3U8 *m3u8;
+
+  m3u8 = gst_hls_demux_stream_get_m3u8 (GST_HLS_DEMUX_STREAM_CAST (stream));
+
+  file = gst_m3u8_peek_fragment (m3u8, stream->demux->segment.rate > 0, n);
+  if (file == NULL)
+    return FALSE;
+
+  fragment->uri = g_strdup (file->uri);
+  fragment->range_start = file->offset;
+  if (file->size != -1)
+    fragment->range_end = file->offset + file->size - 1;
+  else
+    fragment->range_end = -1;
+  fragment->duration = file->duration;
+
+  gst_m3u8_media_file_unref (file);
+
+  return TRUE;
+}
+
 static gboolean
 gst_hls_demux_select_bitrate (GstAdaptiveDemuxStream * stream, guint64 bitrate)
 {
@@ -1519,9 +1551,10 @@ retry:
 
     GST_M3U8_CLIENT_LOCK (demux->client);
     last_sequence =
-        GST_M3U8_MEDIA_FILE (g_list_last (m3u8->files)->data)->sequence;
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files,
+            m3u8->files->len - 1))->sequence;
     first_sequence =
-        GST_M3U8_MEDIA_FILE (g_list_first (m3u8->files)->data)->sequence;
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files, 0))->sequence;
 
     GST_DEBUG_OBJECT (demux,
         "sequence:%" G_GINT64_FORMAT " , first_sequence:%" G_GINT64_FORMAT
@@ -1539,7 +1572,7 @@ retry:
   } else if (!gst_m3u8_is_live (m3u8)) {
     GstClockTime current_pos, target_pos;
     guint sequence = 0;
-    GList *walk;
+    guint i;
 
     /* Sequence numbers are not guaranteed to be the same in different
      * playlists, so get the correct fragment here based on the current
@@ -1563,8 +1596,8 @@ retry:
         GST_TIME_FORMAT " in updated playlist", GST_TIME_ARGS (target_pos));
 
     current_pos = 0;
-    for (walk = m3u8->files; walk; walk = walk->next) {
-      GstM3U8MediaFile *file = walk->data;
+    for (i = 0; i < m3u8->files->len; i++) {
+      GstM3U8MediaFile *file = g_ptr_array_index (m3u8->files, i);
 
       sequence = file->sequence;
       if (current_pos <= target_pos
@@ -1574,7 +1607,7 @@ retry:
       current_pos += file->duration;
     }
     /* End of playlist */
-    if (!walk)
+    if (i == m3u8->files->len)
       sequence++;
     m3u8->sequence = sequence;
     m3u8->sequence_position = current_pos;
@@ -43,7 +43,9 @@ gst_m3u8_new (void)
 
   m3u8 = g_new0 (GstM3U8, 1);
 
-  m3u8->current_file = NULL;
+  m3u8->files = g_ptr_array_new_with_free_func ((GDestroyNotify)
+      gst_m3u8_media_file_unref);
+  m3u8->current_file_idx = -1;
   m3u8->current_file_duration = GST_CLOCK_TIME_NONE;
   m3u8->sequence = -1;
   m3u8->sequence_position = 0;
@@ -105,8 +107,8 @@ gst_m3u8_unref (GstM3U8 * self)
     g_free (self->base_uri);
     g_free (self->name);
 
-    g_list_foreach (self->files, (GFunc) gst_m3u8_media_file_unref, NULL);
-    g_list_free (self->files);
+    g_ptr_array_unref (self->files);
+    g_free (self->files_base_uri);
 
     g_free (self->last_data);
     g_mutex_clear (&self->lock);
@@ -342,73 +344,71 @@ gst_hls_variant_stream_compare_by_bitrate (gconstpointer a, gconstpointer b)
   return vs_a->bandwidth - vs_b->bandwidth;
 }
 
-/* If we have MEDIA-SEQUENCE, ensure that it's consistent. If it is not,
- * the client SHOULD halt playback (6.3.4), which is what we do then. */
-static gboolean
-check_media_seqnums (GstM3U8 * self, GList * previous_files)
+/* Returns the index of the first file with a sequence number of at least
+ * @sequence, or files->len if there is none */
+static guint
+m3u8_files_lower_bound (GPtrArray * files, gint64 sequence)
 {
-  GList *l, *m;
-  GstM3U8MediaFile *f1 = NULL, *f2 = NULL;
+  GstM3U8MediaFile *file;
+  guint lo = 0, hi = files->len;
+
+  if (hi == 0)
+    return 0;
+
+  /* Sequence numbers are contiguous in pretty much every playlist, so try
+   * to index directly before doing a binary search */
+  file = g_ptr_array_index (files, 0);
+  if (sequence <= file->sequence)
+    return 0;
+  if (sequence - file->sequence < files->len) {
+    guint idx = sequence - file->sequence;
+
+    file = g_ptr_array_index (files, idx);
+    if (file->sequence == sequence)
+      return idx;
+  }
 
-  g_return_val_if_fail (previous_files, FALSE);
+  while (lo < hi) {
+    guint mid = lo + (hi - lo) / 2;
 
-  if (!self->files) {
-    /* Empty playlists are trivially consistent */
-    return TRUE;
+    file = g_ptr_array_index (files, mid);
+    if (file->sequence < sequence)
+      lo = mid + 1;
+    else
+      hi = mid;
   }
 
-  /* Find first case of higher/equal sequence number in new playlist.
-   * From there on we can linearly step ahead */
-  for (l = self->files; l; l = l->next) {
-    gboolean match = FALSE;
+  return lo;
+}
 
-    f1 = l->data;
-    for (m = previous_files; m; m = m->next) {
-      f2 = m->data;
+/* Returns the index of the file with the given sequence number, or -1 */
+static gint
+m3u8_find_file_by_sequence (GPtrArray * files, gint64 sequence)
+{
+  guint idx = m3u8_files_lower_bound (files, sequence);
 
-      if (f1->sequence >= f2->sequence) {
-        match = TRUE;
-        break;
-      }
-    }
-    if (match)
-      break;
-  }
+  if (idx < files->len
+      && GST_M3U8_MEDIA_FILE (g_ptr_array_index (files, idx))->sequence ==
+      sequence)
+    return idx;
 
-  /* We must have seen at least one entry on each list */
-  g_assert (f1 != NULL);
-  g_assert (f2 != NULL);
+  return -1;
+}
 
-  if (!l) {
-    /* No match, no sequence in the new playlist was higher than
-     * any in the old. This is bad! */
-    GST_ERROR ("Media sequence doesn't continue: last new %" G_GINT64_FORMAT
-        " < last old %" G_GINT64_FORMAT, f1->sequence, f2->sequence);
-    return FALSE;
-  }
+/* Checks if a media file line of a playlist resolves to @uri, without
+ * actually resolving it. uri_join() only ever prepends to the line, and
+ * relative lines are always joined with a '/' */
+static gboolean
+uri_matches_line (const gchar * uri, const gchar * line)
+{
+  gsize uri_len = strlen (uri);
+  gsize line_len = strlen (line);
 
-  for (; l && m; l = l->next, m = m->next) {
-    f1 = l->data;
-    f2 = m->data;
-
-    if (f1->sequence == f2->sequence && !g_str_equal (f1->uri, f2->uri)) {
-      /* Same sequence, different URI. This is bad! */
-      GST_ERROR ("Media URIs inconsistent (sequence %" G_GINT64_FORMAT
-          "): had '%s', got '%s'", f1->sequence, f2->uri, f1->uri);
-      return FALSE;
-    } else if (f1->sequence < f2->sequence) {
-      /* Not same sequence but by construction sequence must be higher in the
-       * new one. All good in that case, if it isn't then this means that
-       * sequence numbers are decreasing or files were inserted */
-      GST_ERROR ("Media sequences inconsistent: %" G_GINT64_FORMAT " < %"
-          G_GINT64_FORMAT ": URIs new '%s' old '%s'", f1->sequence,
-          f2->sequence, f1->uri, f2->uri);
-      return FALSE;
-    }
-  }
+  if (line_len > uri_len || strcmp (uri + uri_len - line_len, line) != 0)
+    return FALSE;
 
-  /* All good if we're getting here */
-  return TRUE;
+  return line_len == uri_len || line[0] == '/'
+      || uri[uri_len - line_len - 1] == '/';
 }
 
 /* If we don't have MEDIA-SEQUENCE, we check URIs in the previous and
@@ -416,42 +416,41 @@ check_media_seqnums (GstM3U8 * self, GList * previous_files)
  * playlist in relation to the old. That is, same URIs get the same number
  * and later URIs get higher numbers */
 static void
-generate_media_seqnums (GstM3U8 * self, GList * previous_files)
+generate_media_seqnums (GPtrArray * files, GPtrArray * previous_files)
 {
-  GList *l, *m;
+  GHashTable *uris;
   GstM3U8MediaFile *f1 = NULL, *f2 = NULL;
   gint64 mediasequence;
+  guint l, m = 0;
 
-  g_return_if_fail (previous_files);
+  g_return_if_fail (previous_files->len > 0);
 
   /* Find first case of same URI in new playlist.
    * From there on we can linearly step ahead */
-  for (l = self->files; l; l = l->next) {
-    gboolean match = FALSE;
-
-    f1 = l->data;
-    for (m = previous_files; m; m = m->next) {
-      f2 = m->data;
-
-      if (g_str_equal (f1->uri, f2->uri)) {
-        match = TRUE;
-        break;
-      }
-    }
+  uris = g_hash_table_new (g_str_hash, g_str_equal);
+  for (m = previous_files->len; m > 0; m--) {
+    f2 = g_ptr_array_index (previous_files, m - 1);
+    g_hash_table_insert (uris, f2->uri, GUINT_TO_POINTER (m));
+  }
 
-    if (match)
+  for (l = 0; l < files->len; l++) {
+    f1 = g_ptr_array_index (files, l);
+    m = GPOINTER_TO_UINT (g_hash_table_lookup (uris, f1->uri));
+    if (m > 0)
       break;
   }
+  g_hash_table_destroy (uris);
 
-  if (l) {
+  if (l < files->len) {
     /* Match, check that all following ones are matching too and continue
      * sequence numbers from there on */
+    m--;
+    mediasequence =
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (previous_files, m))->sequence;
 
-    mediasequence = f2->sequence;
-
-    for (; l && m; l = l->next, m = m->next) {
-      f1 = l->data;
-      f2 = m->data;
+    for (; l < files->len && m < previous_files->len; l++, m++) {
+      f1 = g_ptr_array_index (files, l);
+      f2 = g_ptr_array_index (previous_files, m);
 
       f1->sequence = mediasequence;
       mediasequence++;
@@ -462,14 +461,15 @@ generate_media_seqnums (GstM3U8 * self, GList * previous_files)
       }
     }
   } else {
-    /* No match, this means f2 is the last item in the previous playlist
-     * and we have to start our new playlist at that sequence */
+    /* No match, this means we have to start our new playlist after the last
+     * item in the previous playlist */
+    f2 = g_ptr_array_index (previous_files, previous_files->len - 1);
     mediasequence = f2->sequence + 1;
-    l = self->files;
+    l = 0;
   }
 
-  for (; l; l = l->next) {
-    f1 = l->data;
+  for (; l < files->len; l++) {
+    f1 = g_ptr_array_index (files, l);
 
     f1->sequence = mediasequence;
     mediasequence++;
@@ -491,9 +491,13 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
   guint8 iv[16] = { 0, };
   gint64 size = -1, offset = -1;
   gint64 mediasequence;
-  GList *previous_files = NULL;
+  GPtrArray *files, *previous_files;
+  const gchar *base_uri;
+  gboolean reuse_files;
+  gint64 previous_first = -1, previous_last = -1;
   gboolean have_mediasequence = FALSE;
   GstM3U8InitFile *last_init_file = NULL;
+  guint n_new = 0;
 
   g_return_val_if_fail (self != NULL, FALSE);
   g_return_val_if_fail (data != NULL, FALSE);
@@ -526,12 +530,26 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
   g_free (self->last_data);
   self->last_data = data;
 
-  self->current_file = NULL;
+  /* The new files are collected on the side, the previous ones stay in place
+   * until the playlist turned out to be valid */
   previous_files = self->files;
-  self->files = NULL;
+  files = g_ptr_array_new_full (previous_files->len + 1,
+      (GDestroyNotify) gst_m3u8_media_file_unref);
+  if (previous_files->len > 0) {
+    previous_first =
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (previous_files, 0))->sequence;
+    previous_last =
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (previous_files,
+            previous_files->len - 1))->sequence;
+  }
   self->duration = GST_CLOCK_TIME_NONE;
   mediasequence = 0;
 
+  /* Known files are only taken over if they were resolved against the same
+   * base URI, which changes with redirects */
+  base_uri = self->base_uri ? self->base_uri : self->uri;
+  reuse_files = g_strcmp0 (self->files_base_uri, base_uri) == 0;
+
   /* By default, allow caching */
   self->allowcache = TRUE;
 
@@ -550,15 +568,41 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
       *r = '\0';
 
     if (data[0] != '#' && data[0] != '\0') {
+      GstM3U8MediaFile *file;
+
       if (duration <= 0) {
         GST_LOG ("%s: got line without EXTINF, dropping", data);
         goto next_line;
       }
 
-      data = uri_join (self->base_uri ? self->base_uri : self->uri, data);
-      if (data != NULL) {
-        GstM3U8MediaFile *file;
-        file = gst_m3u8_media_file_new (data, title, duration, mediasequence++);
+      if (reuse_files && have_mediasequence && previous_files->len > 0
+          && mediasequence >= previous_first
+          && mediasequence <= previous_last) {
+        gint idx = m3u8_find_file_by_sequence (previous_files, mediasequence);
+        GstM3U8MediaFile *prev =
+            idx >= 0 ? g_ptr_array_index (previous_files, idx) : NULL;
+
+        /* Media files never change once they are in the playlist, so the
+         * ones we already know are taken over after checking that they are
+         * still the same, without resolving and allocating them again.
+         * Same sequence with a different URI or files being inserted is bad
+         * though and the client SHOULD halt playback (6.3.4) */
+        if (prev == NULL || !uri_matches_line (prev->uri, data)) {
+          GST_ERROR ("Media sequences inconsistent (sequence %" G_GINT64_FORMAT
+              "): had '%s', got '%s'", mediasequence,
+              prev ? prev->uri : "nothing", data);
+          goto error;
+        }
+
+        file = gst_m3u8_media_file_ref (prev);
+        mediasequence++;
+      } else {
+        data = uri_join (base_uri, data);
+        if (data == NULL)
+          goto next_line;
+
+        file = gst_m3u8_media_file_new (data, g_strdup (title), duration,
+            mediasequence++);
 
         /* set encryption params */
         file->key = current_key ? g_strdup (current_key) : NULL;
@@ -576,7 +620,8 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
           if (offset != -1) {
             file->offset = offset;
           } else {
-            GstM3U8MediaFile *prev = self->files ? self->files->data : NULL;
+            GstM3U8MediaFile *prev = files->len > 0 ?
+                g_ptr_array_index (files, files->len - 1) : NULL;
 
             if (!prev) {
               offset = 0;
@@ -594,13 +639,15 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
         if (last_init_file)
           file->init_file = gst_m3u8_init_file_ref (last_init_file);
 
-        duration = 0;
-        title = NULL;
-        discontinuity = FALSE;
-        size = offset = -1;
-        self->files = g_list_prepend (self->files, file);
+        n_new++;
       }
 
+      duration = 0;
+      title = NULL;
+      discontinuity = FALSE;
+      size = offset = -1;
+      g_ptr_array_add (files, file);
+
     } else if (g_str_has_prefix (data, "#EXTINF:")) {
       gdouble fval;
       if (!double_from_string (data + 8, &data, &fval)) {
@@ -616,10 +663,9 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
       if (!data || *data != ',')
         goto next_line;
       data = g_utf8_next_char (data);
-      if (data != end) {
-        g_free (title);
-        title = g_strdup (data);
-      }
+      /* only copied if this turns out to be a new file */
+      if (data != end)
+        title = data;
     } else if (g_str_has_prefix (data, "#EXT-X-")) {
       gchar *data_ext_x = data + 7;
 
@@ -662,8 +708,7 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
         current_key = NULL;
         while (data && parse_attributes (&data, &a, &v)) {
           if (g_str_equal (a, "URI")) {
-            current_key =
-                uri_join (self->base_uri ? self->base_uri : self->uri, v);
+            current_key = uri_join (base_uri, v);
           } else if (g_str_equal (a, "IV")) {
             gchar *ivp = v;
             gint i;
@@ -717,8 +762,7 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
 
         while (data != NULL && parse_attributes (&data, &a, &v)) {
           if (strcmp (a, "URI") == 0) {
-            header_uri =
-                uri_join (self->base_uri ? self->base_uri : self->uri, v);
+            header_uri = uri_join (base_uri, v);
           } else if (strcmp (a, "BYTERANGE") == 0) {
             if (int64_from_string (v, &v, &size)) {
               if (*v == '@' && !int64_from_string (v + 1, &v, &offset)) {
@@ -767,57 +811,58 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
   g_free (current_key);
   current_key = NULL;
 
-  self->files = g_list_reverse (self->files);
-
   if (last_init_file)
     gst_m3u8_init_file_unref (last_init_file);
-
-  if (previous_files) {
-    gboolean consistent = TRUE;
-
-    if (have_mediasequence) {
-      consistent = check_media_seqnums (self, previous_files);
-    } else {
-      generate_media_seqnums (self, previous_files);
+  last_init_file = NULL;
+
+  if (previous_files->len > 0 && files->len > 0) {
+    if (!have_mediasequence) {
+      generate_media_seqnums (files, previous_files);
+    } else if (GST_M3U8_MEDIA_FILE (g_ptr_array_index (files,
+                files->len - 1))->sequence < previous_first) {
+      /* No sequence in the new playlist was higher than any in the old.
+       * This is bad! */
+      GST_ERROR ("Media sequence doesn't continue: last new %" G_GINT64_FORMAT
+          " < first old %" G_GINT64_FORMAT,
+          GST_M3U8_MEDIA_FILE (g_ptr_array_index (files,
+                  files->len - 1))->sequence, previous_first);
+      goto error;
     }
+  }
+
+  if (files->len == 0) {
+    GST_ERROR ("Invalid media playlist, it does not contain any media files");
+    goto error;
+  }
 
-    g_list_foreach (previous_files, (GFunc) gst_m3u8_media_file_unref, NULL);
-    g_list_free (previous_files);
-    previous_files = NULL;
+  {
+    guint i;
 
-    /* error was reported above already */
-    if (!consistent) {
-      GST_M3U8_UNLOCK (self);
-      return FALSE;
+    for (i = 1; i < files->len; i++) {
+      if (GST_M3U8_MEDIA_FILE (g_ptr_array_index (files, i - 1))->sequence >=
+          GST_M3U8_MEDIA_FILE (g_ptr_array_index (files, i))->sequence) {
+        GST_ERROR ("Non-increasing media sequence");
+        goto error;
+      }
     }
   }
 
-  if (self->files == NULL) {
-    GST_ERROR ("Invalid media playlist, it does not contain any media files");
-    GST_M3U8_UNLOCK (self);
-    return FALSE;
-  }
+  self->files = files;
+  g_ptr_array_unref (previous_files);
+  previous_files = NULL;
+  self->current_file_idx = -1;
+
+  g_free (self->files_base_uri);
+  self->files_base_uri = g_strdup (base_uri);
 
   /* calculate the start and end times of this media playlist. */
   {
-    GList *walk;
     GstM3U8MediaFile *file;
     GstClockTime duration = 0;
+    guint i;
 
-    mediasequence = -1;
-
-    for (walk = self->files; walk; walk = walk->next) {
-      file = walk->data;
-
-      if (mediasequence == -1) {
-        mediasequence = file->sequence;
-      } else if (mediasequence >= file->sequence) {
-        GST_ERROR ("Non-increasing media sequence");
-        GST_M3U8_UNLOCK (self);
-        return FALSE;
-      } else {
-        mediasequence = file->sequence;
-      }
+    for (i = 0; i < self->files->len; i++) {
+      file = g_ptr_array_index (self->files, i);
 
       duration += file->duration;
       if (file->sequence > self->highest_sequence_number) {
@@ -845,76 +890,76 @@ gst_m3u8_update (GstM3U8 * self, gchar * data)
   }
 
   /* first-time setup */
-  if (self->files && self->sequence == -1) {
-    GList *file;
+  if (self->sequence == -1) {
+    gint idx;
 
     if (GST_M3U8_IS_LIVE (self)) {
       gint i;
       GstClockTime sequence_pos = 0;
+      GstM3U8MediaFile *file;
 
-      file = g_list_last (self->files);
+      idx = self->files->len - 1;
+      file = g_ptr_array_index (self->files, idx);
 
-      if (self->last_file_end >= GST_M3U8_MEDIA_FILE (file->data)->duration) {
-        sequence_pos =
-            self->last_file_end - GST_M3U8_MEDIA_FILE (file->data)->duration;
+      if (self->last_file_end >= file->duration) {
+        sequence_pos = self->last_file_end - file->duration;
       }
 
       /* for live streams, start GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE from
        * the end of the playlist. See section 6.3.3 of HLS draft */
-      for (i = 0; i < GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE && file->prev &&
-          GST_M3U8_MEDIA_FILE (file->prev->data)->duration <= sequence_pos;
-          ++i) {
-        file = file->prev;
-        sequence_pos -= GST_M3U8_MEDIA_FILE (file->data)->duration;
+      for (i = 0; i < GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE && idx > 0 &&
+          GST_M3U8_MEDIA_FILE (g_ptr_array_index (self->files,
+                  idx - 1))->duration <= sequence_pos; ++i) {
+        idx--;
+        sequence_pos -=
+            GST_M3U8_MEDIA_FILE (g_ptr_array_index (self->files,
+                idx))->duration;
       }
       self->sequence_position = sequence_pos;
     } else {
-      file = g_list_first (self->files);
+      idx = 0;
       self->sequence_position = 0;
     }
-    self->current_file = file;
-    self->sequence = GST_M3U8_MEDIA_FILE (file->data)->sequence;
+    self->current_file_idx = idx;
+    self->sequence =
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (self->files, idx))->sequence;
     GST_DEBUG ("first sequence: %u", (guint) self->sequence);
   }
 
-  GST_LOG ("processed media playlist %s, %u fragments", self->name,
-      g_list_length (self->files));
+  GST_LOG ("processed media playlist %s, %u fragments, %u new", self->name,
+      self->files->len, n_new);
 
   GST_M3U8_UNLOCK (self);
 
   return TRUE;
+
+error:
+  {
+    g_free (current_key);
+    if (last_init_file)
+      gst_m3u8_init_file_unref (last_init_file);
+    g_ptr_array_unref (files);
+    GST_M3U8_UNLOCK (self);
+    return FALSE;
+  }
 }
 
 /* call with M3U8_LOCK held */
-static GList *
+static gint
 m3u8_find_next_fragment (GstM3U8 * m3u8, gboolean forward)
 {
-  GstM3U8MediaFile *file;
-  GList *l = m3u8->files;
+  guint idx;
 
   if (forward) {
-    while (l) {
-      file = l->data;
-
-      if (file->sequence >= m3u8->sequence)
-        break;
-
-      l = l->next;
-    }
-  } else {
-    l = g_list_last (l);
-
-    while (l) {
-      file = l->data;
-
-      if (file->sequence <= m3u8->sequence)
-        break;
+    idx = m3u8_files_lower_bound (m3u8->files, m3u8->sequence);
 
-      l = l->prev;
-    }
+    return idx < m3u8->files->len ? idx : -1;
   }
 
-  return l;
+  /* the last file not after the current sequence */
+  idx = m3u8_files_lower_bound (m3u8->files, m3u8->sequence + 1);
+
+  return (gint) idx - 1;
 }
 
 GstM3U8MediaFile *
@@ -932,13 +977,14 @@ gst_m3u8_get_next_fragment (GstM3U8 * m3u8, gboolean forward,
   if (m3u8->sequence < 0)       /* can't happen really */
     goto out;
 
-  if (m3u8->current_file == NULL)
-    m3u8->current_file = m3u8_find_next_fragment (m3u8, forward);
+  if (m3u8->current_file_idx < 0)
+    m3u8->current_file_idx = m3u8_find_next_fragment (m3u8, forward);
 
-  if (m3u8->current_file == NULL)
+  if (m3u8->current_file_idx < 0)
     goto out;
 
-  file = gst_m3u8_media_file_ref (m3u8->current_file->data);
+  file = gst_m3u8_media_file_ref (g_ptr_array_index (m3u8->files,
+          m3u8->current_file_idx));
 
   GST_DEBUG ("Got fragment with sequence %u (current sequence %u)",
       (guint) file->sequence, (guint) m3u8->sequence);
@@ -958,11 +1004,39 @@ out:
   return file;
 }
 
+/* Returns the @n-th file after the current one without advancing, or %NULL
+ * if the playlist doesn't contain it (yet) */
+GstM3U8MediaFile *
+gst_m3u8_peek_fragment (GstM3U8 * m3u8, gboolean forward, guint n)
+{
+  GstM3U8MediaFile *file = NULL;
+  gint64 idx;
+
+  g_return_val_if_fail (m3u8 != NULL, NULL);
+
+  GST_M3U8_LOCK (m3u8);
+
+  if (m3u8->current_file_idx < 0)
+    goto out;
+
+  idx = m3u8->current_file_idx + (forward ? (gint64) n : -(gint64) n);
+  if (idx < 0 || idx >= m3u8->files->len)
+    goto out;
+
+  file = gst_m3u8_media_file_ref (g_ptr_array_index (m3u8->files, idx));
+
+out:
+
+  GST_M3U8_UNLOCK (m3u8);
+
+  return file;
+}
+
 gboolean
 gst_m3u8_has_next_fragment (GstM3U8 * m3u8, gboolean forward)
 {
   gboolean have_next;
-  GList *cur;
+  gint cur;
 
   g_return_val_if_fail (m3u8 != NULL, FALSE);
 
@@ -971,13 +1045,14 @@ gst_m3u8_has_next_fragment (GstM3U8 * m3u8, gboolean forward)
   GST_DEBUG ("Checking next fragment %" G_GINT64_FORMAT,
       m3u8->sequence + (forward ? 1 : -1));
 
-  if (m3u8->current_file) {
-    cur = m3u8->current_file;
+  if (m3u8->current_file_idx >= 0) {
+    cur = m3u8->current_file_idx;
   } else {
     cur = m3u8_find_next_fragment (m3u8, forward);
   }
 
-  have_next = cur && ((forward && cur->next) || (!forward && cur->prev));
+  have_next = cur >= 0 && ((forward && cur + 1 < (gint) m3u8->files->len)
+      || (!forward && cur > 0));
 
   GST_M3U8_UNLOCK (m3u8);
 
@@ -988,9 +1063,8 @@ gst_m3u8_has_next_fragment (GstM3U8 * m3u8, gboolean forward)
 static void
 m3u8_alternate_advance (GstM3U8 * m3u8, gboolean forward)
 {
-  gint targetnum = m3u8->sequence;
-  GList *tmp;
-  GstM3U8MediaFile *mf;
+  gint64 targetnum = m3u8->sequence;
+  gint idx;
 
   /* figure out the target seqnum */
   if (forward)
@@ -998,18 +1072,15 @@ m3u8_alternate_advance (GstM3U8 * m3u8, gboolean forward)
   else
     targetnum -= 1;
 
-  for (tmp = m3u8->files; tmp; tmp = tmp->next) {
-    mf = (GstM3U8MediaFile *) tmp->data;
-    if (mf->sequence == targetnum)
-      break;
-  }
-  if (tmp == NULL) {
+  idx = m3u8_find_file_by_sequence (m3u8->files, targetnum);
+  if (idx < 0) {
     GST_WARNING ("Can't find next fragment");
     return;
   }
-  m3u8->current_file = tmp;
+  m3u8->current_file_idx = idx;
   m3u8->sequence = targetnum;
-  m3u8->current_file_duration = GST_M3U8_MEDIA_FILE (tmp->data)->duration;
+  m3u8->current_file_duration =
+      GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files, idx))->duration;
 }
 
 void
@@ -1035,30 +1106,26 @@ gst_m3u8_advance_fragment (GstM3U8 * m3u8, gboolean forward)
     GST_DEBUG ("Sequence position now %" GST_TIME_FORMAT,
         GST_TIME_ARGS (m3u8->sequence_position));
   }
-  if (!m3u8->current_file) {
-    GList *l;
-
+  if (m3u8->current_file_idx < 0) {
     GST_DEBUG ("Looking for fragment %" G_GINT64_FORMAT, m3u8->sequence);
-    for (l = m3u8->files; l != NULL; l = l->next) {
-      if (GST_M3U8_MEDIA_FILE (l->data)->sequence == m3u8->sequence) {
-        m3u8->current_file = l;
-        break;
-      }
-    }
-    if (m3u8->current_file == NULL) {
+    m3u8->current_file_idx =
+        m3u8_find_file_by_sequence (m3u8->files, m3u8->sequence);
+    if (m3u8->current_file_idx < 0) {
       GST_DEBUG
           ("Could not find current fragment, trying next fragment directly");
       m3u8_alternate_advance (m3u8, forward);
 
       /* Resync sequence number if the above has failed for live streams */
-      if (m3u8->current_file == NULL && GST_M3U8_IS_LIVE (m3u8)) {
+      if (m3u8->current_file_idx < 0 && GST_M3U8_IS_LIVE (m3u8)
+          && m3u8->files->len > 0) {
         /* for live streams, start GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE from
            the end of the playlist. See section 6.3.3 of HLS draft */
         gint pos =
-            g_list_length (m3u8->files) - GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE;
-        m3u8->current_file = g_list_nth (m3u8->files, pos >= 0 ? pos : 0);
+            (gint) m3u8->files->len - GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE;
+        m3u8->current_file_idx = MAX (pos, 0);
         m3u8->current_file_duration =
-            GST_M3U8_MEDIA_FILE (m3u8->current_file->data)->duration;
+            GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files,
+                m3u8->current_file_idx))->duration;
 
         GST_WARNING ("Resyncing live playlist");
       }
@@ -1066,28 +1133,33 @@ gst_m3u8_advance_fragment (GstM3U8 * m3u8, gboolean forward)
     }
   }
 
-  file = GST_M3U8_MEDIA_FILE (m3u8->current_file->data);
+  file = g_ptr_array_index (m3u8->files, m3u8->current_file_idx);
   GST_DEBUG ("Advancing from sequence %u", (guint) file->sequence);
   if (forward) {
-    m3u8->current_file = m3u8->current_file->next;
-    if (m3u8->current_file) {
-      m3u8->sequence = GST_M3U8_MEDIA_FILE (m3u8->current_file->data)->sequence;
+    if (m3u8->current_file_idx + 1 < (gint) m3u8->files->len) {
+      m3u8->current_file_idx++;
+      m3u8->sequence = GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files,
+              m3u8->current_file_idx))->sequence;
     } else {
+      m3u8->current_file_idx = -1;
       m3u8->sequence = file->sequence + 1;
     }
   } else {
-    m3u8->current_file = m3u8->current_file->prev;
-    if (m3u8->current_file) {
-      m3u8->sequence = GST_M3U8_MEDIA_FILE (m3u8->current_file->data)->sequence;
+    if (m3u8->current_file_idx > 0) {
+      m3u8->current_file_idx--;
+      m3u8->sequence = GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files,
+              m3u8->current_file_idx))->sequence;
     } else {
+      m3u8->current_file_idx = -1;
       m3u8->sequence = file->sequence - 1;
     }
   }
-  if (m3u8->current_file) {
+  if (m3u8->current_file_idx >= 0) {
     /* Store duration of the fragment we're using to update the position 
      * the next time we advance */
     m3u8->current_file_duration =
-        GST_M3U8_MEDIA_FILE (m3u8->current_file->data)->duration;
+        GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files,
+            m3u8->current_file_idx))->duration;
   }
 
 out:
@@ -1108,12 +1180,13 @@ gst_m3u8_get_duration (GstM3U8 * m3u8)
   if (!m3u8->endlist)
     goto out;
 
-  if (!GST_CLOCK_TIME_IS_VALID (m3u8->duration) && m3u8->files != NULL) {
-    GList *f;
+  if (!GST_CLOCK_TIME_IS_VALID (m3u8->duration) && m3u8->files->len > 0) {
+    guint i;
 
     m3u8->duration = 0;
-    for (f = m3u8->files; f != NULL; f = f->next)
-      m3u8->duration += GST_M3U8_MEDIA_FILE (f)->duration;
+    for (i = 0; i < m3u8->files->len; i++)
+      m3u8->duration +=
+          GST_M3U8_MEDIA_FILE (g_ptr_array_index (m3u8->files, i))->duration;
   }
   duration = m3u8->duration;
 
@@ -1224,16 +1297,15 @@ gboolean
 gst_m3u8_get_seek_range (GstM3U8 * m3u8, gint64 * start, gint64 * stop)
 {
   GstClockTime duration = 0;
-  GList *walk;
   GstM3U8MediaFile *file;
-  guint count;
+  guint i;
   guint min_distance = 0;
 
   g_return_val_if_fail (m3u8 != NULL, FALSE);
 
   GST_M3U8_LOCK (m3u8);
 
-  if (m3u8->files == NULL)
+  if (m3u8->files->len == 0)
     goto out;
 
   if (GST_M3U8_IS_LIVE (m3u8)) {
@@ -1242,11 +1314,8 @@ gst_m3u8_get_seek_range (GstM3U8 * m3u8, gint64 * start, gint64 * stop)
        playlist - see 6.3.3. "Playing the Playlist file" of the HLS draft */
     min_distance = GST_M3U8_LIVE_MIN_FRAGMENT_DISTANCE;
   }
-  count = g_list_length (m3u8->files);
-
-  for (walk = m3u8->files; walk && count > min_distance; walk = walk->next) {
-    file = walk->data;
-    --count;
+  for (i = 0; i + min_distance < m3u8->files->len; i++) {
+    file = g_ptr_array_index (m3u8->files, i);
     duration += file->duration;
   }
 
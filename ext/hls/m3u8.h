@@ -64,10 +64,11 @@ struct _GstM3U8
   GstClockTime targetduration;  /* last EXT-X-TARGETDURATION */
   gboolean allowcache;          /* last EXT-X-ALLOWCACHE */
 
-  GList *files;
+  GPtrArray *files;             /* GstM3U8MediaFile, by increasing sequence */
+  gchar *files_base_uri;        /* base URI the files were resolved against */
 
   /* state */
-  GList *current_file;
+  gint current_file_idx;        /* index of the current file, -1 if unknown */
   GstClockTime current_file_duration; /* Duration of current fragment */
   gint64 sequence;                    /* the next sequence for this client */
   GstClockTime sequence_position;     /* position of this sequence */
@@ -129,6 +130,10 @@ GstM3U8MediaFile * gst_m3u8_get_next_fragment    (GstM3U8      * m3u8,
                                                   GstClockTime * sequence_position,
                                                   gboolean     * discont);
 
+GstM3U8MediaFile * gst_m3u8_peek_fragment        (GstM3U8 * m3u8,
+                                                  gboolean  forward,
+                                                  guint     n);
+
 gboolean           gst_m3u8_has_next_fragment    (GstM3U8 * m3u8,
                                                   gboolean  forward);
 
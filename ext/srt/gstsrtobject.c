@@ -200,6 +200,7 @@ gst_srt_object_new (GstElement * element)
       "mode", GST_TYPE_SRT_CONNECTION_MODE, GST_SRT_DEFAULT_MODE, NULL);
 
   srtobject->sock = SRT_INVALID_SOCK;
+  srtobject->read_sock = SRT_INVALID_SOCK;
   srtobject->poll_id = srt_epoll_create ();
   srtobject->listener_sock = SRT_INVALID_SOCK;
   srtobject->listener_poll_id = SRT_ERROR;
@@ -1023,6 +1024,8 @@ void
 gst_srt_object_close (GstSRTObject * srtobject)
 {
   GST_OBJECT_LOCK (srtobject->element);
+  srtobject->read_sock = SRT_INVALID_SOCK;
+
   if (srtobject->poll_id != SRT_ERROR) {
     srt_epoll_remove_usock (srtobject->poll_id, srtobject->sock);
   }
@@ -1182,12 +1185,75 @@ gst_srt_object_read (GstSRTObject * srtobject,
 
 
     len = srt_recvmsg (rsock, (char *) (data), size);
+    if (len > 0) {
+      GST_OBJECT_LOCK (srtobject->element);
+      srtobject->read_sock = rsock;
+      GST_OBJECT_UNLOCK (srtobject->element);
+    }
     break;
   }
 
   return len;
 }
 
+/* Reads the next message of the socket that gst_srt_object_read() last read
+ * from, if one is already available. Returns 0 when none is, in which case
+ * gst_srt_object_read() has to wait for the next one. */
+gssize
+gst_srt_object_read_pending (GstSRTObject * srtobject,
+    guint8 * data, gsize size, GError ** error)
+{
+  SRTSOCKET rsock;
+  gssize len;
+
+  /* Only source element can read data */
+  g_return_val_if_fail (gst_uri_handler_get_uri_type (GST_URI_HANDLER
+          (srtobject->element)) == GST_URI_SRC, -1);
+
+  GST_OBJECT_LOCK (srtobject->element);
+  rsock = srtobject->read_sock;
+  GST_OBJECT_UNLOCK (srtobject->element);
+
+  if (rsock == SRT_INVALID_SOCK)
+    return 0;
+
+  /* the sockets are non-blocking, this fails with SRT_EASYNCRCV once they
+   * are drained or with SRT_EINVSOCK if it was closed meanwhile. Any other
+   * error is left for the next blocking read. */
+  len = srt_recvmsg (rsock, (char *) (data), size);
+  if (len < 0) {
+    GST_OBJECT_LOCK (srtobject->element);
+    if (srtobject->read_sock == rsock)
+      srtobject->read_sock = SRT_INVALID_SOCK;
+    GST_OBJECT_UNLOCK (srtobject->element);
+    return 0;
+  }
+
+  return len;
+}
+
+/* Tells whether gst_srt_object_read_pending() has a message to return,
+ * without reading it */
+gboolean
+gst_srt_object_has_pending (GstSRTObject * srtobject)
+{
+  SRTSOCKET rsock;
+  gint events = 0;
+  gint optlen = sizeof (events);
+
+  GST_OBJECT_LOCK (srtobject->element);
+  rsock = srtobject->read_sock;
+  GST_OBJECT_UNLOCK (srtobject->element);
+
+  if (rsock == SRT_INVALID_SOCK)
+    return FALSE;
+
+  if (srt_getsockopt (rsock, 0, SRTO_EVENT, &events, &optlen))
+    return FALSE;
+
+  return (events & SRT_EPOLL_IN) != 0;
+}
+
 void
 gst_srt_object_wakeup (GstSRTObject * srtobject, GCancellable * cancellable)
 {
@@ -1264,15 +1330,19 @@ gst_srt_object_send_headers (GstSRTObject * srtobject, SRTSOCKET sock,
 static gssize
 gst_srt_object_write_to_callers (GstSRTObject * srtobject,
     GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+    const GstMapInfo * mapinfos, guint n_mapinfos,
+    GCancellable * cancellable, GError ** error)
 {
   GList *callers;
+  gssize total = 0;
+  guint i;
+
+  for (i = 0; i < n_mapinfos; i++)
+    total += mapinfos[i].size;
 
   GST_OBJECT_LOCK (srtobject->element);
   callers = srtobject->callers;
   while (callers != NULL) {
-    gssize len = 0;
-    const guint8 *msg = mapinfo->data;
     gint sent;
 
     SRTCaller *caller = callers->data;
@@ -1291,13 +1361,20 @@ gst_srt_object_write_to_callers (GstSRTObject * srtobject,
       caller->sent_headers = TRUE;
     }
 
-    while (len < mapinfo->size) {
-      gint rest = mapinfo->size - len;
-      sent = srt_sendmsg2 (caller->sock, (char *) (msg + len), rest, 0);
-      if (sent < 0) {
-        goto err;
+    /* all the messages go to a caller before moving to the next one, the
+     * messages are only mapped once for all of them */
+    for (i = 0; i < n_mapinfos; i++) {
+      const guint8 *msg = mapinfos[i].data;
+      gssize len = 0;
+
+      while (len < mapinfos[i].size) {
+        gint rest = mapinfos[i].size - len;
+        sent = srt_sendmsg2 (caller->sock, (char *) (msg + len), rest, 0);
+        if (sent < 0) {
+          goto err;
+        }
+        len += sent;
       }
-      len += sent;
     }
 
     continue;
@@ -1310,31 +1387,17 @@ gst_srt_object_write_to_callers (GstSRTObject * srtobject,
 
   GST_OBJECT_UNLOCK (srtobject->element);
 
-  return mapinfo->size;
+  return total;
 }
 
 static gssize
 gst_srt_object_write_one (GstSRTObject * srtobject,
-    GstBufferList * headers,
-    const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+    const GstMapInfo * mapinfo, gint poll_timeout,
+    GCancellable * cancellable, GError ** error)
 {
   gssize len = 0;
-  gint poll_timeout;
   const guint8 *msg = mapinfo->data;
 
-  if (!gst_structure_get_int (srtobject->parameters, "poll-timeout",
-          &poll_timeout)) {
-    poll_timeout = GST_SRT_DEFAULT_POLL_TIMEOUT;
-  }
-
-  if (!srtobject->sent_headers) {
-    if (!gst_srt_object_send_headers (srtobject, srtobject->sock,
-            srtobject->poll_id, poll_timeout, headers, cancellable)) {
-      return -1;
-    }
-    srtobject->sent_headers = TRUE;
-  }
-
   while (len < mapinfo->size) {
     SRTSOCKET wsock;
     gint wsocklen = 1;
@@ -1384,10 +1447,61 @@ gst_srt_object_write_one (GstSRTObject * srtobject,
   return len;
 }
 
+static gssize
+gst_srt_object_write_to_socket (GstSRTObject * srtobject,
+    GstBufferList * headers,
+    const GstMapInfo * mapinfos, guint n_mapinfos,
+    GCancellable * cancellable, GError ** error)
+{
+  gssize len = 0;
+  gint poll_timeout;
+  guint i;
+
+  if (!gst_structure_get_int (srtobject->parameters, "poll-timeout",
+          &poll_timeout)) {
+    poll_timeout = GST_SRT_DEFAULT_POLL_TIMEOUT;
+  }
+
+  if (!srtobject->sent_headers) {
+    if (!gst_srt_object_send_headers (srtobject, srtobject->sock,
+            srtobject->poll_id, poll_timeout, headers, cancellable)) {
+      return -1;
+    }
+    srtobject->sent_headers = TRUE;
+  }
+
+  for (i = 0; i < n_mapinfos; i++) {
+    gssize sent;
+
+    sent = gst_srt_object_write_one (srtobject, &mapinfos[i], poll_timeout,
+        cancellable, error);
+    if (sent < 0)
+      return -1;
+
+    len += sent;
+    if (sent < mapinfos[i].size)
+      break;
+  }
+
+  return len;
+}
+
 gssize
 gst_srt_object_write (GstSRTObject * srtobject,
     GstBufferList * headers,
     const GstMapInfo * mapinfo, GCancellable * cancellable, GError ** error)
+{
+  return gst_srt_object_write_list (srtobject, headers, mapinfo, 1,
+      cancellable, error);
+}
+
+/* Sends each of the @n_mapinfos messages in order, returns the number of
+ * bytes sent, or -1 on error */
+gssize
+gst_srt_object_write_list (GstSRTObject * srtobject,
+    GstBufferList * headers,
+    const GstMapInfo * mapinfos, guint n_mapinfos,
+    GCancellable * cancellable, GError ** error)
 {
   gssize len = 0;
   GstSRTConnectionMode connection_mode = GST_SRT_CONNECTION_MODE_NONE;
@@ -1404,12 +1518,12 @@ gst_srt_object_write (GstSRTObject * srtobject,
       return -1;
 
     len =
-        gst_srt_object_write_to_callers (srtobject, headers, mapinfo,
-        cancellable, error);
+        gst_srt_object_write_to_callers (srtobject, headers, mapinfos,
+        n_mapinfos, cancellable, error);
   } else {
     len =
-        gst_srt_object_write_one (srtobject, headers, mapinfo, cancellable,
-        error);
+        gst_srt_object_write_to_socket (srtobject, headers, mapinfos,
+        n_mapinfos, cancellable, error);
   }
 
   return len;
@@ -53,6 +53,8 @@ struct _GstSRTObject
   gboolean                      opened;
   SRTSOCKET                     sock;
   gint                          poll_id;
+  /* the socket last read from, to drain what else it has */
+  SRTSOCKET                     read_sock;
   gboolean                      sent_headers;
 
   GCond                         sock_cond;
@@ -109,12 +111,25 @@ gssize          gst_srt_object_read     (GstSRTObject * srtobject,
                                          GCancellable *cancellable,
                                          GError **err);
 
+gssize          gst_srt_object_read_pending (GstSRTObject * srtobject,
+                                         guint8 *data, gsize size,
+                                         GError **err);
+
+gboolean        gst_srt_object_has_pending (GstSRTObject * srtobject);
+
 gssize          gst_srt_object_write    (GstSRTObject * srtobject, 
                                          GstBufferList * headers,
                                          const GstMapInfo * mapinfo,
                                          GCancellable *cancellable,
                                          GError **err);
 
+gssize          gst_srt_object_write_list (GstSRTObject * srtobject,
+                                         GstBufferList * headers,
+                                         const GstMapInfo * mapinfos,
+                                         guint n_mapinfos,
+                                         GCancellable *cancellable,
+                                         GError **err);
+
 void            gst_srt_object_wakeup   (GstSRTObject * srtobject,
                                          GCancellable *cancellable);
 
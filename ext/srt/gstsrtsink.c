@@ -200,6 +200,11 @@ gst_srt_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   if (gst_srt_object_write (self->srtobject, self->headers, &info,
           self->cancellable, &error) < 0) {
     ret = GST_FLOW_ERROR;
+    if (error) {
+      GST_ELEMENT_ERROR (self, RESOURCE, WRITE, (NULL), ("%s",
+              error->message));
+      g_clear_error (&error);
+    }
   }
 
   gst_buffer_unmap (buffer, &info);
@@ -217,6 +222,68 @@ gst_srt_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   return ret;
 }
 
+static GstFlowReturn
+gst_srt_sink_render_list (GstBaseSink * sink, GstBufferList * list)
+{
+  GstSRTSink *self = GST_SRT_SINK (sink);
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstMapInfo *infos;
+  GstBuffer **buffers;
+  GError *error = NULL;
+  guint i, len, n_infos = 0;
+
+  if (g_cancellable_is_cancelled (self->cancellable)) {
+    return GST_FLOW_FLUSHING;
+  }
+
+  len = gst_buffer_list_length (list);
+  infos = g_new (GstMapInfo, len);
+  buffers = g_new (GstBuffer *, len);
+
+  /* map all the messages once, they are then sent to each caller in turn */
+  for (i = 0; i < len; i++) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+
+    if (self->headers
+        && GST_BUFFER_FLAG_IS_SET (buffer, GST_BUFFER_FLAG_HEADER)) {
+      GST_DEBUG_OBJECT (self, "Have streamheaders,"
+          " ignoring header %" GST_PTR_FORMAT, buffer);
+      continue;
+    }
+
+    if (!gst_buffer_map (buffer, &infos[n_infos], GST_MAP_READ)) {
+      GST_ELEMENT_ERROR (self, RESOURCE, READ,
+          ("Could not map the input stream"), (NULL));
+      ret = GST_FLOW_ERROR;
+      goto out;
+    }
+    buffers[n_infos++] = buffer;
+  }
+
+  if (n_infos == 0)
+    goto out;
+
+  GST_TRACE_OBJECT (self, "sending list of %u buffers", n_infos);
+
+  if (gst_srt_object_write_list (self->srtobject, self->headers, infos,
+          n_infos, self->cancellable, &error) < 0) {
+    ret = GST_FLOW_ERROR;
+    if (error) {
+      GST_ELEMENT_ERROR (self, RESOURCE, WRITE, (NULL), ("%s",
+              error->message));
+      g_clear_error (&error);
+    }
+  }
+
+out:
+  for (i = 0; i < n_infos; i++)
+    gst_buffer_unmap (buffers[i], &infos[i]);
+  g_free (infos);
+  g_free (buffers);
+
+  return ret;
+}
+
 static gboolean
 gst_srt_sink_unlock (GstBaseSink * bsink)
 {
@@ -337,6 +404,8 @@ gst_srt_sink_class_init (GstSRTSinkClass * klass)
   gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_srt_sink_start);
   gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_srt_sink_stop);
   gstbasesink_class->render = GST_DEBUG_FUNCPTR (gst_srt_sink_render);
+  gstbasesink_class->render_list =
+      GST_DEBUG_FUNCPTR (gst_srt_sink_render_list);
   gstbasesink_class->unlock = GST_DEBUG_FUNCPTR (gst_srt_sink_unlock);
   gstbasesink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_srt_sink_unlock_stop);
   gstbasesink_class->set_caps = GST_DEBUG_FUNCPTR (gst_srt_sink_set_caps);
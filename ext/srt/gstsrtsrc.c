@@ -55,6 +55,9 @@ static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
 #define GST_CAT_DEFAULT gst_debug_srt_src
 GST_DEBUG_CATEGORY (GST_CAT_DEFAULT);
 
+/* Most messages pushed downstream in one buffer list */
+#define MAX_MESSAGES_PER_LIST 128
+
 enum
 {
   SIG_CALLER_ADDED,
@@ -186,6 +189,110 @@ out:
   return ret;
 }
 
+static GstClockTime
+gst_srt_src_running_time (GstClock * clock, GstClockTime base_time)
+{
+  GstClockTime now = gst_clock_get_time (clock);
+
+  return now > base_time ? now - base_time : 0;
+}
+
+static GstFlowReturn
+gst_srt_src_create (GstPushSrc * src, GstBuffer ** outbuf)
+{
+  GstSRTSrc *self = GST_SRT_SRC (src);
+  GstBaseSrc *bsrc = GST_BASE_SRC (src);
+  GstBaseSrcClass *bclass = GST_BASE_SRC_GET_CLASS (src);
+  GstBufferList *list = NULL;
+  GstBuffer *buffer = NULL;
+  GstClock *clock = NULL;
+  GstClockTime base_time = 0, first_ts = GST_CLOCK_TIME_NONE;
+  GstFlowReturn ret;
+  guint i;
+
+  /* wait for a message */
+  ret = bclass->alloc (bsrc, -1, gst_base_src_get_blocksize (bsrc), &buffer);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  ret = gst_srt_src_fill (src, buffer);
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (buffer);
+    return ret;
+  }
+
+  /* basesrc only timestamps the first buffer of a list, so the drained ones
+   * are timestamped here, with the running time they were received at */
+  if (gst_base_src_get_do_timestamp (bsrc)) {
+    clock = gst_element_get_clock (GST_ELEMENT_CAST (src));
+    base_time = gst_element_get_base_time (GST_ELEMENT_CAST (src));
+  }
+  if (clock)
+    first_ts = gst_srt_src_running_time (clock, base_time);
+
+  /* then drain the ones that arrived meanwhile without waiting any further,
+   * so that a burst goes downstream at once instead of buffer by buffer */
+  for (i = 1; i < MAX_MESSAGES_PER_LIST; i++) {
+    GstBuffer *next = NULL;
+    GstMapInfo info;
+    gssize recv_len;
+
+    /* don't allocate for nothing, or wait on a bounded pool, when no
+     * message is left */
+    if (!gst_srt_object_has_pending (self->srtobject))
+      break;
+
+    if (bclass->alloc (bsrc, -1, gst_base_src_get_blocksize (bsrc),
+            &next) != GST_FLOW_OK)
+      break;
+
+    if (!gst_buffer_map (next, &info, GST_MAP_WRITE)) {
+      gst_buffer_unref (next);
+      break;
+    }
+
+    recv_len = gst_srt_object_read_pending (self->srtobject, info.data,
+        info.size, NULL);
+
+    gst_buffer_unmap (next, &info);
+
+    if (recv_len <= 0) {
+      gst_buffer_unref (next);
+      break;
+    }
+
+    gst_buffer_resize (next, 0, recv_len);
+
+    if (clock) {
+      GST_BUFFER_PTS (next) = GST_BUFFER_DTS (next) =
+          gst_srt_src_running_time (clock, base_time);
+    }
+
+    if (!list) {
+      list = gst_buffer_list_new ();
+      /* basesrc would timestamp it only after the ones drained here */
+      if (clock && !GST_BUFFER_DTS_IS_VALID (buffer))
+        GST_BUFFER_PTS (buffer) = GST_BUFFER_DTS (buffer) = first_ts;
+      gst_buffer_list_add (list, buffer);
+    }
+    gst_buffer_list_add (list, next);
+  }
+
+  if (clock)
+    gst_object_unref (clock);
+
+  if (list) {
+    GST_LOG_OBJECT (src, "submitting list of %u buffers",
+        gst_buffer_list_length (list));
+    gst_base_src_submit_buffer_list (bsrc, list);
+    *outbuf = NULL;
+  } else {
+    *outbuf = buffer;
+  }
+
+  return GST_FLOW_OK;
+}
+
 static void
 gst_srt_src_init (GstSRTSrc * self)
 {
@@ -308,7 +415,7 @@ gst_srt_src_class_init (GstSRTSrcClass * klass)
   gstbasesrc_class->unlock = GST_DEBUG_FUNCPTR (gst_srt_src_unlock);
   gstbasesrc_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_srt_src_unlock_stop);
 
-  gstpushsrc_class->fill = GST_DEBUG_FUNCPTR (gst_srt_src_fill);
+  gstpushsrc_class->create = GST_DEBUG_FUNCPTR (gst_srt_src_create);
 }
 
 static GstURIType
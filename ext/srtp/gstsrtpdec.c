@@ -207,6 +207,10 @@ static GstFlowReturn gst_srtp_dec_chain_rtp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstFlowReturn gst_srtp_dec_chain_rtcp (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
+static GstFlowReturn gst_srtp_dec_chain_list_rtp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
+static GstFlowReturn gst_srtp_dec_chain_list_rtcp (GstPad * pad,
+    GstObject * parent, GstBufferList * buf_list);
 
 static GstStateChangeReturn gst_srtp_dec_change_state (GstElement * element,
     GstStateChange transition);
@@ -379,6 +383,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtp));
   gst_pad_set_chain_function (filter->rtp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtp));
+  gst_pad_set_chain_list_function (filter->rtp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtp));
 
   filter->rtp_srcpad =
       gst_pad_new_from_static_template (&rtp_src_template, "rtp_src");
@@ -402,6 +408,8 @@ gst_srtp_dec_init (GstSrtpDec * filter)
       GST_DEBUG_FUNCPTR (gst_srtp_dec_iterate_internal_links_rtcp));
   gst_pad_set_chain_function (filter->rtcp_sinkpad,
       GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_rtcp));
+  gst_pad_set_chain_list_function (filter->rtcp_sinkpad,
+      GST_DEBUG_FUNCPTR (gst_srtp_dec_chain_list_rtcp));
 
   filter->rtcp_srcpad =
       gst_pad_new_from_static_template (&rtcp_src_template, "rtcp_src");
@@ -1316,21 +1324,25 @@ gst_srtp_dec_push_early_events (GstSrtpDec * filter, GstPad * pad,
 
 /*
  * This function should be called while holding the filter lock
+ *
+ * The packet is decoded in place, *@buf_ptr is replaced by a copy first if
+ * it is not writable
  */
 static gboolean
-gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad, GstBuffer * buf,
-    gboolean is_rtcp, guint32 ssrc)
+gst_srtp_dec_decode_buffer (GstSrtpDec * filter, GstPad * pad,
+    GstBuffer ** buf_ptr, gboolean is_rtcp, guint32 ssrc)
 {
+  GstBuffer *buf;
   GstMapInfo map;
   srtp_err_status_t err;
   gint size;
 
   GST_LOG_OBJECT (pad, "Received %s buffer of size %" G_GSIZE_FORMAT
-      " with SSRC = %u", is_rtcp ? "RTCP" : "RTP", gst_buffer_get_size (buf),
-      ssrc);
+      " with SSRC = %u", is_rtcp ? "RTCP" : "RTP",
+      gst_buffer_get_size (*buf_ptr), ssrc);
 
   /* Change buffer to remove protection */
-  buf = gst_buffer_make_writable (buf);
+  buf = *buf_ptr = gst_buffer_make_writable (*buf_ptr);
 
   gst_buffer_map (buf, &map, GST_MAP_READWRITE);
   size = map.size;
@@ -1465,7 +1477,7 @@ gst_srtp_dec_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
     goto push_out;
   }
 
-  if (!gst_srtp_dec_decode_buffer (filter, pad, buf, is_rtcp, ssrc)) {
+  if (!gst_srtp_dec_decode_buffer (filter, pad, &buf, is_rtcp, ssrc)) {
     GST_OBJECT_UNLOCK (filter);
     goto drop_buffer;
   }
@@ -1501,6 +1513,123 @@ drop_buffer:
   return ret;
 }
 
+typedef struct DecodeBufferItData
+{
+  GstSrtpDec *filter;
+  GstPad *pad;
+  gboolean is_rtcp;
+  GstBufferList *rtp_list;
+  GstBufferList *rtcp_list;
+  GArray *soft_limit_ssrcs;
+} DecodeBufferItData;
+
+/*
+ * This function should be called while holding the filter lock
+ */
+static gboolean
+decode_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
+{
+  DecodeBufferItData *data = user_data;
+  GstSrtpDec *filter = data->filter;
+  GstSrtpDecSsrcStream *stream;
+  gboolean is_rtcp = data->is_rtcp;
+  guint32 ssrc = 0;
+  guint i;
+
+  if (!(stream = validate_buffer (filter, *buffer, &ssrc, &is_rtcp))) {
+    GST_WARNING_OBJECT (filter, "Invalid buffer, dropping");
+    goto drop_buffer;
+  }
+
+  if (STREAM_HAS_CRYPTO (stream)) {
+    if (!gst_srtp_dec_decode_buffer (filter, data->pad, buffer, is_rtcp, ssrc))
+      goto drop_buffer;
+
+    /* The soft limit is signalled once the filter lock is released */
+    if (gst_srtp_get_soft_limit_reached ()) {
+      for (i = 0; i < data->soft_limit_ssrcs->len; i++) {
+        if (g_array_index (data->soft_limit_ssrcs, guint32, i) == ssrc)
+          break;
+      }
+      if (i == data->soft_limit_ssrcs->len)
+        g_array_append_val (data->soft_limit_ssrcs, ssrc);
+    }
+  }
+
+  /* Move the buffer over to the list of the pad it goes out on */
+  gst_buffer_list_add (is_rtcp ? data->rtcp_list : data->rtp_list, *buffer);
+  *buffer = NULL;
+
+  return TRUE;
+
+drop_buffer:
+  gst_buffer_unref (*buffer);
+  *buffer = NULL;
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list, gboolean is_rtcp)
+{
+  GstSrtpDec *filter = GST_SRTP_DEC (parent);
+  DecodeBufferItData data;
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i;
+
+  GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
+      gst_buffer_list_length (buf_list));
+
+  /* The buffers are decoded in place and moved to the output lists */
+  buf_list = gst_buffer_list_make_writable (buf_list);
+
+  data.filter = filter;
+  data.pad = pad;
+  data.is_rtcp = is_rtcp;
+  data.rtp_list = gst_buffer_list_new ();
+  data.rtcp_list = gst_buffer_list_new ();
+  data.soft_limit_ssrcs = g_array_new (FALSE, FALSE, sizeof (guint32));
+
+  /* Take the lock only once for the whole list */
+  GST_OBJECT_LOCK (filter);
+  gst_buffer_list_foreach (buf_list, decode_buffer_it, &data);
+  GST_OBJECT_UNLOCK (filter);
+
+  gst_buffer_list_unref (buf_list);
+
+  /* If all is well, we may have reached soft limit */
+  for (i = 0; i < data.soft_limit_ssrcs->len; i++)
+    request_key_with_signal (filter,
+        g_array_index (data.soft_limit_ssrcs, guint32, i), SIGNAL_SOFT_LIMIT);
+  g_array_free (data.soft_limit_ssrcs, TRUE);
+
+  /* Push buffers to source pads */
+  if (gst_buffer_list_length (data.rtp_list) > 0) {
+    if (!filter->rtp_has_segment)
+      gst_srtp_dec_push_early_events (filter, filter->rtp_srcpad,
+          filter->rtcp_srcpad, FALSE);
+    ret = gst_pad_push_list (filter->rtp_srcpad, data.rtp_list);
+  } else {
+    gst_buffer_list_unref (data.rtp_list);
+  }
+
+  if (gst_buffer_list_length (data.rtcp_list) > 0) {
+    GstFlowReturn rtcp_ret;
+
+    if (!filter->rtcp_has_segment)
+      gst_srtp_dec_push_early_events (filter, filter->rtcp_srcpad,
+          filter->rtp_srcpad, TRUE);
+    rtcp_ret = gst_pad_push_list (filter->rtcp_srcpad, data.rtcp_list);
+    if (ret == GST_FLOW_OK)
+      ret = rtcp_ret;
+  } else {
+    gst_buffer_list_unref (data.rtcp_list);
+  }
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_srtp_dec_chain_rtp (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -1513,6 +1642,20 @@ gst_srtp_dec_chain_rtcp (GstPad * pad, GstObject * parent, GstBuffer * buf)
   return gst_srtp_dec_chain (pad, parent, buf, TRUE);
 }
 
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, FALSE);
+}
+
+static GstFlowReturn
+gst_srtp_dec_chain_list_rtcp (GstPad * pad, GstObject * parent,
+    GstBufferList * buf_list)
+{
+  return gst_srtp_dec_chain_list (pad, parent, buf_list, TRUE);
+}
+
 static GstStateChangeReturn
 gst_srtp_dec_change_state (GstElement * element, GstStateChange transition)
 {
@@ -131,6 +131,10 @@ GST_DEBUG_CATEGORY_STATIC (gst_srtp_enc_debug);
 #define DEFAULT_RANDOM_KEY      FALSE
 #define DEFAULT_REPLAY_WINDOW_SIZE 128
 #define DEFAULT_ALLOW_REPEAT_TX FALSE
+#define DEFAULT_N_SESSIONS      1
+
+/* Pooled output buffers are allocated in multiples of this */
+#define POOL_BUFFER_SIZE_ALIGN  512
 
 #define HAS_CRYPTO(filter) (filter->rtp_cipher != GST_SRTP_CIPHER_NULL || \
       filter->rtcp_cipher != GST_SRTP_CIPHER_NULL ||                      \
@@ -157,14 +161,16 @@ enum
   PROP_REPLAY_WINDOW_SIZE,
   PROP_ALLOW_REPEAT_TX,
   PROP_STATS,
-  PROP_MKI
+  PROP_MKI,
+  PROP_N_SESSIONS
 };
 
 typedef struct ProcessBufferItData
 {
   GstSrtpEnc *filter;
   GstPad *pad;
-  GstBufferList *out_list;
+  GstSrtpEncSession *session;
+  srtp_err_status_t err;
   GstFlowReturn flowret;
   gboolean is_rtcp;
 } ProcessBufferItData;
@@ -331,6 +337,23 @@ gst_srtp_enc_class_init (GstSrtpEncClass * klass)
           GST_PARAM_MUTABLE_PLAYING));
 #endif
 
+  /**
+   * GstSrtpEnc:n-sessions:
+   *
+   * Number of SRTP sessions the streams are distributed over according to
+   * their SSRC. Each session is locked separately, which allows streams
+   * that end up in different sessions to be protected in parallel from
+   * different streaming threads.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_N_SESSIONS,
+      g_param_spec_uint ("n-sessions", "Number of sessions",
+          "Number of SRTP sessions the streams are distributed over by SSRC",
+          1, 256, DEFAULT_N_SESSIONS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   /**
    * GstSrtpEnc::soft-limit:
    * @gstsrtpenc: the element on which the signal is emitted
@@ -359,7 +382,71 @@ gst_srtp_enc_init (GstSrtpEnc * filter)
   filter->rtcp_auth = DEFAULT_RTCP_AUTH;
   filter->replay_window_size = DEFAULT_REPLAY_WINDOW_SIZE;
   filter->allow_repeat_tx = DEFAULT_ALLOW_REPEAT_TX;
-  filter->ssrcs_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+  filter->n_sessions = DEFAULT_N_SESSIONS;
+}
+
+/* Allocate the sessions the streams are distributed over
+ *
+ * Should be called with the filter locked
+ */
+static void
+gst_srtp_enc_alloc_sessions (GstSrtpEnc * filter)
+{
+  guint i;
+
+  filter->n_active_sessions = filter->n_sessions;
+  filter->sessions = g_new0 (GstSrtpEncSession, filter->n_active_sessions);
+
+  for (i = 0; i < filter->n_active_sessions; i++) {
+    GstSrtpEncSession *session = &filter->sessions[i];
+
+    g_mutex_init (&session->lock);
+    session->ssrcs_set = g_hash_table_new (g_direct_hash, g_direct_equal);
+  }
+}
+
+/* Should be called with the filter locked and no buffer being processed
+ */
+static void
+gst_srtp_enc_free_sessions (GstSrtpEnc * filter)
+{
+  guint i;
+
+  for (i = 0; i < filter->n_active_sessions; i++) {
+    GstSrtpEncSession *session = &filter->sessions[i];
+
+    if (session->session)
+      srtp_dealloc (session->session);
+    g_hash_table_unref (session->ssrcs_set);
+    if (session->pool) {
+      gst_buffer_pool_set_active (session->pool, FALSE);
+      gst_object_unref (session->pool);
+    }
+    g_mutex_clear (&session->lock);
+  }
+
+  g_free (filter->sessions);
+  filter->sessions = NULL;
+  filter->n_active_sessions = 0;
+}
+
+/* Should be called with the session locked
+ */
+static void
+gst_srtp_enc_session_clear (GstSrtpEncSession * session)
+{
+  if (session->session) {
+    srtp_dealloc (session->session);
+    session->session = NULL;
+  }
+
+  g_hash_table_remove_all (session->ssrcs_set);
+}
+
+static GstSrtpEncSession *
+gst_srtp_enc_get_session (GstSrtpEnc * filter, guint32 ssrc)
+{
+  return &filter->sessions[ssrc % filter->n_active_sessions];
 }
 
 static guint
@@ -390,6 +477,7 @@ gst_srtp_enc_create_session (GstSrtpEnc * filter)
   gboolean has_mki = FALSE;
   GstMapInfo mki_map;
 #endif
+  guint i;
 
   memset (&policy, 0, sizeof (srtp_policy_t));
 
@@ -464,10 +552,38 @@ gst_srtp_enc_create_session (GstSrtpEnc * filter)
   policy.window_size = filter->replay_window_size;
   policy.allow_repeat_tx = filter->allow_repeat_tx;
 
-  /* If it is the first stream, create the session
-   * If not, add the stream to the session
+  /* Every session gets the same policy, the streams are created in them
+   * as their SSRCs show up. On a key change the previous context is
+   * replaced in the same critical section, so that the streaming threads
+   * never see a session without one
    */
-  ret = srtp_create (&filter->session, &policy);
+  ret = srtp_err_status_ok;
+  for (i = 0; i < filter->n_active_sessions && ret == srtp_err_status_ok; i++) {
+    GstSrtpEncSession *session = &filter->sessions[i];
+
+    g_mutex_lock (&session->lock);
+    gst_srtp_enc_session_clear (session);
+    ret = srtp_create (&session->session, &policy);
+    session->use_mki = (filter->mki != NULL);
+
+    /* Room needed after the packets for the authentication tag, MKI and
+     * SRTCP index */
+    session->rtp_trailer_len = SRTP_MAX_TRAILER_LEN + 10;
+    session->rtcp_trailer_len = SRTP_MAX_TRAILER_LEN + 10;
+#ifdef HAVE_SRTP2
+    if (ret == srtp_err_status_ok) {
+      guint32 len;
+
+      if (srtp_get_protect_trailer_length (session->session, session->use_mki,
+              0, &len) == srtp_err_status_ok)
+        session->rtp_trailer_len = len;
+      if (srtp_get_protect_rtcp_trailer_length (session->session,
+              session->use_mki, 0, &len) == srtp_err_status_ok)
+        session->rtcp_trailer_len = len;
+    }
+#endif
+    g_mutex_unlock (&session->lock);
+  }
   filter->first_session = FALSE;
 
 #ifdef HAVE_SRTP2
@@ -489,13 +605,14 @@ done:
 static void
 gst_srtp_enc_reset_no_lock (GstSrtpEnc * filter)
 {
-  if (!filter->first_session) {
-    if (filter->session) {
-      srtp_dealloc (filter->session);
-      filter->session = NULL;
-    }
+  guint i;
 
-    g_hash_table_remove_all (filter->ssrcs_set);
+  for (i = 0; i < filter->n_active_sessions; i++) {
+    GstSrtpEncSession *session = &filter->sessions[i];
+
+    g_mutex_lock (&session->lock);
+    gst_srtp_enc_session_clear (session);
+    g_mutex_unlock (&session->lock);
   }
 
   filter->first_session = TRUE;
@@ -649,9 +766,8 @@ gst_srtp_enc_dispose (GObject * object)
   gst_buffer_replace (&filter->key, NULL);
   gst_buffer_replace (&filter->mki, NULL);
 
-  if (filter->ssrcs_set)
-    g_hash_table_unref (filter->ssrcs_set);
-  filter->ssrcs_set = NULL;
+  if (filter->sessions)
+    gst_srtp_enc_free_sessions (filter);
 
   G_OBJECT_CLASS (gst_srtp_enc_parent_class)->dispose (object);
 }
@@ -662,24 +778,33 @@ gst_srtp_enc_create_stats (GstSrtpEnc * filter)
   GstStructure *s;
   GValue va = G_VALUE_INIT;
   GValue v = G_VALUE_INIT;
+  guint i;
 
   s = gst_structure_new_empty ("application/x-srtp-encoder-stats");
 
   g_value_init (&va, GST_TYPE_ARRAY);
   g_value_init (&v, GST_TYPE_STRUCTURE);
 
-  if (filter->session) {
+  for (i = 0; i < filter->n_active_sessions; i++) {
+    GstSrtpEncSession *session = &filter->sessions[i];
     GHashTableIter iter;
     gpointer key;
 
-    g_hash_table_iter_init (&iter, filter->ssrcs_set);
+    g_mutex_lock (&session->lock);
+
+    if (!session->session) {
+      g_mutex_unlock (&session->lock);
+      continue;
+    }
+
+    g_hash_table_iter_init (&iter, session->ssrcs_set);
     while (g_hash_table_iter_next (&iter, &key, NULL)) {
       GstStructure *ss;
       guint32 ssrc = GPOINTER_TO_UINT (key);
       srtp_err_status_t status;
       guint32 roc;
 
-      status = srtp_get_stream_roc (filter->session, ssrc, &roc);
+      status = srtp_get_stream_roc (session->session, ssrc, &roc);
       if (status != srtp_err_status_ok) {
         continue;
       }
@@ -690,6 +815,8 @@ gst_srtp_enc_create_stats (GstSrtpEnc * filter)
       g_value_take_boxed (&v, ss);
       gst_value_array_append_value (&va, &v);
     }
+
+    g_mutex_unlock (&session->lock);
   }
 
   gst_structure_take_value (s, "streams", &va);
@@ -754,6 +881,9 @@ gst_srtp_enc_set_property (GObject * object, guint prop_id,
       GST_INFO_OBJECT (object, "Set property: mki=[%p]", filter->mki);
       break;
 #endif
+    case PROP_N_SESSIONS:
+      filter->n_sessions = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -804,6 +934,9 @@ gst_srtp_enc_get_property (GObject * object, guint prop_id,
         g_value_set_boxed (value, filter->mki);
       break;
 #endif
+    case PROP_N_SESSIONS:
+      g_value_set_uint (value, filter->n_sessions);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -820,11 +953,14 @@ get_rtp_other_pad (GstPad * pad)
   return GST_PAD (gst_pad_get_element_private (pad));
 }
 
+/* Should be called with @session locked
+ */
 static void
-gst_srtp_enc_add_ssrc (GstSrtpEnc * filter, guint ssrc)
+gst_srtp_enc_add_ssrc (GstSrtpEnc * filter, GstSrtpEncSession * session,
+    guint ssrc)
 {
   gboolean is_added =
-      g_hash_table_add (filter->ssrcs_set, GUINT_TO_POINTER (ssrc));
+      g_hash_table_add (session->ssrcs_set, GUINT_TO_POINTER (ssrc));
   if (is_added) {
     GST_DEBUG_OBJECT (filter, "Added ssrc %u", ssrc);
   }
@@ -879,10 +1015,16 @@ gst_srtp_enc_sink_setcaps (GstPad * pad, GstSrtpEnc * filter,
 
   GST_OBJECT_LOCK (filter);
 
-  if (gst_structure_has_field_typed (ps, "ssrc", G_TYPE_UINT)) {
+  if (filter->sessions
+      && gst_structure_has_field_typed (ps, "ssrc", G_TYPE_UINT)) {
+    GstSrtpEncSession *session;
     guint ssrc;
+
     gst_structure_get_uint (ps, "ssrc", &ssrc);
-    gst_srtp_enc_add_ssrc (filter, ssrc);
+    session = gst_srtp_enc_get_session (filter, ssrc);
+    g_mutex_lock (&session->lock);
+    gst_srtp_enc_add_ssrc (filter, session, ssrc);
+    g_mutex_unlock (&session->lock);
   }
 
   if (HAS_CRYPTO (filter))
@@ -1067,14 +1209,24 @@ gst_srtp_enc_replace_random_key (GstSrtpEnc * filter)
 
 static GstFlowReturn
 gst_srtp_enc_check_set_caps (GstSrtpEnc * filter, GstPad * pad,
-    gboolean is_rtcp)
+    gboolean is_rtcp, gboolean * has_crypto)
 {
   gboolean do_setcaps = FALSE;
 
   GST_OBJECT_LOCK (filter);
 
+  if (filter->sessions == NULL) {
+    /* Not started yet or shutting down */
+    GST_OBJECT_UNLOCK (filter);
+    return GST_FLOW_FLUSHING;
+  }
+
   if (filter->key_changed) {
-    gst_srtp_enc_reset_no_lock (filter);
+    /* The sessions are not reset here but replaced one by one by
+     * gst_srtp_enc_create_session(), the streaming threads of the other
+     * pads would find them without context in between otherwise */
+    filter->first_session = TRUE;
+    filter->key_changed = FALSE;
     do_setcaps = TRUE;
   }
 
@@ -1082,6 +1234,8 @@ gst_srtp_enc_check_set_caps (GstSrtpEnc * filter, GstPad * pad,
     srtp_err_status_t status = gst_srtp_enc_create_session (filter);
 
     if (status != srtp_err_status_ok) {
+      /* don't keep encrypting with the previous key on the other pads */
+      gst_srtp_enc_reset_no_lock (filter);
       GST_OBJECT_UNLOCK (filter);
       GST_ELEMENT_ERROR (filter, LIBRARY, INIT,
           ("Could not initialize SRTP encoder"),
@@ -1090,6 +1244,8 @@ gst_srtp_enc_check_set_caps (GstSrtpEnc * filter, GstPad * pad,
     }
   }
 
+  *has_crypto = HAS_CRYPTO (filter);
+
   GST_OBJECT_UNLOCK (filter);
 
   /* Update source caps if asked */
@@ -1107,98 +1263,179 @@ gst_srtp_enc_check_set_caps (GstSrtpEnc * filter, GstPad * pad,
   return GST_FLOW_OK;
 }
 
-static void
-gst_srtp_enc_ensure_ssrc (GstSrtpEnc * filter, GstBuffer * buf)
+/* Get the SSRC of the stream a packet belongs to, which is what libsrtp
+ * looks the stream up with
+ */
+static gboolean
+gst_srtp_enc_get_ssrc (GstBuffer * buf, gboolean is_rtcp, guint32 * ssrc)
 {
-  GstRTPBuffer rtpbuf = GST_RTP_BUFFER_INIT;
-  if (gst_rtp_buffer_map (buf,
-          GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING, &rtpbuf)) {
-    guint32 ssrc = gst_rtp_buffer_get_ssrc (&rtpbuf);
-    gst_srtp_enc_add_ssrc (filter, ssrc);
-    gst_rtp_buffer_unmap (&rtpbuf);
-  }
+  guint8 data[4];
+
+  /* The SSRC of RTP packets follows the timestamp, RTCP packets start with
+   * the SSRC of the sender after the common header */
+  if (gst_buffer_extract (buf, is_rtcp ? 4 : 8, data, 4) != 4)
+    return FALSE;
+
+  *ssrc = GST_READ_UINT32_BE (data);
+
+  return TRUE;
 }
 
-static GstFlowReturn
-gst_srtp_enc_process_buffer (GstSrtpEnc * filter, GstPad * pad,
-    GstBuffer * buf, gboolean is_rtcp, GstBuffer ** outbuf_ptr)
+/* Whether @buf is writable and its memory has enough tailroom for the
+ * authentication tag and MKI
+ */
+static gboolean
+gst_srtp_enc_can_protect_in_place (GstBuffer * buf, gsize size_max)
 {
-  GstFlowReturn ret = GST_FLOW_OK;
-  gint size_max, size;
-  GstBuffer *bufout = NULL;
-  GstMapInfo mapout;
-  srtp_err_status_t err;
+  gsize offset, maxsize;
 
-  /* Create a bigger buffer to add protection */
-  size = gst_buffer_get_size (buf);
-  size_max = size + SRTP_MAX_TRAILER_LEN + 10;
-  bufout = gst_buffer_new_allocate (NULL, size_max, NULL);
+  if (!gst_buffer_is_writable (buf) || gst_buffer_n_memory (buf) != 1)
+    return FALSE;
 
-  gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
+  if (!gst_memory_is_writable (gst_buffer_peek_memory (buf, 0)))
+    return FALSE;
 
-  gst_buffer_extract (buf, 0, mapout.data, size);
+  gst_buffer_get_sizes (buf, &offset, &maxsize);
 
-  GST_OBJECT_LOCK (filter);
+  return maxsize - offset >= size_max;
+}
 
-  gst_srtp_init_event_reporter ();
+/* Should be called with @session locked
+ */
+static GstBuffer *
+gst_srtp_enc_acquire_buffer (GstSrtpEnc * filter, GstSrtpEncSession * session,
+    gsize size)
+{
+  GstBuffer *buf = NULL;
 
-  if (filter->session == NULL) {
-    /* The rtcp session disappeared (element shutting down) */
-    GST_OBJECT_UNLOCK (filter);
-    ret = GST_FLOW_FLUSHING;
-    goto fail;
+  /* Recreate the pool with bigger buffers if needed, packet sizes are
+   * bounded by the MTU so this only happens a few times at the start */
+  if (size > session->pool_size) {
+    GstStructure *config;
+
+    if (session->pool) {
+      gst_buffer_pool_set_active (session->pool, FALSE);
+      gst_object_unref (session->pool);
+    }
+
+    session->pool_size = (size + POOL_BUFFER_SIZE_ALIGN - 1) &
+        ~(POOL_BUFFER_SIZE_ALIGN - 1);
+    session->pool = gst_buffer_pool_new ();
+
+    config = gst_buffer_pool_get_config (session->pool);
+    gst_buffer_pool_config_set_params (config, NULL, session->pool_size, 0, 0);
+    if (!gst_buffer_pool_set_config (session->pool, config) ||
+        !gst_buffer_pool_set_active (session->pool, TRUE)) {
+      GST_WARNING_OBJECT (filter, "Could not activate buffer pool");
+      gst_clear_object (&session->pool);
+    }
   }
 
-  gst_srtp_enc_ensure_ssrc (filter, buf);
+  if (session->pool)
+    gst_buffer_pool_acquire_buffer (session->pool, &buf, NULL);
+
+  if (buf == NULL)
+    buf = gst_buffer_new_allocate (NULL, size, NULL);
+
+  return buf;
+}
+
+/* Protect *@buf, in place if possible or into a pooled buffer that replaces
+ * it otherwise
+ *
+ * Should be called with @session locked
+ */
+static srtp_err_status_t
+gst_srtp_enc_protect_buffer (GstSrtpEnc * filter, GstSrtpEncSession * session,
+    GstPad * pad, GstBuffer ** buf, gboolean is_rtcp)
+{
+  gint size_max, size;
+  GstBuffer *bufout;
+  GstMapInfo mapout;
+  gboolean in_place;
+  srtp_err_status_t err;
+
+  size = gst_buffer_get_size (*buf);
+  size_max = size + (is_rtcp ? session->rtcp_trailer_len :
+      session->rtp_trailer_len);
+
+  in_place = gst_srtp_enc_can_protect_in_place (*buf, size_max);
+  if (in_place) {
+    bufout = *buf;
+    gst_buffer_set_size (bufout, size_max);
+    gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
+  } else {
+    bufout = gst_srtp_enc_acquire_buffer (filter, session, size_max);
+    gst_buffer_map (bufout, &mapout, GST_MAP_READWRITE);
+    gst_buffer_extract (*buf, 0, mapout.data, size);
+  }
 
 #ifdef HAVE_SRTP2
   if (is_rtcp)
-    err = srtp_protect_rtcp_mki (filter->session, mapout.data, &size,
-        (filter->mki != NULL), 0);
+    err = srtp_protect_rtcp_mki (session->session, mapout.data, &size,
+        session->use_mki, 0);
   else
-    err = srtp_protect_mki (filter->session, mapout.data, &size,
-        (filter->mki != NULL), 0);
+    err = srtp_protect_mki (session->session, mapout.data, &size,
+        session->use_mki, 0);
 #else
   if (is_rtcp)
-    err = srtp_protect_rtcp (filter->session, mapout.data, &size);
+    err = srtp_protect_rtcp (session->session, mapout.data, &size);
   else
-    err = srtp_protect (filter->session, mapout.data, &size);
+    err = srtp_protect (session->session, mapout.data, &size);
 #endif
 
-  GST_OBJECT_UNLOCK (filter);
-
   gst_buffer_unmap (bufout, &mapout);
 
-  if (err == srtp_err_status_ok) {
-    /* Buffer protected */
-    gst_buffer_set_size (bufout, size);
-    gst_buffer_copy_into (bufout, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  if (err != srtp_err_status_ok) {
+    if (in_place)
+      gst_buffer_set_size (bufout, size);
+    else
+      gst_buffer_unref (bufout);
+    return err;
+  }
 
-    GST_LOG_OBJECT (pad, "Encoding %s buffer of size %d",
-        is_rtcp ? "RTCP" : "RTP", size);
+  /* Buffer protected */
+  gst_buffer_set_size (bufout, size);
+  if (!in_place) {
+    gst_buffer_copy_into (bufout, *buf, GST_BUFFER_COPY_METADATA, 0, -1);
+    gst_buffer_unref (*buf);
+    *buf = bufout;
+  }
+
+  GST_LOG_OBJECT (pad, "Encoding %s buffer of size %d%s",
+      is_rtcp ? "RTCP" : "RTP", size, in_place ? " in place" : "");
 
-  } else if (err == srtp_err_status_key_expired) {
+  return err;
+}
 
+static GstFlowReturn
+gst_srtp_enc_post_protect_error (GstSrtpEnc * filter, srtp_err_status_t err)
+{
+  if (err == srtp_err_status_key_expired) {
     GST_ELEMENT_ERROR (GST_ELEMENT_CAST (filter), STREAM, ENCODE,
         ("Key usage limit has been reached"),
         ("Unable to protect buffer (hard key usage limit reached)"));
-    ret = GST_FLOW_ERROR;
-    goto fail;
-
   } else {
     /* srtp_protect failed */
     GST_ELEMENT_ERROR (filter, LIBRARY, FAILED, (NULL),
         ("Unable to protect buffer (protect failed) code %d", err));
-    ret = GST_FLOW_ERROR;
-    goto fail;
   }
 
-  *outbuf_ptr = bufout;
-  return ret;
+  return GST_FLOW_ERROR;
+}
 
-fail:
-  gst_buffer_unref (bufout);
-  return ret;
+static void
+gst_srtp_enc_check_soft_limit (GstSrtpEnc * filter)
+{
+  if (!gst_srtp_get_soft_limit_reached ())
+    return;
+
+  g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
+
+  GST_OBJECT_LOCK (filter);
+  if (filter->random_key && !filter->key_changed)
+    gst_srtp_enc_replace_random_key (filter);
+  GST_OBJECT_UNLOCK (filter);
 }
 
 static GstFlowReturn
@@ -1208,48 +1445,60 @@ gst_srtp_enc_chain (GstPad * pad, GstObject * parent, GstBuffer * buf,
   GstSrtpEnc *filter = GST_SRTP_ENC (parent);
   GstFlowReturn ret = GST_FLOW_OK;
   GstPad *otherpad;
-  GstBuffer *bufout = NULL;
+  GstSrtpEncSession *session;
+  gboolean has_crypto = FALSE;
+  gboolean has_ssrc;
+  guint32 ssrc = 0;
+  srtp_err_status_t err;
 
-  if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp)) != GST_FLOW_OK) {
+  if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp,
+              &has_crypto)) != GST_FLOW_OK) {
     goto out;
   }
 
-  GST_OBJECT_LOCK (filter);
+  otherpad = get_rtp_other_pad (pad);
 
-  if (!HAS_CRYPTO (filter)) {
-    GST_OBJECT_UNLOCK (filter);
-    otherpad = get_rtp_other_pad (pad);
+  if (!has_crypto)
     return gst_pad_push (otherpad, buf);
+
+  gst_srtp_init_event_reporter ();
+
+  has_ssrc = gst_srtp_enc_get_ssrc (buf, is_rtcp, &ssrc);
+  session = gst_srtp_enc_get_session (filter, ssrc);
+
+  g_mutex_lock (&session->lock);
+
+  if (session->session == NULL) {
+    /* The session disappeared (element shutting down) */
+    g_mutex_unlock (&session->lock);
+    ret = GST_FLOW_FLUSHING;
+    goto out;
   }
 
-  GST_OBJECT_UNLOCK (filter);
+  if (has_ssrc)
+    gst_srtp_enc_add_ssrc (filter, session, ssrc);
 
-  ret = gst_srtp_enc_process_buffer (filter, pad, buf, is_rtcp, &bufout);
-  if (ret != GST_FLOW_OK)
+  err = gst_srtp_enc_protect_buffer (filter, session, pad, &buf, is_rtcp);
+
+  g_mutex_unlock (&session->lock);
+
+  if (err != srtp_err_status_ok) {
+    ret = gst_srtp_enc_post_protect_error (filter, err);
     goto out;
+  }
 
   /* Push buffer to source pad */
-  otherpad = get_rtp_other_pad (pad);
-  ret = gst_pad_push (otherpad, bufout);
-  bufout = NULL;
+  ret = gst_pad_push (otherpad, buf);
+  buf = NULL;
 
   if (ret != GST_FLOW_OK)
     goto out;
 
-  GST_OBJECT_LOCK (filter);
-
-  if (gst_srtp_get_soft_limit_reached ()) {
-    GST_OBJECT_UNLOCK (filter);
-    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
-    GST_OBJECT_LOCK (filter);
-    if (filter->random_key && !filter->key_changed)
-      gst_srtp_enc_replace_random_key (filter);
-  }
-
-  GST_OBJECT_UNLOCK (filter);
+  gst_srtp_enc_check_soft_limit (filter);
 
 out:
-  gst_buffer_unref (buf);
+  if (buf)
+    gst_buffer_unref (buf);
   return ret;
 }
 
@@ -1257,17 +1506,37 @@ static gboolean
 process_buffer_it (GstBuffer ** buffer, guint index, gpointer user_data)
 {
   ProcessBufferItData *data = user_data;
-  GstBuffer *bufout;
-  GstFlowReturn ret;
+  GstSrtpEncSession *session;
+  gboolean has_ssrc;
+  guint32 ssrc = 0;
+
+  has_ssrc = gst_srtp_enc_get_ssrc (*buffer, data->is_rtcp, &ssrc);
+  session = gst_srtp_enc_get_session (data->filter, ssrc);
+
+  /* Lists usually carry a single stream, the session lock is only switched
+   * when the next packet belongs to a stream of another session */
+  if (session != data->session) {
+    if (data->session)
+      g_mutex_unlock (&data->session->lock);
+    g_mutex_lock (&session->lock);
+    data->session = session;
+  }
 
-  ret = gst_srtp_enc_process_buffer (data->filter, data->pad, *buffer,
-      data->is_rtcp, &bufout);
-  if (ret != GST_FLOW_OK) {
-    data->flowret = ret;
+  if (session->session == NULL) {
+    /* The session disappeared (element shutting down) */
+    data->flowret = GST_FLOW_FLUSHING;
     return FALSE;
   }
 
-  gst_buffer_list_add (data->out_list, bufout);
+  if (has_ssrc)
+    gst_srtp_enc_add_ssrc (data->filter, session, ssrc);
+
+  data->err = gst_srtp_enc_protect_buffer (data->filter, session, data->pad,
+      buffer, data->is_rtcp);
+  if (data->err != srtp_err_status_ok) {
+    data->flowret = GST_FLOW_ERROR;
+    return FALSE;
+  }
 
   return TRUE;
 }
@@ -1279,8 +1548,8 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   GstSrtpEnc *filter = GST_SRTP_ENC (parent);
   GstFlowReturn ret = GST_FLOW_OK;
   GstPad *otherpad;
-  GstBufferList *out_list = NULL;
   ProcessBufferItData process_data;
+  gboolean has_crypto = FALSE;
 
   GST_LOG_OBJECT (pad, "Buffer chain with list of %d",
       gst_buffer_list_length (buf_list));
@@ -1288,63 +1557,59 @@ gst_srtp_enc_chain_list (GstPad * pad, GstObject * parent,
   if (!gst_buffer_list_length (buf_list))
     goto out;
 
-  if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp)) != GST_FLOW_OK)
+  if ((ret = gst_srtp_enc_check_set_caps (filter, pad, is_rtcp,
+              &has_crypto)) != GST_FLOW_OK)
     goto out;
 
-  GST_OBJECT_LOCK (filter);
+  otherpad = get_rtp_other_pad (pad);
 
-  if (!HAS_CRYPTO (filter)) {
-    GST_OBJECT_UNLOCK (filter);
-    otherpad = get_rtp_other_pad (pad);
+  if (!has_crypto)
     return gst_pad_push_list (otherpad, buf_list);
-  }
 
-  GST_OBJECT_UNLOCK (filter);
+  /* The packets are replaced in the list if they can't be protected in
+   * place */
+  buf_list = gst_buffer_list_make_writable (buf_list);
 
-  out_list = gst_buffer_list_new ();
+  gst_srtp_init_event_reporter ();
 
   process_data.filter = filter;
   process_data.pad = pad;
   process_data.is_rtcp = is_rtcp;
-  process_data.out_list = out_list;
+  process_data.session = NULL;
+  process_data.err = srtp_err_status_ok;
   process_data.flowret = GST_FLOW_OK;
 
-  if (!gst_buffer_list_foreach (buf_list, process_buffer_it, &process_data)) {
-    ret = process_data.flowret;
+  gst_buffer_list_foreach (buf_list, process_buffer_it, &process_data);
+
+  if (process_data.session)
+    g_mutex_unlock (&process_data.session->lock);
+
+  if (process_data.err != srtp_err_status_ok) {
+    ret = gst_srtp_enc_post_protect_error (filter, process_data.err);
     goto out;
   }
 
-  if (!gst_buffer_list_length (out_list)) {
-    gst_buffer_list_unref (out_list);
-    ret = GST_FLOW_OK;
+  if (process_data.flowret != GST_FLOW_OK) {
+    ret = process_data.flowret;
     goto out;
   }
 
   /* Push buffer to source pad */
-  otherpad = get_rtp_other_pad (pad);
   GST_LOG_OBJECT (pad, "Pushing buffer chain of %d",
       gst_buffer_list_length (buf_list));
-  ret = gst_pad_push_list (otherpad, out_list);
+  ret = gst_pad_push_list (otherpad, buf_list);
+  buf_list = NULL;
 
   if (ret != GST_FLOW_OK) {
     goto out;
   }
 
-  GST_OBJECT_LOCK (filter);
-
-  if (gst_srtp_get_soft_limit_reached ()) {
-    GST_OBJECT_UNLOCK (filter);
-    g_signal_emit (filter, gst_srtp_enc_signals[SIGNAL_SOFT_LIMIT], 0);
-    GST_OBJECT_LOCK (filter);
-    if (filter->random_key && !filter->key_changed)
-      gst_srtp_enc_replace_random_key (filter);
-  }
-
-  GST_OBJECT_UNLOCK (filter);
+  gst_srtp_enc_check_soft_limit (filter);
 
 out:
 
-  gst_buffer_list_unref (buf_list);
+  if (buf_list)
+    gst_buffer_list_unref (buf_list);
 
   return ret;
 }
@@ -1419,6 +1684,10 @@ gst_srtp_enc_change_state (GstElement * element, GstStateChange transition)
       GST_OBJECT_UNLOCK (filter);
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
+      GST_OBJECT_LOCK (filter);
+      if (!filter->sessions)
+        gst_srtp_enc_alloc_sessions (filter);
+      GST_OBJECT_UNLOCK (filter);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
       break;
@@ -1433,7 +1702,10 @@ gst_srtp_enc_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_PLAYING_TO_PAUSED:
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
-      gst_srtp_enc_reset (filter);
+      GST_OBJECT_LOCK (filter);
+      gst_srtp_enc_reset_no_lock (filter);
+      gst_srtp_enc_free_sessions (filter);
+      GST_OBJECT_UNLOCK (filter);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       break;
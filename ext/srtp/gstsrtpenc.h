@@ -64,6 +64,25 @@ G_BEGIN_DECLS
 
 typedef struct _GstSrtpEnc      GstSrtpEnc;
 typedef struct _GstSrtpEncClass GstSrtpEncClass;
+typedef struct _GstSrtpEncSession GstSrtpEncSession;
+
+/* The streams are spread over the sessions by SSRC, each session has its
+ * own lock so that different streams can be protected in parallel */
+struct _GstSrtpEncSession
+{
+  GMutex lock;
+
+  srtp_t session;
+  gboolean use_mki;
+  guint32 rtp_trailer_len;
+  guint32 rtcp_trailer_len;
+
+  GHashTable *ssrcs_set;
+
+  /* Output buffers for packets without enough tailroom */
+  GstBufferPool *pool;
+  gsize pool_size;
+};
 
 struct _GstSrtpEnc
 {
@@ -78,14 +97,15 @@ struct _GstSrtpEnc
   guint rtcp_auth;
   GstBuffer *mki;
 
-  srtp_t session;
   gboolean first_session;
   gboolean key_changed;
 
   guint replay_window_size;
   gboolean allow_repeat_tx;
 
-  GHashTable *ssrcs_set;
+  guint n_sessions;
+  GstSrtpEncSession *sessions;
+  guint n_active_sessions;
 };
 
 struct _GstSrtpEncClass
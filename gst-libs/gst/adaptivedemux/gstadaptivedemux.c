@@ -129,6 +129,8 @@ GST_DEBUG_CATEGORY (adaptivedemux_debug);
 #define DEFAULT_FAILED_COUNT 3
 #define DEFAULT_CONNECTION_SPEED 0
 #define DEFAULT_BITRATE_LIMIT 0.8f
+#define DEFAULT_PREFETCH_FRAGMENTS 0
+#define MAX_PREFETCH_FRAGMENTS 8
 #define SRC_QUEUE_MAX_BYTES 20 * 1024 * 1024    /* For safety. Large enough to hold a segment. */
 #define NUM_LOOKBACK_FRAGMENTS 3
 
@@ -157,6 +159,7 @@ enum
   PROP_0,
   PROP_CONNECTION_SPEED,
   PROP_BITRATE_LIMIT,
+  PROP_PREFETCH_FRAGMENTS,
   PROP_LAST
 };
 
@@ -205,8 +208,52 @@ struct _GstAdaptiveDemuxPrivate
    * without needing to stop tasks when they just want to
    * update the segment boundaries */
   GMutex segment_lock;
+
+  guint prefetch_fragments;     /* protected by manifest_lock */
+  GThreadPool *prefetch_pool;   /* protected by manifest_lock */
+  GstAdaptiveDemuxStreamPeekFragmentFunc stream_peek_fragment;
 };
 
+/* Per-stream state that is not part of the public stream struct. The
+ * size of that is only known at runtime, so this is allocated right in
+ * front of it */
+typedef struct _GstAdaptiveDemuxStreamPrivate
+{
+  /* prefetching of the following fragments, see the prefetch-fragments
+   * property. The queue is owned by the download task, the rest is
+   * protected by the stream's fragment_download_lock */
+  GstUriDownloader *prefetch_downloader;
+  GQueue prefetch_queue;
+  guint prefetch_pending;
+  GstClockTime prefetch_last_end;
+  /* signalled when a prefetch finished or the stream got cancelled */
+  GCond prefetch_cond;
+} GstAdaptiveDemuxStreamPrivate;
+
+#define STREAM_PRIVATE_SIZE \
+    GST_ROUND_UP_16 (sizeof (GstAdaptiveDemuxStreamPrivate))
+#define STREAM_GET_PRIVATE(s) ((GstAdaptiveDemuxStreamPrivate *) \
+    ((guint8 *) (s) - STREAM_PRIVATE_SIZE))
+
+/* A download of a fragment following the current one of a stream, started
+ * before the stream gets to it */
+typedef struct _GstAdaptiveDemuxPrefetch
+{
+  GstAdaptiveDemuxStream *stream;
+  gchar *uri;
+  gint64 range_start;
+  gint64 range_end;
+  guint depth;
+
+  /* protected by the stream's fragment_download_lock */
+  gboolean done;
+  gboolean discarded;
+  GstBuffer *buffer;
+  GError *error;
+  GstClockTime download_start;
+  GstClockTime download_time;
+} GstAdaptiveDemuxPrefetch;
+
 typedef struct _GstAdaptiveDemuxTimer
 {
   volatile gint ref_count;
@@ -258,6 +305,8 @@ static gboolean gst_adaptive_demux_stream_select_bitrate (GstAdaptiveDemux *
 static GstFlowReturn
 gst_adaptive_demux_stream_update_fragment_info (GstAdaptiveDemux * demux,
     GstAdaptiveDemuxStream * stream);
+static void gst_adaptive_demux_stream_clear_prefetch (GstAdaptiveDemuxStream *
+    stream);
 static gint64
 gst_adaptive_demux_stream_get_fragment_waiting_time (GstAdaptiveDemux * demux,
     GstAdaptiveDemuxStream * stream);
@@ -361,6 +410,9 @@ gst_adaptive_demux_set_property (GObject * object, guint prop_id,
     case PROP_BITRATE_LIMIT:
       demux->bitrate_limit = g_value_get_float (value);
       break;
+    case PROP_PREFETCH_FRAGMENTS:
+      demux->priv->prefetch_fragments = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -385,6 +437,9 @@ gst_adaptive_demux_get_property (GObject * object, guint prop_id,
     case PROP_BITRATE_LIMIT:
       g_value_set_float (value, demux->bitrate_limit);
       break;
+    case PROP_PREFETCH_FRAGMENTS:
+      g_value_set_uint (value, demux->priv->prefetch_fragments);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -430,6 +485,25 @@ gst_adaptive_demux_class_init (GstAdaptiveDemuxClass * klass)
           0, 1, DEFAULT_BITRATE_LIMIT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAdaptiveDemux:prefetch-fragments:
+   *
+   * Number of fragments following the current one of each stream that are
+   * downloaded in parallel to it. This hides the request latency of the
+   * server when it is large compared to the fragment download time. At most
+   * that many fragments per stream are kept in memory. Only used if the
+   * subclass sets a #GstAdaptiveDemuxStreamPeekFragmentFunc with
+   * gst_adaptive_demux_set_stream_peek_fragment_func().
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_PREFETCH_FRAGMENTS,
+      g_param_spec_uint ("prefetch-fragments", "Prefetch fragments",
+          "Number of following fragments to download in parallel "
+          "(0 = disabled)", 0, MAX_PREFETCH_FRAGMENTS,
+          DEFAULT_PREFETCH_FRAGMENTS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_adaptive_demux_change_state;
 
   gstbin_class->handle_message = gst_adaptive_demux_handle_message;
@@ -522,6 +596,7 @@ gst_adaptive_demux_init (GstAdaptiveDemux * demux,
   /* Properties */
   demux->bitrate_limit = DEFAULT_BITRATE_LIMIT;
   demux->connection_speed = DEFAULT_CONNECTION_SPEED;
+  demux->priv->prefetch_fragments = DEFAULT_PREFETCH_FRAGMENTS;
 
   gst_element_add_pad (GST_ELEMENT (demux), demux->sinkpad);
 }
@@ -536,6 +611,8 @@ gst_adaptive_demux_finalize (GObject * object)
 
   g_object_unref (priv->input_adapter);
   g_object_unref (demux->downloader);
+  if (priv->prefetch_pool)
+    g_thread_pool_free (priv->prefetch_pool, FALSE, TRUE);
 
   g_mutex_clear (&priv->updates_timed_lock);
   g_cond_clear (&priv->updates_timed_cond);
@@ -934,6 +1011,28 @@ gst_adaptive_demux_set_stream_struct_size (GstAdaptiveDemux * demux,
   GST_API_UNLOCK (demux);
 }
 
+/**
+ * gst_adaptive_demux_set_stream_peek_fragment_func:
+ * @demux: #GstAdaptiveDemux
+ * @func: (nullable): a #GstAdaptiveDemuxStreamPeekFragmentFunc
+ *
+ * Sets the function used to look up the fragments following the current
+ * one of a stream. Prefetching (see #GstAdaptiveDemux:prefetch-fragments)
+ * is only done if this is set.
+ *
+ * Since: 1.18
+ */
+void
+gst_adaptive_demux_set_stream_peek_fragment_func (GstAdaptiveDemux * demux,
+    GstAdaptiveDemuxStreamPeekFragmentFunc func)
+{
+  GST_API_LOCK (demux);
+  GST_MANIFEST_LOCK (demux);
+  demux->priv->stream_peek_fragment = func;
+  GST_MANIFEST_UNLOCK (demux);
+  GST_API_UNLOCK (demux);
+}
+
 /* must be called with manifest_lock taken */
 static gboolean
 gst_adaptive_demux_prepare_stream (GstAdaptiveDemux * demux,
@@ -1282,6 +1381,7 @@ gst_adaptive_demux_expose_streams (GstAdaptiveDemux * demux)
       stream->cancelled = TRUE;
       stream->replaced = TRUE;
       g_cond_signal (&stream->fragment_download_cond);
+      g_cond_signal (&STREAM_GET_PRIVATE (stream)->prefetch_cond);
       g_mutex_unlock (&stream->fragment_download_lock);
     }
     gst_event_unref (eos);
@@ -1308,8 +1408,10 @@ GstAdaptiveDemuxStream *
 gst_adaptive_demux_stream_new (GstAdaptiveDemux * demux, GstPad * pad)
 {
   GstAdaptiveDemuxStream *stream;
+  GstAdaptiveDemuxStreamPrivate *priv;
 
-  stream = g_malloc0 (demux->stream_struct_size);
+  priv = g_malloc0 (STREAM_PRIVATE_SIZE + demux->stream_struct_size);
+  stream = (GstAdaptiveDemuxStream *) ((guint8 *) priv + STREAM_PRIVATE_SIZE);
 
   /* Downloading task */
   g_rec_mutex_init (&stream->download_lock);
@@ -1338,6 +1440,7 @@ gst_adaptive_demux_stream_new (GstAdaptiveDemux * demux, GstPad * pad)
   gst_segment_init (&stream->segment, GST_FORMAT_TIME);
   g_cond_init (&stream->fragment_download_cond);
   g_mutex_init (&stream->fragment_download_lock);
+  g_cond_init (&priv->prefetch_cond);
 
   demux->next_streams = g_list_append (demux->next_streams, stream);
 
@@ -1370,6 +1473,7 @@ gst_adaptive_demux_stream_free (GstAdaptiveDemuxStream * stream)
 {
   GstAdaptiveDemux *demux = stream->demux;
   GstAdaptiveDemuxClass *klass = GST_ADAPTIVE_DEMUX_GET_CLASS (demux);
+  GstAdaptiveDemuxStreamPrivate *priv = STREAM_GET_PRIVATE (stream);
 
   if (klass->stream_free)
     klass->stream_free (stream);
@@ -1385,6 +1489,7 @@ gst_adaptive_demux_stream_free (GstAdaptiveDemuxStream * stream)
       g_mutex_lock (&stream->fragment_download_lock);
       stream->cancelled = TRUE;
       g_cond_signal (&stream->fragment_download_cond);
+      g_cond_signal (&priv->prefetch_cond);
       g_mutex_unlock (&stream->fragment_download_lock);
     }
     GST_LOG_OBJECT (demux, "Waiting for task to finish");
@@ -1404,6 +1509,10 @@ gst_adaptive_demux_stream_free (GstAdaptiveDemuxStream * stream)
 
   gst_adaptive_demux_stream_fragment_clear (&stream->fragment);
 
+  gst_adaptive_demux_stream_clear_prefetch (stream);
+  if (priv->prefetch_downloader)
+    g_object_unref (priv->prefetch_downloader);
+
   if (stream->pending_segment) {
     gst_event_unref (stream->pending_segment);
     stream->pending_segment = NULL;
@@ -1437,6 +1546,7 @@ gst_adaptive_demux_stream_free (GstAdaptiveDemuxStream * stream)
 
   g_cond_clear (&stream->fragment_download_cond);
   g_mutex_clear (&stream->fragment_download_lock);
+  g_cond_clear (&priv->prefetch_cond);
   g_free (stream->fragment_bitrates);
 
   if (stream->pad) {
@@ -1448,7 +1558,7 @@ gst_adaptive_demux_stream_free (GstAdaptiveDemuxStream * stream)
 
   g_clear_pointer (&stream->pending_tags, gst_tag_list_unref);
 
-  g_free (stream);
+  g_free (priv);
 }
 
 /* must be called with manifest_lock taken */
@@ -2099,6 +2209,7 @@ gst_adaptive_demux_stop_tasks (GstAdaptiveDemux * demux, gboolean stop_updates)
       stream->cancelled = TRUE;
       gst_task_stop (stream->download_task);
       g_cond_signal (&stream->fragment_download_cond);
+      g_cond_signal (&STREAM_GET_PRIVATE (stream)->prefetch_cond);
       g_mutex_unlock (&stream->fragment_download_lock);
     }
     list_to_process = demux->prepared_streams;
@@ -2137,6 +2248,8 @@ gst_adaptive_demux_stop_tasks (GstAdaptiveDemux * demux, gboolean stop_updates)
        */
       gst_task_join (stream->download_task);
 
+      gst_adaptive_demux_stream_clear_prefetch (stream);
+
       GST_MANIFEST_LOCK (demux);
     }
     list_to_process = demux->prepared_streams;
@@ -2784,18 +2897,16 @@ _src_query (GstPad * pad, GstObject * parent, GstQuery * query)
   return gst_pad_peer_query (stream->pad, query);
 }
 
-static GstPadProbeReturn
-_uri_handler_probe (GstPad * pad, GstPadProbeInfo * info,
-    GstAdaptiveDemuxStream * stream)
+/* Measures the download from the data the source pushes, @now is the time
+ * it was received */
+static void
+_uri_handler_account (GstPad * pad, GstMiniObject * data,
+    GstAdaptiveDemuxStream * stream, GstClockTime now)
 {
-  GstPadProbeReturn ret = GST_PAD_PROBE_OK;
-
-  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER) {
-    GstBuffer *buf = GST_PAD_PROBE_INFO_BUFFER (info);
+  if (GST_IS_BUFFER (data)) {
+    GstBuffer *buf = GST_BUFFER_CAST (data);
     if (stream->fragment_bytes_downloaded == 0) {
-      stream->last_latency =
-          gst_adaptive_demux_get_monotonic_time (stream->demux) -
-          (stream->download_start_time * GST_USECOND);
+      stream->last_latency = now - (stream->download_start_time * GST_USECOND);
       GST_DEBUG_OBJECT (pad,
           "FIRST BYTE since download_start %" GST_TIME_FORMAT,
           GST_TIME_ARGS (stream->last_latency));
@@ -2804,9 +2915,8 @@ _uri_handler_probe (GstPad * pad, GstPadProbeInfo * info,
     GST_LOG_OBJECT (pad,
         "Received buffer, size %" G_GSIZE_FORMAT " total %" G_GUINT64_FORMAT,
         gst_buffer_get_size (buf), stream->fragment_bytes_downloaded);
-  } else if (GST_PAD_PROBE_INFO_TYPE (info) &
-      GST_PAD_PROBE_TYPE_EVENT_DOWNSTREAM) {
-    GstEvent *ev = GST_PAD_PROBE_INFO_EVENT (info);
+  } else if (GST_IS_EVENT (data)) {
+    GstEvent *ev = GST_EVENT_CAST (data);
     GST_LOG_OBJECT (pad, "Received event %s %" GST_PTR_FORMAT,
         GST_EVENT_TYPE_NAME (ev), ev);
     switch (GST_EVENT_TYPE (ev)) {
@@ -2816,8 +2926,7 @@ _uri_handler_probe (GstPad * pad, GstPadProbeInfo * info,
       case GST_EVENT_EOS:
       {
         stream->last_download_time =
-            gst_adaptive_demux_get_monotonic_time (stream->demux) -
-            (stream->download_start_time * GST_USECOND);
+            now - (stream->download_start_time * GST_USECOND);
         stream->last_bitrate =
             gst_util_uint64_scale (stream->fragment_bytes_downloaded,
             8 * GST_SECOND, stream->last_download_time);
@@ -2832,8 +2941,16 @@ _uri_handler_probe (GstPad * pad, GstPadProbeInfo * info,
         break;
     }
   }
+}
 
-  return ret;
+static GstPadProbeReturn
+_uri_handler_probe (GstPad * pad, GstPadProbeInfo * info,
+    GstAdaptiveDemuxStream * stream)
+{
+  _uri_handler_account (pad, GST_PAD_PROBE_INFO_DATA (info), stream,
+      gst_adaptive_demux_get_monotonic_time (stream->demux));
+
+  return GST_PAD_PROBE_OK;
 }
 
 /* must be called with manifest_lock taken.
@@ -3323,6 +3440,336 @@ gst_adaptive_demux_stream_download_header_fragment (GstAdaptiveDemuxStream *
   return ret;
 }
 
+static void
+gst_adaptive_demux_prefetch_free (GstAdaptiveDemuxPrefetch * prefetch)
+{
+  g_free (prefetch->uri);
+  if (prefetch->buffer)
+    gst_buffer_unref (prefetch->buffer);
+  g_clear_error (&prefetch->error);
+  g_free (prefetch);
+}
+
+/* must be called with the stream's fragment_download_lock taken.
+ * Prefetches that are still downloading are freed by their worker */
+static void
+gst_adaptive_demux_prefetch_discard (GstAdaptiveDemuxPrefetch * prefetch)
+{
+  if (prefetch->done)
+    gst_adaptive_demux_prefetch_free (prefetch);
+  else
+    prefetch->discarded = TRUE;
+}
+
+/* Runs in the prefetch thread pool */
+static void
+gst_adaptive_demux_prefetch_func (GstAdaptiveDemuxPrefetch * prefetch,
+    GstAdaptiveDemux * demux)
+{
+  GstAdaptiveDemuxStream *stream = prefetch->stream;
+  GstAdaptiveDemuxStreamPrivate *priv = STREAM_GET_PRIVATE (stream);
+  GstFragment *download = NULL;
+  GError *err = NULL;
+  GstClockTime start, end, busy_start;
+  gboolean discarded;
+
+  g_mutex_lock (&stream->fragment_download_lock);
+  discarded = prefetch->discarded;
+  g_mutex_unlock (&stream->fragment_download_lock);
+
+  start = gst_adaptive_demux_get_monotonic_time (demux);
+  if (!discarded) {
+    GST_DEBUG_OBJECT (stream->pad, "Prefetching %s, range:%" G_GINT64_FORMAT
+        " - %" G_GINT64_FORMAT, prefetch->uri, prefetch->range_start,
+        prefetch->range_end);
+    download =
+        gst_uri_downloader_fetch_uri_with_range (priv->prefetch_downloader,
+        prefetch->uri, NULL, FALSE, FALSE, TRUE, prefetch->range_start,
+        prefetch->range_end, &err);
+  }
+  end = gst_adaptive_demux_get_monotonic_time (demux);
+
+  g_mutex_lock (&stream->fragment_download_lock);
+  if (prefetch->discarded) {
+    gst_adaptive_demux_prefetch_free (prefetch);
+    g_clear_error (&err);
+  } else {
+    if (download)
+      prefetch->buffer = gst_fragment_get_buffer (download);
+    prefetch->error = err;
+
+    /* The prefetches of a stream overlap, so each one is only accounted the
+     * time since the previous one finished. Summed up that is the time the
+     * connection was busy, which makes the bitrate estimate the throughput
+     * of all downloads together. Downloads finishing at about the same time
+     * would give bogus values though, so each one is accounted at least its
+     * share of the time it was running in parallel to the others. */
+    busy_start = MAX (start, priv->prefetch_last_end);
+    prefetch->download_start = start;
+    prefetch->download_time =
+        MAX (end - busy_start, (end - start) / prefetch->depth);
+    prefetch->done = TRUE;
+  }
+  priv->prefetch_last_end = MAX (priv->prefetch_last_end, end);
+  priv->prefetch_pending--;
+  g_cond_broadcast (&priv->prefetch_cond);
+  g_mutex_unlock (&stream->fragment_download_lock);
+
+  if (download)
+    g_object_unref (download);
+}
+
+/* must be called with manifest_lock taken.
+ * Starts downloading the fragments following the current one, up to the
+ * configured depth. The prefetch queue is only modified by the download task,
+ * or while it is stopped */
+static void
+gst_adaptive_demux_stream_prefetch (GstAdaptiveDemux * demux,
+    GstAdaptiveDemuxStream * stream)
+{
+  GstAdaptiveDemuxStreamPrivate *priv = STREAM_GET_PRIVATE (stream);
+  guint depth = demux->priv->prefetch_fragments;
+  guint n;
+
+  if (depth == 0 || demux->priv->stream_peek_fragment == NULL)
+    return;
+
+  if (demux->priv->prefetch_pool == NULL) {
+    demux->priv->prefetch_pool =
+        g_thread_pool_new ((GFunc) gst_adaptive_demux_prefetch_func, demux, -1,
+        FALSE, NULL);
+  }
+  if (priv->prefetch_downloader == NULL) {
+    priv->prefetch_downloader = gst_uri_downloader_new ();
+    gst_uri_downloader_set_parent (priv->prefetch_downloader,
+        GST_ELEMENT_CAST (demux));
+  }
+
+  for (n = g_queue_get_length (&priv->prefetch_queue) + 1; n <= depth; n++) {
+    GstAdaptiveDemuxStreamFragment fragment = { 0, };
+    GstAdaptiveDemuxPrefetch *prefetch;
+
+    fragment.range_end = -1;
+    if (!demux->priv->stream_peek_fragment (stream, n, &fragment)
+        || fragment.uri == NULL) {
+      gst_adaptive_demux_stream_fragment_clear (&fragment);
+      break;
+    }
+
+    prefetch = g_new0 (GstAdaptiveDemuxPrefetch, 1);
+    prefetch->stream = stream;
+    prefetch->uri = fragment.uri;
+    prefetch->range_start = fragment.range_start;
+    prefetch->range_end = fragment.range_end;
+    prefetch->depth = depth;
+    fragment.uri = NULL;
+    gst_adaptive_demux_stream_fragment_clear (&fragment);
+
+    g_mutex_lock (&stream->fragment_download_lock);
+    if (G_UNLIKELY (stream->cancelled)) {
+      g_mutex_unlock (&stream->fragment_download_lock);
+      gst_adaptive_demux_prefetch_free (prefetch);
+      break;
+    }
+    g_queue_push_tail (&priv->prefetch_queue, prefetch);
+    priv->prefetch_pending++;
+    g_mutex_unlock (&stream->fragment_download_lock);
+
+    g_thread_pool_push (demux->priv->prefetch_pool, prefetch, NULL);
+  }
+}
+
+static gint
+gst_adaptive_demux_prefetch_compare (GstAdaptiveDemuxPrefetch * prefetch,
+    GstAdaptiveDemuxStreamFragment * fragment)
+{
+  if (prefetch->range_start != fragment->range_start
+      || prefetch->range_end != fragment->range_end)
+    return 1;
+
+  return g_strcmp0 (prefetch->uri, fragment->uri);
+}
+
+/* must be called with manifest_lock taken.
+ * Returns the prefetch of the current fragment if there is one. Everything
+ * before it was skipped, and if there is none the whole queue is stale, e.g.
+ * after a bitrate switch. Either way those are dropped */
+static GstAdaptiveDemuxPrefetch *
+gst_adaptive_demux_stream_take_prefetch (GstAdaptiveDemuxStream * stream)
+{
+  GstAdaptiveDemuxStreamPrivate *priv = STREAM_GET_PRIVATE (stream);
+  GstAdaptiveDemuxPrefetch *prefetch = NULL;
+  GList *link;
+  guint dropped = 0;
+
+  if (g_queue_is_empty (&priv->prefetch_queue))
+    return NULL;
+
+  link = g_queue_find_custom (&priv->prefetch_queue, &stream->fragment,
+      (GCompareFunc) gst_adaptive_demux_prefetch_compare);
+
+  g_mutex_lock (&stream->fragment_download_lock);
+  while (!g_queue_is_empty (&priv->prefetch_queue)) {
+    gboolean found = (priv->prefetch_queue.head == link);
+
+    prefetch = g_queue_pop_head (&priv->prefetch_queue);
+    if (found)
+      break;
+    gst_adaptive_demux_prefetch_discard (prefetch);
+    prefetch = NULL;
+    dropped++;
+  }
+  g_mutex_unlock (&stream->fragment_download_lock);
+
+  if (dropped > 0) {
+    GST_DEBUG_OBJECT (stream->pad, "Dropped %u stale prefetched fragments",
+        dropped);
+  }
+
+  return prefetch;
+}
+
+/* Drops all prefetches of the stream and waits until the ongoing downloads
+ * are aborted. The download task must not be running */
+static void
+gst_adaptive_demux_stream_clear_prefetch (GstAdaptiveDemuxStream * stream)
+{
+  GstAdaptiveDemuxStreamPrivate *priv = STREAM_GET_PRIVATE (stream);
+  GstAdaptiveDemuxPrefetch *prefetch;
+  gboolean pending;
+
+  g_mutex_lock (&stream->fragment_download_lock);
+  while ((prefetch = g_queue_pop_head (&priv->prefetch_queue)))
+    gst_adaptive_demux_prefetch_discard (prefetch);
+  pending = priv->prefetch_pending > 0;
+  g_mutex_unlock (&stream->fragment_download_lock);
+
+  if (!pending)
+    return;
+
+  /* also aborts the fetches of workers that did not start yet */
+  gst_uri_downloader_stop (priv->prefetch_downloader);
+
+  g_mutex_lock (&stream->fragment_download_lock);
+  while (priv->prefetch_pending > 0)
+    g_cond_wait (&priv->prefetch_cond, &stream->fragment_download_lock);
+  g_mutex_unlock (&stream->fragment_download_lock);
+
+  gst_uri_downloader_reset (priv->prefetch_downloader);
+}
+
+/* must be called with manifest_lock taken.
+ * Can temporarily release manifest_lock
+ *
+ * Waits for @prefetch and passes its data on like download_uri() does for a
+ * regular download. Returns %FALSE if the prefetch failed and the fragment has
+ * to be downloaded again */
+static gboolean
+gst_adaptive_demux_stream_push_prefetch (GstAdaptiveDemux * demux,
+    GstAdaptiveDemuxStream * stream, GstAdaptiveDemuxPrefetch * prefetch,
+    GstFlowReturn * ret)
+{
+  GstAdaptiveDemuxStreamPrivate *priv = STREAM_GET_PRIVATE (stream);
+  GstBuffer *buffer;
+  GstEvent *event;
+  GstSegment segment;
+  GstPad *pad;
+  GstClockTime now, download_end;
+  gchar *stream_id;
+  gsize size;
+
+  /* the source pad of the regular downloads takes the data */
+  if (stream->internal_pad == NULL) {
+    g_mutex_lock (&stream->fragment_download_lock);
+    gst_adaptive_demux_prefetch_discard (prefetch);
+    g_mutex_unlock (&stream->fragment_download_lock);
+    return FALSE;
+  }
+
+  GST_MANIFEST_UNLOCK (demux);
+  g_mutex_lock (&stream->fragment_download_lock);
+  while (!stream->cancelled && !prefetch->done) {
+    g_cond_wait (&priv->prefetch_cond, &stream->fragment_download_lock);
+  }
+  if (G_UNLIKELY (stream->cancelled)) {
+    gst_adaptive_demux_prefetch_discard (prefetch);
+    g_mutex_unlock (&stream->fragment_download_lock);
+    GST_MANIFEST_LOCK (demux);
+    *ret = stream->last_ret = GST_FLOW_FLUSHING;
+    return TRUE;
+  }
+  g_mutex_unlock (&stream->fragment_download_lock);
+  GST_MANIFEST_LOCK (demux);
+
+  if (prefetch->buffer == NULL) {
+    GST_INFO_OBJECT (stream->pad, "Prefetching %s failed: %s", prefetch->uri,
+        prefetch->error ? prefetch->error->message : "no data");
+    gst_adaptive_demux_prefetch_free (prefetch);
+    return FALSE;
+  }
+
+  buffer = prefetch->buffer;
+  prefetch->buffer = NULL;
+  size = gst_buffer_get_size (buffer);
+
+  GST_DEBUG_OBJECT (stream->pad, "Using prefetched %s, %" G_GSIZE_FORMAT
+      " bytes in %" GST_TIME_FORMAT, prefetch->uri, size,
+      GST_TIME_ARGS (prefetch->download_time));
+
+  /* the data is measured by the same probe as for regular downloads. It
+   * arrived when the stream was done waiting for it, and finished after the
+   * time the prefetch is accounted for */
+  stream->download_start_time =
+      GST_TIME_AS_USECONDS (prefetch->download_start);
+  now = gst_adaptive_demux_get_monotonic_time (demux);
+  download_end = prefetch->download_start + MAX (prefetch->download_time, 1);
+  gst_adaptive_demux_prefetch_free (prefetch);
+
+  /* what _src_chain() works out from the size reported by the source */
+  if (stream->fragment.bitrate == 0 && stream->fragment.duration != 0) {
+    stream->fragment.bitrate = MIN (G_MAXUINT, gst_util_uint64_scale (size,
+            8 * GST_SECOND, stream->fragment.duration));
+  }
+  if (stream->fragment.bitrate)
+    stream->bitrate_changed = TRUE;
+  stream->downloading_first_buffer = FALSE;
+
+  g_mutex_lock (&stream->fragment_download_lock);
+  stream->download_finished = FALSE;
+  g_mutex_unlock (&stream->fragment_download_lock);
+
+  /* and passed on like the source would do it, the EOS finishes the
+   * fragment */
+  pad = stream->internal_pad;
+  stream_id = g_strdup_printf ("%s/prefetch", GST_PAD_NAME (pad));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  GST_MANIFEST_UNLOCK (demux);
+
+  gst_pad_send_event (pad, gst_event_new_stream_start (stream_id));
+  event = gst_event_new_segment (&segment);
+  _uri_handler_account (pad, GST_MINI_OBJECT_CAST (event), stream, now);
+  gst_pad_send_event (pad, event);
+
+  _uri_handler_account (pad, GST_MINI_OBJECT_CAST (buffer), stream, now);
+  if (gst_pad_chain (pad, buffer) == GST_FLOW_OK) {
+    event = gst_event_new_eos ();
+    _uri_handler_account (pad, GST_MINI_OBJECT_CAST (event), stream,
+        download_end);
+    gst_pad_send_event (pad, event);
+  }
+
+  GST_MANIFEST_LOCK (demux);
+  g_free (stream_id);
+
+  /* make the pad fresh again for the next download */
+  gst_pad_set_active (pad, FALSE);
+  gst_pad_set_active (pad, TRUE);
+
+  *ret = stream->last_ret;
+
+  return TRUE;
+}
+
 /* must be called with manifest_lock taken.
  * Can temporarily release manifest_lock
  */
@@ -3441,9 +3888,21 @@ again:
         chunk_end = MIN (chunk_end, range_end);
     }
   } else {
-    ret =
-        gst_adaptive_demux_stream_download_uri (demux, stream, url,
-        stream->fragment.range_start, stream->fragment.range_end, &http_status);
+    GstAdaptiveDemuxPrefetch *prefetch;
+
+    prefetch = gst_adaptive_demux_stream_take_prefetch (stream);
+
+    /* keep the following fragments downloading meanwhile */
+    gst_adaptive_demux_stream_prefetch (demux, stream);
+
+    if (prefetch == NULL
+        || !gst_adaptive_demux_stream_push_prefetch (demux, stream, prefetch,
+            &ret)) {
+      ret =
+          gst_adaptive_demux_stream_download_uri (demux, stream, url,
+          stream->fragment.range_start, stream->fragment.range_end,
+          &http_status);
+    }
     GST_DEBUG_OBJECT (stream->pad, "Fragment download result: %d (%d) %s",
         stream->last_ret, http_status, gst_flow_get_name (stream->last_ret));
   }
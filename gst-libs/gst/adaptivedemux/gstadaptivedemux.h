@@ -122,6 +122,25 @@ struct _GstAdaptiveDemuxStreamFragment
   gboolean finished;
 };
 
+/**
+ * GstAdaptiveDemuxStreamPeekFragmentFunc:
+ * @stream: #GstAdaptiveDemuxStream
+ * @n: how many fragments after the current one
+ * @fragment: #GstAdaptiveDemuxStreamFragment to fill
+ *
+ * Fills the uri, range and duration of the @n-th fragment after the current
+ * one into @fragment, without changing the state of the stream. Used to
+ * download the following fragments in parallel when prefetching is enabled.
+ * Fragments that may not be available yet must not be returned.
+ *
+ * Returns: %TRUE if @fragment was filled.
+ *
+ * Since: 1.18
+ */
+typedef gboolean (*GstAdaptiveDemuxStreamPeekFragmentFunc) (GstAdaptiveDemuxStream * stream,
+                                                            guint n,
+                                                            GstAdaptiveDemuxStreamFragment * fragment);
+
 struct _GstAdaptiveDemuxStream
 {
   GstPad *pad;
@@ -491,6 +510,10 @@ GST_ADAPTIVE_DEMUX_API
 void     gst_adaptive_demux_set_stream_struct_size (GstAdaptiveDemux * demux,
                                                     gsize struct_size);
 
+GST_ADAPTIVE_DEMUX_API
+void     gst_adaptive_demux_set_stream_peek_fragment_func (GstAdaptiveDemux * demux,
+                                                           GstAdaptiveDemuxStreamPeekFragmentFunc func);
+
 
 GST_ADAPTIVE_DEMUX_API
 GstAdaptiveDemuxStream *gst_adaptive_demux_stream_new (GstAdaptiveDemux * demux,
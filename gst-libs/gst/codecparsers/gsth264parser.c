@@ -41,6 +41,9 @@
  *
  *   * #gst_h264_parser_identify_nalu_avc to identify a NAL unit in an AVC type bitstream
  *
+ * All the NAL units of an Annex B type buffer, e.g. an access unit, can also
+ * be found in a single pass with #gst_h264_parser_index_nalus.
+ *
  * The following functions are then available for parsing the structure of the
  * #GstH264NalUnit, depending on the #GstH264NalUnitType:
  *
@@ -251,6 +254,33 @@ gst_h264_parse_nalu_header (GstH264NalUnit * nalu)
   return TRUE;
 }
 
+static gboolean
+gst_h264_parse_nalu_entry_header (GstH264NalUnitEntry * entry,
+    const guint8 * data)
+{
+  if (entry->size < 1)
+    return FALSE;
+
+  entry->type = (data[entry->offset] & 0x1f);
+  entry->ref_idc = (data[entry->offset] & 0x60) >> 5;
+  entry->header_bytes = 1;
+
+  if (entry->type == GST_H264_NAL_PREFIX_UNIT
+      || entry->type == GST_H264_NAL_SLICE_EXT) {
+    if (entry->size < 4)
+      return FALSE;
+    entry->header_bytes += 3;
+  }
+
+  /* sc might have 2 or 3 0-bytes */
+  if (entry->sc_offset > 0 && data[entry->sc_offset - 1] == 00
+      && (entry->type == GST_H264_NAL_SPS || entry->type == GST_H264_NAL_PPS
+          || entry->type == GST_H264_NAL_AU_DELIMITER))
+    entry->sc_offset--;
+
+  return TRUE;
+}
+
 /*
  * gst_h264_pps_copy:
  * @dst_pps: The destination #GstH264PPS to copy into
@@ -1461,6 +1491,99 @@ beach:
   return res;
 }
 
+/**
+ * gst_h264_parser_index_nalus:
+ * @nalparser: a #GstH264NalParser
+ * @data: The data to index, containing Annex B coded NAL units
+ * @offset: the offset in @data from which to index NAL units
+ * @size: the size of @data
+ * @entries: (array length=max_entries) (out caller-allocates): The
+ *  #GstH264NalUnitEntry array to store the found NAL units in
+ * @max_entries: the number of entries in @entries
+ * @n_entries: (out): the number of NAL units stored in @entries
+ *
+ * Finds all Annex B coded NAL units in @data, e.g. those of an access unit,
+ * in a single pass and stores their positions, headers and number of
+ * emulation prevention bytes in @entries. Unlike with
+ * gst_h264_parser_identify_nalu() the last NAL unit ends at the end of
+ * @data. NAL units too small to hold their header are skipped.
+ *
+ * If there are more than @max_entries NAL units, indexing stops after
+ * @max_entries of them and can be continued from the end of the last one.
+ *
+ * Returns: %GST_H264_PARSER_OK if NAL units were found,
+ *  %GST_H264_PARSER_NO_NAL if not
+ *
+ * Since: 1.18
+ */
+GstH264ParserResult
+gst_h264_parser_index_nalus (GstH264NalParser * nalparser,
+    const guint8 * data, guint offset, gsize size,
+    GstH264NalUnitEntry * entries, guint max_entries, guint * n_entries)
+{
+  GstH264NalUnitEntry *entry = NULL;
+  guint n = 0, n_epb = 0, pos, end;
+  gint off;
+
+  g_return_val_if_fail (data != NULL, GST_H264_PARSER_ERROR);
+  g_return_val_if_fail (entries != NULL || max_entries == 0,
+      GST_H264_PARSER_ERROR);
+  g_return_val_if_fail (n_entries != NULL, GST_H264_PARSER_ERROR);
+
+  *n_entries = 0;
+
+  if (size < offset + 4) {
+    GST_DEBUG ("Can't index, buffer has too small size %" G_GSIZE_FORMAT
+        ", offset %u", size, offset);
+    return GST_H264_PARSER_ERROR;
+  }
+
+  pos = offset;
+  while (TRUE) {
+    off = scan_for_start_codes_or_epb (data + pos, size - pos);
+
+    /* emulation prevention bytes are only counted */
+    if (off >= 0 && data[pos + off + 2] == 0x03) {
+      n_epb++;
+      pos += off + 3;
+      continue;
+    }
+
+    /* anything up to here belongs to the current NAL unit, except for
+     * trailing zero bytes or the first byte of a 4 byte start code */
+    if (entry) {
+      end = off >= 0 ? pos + off : size;
+      if (off >= 0) {
+        while (end > entry->offset && data[end - 1] == 00)
+          end--;
+      }
+      entry->size = end - entry->offset;
+      entry->n_epb = n_epb;
+
+      if (gst_h264_parse_nalu_entry_header (entry, data)) {
+        GST_LOG ("Nal type %u at offset %u, size %u", entry->type,
+            entry->offset, entry->size);
+        n++;
+      } else {
+        GST_WARNING ("skipping too small nal at offset %u", entry->offset);
+      }
+      entry = NULL;
+    }
+
+    if (off < 0 || n == max_entries)
+      break;
+
+    entry = &entries[n];
+    entry->sc_offset = pos + off;
+    entry->offset = pos + off + 3;
+    n_epb = 0;
+    pos = entry->offset;
+  }
+
+  *n_entries = n;
+
+  return n > 0 ? GST_H264_PARSER_OK : GST_H264_PARSER_NO_NAL;
+}
 
 /**
  * gst_h264_parser_identify_nalu_avc:
@@ -327,6 +327,7 @@ typedef enum
 typedef struct _GstH264NalParser              GstH264NalParser;
 
 typedef struct _GstH264NalUnit                GstH264NalUnit;
+typedef struct _GstH264NalUnitEntry           GstH264NalUnitEntry;
 typedef struct _GstH264NalUnitExtensionMVC    GstH264NalUnitExtensionMVC;
 
 typedef struct _GstH264SPSExtMVCView          GstH264SPSExtMVCView;
@@ -431,6 +432,39 @@ struct _GstH264NalUnit
   } extension;
 };
 
+/**
+ * GstH264NalUnitEntry:
+ * @sc_offset: The offset of the first byte of the start code of
+ *  the NAL unit.
+ * @offset: The offset of the first byte of the NAL unit header,
+ *  just after the start code.
+ * @size: The size of the NAL unit starting from @offset, thus
+ *  including the header bytes but not the start code.
+ * @n_epb: The number of emulation prevention bytes in the NAL unit.
+ * @type: A #GstH264NalUnitType
+ * @ref_idc: The nal_ref_idc of the NAL unit
+ * @header_bytes: The size of the NALU header in bytes, including
+ *  the extension header bytes of prefix and extension NALs.
+ *
+ * A NAL unit found by gst_h264_parser_index_nalus(). To parse the
+ * NAL unit further, identify it again with
+ * gst_h264_parser_identify_nalu_unchecked() on @sc_offset and
+ * @offset + @size, which does not need to scan for its end.
+ *
+ * Since: 1.18
+ */
+struct _GstH264NalUnitEntry
+{
+  guint sc_offset;
+  guint offset;
+  guint size;
+  guint n_epb;
+
+  guint8 type;
+  guint8 ref_idc;
+  guint8 header_bytes;
+};
+
 /**
  * GstH264HRDParams:
  * @cpb_cnt_minus1: plus 1 specifies the number of alternative
@@ -1093,6 +1127,12 @@ GstH264ParserResult gst_h264_parser_identify_nalu_unchecked (GstH264NalParser *n
                                                        const guint8 *data, guint offset,
                                                        gsize size, GstH264NalUnit *nalu);
 
+GST_CODEC_PARSERS_API
+GstH264ParserResult gst_h264_parser_index_nalus       (GstH264NalParser *nalparser,
+                                                       const guint8 *data, guint offset,
+                                                       gsize size, GstH264NalUnitEntry *entries,
+                                                       guint max_entries, guint *n_entries);
+
 GST_CODEC_PARSERS_API
 GstH264ParserResult gst_h264_parser_identify_nalu_avc (GstH264NalParser *nalparser, const guint8 *data,
                                                        guint offset, gsize size, guint8 nal_length_size,
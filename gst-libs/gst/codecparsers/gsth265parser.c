@@ -34,6 +34,9 @@
  *   * gst_h265_parser_identify_nalu_hevc() to identify the nalu in
  *        HEVC bitstreams
  *
+ * All the nal units of a non-HEVC buffer, e.g. an access unit, can also be
+ * found in a single pass with gst_h265_parser_index_nalus().
+ *
  * Then, depending on the #GstH265NalUnitType of the newly parsed #GstH265NalUnit,
  * you should call the differents functions to parse the structure:
  *
@@ -251,6 +254,26 @@ gst_h265_parse_nalu_header (GstH265NalUnit * nalu)
   return TRUE;
 }
 
+static gboolean
+gst_h265_parse_nalu_entry_header (GstH265NalUnitEntry * entry,
+    const guint8 * data)
+{
+  if (entry->size < 2)
+    return FALSE;
+
+  entry->type = (data[entry->offset] >> 1) & 0x3f;
+  entry->layer_id = ((data[entry->offset] & 0x01) << 5) |
+      (data[entry->offset + 1] >> 3);
+  entry->temporal_id_plus1 = data[entry->offset + 1] & 0x07;
+  entry->header_bytes = 2;
+
+  /* sc might have 2 or 3 0-bytes */
+  if (entry->sc_offset > 0 && data[entry->sc_offset - 1] == 00)
+    entry->sc_offset--;
+
+  return TRUE;
+}
+
 /****** Parsing functions *****/
 
 static gboolean
@@ -1437,6 +1460,100 @@ beach:
   return res;
 }
 
+/**
+ * gst_h265_parser_index_nalus:
+ * @parser: a #GstH265Parser
+ * @data: The data to index, containing non-HEVC bitstream nal units
+ * @offset: the offset from which to index @data
+ * @size: the size of @data
+ * @entries: (array length=max_entries) (out caller-allocates): The
+ *  #GstH265NalUnitEntry array to store the found nal units in
+ * @max_entries: the number of entries in @entries
+ * @n_entries: (out): the number of nal units stored in @entries
+ *
+ * Finds all nal units in @data, e.g. those of an access unit, in a single
+ * pass and stores their positions, headers and number of emulation
+ * prevention bytes in @entries. Unlike with gst_h265_parser_identify_nalu()
+ * the last nal unit ends at the end of @data. Nal units too small to hold
+ * their header are skipped.
+ *
+ * If there are more than @max_entries nal units, indexing stops after
+ * @max_entries of them and can be continued from the end of the last one.
+ *
+ * Returns: %GST_H265_PARSER_OK if nal units were found,
+ *  %GST_H265_PARSER_NO_NAL if not
+ *
+ * Since: 1.18
+ */
+GstH265ParserResult
+gst_h265_parser_index_nalus (GstH265Parser * parser, const guint8 * data,
+    guint offset, gsize size, GstH265NalUnitEntry * entries,
+    guint max_entries, guint * n_entries)
+{
+  GstH265NalUnitEntry *entry = NULL;
+  guint n = 0, n_epb = 0, pos, end;
+  gint off;
+
+  g_return_val_if_fail (data != NULL, GST_H265_PARSER_ERROR);
+  g_return_val_if_fail (entries != NULL || max_entries == 0,
+      GST_H265_PARSER_ERROR);
+  g_return_val_if_fail (n_entries != NULL, GST_H265_PARSER_ERROR);
+
+  *n_entries = 0;
+
+  if (size < offset + 4) {
+    GST_DEBUG ("Can't index, buffer has too small size %" G_GSIZE_FORMAT
+        ", offset %u", size, offset);
+    return GST_H265_PARSER_ERROR;
+  }
+
+  pos = offset;
+  while (TRUE) {
+    off = scan_for_start_codes_or_epb (data + pos, size - pos);
+
+    /* emulation prevention bytes are only counted */
+    if (off >= 0 && data[pos + off + 2] == 0x03) {
+      n_epb++;
+      pos += off + 3;
+      continue;
+    }
+
+    /* anything up to here belongs to the current nal unit, except for
+     * trailing zero bytes or the first byte of a 4 byte start code */
+    if (entry) {
+      end = off >= 0 ? pos + off : size;
+      if (off >= 0) {
+        while (end > entry->offset && data[end - 1] == 00)
+          end--;
+      }
+      entry->size = end - entry->offset;
+      entry->n_epb = n_epb;
+
+      if (gst_h265_parse_nalu_entry_header (entry, data)) {
+        GST_LOG ("Nal type %u at offset %u, size %u", entry->type,
+            entry->offset, entry->size);
+        n++;
+      } else {
+        GST_WARNING ("skipping too small nal at offset %u", entry->offset);
+      }
+      entry = NULL;
+    }
+
+    if (off < 0 || n == max_entries)
+      break;
+
+    entry = &entries[n];
+    entry->sc_offset = pos + off;
+    entry->offset = pos + off + 3;
+    n_epb = 0;
+    pos = entry->offset;
+  }
+
+  *n_entries = n;
+
+  return n > 0 ? GST_H265_PARSER_OK : GST_H265_PARSER_NO_NAL;
+}
+
 /**
  * gst_h265_parser_identify_nalu_hevc:
  * @parser: a #GstH265Parser
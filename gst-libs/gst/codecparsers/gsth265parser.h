@@ -357,6 +357,7 @@ typedef enum
 typedef struct _GstH265Parser                   GstH265Parser;
 
 typedef struct _GstH265NalUnit                  GstH265NalUnit;
+typedef struct _GstH265NalUnitEntry             GstH265NalUnitEntry;
 
 typedef struct _GstH265VPS                      GstH265VPS;
 typedef struct _GstH265SPS                      GstH265SPS;
@@ -413,6 +414,37 @@ struct _GstH265NalUnit
   guint8 header_bytes;
 };
 
+/**
+ * GstH265NalUnitEntry:
+ * @sc_offset: The offset of the start code of the nal unit
+ * @offset: The offset of the actual start of the nal unit
+ * @size: The size of the nal unit starting from @offset
+ * @n_epb: The number of emulation prevention bytes in the nal unit
+ * @type: A #GstH265NalUnitType
+ * @layer_id: A nal unit layer id
+ * @temporal_id_plus1: A nal unit temporal identifier
+ * @header_bytes: The size of the nal unit header in bytes
+ *
+ * A nal unit found by gst_h265_parser_index_nalus(). To parse the nal
+ * unit further, identify it again with
+ * gst_h265_parser_identify_nalu_unchecked() on @sc_offset and
+ * @offset + @size, which does not need to scan for its end.
+ *
+ * Since: 1.18
+ */
+struct _GstH265NalUnitEntry
+{
+  guint sc_offset;
+  guint offset;
+  guint size;
+  guint n_epb;
+
+  guint8 type;
+  guint8 layer_id;
+  guint8 temporal_id_plus1;
+  guint8 header_bytes;
+};
+
 /**
  * GstH265ProfileTierLevel:
  * @profile_space: specifies the context for the interpretation of
@@ -1435,6 +1467,15 @@ GstH265ParserResult gst_h265_parser_identify_nalu_unchecked (GstH265Parser * par
                                                         gsize            size,
                                                         GstH265NalUnit * nalu);
 
+GST_CODEC_PARSERS_API
+GstH265ParserResult gst_h265_parser_index_nalus        (GstH265Parser       * parser,
+                                                        const guint8        * data,
+                                                        guint                 offset,
+                                                        gsize                 size,
+                                                        GstH265NalUnitEntry * entries,
+                                                        guint                 max_entries,
+                                                        guint               * n_entries);
+
 GST_CODEC_PARSERS_API
 GstH265ParserResult gst_h265_parser_identify_nalu_hevc (GstH265Parser  * parser,
                                                         const guint8   * data,
@@ -35,6 +35,7 @@
 
 #include "gstvc1parser.h"
 #include "parserutils.h"
+#include "nalutils.h"
 #include <gst/base/gstbytereader.h>
 #include <gst/base/gstbytewriter.h>
 #include <gst/base/gstbitreader.h>
@@ -681,17 +682,6 @@ failed:
   return FALSE;
 }
 
-static inline gint
-scan_for_start_codes (const guint8 * data, guint size)
-{
-  GstByteReader br;
-  gst_byte_reader_init (&br, data, size);
-
-  /* NALU not empty, so we can at least expect 1 (even 2) bytes following sc */
-  return gst_byte_reader_masked_scan_uint32 (&br, 0xffffff00, 0x00000100,
-      0, size);
-}
-
 static inline gint
 get_unary (GstBitReader * br, gint stop, gint len)
 {
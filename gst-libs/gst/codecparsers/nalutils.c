@@ -37,6 +37,12 @@
 
 #include "nalutils.h"
 
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 /* Compute Ceil(Log2(v)) */
 /* Derived from branchless code for integer log2(v) from:
    <http://graphics.stanford.edu/~seander/bithacks.html#IntegerLog> */
@@ -294,13 +300,99 @@ nal_reader_has_more_data (NalReader * nr)
 
 /***********  end of nal parser ***************/
 
+/* Returns the offset of the first 0x000001 prefix in @data, or of the first
+ * 0x000003 one too if @epb is set, for which @need bytes are available
+ * starting at the prefix. Returns -1 if there is none. This is the hot loop
+ * of every start code based parser, so it is vectorized where possible, and
+ * inlined so the checks on @epb and @need are resolved at compile time. */
+static inline gint
+scan_for_prefix (const guint8 * data, guint size, gboolean epb, guint need)
+{
+  guint i = 0;
+  guint8 b;
+
+  if (G_UNLIKELY (size < need))
+    return -1;
+
+#if defined (__SSE2__)
+  {
+    const __m128i zero = _mm_setzero_si128 ();
+    const __m128i one = _mm_set1_epi8 (1);
+    const __m128i three = _mm_set1_epi8 (3);
+    __m128i m, third;
+    gint mask;
+
+    /* checks the 16 positions i to i + 15, which reads up to i + 17 and
+     * needs @need bytes from i + 15 */
+    for (; i + 15 + need <= size; i += 16) {
+      third = _mm_loadu_si128 ((const __m128i *) (data + i + 2));
+      m = _mm_cmpeq_epi8 (third, one);
+      if (epb)
+        m = _mm_or_si128 (m, _mm_cmpeq_epi8 (third, three));
+      m = _mm_and_si128 (m,
+          _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i *) (data + i)),
+              zero));
+      m = _mm_and_si128 (m,
+          _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i *) (data + i + 1)),
+              zero));
+      mask = _mm_movemask_epi8 (m);
+      if (mask)
+        return i + g_bit_nth_lsf (mask, -1);
+    }
+  }
+#elif defined (__ARM_NEON)
+  {
+    const uint8x16_t zero = vdupq_n_u8 (0);
+    const uint8x16_t one = vdupq_n_u8 (1);
+    const uint8x16_t three = vdupq_n_u8 (3);
+    uint8x16_t m, third;
+    uint64x2_t m64;
+
+    for (; i + 15 + need <= size; i += 16) {
+      third = vld1q_u8 (data + i + 2);
+      m = vceqq_u8 (third, one);
+      if (epb)
+        m = vorrq_u8 (m, vceqq_u8 (third, three));
+      m = vandq_u8 (m, vceqq_u8 (vld1q_u8 (data + i), zero));
+      m = vandq_u8 (m, vceqq_u8 (vld1q_u8 (data + i + 1), zero));
+      m64 = vreinterpretq_u64_u8 (m);
+      /* The scalar loop below finds the exact position within this block */
+      if (vgetq_lane_u64 (m64, 0) | vgetq_lane_u64 (m64, 1))
+        break;
+    }
+  }
+#endif
+
+  /* skip ahead as far as the third byte allows */
+  while (i + need <= size) {
+    b = data[i + 2];
+    if (b != 0 && b != 1 && !(epb && b == 3)) {
+      i += 3;
+    } else if (data[i + 1]) {
+      i += 2;
+    } else if (data[i] || b == 0) {
+      i++;
+    } else {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+/* Returns the offset of the first 0x000001 start code prefix in @data that
+ * is followed by at least one more byte, or -1 if there is none. */
 gint
 scan_for_start_codes (const guint8 * data, guint size)
 {
-  GstByteReader br;
-  gst_byte_reader_init (&br, data, size);
-
   /* NALU not empty, so we can at least expect 1 (even 2) bytes following sc */
-  return gst_byte_reader_masked_scan_uint32 (&br, 0xffffff00, 0x00000100,
-      0, size);
+  return scan_for_prefix (data, size, FALSE, 4);
+}
+
+/* Returns the offset of the first 0x000001 start code prefix or 0x000003
+ * emulation prevention prefix in @data, or -1 if there is none. */
+gint
+scan_for_start_codes_or_epb (const guint8 * data, guint size)
+{
+  return scan_for_prefix (data, size, TRUE, 3);
 }
@@ -182,3 +182,6 @@ gboolean nal_reader_get_se (NalReader * nr, gint32 * val);
 
 G_GNUC_INTERNAL
 gint scan_for_start_codes (const guint8 * data, guint size);
+
+G_GNUC_INTERNAL
+gint scan_for_start_codes_or_epb (const guint8 * data, guint size);
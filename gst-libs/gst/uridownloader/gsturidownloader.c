@@ -30,23 +30,44 @@
 #define GST_CAT_DEFAULT uridownloader_debug
 GST_DEBUG_CATEGORY (uridownloader_debug);
 
-struct _GstUriDownloaderPrivate
+/* Maximum number of idle source elements kept around per scheme, host and
+ * port. Sources keep their connection open between requests, so this is
+ * also the number of idle connections to a server. */
+#define MAX_IDLE_SOURCES_PER_HOST 4
+
+/* One source element together with the pad and bus used to run a download
+ * through it. Sources are only used by one fetch at a time and are put back
+ * in the idle pool of their host afterwards. */
+typedef struct
 {
-  /* Fragments fetcher */
+  GstUriDownloader *downloader;
+  gchar *key;
+
   GstElement *urisrc;
   GstBus *bus;
   GstPad *pad;
-  GTimeVal *timeout;
   GstFragment *download;
   gboolean got_buffer;
-  GMutex download_lock;         /* used to restrict to one download only */
+  gboolean cancelled;
+  GError *err;
+} GstUriDownloaderSource;
 
-  GWeakRef parent;
+struct _GstUriDownloaderPrivate
+{
+  /* host key -> GQueue of idle GstUriDownloaderSource, most recently used
+   * first */
+  GHashTable *idle_sources;
+  /* sources of the fetches in progress */
+  GList *active_sources;
 
-  GError *err;
+  GWeakRef parent;
 
+  /* signalled whenever a download completes or is cancelled */
   GCond cond;
+  /* a cancel that found no fetch in progress, aborts the next fetch */
   gboolean cancelled;
+  /* aborts all the fetches until the next reset */
+  gboolean stopped;
 };
 
 static void gst_uri_downloader_finalize (GObject * object);
@@ -58,10 +79,12 @@ static gboolean gst_uri_downloader_sink_event (GstPad * pad, GstObject * parent,
     GstEvent * event);
 static GstBusSyncReply gst_uri_downloader_bus_handler (GstBus * bus,
     GstMessage * message, gpointer data);
+static gboolean gst_uri_downloader_cancel_active (GstUriDownloader *
+    downloader);
 
-static gboolean gst_uri_downloader_ensure_src (GstUriDownloader * downloader,
+static gboolean gst_uri_downloader_ensure_src (GstUriDownloaderSource * source,
     const gchar * uri);
-static void gst_uri_downloader_destroy_src (GstUriDownloader * downloader);
+static void gst_uri_downloader_destroy_src (GstUriDownloaderSource * source);
 
 static GstStaticPadTemplate sinkpadtemplate = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
@@ -77,6 +100,51 @@ G_DEFINE_TYPE_WITH_CODE (GstUriDownloader, gst_uri_downloader, GST_TYPE_OBJECT,
     G_ADD_PRIVATE (GstUriDownloader)
     _do_init);
 
+static GstUriDownloaderSource *
+gst_uri_downloader_source_new (GstUriDownloader * downloader, const gchar * key)
+{
+  GstUriDownloaderSource *source = g_slice_new0 (GstUriDownloaderSource);
+
+  source->downloader = downloader;
+  source->key = g_strdup (key);
+
+  /* Initialize the sink pad. This pad will be connected to the src pad of the
+   * element created with gst_element_make_from_uri and will handle the download */
+  source->pad = gst_pad_new_from_static_template (&sinkpadtemplate, "sink");
+  gst_pad_set_chain_function (source->pad,
+      GST_DEBUG_FUNCPTR (gst_uri_downloader_chain));
+  gst_pad_set_event_function (source->pad,
+      GST_DEBUG_FUNCPTR (gst_uri_downloader_sink_event));
+  gst_pad_set_element_private (source->pad, source);
+  gst_pad_set_active (source->pad, TRUE);
+
+  /* Create a bus to handle error and warning message from the source element */
+  source->bus = gst_bus_new ();
+
+  return source;
+}
+
+static void
+gst_uri_downloader_source_free (GstUriDownloaderSource * source)
+{
+  gst_uri_downloader_destroy_src (source);
+
+  gst_object_unref (source->bus);
+  gst_object_unref (source->pad);
+  if (source->download)
+    g_object_unref (source->download);
+  g_clear_error (&source->err);
+  g_free (source->key);
+
+  g_slice_free (GstUriDownloaderSource, source);
+}
+
+static void
+gst_uri_downloader_free_idle_queue (GQueue * queue)
+{
+  g_queue_free_full (queue, (GDestroyNotify) gst_uri_downloader_source_free);
+}
+
 static void
 gst_uri_downloader_class_init (GstUriDownloaderClass * klass)
 {
@@ -93,21 +161,10 @@ gst_uri_downloader_init (GstUriDownloader * downloader)
 {
   downloader->priv = gst_uri_downloader_get_instance_private (downloader);
 
-  /* Initialize the sink pad. This pad will be connected to the src pad of the
-   * element created with gst_element_make_from_uri and will handle the download */
-  downloader->priv->pad =
-      gst_pad_new_from_static_template (&sinkpadtemplate, "sink");
-  gst_pad_set_chain_function (downloader->priv->pad,
-      GST_DEBUG_FUNCPTR (gst_uri_downloader_chain));
-  gst_pad_set_event_function (downloader->priv->pad,
-      GST_DEBUG_FUNCPTR (gst_uri_downloader_sink_event));
-  gst_pad_set_element_private (downloader->priv->pad, downloader);
-  gst_pad_set_active (downloader->priv->pad, TRUE);
-
-  /* Create a bus to handle error and warning message from the source element */
-  downloader->priv->bus = gst_bus_new ();
+  downloader->priv->idle_sources = g_hash_table_new_full (g_str_hash,
+      g_str_equal, g_free,
+      (GDestroyNotify) gst_uri_downloader_free_idle_queue);
 
-  g_mutex_init (&downloader->priv->download_lock);
   g_cond_init (&downloader->priv->cond);
 }
 
@@ -115,23 +172,20 @@ static void
 gst_uri_downloader_dispose (GObject * object)
 {
   GstUriDownloader *downloader = GST_URI_DOWNLOADER (object);
+  GHashTable *idle_sources;
 
-  gst_uri_downloader_destroy_src (downloader);
-
-  if (downloader->priv->bus != NULL) {
-    gst_object_unref (downloader->priv->bus);
-    downloader->priv->bus = NULL;
-  }
-
-  if (downloader->priv->pad) {
-    gst_object_unref (downloader->priv->pad);
-    downloader->priv->pad = NULL;
-  }
+  /* fetches in progress in other threads still use their source, wait for
+   * them to give it back. They free it themselves once the pool is gone */
+  GST_OBJECT_LOCK (downloader);
+  gst_uri_downloader_cancel_active (downloader);
+  while (downloader->priv->active_sources)
+    g_cond_wait (&downloader->priv->cond, GST_OBJECT_GET_LOCK (downloader));
+  idle_sources = downloader->priv->idle_sources;
+  downloader->priv->idle_sources = NULL;
+  GST_OBJECT_UNLOCK (downloader);
 
-  if (downloader->priv->download) {
-    g_object_unref (downloader->priv->download);
-    downloader->priv->download = NULL;
-  }
+  if (idle_sources)
+    g_hash_table_unref (idle_sources);
 
   g_weak_ref_clear (&downloader->priv->parent);
 
@@ -143,7 +197,6 @@ gst_uri_downloader_finalize (GObject * object)
 {
   GstUriDownloader *downloader = GST_URI_DOWNLOADER (object);
 
-  g_mutex_clear (&downloader->priv->download_lock);
   g_cond_clear (&downloader->priv->cond);
 
   G_OBJECT_CLASS (gst_uri_downloader_parent_class)->finalize (object);
@@ -181,21 +234,22 @@ gst_uri_downloader_sink_event (GstPad * pad, GstObject * parent,
     GstEvent * event)
 {
   gboolean ret = FALSE;
+  GstUriDownloaderSource *source;
   GstUriDownloader *downloader;
 
-  downloader = GST_URI_DOWNLOADER (gst_pad_get_element_private (pad));
+  source = gst_pad_get_element_private (pad);
+  downloader = source->downloader;
 
   switch (event->type) {
     case GST_EVENT_EOS:{
       GST_OBJECT_LOCK (downloader);
       GST_DEBUG_OBJECT (downloader, "Got EOS on the fetcher pad");
-      if (downloader->priv->download != NULL) {
+      if (source->download != NULL) {
         /* signal we have fetched the URI */
-        downloader->priv->download->completed = TRUE;
-        downloader->priv->download->download_stop_time =
-            gst_util_get_timestamp ();
+        source->download->completed = TRUE;
+        source->download->download_stop_time = gst_util_get_timestamp ();
         GST_DEBUG_OBJECT (downloader, "Signaling chain funtion");
-        g_cond_signal (&downloader->priv->cond);
+        g_cond_broadcast (&downloader->priv->cond);
       }
       GST_OBJECT_UNLOCK (downloader);
       gst_event_unref (event);
@@ -206,10 +260,10 @@ gst_uri_downloader_sink_event (GstPad * pad, GstObject * parent,
       str = gst_event_get_structure (event);
       if (gst_structure_has_name (str, "http-headers")) {
         GST_OBJECT_LOCK (downloader);
-        if (downloader->priv->download != NULL) {
-          if (downloader->priv->download->headers)
-            gst_structure_free (downloader->priv->download->headers);
-          downloader->priv->download->headers = gst_structure_copy (str);
+        if (source->download != NULL) {
+          if (source->download->headers)
+            gst_structure_free (source->download->headers);
+          source->download->headers = gst_structure_copy (str);
         }
         GST_OBJECT_UNLOCK (downloader);
       }
@@ -227,7 +281,8 @@ static GstBusSyncReply
 gst_uri_downloader_bus_handler (GstBus * bus,
     GstMessage * message, gpointer data)
 {
-  GstUriDownloader *downloader = (GstUriDownloader *) (data);
+  GstUriDownloaderSource *source = data;
+  GstUriDownloader *downloader = source->downloader;
 
   if (GST_MESSAGE_TYPE (message) == GST_MESSAGE_ERROR) {
     GError *err = NULL;
@@ -247,24 +302,24 @@ gst_uri_downloader_bus_handler (GstBus * bus,
       err->message = new_error;
     }
 
-    if (!downloader->priv->err)
-      downloader->priv->err = err;
-    else
-      g_error_free (err);
-
     g_free (dbg_info);
 
     /* remove the sync handler to avoid duplicated messages */
-    gst_bus_set_sync_handler (downloader->priv->bus, NULL, NULL, NULL);
+    gst_bus_set_sync_handler (source->bus, NULL, NULL, NULL);
 
     /* stop the download */
     GST_OBJECT_LOCK (downloader);
-    if (downloader->priv->download != NULL) {
+    if (!source->err)
+      source->err = err;
+    else
+      g_error_free (err);
+
+    if (source->download != NULL) {
       GST_DEBUG_OBJECT (downloader, "Stopping download");
-      g_object_unref (downloader->priv->download);
-      downloader->priv->download = NULL;
-      downloader->priv->cancelled = TRUE;
-      g_cond_signal (&downloader->priv->cond);
+      g_object_unref (source->download);
+      source->download = NULL;
+      source->cancelled = TRUE;
+      g_cond_broadcast (&downloader->priv->cond);
     }
     GST_OBJECT_UNLOCK (downloader);
   } else if (GST_MESSAGE_TYPE (message) == GST_MESSAGE_WARNING) {
@@ -316,16 +371,18 @@ gst_uri_downloader_bus_handler (GstBus * bus,
 static GstFlowReturn
 gst_uri_downloader_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
+  GstUriDownloaderSource *source;
   GstUriDownloader *downloader;
 
-  downloader = GST_URI_DOWNLOADER (gst_pad_get_element_private (pad));
+  source = gst_pad_get_element_private (pad);
+  downloader = source->downloader;
 
   /* HTML errors (404, 500, etc...) are also pushed through this pad as
    * response but the source element will also post a warning or error message
    * in the bus, which is handled synchronously cancelling the download.
    */
   GST_OBJECT_LOCK (downloader);
-  if (downloader->priv->download == NULL) {
+  if (source->download == NULL) {
     /* Download cancelled, quit */
     gst_buffer_unref (buf);
     GST_OBJECT_UNLOCK (downloader);
@@ -334,8 +391,8 @@ gst_uri_downloader_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
   GST_LOG_OBJECT (downloader, "The uri fetcher received a new buffer "
       "of size %" G_GSIZE_FORMAT, gst_buffer_get_size (buf));
-  downloader->priv->got_buffer = TRUE;
-  if (!gst_fragment_add_buffer (downloader->priv->download, buf)) {
+  source->got_buffer = TRUE;
+  if (!gst_fragment_add_buffer (source->download, buf)) {
     GST_WARNING_OBJECT (downloader, "Could not add buffer to fragment");
     gst_buffer_unref (buf);
   }
@@ -354,34 +411,169 @@ gst_uri_downloader_reset (GstUriDownloader * downloader)
 
   GST_OBJECT_LOCK (downloader);
   downloader->priv->cancelled = FALSE;
+  downloader->priv->stopped = FALSE;
   GST_OBJECT_UNLOCK (downloader);
 }
 
+/**
+ * gst_uri_downloader_cancel:
+ * @downloader: the #GstUriDownloader
+ *
+ * Cancels all the fetches in progress. If there are none, the next fetch
+ * is cancelled instead. Fetches started after this call are not affected
+ * otherwise.
+ */
+/* Cancels the downloads of all the fetches in progress. Returns TRUE if there
+ * was any. Must be called with the object lock */
+static gboolean
+gst_uri_downloader_cancel_active (GstUriDownloader * downloader)
+{
+  GList *walk;
+  gboolean cancelled = FALSE;
+
+  for (walk = downloader->priv->active_sources; walk; walk = walk->next) {
+    GstUriDownloaderSource *source = walk->data;
+
+    if (source->download != NULL) {
+      GST_DEBUG_OBJECT (downloader, "Cancelling download");
+      g_object_unref (source->download);
+      source->download = NULL;
+      source->cancelled = TRUE;
+      cancelled = TRUE;
+    }
+  }
+
+  if (cancelled) {
+    GST_DEBUG_OBJECT (downloader, "Signaling chain funtion");
+    g_cond_broadcast (&downloader->priv->cond);
+  }
+
+  return cancelled;
+}
+
 void
 gst_uri_downloader_cancel (GstUriDownloader * downloader)
 {
   GST_OBJECT_LOCK (downloader);
-  if (downloader->priv->download != NULL) {
-    GST_DEBUG_OBJECT (downloader, "Cancelling download");
-    g_object_unref (downloader->priv->download);
-    downloader->priv->download = NULL;
-    downloader->priv->cancelled = TRUE;
-    GST_DEBUG_OBJECT (downloader, "Signaling chain funtion");
-    g_cond_signal (&downloader->priv->cond);
-  } else {
-    gboolean cancelled;
+  if (gst_uri_downloader_cancel_active (downloader)) {
+    GST_OBJECT_UNLOCK (downloader);
+    return;
+  }
 
-    cancelled = downloader->priv->cancelled;
+  if (downloader->priv->cancelled) {
+    GST_DEBUG_OBJECT (downloader,
+        "Trying to cancel a download that was alredy cancelled");
+  } else {
     downloader->priv->cancelled = TRUE;
-    if (cancelled)
-      GST_DEBUG_OBJECT (downloader,
-          "Trying to cancel a download that was alredy cancelled");
   }
   GST_OBJECT_UNLOCK (downloader);
 }
 
+/**
+ * gst_uri_downloader_stop:
+ * @downloader: the #GstUriDownloader
+ *
+ * Cancels all the fetches in progress, and all the fetches started afterwards
+ * until gst_uri_downloader_reset() is called.
+ *
+ * Since: 1.18
+ */
+void
+gst_uri_downloader_stop (GstUriDownloader * downloader)
+{
+  g_return_if_fail (downloader != NULL);
+
+  GST_OBJECT_LOCK (downloader);
+  downloader->priv->stopped = TRUE;
+  gst_uri_downloader_cancel_active (downloader);
+  GST_OBJECT_UNLOCK (downloader);
+}
+
+/* Sources are shared between URIs with the same scheme, host and port, so
+ * that a connection kept alive by the source can be used again */
+static gchar *
+gst_uri_downloader_make_key (const gchar * uri)
+{
+  GstUri *gsturi;
+  gchar *key;
+
+  gsturi = gst_uri_from_string (uri);
+  if (!gsturi)
+    return gst_uri_get_protocol (uri);
+
+  key = g_strdup_printf ("%s://%s:%u",
+      GST_STR_NULL (gst_uri_get_scheme (gsturi)),
+      GST_STR_NULL (gst_uri_get_host (gsturi)), gst_uri_get_port (gsturi));
+  gst_uri_unref (gsturi);
+
+  return key;
+}
+
+/* must be called with the object lock */
+static GstUriDownloaderSource *
+gst_uri_downloader_acquire_source (GstUriDownloader * downloader,
+    const gchar * uri)
+{
+  GstUriDownloaderSource *source = NULL;
+  GQueue *queue;
+  gchar *key;
+
+  key = gst_uri_downloader_make_key (uri);
+  queue = g_hash_table_lookup (downloader->priv->idle_sources, key);
+  if (queue)
+    source = g_queue_pop_head (queue);
+
+  if (source) {
+    GST_DEBUG_OBJECT (downloader, "Re-using idle source for %s", key);
+  } else {
+    GST_DEBUG_OBJECT (downloader, "No idle source for %s", key);
+    source = gst_uri_downloader_source_new (downloader, key);
+  }
+  g_free (key);
+
+  source->cancelled = FALSE;
+  source->got_buffer = FALSE;
+  g_clear_error (&source->err);
+
+  downloader->priv->active_sources =
+      g_list_prepend (downloader->priv->active_sources, source);
+
+  return source;
+}
+
+/* Puts the source back in the idle pool of its host. Returns the source if it
+ * has to be freed instead, which must be done without the object lock.
+ * Must be called with the object lock */
+static GstUriDownloaderSource *
+gst_uri_downloader_release_source (GstUriDownloader * downloader,
+    GstUriDownloaderSource * source)
+{
+  GQueue *queue;
+
+  downloader->priv->active_sources =
+      g_list_remove (downloader->priv->active_sources, source);
+  /* dispose waits for all the sources to be released */
+  g_cond_broadcast (&downloader->priv->cond);
+
+  if (!downloader->priv->idle_sources || !source->urisrc)
+    return source;
+
+  queue = g_hash_table_lookup (downloader->priv->idle_sources, source->key);
+  if (!queue) {
+    queue = g_queue_new ();
+    g_hash_table_insert (downloader->priv->idle_sources,
+        g_strdup (source->key), queue);
+  }
+
+  if (g_queue_get_length (queue) >= MAX_IDLE_SOURCES_PER_HOST)
+    return source;
+
+  g_queue_push_head (queue, source);
+  return NULL;
+}
+
 static gboolean
-gst_uri_downloader_set_range (GstUriDownloader * downloader,
+gst_uri_downloader_set_range (GstUriDownloaderSource * source,
     gint64 range_start, gint64 range_end)
 {
   g_return_val_if_fail (range_start >= 0, FALSE);
@@ -393,36 +585,38 @@ gst_uri_downloader_set_range (GstUriDownloader * downloader,
     seek = gst_event_new_seek (1.0, GST_FORMAT_BYTES, GST_SEEK_FLAG_FLUSH,
         GST_SEEK_TYPE_SET, range_start, GST_SEEK_TYPE_SET, range_end);
 
-    return gst_element_send_event (downloader->priv->urisrc, seek);
+    return gst_element_send_event (source->urisrc, seek);
   }
   return TRUE;
 }
 
 static gboolean
-gst_uri_downloader_ensure_src (GstUriDownloader * downloader, const gchar * uri)
+gst_uri_downloader_ensure_src (GstUriDownloaderSource * source,
+    const gchar * uri)
 {
-  if (downloader->priv->urisrc) {
+  GstUriDownloader *downloader = source->downloader;
+
+  if (source->urisrc) {
     gchar *old_protocol, *new_protocol;
     gchar *old_uri;
 
-    old_uri =
-        gst_uri_handler_get_uri (GST_URI_HANDLER (downloader->priv->urisrc));
+    old_uri = gst_uri_handler_get_uri (GST_URI_HANDLER (source->urisrc));
     old_protocol = gst_uri_get_protocol (old_uri);
     new_protocol = gst_uri_get_protocol (uri);
 
     if (!g_str_equal (old_protocol, new_protocol)) {
-      gst_uri_downloader_destroy_src (downloader);
+      gst_uri_downloader_destroy_src (source);
       GST_DEBUG_OBJECT (downloader, "Can't re-use old source element");
     } else {
       GError *err = NULL;
 
       GST_DEBUG_OBJECT (downloader, "Re-using old source element");
-      if (!gst_uri_handler_set_uri
-          (GST_URI_HANDLER (downloader->priv->urisrc), uri, &err)) {
+      if (!gst_uri_handler_set_uri (GST_URI_HANDLER (source->urisrc), uri,
+              &err)) {
         GST_DEBUG_OBJECT (downloader,
             "Failed to re-use old source element: %s", err->message);
         g_clear_error (&err);
-        gst_uri_downloader_destroy_src (downloader);
+        gst_uri_downloader_destroy_src (source);
       }
     }
     g_free (old_uri);
@@ -430,36 +624,35 @@ gst_uri_downloader_ensure_src (GstUriDownloader * downloader, const gchar * uri)
     g_free (new_protocol);
   }
 
-  if (!downloader->priv->urisrc) {
+  if (!source->urisrc) {
     GST_DEBUG_OBJECT (downloader, "Creating source element for the URI:%s",
         uri);
-    downloader->priv->urisrc =
-        gst_element_make_from_uri (GST_URI_SRC, uri, NULL, NULL);
-    if (downloader->priv->urisrc) {
+    source->urisrc = gst_element_make_from_uri (GST_URI_SRC, uri, NULL, NULL);
+    if (source->urisrc) {
       /* gst_element_make_from_uri returns a floating reference
        * and we are not going to transfer the ownership, so we
        * should take it.
        */
-      gst_object_ref_sink (downloader->priv->urisrc);
+      gst_object_ref_sink (source->urisrc);
     }
   }
 
-  return downloader->priv->urisrc != NULL;
+  return source->urisrc != NULL;
 }
 
 static void
-gst_uri_downloader_destroy_src (GstUriDownloader * downloader)
+gst_uri_downloader_destroy_src (GstUriDownloaderSource * source)
 {
-  if (!downloader->priv->urisrc)
+  if (!source->urisrc)
     return;
 
-  gst_element_set_state (downloader->priv->urisrc, GST_STATE_NULL);
-  gst_object_unref (downloader->priv->urisrc);
-  downloader->priv->urisrc = NULL;
+  gst_element_set_state (source->urisrc, GST_STATE_NULL);
+  gst_object_unref (source->urisrc);
+  source->urisrc = NULL;
 }
 
 static gboolean
-gst_uri_downloader_set_uri (GstUriDownloader * downloader, const gchar * uri,
+gst_uri_downloader_set_uri (GstUriDownloaderSource * source, const gchar * uri,
     const gchar * referer, gboolean compress,
     gboolean refresh, gboolean allow_cache)
 {
@@ -469,14 +662,17 @@ gst_uri_downloader_set_uri (GstUriDownloader * downloader, const gchar * uri,
   if (!gst_uri_is_valid (uri))
     return FALSE;
 
-  if (!gst_uri_downloader_ensure_src (downloader, uri))
+  if (!gst_uri_downloader_ensure_src (source, uri))
     return FALSE;
 
-  gobject_class = G_OBJECT_GET_CLASS (downloader->priv->urisrc);
+  gobject_class = G_OBJECT_GET_CLASS (source->urisrc);
   if (g_object_class_find_property (gobject_class, "compress"))
-    g_object_set (downloader->priv->urisrc, "compress", compress, NULL);
+    g_object_set (source->urisrc, "compress", compress, NULL);
   if (g_object_class_find_property (gobject_class, "keep-alive"))
-    g_object_set (downloader->priv->urisrc, "keep-alive", TRUE, NULL);
+    g_object_set (source->urisrc, "keep-alive", TRUE, NULL);
+  /* the source might have been used for a HEAD request before */
+  if (g_object_class_find_property (gobject_class, "method"))
+    g_object_set (source->urisrc, "method", NULL, NULL);
   if (g_object_class_find_property (gobject_class, "extra-headers")) {
     if (referer || refresh || !allow_cache) {
       GstStructure *extra_headers = gst_structure_new_empty ("headers");
@@ -492,41 +688,39 @@ gst_uri_downloader_set_uri (GstUriDownloader * downloader, const gchar * uri,
         gst_structure_set (extra_headers, "Cache-Control", G_TYPE_STRING,
             "max-age=0", NULL);
 
-      g_object_set (downloader->priv->urisrc, "extra-headers", extra_headers,
-          NULL);
+      g_object_set (source->urisrc, "extra-headers", extra_headers, NULL);
 
       gst_structure_free (extra_headers);
     } else {
-      g_object_set (downloader->priv->urisrc, "extra-headers", NULL, NULL);
+      g_object_set (source->urisrc, "extra-headers", NULL, NULL);
     }
   }
 
   /* add a sync handler for the bus messages to detect errors in the download */
-  gst_element_set_bus (GST_ELEMENT (downloader->priv->urisrc),
-      downloader->priv->bus);
-  gst_bus_set_sync_handler (downloader->priv->bus,
-      gst_uri_downloader_bus_handler, downloader, NULL);
+  gst_element_set_bus (GST_ELEMENT (source->urisrc), source->bus);
+  gst_bus_set_sync_handler (source->bus, gst_uri_downloader_bus_handler,
+      source, NULL);
 
-  pad = gst_element_get_static_pad (downloader->priv->urisrc, "src");
+  pad = gst_element_get_static_pad (source->urisrc, "src");
   if (!pad)
     return FALSE;
-  gst_pad_link (pad, downloader->priv->pad);
+  gst_pad_link (pad, source->pad);
   gst_object_unref (pad);
   return TRUE;
 }
 
 static gboolean
-gst_uri_downloader_set_method (GstUriDownloader * downloader,
+gst_uri_downloader_set_method (GstUriDownloaderSource * source,
     const gchar * method)
 {
   GObjectClass *gobject_class;
 
-  if (!downloader->priv->urisrc)
+  if (!source->urisrc)
     return FALSE;
 
-  gobject_class = G_OBJECT_GET_CLASS (downloader->priv->urisrc);
+  gobject_class = G_OBJECT_GET_CLASS (source->urisrc);
   if (g_object_class_find_property (gobject_class, "method")) {
-    g_object_set (downloader->priv->urisrc, "method", method, NULL);
+    g_object_set (source->urisrc, "method", method, NULL);
     return TRUE;
   }
   return FALSE;
@@ -548,6 +742,10 @@ gst_uri_downloader_fetch_uri (GstUriDownloader * downloader,
  * @range_start: the starting byte index
  * @range_end: the final byte index, use -1 for unspecified
  *
+ * Several fetches can be done at the same time from different threads, each
+ * of them uses its own source element. Source elements are kept around
+ * after a fetch and used again for later fetches from the same host.
+ *
  * Returns the downloaded #GstFragment
  */
 GstFragment *
@@ -558,69 +756,75 @@ gst_uri_downloader_fetch_uri_with_range (GstUriDownloader *
 {
   GstStateChangeReturn ret;
   GstFragment *download = NULL;
+  GstUriDownloaderSource *source;
 
   GST_DEBUG_OBJECT (downloader, "Fetching URI %s", uri);
 
-  g_mutex_lock (&downloader->priv->download_lock);
-  downloader->priv->err = NULL;
-  downloader->priv->got_buffer = FALSE;
-
   GST_OBJECT_LOCK (downloader);
+  source = gst_uri_downloader_acquire_source (downloader, uri);
+
+  if (downloader->priv->stopped) {
+    GST_DEBUG_OBJECT (downloader, "Stopped, aborting fetch");
+    goto quit;
+  }
+
+  /* a pending cancel only applies to one fetch */
   if (downloader->priv->cancelled) {
     GST_DEBUG_OBJECT (downloader, "Cancelled, aborting fetch");
+    downloader->priv->cancelled = FALSE;
     goto quit;
   }
 
-  if (!gst_uri_downloader_set_uri (downloader, uri, referer, compress, refresh,
+  if (!gst_uri_downloader_set_uri (source, uri, referer, compress, refresh,
           allow_cache)) {
     GST_WARNING_OBJECT (downloader, "Failed to set URI");
     goto quit;
   }
 
-  gst_bus_set_flushing (downloader->priv->bus, FALSE);
-  if (downloader->priv->download)
-    g_object_unref (downloader->priv->download);
-  downloader->priv->download = gst_fragment_new ();
-  downloader->priv->download->range_start = range_start;
-  downloader->priv->download->range_end = range_end;
+  gst_bus_set_flushing (source->bus, FALSE);
+  if (source->download)
+    g_object_unref (source->download);
+  source->download = gst_fragment_new ();
+  source->download->range_start = range_start;
+  source->download->range_end = range_end;
   GST_OBJECT_UNLOCK (downloader);
-  ret = gst_element_set_state (downloader->priv->urisrc, GST_STATE_READY);
+  ret = gst_element_set_state (source->urisrc, GST_STATE_READY);
   GST_OBJECT_LOCK (downloader);
-  if (ret == GST_STATE_CHANGE_FAILURE || downloader->priv->download == NULL) {
+  if (ret == GST_STATE_CHANGE_FAILURE || source->download == NULL) {
     GST_WARNING_OBJECT (downloader, "Failed to set src to READY");
     goto quit;
   }
 
   /* might have been cancelled because of failures in state change */
-  if (downloader->priv->cancelled) {
+  if (source->cancelled) {
     goto quit;
   }
 
   if (range_start < 0 && range_end < 0) {
-    if (!gst_uri_downloader_set_method (downloader, "HEAD")) {
+    if (!gst_uri_downloader_set_method (source, "HEAD")) {
       GST_WARNING_OBJECT (downloader, "Failed to set HTTP method");
       goto quit;
     }
   } else {
-    if (!gst_uri_downloader_set_range (downloader, range_start, range_end)) {
+    if (!gst_uri_downloader_set_range (source, range_start, range_end)) {
       GST_WARNING_OBJECT (downloader, "Failed to set range");
       goto quit;
     }
   }
 
   GST_OBJECT_UNLOCK (downloader);
-  ret = gst_element_set_state (downloader->priv->urisrc, GST_STATE_PLAYING);
+  ret = gst_element_set_state (source->urisrc, GST_STATE_PLAYING);
   GST_OBJECT_LOCK (downloader);
   if (ret == GST_STATE_CHANGE_FAILURE) {
-    if (downloader->priv->download) {
-      g_object_unref (downloader->priv->download);
-      downloader->priv->download = NULL;
+    if (source->download) {
+      g_object_unref (source->download);
+      source->download = NULL;
     }
     goto quit;
   }
 
   /* might have been cancelled because of failures in state change */
-  if (downloader->priv->cancelled) {
+  if (source->cancelled) {
     goto quit;
   }
 
@@ -630,20 +834,20 @@ gst_uri_downloader_fetch_uri_with_range (GstUriDownloader *
    *   - the download was canceled
    */
   GST_DEBUG_OBJECT (downloader, "Waiting to fetch the URI %s", uri);
-  while (!downloader->priv->cancelled && !downloader->priv->download->completed)
+  while (!source->cancelled && !source->download->completed)
     g_cond_wait (&downloader->priv->cond, GST_OBJECT_GET_LOCK (downloader));
 
-  if (downloader->priv->cancelled) {
-    if (downloader->priv->download) {
-      g_object_unref (downloader->priv->download);
-      downloader->priv->download = NULL;
+  if (source->cancelled) {
+    if (source->download) {
+      g_object_unref (source->download);
+      source->download = NULL;
     }
     goto quit;
   }
 
-  download = downloader->priv->download;
-  downloader->priv->download = NULL;
-  if (!downloader->priv->got_buffer) {
+  download = source->download;
+  source->download = NULL;
+  if (!source->got_buffer) {
     if (download->range_start < 0 && download->range_end < 0) {
       /* HEAD request, so we don't expect a response */
     } else {
@@ -660,18 +864,25 @@ gst_uri_downloader_fetch_uri_with_range (GstUriDownloader *
 
 quit:
   {
-    if (downloader->priv->urisrc) {
+    GError *source_err;
+
+    if (source->download) {
+      g_object_unref (source->download);
+      source->download = NULL;
+    }
+
+    if (source->urisrc) {
       GstPad *pad;
       GstElement *urisrc;
 
-      urisrc = downloader->priv->urisrc;
+      urisrc = source->urisrc;
 
       GST_DEBUG_OBJECT (downloader, "Stopping source element %s",
           GST_ELEMENT_NAME (urisrc));
 
       /* remove the bus' sync handler */
-      gst_bus_set_sync_handler (downloader->priv->bus, NULL, NULL, NULL);
-      gst_bus_set_flushing (downloader->priv->bus, TRUE);
+      gst_bus_set_sync_handler (source->bus, NULL, NULL, NULL);
+      gst_bus_set_flushing (source->bus, TRUE);
 
       /* set the element state to NULL */
       GST_OBJECT_UNLOCK (downloader);
@@ -689,33 +900,39 @@ quit:
               &download->redirect_permanent);
         }
         gst_query_unref (query);
+        /* keeps the connection alive for the next fetch from this host */
         gst_element_set_state (urisrc, GST_STATE_READY);
       }
       GST_OBJECT_LOCK (downloader);
       gst_element_set_bus (urisrc, NULL);
 
       /* unlink the source element from the internal pad */
-      pad = gst_pad_get_peer (downloader->priv->pad);
+      pad = gst_pad_get_peer (source->pad);
       if (pad) {
-        gst_pad_unlink (pad, downloader->priv->pad);
+        gst_pad_unlink (pad, source->pad);
         gst_object_unref (pad);
       }
     }
+
+    source_err = source->err;
+    source->err = NULL;
+    source = gst_uri_downloader_release_source (downloader, source);
     GST_OBJECT_UNLOCK (downloader);
 
+    if (source)
+      gst_uri_downloader_source_free (source);
+
     if (download == NULL) {
-      if (!downloader->priv->err) {
+      if (!source_err) {
         g_set_error (err, GST_RESOURCE_ERROR, GST_RESOURCE_ERROR_OPEN_READ,
             "Failed to download '%s'", uri);
       } else {
-        g_propagate_error (err, downloader->priv->err);
-        downloader->priv->err = NULL;
+        g_propagate_error (err, source_err);
+        source_err = NULL;
       }
     }
+    g_clear_error (&source_err);
 
-    downloader->priv->cancelled = FALSE;
-
-    g_mutex_unlock (&downloader->priv->download_lock);
     return download;
   }
 }
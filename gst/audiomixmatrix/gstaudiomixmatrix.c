@@ -73,6 +73,12 @@
 #include <string.h>
 #include <math.h>
 
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 GST_DEBUG_CATEGORY_STATIC (audiomixmatrix_debug);
 #define GST_CAT_DEFAULT audiomixmatrix_debug
 
@@ -115,7 +121,8 @@ GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS
-    ("audio/x-raw, channels = [1, max], layout = (string) interleaved, format = (string) {"
+    ("audio/x-raw, channels = [1, max], "
+        "layout = (string) { interleaved, non-interleaved }, format = (string) {"
         GST_AUDIO_NE (F32) "," GST_AUDIO_NE (F64) "," GST_AUDIO_NE (S16) ","
         GST_AUDIO_NE (S32) "}")
     );
@@ -125,7 +132,8 @@ GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS
-    ("audio/x-raw, channels = [1, max], layout = (string) interleaved, format = (string) {"
+    ("audio/x-raw, channels = [1, max], "
+        "layout = (string) { interleaved, non-interleaved }, format = (string) {"
         GST_AUDIO_NE (F32) "," GST_AUDIO_NE (F64) "," GST_AUDIO_NE (S16) ","
         GST_AUDIO_NE (S32) "}")
     );
@@ -139,6 +147,8 @@ static gboolean gst_audio_mix_matrix_get_unit_size (GstBaseTransform * trans,
     GstCaps * caps, gsize * size);
 static gboolean gst_audio_mix_matrix_set_caps (GstBaseTransform * trans,
     GstCaps * incaps, GstCaps * outcaps);
+static GstFlowReturn gst_audio_mix_matrix_prepare_output_buffer (GstBaseTransform
+    * trans, GstBuffer * inbuf, GstBuffer ** outbuf);
 static GstFlowReturn gst_audio_mix_matrix_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
 static GstCaps *gst_audio_mix_matrix_transform_caps (GstBaseTransform * trans,
@@ -208,6 +218,8 @@ gst_audio_mix_matrix_class_init (GstAudioMixMatrixClass * klass)
   trans_class->get_unit_size =
       GST_DEBUG_FUNCPTR (gst_audio_mix_matrix_get_unit_size);
   trans_class->set_caps = GST_DEBUG_FUNCPTR (gst_audio_mix_matrix_set_caps);
+  trans_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_audio_mix_matrix_prepare_output_buffer);
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_audio_mix_matrix_transform);
   trans_class->transform_caps =
       GST_DEBUG_FUNCPTR (gst_audio_mix_matrix_transform_caps);
@@ -230,6 +242,387 @@ gst_audio_mix_matrix_init (GstAudioMixMatrix * self)
   self->mode = GST_AUDIO_MIX_MATRIX_MODE_MANUAL;
 }
 
+/* Kernels */
+
+static inline gfloat
+dot_f32 (const gfloat * a, const gfloat * b, guint n)
+{
+  gfloat sum = 0;
+  guint i = 0;
+
+#if defined (__SSE2__)
+  {
+    __m128 acc0 = _mm_setzero_ps ();
+    __m128 acc1 = _mm_setzero_ps ();
+    gfloat tmp[4];
+
+    for (; i + 8 <= n; i += 8) {
+      acc0 = _mm_add_ps (acc0,
+          _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+      acc1 = _mm_add_ps (acc1,
+          _mm_mul_ps (_mm_loadu_ps (a + i + 4), _mm_loadu_ps (b + i + 4)));
+    }
+    if (i + 4 <= n) {
+      acc0 = _mm_add_ps (acc0,
+          _mm_mul_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i)));
+      i += 4;
+    }
+    _mm_storeu_ps (tmp, _mm_add_ps (acc0, acc1));
+    sum = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+  }
+#elif defined (__ARM_NEON)
+  {
+    float32x4_t acc0 = vdupq_n_f32 (0);
+    float32x4_t acc1 = vdupq_n_f32 (0);
+    gfloat tmp[4];
+
+    for (; i + 8 <= n; i += 8) {
+      acc0 = vmlaq_f32 (acc0, vld1q_f32 (a + i), vld1q_f32 (b + i));
+      acc1 = vmlaq_f32 (acc1, vld1q_f32 (a + i + 4), vld1q_f32 (b + i + 4));
+    }
+    if (i + 4 <= n) {
+      acc0 = vmlaq_f32 (acc0, vld1q_f32 (a + i), vld1q_f32 (b + i));
+      i += 4;
+    }
+    vst1q_f32 (tmp, vaddq_f32 (acc0, acc1));
+    sum = (tmp[0] + tmp[1]) + (tmp[2] + tmp[3]);
+  }
+#endif
+
+  for (; i < n; i++)
+    sum += a[i] * b[i];
+
+  return sum;
+}
+
+static inline gdouble
+dot_f64 (const gdouble * a, const gdouble * b, guint n)
+{
+  gdouble sum = 0;
+  guint i = 0;
+
+#if defined (__SSE2__)
+  {
+    __m128d acc0 = _mm_setzero_pd ();
+    __m128d acc1 = _mm_setzero_pd ();
+    gdouble tmp[2];
+
+    for (; i + 4 <= n; i += 4) {
+      acc0 = _mm_add_pd (acc0,
+          _mm_mul_pd (_mm_loadu_pd (a + i), _mm_loadu_pd (b + i)));
+      acc1 = _mm_add_pd (acc1,
+          _mm_mul_pd (_mm_loadu_pd (a + i + 2), _mm_loadu_pd (b + i + 2)));
+    }
+    _mm_storeu_pd (tmp, _mm_add_pd (acc0, acc1));
+    sum = tmp[0] + tmp[1];
+  }
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+  {
+    float64x2_t acc0 = vdupq_n_f64 (0);
+    float64x2_t acc1 = vdupq_n_f64 (0);
+
+    for (; i + 4 <= n; i += 4) {
+      acc0 = vfmaq_f64 (acc0, vld1q_f64 (a + i), vld1q_f64 (b + i));
+      acc1 = vfmaq_f64 (acc1, vld1q_f64 (a + i + 2), vld1q_f64 (b + i + 2));
+    }
+    sum = vaddvq_f64 (vaddq_f64 (acc0, acc1));
+  }
+#endif
+
+  for (; i < n; i++)
+    sum += a[i] * b[i];
+
+  return sum;
+}
+
+/* out[i] += c * in[i] */
+static inline void
+axpy_f32 (gfloat * out, const gfloat * in, gfloat c, guint n)
+{
+  guint i = 0;
+
+#if defined (__SSE2__)
+  {
+    const __m128 vc = _mm_set1_ps (c);
+
+    for (; i + 4 <= n; i += 4)
+      _mm_storeu_ps (out + i, _mm_add_ps (_mm_loadu_ps (out + i),
+              _mm_mul_ps (vc, _mm_loadu_ps (in + i))));
+  }
+#elif defined (__ARM_NEON)
+  for (; i + 4 <= n; i += 4)
+    vst1q_f32 (out + i, vmlaq_n_f32 (vld1q_f32 (out + i), vld1q_f32 (in + i),
+            c));
+#endif
+
+  for (; i < n; i++)
+    out[i] += c * in[i];
+}
+
+static inline void
+axpy_f64 (gdouble * out, const gdouble * in, gdouble c, guint n)
+{
+  guint i = 0;
+
+#if defined (__SSE2__)
+  {
+    const __m128d vc = _mm_set1_pd (c);
+
+    for (; i + 2 <= n; i += 2)
+      _mm_storeu_pd (out + i, _mm_add_pd (_mm_loadu_pd (out + i),
+              _mm_mul_pd (vc, _mm_loadu_pd (in + i))));
+  }
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+  for (; i + 2 <= n; i += 2)
+    vst1q_f64 (out + i, vfmaq_n_f64 (vld1q_f64 (out + i), vld1q_f64 (in + i),
+            c));
+#endif
+
+  for (; i < n; i++)
+    out[i] += c * in[i];
+}
+
+static void
+gst_audio_mix_matrix_free_rows (GstAudioMixMatrix * self)
+{
+  g_free (self->rows);
+  self->rows = NULL;
+  g_free (self->f32_matrix);
+  self->f32_matrix = NULL;
+  g_free (self->taps);
+  self->taps = NULL;
+  g_free (self->f32_taps);
+  self->f32_taps = NULL;
+  g_free (self->f64_taps);
+  self->f64_taps = NULL;
+  g_free (self->s16_taps);
+  self->s16_taps = NULL;
+  g_free (self->s32_taps);
+  self->s32_taps = NULL;
+}
+
+/* Looks at every row of the matrix to find out which input channels actually
+ * contribute to it, so that routing-only and mostly empty matrices do not go
+ * through the full multiply-accumulate over all input channels */
+static void
+gst_audio_mix_matrix_update_rows (GstAudioMixMatrix * self)
+{
+  guint in, out, n_taps = 0;
+  guint size = self->in_channels * self->out_channels;
+
+  gst_audio_mix_matrix_free_rows (self);
+
+  if (self->matrix == NULL || size == 0)
+    return;
+
+  self->rows = g_new (GstAudioMixMatrixRow, self->out_channels);
+  self->f32_matrix = g_new (gfloat, size);
+  self->taps = g_new (guint, size);
+  self->f32_taps = g_new (gfloat, size);
+  self->f64_taps = g_new (gdouble, size);
+  if (self->s16_conv_matrix)
+    self->s16_taps = g_new (gint32, size);
+  if (self->s32_conv_matrix)
+    self->s32_taps = g_new (gint64, size);
+
+  for (out = 0; out < self->out_channels; out++) {
+    GstAudioMixMatrixRow *row = &self->rows[out];
+
+    row->offset = n_taps;
+
+    for (in = 0; in < self->in_channels; in++) {
+      guint i = out * self->in_channels + in;
+
+      self->f32_matrix[i] = self->matrix[i];
+
+      if (self->matrix[i] == 0.0)
+        continue;
+
+      self->taps[n_taps] = in;
+      self->f32_taps[n_taps] = self->matrix[i];
+      self->f64_taps[n_taps] = self->matrix[i];
+      if (self->s16_taps)
+        self->s16_taps[n_taps] = self->s16_conv_matrix[i];
+      if (self->s32_taps)
+        self->s32_taps[n_taps] = self->s32_conv_matrix[i];
+      n_taps++;
+    }
+
+    row->n_taps = n_taps - row->offset;
+
+    if (row->n_taps == 0)
+      row->type = GST_AUDIO_MIX_MATRIX_ROW_ZERO;
+    else if (row->n_taps == 1 && self->f64_taps[row->offset] == 1.0)
+      row->type = GST_AUDIO_MIX_MATRIX_ROW_COPY;
+    else if (row->n_taps * 4 <= self->in_channels)
+      row->type = GST_AUDIO_MIX_MATRIX_ROW_SPARSE;
+    else
+      row->type = GST_AUDIO_MIX_MATRIX_ROW_DENSE;
+
+    GST_LOG_OBJECT (self, "output channel %u: type %d, %u taps", out,
+        row->type, row->n_taps);
+  }
+}
+
+/* Interleaved samples: one output frame at a time, dense rows are a dot
+ * product over the input frame */
+
+#define DEFINE_MIX_INTERLEAVED_FLOAT(fmt, ctype, dot, full)                   \
+static void                                                                   \
+mix_interleaved_##fmt (GstAudioMixMatrix * self, const ctype * in,            \
+    ctype * out, guint n_samples)                                             \
+{                                                                             \
+  const guint inchannels = self->in_channels;                                 \
+  const guint outchannels = self->out_channels;                               \
+  const guint *taps = self->taps;                                             \
+  const ctype *coefs = self->fmt##_taps;                                      \
+  const ctype *matrix = self->full;                                           \
+  guint sample, o, t;                                                         \
+                                                                              \
+  for (sample = 0; sample < n_samples; sample++) {                            \
+    for (o = 0; o < outchannels; o++) {                                       \
+      const GstAudioMixMatrixRow *row = &self->rows[o];                       \
+      ctype outval = 0;                                                       \
+                                                                              \
+      switch (row->type) {                                                    \
+        case GST_AUDIO_MIX_MATRIX_ROW_ZERO:                                   \
+          break;                                                              \
+        case GST_AUDIO_MIX_MATRIX_ROW_COPY:                                   \
+          outval = in[taps[row->offset]];                                     \
+          break;                                                              \
+        case GST_AUDIO_MIX_MATRIX_ROW_SPARSE:                                 \
+          for (t = row->offset; t < row->offset + row->n_taps; t++)           \
+            outval += in[taps[t]] * coefs[t];                                 \
+          break;                                                              \
+        case GST_AUDIO_MIX_MATRIX_ROW_DENSE:                                  \
+          outval = dot (in, matrix + o * inchannels, inchannels);             \
+          break;                                                              \
+      }                                                                       \
+      out[o] = outval;                                                        \
+    }                                                                         \
+    in += inchannels;                                                         \
+    out += outchannels;                                                       \
+  }                                                                           \
+}
+
+/* The integer versions accumulate exactly like the generic code always did,
+ * so the output does not change */
+#define DEFINE_MIX_INTERLEAVED_INT(fmt, ctype, acctype)                       \
+static void                                                                   \
+mix_interleaved_##fmt (GstAudioMixMatrix * self, const ctype * in,            \
+    ctype * out, guint n_samples)                                             \
+{                                                                             \
+  const guint inchannels = self->in_channels;                                 \
+  const guint outchannels = self->out_channels;                               \
+  const guint *taps = self->taps;                                             \
+  const acctype *coefs = self->fmt##_taps;                                    \
+  const acctype *matrix = self->fmt##_conv_matrix;                            \
+  const guint shift = self->shift_bytes;                                      \
+  guint sample, o, t;                                                         \
+                                                                              \
+  for (sample = 0; sample < n_samples; sample++) {                            \
+    for (o = 0; o < outchannels; o++) {                                       \
+      const GstAudioMixMatrixRow *row = &self->rows[o];                       \
+      acctype outval = 0;                                                     \
+                                                                              \
+      switch (row->type) {                                                    \
+        case GST_AUDIO_MIX_MATRIX_ROW_ZERO:                                   \
+          out[o] = 0;                                                         \
+          continue;                                                           \
+        case GST_AUDIO_MIX_MATRIX_ROW_COPY:                                   \
+          out[o] = in[taps[row->offset]];                                     \
+          continue;                                                           \
+        case GST_AUDIO_MIX_MATRIX_ROW_SPARSE:                                 \
+          for (t = row->offset; t < row->offset + row->n_taps; t++)           \
+            outval += (acctype) (in[taps[t]] * coefs[t]);                     \
+          break;                                                              \
+        case GST_AUDIO_MIX_MATRIX_ROW_DENSE:{                                 \
+          const acctype *m = matrix + o * inchannels;                         \
+          for (t = 0; t < inchannels; t++)                                    \
+            outval += (acctype) (in[t] * m[t]);                               \
+          break;                                                              \
+        }                                                                     \
+      }                                                                       \
+      out[o] = (ctype) (outval >> shift);                                     \
+    }                                                                         \
+    in += inchannels;                                                         \
+    out += outchannels;                                                       \
+  }                                                                           \
+}
+
+/* Planar samples: one output channel at a time, every input channel that
+ * contributes to it is added with a vectorized multiply-add over the whole
+ * plane */
+
+#define DEFINE_MIX_PLANAR_FLOAT(fmt, ctype, axpy)                             \
+static void                                                                   \
+mix_planar_##fmt (GstAudioMixMatrix * self, ctype ** in, ctype ** out,        \
+    guint n_samples)                                                          \
+{                                                                             \
+  const guint *taps = self->taps;                                             \
+  const ctype *coefs = self->fmt##_taps;                                      \
+  guint o, t;                                                                 \
+                                                                              \
+  for (o = 0; o < self->out_channels; o++) {                                  \
+    const GstAudioMixMatrixRow *row = &self->rows[o];                         \
+                                                                              \
+    if (row->type == GST_AUDIO_MIX_MATRIX_ROW_COPY) {                         \
+      memcpy (out[o], in[taps[row->offset]], n_samples * sizeof (ctype));     \
+      continue;                                                               \
+    }                                                                         \
+                                                                              \
+    memset (out[o], 0, n_samples * sizeof (ctype));                           \
+    for (t = row->offset; t < row->offset + row->n_taps; t++)                 \
+      axpy (out[o], in[taps[t]], coefs[t], n_samples);                        \
+  }                                                                           \
+}
+
+#define PLANAR_BLOCK_SIZE 256
+
+#define DEFINE_MIX_PLANAR_INT(fmt, ctype, acctype)                            \
+static void                                                                   \
+mix_planar_##fmt (GstAudioMixMatrix * self, ctype ** in, ctype ** out,        \
+    guint n_samples)                                                          \
+{                                                                             \
+  const guint *taps = self->taps;                                             \
+  const acctype *coefs = self->fmt##_taps;                                    \
+  const guint shift = self->shift_bytes;                                      \
+  acctype acc[PLANAR_BLOCK_SIZE];                                             \
+  guint o, t, i, start, len;                                                  \
+                                                                              \
+  for (o = 0; o < self->out_channels; o++) {                                  \
+    const GstAudioMixMatrixRow *row = &self->rows[o];                         \
+                                                                              \
+    if (row->type == GST_AUDIO_MIX_MATRIX_ROW_COPY) {                         \
+      memcpy (out[o], in[taps[row->offset]], n_samples * sizeof (ctype));     \
+      continue;                                                               \
+    }                                                                         \
+                                                                              \
+    for (start = 0; start < n_samples; start += PLANAR_BLOCK_SIZE) {          \
+      len = MIN (n_samples - start, PLANAR_BLOCK_SIZE);                       \
+                                                                              \
+      memset (acc, 0, len * sizeof (acctype));                                \
+      for (t = row->offset; t < row->offset + row->n_taps; t++) {             \
+        const ctype *src = in[taps[t]] + start;                               \
+        const acctype c = coefs[t];                                           \
+        for (i = 0; i < len; i++)                                             \
+          acc[i] += (acctype) (src[i] * c);                                   \
+      }                                                                       \
+      for (i = 0; i < len; i++)                                               \
+        out[o][start + i] = (ctype) (acc[i] >> shift);                        \
+    }                                                                         \
+  }                                                                           \
+}
+
+DEFINE_MIX_INTERLEAVED_FLOAT (f32, gfloat, dot_f32, f32_matrix);
+DEFINE_MIX_INTERLEAVED_FLOAT (f64, gdouble, dot_f64, matrix);
+DEFINE_MIX_INTERLEAVED_INT (s16, gint16, gint32);
+DEFINE_MIX_INTERLEAVED_INT (s32, gint32, gint64);
+DEFINE_MIX_PLANAR_FLOAT (f32, gfloat, axpy_f32);
+DEFINE_MIX_PLANAR_FLOAT (f64, gdouble, axpy_f64);
+DEFINE_MIX_PLANAR_INT (s16, gint16, gint32);
+DEFINE_MIX_PLANAR_INT (s32, gint32, gint64);
+
 static void
 gst_audio_mix_matrix_dispose (GObject * object)
 {
@@ -240,6 +633,8 @@ gst_audio_mix_matrix_dispose (GObject * object)
     self->matrix = NULL;
   }
 
+  gst_audio_mix_matrix_free_rows (self);
+
   G_OBJECT_CLASS (gst_audio_mix_matrix_parent_class)->dispose (object);
 }
 
@@ -280,6 +675,42 @@ gst_audio_mix_matrix_convert_s32_matrix (GstAudioMixMatrix * self)
 }
 
 
+/* Returns a newly allocated matrix with the coefficients of @value, or %NULL
+ * if it does not have @out_channels rows of @in_channels doubles */
+static gdouble *
+gst_audio_mix_matrix_parse_matrix (const GValue * value, guint in_channels,
+    guint out_channels)
+{
+  gdouble *matrix;
+  guint in, out;
+
+  g_return_val_if_fail (gst_value_array_get_size (value) == out_channels,
+      NULL);
+
+  matrix = g_new (gdouble, in_channels * out_channels);
+  for (out = 0; out < out_channels; out++) {
+    const GValue *row = gst_value_array_get_value (value, out);
+
+    if (gst_value_array_get_size (row) != in_channels)
+      goto invalid;
+    for (in = 0; in < in_channels; in++) {
+      const GValue *itm = gst_value_array_get_value (row, in);
+
+      if (!G_VALUE_HOLDS_DOUBLE (itm))
+        goto invalid;
+      matrix[out * in_channels + in] = g_value_get_double (itm);
+    }
+  }
+
+  return matrix;
+
+invalid:
+  g_free (matrix);
+  g_return_val_if_reached (NULL);
+}
+
+/* The matrix and everything derived from it is protected by the object lock,
+ * the streaming thread uses them while mixing */
 static void
 gst_audio_mix_matrix_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
@@ -288,42 +719,39 @@ gst_audio_mix_matrix_set_property (GObject * object, guint prop_id,
 
   switch (prop_id) {
     case PROP_IN_CHANNELS:
+      GST_OBJECT_LOCK (self);
       self->in_channels = g_value_get_uint (value);
       if (self->matrix) {
         gst_audio_mix_matrix_convert_s16_matrix (self);
         gst_audio_mix_matrix_convert_s32_matrix (self);
+        gst_audio_mix_matrix_update_rows (self);
       }
+      GST_OBJECT_UNLOCK (self);
       break;
     case PROP_OUT_CHANNELS:
+      GST_OBJECT_LOCK (self);
       self->out_channels = g_value_get_uint (value);
       if (self->matrix) {
         gst_audio_mix_matrix_convert_s16_matrix (self);
         gst_audio_mix_matrix_convert_s32_matrix (self);
+        gst_audio_mix_matrix_update_rows (self);
       }
+      GST_OBJECT_UNLOCK (self);
       break;
     case PROP_MATRIX:{
-      gint in, out;
+      gdouble *matrix;
 
-      if (self->matrix)
+      GST_OBJECT_LOCK (self);
+      matrix = gst_audio_mix_matrix_parse_matrix (value, self->in_channels,
+          self->out_channels);
+      if (matrix) {
         g_free (self->matrix);
-      self->matrix = g_new (gdouble, self->in_channels * self->out_channels);
-
-      g_return_if_fail (gst_value_array_get_size (value) == self->out_channels);
-      for (out = 0; out < self->out_channels; out++) {
-        const GValue *row = gst_value_array_get_value (value, out);
-        g_return_if_fail (gst_value_array_get_size (row) == self->in_channels);
-        for (in = 0; in < self->in_channels; in++) {
-          const GValue *itm;
-          gdouble coefficient;
-
-          itm = gst_value_array_get_value (row, in);
-          g_return_if_fail (G_VALUE_HOLDS_DOUBLE (itm));
-          coefficient = g_value_get_double (itm);
-          self->matrix[out * self->in_channels + in] = coefficient;
-        }
+        self->matrix = matrix;
+        gst_audio_mix_matrix_convert_s16_matrix (self);
+        gst_audio_mix_matrix_convert_s32_matrix (self);
+        gst_audio_mix_matrix_update_rows (self);
       }
-      gst_audio_mix_matrix_convert_s16_matrix (self);
-      gst_audio_mix_matrix_convert_s32_matrix (self);
+      GST_OBJECT_UNLOCK (self);
       break;
     }
     case PROP_CHANNEL_MASK:
@@ -354,8 +782,11 @@ gst_audio_mix_matrix_get_property (GObject * object, guint prop_id,
     case PROP_MATRIX:{
       gint in, out;
 
-      if (self->matrix == NULL)
+      GST_OBJECT_LOCK (self);
+      if (self->matrix == NULL) {
+        GST_OBJECT_UNLOCK (self);
         break;
+      }
 
       for (out = 0; out < self->out_channels; out++) {
         GValue row = G_VALUE_INIT;
@@ -370,6 +801,7 @@ gst_audio_mix_matrix_get_property (GObject * object, guint prop_id,
         gst_value_array_append_value (value, &row);
         g_value_unset (&row);
       }
+      GST_OBJECT_UNLOCK (self);
       break;
     }
     case PROP_CHANNEL_MASK:
@@ -395,6 +827,7 @@ gst_audio_mix_matrix_change_state (GstElement * element,
       (element, transition);
 
   if (transition == GST_STATE_CHANGE_PAUSED_TO_READY) {
+    GST_OBJECT_LOCK (self);
     if (self->s16_conv_matrix) {
       g_free (self->s16_conv_matrix);
       self->s16_conv_matrix = NULL;
@@ -404,131 +837,129 @@ gst_audio_mix_matrix_change_state (GstElement * element,
       g_free (self->s32_conv_matrix);
       self->s32_conv_matrix = NULL;
     }
+
+    gst_audio_mix_matrix_free_rows (self);
+    GST_OBJECT_UNLOCK (self);
   }
 
   return s;
 }
 
 
+static GstFlowReturn
+gst_audio_mix_matrix_prepare_output_buffer (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
+{
+  GstAudioMixMatrix *self = GST_AUDIO_MIX_MATRIX (trans);
+  GstFlowReturn ret;
+
+  ret =
+      GST_BASE_TRANSFORM_CLASS
+      (gst_audio_mix_matrix_parent_class)->prepare_output_buffer (trans, inbuf,
+      outbuf);
+
+  /* the planes of non-interleaved output are described by a meta */
+  if (ret == GST_FLOW_OK && GST_AUDIO_INFO_LAYOUT (&self->out_info) ==
+      GST_AUDIO_LAYOUT_NON_INTERLEAVED) {
+    GstAudioMeta *meta = gst_buffer_get_audio_meta (*outbuf);
+    gsize n_samples;
+
+    if (meta)
+      gst_buffer_remove_meta (*outbuf, (GstMeta *) meta);
+
+    n_samples = gst_buffer_get_size (*outbuf) /
+        GST_AUDIO_INFO_BPF (&self->out_info);
+    gst_buffer_add_audio_meta (*outbuf, &self->out_info, n_samples, NULL);
+  }
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_audio_mix_matrix_transform (GstBaseTransform * vfilter,
     GstBuffer * inbuf, GstBuffer * outbuf)
 {
-  GstMapInfo inmap, outmap;
+  GstAudioBuffer inabuf, outabuf;
   GstAudioMixMatrix *self = GST_AUDIO_MIX_MATRIX (vfilter);
-  gint in, out, sample;
-  guint inchannels = self->in_channels;
-  guint outchannels = self->out_channels;
-  gdouble *matrix = self->matrix;
+  gboolean planar;
+  guint n_samples;
+
+  planar = GST_AUDIO_INFO_LAYOUT (&self->in_info) ==
+      GST_AUDIO_LAYOUT_NON_INTERLEAVED;
 
-  if (!gst_buffer_map (inbuf, &inmap, GST_MAP_READ)) {
+  if (planar && !gst_buffer_get_audio_meta (inbuf)) {
+    GST_ELEMENT_ERROR (self, STREAM, FORMAT, (NULL),
+        ("Non-interleaved input buffer without GstAudioMeta"));
     return GST_FLOW_ERROR;
   }
-  if (!gst_buffer_map (outbuf, &outmap, GST_MAP_WRITE)) {
-    gst_buffer_unmap (inbuf, &inmap);
+
+  if (!gst_audio_buffer_map (&inabuf, &self->in_info, inbuf, GST_MAP_READ)) {
+    return GST_FLOW_ERROR;
+  }
+  if (!gst_audio_buffer_map (&outabuf, &self->out_info, outbuf,
+          GST_MAP_WRITE)) {
+    gst_audio_buffer_unmap (&inabuf);
     return GST_FLOW_ERROR;
   }
 
+  n_samples = MIN (inabuf.n_samples, outabuf.n_samples);
+
+  GST_OBJECT_LOCK (self);
+  if (!self->rows) {
+    GST_OBJECT_UNLOCK (self);
+    gst_audio_buffer_unmap (&inabuf);
+    gst_audio_buffer_unmap (&outabuf);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
   switch (self->format) {
     case GST_AUDIO_FORMAT_F32LE:
-    case GST_AUDIO_FORMAT_F32BE:{
-      const gfloat *inarray;
-      gfloat *outarray;
-      guint n_samples = outmap.size / (sizeof (gfloat) * outchannels);
-
-      inarray = (gfloat *) inmap.data;
-      outarray = (gfloat *) outmap.data;
-
-      for (sample = 0; sample < n_samples; sample++) {
-        for (out = 0; out < outchannels; out++) {
-          gfloat outval = 0;
-          for (in = 0; in < inchannels; in++) {
-            outval +=
-                inarray[sample * inchannels +
-                in] * matrix[out * inchannels + in];
-          }
-          outarray[sample * outchannels + out] = outval;
-        }
-      }
+    case GST_AUDIO_FORMAT_F32BE:
+      if (planar)
+        mix_planar_f32 (self, (gfloat **) inabuf.planes,
+            (gfloat **) outabuf.planes, n_samples);
+      else
+        mix_interleaved_f32 (self, inabuf.planes[0], outabuf.planes[0],
+            n_samples);
       break;
-    }
     case GST_AUDIO_FORMAT_F64LE:
-    case GST_AUDIO_FORMAT_F64BE:{
-      const gdouble *inarray;
-      gdouble *outarray;
-      guint n_samples = outmap.size / (sizeof (gdouble) * outchannels);
-
-      inarray = (gdouble *) inmap.data;
-      outarray = (gdouble *) outmap.data;
-
-      for (sample = 0; sample < n_samples; sample++) {
-        for (out = 0; out < outchannels; out++) {
-          gdouble outval = 0;
-          for (in = 0; in < inchannels; in++) {
-            outval +=
-                inarray[sample * inchannels +
-                in] * matrix[out * inchannels + in];
-          }
-          outarray[sample * outchannels + out] = outval;
-        }
-      }
+    case GST_AUDIO_FORMAT_F64BE:
+      if (planar)
+        mix_planar_f64 (self, (gdouble **) inabuf.planes,
+            (gdouble **) outabuf.planes, n_samples);
+      else
+        mix_interleaved_f64 (self, inabuf.planes[0], outabuf.planes[0],
+            n_samples);
       break;
-    }
     case GST_AUDIO_FORMAT_S16LE:
-    case GST_AUDIO_FORMAT_S16BE:{
-      const gint16 *inarray;
-      gint16 *outarray;
-      guint n_samples = outmap.size / (sizeof (gint16) * outchannels);
-      guint n = self->shift_bytes;
-      gint32 *conv_matrix = self->s16_conv_matrix;
-
-      inarray = (gint16 *) inmap.data;
-      outarray = (gint16 *) outmap.data;
-
-      for (sample = 0; sample < n_samples; sample++) {
-        for (out = 0; out < outchannels; out++) {
-          gint32 outval = 0;
-          for (in = 0; in < inchannels; in++) {
-            outval += (gint32) (inarray[sample * inchannels + in] *
-                conv_matrix[out * inchannels + in]);
-          }
-          outarray[sample * outchannels + out] = (gint16) (outval >> n);
-        }
-      }
+    case GST_AUDIO_FORMAT_S16BE:
+      if (planar)
+        mix_planar_s16 (self, (gint16 **) inabuf.planes,
+            (gint16 **) outabuf.planes, n_samples);
+      else
+        mix_interleaved_s16 (self, inabuf.planes[0], outabuf.planes[0],
+            n_samples);
       break;
-    }
     case GST_AUDIO_FORMAT_S32LE:
-    case GST_AUDIO_FORMAT_S32BE:{
-      const gint32 *inarray;
-      gint32 *outarray;
-      guint n_samples = outmap.size / (sizeof (gint32) * outchannels);
-      guint n = self->shift_bytes;
-      gint64 *conv_matrix = self->s32_conv_matrix;
-
-      inarray = (gint32 *) inmap.data;
-      outarray = (gint32 *) outmap.data;
-
-      for (sample = 0; sample < n_samples; sample++) {
-        for (out = 0; out < outchannels; out++) {
-          gint64 outval = 0;
-          for (in = 0; in < inchannels; in++) {
-            outval += (gint64) (inarray[sample * inchannels + in] *
-                conv_matrix[out * inchannels + in]);
-          }
-          outarray[sample * outchannels + out] = (gint32) (outval >> n);
-        }
-      }
+    case GST_AUDIO_FORMAT_S32BE:
+      if (planar)
+        mix_planar_s32 (self, (gint32 **) inabuf.planes,
+            (gint32 **) outabuf.planes, n_samples);
+      else
+        mix_interleaved_s32 (self, inabuf.planes[0], outabuf.planes[0],
+            n_samples);
       break;
-    }
     default:
-      gst_buffer_unmap (inbuf, &inmap);
-      gst_buffer_unmap (outbuf, &outmap);
+      GST_OBJECT_UNLOCK (self);
+      gst_audio_buffer_unmap (&inabuf);
+      gst_audio_buffer_unmap (&outabuf);
       return GST_FLOW_NOT_SUPPORTED;
 
   }
+  GST_OBJECT_UNLOCK (self);
 
-  gst_buffer_unmap (inbuf, &inmap);
-  gst_buffer_unmap (outbuf, &outmap);
+  gst_audio_buffer_unmap (&inabuf);
+  gst_audio_buffer_unmap (&outabuf);
   return GST_FLOW_OK;
 }
 
@@ -559,7 +990,15 @@ gst_audio_mix_matrix_set_caps (GstBaseTransform * trans, GstCaps * incaps,
   if (!gst_audio_info_from_caps (&out_info, outcaps))
     return FALSE;
 
+  if (GST_AUDIO_INFO_LAYOUT (&info) != GST_AUDIO_INFO_LAYOUT (&out_info)) {
+    GST_ERROR_OBJECT (self, "Input and output layout must be the same");
+    return FALSE;
+  }
+
+  GST_OBJECT_LOCK (self);
   self->format = info.finfo->format;
+  self->in_info = info;
+  self->out_info = out_info;
 
   if (self->mode == GST_AUDIO_MIX_MATRIX_MODE_FIRST_CHANNELS) {
     gint in, out;
@@ -567,6 +1006,7 @@ gst_audio_mix_matrix_set_caps (GstBaseTransform * trans, GstCaps * incaps,
     self->in_channels = info.channels;
     self->out_channels = out_info.channels;
 
+    g_free (self->matrix);
     self->matrix = g_new (gdouble, self->in_channels * self->out_channels);
 
     for (out = 0; out < self->out_channels; out++) {
@@ -576,6 +1016,7 @@ gst_audio_mix_matrix_set_caps (GstBaseTransform * trans, GstCaps * incaps,
     }
   } else if (!self->matrix || info.channels != self->in_channels ||
       out_info.channels != self->out_channels) {
+    GST_OBJECT_UNLOCK (self);
     GST_ELEMENT_ERROR (self, LIBRARY, SETTINGS,
         ("Erroneous matrix detected"),
         ("Please enter a matrix with the correct input and output channels"));
@@ -596,6 +1037,10 @@ gst_audio_mix_matrix_set_caps (GstBaseTransform * trans, GstCaps * incaps,
     default:
       break;
   }
+
+  gst_audio_mix_matrix_update_rows (self);
+  GST_OBJECT_UNLOCK (self);
+
   return TRUE;
 }
 
@@ -36,6 +36,7 @@
 
 typedef struct _GstAudioMixMatrix GstAudioMixMatrix;
 typedef struct _GstAudioMixMatrixClass GstAudioMixMatrixClass;
+typedef struct _GstAudioMixMatrixRow GstAudioMixMatrixRow;
 
 typedef enum _GstAudioMixMatrixMode
 {
@@ -43,6 +44,24 @@ typedef enum _GstAudioMixMatrixMode
   GST_AUDIO_MIX_MATRIX_MODE_FIRST_CHANNELS = 1
 } GstAudioMixMatrixMode;
 
+typedef enum
+{
+  GST_AUDIO_MIX_MATRIX_ROW_ZERO,        /* all coefficients are 0 */
+  GST_AUDIO_MIX_MATRIX_ROW_COPY,        /* a single coefficient of 1 */
+  GST_AUDIO_MIX_MATRIX_ROW_SPARSE,      /* few non-zero coefficients */
+  GST_AUDIO_MIX_MATRIX_ROW_DENSE        /* everything else */
+} GstAudioMixMatrixRowType;
+
+/* How to compute one output channel: the non-zero coefficients are those of
+ * the input channels taps[offset] to taps[offset + n_taps - 1]. Dense rows
+ * are computed from the full matrix row instead. */
+struct _GstAudioMixMatrixRow
+{
+  GstAudioMixMatrixRowType type;
+  guint n_taps;
+  guint offset;
+};
+
 /**
  * GstAudioMixMatrix:
  *
@@ -62,7 +81,18 @@ struct _GstAudioMixMatrix
   gint64 *s32_conv_matrix;
   gint shift_bytes;
 
+  /* Per output channel plan, derived from the matrix */
+  GstAudioMixMatrixRow *rows;
+  gfloat *f32_matrix;
+  guint *taps;
+  gfloat *f32_taps;
+  gdouble *f64_taps;
+  gint32 *s16_taps;
+  gint64 *s32_taps;
+
   GstAudioFormat format;
+  GstAudioInfo in_info;
+  GstAudioInfo out_info;
 };
 
 struct _GstAudioMixMatrixClass
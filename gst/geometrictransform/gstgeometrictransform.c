@@ -24,6 +24,13 @@
 #include "gstgeometrictransform.h"
 #include "geometricmath.h"
 #include <string.h>
+#include <math.h>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 GST_DEBUG_CATEGORY_STATIC (geometric_transform_debug);
 #define GST_CAT_DEFAULT geometric_transform_debug
@@ -49,7 +56,9 @@ static GstVideoFilterClass *parent_class = NULL;
 enum
 {
   PROP_0,
-  PROP_OFF_EDGE_PIXELS
+  PROP_OFF_EDGE_PIXELS,
+  PROP_INTERPOLATION,
+  PROP_N_THREADS
 };
 
 #define GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE ( \
@@ -76,6 +85,91 @@ gst_geometric_transform_off_edges_pixels_method_get_type (void)
 
 #define DEFAULT_OFF_EDGE_PIXELS GST_GT_OFF_EDGES_PIXELS_IGNORE
 
+#define GST_GT_INTERPOLATION_TYPE ( \
+    gst_geometric_transform_interpolation_get_type())
+static GType
+gst_geometric_transform_interpolation_get_type (void)
+{
+  static GType interpolation_type = 0;
+
+  static const GEnumValue interpolation_types[] = {
+    {GST_GT_INTERPOLATION_NEAREST, "Nearest neighbour", "nearest"},
+    {GST_GT_INTERPOLATION_BILINEAR, "Bilinear", "bilinear"},
+    {0, NULL, NULL}
+  };
+
+  if (!interpolation_type) {
+    interpolation_type =
+        g_enum_register_static ("GstGeometricTransformInterpolation",
+        interpolation_types);
+  }
+  return interpolation_type;
+}
+
+#define DEFAULT_INTERPOLATION GST_GT_INTERPOLATION_NEAREST
+#define DEFAULT_N_THREADS 1
+
+/* sub-pixel positions are in 1/128ths, so the four bilinear weights of a
+ * pixel always add up to 1 << 14 */
+#define GT_FRAC_BITS 7
+#define GT_FRAC_ONE (1 << GT_FRAC_BITS)
+#define GT_WEIGHT_SHIFT (2 * GT_FRAC_BITS)
+#define GT_WEIGHT_ROUND (1 << (GT_WEIGHT_SHIFT - 1))
+
+#define GT_NO_PIXEL G_MAXUINT16
+
+/* Converts the input position calculated by the subclass into a map entry.
+ * Must be called with the object lock */
+static void
+gst_geometric_transform_make_entry (GstGeometricTransform * gt, gdouble in_x,
+    gdouble in_y, GstGeometricTransformMapEntry * entry)
+{
+  /* operate on out of edge pixels */
+  switch (gt->off_edge_pixels) {
+    case GST_GT_OFF_EDGES_PIXELS_CLAMP:
+      in_x = CLAMP (in_x, 0, gt->width - 1);
+      in_y = CLAMP (in_y, 0, gt->height - 1);
+      break;
+
+    case GST_GT_OFF_EDGES_PIXELS_WRAP:
+      in_x = gst_gm_mod_float (in_x, gt->width);
+      in_y = gst_gm_mod_float (in_y, gt->height);
+      if (in_x < 0)
+        in_x += gt->width;
+      if (in_y < 0)
+        in_y += gt->height;
+      break;
+
+    default:
+      break;
+  }
+
+  /* the comparisons are written so that NaN ends up as no pixel */
+  if (gt->interpolation == GST_GT_INTERPOLATION_BILINEAR) {
+    if (in_x >= 0 && in_x < gt->width && in_y >= 0 && in_y < gt->height) {
+      gdouble floor_x = floor (in_x);
+      gdouble floor_y = floor (in_y);
+
+      entry->x = (guint16) floor_x;
+      entry->y = (guint16) floor_y;
+      entry->fx = (guint8) ((in_x - floor_x) * GT_FRAC_ONE);
+      entry->fy = (guint8) ((in_y - floor_y) * GT_FRAC_ONE);
+      return;
+    }
+  } else {
+    /* truncate towards zero, like we always did */
+    if (in_x > -1 && in_x < gt->width && in_y > -1 && in_y < gt->height) {
+      entry->x = (guint16) (gint) in_x;
+      entry->y = (guint16) (gint) in_y;
+      entry->fx = entry->fy = 0;
+      return;
+    }
+  }
+
+  entry->x = entry->y = GT_NO_PIXEL;
+  entry->fx = entry->fy = 0;
+}
+
 /* must be called with the object lock */
 static gboolean
 gst_geometric_transform_generate_map (GstGeometricTransform * gt)
@@ -84,7 +178,7 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
   gdouble in_x, in_y;
   gboolean ret = TRUE;
   GstGeometricTransformClass *klass;
-  gdouble *ptr;
+  GstGeometricTransformMapEntry *ptr;
 
   GST_INFO_OBJECT (gt, "Generating new transform map");
 
@@ -98,9 +192,9 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
   g_return_val_if_fail (klass->map_func, FALSE);
 
   /*
-   * (x,y) pairs of the inverse mapping
+   * input positions of the inverse mapping
    */
-  gt->map = g_malloc0 (sizeof (gdouble) * gt->width * gt->height * 2);
+  gt->map = g_new (GstGeometricTransformMapEntry, gt->width * gt->height);
   ptr = gt->map;
 
   for (y = 0; y < gt->height; y++) {
@@ -111,9 +205,8 @@ gst_geometric_transform_generate_map (GstGeometricTransform * gt)
         goto end;
       }
 
-      ptr[0] = in_x;
-      ptr[1] = in_y;
-      ptr += 2;
+      gst_geometric_transform_make_entry (gt, in_x, in_y, ptr);
+      ptr++;
     }
   }
 
@@ -143,8 +236,15 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
   old_width = gt->width;
   old_height = gt->height;
 
+  if (in_info->width >= GT_NO_PIXEL || in_info->height >= GT_NO_PIXEL) {
+    GST_ERROR_OBJECT (gt, "Unsupported frame size %dx%d", in_info->width,
+        in_info->height);
+    return FALSE;
+  }
+
   gt->width = in_info->width;
   gt->height = in_info->height;
+  gt->format = GST_VIDEO_INFO_FORMAT (in_info);
   gt->row_stride = in_info->stride[0];
   gt->pixel_stride = GST_VIDEO_INFO_COMP_PSTRIDE (in_info, 0);
 
@@ -164,48 +264,282 @@ gst_geometric_transform_set_info (GstVideoFilter * vfilter, GstCaps * incaps,
   return ret;
 }
 
+#define NEAREST_ROW(ps) G_STMT_START {                                   \
+  for (x = 0; x < gt->width; x++) {                                       \
+    if (map[x].x == GT_NO_PIXEL)                                          \
+      continue;                                                           \
+    memcpy (out + x * (ps),                                               \
+        in_data + map[x].y * in_stride + map[x].x * (ps), (ps));          \
+  }                                                                       \
+} G_STMT_END
+
 static void
-gst_geometric_transform_do_map (GstGeometricTransform * gt, guint8 * in_data,
-    guint8 * out_data, gint x, gint y, gdouble in_x, gdouble in_y)
+gst_geometric_transform_nearest_row (GstGeometricTransform * gt,
+    const GstGeometricTransformMapEntry * map, const guint8 * in_data,
+    gint in_stride, guint8 * out)
 {
-  gint in_offset;
-  gint out_offset;
+  gint x;
 
-  out_offset = y * gt->row_stride + x * gt->pixel_stride;
-
-  /* operate on out of edge pixels */
-  switch (gt->off_edge_pixels) {
-    case GST_GT_OFF_EDGES_PIXELS_CLAMP:
-      in_x = CLAMP (in_x, 0, gt->width - 1);
-      in_y = CLAMP (in_y, 0, gt->height - 1);
+  /* constant sizes let the compiler turn the memcpy into a single move */
+  switch (gt->pixel_stride) {
+    case 1:
+      NEAREST_ROW (1);
       break;
-
-    case GST_GT_OFF_EDGES_PIXELS_WRAP:
-      in_x = gst_gm_mod_float (in_x, gt->width);
-      in_y = gst_gm_mod_float (in_y, gt->height);
-      if (in_x < 0)
-        in_x += gt->width;
-      if (in_y < 0)
-        in_y += gt->height;
+    case 2:
+      NEAREST_ROW (2);
+      break;
+    case 3:
+      NEAREST_ROW (3);
+      break;
+    case 4:
+      NEAREST_ROW (4);
       break;
-
     default:
+      NEAREST_ROW (gt->pixel_stride);
       break;
   }
+}
 
-  {
-    gint trunc_x = (gint) in_x;
-    gint trunc_y = (gint) in_y;
-    /* only set the values if the values are valid */
-    if (trunc_x >= 0 && trunc_x < gt->width && trunc_y >= 0 &&
-        trunc_y < gt->height) {
-      in_offset = trunc_y * gt->row_stride + trunc_x * gt->pixel_stride;
+#undef NEAREST_ROW
 
-      memcpy (out_data + out_offset, in_data + in_offset, gt->pixel_stride);
+/* Interpolates between four pixels with 4 8-bit components each */
+static inline void
+gst_geometric_transform_bilinear_4x8 (const guint8 * p00, const guint8 * p01,
+    const guint8 * p10, const guint8 * p11, guint w00, guint w01, guint w10,
+    guint w11, guint8 * out)
+{
+#if defined (__SSE2__)
+  const __m128i zero = _mm_setzero_si128 ();
+  guint32 v00, v01, v10, v11;
+  __m128i top, bottom, acc;
+
+  memcpy (&v00, p00, 4);
+  memcpy (&v01, p01, 4);
+  memcpy (&v10, p10, 4);
+  memcpy (&v11, p11, 4);
+
+  /* c0 of p00, c0 of p01, c1 of p00, ... as 16 bits so that one
+   * multiply-add per row gives the weighted sum of each component */
+  top = _mm_unpacklo_epi8 (_mm_unpacklo_epi8 (_mm_cvtsi32_si128 (v00),
+          _mm_cvtsi32_si128 (v01)), zero);
+  bottom = _mm_unpacklo_epi8 (_mm_unpacklo_epi8 (_mm_cvtsi32_si128 (v10),
+          _mm_cvtsi32_si128 (v11)), zero);
+
+  acc = _mm_add_epi32 (_mm_madd_epi16 (top, _mm_set1_epi32 ((w01 << 16) | w00)),
+      _mm_madd_epi16 (bottom, _mm_set1_epi32 ((w11 << 16) | w10)));
+  acc = _mm_srli_epi32 (_mm_add_epi32 (acc, _mm_set1_epi32 (GT_WEIGHT_ROUND)),
+      GT_WEIGHT_SHIFT);
+  acc = _mm_packs_epi32 (acc, acc);
+  acc = _mm_packus_epi16 (acc, acc);
+
+  v00 = _mm_cvtsi128_si32 (acc);
+  memcpy (out, &v00, 4);
+#elif defined (__ARM_NEON)
+  guint32 v00, v01, v10, v11;
+  uint32x4_t acc;
+  uint16x4_t res;
+
+  memcpy (&v00, p00, 4);
+  memcpy (&v01, p01, 4);
+  memcpy (&v10, p10, 4);
+  memcpy (&v11, p11, 4);
+
+#define GT_LOAD_4X8(v) \
+  vget_low_u16 (vmovl_u8 (vreinterpret_u8_u32 (vdup_n_u32 (v))))
+  acc = vmull_n_u16 (GT_LOAD_4X8 (v00), w00);
+  acc = vmlal_n_u16 (acc, GT_LOAD_4X8 (v01), w01);
+  acc = vmlal_n_u16 (acc, GT_LOAD_4X8 (v10), w10);
+  acc = vmlal_n_u16 (acc, GT_LOAD_4X8 (v11), w11);
+#undef GT_LOAD_4X8
+
+  /* rounding shift, adds GT_WEIGHT_ROUND like the scalar version */
+  res = vrshrn_n_u32 (acc, GT_WEIGHT_SHIFT);
+  v00 = vget_lane_u32 (vreinterpret_u32_u8 (vmovn_u16 (vcombine_u16 (res,
+                  res))), 0);
+  memcpy (out, &v00, 4);
+#else
+  gint c;
+
+  for (c = 0; c < 4; c++)
+    out[c] = (p00[c] * w00 + p01[c] * w01 + p10[c] * w10 + p11[c] * w11 +
+        GT_WEIGHT_ROUND) >> GT_WEIGHT_SHIFT;
+#endif
+}
+
+static void
+gst_geometric_transform_bilinear_row (GstGeometricTransform * gt,
+    const GstGeometricTransformMapEntry * map, const guint8 * in_data,
+    gint in_stride, guint8 * out)
+{
+  gint ps = gt->pixel_stride;
+  gboolean wrap = gt->off_edge_pixels == GST_GT_OFF_EDGES_PIXELS_WRAP;
+  gint x, c;
+
+  for (x = 0; x < gt->width; x++) {
+    const guint8 *row0, *row1;
+    guint x0, x1, y1;
+    guint fx, fy, w00, w01, w10, w11;
+
+    if (map[x].x == GT_NO_PIXEL)
+      continue;
+
+    /* the right and bottom neighbours of the last column and row are
+     * either wrapped around or the edge pixel itself */
+    x0 = map[x].x;
+    x1 = x0 + 1 < gt->width ? x0 + 1 : (wrap ? 0 : x0);
+    y1 = map[x].y + 1 < gt->height ? map[x].y + 1 : (wrap ? 0 : map[x].y);
+
+    row0 = in_data + map[x].y * in_stride;
+    row1 = in_data + y1 * in_stride;
+
+    fx = map[x].fx;
+    fy = map[x].fy;
+    w00 = (GT_FRAC_ONE - fx) * (GT_FRAC_ONE - fy);
+    w01 = fx * (GT_FRAC_ONE - fy);
+    w10 = (GT_FRAC_ONE - fx) * fy;
+    w11 = fx * fy;
+
+    switch (gt->format) {
+      case GST_VIDEO_FORMAT_GRAY16_LE:
+        GST_WRITE_UINT16_LE (out + x * 2,
+            (GST_READ_UINT16_LE (row0 + x0 * 2) * w00 +
+                GST_READ_UINT16_LE (row0 + x1 * 2) * w01 +
+                GST_READ_UINT16_LE (row1 + x0 * 2) * w10 +
+                GST_READ_UINT16_LE (row1 + x1 * 2) * w11 +
+                GT_WEIGHT_ROUND) >> GT_WEIGHT_SHIFT);
+        break;
+      case GST_VIDEO_FORMAT_GRAY16_BE:
+        GST_WRITE_UINT16_BE (out + x * 2,
+            (GST_READ_UINT16_BE (row0 + x0 * 2) * w00 +
+                GST_READ_UINT16_BE (row0 + x1 * 2) * w01 +
+                GST_READ_UINT16_BE (row1 + x0 * 2) * w10 +
+                GST_READ_UINT16_BE (row1 + x1 * 2) * w11 +
+                GT_WEIGHT_ROUND) >> GT_WEIGHT_SHIFT);
+        break;
+      default:
+        if (ps == 4) {
+          gst_geometric_transform_bilinear_4x8 (row0 + x0 * 4, row0 + x1 * 4,
+              row1 + x0 * 4, row1 + x1 * 4, w00, w01, w10, w11, out + x * 4);
+        } else {
+          const guint8 *p00 = row0 + x0 * ps, *p01 = row0 + x1 * ps;
+          const guint8 *p10 = row1 + x0 * ps, *p11 = row1 + x1 * ps;
+
+          for (c = 0; c < ps; c++)
+            out[x * ps + c] = (p00[c] * w00 + p01[c] * w01 + p10[c] * w10 +
+                p11[c] * w11 + GT_WEIGHT_ROUND) >> GT_WEIGHT_SHIFT;
+        }
+        break;
     }
   }
 }
 
+/* map points to the entries of the first row. Called with the object lock
+ * held, possibly from one of the pool threads */
+static void
+gst_geometric_transform_remap_rows (GstGeometricTransform * gt,
+    const GstGeometricTransformMapEntry * map, const guint8 * in_data,
+    gint in_stride, guint8 * out_data, gint out_stride, gint y_start,
+    gint y_end)
+{
+  gint y;
+
+  for (y = y_start; y < y_end; y++) {
+    if (gt->interpolation == GST_GT_INTERPOLATION_BILINEAR)
+      gst_geometric_transform_bilinear_row (gt, map, in_data, in_stride,
+          out_data + y * out_stride);
+    else
+      gst_geometric_transform_nearest_row (gt, map, in_data, in_stride,
+          out_data + y * out_stride);
+    map += gt->width;
+  }
+}
+
+typedef struct
+{
+  GstGeometricTransform *gt;
+  const guint8 *in_data;
+  guint8 *out_data;
+  gint in_stride, out_stride;
+  gint y_start, y_end;
+} GstGeometricTransformBand;
+
+static void
+gst_geometric_transform_band_func (GstGeometricTransformBand * band,
+    gpointer user_data)
+{
+  GstGeometricTransform *gt = band->gt;
+
+  gst_geometric_transform_remap_rows (gt,
+      gt->map + band->y_start * gt->width, band->in_data, band->in_stride,
+      band->out_data, band->out_stride, band->y_start, band->y_end);
+
+  g_mutex_lock (&gt->bands_lock);
+  if (--gt->bands_pending == 0)
+    g_cond_signal (&gt->bands_cond);
+  g_mutex_unlock (&gt->bands_lock);
+}
+
+/* Applies the precalculated map, splitting the frame into one band of rows
+ * per thread. Must be called with the object lock */
+static void
+gst_geometric_transform_remap (GstGeometricTransform * gt,
+    const guint8 * in_data, gint in_stride, guint8 * out_data, gint out_stride)
+{
+  GstGeometricTransformBand *bands;
+  guint n_threads, i;
+
+  n_threads = gt->n_threads ? gt->n_threads : g_get_num_processors ();
+  n_threads = CLAMP (n_threads, 1, gt->height);
+
+  if (n_threads > 1 && (!gt->pool || gt->pool_threads != n_threads - 1)) {
+    GError *err = NULL;
+
+    if (gt->pool)
+      g_thread_pool_free (gt->pool, FALSE, TRUE);
+
+    GST_DEBUG_OBJECT (gt, "Starting %u worker threads", n_threads - 1);
+    gt->pool = g_thread_pool_new ((GFunc) gst_geometric_transform_band_func,
+        NULL, n_threads - 1, TRUE, &err);
+    gt->pool_threads = n_threads - 1;
+    if (!gt->pool) {
+      GST_WARNING_OBJECT (gt, "Failed to start worker threads: %s",
+          err->message);
+      g_clear_error (&err);
+      gt->pool_threads = 0;
+    }
+  }
+
+  if (n_threads <= 1 || !gt->pool) {
+    gst_geometric_transform_remap_rows (gt, gt->map, in_data, in_stride,
+        out_data, out_stride, 0, gt->height);
+    return;
+  }
+
+  bands = g_newa (GstGeometricTransformBand, n_threads);
+  for (i = 0; i < n_threads; i++) {
+    bands[i].gt = gt;
+    bands[i].in_data = in_data;
+    bands[i].out_data = out_data;
+    bands[i].in_stride = in_stride;
+    bands[i].out_stride = out_stride;
+    bands[i].y_start = gt->height * i / n_threads;
+    bands[i].y_end = gt->height * (i + 1) / n_threads;
+  }
+
+  gt->bands_pending = n_threads - 1;
+  for (i = 1; i < n_threads; i++)
+    g_thread_pool_push (gt->pool, &bands[i], NULL);
+
+  /* this thread does the first band itself */
+  gst_geometric_transform_remap_rows (gt, gt->map, in_data, in_stride,
+      out_data, out_stride, bands[0].y_start, bands[0].y_end);
+
+  g_mutex_lock (&gt->bands_lock);
+  while (gt->bands_pending > 0)
+    g_cond_wait (&gt->bands_cond, &gt->bands_lock);
+  g_mutex_unlock (&gt->bands_lock);
+}
+
 static void
 gst_geometric_transform_before_transform (GstBaseTransform * trans,
     GstBuffer * outbuf)
@@ -231,15 +565,17 @@ gst_geometric_transform_transform_frame (GstVideoFilter * vfilter,
   GstGeometricTransformClass *klass;
   gint x, y, i;
   GstFlowReturn ret = GST_FLOW_OK;
-  gdouble *ptr;
   guint8 *in_data;
   guint8 *out_data;
+  gint in_stride, out_stride;
 
   gt = GST_GEOMETRIC_TRANSFORM_CAST (vfilter);
   klass = GST_GEOMETRIC_TRANSFORM_GET_CLASS (gt);
 
   in_data = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
   out_data = GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0);
+  in_stride = GST_VIDEO_FRAME_PLANE_STRIDE (in_frame, 0);
+  out_stride = GST_VIDEO_FRAME_PLANE_STRIDE (out_frame, 0);
 
   if (GST_VIDEO_FRAME_FORMAT (out_frame) == GST_VIDEO_FORMAT_AYUV) {
     /* in AYUV black is not just all zeros:
@@ -262,30 +598,29 @@ gst_geometric_transform_transform_frame (GstVideoFilter * vfilter,
       gst_geometric_transform_generate_map (gt);
     }
     g_return_val_if_fail (gt->map, GST_FLOW_ERROR);
-    ptr = gt->map;
-    for (y = 0; y < gt->height; y++) {
-      for (x = 0; x < gt->width; x++) {
-        /* do the mapping */
-        gst_geometric_transform_do_map (gt, in_data, out_data, x, y, ptr[0],
-            ptr[1]);
-        ptr += 2;
-      }
-    }
+    gst_geometric_transform_remap (gt, in_data, in_stride, out_data,
+        out_stride);
   } else {
+    GstGeometricTransformMapEntry *row;
+
+    row = g_new (GstGeometricTransformMapEntry, gt->width);
     for (y = 0; y < gt->height; y++) {
       for (x = 0; x < gt->width; x++) {
         gdouble in_x, in_y;
 
         if (klass->map_func (gt, x, y, &in_x, &in_y)) {
-          gst_geometric_transform_do_map (gt, in_data, out_data, x, y, in_x,
-              in_y);
+          gst_geometric_transform_make_entry (gt, in_x, in_y, &row[x]);
         } else {
           GST_WARNING_OBJECT (gt, "Failed to do mapping for %d %d", x, y);
           ret = GST_FLOW_ERROR;
+          g_free (row);
           goto end;
         }
       }
+      gst_geometric_transform_remap_rows (gt, row, in_data, in_stride,
+          out_data, out_stride, y, y + 1);
     }
+    g_free (row);
   }
 end:
   GST_OBJECT_UNLOCK (gt);
@@ -301,9 +636,32 @@ gst_geometric_transform_set_property (GObject * object, guint prop_id,
   gt = GST_GEOMETRIC_TRANSFORM_CAST (object);
 
   switch (prop_id) {
-    case PROP_OFF_EDGE_PIXELS:
+    case PROP_OFF_EDGE_PIXELS:{
+      gint v = g_value_get_enum (value);
+
+      /* the edge handling is part of the precalculated map */
+      GST_OBJECT_LOCK (gt);
+      if (v != gt->off_edge_pixels) {
+        gt->off_edge_pixels = v;
+        gst_geometric_transform_set_need_remap (gt);
+      }
+      GST_OBJECT_UNLOCK (gt);
+      break;
+    }
+    case PROP_INTERPOLATION:{
+      gint v = g_value_get_enum (value);
+
+      GST_OBJECT_LOCK (gt);
+      if (v != gt->interpolation) {
+        gt->interpolation = v;
+        gst_geometric_transform_set_need_remap (gt);
+      }
+      GST_OBJECT_UNLOCK (gt);
+      break;
+    }
+    case PROP_N_THREADS:
       GST_OBJECT_LOCK (gt);
-      gt->off_edge_pixels = g_value_get_enum (value);
+      gt->n_threads = g_value_get_uint (value);
       GST_OBJECT_UNLOCK (gt);
       break;
     default:
@@ -324,6 +682,12 @@ gst_geometric_transform_get_property (GObject * object, guint prop_id,
     case PROP_OFF_EDGE_PIXELS:
       g_value_set_enum (value, gt->off_edge_pixels);
       break;
+    case PROP_INTERPOLATION:
+      g_value_set_enum (value, gt->interpolation);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, gt->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -344,9 +708,26 @@ gst_geometric_transform_stop (GstBaseTransform * trans)
   g_free (gt->map);
   gt->map = NULL;
 
+  if (gt->pool) {
+    g_thread_pool_free (gt->pool, FALSE, TRUE);
+    gt->pool = NULL;
+    gt->pool_threads = 0;
+  }
+
   return TRUE;
 }
 
+static void
+gst_geometric_transform_finalize (GObject * object)
+{
+  GstGeometricTransform *gt = GST_GEOMETRIC_TRANSFORM_CAST (object);
+
+  g_mutex_clear (&gt->bands_lock);
+  g_cond_clear (&gt->bands_cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
 static void
 gst_geometric_transform_base_init (gpointer g_class)
 {
@@ -373,6 +754,7 @@ gst_geometric_transform_class_init (gpointer klass, gpointer class_data)
 
   obj_class->set_property = gst_geometric_transform_set_property;
   obj_class->get_property = gst_geometric_transform_get_property;
+  obj_class->finalize = gst_geometric_transform_finalize;
 
   trans_class->stop = GST_DEBUG_FUNCPTR (gst_geometric_transform_stop);
   trans_class->before_transform =
@@ -388,6 +770,18 @@ gst_geometric_transform_class_init (gpointer klass, gpointer class_data)
           "What to do with off edge pixels",
           GST_GT_OFF_EDGES_PIXELS_METHOD_TYPE, DEFAULT_OFF_EDGE_PIXELS,
           GST_PARAM_CONTROLLABLE | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (obj_class, PROP_INTERPOLATION,
+      g_param_spec_enum ("interpolation", "Interpolation",
+          "How to sample the input pixels",
+          GST_GT_INTERPOLATION_TYPE, DEFAULT_INTERPOLATION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (obj_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Number of threads used to apply the transform map "
+          "(0 = number of processors)", 0, G_MAXINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -396,8 +790,13 @@ gst_geometric_transform_init (GTypeInstance * instance, gpointer g_class)
   GstGeometricTransform *gt = GST_GEOMETRIC_TRANSFORM_CAST (instance);
 
   gt->off_edge_pixels = DEFAULT_OFF_EDGE_PIXELS;
+  gt->interpolation = DEFAULT_INTERPOLATION;
+  gt->n_threads = DEFAULT_N_THREADS;
   gt->precalc_map = TRUE;
   gt->needs_remap = TRUE;
+
+  g_mutex_init (&gt->bands_lock);
+  g_cond_init (&gt->bands_cond);
 }
 
 GType
@@ -46,8 +46,15 @@ enum
   GST_GT_OFF_EDGES_PIXELS_WRAP
 };
 
+enum
+{
+  GST_GT_INTERPOLATION_NEAREST = 0,
+  GST_GT_INTERPOLATION_BILINEAR
+};
+
 typedef struct _GstGeometricTransform GstGeometricTransform;
 typedef struct _GstGeometricTransformClass GstGeometricTransformClass;
+typedef struct _GstGeometricTransformMapEntry GstGeometricTransformMapEntry;
 
 /**
  * GstGeometricTransformMapFunc:
@@ -77,6 +84,17 @@ typedef gboolean (*GstGeometricTransformMapFunc) (GstGeometricTransform * gt,
 typedef gboolean (*GstGeometricTransformPrepareFunc) (
     GstGeometricTransform * gt);
 
+/*
+ * One entry of the precalculated inverse map: the integer input pixel
+ * position with off edge pixel handling already applied, plus the
+ * sub-pixel position in 1/128ths used for bilinear interpolation.
+ * x is G_MAXUINT16 if there is no input pixel for this output pixel.
+ */
+struct _GstGeometricTransformMapEntry {
+  guint16 x, y;
+  guint8 fx, fy;
+};
+
 /**
  * GstGeometricTransform:
  *
@@ -99,8 +117,17 @@ struct _GstGeometricTransform {
 
   /* properties */
   gint off_edge_pixels;
+  gint interpolation;
+  guint n_threads;
+
+  GstGeometricTransformMapEntry *map;
 
-  gdouble *map;
+  /* for the row bands processed by other threads */
+  GThreadPool *pool;
+  guint pool_threads;
+  GMutex bands_lock;
+  GCond bands_cond;
+  guint bands_pending;
 };
 
 struct _GstGeometricTransformClass {
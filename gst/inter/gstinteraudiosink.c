@@ -271,7 +271,7 @@ gst_inter_audio_sink_event (GstBaseSink * sink, GstEvent * event)
 
       if ((n = gst_adapter_available (interaudiosink->input_adapter)) > 0) {
         g_mutex_lock (&interaudiosink->surface->mutex);
-        tmp = gst_adapter_take_buffer (interaudiosink->input_adapter, n);
+        tmp = gst_adapter_take_buffer_fast (interaudiosink->input_adapter, n);
         gst_adapter_push (interaudiosink->surface->audio_adapter, tmp);
         g_mutex_unlock (&interaudiosink->surface->mutex);
       }
@@ -333,7 +333,7 @@ gst_inter_audio_sink_render (GstBaseSink * sink, GstBuffer * buffer)
     GstBuffer *tmp;
 
     if (n > 0) {
-      tmp = gst_adapter_take_buffer (interaudiosink->input_adapter, n);
+      tmp = gst_adapter_take_buffer_fast (interaudiosink->input_adapter, n);
       gst_adapter_push (interaudiosink->surface->audio_adapter, tmp);
     }
     gst_adapter_push (interaudiosink->surface->audio_adapter,
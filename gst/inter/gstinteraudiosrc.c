@@ -371,7 +371,9 @@ gst_inter_audio_src_create (GstBaseSrc * src, guint64 offset, guint size,
   if (n > period_samples)
     n = period_samples;
   if (n > 0) {
-    buffer = gst_adapter_take_buffer (interaudiosrc->surface->audio_adapter,
+    /* Don't merge the sink's buffers, the memories are only read anyway */
+    buffer =
+        gst_adapter_take_buffer_fast (interaudiosrc->surface->audio_adapter,
         n * bpf);
   } else {
     buffer = gst_buffer_new ();
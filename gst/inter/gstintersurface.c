@@ -49,6 +49,7 @@ gst_inter_surface_get (const char *name)
   surface->name = g_strdup (name);
   g_mutex_init (&surface->mutex);
   surface->audio_adapter = gst_adapter_new ();
+  surface->video_max_frames = 1;
   surface->audio_buffer_time = DEFAULT_AUDIO_BUFFER_TIME;
   surface->audio_latency_time = DEFAULT_AUDIO_LATENCY_TIME;
   surface->audio_period_time = DEFAULT_AUDIO_PERIOD_TIME;
@@ -78,7 +79,7 @@ gst_inter_surface_unref (GstInterSurface * surface)
     }
 
     g_mutex_clear (&surface->mutex);
-    gst_buffer_replace (&surface->video_buffer, NULL);
+    gst_inter_surface_clear_video_frames (surface);
     gst_buffer_replace (&surface->sub_buffer, NULL);
     gst_object_unref (surface->audio_adapter);
     g_free (surface->name);
@@ -86,3 +87,106 @@ gst_inter_surface_unref (GstInterSurface * surface)
   }
   g_mutex_unlock (&mutex);
 }
+
+/* All the functions below must be called with the surface mutex held. They
+ * only move buffer references around, so that the sink and the sources never
+ * wait on each other for longer than a few pointer updates. */
+
+void
+gst_inter_surface_push_video_frame (GstInterSurface * surface,
+    GstBuffer * buffer, GstClockTime time)
+{
+  GstInterSurfaceFrame *frame;
+
+  g_assert (surface->video_max_frames > 0 &&
+      surface->video_max_frames <= GST_INTER_SURFACE_VIDEO_FRAMES);
+
+  while (surface->video_n_frames >= surface->video_max_frames) {
+    /* Full, drop the oldest frame */
+    frame = &surface->video_frames[surface->video_head];
+    gst_buffer_unref (frame->buffer);
+    frame->buffer = NULL;
+    surface->video_head =
+        (surface->video_head + 1) % GST_INTER_SURFACE_VIDEO_FRAMES;
+    surface->video_n_frames--;
+  }
+
+  frame = &surface->video_frames[(surface->video_head +
+          surface->video_n_frames) % GST_INTER_SURFACE_VIDEO_FRAMES];
+  frame->buffer = gst_buffer_ref (buffer);
+  frame->time = time;
+  frame->seqnum = ++surface->video_seqnum;
+  surface->video_n_frames++;
+}
+
+/* Returns a new reference to the frame to output for @time, or %NULL if there
+ * is none. With a valid @time, this is the frame whose time is the closest,
+ * otherwise the newest one. The frames before the returned one are dropped,
+ * and video_buffer_count is reset whenever a frame is selected for the first
+ * time. */
+GstBuffer *
+gst_inter_surface_select_video_frame (GstInterSurface * surface,
+    GstClockTime time)
+{
+  GstInterSurfaceFrame *frame;
+  guint i, best;
+
+  if (surface->video_n_frames == 0)
+    return NULL;
+
+  best = surface->video_n_frames - 1;
+
+  if (GST_CLOCK_TIME_IS_VALID (time)) {
+    GstClockTime best_diff = GST_CLOCK_TIME_NONE;
+
+    for (i = 0; i < surface->video_n_frames; i++) {
+      GstClockTime diff;
+
+      frame = &surface->video_frames[(surface->video_head + i) %
+          GST_INTER_SURFACE_VIDEO_FRAMES];
+      if (!GST_CLOCK_TIME_IS_VALID (frame->time))
+        continue;
+
+      diff = frame->time > time ? frame->time - time : time - frame->time;
+      /* Times are increasing, so we are moving away from the target */
+      if (diff > best_diff)
+        break;
+
+      best_diff = diff;
+      best = i;
+    }
+  }
+
+  /* Older frames will never be selected again */
+  for (i = 0; i < best; i++) {
+    frame = &surface->video_frames[surface->video_head];
+    gst_buffer_unref (frame->buffer);
+    frame->buffer = NULL;
+    surface->video_head =
+        (surface->video_head + 1) % GST_INTER_SURFACE_VIDEO_FRAMES;
+    surface->video_n_frames--;
+  }
+
+  frame = &surface->video_frames[surface->video_head];
+
+  if (frame->seqnum != surface->video_selected_seqnum) {
+    surface->video_selected_seqnum = frame->seqnum;
+    surface->video_buffer_count = 0;
+  }
+
+  return gst_buffer_ref (frame->buffer);
+}
+
+void
+gst_inter_surface_clear_video_frames (GstInterSurface * surface)
+{
+  while (surface->video_n_frames > 0) {
+    GstInterSurfaceFrame *frame = &surface->video_frames[surface->video_head];
+
+    gst_buffer_unref (frame->buffer);
+    frame->buffer = NULL;
+    surface->video_head =
+        (surface->video_head + 1) % GST_INTER_SURFACE_VIDEO_FRAMES;
+    surface->video_n_frames--;
+  }
+}
@@ -27,6 +27,18 @@
 G_BEGIN_DECLS
 
 typedef struct _GstInterSurface GstInterSurface;
+typedef struct _GstInterSurfaceFrame GstInterSurfaceFrame;
+
+/* Maximum number of video frames kept around for the source to choose from */
+#define GST_INTER_SURFACE_VIDEO_FRAMES 4
+
+struct _GstInterSurfaceFrame
+{
+  GstBuffer *buffer;
+  /* Clock time at which the sink rendered the frame */
+  GstClockTime time;
+  guint64 seqnum;
+};
 
 struct _GstInterSurface
 {
@@ -39,13 +51,21 @@ struct _GstInterSurface
   GstVideoInfo video_info;
   int video_buffer_count;
 
+  /* Ring of the most recent frames, oldest first starting at video_head */
+  GstInterSurfaceFrame video_frames[GST_INTER_SURFACE_VIDEO_FRAMES];
+  guint video_head;
+  guint video_n_frames;
+  /* Set by the source, 1 unless it needs older frames */
+  guint video_max_frames;
+  guint64 video_seqnum;
+  guint64 video_selected_seqnum;
+
   /* audio */
   GstAudioInfo audio_info;
   guint64 audio_buffer_time;
   guint64 audio_latency_time;
   guint64 audio_period_time;
 
-  GstBuffer *video_buffer;
   GstBuffer *sub_buffer;
   GstAdapter *audio_adapter;
 };
@@ -58,6 +78,12 @@ struct _GstInterSurface
 GstInterSurface * gst_inter_surface_get (const char *name);
 void gst_inter_surface_unref (GstInterSurface *surface);
 
+void gst_inter_surface_push_video_frame (GstInterSurface *surface,
+    GstBuffer *buffer, GstClockTime time);
+GstBuffer * gst_inter_surface_select_video_frame (GstInterSurface *surface,
+    GstClockTime time);
+void gst_inter_surface_clear_video_frames (GstInterSurface *surface);
+
 
 G_END_DECLS
 
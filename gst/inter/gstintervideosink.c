@@ -210,10 +210,7 @@ gst_inter_video_sink_stop (GstBaseSink * sink)
   GstInterVideoSink *intervideosink = GST_INTER_VIDEO_SINK (sink);
 
   g_mutex_lock (&intervideosink->surface->mutex);
-  if (intervideosink->surface->video_buffer) {
-    gst_buffer_unref (intervideosink->surface->video_buffer);
-  }
-  intervideosink->surface->video_buffer = NULL;
+  gst_inter_surface_clear_video_frames (intervideosink->surface);
   memset (&intervideosink->surface->video_info, 0, sizeof (GstVideoInfo));
   g_mutex_unlock (&intervideosink->surface->mutex);
 
@@ -246,16 +243,20 @@ static GstFlowReturn
 gst_inter_video_sink_show_frame (GstVideoSink * sink, GstBuffer * buffer)
 {
   GstInterVideoSink *intervideosink = GST_INTER_VIDEO_SINK (sink);
+  GstClockTime time;
 
   GST_DEBUG_OBJECT (intervideosink, "render ts %" GST_TIME_FORMAT,
       GST_TIME_ARGS (GST_BUFFER_PTS (buffer)));
 
+  /* Remember the clock time of the frame, so that the source can pick the
+   * frame matching its own output times */
+  time = gst_segment_to_running_time (&GST_BASE_SINK (sink)->segment,
+      GST_FORMAT_TIME, GST_BUFFER_PTS (buffer));
+  if (GST_CLOCK_TIME_IS_VALID (time))
+    time += gst_element_get_base_time (GST_ELEMENT (sink));
+
   g_mutex_lock (&intervideosink->surface->mutex);
-  if (intervideosink->surface->video_buffer) {
-    gst_buffer_unref (intervideosink->surface->video_buffer);
-  }
-  intervideosink->surface->video_buffer = gst_buffer_ref (buffer);
-  intervideosink->surface->video_buffer_count = 0;
+  gst_inter_surface_push_video_frame (intervideosink->surface, buffer, time);
   g_mutex_unlock (&intervideosink->surface->mutex);
 
   return GST_FLOW_OK;
@@ -71,11 +71,34 @@ enum
 {
   PROP_0,
   PROP_CHANNEL,
-  PROP_TIMEOUT
+  PROP_TIMEOUT,
+  PROP_FRAME_SELECTION
 };
 
 #define DEFAULT_CHANNEL ("default")
 #define DEFAULT_TIMEOUT (GST_SECOND)
+#define DEFAULT_FRAME_SELECTION GST_INTER_VIDEO_SRC_FRAME_SELECTION_LATEST
+
+#define GST_TYPE_INTER_VIDEO_SRC_FRAME_SELECTION \
+  (gst_inter_video_src_frame_selection_get_type())
+static GType
+gst_inter_video_src_frame_selection_get_type (void)
+{
+  static GType type = 0;
+
+  static const GEnumValue values[] = {
+    {GST_INTER_VIDEO_SRC_FRAME_SELECTION_LATEST,
+        "Output the latest frame", "latest"},
+    {GST_INTER_VIDEO_SRC_FRAME_SELECTION_NEAREST,
+        "Output the frame with the nearest timestamp", "nearest"},
+    {0, NULL, NULL}
+  };
+
+  if (!type) {
+    type = g_enum_register_static ("GstInterVideoSrcFrameSelection", values);
+  }
+  return type;
+}
 
 /* pad templates */
 static GstStaticPadTemplate gst_inter_video_src_src_template =
@@ -130,6 +153,23 @@ gst_inter_video_src_class_init (GstInterVideoSrcClass * klass)
           "Timeout after which to start outputting black frames",
           0, G_MAXUINT64, DEFAULT_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstInterVideoSrc:frame-selection:
+   *
+   * How to pick the frame to output among the ones recently rendered by the
+   * intervideosink. "latest" always outputs the newest frame. "nearest"
+   * outputs the frame that was rendered closest to one frame duration before
+   * the time the output frame is due, which avoids dropped and duplicated
+   * frames when the two pipelines run at the same rate with some jitter, at
+   * the cost of one frame of delay. This requires both pipelines to use the
+   * same clock.
+   */
+  g_object_class_install_property (gobject_class, PROP_FRAME_SELECTION,
+      g_param_spec_enum ("frame-selection", "Frame selection",
+          "How to select the frame to output",
+          GST_TYPE_INTER_VIDEO_SRC_FRAME_SELECTION, DEFAULT_FRAME_SELECTION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -140,6 +180,7 @@ gst_inter_video_src_init (GstInterVideoSrc * intervideosrc)
 
   intervideosrc->channel = g_strdup (DEFAULT_CHANNEL);
   intervideosrc->timeout = DEFAULT_TIMEOUT;
+  intervideosrc->frame_selection = DEFAULT_FRAME_SELECTION;
 }
 
 void
@@ -156,6 +197,9 @@ gst_inter_video_src_set_property (GObject * object, guint property_id,
     case PROP_TIMEOUT:
       intervideosrc->timeout = g_value_get_uint64 (value);
       break;
+    case PROP_FRAME_SELECTION:
+      intervideosrc->frame_selection = g_value_get_enum (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -175,6 +219,9 @@ gst_inter_video_src_get_property (GObject * object, guint property_id,
     case PROP_TIMEOUT:
       g_value_set_uint64 (value, intervideosrc->timeout);
       break;
+    case PROP_FRAME_SELECTION:
+      g_value_set_enum (value, intervideosrc->frame_selection);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -327,6 +374,7 @@ gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
   GstCaps *caps;
   GstBuffer *buffer;
   guint64 frames;
+  GstClockTime target = GST_CLOCK_TIME_NONE;
   gboolean is_gap = FALSE;
 
   GST_DEBUG_OBJECT (intervideosrc, "create");
@@ -360,17 +408,35 @@ gst_inter_video_src_create (GstBaseSrc * src, guint64 offset, guint size,
     }
   }
 
-  if (intervideosrc->surface->video_buffer) {
-    /* We have a buffer to push */
-    buffer = gst_buffer_ref (intervideosrc->surface->video_buffer);
-
-    /* Can only be true if timeout > 0 */
-    if (intervideosrc->surface->video_buffer_count == frames) {
-      gst_buffer_unref (intervideosrc->surface->video_buffer);
-      intervideosrc->surface->video_buffer = NULL;
-    }
+  if (intervideosrc->frame_selection ==
+      GST_INTER_VIDEO_SRC_FRAME_SELECTION_NEAREST &&
+      GST_VIDEO_INFO_FPS_N (&intervideosrc->info) > 0) {
+    GstClockTime duration;
+
+    /* Aim one frame back from the clock time this frame is due at, by then
+     * the sink has rendered the frames around it */
+    duration = gst_util_uint64_scale (GST_SECOND,
+        GST_VIDEO_INFO_FPS_D (&intervideosrc->info),
+        GST_VIDEO_INFO_FPS_N (&intervideosrc->info));
+    target = intervideosrc->timestamp_offset +
+        gst_util_uint64_scale (GST_SECOND * intervideosrc->n_frames,
+        GST_VIDEO_INFO_FPS_D (&intervideosrc->info),
+        GST_VIDEO_INFO_FPS_N (&intervideosrc->info)) +
+        gst_element_get_base_time (GST_ELEMENT (src));
+    target = target > duration ? target - duration : 0;
+
+    intervideosrc->surface->video_max_frames = GST_INTER_SURFACE_VIDEO_FRAMES;
+  } else {
+    intervideosrc->surface->video_max_frames = 1;
   }
 
+  buffer = gst_inter_surface_select_video_frame (intervideosrc->surface,
+      target);
+
+  /* Can only be true if timeout > 0 */
+  if (buffer && intervideosrc->surface->video_buffer_count == frames)
+    gst_inter_surface_clear_video_frames (intervideosrc->surface);
+
   if (intervideosrc->surface->video_buffer_count != 0 &&
       intervideosrc->surface->video_buffer_count != (frames + 1)) {
     /* This is a repeat of the stored buffer or of a black frame */
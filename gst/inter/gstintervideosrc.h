@@ -32,6 +32,12 @@ G_BEGIN_DECLS
 #define GST_IS_INTER_VIDEO_SRC(obj)   (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_INTER_VIDEO_SRC))
 #define GST_IS_INTER_VIDEO_SRC_CLASS(obj)   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_INTER_VIDEO_SRC))
 
+typedef enum
+{
+  GST_INTER_VIDEO_SRC_FRAME_SELECTION_LATEST,
+  GST_INTER_VIDEO_SRC_FRAME_SELECTION_NEAREST
+} GstInterVideoSrcFrameSelection;
+
 typedef struct _GstInterVideoSrc GstInterVideoSrc;
 typedef struct _GstInterVideoSrcClass GstInterVideoSrcClass;
 
@@ -43,6 +49,7 @@ struct _GstInterVideoSrc
 
   char *channel;
   guint64 timeout;
+  GstInterVideoSrcFrameSelection frame_selection;
 
   GstVideoInfo info;
   GstBuffer *black_frame;
@@ -35,6 +35,7 @@
 
 #include "mpegtspacketizer.h"
 #include "gstmpegdesc.h"
+#include "mpegtsscan.h"
 
 GST_DEBUG_CATEGORY_STATIC (mpegts_packetizer_debug);
 #define GST_CAT_DEFAULT mpegts_packetizer_debug
@@ -53,13 +54,14 @@ static void mpegts_packetizer_finalize (GObject * object);
 static GstClockTime calculate_skew (MpegTSPacketizer2 * packetizer,
     MpegTSPCR * pcr, guint64 pcrtime, GstClockTime time);
 static void _close_current_group (MpegTSPCR * pcrtable);
+static void mpegts_packetizer_flush_bytes (MpegTSPacketizer2 * packetizer,
+    gsize size);
 static void record_pcr (MpegTSPacketizer2 * packetizer, MpegTSPCR * pcrtable,
     guint64 pcr, guint64 offset);
 
 #define CONTINUITY_UNSET 255
 #define VERSION_NUMBER_UNSET 255
 #define TABLE_ID_UNSET 0xFF
-#define PACKET_SYNC_BYTE 0x47
 
 static inline MpegTSPCR *
 get_pcr_table (MpegTSPacketizer2 * packetizer, guint16 pid)
@@ -290,6 +292,7 @@ mpegts_packetizer_dispose (GObject * object)
     }
 
     gst_adapter_clear (packetizer->adapter);
+    mpegts_packetizer_flush_bytes (packetizer, 0);
     g_object_unref (packetizer->adapter);
     g_mutex_clear (&packetizer->group_lock);
     packetizer->disposed = TRUE;
@@ -572,12 +575,10 @@ mpegts_packetizer_clear (MpegTSPacketizer2 * packetizer)
   }
 
   gst_adapter_clear (packetizer->adapter);
+  mpegts_packetizer_flush_bytes (packetizer, 0);
   packetizer->offset = 0;
   packetizer->empty = TRUE;
   packetizer->need_sync = FALSE;
-  packetizer->map_data = NULL;
-  packetizer->map_size = 0;
-  packetizer->map_offset = 0;
   packetizer->last_in_time = GST_CLOCK_TIME_NONE;
 
   pcrtable = packetizer->observations[packetizer->pcrtablelut[0x1fff]];
@@ -611,13 +612,11 @@ mpegts_packetizer_flush (MpegTSPacketizer2 * packetizer, gboolean hard)
     }
   }
   gst_adapter_clear (packetizer->adapter);
+  mpegts_packetizer_flush_bytes (packetizer, 0);
 
   packetizer->offset = 0;
   packetizer->empty = TRUE;
   packetizer->need_sync = FALSE;
-  packetizer->map_data = NULL;
-  packetizer->map_size = 0;
-  packetizer->map_offset = 0;
   packetizer->last_in_time = GST_CLOCK_TIME_NONE;
 
   pcrtable = packetizer->observations[packetizer->pcrtablelut[0x1fff]];
@@ -693,12 +692,22 @@ mpegts_packetizer_flush_bytes (MpegTSPacketizer2 * packetizer, gsize size)
   packetizer->map_data = NULL;
   packetizer->map_size = 0;
   packetizer->map_offset = 0;
+  if (packetizer->map_buffer) {
+    gst_buffer_unref (packetizer->map_buffer);
+    packetizer->map_buffer = NULL;
+  }
 }
 
+/* Makes sure at least @size bytes are readable from map_data + map_offset.
+ *
+ * Only the contiguous head of the adapter is mapped, which is a zero-copy
+ * operation. The adapter only has to copy when the next @size bytes
+ * straddle a buffer boundary, and in that case exactly @size bytes are
+ * mapped so that the copy is limited to the straddling packet(s). */
 static gboolean
 mpegts_packetizer_map (MpegTSPacketizer2 * packetizer, gsize size)
 {
-  gsize available;
+  gsize available, contiguous;
 
   if (packetizer->map_size - packetizer->map_offset >= size)
     return TRUE;
@@ -709,24 +718,64 @@ mpegts_packetizer_map (MpegTSPacketizer2 * packetizer, gsize size)
   if (available < size)
     return FALSE;
 
+  contiguous = gst_adapter_available_fast (packetizer->adapter);
+  if (contiguous < size)
+    contiguous = size;
+
   packetizer->map_data =
-      (guint8 *) gst_adapter_map (packetizer->adapter, available);
+      (guint8 *) gst_adapter_map (packetizer->adapter, contiguous);
   if (!packetizer->map_data)
     return FALSE;
 
-  packetizer->map_size = available;
+  packetizer->map_size = contiguous;
   packetizer->map_offset = 0;
 
-  GST_LOG ("mapped %" G_GSIZE_FORMAT " bytes from adapter", available);
+  GST_LOG ("mapped %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT
+      " bytes from adapter", contiguous, available);
 
   return TRUE;
 }
 
+/* Returns a memory sharing the @size bytes at @data, which must have been
+ * read from the current packet, or %NULL if they can't be shared because
+ * the adapter had to copy them or they span several input memories */
+GstMemory *
+mpegts_packetizer_share_memory (MpegTSPacketizer2 * packetizer,
+    const guint8 * data, gsize size)
+{
+  GstMemory *mem;
+  gsize offset, skip;
+  guint idx, length;
+
+  if (G_UNLIKELY (packetizer->map_data == NULL || data < packetizer->map_data
+          || data + size > packetizer->map_data + packetizer->map_size))
+    return NULL;
+
+  /* Only looked up once per mapping, and only if something gets shared */
+  if (packetizer->map_buffer == NULL) {
+    packetizer->map_buffer =
+        gst_adapter_get_buffer_fast (packetizer->adapter, packetizer->map_size);
+    if (packetizer->map_buffer == NULL)
+      return NULL;
+  }
+
+  offset = data - packetizer->map_data;
+  if (!gst_buffer_find_memory (packetizer->map_buffer, offset, size, &idx,
+          &length, &skip) || length != 1)
+    return NULL;
+
+  mem = gst_buffer_peek_memory (packetizer->map_buffer, idx);
+  if (GST_MEMORY_FLAG_IS_SET (mem, GST_MEMORY_FLAG_NO_SHARE))
+    return NULL;
+
+  return gst_memory_share (mem, skip, size);
+}
+
 static gboolean
 mpegts_try_discover_packet_size (MpegTSPacketizer2 * packetizer)
 {
-  guint8 *data;
-  gsize size, i, j;
+  const guint8 *data, *sync;
+  gsize size, end, i, j;
 
   static const guint psizes[] = {
     MPEGTS_NORMAL_PACKETSIZE,
@@ -735,40 +784,45 @@ mpegts_try_discover_packet_size (MpegTSPacketizer2 * packetizer)
     MPEGTS_ATSC_PACKETSIZE
   };
 
-  if (!mpegts_packetizer_map (packetizer, 4 * MPEGTS_MAX_PACKETSIZE))
-    return FALSE;
-
-  size = packetizer->map_size - packetizer->map_offset;
-  data = packetizer->map_data + packetizer->map_offset;
-
-  for (i = 0; i + 3 * MPEGTS_MAX_PACKETSIZE < size; i++) {
-    /* find a sync byte */
-    if (data[i] != PACKET_SYNC_BYTE)
-      continue;
+  /* Only part of the available data might be mapped, keep going until
+   * we either detected the packet size or ran out of data */
+  while (mpegts_packetizer_map (packetizer, 4 * MPEGTS_MAX_PACKETSIZE)) {
+    size = packetizer->map_size - packetizer->map_offset;
+    data = packetizer->map_data + packetizer->map_offset;
+    end = size - 3 * MPEGTS_MAX_PACKETSIZE;
+
+    for (i = 0; i < end; i++) {
+      /* find a sync byte */
+      sync = memchr (data + i, PACKET_SYNC_BYTE, end - i);
+      if (sync == NULL) {
+        i = end;
+        break;
+      }
+      i = sync - data;
 
-    /* check for 4 consecutive sync bytes with each possible packet size */
-    for (j = 0; j < G_N_ELEMENTS (psizes); j++) {
-      guint packet_size = psizes[j];
+      /* check for 4 consecutive sync bytes with each possible packet size */
+      for (j = 0; j < G_N_ELEMENTS (psizes); j++) {
+        guint packet_size = psizes[j];
 
-      if (data[i + packet_size] == PACKET_SYNC_BYTE &&
-          data[i + 2 * packet_size] == PACKET_SYNC_BYTE &&
-          data[i + 3 * packet_size] == PACKET_SYNC_BYTE) {
-        packetizer->packet_size = packet_size;
-        goto out;
+        if (data[i + packet_size] == PACKET_SYNC_BYTE &&
+            data[i + 2 * packet_size] == PACKET_SYNC_BYTE &&
+            data[i + 3 * packet_size] == PACKET_SYNC_BYTE) {
+          packetizer->packet_size = packet_size;
+          goto out;
+        }
       }
     }
-  }
 
-out:
-  packetizer->map_offset += i;
-
-  if (packetizer->packet_size == 0) {
     GST_DEBUG ("Could not determine packet size in %" G_GSIZE_FORMAT
         " bytes buffer, flush %" G_GSIZE_FORMAT " bytes", size, i);
-    mpegts_packetizer_flush_bytes (packetizer, packetizer->map_offset);
-    return FALSE;
+    mpegts_packetizer_flush_bytes (packetizer, packetizer->map_offset + i);
   }
 
+  return FALSE;
+
+out:
+  packetizer->map_offset += i;
+
   GST_INFO ("have packetsize detected: %u bytes", packetizer->packet_size);
 
   if (packetizer->packet_size == MPEGTS_M2TS_PACKETSIZE &&
@@ -781,39 +835,35 @@ out:
 static gboolean
 mpegts_packetizer_sync (MpegTSPacketizer2 * packetizer)
 {
-  gboolean found = FALSE;
   guint8 *data;
   guint packet_size;
-  gsize size, sync_offset, i;
+  gsize size, end, sync_offset, i;
 
   packet_size = packetizer->packet_size;
 
-  if (!mpegts_packetizer_map (packetizer, 3 * packet_size))
-    return FALSE;
-
-  size = packetizer->map_size - packetizer->map_offset;
-  data = packetizer->map_data + packetizer->map_offset;
-
   if (packet_size == MPEGTS_M2TS_PACKETSIZE)
     sync_offset = 4;
   else
     sync_offset = 0;
 
-  for (i = sync_offset; i + 2 * packet_size < size; i++) {
-    if (data[i] == PACKET_SYNC_BYTE &&
-        data[i + packet_size] == PACKET_SYNC_BYTE &&
-        data[i + 2 * packet_size] == PACKET_SYNC_BYTE) {
-      found = TRUE;
-      break;
-    }
-  }
+  /* Only part of the available data might be mapped, keep going until
+   * we either found sync or ran out of data */
+  while (mpegts_packetizer_map (packetizer, 3 * packet_size)) {
+    size = packetizer->map_size - packetizer->map_offset;
+    data = packetizer->map_data + packetizer->map_offset;
+    end = size - 2 * packet_size - sync_offset;
 
-  packetizer->map_offset += i - sync_offset;
+    i = mpegts_packetizer_scan_sync (data + sync_offset, end, packet_size);
 
-  if (!found)
-    mpegts_packetizer_flush_bytes (packetizer, packetizer->map_offset);
+    if (i < end) {
+      packetizer->map_offset += i;
+      return TRUE;
+    }
+
+    mpegts_packetizer_flush_bytes (packetizer, packetizer->map_offset + i);
+  }
 
-  return found;
+  return FALSE;
 }
 
 MpegTSPacketizerPacketReturn
@@ -268,6 +268,8 @@ struct _MpegTSPacketizer2 {
   gsize map_offset;
   gsize map_size;
   gboolean need_sync;
+  /* Input buffer(s) behind map_data, to share payloads from */
+  GstBuffer *map_buffer;
 
   /* Reference offset */
   guint64 refoffset;
@@ -348,6 +350,8 @@ G_GNUC_INTERNAL MpegTSPacketizerPacketReturn
 mpegts_packetizer_process_next_packet(MpegTSPacketizer2 * packetizer);
 G_GNUC_INTERNAL void mpegts_packetizer_clear_packet (MpegTSPacketizer2 *packetizer,
 				     MpegTSPacketizerPacket *packet);
+G_GNUC_INTERNAL GstMemory *mpegts_packetizer_share_memory (MpegTSPacketizer2 *packetizer,
+    const guint8 *data, gsize size);
 G_GNUC_INTERNAL void mpegts_packetizer_remove_stream(MpegTSPacketizer2 *packetizer,
   gint16 pid);
 
@@ -0,0 +1,97 @@
+/*
+ * mpegtsscan.h : MPEG-TS sync byte scanning
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Only meant to be included by mpegtspacketizer.c and by the packetizer
+ * benchmark in tests/examples/mpegts, which times the very same code */
+
+#ifndef __MPEGTS_SCAN_H__
+#define __MPEGTS_SCAN_H__
+
+#include <glib.h>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#elif defined (__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+G_BEGIN_DECLS
+
+#define PACKET_SYNC_BYTE 0x47
+
+/* Returns the first offset i < @end for which data[i], data[i + packet_size]
+ * and data[i + 2 * packet_size] are all sync bytes, or @end if there is none.
+ * @data must be readable up to @end + 2 * @packet_size bytes. */
+static inline gsize
+mpegts_packetizer_scan_sync (const guint8 * data, gsize end, guint packet_size)
+{
+  const guint8 *data1 = data + packet_size;
+  const guint8 *data2 = data + 2 * packet_size;
+  gsize i = 0;
+
+#if defined (__SSE2__)
+  {
+    const __m128i sync = _mm_set1_epi8 (PACKET_SYNC_BYTE);
+    __m128i m;
+    gint mask;
+
+    for (; i + 16 <= end; i += 16) {
+      m = _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i *) (data + i)),
+          sync);
+      m = _mm_and_si128 (m,
+          _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i *) (data1 + i)),
+              sync));
+      m = _mm_and_si128 (m,
+          _mm_cmpeq_epi8 (_mm_loadu_si128 ((const __m128i *) (data2 + i)),
+              sync));
+      mask = _mm_movemask_epi8 (m);
+      if (mask)
+        return i + g_bit_nth_lsf (mask, -1);
+    }
+  }
+#elif defined (__ARM_NEON)
+  {
+    const uint8x16_t sync = vdupq_n_u8 (PACKET_SYNC_BYTE);
+    uint8x16_t m;
+    uint64x2_t m64;
+
+    for (; i + 16 <= end; i += 16) {
+      m = vceqq_u8 (vld1q_u8 (data + i), sync);
+      m = vandq_u8 (m, vceqq_u8 (vld1q_u8 (data1 + i), sync));
+      m = vandq_u8 (m, vceqq_u8 (vld1q_u8 (data2 + i), sync));
+      m64 = vreinterpretq_u64_u8 (m);
+      /* The scalar loop below finds the exact position within this block */
+      if (vgetq_lane_u64 (m64, 0) | vgetq_lane_u64 (m64, 1))
+        break;
+    }
+  }
+#endif
+
+  for (; i < end; i++) {
+    if (data[i] == PACKET_SYNC_BYTE &&
+        data1[i] == PACKET_SYNC_BYTE && data2[i] == PACKET_SYNC_BYTE)
+      return i;
+  }
+
+  return end;
+}
+
+G_END_DECLS
+
+#endif /* __MPEGTS_SCAN_H__ */
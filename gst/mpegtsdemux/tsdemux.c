@@ -82,6 +82,10 @@
  * up to this size */
 #define MAX_PES_PAYLOAD (32 * 1024 * 1024)
 
+/* Largest initial allocation for a PES of unbounded length. Bigger ones
+ * grow by doubling, which only costs a few reallocs at that size */
+#define MAX_PES_SIZE_HINT (1024 * 1024)
+
 GST_DEBUG_CATEGORY_STATIC (ts_demux_debug);
 #define GST_CAT_DEFAULT ts_demux_debug
 
@@ -167,6 +171,9 @@ struct _TSDemuxStream
 
   /* Data being reconstructed (allocated) */
   guint8 *data;
+  /* Or, instead of ->data, the memories of the input packets it was
+   * collected from */
+  GstBuffer *shared;
 
   /* Size of data being reconstructed (if known, else 0) */
   guint expected_size;
@@ -175,6 +182,10 @@ struct _TSDemuxStream
   guint current_size;
   /* Size of ->data */
   guint allocated_size;
+  /* Decaying maximum of the recent PES payload sizes of this stream, up to
+   * MAX_PES_SIZE_HINT, used to allocate ->data when the PES packet length
+   * is unbounded */
+  guint size_hint;
 
   /* Current PTS/DTS for this stream (in running time) */
   GstClockTime pts;
@@ -1931,6 +1942,10 @@ gst_ts_demux_stream_flush (TSDemuxStream * stream, GstTSDemux * tsdemux,
 
   g_free (stream->data);
   stream->data = NULL;
+  if (stream->shared) {
+    gst_buffer_unref (stream->shared);
+    stream->shared = NULL;
+  }
   stream->state = PENDING_PACKET_EMPTY;
   stream->expected_size = 0;
   stream->allocated_size = 0;
@@ -2330,6 +2345,50 @@ check_pending_buffers (GstTSDemux * demux)
   return TRUE;
 }
 
+/* Whether the payload of the PES starting now can be collected by sharing
+ * the memories of the input packets rather than copying them. That is only
+ * done if nothing has to parse it before it's pushed, and if it's expected
+ * to fit in the memories of a single buffer, one per packet */
+static gboolean
+gst_ts_demux_stream_can_share (TSDemuxStream * stream)
+{
+  MpegTSBaseStream *bs = (MpegTSBaseStream *) stream;
+  guint size;
+
+  if (stream->needs_keyframe)
+    return FALSE;
+
+  if ((bs->stream_type == GST_MPEGTS_STREAM_TYPE_PRIVATE_PES_PACKETS &&
+          bs->registration_id == DRF_ID_OPUS) ||
+      bs->stream_type == GST_MPEGTS_STREAM_TYPE_VIDEO_JP2K)
+    return FALSE;
+
+  size = stream->expected_size ? stream->expected_size : stream->size_hint;
+  return size / (MPEGTS_NORMAL_PACKETSIZE - 4) < gst_buffer_get_max_memory ();
+}
+
+/* Copies the payload collected in ->shared into ->data, leaving room for
+ * @extra more bytes. Done once a PES turns out to need more memories than a
+ * buffer can hold, or when it has to be parsed */
+static void
+gst_ts_demux_stream_merge_shared (TSDemuxStream * stream, guint extra)
+{
+  GST_LOG ("merging %u shared memories",
+      gst_buffer_n_memory (stream->shared));
+
+  if (stream->expected_size)
+    stream->allocated_size = stream->expected_size;
+  else
+    stream->allocated_size = MAX (8192, stream->size_hint);
+  stream->allocated_size =
+      MAX (stream->allocated_size, stream->current_size + extra);
+
+  stream->data = g_malloc (stream->allocated_size);
+  gst_buffer_extract (stream->shared, 0, stream->data, stream->current_size);
+  gst_buffer_unref (stream->shared);
+  stream->shared = NULL;
+}
+
 static void
 gst_ts_demux_parse_pes_header (GstTSDemux * demux, TSDemuxStream * stream,
     guint8 * data, guint32 length, guint64 bufferoffset)
@@ -2388,15 +2447,34 @@ gst_ts_demux_parse_pes_header (GstTSDemux * demux, TSDemuxStream * stream,
   data += header.header_size;
   length -= header.header_size;
 
+  g_assert (stream->data == NULL && stream->shared == NULL);
+
+  if (gst_ts_demux_stream_can_share (stream)) {
+    stream->shared = gst_buffer_new ();
+    if (length > 0) {
+      GstMemory *mem =
+          mpegts_packetizer_share_memory (MPEG_TS_BASE_PACKETIZER (demux),
+          data, length);
+
+      if (mem) {
+        gst_buffer_append_memory (stream->shared, mem);
+      } else {
+        gst_buffer_unref (stream->shared);
+        stream->shared = NULL;
+      }
+    }
+  }
+
   /* Create the output buffer */
-  if (stream->expected_size)
-    stream->allocated_size = MAX (stream->expected_size, length);
-  else
-    stream->allocated_size = MAX (8192, length);
+  if (stream->shared == NULL) {
+    if (stream->expected_size)
+      stream->allocated_size = MAX (stream->expected_size, length);
+    else
+      stream->allocated_size = MAX (MAX (8192, stream->size_hint), length);
 
-  g_assert (stream->data == NULL);
-  stream->data = g_malloc (stream->allocated_size);
-  memcpy (stream->data, data, length);
+    stream->data = g_malloc (stream->allocated_size);
+    memcpy (stream->data, data, length);
+  }
   stream->current_size = length;
 
   stream->state = PENDING_PACKET_BUFFER;
@@ -2460,6 +2538,19 @@ gst_ts_demux_queue_data (GstTSDemux * demux, TSDemuxStream * stream,
     case PENDING_PACKET_BUFFER:
     {
       GST_LOG ("BUFFER: appending data");
+      if (stream->shared) {
+        GstMemory *mem = NULL;
+
+        if (gst_buffer_n_memory (stream->shared) < gst_buffer_get_max_memory ())
+          mem = mpegts_packetizer_share_memory (MPEG_TS_BASE_PACKETIZER (demux),
+              data, size);
+        if (mem) {
+          gst_buffer_append_memory (stream->shared, mem);
+          stream->current_size += size;
+          break;
+        }
+        gst_ts_demux_stream_merge_shared (stream, size);
+      }
       if (G_UNLIKELY (stream->current_size + size > stream->allocated_size)) {
         GST_LOG ("resizing buffer");
         do {
@@ -2478,6 +2569,10 @@ gst_ts_demux_queue_data (GstTSDemux * demux, TSDemuxStream * stream,
         g_free (stream->data);
         stream->data = NULL;
       }
+      if (G_UNLIKELY (stream->shared)) {
+        gst_buffer_unref (stream->shared);
+        stream->shared = NULL;
+      }
       stream->continuity_counter = CONTINUITY_UNSET;
       break;
     }
@@ -2906,6 +3001,28 @@ error:
   return NULL;
 }
 
+/* Wraps the reassembled PES into a buffer, giving back what the block
+ * has beyond it if that is a lot. g_realloc() may move the block even when
+ * shrinking it, so this must be done before anything points into it */
+static GstBuffer *
+gst_ts_demux_stream_wrap_data (TSDemuxStream * stream)
+{
+  if (stream->shared) {
+    GstBuffer *buffer = stream->shared;
+
+    stream->shared = NULL;
+    return buffer;
+  }
+
+  if (stream->current_size > 0 &&
+      stream->allocated_size > stream->current_size + 65536) {
+    stream->data = g_realloc (stream->data, stream->current_size);
+    stream->allocated_size = stream->current_size;
+  }
+
+  return gst_buffer_new_wrapped (stream->data, stream->current_size);
+}
+
 static GstFlowReturn
 gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
     MpegTSBaseProgram * target_program)
@@ -2921,7 +3038,7 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
       "stream:%p, pid:0x%04x stream_type:%d state:%d", stream, bs->pid,
       bs->stream_type, stream->state);
 
-  if (G_UNLIKELY (stream->data == NULL)) {
+  if (G_UNLIKELY (stream->data == NULL && stream->shared == NULL)) {
     GST_LOG ("stream->data == NULL");
     goto beach;
   }
@@ -2942,6 +3059,17 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
     goto beach;
   }
 
+  /* Size the next PES after the recent ones, so that large video access
+   * units don't have to go through a chain of reallocs. The hint decays
+   * within a few PES, so an occasional big one doesn't inflate the
+   * allocations of the following small ones for long */
+  stream->size_hint = MAX (MIN (stream->current_size, MAX_PES_SIZE_HINT),
+      stream->size_hint - (stream->size_hint >> 3));
+
+  /* The keyframe search needs contiguous data */
+  if (stream->needs_keyframe && stream->shared)
+    gst_ts_demux_stream_merge_shared (stream, 0);
+
   if (stream->needs_keyframe) {
     MpegTSBase *base = (MpegTSBase *) demux;
 
@@ -2971,7 +3099,7 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
           goto beach;
         }
       } else {
-        buffer = gst_buffer_new_wrapped (stream->data, stream->current_size);
+        buffer = gst_ts_demux_stream_wrap_data (stream);
       }
 
       stream->seeked_pts = stream->pts;
@@ -3011,7 +3139,7 @@ gst_ts_demux_push_pending_data (GstTSDemux * demux, TSDemuxStream * stream,
         goto beach;
       }
     } else {
-      buffer = gst_buffer_new_wrapped (stream->data, stream->current_size);
+      buffer = gst_ts_demux_stream_wrap_data (stream);
     }
 
     if (G_UNLIKELY (stream->pending_ts && !check_pending_buffers (demux))) {
@@ -3166,6 +3294,10 @@ beach:
       stream->expected_size -= stream->current_size;
   }
   stream->data = NULL;
+  if (stream->shared) {
+    gst_buffer_unref (stream->shared);
+    stream->shared = NULL;
+  }
   stream->allocated_size = 0;
   stream->current_size = 0;
 
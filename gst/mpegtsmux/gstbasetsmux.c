@@ -300,6 +300,8 @@ steal_si_section (GstMpegtsSectionType * type, TsMuxSection * section,
   return TRUE;
 }
 
+static void gst_base_ts_mux_clear_chunks (GstBaseTsMux * mux);
+
 static void
 gst_base_ts_mux_reset (GstBaseTsMux * mux, gboolean alloc)
 {
@@ -320,6 +322,7 @@ gst_base_ts_mux_reset (GstBaseTsMux * mux, gboolean alloc)
 
   if (mux->out_adapter)
     gst_adapter_clear (mux->out_adapter);
+  gst_base_ts_mux_clear_chunks (mux);
 
   if (mux->tsmux) {
     if (mux->tsmux->si_sections)
@@ -801,7 +804,7 @@ new_packet_common_init (GstBaseTsMux * mux, GstBuffer * buf, guint8 * data,
         hbuf = gst_buffer_new_and_alloc (len);
         gst_buffer_fill (hbuf, 0, data, len);
       } else {
-        hbuf = gst_buffer_copy (buf);
+        hbuf = gst_buffer_copy_deep (buf);
       }
       GST_LOG_OBJECT (mux,
           "Collecting packet with pid 0x%04x into streamheaders", pid);
@@ -851,17 +854,260 @@ finish_buffer_list (GstBaseTsMux * mux, GstBufferList * list)
   return ret;
 }
 
+static gint
+gst_base_ts_mux_get_alignment (GstBaseTsMux * mux)
+{
+  if (mux->alignment < 0)
+    return mux->automatic_alignment;
+
+  return mux->alignment;
+}
+
+/* Output chunk handling
+ *
+ * When the output is aligned, packets are not allocated one by one but
+ * handed out as slots of a chunk of alignment * packet_size bytes that is
+ * taken from a buffer pool. Once all packets of a chunk have been output,
+ * the chunk is pushed to the output adapter as a whole, from where
+ * gst_base_ts_mux_push_packets() can take it without merging or copying.
+ *
+ * Packets are expected to be output in the order they were allocated. */
+typedef struct
+{
+  GstBuffer *buffer;
+  GstMapInfo map;
+  gsize packet_size;
+  guint n_slots;
+  guint n_allocated;
+  guint n_written;
+
+  /* metadata of the first packet, only applied to the output once the
+   * packets no longer reference the chunk buffer */
+  GstClockTime pts;
+  GstClockTime dts;
+  GstBufferFlags flags;
+} GstBaseTsMuxChunk;
+
+static void
+gst_base_ts_mux_chunk_free (GstBaseTsMuxChunk * chunk)
+{
+  gst_buffer_unmap (chunk->buffer, &chunk->map);
+  gst_buffer_unref (chunk->buffer);
+  g_slice_free (GstBaseTsMuxChunk, chunk);
+}
+
+/* Pushes the packets that were written into @chunk so far to the
+ * output adapter, and frees @chunk */
+static void
+gst_base_ts_mux_chunk_finish (GstBaseTsMux * mux, GstBaseTsMuxChunk * chunk)
+{
+  GstBuffer *buf;
+  GstClockTime pts, dts;
+  GstBufferFlags flags;
+  guint n_written;
+  gsize size;
+
+  if (chunk->n_written == 0) {
+    gst_base_ts_mux_chunk_free (chunk);
+    return;
+  }
+
+  n_written = chunk->n_written;
+  size = n_written * chunk->packet_size;
+  pts = chunk->pts;
+  dts = chunk->dts;
+  flags = chunk->flags;
+  buf = gst_buffer_ref (chunk->buffer);
+  gst_base_ts_mux_chunk_free (chunk);
+
+  /* Slots that were handed out but not written yet still reference the
+   * chunk buffer, output the written part as a new buffer then */
+  if (gst_buffer_is_writable (buf)) {
+    if (size < gst_buffer_get_size (buf))
+      gst_buffer_resize (buf, 0, size);
+  } else {
+    GstBuffer *sub;
+
+    sub = gst_buffer_copy_region (buf, GST_BUFFER_COPY_MEMORY, 0, size);
+    gst_buffer_unref (buf);
+    buf = sub;
+  }
+
+  /* Like GstAdapter, give the chunk the metadata of its first packet */
+  GST_BUFFER_PTS (buf) = pts;
+  GST_BUFFER_DTS (buf) = dts;
+  GST_BUFFER_FLAG_SET (buf, flags);
+
+  GST_LOG_OBJECT (mux, "collecting chunk of %u packets", n_written);
+  gst_adapter_push (mux->out_adapter, buf);
+}
+
+static void
+gst_base_ts_mux_flush_chunks (GstBaseTsMux * mux)
+{
+  GstBaseTsMuxChunk *chunk;
+
+  while ((chunk = g_queue_pop_head (&mux->out_chunks)))
+    gst_base_ts_mux_chunk_finish (mux, chunk);
+}
+
+static void
+gst_base_ts_mux_clear_chunks (GstBaseTsMux * mux)
+{
+  GstBaseTsMuxChunk *chunk;
+
+  while ((chunk = g_queue_pop_head (&mux->out_chunks)))
+    gst_base_ts_mux_chunk_free (chunk);
+
+  if (mux->out_pool) {
+    gst_buffer_pool_set_active (mux->out_pool, FALSE);
+    gst_object_unref (mux->out_pool);
+    mux->out_pool = NULL;
+  }
+  mux->out_chunk_size = 0;
+}
+
+static gboolean
+gst_base_ts_mux_ensure_out_pool (GstBaseTsMux * mux, gsize chunk_size)
+{
+  GstStructure *config;
+
+  if (mux->out_pool && mux->out_chunk_size == chunk_size)
+    return TRUE;
+
+  if (mux->out_pool) {
+    gst_buffer_pool_set_active (mux->out_pool, FALSE);
+    gst_object_unref (mux->out_pool);
+  }
+
+  mux->out_pool = gst_buffer_pool_new ();
+  mux->out_chunk_size = chunk_size;
+
+  config = gst_buffer_pool_get_config (mux->out_pool);
+  gst_buffer_pool_config_set_params (config, NULL, chunk_size, 0, 0);
+
+  if (!gst_buffer_pool_set_config (mux->out_pool, config) ||
+      !gst_buffer_pool_set_active (mux->out_pool, TRUE)) {
+    GST_WARNING_OBJECT (mux, "failed to set up output chunk pool");
+    gst_object_unref (mux->out_pool);
+    mux->out_pool = NULL;
+    mux->out_chunk_size = 0;
+    return FALSE;
+  }
+
+  GST_DEBUG_OBJECT (mux, "using output chunks of %" G_GSIZE_FORMAT " bytes",
+      chunk_size);
+
+  return TRUE;
+}
+
+/* Returns a packet buffer that wraps the next free slot of the current
+ * output chunk, or NULL if the output is not aligned */
+static GstBuffer *
+gst_base_ts_mux_chunk_alloc_packet (GstBaseTsMux * mux)
+{
+  GstBaseTsMuxChunk *chunk;
+  GstBuffer *buf;
+  gint align;
+  guint8 *data;
+
+  align = gst_base_ts_mux_get_alignment (mux);
+  chunk = g_queue_peek_tail (&mux->out_chunks);
+
+  /* Stop filling the current chunk if the layout changed */
+  if (chunk && (align <= 0 || chunk->n_slots != align ||
+          chunk->packet_size != mux->packet_size))
+    chunk->n_slots = chunk->n_allocated;
+
+  if (align <= 0)
+    return NULL;
+
+  if (!chunk || chunk->n_allocated == chunk->n_slots) {
+    if (!gst_base_ts_mux_ensure_out_pool (mux, align * mux->packet_size))
+      return NULL;
+
+    if (gst_buffer_pool_acquire_buffer (mux->out_pool, &buf,
+            NULL) != GST_FLOW_OK)
+      return NULL;
+
+    chunk = g_slice_new0 (GstBaseTsMuxChunk);
+    chunk->buffer = buf;
+    chunk->packet_size = mux->packet_size;
+    chunk->n_slots = align;
+
+    if (!gst_buffer_map (buf, &chunk->map, GST_MAP_WRITE)) {
+      gst_buffer_unref (buf);
+      g_slice_free (GstBaseTsMuxChunk, chunk);
+      return NULL;
+    }
+
+    g_queue_push_tail (&mux->out_chunks, chunk);
+  }
+
+  data = chunk->map.data + chunk->n_allocated * chunk->packet_size;
+  chunk->n_allocated++;
+
+  /* The packet keeps the chunk alive for as long as it references it */
+  return gst_buffer_new_wrapped_full (0, data, chunk->packet_size, 0,
+      chunk->packet_size, gst_buffer_ref (chunk->buffer),
+      (GDestroyNotify) gst_buffer_unref);
+}
+
+/* Returns TRUE if @buf was written into the next slot of the oldest
+ * output chunk, in which case @buf is consumed */
+static gboolean
+gst_base_ts_mux_chunk_collect_packet (GstBaseTsMux * mux, GstBuffer * buf)
+{
+  GstBaseTsMuxChunk *chunk;
+  GstMapInfo map;
+  gboolean in_chunk;
+
+  chunk = g_queue_peek_head (&mux->out_chunks);
+  if (!chunk || gst_buffer_n_memory (buf) != 1)
+    return FALSE;
+
+  if (!gst_buffer_map (buf, &map, GST_MAP_READ))
+    return FALSE;
+  in_chunk = (map.data ==
+      chunk->map.data + chunk->n_written * chunk->packet_size);
+  gst_buffer_unmap (buf, &map);
+
+  if (!in_chunk)
+    return FALSE;
+
+  /* The other slots still reference the chunk buffer, so the metadata of
+   * the first packet is only remembered here */
+  if (chunk->n_written == 0) {
+    chunk->pts = GST_BUFFER_PTS (buf);
+    chunk->dts = GST_BUFFER_DTS (buf);
+    chunk->flags = GST_BUFFER_FLAGS (buf) & ~GST_BUFFER_FLAG_TAG_MEMORY;
+  }
+
+  chunk->n_written++;
+  gst_buffer_unref (buf);
+
+  while ((chunk = g_queue_peek_head (&mux->out_chunks)) &&
+      chunk->n_written == chunk->n_slots) {
+    g_queue_pop_head (&mux->out_chunks);
+    gst_base_ts_mux_chunk_finish (mux, chunk);
+  }
+
+  return TRUE;
+}
+
 static GstFlowReturn
 gst_base_ts_mux_push_packets (GstBaseTsMux * mux, gboolean force)
 {
   GstBufferList *buffer_list;
-  gint align = mux->alignment;
+  gint align;
   gint av, packet_size;
 
   packet_size = mux->packet_size;
+  align = gst_base_ts_mux_get_alignment (mux);
 
-  if (align < 0)
-    align = mux->automatic_alignment;
+  /* Partially filled chunks are only output when draining */
+  if (force)
+    gst_base_ts_mux_flush_chunks (mux);
 
   av = gst_adapter_available (mux->out_adapter);
   GST_LOG_OBJECT (mux, "align %d, av %d", align, av);
@@ -956,6 +1202,13 @@ gst_base_ts_mux_collect_packet (GstBaseTsMux * mux, GstBuffer * buf)
 {
   GST_LOG_OBJECT (mux, "collecting packet size %" G_GSIZE_FORMAT,
       gst_buffer_get_size (buf));
+
+  if (gst_base_ts_mux_chunk_collect_packet (mux, buf))
+    return GST_FLOW_OK;
+
+  /* Not written into a chunk, everything allocated before it has been
+   * output by now so the pending chunks go first */
+  gst_base_ts_mux_flush_chunks (mux);
   gst_adapter_push (mux->out_adapter, buf);
 
   return GST_FLOW_OK;
@@ -1809,7 +2062,9 @@ gst_base_ts_mux_default_allocate_packet (GstBaseTsMux * mux,
 {
   GstBuffer *buf;
 
-  buf = gst_buffer_new_and_alloc (mux->packet_size);
+  buf = gst_base_ts_mux_chunk_alloc_packet (mux);
+  if (!buf)
+    buf = gst_buffer_new_and_alloc (mux->packet_size);
 
   *buffer = buf;
 }
@@ -197,6 +197,11 @@ struct GstBaseTsMux {
   /* output buffer aggregation */
   GstAdapter *out_adapter;
   GstBuffer *out_buffer;
+
+  /* aligned output chunks that packets are written into directly */
+  GstBufferPool *out_pool;
+  gsize out_chunk_size;
+  GQueue out_chunks;
 };
 
 /**
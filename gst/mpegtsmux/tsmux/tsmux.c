@@ -1008,15 +1008,13 @@ static gboolean
 tsmux_section_write_packet (gpointer unused_arg,
     TsMuxSection * section, TsMux * mux)
 {
-  GstBuffer *section_buffer;
   GstBuffer *packet_buffer = NULL;
-  GstMemory *mem;
+  GstMapInfo map;
   guint8 *packet;
   guint8 *data;
   gsize data_size = 0;
   gsize payload_written;
   guint len = 0, offset = 0, payload_len = 0;
-  guint extra_alloc_bytes = 0;
 
   g_return_val_if_fail (section != NULL, FALSE);
   g_return_val_if_fail (mux != NULL, FALSE);
@@ -1035,17 +1033,19 @@ tsmux_section_write_packet (gpointer unused_arg,
   section->pi.stream_avail = data_size;
   payload_written = 0;
 
-  /* Wrap section data in a buffer without free function.
-     The data will be freed when the GstMpegtsSection is destroyed. */
-  section_buffer = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
-      data, data_size, 0, data_size, NULL, NULL);
-
-  TS_DEBUG ("Section buffer with size %" G_GSIZE_FORMAT " created",
-      gst_buffer_get_size (section_buffer));
-
   while (section->pi.stream_avail > 0) {
 
-    packet = g_malloc (TSMUX_PACKET_LENGTH);
+    /* Sections are written into packets obtained like the PES ones, so
+     * that they end up in the same output chunks */
+    if (!tsmux_get_buffer (mux, &packet_buffer))
+      return FALSE;
+
+    if (!gst_buffer_map (packet_buffer, &map, GST_MAP_WRITE)) {
+      TS_DEBUG ("Could not map packet buffer");
+      gst_buffer_unref (packet_buffer);
+      return FALSE;
+    }
+    packet = map.data;
 
     if (section->pi.packet_start_unit_indicator) {
       /* Wee need room for a pointer byte */
@@ -1066,41 +1066,11 @@ tsmux_section_write_packet (gpointer unused_arg,
       payload_len = len;
     }
 
-    /* Wrap the TS header and adaption field in a GstMemory */
-    mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
-        packet, TSMUX_PACKET_LENGTH, 0, offset, packet, g_free);
-
     TS_DEBUG ("Creating packet buffer at offset "
         "%" G_GSIZE_FORMAT " with length %u", payload_written, payload_len);
 
-    /* If in M2TS mode, we will need to resize to 4 bytes after the end
-       of the buffer. For performance reasons, we will now try to include
-       4 extra bytes from the source buffer, then resize down, to avoid
-       having an extra 4 byte GstMemory appended. If the source buffer
-       does not have enough data for this, a new GstMemory will be used */
-    if (gst_buffer_get_size (section_buffer) - (payload_written +
-            payload_len) >= 4) {
-      /* enough space */
-      extra_alloc_bytes = 4;
-    }
-    packet_buffer = gst_buffer_copy_region (section_buffer, GST_BUFFER_COPY_ALL,
-        payload_written, payload_len + extra_alloc_bytes);
-
-    /* Prepend the header to the section data */
-    gst_buffer_prepend_memory (packet_buffer, mem);
-
-    /* add an extra 4 bytes if it could not be reserved already */
-    if (extra_alloc_bytes == 4) {
-      /* we allocated those already, resize */
-      gst_buffer_set_size (packet_buffer,
-          gst_buffer_get_size (packet_buffer) - extra_alloc_bytes);
-    } else {
-      void *ptr = g_malloc (4);
-      GstMemory *extra =
-          gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, ptr, 4, 0, 0, ptr,
-          g_free);
-      gst_buffer_append_memory (packet_buffer, extra);
-    }
+    memcpy (packet + offset, data + payload_written, payload_len);
+    gst_buffer_unmap (packet_buffer, &map);
 
     TS_DEBUG ("Writing %d bytes to section. %d bytes remaining",
         len, section->pi.stream_avail - len);
@@ -1108,8 +1078,7 @@ tsmux_section_write_packet (gpointer unused_arg,
     /* Push the packet without PCR */
     if (G_UNLIKELY (!tsmux_packet_out (mux, packet_buffer, -1))) {
       /* Buffer given away */
-      packet_buffer = NULL;
-      goto fail;
+      return FALSE;
     }
 
     packet_buffer = NULL;
@@ -1118,14 +1087,11 @@ tsmux_section_write_packet (gpointer unused_arg,
     section->pi.packet_start_unit_indicator = FALSE;
   }
 
-  gst_buffer_unref (section_buffer);
-
   return TRUE;
 
 fail:
-  g_free (packet);
-  if (section_buffer)
-    gst_buffer_unref (section_buffer);
+  gst_buffer_unmap (packet_buffer, &map);
+  gst_buffer_unref (packet_buffer);
   return FALSE;
 }
 
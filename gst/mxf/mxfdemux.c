@@ -34,7 +34,7 @@
  *   - Handle timecode tracks correctly (where is this documented?)
  *   - Handle drop-frame field of timecode tracks
  *   - Handle Generic container system items
- *   - Implement correct support for clip-wrapped essence elements.
+ *   - Support clip-wrapped essence elements in push mode.
  *   - Post structural metadata and descriptive metadata trees as a message on the bus
  *     and send them downstream as event.
  *   - Multichannel audio needs channel layouts, define them (SMPTE S320M?).
@@ -54,6 +54,7 @@
 #include "mxfdemux.h"
 #include "mxfessence.h"
 
+#include <glib/gstdio.h>
 #include <string.h>
 
 static GstStaticPadTemplate mxf_sink_template = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -71,6 +72,12 @@ GST_STATIC_PAD_TEMPLATE ("track_%u",
 GST_DEBUG_CATEGORY_STATIC (mxfdemux_debug);
 #define GST_CAT_DEFAULT mxfdemux_debug
 
+static GstFlowReturn
+gst_mxf_demux_peek_klv_packet (GstMXFDemux * demux, guint64 offset,
+    MXFUL * key, guint * data_offset, guint64 * length);
+static GstFlowReturn
+gst_mxf_demux_pull_klv_value (GstMXFDemux * demux, guint64 offset,
+    guint64 length, GstBuffer ** outbuf);
 static GstFlowReturn
 gst_mxf_demux_pull_klv_packet (GstMXFDemux * demux, guint64 offset, MXFUL * key,
     GstBuffer ** outbuf, guint * read);
@@ -116,7 +123,9 @@ enum
   PROP_0,
   PROP_PACKAGE,
   PROP_MAX_DRIFT,
-  PROP_STRUCTURE
+  PROP_STRUCTURE,
+  PROP_INDEX_CACHE_DIRECTORY,
+  PROP_INDEX_CACHE_REMOTE
 };
 
 static gboolean gst_mxf_demux_sink_event (GstPad * pad, GstObject * parent,
@@ -294,6 +303,14 @@ gst_mxf_demux_reset (GstMXFDemux * demux)
 
   demux->index_table_segments_collected = FALSE;
 
+  if (demux->index_cache) {
+    mxf_index_cache_free (demux->index_cache);
+    demux->index_cache = NULL;
+  }
+  g_free (demux->index_cache_filename);
+  demux->index_cache_filename = NULL;
+  demux->index_cache_n_entries = 0;
+
   gst_mxf_demux_reset_mxf_state (demux);
   gst_mxf_demux_reset_metadata (demux);
 
@@ -661,6 +678,47 @@ done:
   return ret;
 }
 
+/* Fills the gaps in the essence track's index with the offsets from the
+ * index cache */
+static void
+gst_mxf_demux_apply_index_cache (GstMXFDemux * demux,
+    GstMXFDemuxEssenceTrack * etrack)
+{
+  const MXFIndexCacheTrack *ctrack;
+  guint i;
+
+  if (!demux->index_cache)
+    return;
+
+  ctrack =
+      mxf_index_cache_find_track (demux->index_cache,
+      &etrack->source_package_uid, etrack->track_id, etrack->body_sid,
+      etrack->track_number);
+  if (!ctrack)
+    return;
+
+  GST_DEBUG_OBJECT (demux, "Using %u cached index entries for track %u",
+      ctrack->offsets->len, etrack->track_id);
+
+  if (!etrack->offsets)
+    etrack->offsets = g_array_new (FALSE, TRUE, sizeof (GstMXFDemuxIndex));
+  if (etrack->offsets->len < ctrack->offsets->len)
+    g_array_set_size (etrack->offsets, ctrack->offsets->len);
+
+  for (i = 0; i < ctrack->offsets->len; i++) {
+    const GstMXFDemuxIndex *src =
+        &g_array_index (ctrack->offsets, GstMXFDemuxIndex, i);
+    GstMXFDemuxIndex *dest =
+        &g_array_index (etrack->offsets, GstMXFDemuxIndex, i);
+
+    if (src->initialized && !dest->initialized)
+      *dest = *src;
+  }
+
+  if (etrack->duration <= 0 && ctrack->duration > 0)
+    etrack->duration = ctrack->duration;
+}
+
 static GstFlowReturn
 gst_mxf_demux_update_essence_tracks (GstMXFDemux * demux)
 {
@@ -859,19 +917,24 @@ gst_mxf_demux_update_essence_tracks (GstMXFDemux * demux)
         MXFEssenceWrapping track_wrapping;
 
         track_wrapping = etrack->handler->get_track_wrapping (track);
-        if (track_wrapping == MXF_ESSENCE_WRAPPING_CLIP_WRAPPING) {
+        if (track_wrapping == MXF_ESSENCE_WRAPPING_CLIP_WRAPPING
+            && !demux->random_access) {
           GST_ELEMENT_ERROR (demux, STREAM, NOT_IMPLEMENTED, (NULL),
-              ("Clip essence wrapping is not implemented yet."));
+              ("Clip essence wrapping is only supported in pull mode."));
           return GST_FLOW_ERROR;
         } else if (track_wrapping == MXF_ESSENCE_WRAPPING_CUSTOM_WRAPPING) {
           GST_ELEMENT_ERROR (demux, STREAM, NOT_IMPLEMENTED, (NULL),
               ("Custom essence wrappings are not supported."));
           return GST_FLOW_ERROR;
         }
+        etrack->wrapping = track_wrapping;
       }
 
       etrack->source_package = package;
       etrack->source_track = track;
+
+      if (new)
+        gst_mxf_demux_apply_index_cache (demux, etrack);
       continue;
 
     next:
@@ -1683,12 +1746,37 @@ gst_mxf_demux_pad_set_component (GstMXFDemux * demux, GstMXFDemuxPad * pad,
   return ret;
 }
 
+static GstMXFDemuxEssenceTrack *
+gst_mxf_demux_find_essence_track_for_key (GstMXFDemux * demux,
+    const MXFUL * key)
+{
+  guint32 track_number;
+  guint i;
+
+  if (!demux->current_partition)
+    return NULL;
+
+  track_number = GST_READ_UINT32_BE (&key->u[12]);
+
+  for (i = 0; i < demux->essence_tracks->len; i++) {
+    GstMXFDemuxEssenceTrack *etrack =
+        &g_array_index (demux->essence_tracks, GstMXFDemuxEssenceTrack, i);
+
+    if (etrack->body_sid == demux->current_partition->partition.body_sid &&
+        (etrack->track_number == track_number || etrack->track_number == 0))
+      return etrack;
+  }
+
+  return NULL;
+}
+
+/* buffer contains n_edit_units consecutive edit units of the essence track,
+ * which is always 1 except for chunks of clip-wrapped sound essence */
 static GstFlowReturn
 gst_mxf_demux_handle_generic_container_essence_element (GstMXFDemux * demux,
-    const MXFUL * key, GstBuffer * buffer, gboolean peek)
+    const MXFUL * key, GstBuffer * buffer, guint n_edit_units, gboolean peek)
 {
   GstFlowReturn ret = GST_FLOW_OK;
-  guint32 track_number;
   guint i;
   GstBuffer *inbuf = NULL;
   GstBuffer *outbuf = NULL;
@@ -1727,19 +1815,7 @@ gst_mxf_demux_handle_generic_container_essence_element (GstMXFDemux * demux,
     return GST_FLOW_ERROR;
   }
 
-  track_number = GST_READ_UINT32_BE (&key->u[12]);
-
-  for (i = 0; i < demux->essence_tracks->len; i++) {
-    GstMXFDemuxEssenceTrack *tmp =
-        &g_array_index (demux->essence_tracks, GstMXFDemuxEssenceTrack, i);
-
-    if (tmp->body_sid == demux->current_partition->partition.body_sid &&
-        (tmp->track_number == track_number || tmp->track_number == 0)) {
-      etrack = tmp;
-      break;
-    }
-  }
-
+  etrack = gst_mxf_demux_find_essence_track_for_key (demux, key);
   if (!etrack) {
     GST_WARNING_OBJECT (demux,
         "No essence track for this essence element found");
@@ -1933,7 +2009,7 @@ gst_mxf_demux_handle_generic_container_essence_element (GstMXFDemux * demux,
     }
 
     GST_BUFFER_DURATION (outbuf) =
-        gst_util_uint64_scale (GST_SECOND,
+        gst_util_uint64_scale (n_edit_units * GST_SECOND,
         pad->current_essence_track->source_track->edit_rate.d,
         pad->current_essence_track->source_track->edit_rate.n);
     GST_BUFFER_OFFSET (outbuf) = GST_BUFFER_OFFSET_NONE;
@@ -1967,7 +2043,8 @@ gst_mxf_demux_handle_generic_container_essence_element (GstMXFDemux * demux,
     /* Update accumulated error and compensate */
     {
       guint64 abs_error =
-          (GST_SECOND * pad->current_essence_track->source_track->edit_rate.d) %
+          (n_edit_units * GST_SECOND *
+          pad->current_essence_track->source_track->edit_rate.d) %
           pad->current_essence_track->source_track->edit_rate.n;
       pad->position_accumulated_error +=
           ((gdouble) abs_error) /
@@ -1997,7 +2074,7 @@ gst_mxf_demux_handle_generic_container_essence_element (GstMXFDemux * demux,
     }
 
     pad->position += GST_BUFFER_DURATION (outbuf);
-    pad->current_material_track_position++;
+    pad->current_material_track_position += n_edit_units;
 
     GST_DEBUG_OBJECT (demux,
         "Pushing buffer of size %" G_GSIZE_FORMAT " for track %u: pts %"
@@ -2025,7 +2102,7 @@ gst_mxf_demux_handle_generic_container_essence_element (GstMXFDemux * demux,
     if (ret != GST_FLOW_OK)
       goto out;
 
-    pad->current_essence_track_position++;
+    pad->current_essence_track_position += n_edit_units;
 
     if (pad->current_component) {
       if (pad->current_component_duration > 0 &&
@@ -2073,7 +2150,193 @@ out:
   if (outbuf)
     gst_buffer_unref (outbuf);
 
-  etrack->position++;
+  etrack->position += n_edit_units;
+
+  return ret;
+}
+
+/* Maximum size of the chunks clip-wrapped sound essence is read in */
+#define MXF_CLIP_CHUNK_SIZE (64 * 1024)
+
+static GstMXFDemuxIndexTable *
+gst_mxf_demux_find_index_table (GstMXFDemux * demux,
+    GstMXFDemuxEssenceTrack * etrack)
+{
+  GList *l;
+
+  for (l = demux->index_tables; l; l = l->next) {
+    GstMXFDemuxIndexTable *t = l->data;
+
+    if (t->body_sid == etrack->body_sid && t->index_sid == etrack->index_sid)
+      return t;
+  }
+
+  return NULL;
+}
+
+/* Gets offset and size of an edit unit of clip-wrapped essence, relative to
+ * the start of the value of the essence element at clip_offset (without
+ * run-in). The stream offsets of clip-wrapped essence don't include the key
+ * and length of the essence element, so while the index table offsets were
+ * calculated relative to the essence element itself they are relative to
+ * its value here */
+static gboolean
+gst_mxf_demux_get_clip_edit_unit (GstMXFDemux * demux,
+    GstMXFDemuxIndexTable * index_table, guint64 clip_offset,
+    guint64 clip_size, gint64 position, guint64 * offset, guint64 * size)
+{
+  GstMXFDemuxIndex *idx, *next;
+
+  if (position < 0)
+    return FALSE;
+
+  if (index_table->edit_unit_byte_count) {
+    guint64 stream_offset = position * index_table->edit_unit_byte_count;
+    guint64 body_offset = demux->current_partition->partition.body_offset;
+
+    if (stream_offset < body_offset)
+      return FALSE;
+
+    *offset = stream_offset - body_offset;
+    *size = index_table->edit_unit_byte_count;
+
+    return *offset + *size <= clip_size;
+  }
+
+  if (position >= index_table->offsets->len)
+    return FALSE;
+
+  idx = &g_array_index (index_table->offsets, GstMXFDemuxIndex, position);
+  if (!idx->initialized || idx->offset < clip_offset
+      || idx->offset - clip_offset >= clip_size)
+    return FALSE;
+
+  *offset = idx->offset - clip_offset;
+
+  /* The last edit unit goes until the end of the essence element */
+  *size = clip_size - *offset;
+  if (position + 1 < index_table->offsets->len) {
+    next =
+        &g_array_index (index_table->offsets, GstMXFDemuxIndex, position + 1);
+    if (next->initialized && next->offset > idx->offset
+        && next->offset - clip_offset <= clip_size)
+      *size = next->offset - idx->offset;
+  }
+
+  return TRUE;
+}
+
+/* Clip-wrapped essence is stored in a single, possibly multiple GB large,
+ * essence element. Instead of pulling it completely the edit units are read
+ * one after another from the essence element's value, sound essence in
+ * chunks of multiple edit units. demux->offset stays at the essence element
+ * until done is set */
+static GstFlowReturn
+gst_mxf_demux_handle_clip_wrapped_essence_element (GstMXFDemux * demux,
+    const MXFUL * key, GstMXFDemuxEssenceTrack * etrack, guint data_offset,
+    guint64 length, gboolean * done)
+{
+  GstMXFDemuxIndexTable *index_table;
+  GstBuffer *buffer = NULL;
+  guint64 clip_offset = demux->offset - demux->run_in;
+  guint64 offset, size, next_offset, next_size;
+  gint64 position = -1;
+  guint n_edit_units = 1;
+  GstFlowReturn ret;
+  guint i;
+
+  *done = FALSE;
+
+  if (demux->current_partition->essence_container_offset == 0)
+    demux->current_partition->essence_container_offset =
+        clip_offset - demux->current_partition->partition.this_partition;
+
+  if (!demux->index_table_segments_collected) {
+    collect_index_table_segments (demux);
+    demux->index_table_segments_collected = TRUE;
+  }
+
+  index_table = gst_mxf_demux_find_index_table (demux, etrack);
+  if (!index_table) {
+    GST_ELEMENT_ERROR (demux, STREAM, DEMUX, (NULL),
+        ("No index table for clip-wrapped essence track %u",
+            etrack->track_id));
+    return GST_FLOW_ERROR;
+  }
+
+  /* Continue with the earliest edit unit any pad is waiting for */
+  for (i = 0; i < demux->src->len; i++) {
+    GstMXFDemuxPad *pad = g_ptr_array_index (demux->src, i);
+
+    if (pad->current_essence_track != etrack || pad->eos)
+      continue;
+
+    if (position == -1 || pad->current_essence_track_position < position)
+      position = pad->current_essence_track_position;
+  }
+
+  if (!gst_mxf_demux_get_clip_edit_unit (demux, index_table, clip_offset,
+          length, position, &offset, &size)) {
+    GST_DEBUG_OBJECT (demux,
+        "No edit units needed from essence element at offset %"
+        G_GUINT64_FORMAT, demux->offset);
+    *done = TRUE;
+    return GST_FLOW_OK;
+  }
+
+  if (index_table->edit_unit_byte_count
+      && etrack->source_track->parent.type ==
+      MXF_METADATA_TRACK_SOUND_ESSENCE) {
+    gint64 max_edit_units = MXF_CLIP_CHUNK_SIZE / size;
+
+    max_edit_units = MIN (max_edit_units, (length - offset) / size);
+    if (etrack->duration > 0)
+      max_edit_units = MIN (max_edit_units, etrack->duration - position);
+
+    /* Don't read beyond the end of the current components */
+    for (i = 0; i < demux->src->len; i++) {
+      GstMXFDemuxPad *pad = g_ptr_array_index (demux->src, i);
+
+      if (pad->current_essence_track != etrack || pad->eos
+          || pad->current_essence_track_position != position
+          || !pad->current_component || pad->current_component_duration <= 0)
+        continue;
+
+      max_edit_units = MIN (max_edit_units,
+          pad->current_component_start + pad->current_component_duration -
+          position);
+    }
+
+    n_edit_units = MAX (max_edit_units, 1);
+    size *= n_edit_units;
+  }
+
+  if (size > G_MAXUINT) {
+    GST_ERROR_OBJECT (demux,
+        "Unsupported edit unit size: %" G_GUINT64_FORMAT, size);
+    return GST_FLOW_ERROR;
+  }
+
+  GST_DEBUG_OBJECT (demux,
+      "Reading %u edit units from %" G_GINT64_FORMAT " of track %u at offset %"
+      G_GUINT64_FORMAT " of the clip-wrapped essence element", n_edit_units,
+      position, etrack->track_number, offset);
+
+  ret =
+      gst_mxf_demux_pull_range (demux, demux->offset + data_offset + offset,
+      size, &buffer);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  etrack->position = position;
+  ret =
+      gst_mxf_demux_handle_generic_container_essence_element (demux, key,
+      buffer, n_edit_units, FALSE);
+  gst_buffer_unref (buffer);
+
+  if (!gst_mxf_demux_get_clip_edit_unit (demux, index_table, clip_offset,
+          length, position + n_edit_units, &next_offset, &next_size))
+    *done = TRUE;
 
   return ret;
 }
@@ -2083,7 +2346,8 @@ read_partition_header (GstMXFDemux * demux)
 {
   GstBuffer *buf;
   MXFUL key;
-  guint read;
+  guint read, data_offset;
+  guint64 length;
 
   if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf, &read)
       != GST_FLOW_OK)
@@ -2101,32 +2365,31 @@ read_partition_header (GstMXFDemux * demux)
   demux->offset += read;
   gst_buffer_unref (buf);
 
-  if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf, &read)
-      != GST_FLOW_OK)
+  /* Only look at the headers of the following packets, the essence
+   * container might start right after them and could be huge */
+  if (gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key, &data_offset,
+          &length) != GST_FLOW_OK)
     return;
 
   while (mxf_is_fill (&key)) {
-    demux->offset += read;
-    gst_buffer_unref (buf);
-    if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf, &read)
-        != GST_FLOW_OK)
+    demux->offset += data_offset + length;
+    if (gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key,
+            &data_offset, &length) != GST_FLOW_OK)
       return;
   }
 
   if (!mxf_is_index_table_segment (&key)
       && demux->current_partition->partition.header_byte_count) {
-    gst_buffer_unref (buf);
     demux->offset += demux->current_partition->partition.header_byte_count;
-    if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf, &read)
-        != GST_FLOW_OK)
+    if (gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key,
+            &data_offset, &length) != GST_FLOW_OK)
       return;
   }
 
   while (mxf_is_fill (&key)) {
-    demux->offset += read;
-    gst_buffer_unref (buf);
-    if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf, &read)
-        != GST_FLOW_OK)
+    demux->offset += data_offset + length;
+    if (gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key,
+            &data_offset, &length) != GST_FLOW_OK)
       return;
   }
 
@@ -2137,24 +2400,26 @@ read_partition_header (GstMXFDemux * demux)
 
     while (demux->offset < index_end_offset) {
       if (mxf_is_index_table_segment (&key)) {
+        if (gst_mxf_demux_pull_klv_value (demux, demux->offset + data_offset,
+                length, &buf) != GST_FLOW_OK)
+          return;
+
         gst_mxf_demux_handle_index_table_segment (demux, &key, buf,
             demux->offset);
+        gst_buffer_unref (buf);
       }
-      demux->offset += read;
+      demux->offset += data_offset + length;
 
-      gst_buffer_unref (buf);
-      if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf,
-              &read)
-          != GST_FLOW_OK)
+      if (gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key,
+              &data_offset, &length) != GST_FLOW_OK)
         return;
     }
   }
 
   while (mxf_is_fill (&key)) {
-    demux->offset += read;
-    gst_buffer_unref (buf);
-    if (gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buf, &read)
-        != GST_FLOW_OK)
+    demux->offset += data_offset + length;
+    if (gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key,
+            &data_offset, &length) != GST_FLOW_OK)
       return;
   }
 
@@ -2166,8 +2431,6 @@ read_partition_header (GstMXFDemux * demux)
           demux->offset - demux->current_partition->partition.this_partition -
           demux->run_in;
   }
-
-  gst_buffer_unref (buf);
 }
 
 static GstFlowReturn
@@ -2273,14 +2536,14 @@ gst_mxf_demux_handle_index_table_segment (GstMXFDemux * demux,
   return GST_FLOW_OK;
 }
 
+/* Reads the key and length of the KLV packet at offset. data_offset is
+ * the size of the key and the BER encoded length */
 static GstFlowReturn
-gst_mxf_demux_pull_klv_packet (GstMXFDemux * demux, guint64 offset, MXFUL * key,
-    GstBuffer ** outbuf, guint * read)
+gst_mxf_demux_peek_klv_packet (GstMXFDemux * demux, guint64 offset,
+    MXFUL * key, guint * data_offset, guint64 * length)
 {
   GstBuffer *buffer = NULL;
   const guint8 *data;
-  guint64 data_offset = 0;
-  guint64 length;
   GstFlowReturn ret = GST_FLOW_OK;
   GstMapInfo map;
 #ifndef GST_DISABLE_GST_DEBUG
@@ -2303,12 +2566,12 @@ gst_mxf_demux_pull_klv_packet (GstMXFDemux * demux, guint64 offset, MXFUL * key,
 
   /* Decode BER encoded packet length */
   if ((map.data[16] & 0x80) == 0) {
-    length = map.data[16];
-    data_offset = 17;
+    *length = map.data[16];
+    *data_offset = 17;
   } else {
     guint slen = map.data[16] & 0x7f;
 
-    data_offset = 16 + 1 + slen;
+    *data_offset = 16 + 1 + slen;
 
     gst_buffer_unmap (buffer, &map);
     gst_buffer_unref (buffer);
@@ -2329,9 +2592,9 @@ gst_mxf_demux_pull_klv_packet (GstMXFDemux * demux, guint64 offset, MXFUL * key,
     gst_buffer_map (buffer, &map, GST_MAP_READ);
 
     data = map.data;
-    length = 0;
+    *length = 0;
     while (slen) {
-      length = (length << 8) | *data;
+      *length = (*length << 8) | *data;
       data++;
       slen--;
     }
@@ -2341,33 +2604,52 @@ gst_mxf_demux_pull_klv_packet (GstMXFDemux * demux, guint64 offset, MXFUL * key,
   gst_buffer_unref (buffer);
   buffer = NULL;
 
+  GST_DEBUG_OBJECT (demux, "KLV packet with key %s has length "
+      "%" G_GUINT64_FORMAT, mxf_ul_to_string (key, str), *length);
+
+beach:
+  if (buffer)
+    gst_buffer_unref (buffer);
+
+  return ret;
+}
+
+static GstFlowReturn
+gst_mxf_demux_pull_klv_value (GstMXFDemux * demux, guint64 offset,
+    guint64 length, GstBuffer ** outbuf)
+{
   /* GStreamer's buffer sizes are stored in a guint so we
    * limit ourself to G_MAXUINT large buffers */
   if (length > G_MAXUINT) {
     GST_ERROR_OBJECT (demux,
         "Unsupported KLV packet length: %" G_GUINT64_FORMAT, length);
-    ret = GST_FLOW_ERROR;
-    goto beach;
+    return GST_FLOW_ERROR;
   }
 
-  GST_DEBUG_OBJECT (demux, "KLV packet with key %s has length "
-      "%" G_GUINT64_FORMAT, mxf_ul_to_string (key, str), length);
+  return gst_mxf_demux_pull_range (demux, offset, length, outbuf);
+}
+
+static GstFlowReturn
+gst_mxf_demux_pull_klv_packet (GstMXFDemux * demux, guint64 offset, MXFUL * key,
+    GstBuffer ** outbuf, guint * read)
+{
+  guint data_offset;
+  guint64 length;
+  GstFlowReturn ret;
+
+  if ((ret = gst_mxf_demux_peek_klv_packet (demux, offset, key, &data_offset,
+              &length)) != GST_FLOW_OK)
+    return ret;
 
   /* Pull the complete KLV packet */
-  if ((ret = gst_mxf_demux_pull_range (demux, offset + data_offset, length,
-              &buffer)) != GST_FLOW_OK)
-    goto beach;
+  if ((ret = gst_mxf_demux_pull_klv_value (demux, offset + data_offset,
+              length, outbuf)) != GST_FLOW_OK)
+    return ret;
 
-  *outbuf = buffer;
-  buffer = NULL;
   if (read)
     *read = data_offset + length;
 
-beach:
-  if (buffer)
-    gst_buffer_unref (buffer);
-
-  return ret;
+  return GST_FLOW_OK;
 }
 
 static void
@@ -2610,13 +2892,11 @@ out:
   demux->current_partition = old_partition;
 }
 
+/* Resolves the metadata and updates the tracks once all header metadata
+ * was read, which is latest when the first essence element is reached */
 static GstFlowReturn
-gst_mxf_demux_handle_klv_packet (GstMXFDemux * demux, const MXFUL * key,
-    GstBuffer * buffer, gboolean peek)
+gst_mxf_demux_update_metadata_for_key (GstMXFDemux * demux, const MXFUL * key)
 {
-#ifndef GST_DISABLE_GST_DEBUG
-  gchar key_str[48];
-#endif
   GstFlowReturn ret = GST_FLOW_OK;
 
   if (demux->update_metadata
@@ -2628,16 +2908,27 @@ gst_mxf_demux_handle_klv_packet (GstMXFDemux * demux, const MXFUL * key,
           mxf_is_generic_container_essence_element (key) ||
           mxf_is_avid_essence_container_essence_element (key))) {
     demux->current_partition->parsed_metadata = TRUE;
-    if ((ret = gst_mxf_demux_resolve_references (demux)) != GST_FLOW_OK ||
-        (ret = gst_mxf_demux_update_tracks (demux)) != GST_FLOW_OK) {
-      goto beach;
-    }
+    if ((ret = gst_mxf_demux_resolve_references (demux)) == GST_FLOW_OK)
+      ret = gst_mxf_demux_update_tracks (demux);
   } else if (demux->metadata_resolved && demux->requested_package_string) {
-    if ((ret = gst_mxf_demux_update_tracks (demux)) != GST_FLOW_OK) {
-      goto beach;
-    }
+    ret = gst_mxf_demux_update_tracks (demux);
   }
 
+  return ret;
+}
+
+static GstFlowReturn
+gst_mxf_demux_handle_klv_packet (GstMXFDemux * demux, const MXFUL * key,
+    GstBuffer * buffer, gboolean peek)
+{
+#ifndef GST_DISABLE_GST_DEBUG
+  gchar key_str[48];
+#endif
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  if ((ret = gst_mxf_demux_update_metadata_for_key (demux, key)) != GST_FLOW_OK)
+    goto beach;
+
   if (!mxf_is_mxf_packet (key)) {
     GST_WARNING_OBJECT (demux,
         "Skipping non-MXF packet of size %" G_GSIZE_FORMAT " at offset %"
@@ -2677,7 +2968,7 @@ gst_mxf_demux_handle_klv_packet (GstMXFDemux * demux, const MXFUL * key,
       mxf_is_avid_essence_container_essence_element (key)) {
     ret =
         gst_mxf_demux_handle_generic_container_essence_element (demux, key,
-        buffer, peek);
+        buffer, 1, peek);
   } else if (mxf_is_random_index_pack (key)) {
     ret = gst_mxf_demux_handle_random_index_pack (demux, key, buffer);
 
@@ -2811,6 +3102,62 @@ find_closest_offset (GArray * offsets, gint64 * position, gboolean keyframe)
   return -1;
 }
 
+/* Clip-wrapped essence is always read starting at the essence element, the
+ * edit unit is then picked based on the essence track position. This
+ * returns the offset of the essence element containing the edit unit */
+static guint64
+gst_mxf_demux_find_clip_wrapped_essence_element (GstMXFDemux * demux,
+    GstMXFDemuxEssenceTrack * etrack, gint64 * position, gboolean keyframe)
+{
+  GstMXFDemuxIndexTable *index_table;
+  GstMXFDemuxPartition *partition = NULL;
+  gint64 current_position = *position;
+  GList *l;
+
+  if (demux->random_access && !demux->index_table_segments_collected) {
+    collect_index_table_segments (demux);
+    demux->index_table_segments_collected = TRUE;
+  }
+
+  index_table = gst_mxf_demux_find_index_table (demux, etrack);
+
+  if (index_table && index_table->edit_unit_byte_count) {
+    guint64 stream_offset =
+        current_position * index_table->edit_unit_byte_count;
+
+    for (l = demux->partitions; l; l = l->next) {
+      GstMXFDemuxPartition *p = l->data;
+
+      if (p->partition.body_sid == etrack->body_sid
+          && p->essence_container_offset != 0
+          && p->partition.body_offset <= stream_offset)
+        partition = p;
+    }
+  } else if (index_table) {
+    guint64 offset =
+        find_offset (index_table->offsets, &current_position, keyframe);
+
+    for (l = demux->partitions; offset != -1 && l; l = l->next) {
+      GstMXFDemuxPartition *p = l->data;
+
+      if (p->partition.body_sid == etrack->body_sid
+          && p->essence_container_offset != 0
+          && p->partition.this_partition <= offset)
+        partition = p;
+    }
+  }
+
+  if (partition) {
+    *position = current_position;
+    return partition->partition.this_partition +
+        partition->essence_container_offset;
+  }
+
+  /* Otherwise use the essence element we read edit units from before */
+  current_position = *position;
+  return find_closest_offset (etrack->offsets, &current_position, FALSE);
+}
+
 static guint64
 gst_mxf_demux_find_essence_element (GstMXFDemux * demux,
     GstMXFDemuxEssenceTrack * etrack, gint64 * position, gboolean keyframe)
@@ -2848,6 +3195,22 @@ from_index:
     return -1;
   }
 
+  if (etrack->wrapping == MXF_ESSENCE_WRAPPING_CLIP_WRAPPING) {
+    offset =
+        gst_mxf_demux_find_clip_wrapped_essence_element (demux, etrack,
+        position, keyframe);
+    if (offset != -1) {
+      GST_DEBUG_OBJECT (demux,
+          "Found edit unit %" G_GINT64_FORMAT " for %" G_GINT64_FORMAT
+          " in essence element at offset %" G_GUINT64_FORMAT, *position,
+          requested_position, offset);
+      return offset;
+    }
+
+    /* Index table offsets point into the essence elements */
+    index_table = NULL;
+  }
+
   /* First try to find an offset in our index */
   offset = find_offset (etrack->offsets, position, keyframe);
   if (offset != -1) {
@@ -2928,11 +3291,49 @@ from_index:
     while (ret == GST_FLOW_OK) {
       GstBuffer *buffer = NULL;
       MXFUL key;
-      guint read = 0;
+      guint data_offset = 0;
+      guint64 length = 0, read = 0;
 
       ret =
-          gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buffer,
-          &read);
+          gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key,
+          &data_offset, &length);
+
+      /* Don't read clip-wrapped essence elements, we can only stop at
+       * their beginning anyway */
+      if (ret == GST_FLOW_OK
+          && (mxf_is_generic_container_essence_element (&key)
+              || mxf_is_avid_essence_container_essence_element (&key))) {
+        GstMXFDemuxEssenceTrack *t =
+            gst_mxf_demux_find_essence_track_for_key (demux, &key);
+
+        if (t && t->wrapping == MXF_ESSENCE_WRAPPING_CLIP_WRAPPING) {
+          if (demux->current_partition->essence_container_offset == 0)
+            demux->current_partition->essence_container_offset =
+                demux->offset -
+                demux->current_partition->partition.this_partition -
+                demux->run_in;
+
+          if (t == etrack) {
+            offset = demux->offset - demux->run_in;
+            GST_DEBUG_OBJECT (demux,
+                "Found clip-wrapped essence element at offset %"
+                G_GUINT64_FORMAT, offset);
+            demux->offset = old_offset;
+            demux->current_partition = old_partition;
+            return offset;
+          }
+
+          demux->offset += data_offset + length;
+          continue;
+        }
+      }
+
+      if (ret == GST_FLOW_OK) {
+        ret =
+            gst_mxf_demux_pull_klv_value (demux, demux->offset + data_offset,
+            length, &buffer);
+        read = data_offset + length;
+      }
 
       if (ret == GST_FLOW_EOS) {
         for (i = 0; i < demux->essence_tracks->len; i++) {
@@ -3000,7 +3401,9 @@ gst_mxf_demux_pull_and_handle_klv_packet (GstMXFDemux * demux)
   GstBuffer *buffer = NULL;
   MXFUL key;
   GstFlowReturn ret = GST_FLOW_OK;
-  guint read = 0;
+  guint data_offset = 0;
+  guint64 length = 0;
+  GstMXFDemuxEssenceTrack *clip_etrack = NULL;
 
   if (demux->src->len > 0) {
     if (!gst_mxf_demux_get_earliest_pad (demux)) {
@@ -3011,8 +3414,8 @@ gst_mxf_demux_pull_and_handle_klv_packet (GstMXFDemux * demux)
   }
 
   ret =
-      gst_mxf_demux_pull_klv_packet (demux, demux->offset, &key, &buffer,
-      &read);
+      gst_mxf_demux_peek_klv_packet (demux, demux->offset, &key, &data_offset,
+      &length);
 
   if (ret == GST_FLOW_EOS && demux->src->len > 0) {
     guint i;
@@ -3074,8 +3477,38 @@ gst_mxf_demux_pull_and_handle_klv_packet (GstMXFDemux * demux)
   if (G_UNLIKELY (ret != GST_FLOW_OK))
     goto beach;
 
-  ret = gst_mxf_demux_handle_klv_packet (demux, &key, buffer, FALSE);
-  demux->offset += read;
+  /* The tracks need to be known to decide how to read essence elements */
+  if (mxf_is_generic_container_essence_element (&key) ||
+      mxf_is_avid_essence_container_essence_element (&key)) {
+    if ((ret =
+            gst_mxf_demux_update_metadata_for_key (demux,
+                &key)) != GST_FLOW_OK)
+      goto beach;
+
+    clip_etrack = gst_mxf_demux_find_essence_track_for_key (demux, &key);
+    if (clip_etrack
+        && clip_etrack->wrapping != MXF_ESSENCE_WRAPPING_CLIP_WRAPPING)
+      clip_etrack = NULL;
+  }
+
+  if (clip_etrack) {
+    gboolean done = FALSE;
+
+    ret =
+        gst_mxf_demux_handle_clip_wrapped_essence_element (demux, &key,
+        clip_etrack, data_offset, length, &done);
+    if (done)
+      demux->offset += data_offset + length;
+  } else {
+    ret =
+        gst_mxf_demux_pull_klv_value (demux, demux->offset + data_offset,
+        length, &buffer);
+    if (G_UNLIKELY (ret != GST_FLOW_OK))
+      goto beach;
+
+    ret = gst_mxf_demux_handle_klv_packet (demux, &key, buffer, FALSE);
+    demux->offset += data_offset + length;
+  }
 
   if (ret == GST_FLOW_OK && demux->src->len > 0
       && demux->essence_tracks->len > 0) {
@@ -3127,6 +3560,118 @@ beach:
   return ret;
 }
 
+/* Files are identified by their URI, size and modification time. For
+ * non-local files only the size is known, so a changed file of the same size
+ * can't be detected and those are only cached if explicitly allowed */
+static void
+gst_mxf_demux_load_index_cache (GstMXFDemux * demux)
+{
+  GstQuery *query;
+  gchar *uri = NULL, *filename;
+  guint64 file_size = 0;
+  gint64 mtime = 0;
+
+  if (!demux->index_cache_directory)
+    return;
+
+  query = gst_query_new_uri ();
+  if (gst_pad_peer_query (demux->sinkpad, query))
+    gst_query_parse_uri (query, &uri);
+  gst_query_unref (query);
+
+  if (!uri) {
+    GST_DEBUG_OBJECT (demux, "Upstream has no URI, not using the index cache");
+    return;
+  }
+
+  filename = g_filename_from_uri (uri, NULL, NULL);
+  if (filename) {
+    GStatBuf st;
+
+    if (g_stat (filename, &st) == 0) {
+      file_size = st.st_size;
+      mtime = st.st_mtime;
+    }
+    g_free (filename);
+  } else if (!demux->index_cache_remote) {
+    GST_DEBUG_OBJECT (demux, "Not using the index cache for non-local URI %s",
+        uri);
+    g_free (uri);
+    return;
+  }
+
+  if (file_size == 0) {
+    gint64 duration;
+
+    if (gst_pad_peer_query_duration (demux->sinkpad, GST_FORMAT_BYTES,
+            &duration) && duration > 0)
+      file_size = duration;
+  }
+
+  if (file_size == 0) {
+    GST_DEBUG_OBJECT (demux, "Unknown file size, not using the index cache");
+    g_free (uri);
+    return;
+  }
+
+  demux->index_cache_filename =
+      mxf_index_cache_get_filename (demux->index_cache_directory, uri);
+  g_free (uri);
+
+  demux->index_cache =
+      mxf_index_cache_load (demux->index_cache_filename, file_size, mtime);
+  if (!demux->index_cache)
+    demux->index_cache = mxf_index_cache_new (file_size, mtime);
+  demux->index_cache_n_entries =
+      mxf_index_cache_get_n_entries (demux->index_cache);
+
+  GST_DEBUG_OBJECT (demux, "Using index cache %s with %u entries",
+      demux->index_cache_filename, demux->index_cache_n_entries);
+}
+
+static void
+gst_mxf_demux_save_index_cache (GstMXFDemux * demux)
+{
+  MXFIndexCache *cache;
+  GError *err = NULL;
+  guint i, n_entries;
+
+  if (!demux->index_cache)
+    return;
+
+  cache =
+      mxf_index_cache_new (demux->index_cache->file_size,
+      demux->index_cache->mtime);
+
+  for (i = 0; i < demux->essence_tracks->len; i++) {
+    GstMXFDemuxEssenceTrack *etrack =
+        &g_array_index (demux->essence_tracks, GstMXFDemuxEssenceTrack, i);
+
+    if (!etrack->offsets)
+      continue;
+
+    mxf_index_cache_add_track (cache, &etrack->source_package_uid,
+        etrack->track_id, etrack->body_sid, etrack->track_number,
+        etrack->duration, etrack->offsets);
+  }
+
+  /* Only write the cache if the index grew */
+  n_entries = mxf_index_cache_get_n_entries (cache);
+  if (n_entries > demux->index_cache_n_entries) {
+    if (mxf_index_cache_save (cache, demux->index_cache_filename, &err)) {
+      GST_DEBUG_OBJECT (demux, "Wrote index cache %s with %u entries",
+          demux->index_cache_filename, n_entries);
+      demux->index_cache_n_entries = n_entries;
+    } else {
+      GST_WARNING_OBJECT (demux, "Failed to write index cache %s: %s",
+          demux->index_cache_filename, err->message);
+      g_clear_error (&err);
+    }
+  }
+
+  mxf_index_cache_free (cache);
+}
+
 static void
 gst_mxf_demux_loop (GstPad * pad)
 {
@@ -3174,6 +3719,8 @@ gst_mxf_demux_loop (GstPad * pad)
       goto pause;
     }
 
+    gst_mxf_demux_load_index_cache (demux);
+
     /* First of all pull&parse the random index pack at EOF */
     gst_mxf_demux_pull_random_index_pack (demux);
   }
@@ -3716,6 +4263,10 @@ collect_index_table_segments (GstMXFDemux * demux)
       demux->index_tables = g_list_prepend (demux->index_tables, t);
     }
 
+    /* CBR segments carry no index entries, remember the edit unit size */
+    if (segment->edit_unit_byte_count)
+      t->edit_unit_byte_count = segment->edit_unit_byte_count;
+
     start = segment->index_start_position;
     end = start + segment->index_duration;
     if (end > G_MAXINT / sizeof (GstMXFDemuxIndex)) {
@@ -4528,6 +5079,7 @@ gst_mxf_demux_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_mxf_demux_save_index_cache (demux);
       gst_mxf_demux_reset (demux);
       break;
     default:
@@ -4551,6 +5103,13 @@ gst_mxf_demux_set_property (GObject * object, guint prop_id,
     case PROP_MAX_DRIFT:
       demux->max_drift = g_value_get_uint64 (value);
       break;
+    case PROP_INDEX_CACHE_DIRECTORY:
+      g_free (demux->index_cache_directory);
+      demux->index_cache_directory = g_value_dup_string (value);
+      break;
+    case PROP_INDEX_CACHE_REMOTE:
+      demux->index_cache_remote = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -4589,6 +5148,12 @@ gst_mxf_demux_get_property (GObject * object, guint prop_id,
       g_rw_lock_reader_unlock (&demux->metadata_lock);
       break;
     }
+    case PROP_INDEX_CACHE_DIRECTORY:
+      g_value_set_string (value, demux->index_cache_directory);
+      break;
+    case PROP_INDEX_CACHE_REMOTE:
+      g_value_set_boolean (value, demux->index_cache_remote);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -4621,6 +5186,8 @@ gst_mxf_demux_finalize (GObject * object)
   demux->current_package_string = NULL;
   g_free (demux->requested_package_string);
   demux->requested_package_string = NULL;
+  g_free (demux->index_cache_directory);
+  demux->index_cache_directory = NULL;
 
   g_ptr_array_free (demux->src, TRUE);
   demux->src = NULL;
@@ -4664,6 +5231,40 @@ gst_mxf_demux_class_init (GstMXFDemuxClass * klass)
           "Structural metadata of the MXF file",
           GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstMXFDemux:index-cache-directory:
+   *
+   * Directory in which the index generated while reading a file is cached.
+   * When the same file is opened again in pull mode, the cached index is
+   * used for seeking instead of scanning the file. Caches are only written
+   * when the element is stopped, so they can be prepared in advance by
+   * running the files through the demuxer once.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_INDEX_CACHE_DIRECTORY,
+      g_param_spec_string ("index-cache-directory", "Index cache directory",
+          "Directory for caching the generated index of files (NULL = disabled)",
+          NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  /**
+   * GstMXFDemux:index-cache-remote:
+   *
+   * Whether the index cache is also used for non-local URIs. Their
+   * modification time is unknown, so a cached index would be used for a
+   * changed file as long as its size stays the same.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_INDEX_CACHE_REMOTE,
+      g_param_spec_boolean ("index-cache-remote", "Index cache remote",
+          "Also cache the index of non-local URIs, which are only identified "
+          "by their size", FALSE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_mxf_demux_change_state);
   gstelement_class->query = GST_DEBUG_FUNCPTR (gst_mxf_demux_query);
@@ -26,6 +26,7 @@
 #include <gst/video/video.h>
 
 #include "mxfessence.h"
+#include "mxfindexcache.h"
 
 G_BEGIN_DECLS
 
@@ -82,6 +83,8 @@ typedef struct
 
   GstCaps *caps;
   gboolean intra_only;
+
+  MXFEssenceWrapping wrapping;
 } GstMXFDemuxEssenceTrack;
 
 typedef struct
@@ -106,6 +109,9 @@ typedef struct
 
   /* offsets indexed by DTS */
   GArray *offsets;
+
+  /* Size of every edit unit for CBR index tables, 0 otherwise */
+  guint32 edit_unit_byte_count;
 } GstMXFDemuxIndexTable;
 
 struct _GstMXFDemuxPad
@@ -205,9 +211,16 @@ struct _GstMXFDemux
 
   GstTagList *tags;
 
+  /* Index cache, pull mode only */
+  gchar *index_cache_filename;
+  MXFIndexCache *index_cache;
+  guint index_cache_n_entries;
+
   /* Properties */
   gchar *requested_package_string;
   GstClockTime max_drift;
+  gchar *index_cache_directory;
+  gboolean index_cache_remote;
 };
 
 struct _GstMXFDemuxClass
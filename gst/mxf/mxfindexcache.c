@@ -0,0 +1,496 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* On-disk cache of the index mxfdemux generates while reading a file, so
+ * that seeking in a file that was read before doesn't require scanning it
+ * again.
+ *
+ * All integers are big endian, like in MXF:
+ *
+ *   "GSTMXFIC"                  magic
+ *   guint32                     version
+ *   guint64                     file size
+ *   gint64                      file modification time
+ *   guint32                     number of tracks
+ *
+ * followed by each track:
+ *
+ *   MXFUMID                     source package UID
+ *   guint32                     track id
+ *   guint32                     body SID
+ *   guint32                     track number
+ *   gint64                      duration
+ *   guint32                     number of edit units
+ *   guint32                     number of entries
+ *
+ * and its entries, one per known edit unit:
+ *
+ *   varint                      edit units since the previous entry
+ *   varint                      zigzag encoded difference to the
+ *                               previous entry's offset
+ *   guint8                      flags: keyframe, has PTS, has DTS
+ *   varint                      PTS, if present
+ *   varint                      DTS, if present
+ *
+ * varints are 7 bits per byte, least significant group first, with the
+ * high bit set on all but the last byte.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/base/gstbytereader.h>
+#include <gst/base/gstbytewriter.h>
+#include <glib/gstdio.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mxfindexcache.h"
+#include "mxfdemux.h"
+
+GST_DEBUG_CATEGORY_EXTERN (mxf_debug);
+#define GST_CAT_DEFAULT mxf_debug
+
+#define MXF_INDEX_CACHE_MAGIC "GSTMXFIC"
+#define MXF_INDEX_CACHE_VERSION 1
+
+#define MXF_INDEX_CACHE_FLAG_KEYFRAME (1 << 0)
+#define MXF_INDEX_CACHE_FLAG_PTS (1 << 1)
+#define MXF_INDEX_CACHE_FLAG_DTS (1 << 2)
+
+/* Every indexed edit unit is an essence element of the file, so at least a
+ * 16 byte key and a 1 byte length */
+#define MXF_INDEX_CACHE_MIN_ELEMENT_SIZE (16 + 1)
+
+gchar *
+mxf_index_cache_get_filename (const gchar * directory, const gchar * uri)
+{
+  gchar *checksum, *basename, *filename;
+
+  g_return_val_if_fail (directory != NULL, NULL);
+  g_return_val_if_fail (uri != NULL, NULL);
+
+  checksum = g_compute_checksum_for_string (G_CHECKSUM_SHA1, uri, -1);
+  basename = g_strconcat (checksum, ".mxfindex", NULL);
+  filename = g_build_filename (directory, basename, NULL);
+  g_free (basename);
+  g_free (checksum);
+
+  return filename;
+}
+
+static void
+mxf_index_cache_track_clear (MXFIndexCacheTrack * track)
+{
+  if (track->offsets)
+    g_array_free (track->offsets, TRUE);
+  track->offsets = NULL;
+}
+
+MXFIndexCache *
+mxf_index_cache_new (guint64 file_size, gint64 mtime)
+{
+  MXFIndexCache *cache = g_new0 (MXFIndexCache, 1);
+
+  cache->file_size = file_size;
+  cache->mtime = mtime;
+  cache->tracks = g_array_new (FALSE, TRUE, sizeof (MXFIndexCacheTrack));
+  g_array_set_clear_func (cache->tracks,
+      (GDestroyNotify) mxf_index_cache_track_clear);
+
+  return cache;
+}
+
+void
+mxf_index_cache_free (MXFIndexCache * cache)
+{
+  g_return_if_fail (cache != NULL);
+
+  g_array_free (cache->tracks, TRUE);
+  g_free (cache);
+}
+
+static MXFIndexCacheTrack *
+mxf_index_cache_append_track (MXFIndexCache * cache,
+    const MXFUMID * source_package_uid, guint32 track_id, guint32 body_sid,
+    guint32 track_number, gint64 duration, guint n_offsets)
+{
+  MXFIndexCacheTrack *track;
+
+  g_array_set_size (cache->tracks, cache->tracks->len + 1);
+  track =
+      &g_array_index (cache->tracks, MXFIndexCacheTrack,
+      cache->tracks->len - 1);
+
+  memcpy (&track->source_package_uid, source_package_uid, sizeof (MXFUMID));
+  track->track_id = track_id;
+  track->body_sid = body_sid;
+  track->track_number = track_number;
+  track->duration = duration;
+  track->offsets =
+      g_array_sized_new (FALSE, TRUE, sizeof (GstMXFDemuxIndex), n_offsets);
+  g_array_set_size (track->offsets, n_offsets);
+
+  return track;
+}
+
+void
+mxf_index_cache_add_track (MXFIndexCache * cache,
+    const MXFUMID * source_package_uid, guint32 track_id, guint32 body_sid,
+    guint32 track_number, gint64 duration, const GArray * offsets)
+{
+  MXFIndexCacheTrack *track;
+
+  g_return_if_fail (cache != NULL);
+  g_return_if_fail (source_package_uid != NULL);
+  g_return_if_fail (offsets != NULL);
+
+  track =
+      mxf_index_cache_append_track (cache, source_package_uid, track_id,
+      body_sid, track_number, duration, offsets->len);
+  if (offsets->len > 0)
+    memcpy (track->offsets->data, offsets->data,
+        offsets->len * sizeof (GstMXFDemuxIndex));
+}
+
+const MXFIndexCacheTrack *
+mxf_index_cache_find_track (const MXFIndexCache * cache,
+    const MXFUMID * source_package_uid, guint32 track_id, guint32 body_sid,
+    guint32 track_number)
+{
+  guint i;
+
+  g_return_val_if_fail (cache != NULL, NULL);
+  g_return_val_if_fail (source_package_uid != NULL, NULL);
+
+  for (i = 0; i < cache->tracks->len; i++) {
+    const MXFIndexCacheTrack *track =
+        &g_array_index (cache->tracks, MXFIndexCacheTrack, i);
+
+    if (track->track_id == track_id && track->body_sid == body_sid
+        && track->track_number == track_number
+        && mxf_umid_is_equal (&track->source_package_uid, source_package_uid))
+      return track;
+  }
+
+  return NULL;
+}
+
+static gboolean
+mxf_index_cache_entry_is_valid (const GstMXFDemuxIndex * index)
+{
+  return index->initialized && index->offset != 0;
+}
+
+guint
+mxf_index_cache_get_n_entries (const MXFIndexCache * cache)
+{
+  guint i, j, n = 0;
+
+  g_return_val_if_fail (cache != NULL, 0);
+
+  for (i = 0; i < cache->tracks->len; i++) {
+    const MXFIndexCacheTrack *track =
+        &g_array_index (cache->tracks, MXFIndexCacheTrack, i);
+
+    for (j = 0; j < track->offsets->len; j++) {
+      if (mxf_index_cache_entry_is_valid (&g_array_index (track->offsets,
+                  GstMXFDemuxIndex, j)))
+        n++;
+    }
+  }
+
+  return n;
+}
+
+static gboolean
+read_varint (GstByteReader * reader, guint64 * value)
+{
+  guint shift = 0;
+  guint8 b;
+
+  *value = 0;
+  do {
+    if (shift > 63 || !gst_byte_reader_get_uint8 (reader, &b))
+      return FALSE;
+    *value |= ((guint64) (b & 0x7f)) << shift;
+    shift += 7;
+  } while (b & 0x80);
+
+  return TRUE;
+}
+
+static gboolean
+write_varint (GstByteWriter * writer, guint64 value)
+{
+  while (value >= 0x80) {
+    if (!gst_byte_writer_put_uint8 (writer, (value & 0x7f) | 0x80))
+      return FALSE;
+    value >>= 7;
+  }
+
+  return gst_byte_writer_put_uint8 (writer, value);
+}
+
+static gboolean
+mxf_index_cache_read_track (MXFIndexCache * cache, GstByteReader * reader)
+{
+  MXFIndexCacheTrack *track;
+  const guint8 *umid;
+  guint32 track_id, body_sid, track_number, n_offsets, n_entries, i;
+  gint64 duration;
+  guint64 position = 0, offset = 0;
+
+  if (!gst_byte_reader_get_data (reader, sizeof (MXFUMID), &umid) ||
+      !gst_byte_reader_get_uint32_be (reader, &track_id) ||
+      !gst_byte_reader_get_uint32_be (reader, &body_sid) ||
+      !gst_byte_reader_get_uint32_be (reader, &track_number) ||
+      !gst_byte_reader_get_int64_be (reader, &duration) ||
+      !gst_byte_reader_get_uint32_be (reader, &n_offsets) ||
+      !gst_byte_reader_get_uint32_be (reader, &n_entries))
+    return FALSE;
+
+  /* Every entry needs at least 3 bytes */
+  if (n_entries > n_offsets
+      || n_offsets > cache->file_size / MXF_INDEX_CACHE_MIN_ELEMENT_SIZE
+      || n_offsets > G_MAXINT / sizeof (GstMXFDemuxIndex)
+      || n_entries > gst_byte_reader_get_remaining (reader) / 3)
+    return FALSE;
+
+  /* Only allocated up to the entries that are actually there, the edit
+   * units after the last one are unknown anyway */
+  track =
+      mxf_index_cache_append_track (cache, (const MXFUMID *) umid, track_id,
+      body_sid, track_number, duration, 0);
+
+  for (i = 0; i < n_entries; i++) {
+    GstMXFDemuxIndex *index;
+    guint64 skip, offset_diff, pts = G_MAXUINT64, dts = G_MAXUINT64;
+    guint8 flags;
+
+    if (!read_varint (reader, &skip) || !read_varint (reader, &offset_diff) ||
+        !gst_byte_reader_get_uint8 (reader, &flags))
+      return FALSE;
+
+    if ((flags & MXF_INDEX_CACHE_FLAG_PTS) && !read_varint (reader, &pts))
+      return FALSE;
+    if ((flags & MXF_INDEX_CACHE_FLAG_DTS) && !read_varint (reader, &dts))
+      return FALSE;
+
+    position += skip;
+    if (skip >= n_offsets || position >= n_offsets)
+      return FALSE;
+
+    /* zigzag decoding, a negative offset wraps around and is rejected
+     * together with the ones past the end of the file */
+    offset += (offset_diff >> 1) ^ -(offset_diff & 1);
+    if (offset == 0 || offset >= cache->file_size)
+      return FALSE;
+
+    g_array_set_size (track->offsets, position + 1);
+    index = &g_array_index (track->offsets, GstMXFDemuxIndex, position);
+    index->offset = offset;
+    index->pts = pts;
+    index->dts = dts;
+    index->keyframe = ! !(flags & MXF_INDEX_CACHE_FLAG_KEYFRAME);
+    index->initialized = TRUE;
+
+    position++;
+  }
+
+  return TRUE;
+}
+
+MXFIndexCache *
+mxf_index_cache_load (const gchar * filename, guint64 file_size, gint64 mtime)
+{
+  MXFIndexCache *cache = NULL;
+  GstByteReader reader;
+  gchar *contents = NULL;
+  gsize length = 0;
+  const guint8 *magic;
+  guint32 version, n_tracks, i;
+  guint64 cached_file_size;
+  gint64 cached_mtime;
+  GError *err = NULL;
+
+  g_return_val_if_fail (filename != NULL, NULL);
+
+  if (!g_file_get_contents (filename, &contents, &length, &err)) {
+    GST_DEBUG ("No index cache %s: %s", filename, err->message);
+    g_clear_error (&err);
+    return NULL;
+  }
+
+  gst_byte_reader_init (&reader, (const guint8 *) contents, length);
+
+  if (!gst_byte_reader_get_data (&reader, 8, &magic) ||
+      memcmp (magic, MXF_INDEX_CACHE_MAGIC, 8) != 0 ||
+      !gst_byte_reader_get_uint32_be (&reader, &version) ||
+      version != MXF_INDEX_CACHE_VERSION) {
+    GST_WARNING ("Index cache %s has an unsupported format", filename);
+    goto done;
+  }
+
+  if (!gst_byte_reader_get_uint64_be (&reader, &cached_file_size) ||
+      !gst_byte_reader_get_int64_be (&reader, &cached_mtime) ||
+      !gst_byte_reader_get_uint32_be (&reader, &n_tracks))
+    goto invalid;
+
+  if (cached_file_size != file_size || cached_mtime != mtime) {
+    GST_DEBUG ("Index cache %s is outdated", filename);
+    goto done;
+  }
+
+  cache = mxf_index_cache_new (file_size, mtime);
+  for (i = 0; i < n_tracks; i++) {
+    if (!mxf_index_cache_read_track (cache, &reader))
+      goto invalid;
+  }
+
+  GST_DEBUG ("Loaded index cache %s with %u tracks", filename, n_tracks);
+
+done:
+  g_free (contents);
+
+  return cache;
+
+invalid:
+  GST_WARNING ("Index cache %s is invalid", filename);
+  if (cache)
+    mxf_index_cache_free (cache);
+  cache = NULL;
+  goto done;
+}
+
+static gboolean
+mxf_index_cache_write_track (const MXFIndexCacheTrack * track,
+    GstByteWriter * writer)
+{
+  gboolean ret = TRUE;
+  guint64 next_position = 0, prev_offset = 0;
+  guint32 n_entries = 0;
+  guint i;
+
+  for (i = 0; i < track->offsets->len; i++) {
+    if (mxf_index_cache_entry_is_valid (&g_array_index (track->offsets,
+                GstMXFDemuxIndex, i)))
+      n_entries++;
+  }
+
+  ret &= gst_byte_writer_put_data (writer,
+      (const guint8 *) &track->source_package_uid, sizeof (MXFUMID));
+  ret &= gst_byte_writer_put_uint32_be (writer, track->track_id);
+  ret &= gst_byte_writer_put_uint32_be (writer, track->body_sid);
+  ret &= gst_byte_writer_put_uint32_be (writer, track->track_number);
+  ret &= gst_byte_writer_put_int64_be (writer, track->duration);
+  ret &= gst_byte_writer_put_uint32_be (writer, track->offsets->len);
+  ret &= gst_byte_writer_put_uint32_be (writer, n_entries);
+
+  for (i = 0; i < track->offsets->len && ret; i++) {
+    const GstMXFDemuxIndex *index =
+        &g_array_index (track->offsets, GstMXFDemuxIndex, i);
+    gint64 offset_diff;
+    guint8 flags = 0;
+
+    if (!mxf_index_cache_entry_is_valid (index))
+      continue;
+
+    if (index->keyframe)
+      flags |= MXF_INDEX_CACHE_FLAG_KEYFRAME;
+    if (index->pts != G_MAXUINT64)
+      flags |= MXF_INDEX_CACHE_FLAG_PTS;
+    if (index->dts != G_MAXUINT64)
+      flags |= MXF_INDEX_CACHE_FLAG_DTS;
+
+    offset_diff = index->offset - prev_offset;
+
+    ret &= write_varint (writer, i - next_position);
+    /* zigzag encoding */
+    ret &= write_varint (writer, ((guint64) offset_diff << 1) ^
+        (guint64) (offset_diff >> 63));
+    ret &= gst_byte_writer_put_uint8 (writer, flags);
+    if (flags & MXF_INDEX_CACHE_FLAG_PTS)
+      ret &= write_varint (writer, index->pts);
+    if (flags & MXF_INDEX_CACHE_FLAG_DTS)
+      ret &= write_varint (writer, index->dts);
+
+    next_position = i + 1;
+    prev_offset = index->offset;
+  }
+
+  return ret;
+}
+
+gboolean
+mxf_index_cache_save (const MXFIndexCache * cache, const gchar * filename,
+    GError ** error)
+{
+  GstByteWriter writer;
+  gboolean ret = TRUE;
+  gchar *dirname;
+  guint8 *data;
+  guint size, i;
+
+  g_return_val_if_fail (cache != NULL, FALSE);
+  g_return_val_if_fail (filename != NULL, FALSE);
+
+  gst_byte_writer_init (&writer);
+
+  ret &= gst_byte_writer_put_data (&writer,
+      (const guint8 *) MXF_INDEX_CACHE_MAGIC, 8);
+  ret &= gst_byte_writer_put_uint32_be (&writer, MXF_INDEX_CACHE_VERSION);
+  ret &= gst_byte_writer_put_uint64_be (&writer, cache->file_size);
+  ret &= gst_byte_writer_put_int64_be (&writer, cache->mtime);
+  ret &= gst_byte_writer_put_uint32_be (&writer, cache->tracks->len);
+
+  for (i = 0; i < cache->tracks->len && ret; i++)
+    ret &= mxf_index_cache_write_track (&g_array_index (cache->tracks,
+            MXFIndexCacheTrack, i), &writer);
+
+  size = gst_byte_writer_get_size (&writer);
+  data = gst_byte_writer_reset_and_get_data (&writer);
+
+  if (!ret) {
+    g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_NOMEM,
+        "Failed to serialize the index");
+    g_free (data);
+    return FALSE;
+  }
+
+  dirname = g_path_get_dirname (filename);
+  if (g_mkdir_with_parents (dirname, 0755) != 0) {
+    gint errsv = errno;
+
+    g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errsv),
+        "Failed to create directory %s: %s", dirname, g_strerror (errsv));
+    g_free (dirname);
+    g_free (data);
+    return FALSE;
+  }
+  g_free (dirname);
+
+  /* Written to a temporary file first and renamed, so other demuxers never
+   * see partially written caches */
+  ret = g_file_set_contents (filename, (const gchar *) data, size, error);
+  g_free (data);
+
+  return ret;
+}
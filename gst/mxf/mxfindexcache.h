@@ -0,0 +1,59 @@
+/* GStreamer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __MXF_INDEX_CACHE_H__
+#define __MXF_INDEX_CACHE_H__
+
+#include <gst/gst.h>
+
+#include "mxftypes.h"
+
+typedef struct {
+  MXFUMID source_package_uid;
+  guint32 track_id;
+  guint32 body_sid;
+  guint32 track_number;
+  gint64 duration;
+
+  /* GstMXFDemuxIndex, indexed by edit unit */
+  GArray *offsets;
+} MXFIndexCacheTrack;
+
+/* Index of the essence element offsets of a file, as generated by the
+ * demuxer. Files are identified by their size and modification time, the
+ * tracks by their source package and track ids */
+typedef struct {
+  guint64 file_size;
+  gint64 mtime;
+
+  GArray *tracks;
+} MXFIndexCache;
+
+gchar * mxf_index_cache_get_filename (const gchar * directory, const gchar * uri);
+
+MXFIndexCache * mxf_index_cache_new (guint64 file_size, gint64 mtime);
+void mxf_index_cache_free (MXFIndexCache * cache);
+
+void mxf_index_cache_add_track (MXFIndexCache * cache, const MXFUMID * source_package_uid, guint32 track_id, guint32 body_sid, guint32 track_number, gint64 duration, const GArray * offsets);
+const MXFIndexCacheTrack * mxf_index_cache_find_track (const MXFIndexCache * cache, const MXFUMID * source_package_uid, guint32 track_id, guint32 body_sid, guint32 track_number);
+guint mxf_index_cache_get_n_entries (const MXFIndexCache * cache);
+
+MXFIndexCache * mxf_index_cache_load (const gchar * filename, guint64 file_size, gint64 mtime);
+gboolean mxf_index_cache_save (const MXFIndexCache * cache, const gchar * filename, GError ** error);
+
+#endif /* __MXF_INDEX_CACHE_H__ */
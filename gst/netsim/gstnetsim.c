@@ -66,6 +66,11 @@ enum
   PROP_MAX_KBPS,
   PROP_MAX_BUCKET_SIZE,
   PROP_ALLOW_REORDERING,
+  PROP_BURST_ENTER_PROBABILITY,
+  PROP_BURST_EXIT_PROBABILITY,
+  PROP_BURST_DROP_PROBABILITY,
+  PROP_REORDER_PROBABILITY,
+  PROP_REORDER_DISTANCE,
 };
 
 /* these numbers are nothing but wild guesses and dont reflect any reality */
@@ -79,6 +84,11 @@ enum
 #define DEFAULT_MAX_KBPS -1
 #define DEFAULT_MAX_BUCKET_SIZE -1
 #define DEFAULT_ALLOW_REORDERING TRUE
+#define DEFAULT_BURST_ENTER_PROBABILITY 0.0
+#define DEFAULT_BURST_EXIT_PROBABILITY 0.5
+#define DEFAULT_BURST_DROP_PROBABILITY 1.0
+#define DEFAULT_REORDER_PROBABILITY 0.0
+#define DEFAULT_REORDER_DISTANCE 1
 
 static GstStaticPadTemplate gst_net_sim_sink_template =
 GST_STATIC_PAD_TEMPLATE ("sink",
@@ -94,148 +104,168 @@ GST_STATIC_PAD_TEMPLATE ("src",
 
 G_DEFINE_TYPE (GstNetSim, gst_net_sim, GST_TYPE_ELEMENT);
 
-static gboolean
-gst_net_sim_source_dispatch (GSource * source,
-    GSourceFunc callback, gpointer user_data)
+typedef struct
 {
-  callback (user_data);
-  return FALSE;
-}
+  gint64 ready_time;
+  guint64 seqnum;
+  GstBuffer *buf;
+} NetSimPacket;
 
-GSourceFuncs gst_net_sim_source_funcs = {
-  NULL,                         /* prepare */
-  NULL,                         /* check */
-  gst_net_sim_source_dispatch,
-  NULL                          /* finalize */
-};
+typedef struct
+{
+  GstBuffer *buf;
+  guint remaining;
+} NetSimReorderedPacket;
+
+/* Delayed packets are kept in a binary min-heap ordered by release time, and
+ * in arrival order for equal release times. Must be called with the
+ * loop_mutex */
+static inline gboolean
+net_sim_packet_before (const NetSimPacket * a, const NetSimPacket * b)
+{
+  return a->ready_time < b->ready_time ||
+      (a->ready_time == b->ready_time && a->seqnum < b->seqnum);
+}
 
 static void
-gst_net_sim_loop (GstNetSim * netsim)
+gst_net_sim_delayed_push (GstNetSim * netsim, gint64 ready_time,
+    GstBuffer * buf)
 {
-  GMainLoop *loop;
+  NetSimPacket *heap;
+  NetSimPacket packet;
+  guint i;
 
-  GST_TRACE_OBJECT (netsim, "TASK: begin");
+  packet.ready_time = ready_time;
+  packet.seqnum = netsim->delayed_seqnum++;
+  packet.buf = buf;
 
-  g_mutex_lock (&netsim->loop_mutex);
-  loop = g_main_loop_ref (netsim->main_loop);
-  netsim->running = TRUE;
-  GST_TRACE_OBJECT (netsim, "TASK: signal start");
-  g_cond_signal (&netsim->start_cond);
-  g_mutex_unlock (&netsim->loop_mutex);
+  g_array_set_size (netsim->delayed, netsim->delayed->len + 1);
+  heap = (NetSimPacket *) netsim->delayed->data;
 
-  GST_TRACE_OBJECT (netsim, "TASK: run");
-  g_main_loop_run (loop);
-  g_main_loop_unref (loop);
+  for (i = netsim->delayed->len - 1; i > 0; i = (i - 1) / 2) {
+    if (!net_sim_packet_before (&packet, &heap[(i - 1) / 2]))
+      break;
+    heap[i] = heap[(i - 1) / 2];
+  }
+  heap[i] = packet;
+}
 
-  g_mutex_lock (&netsim->loop_mutex);
-  GST_TRACE_OBJECT (netsim, "TASK: pause");
-  gst_pad_pause_task (netsim->srcpad);
-  netsim->running = FALSE;
-  GST_TRACE_OBJECT (netsim, "TASK: signal end");
-  g_cond_signal (&netsim->start_cond);
-  g_mutex_unlock (&netsim->loop_mutex);
-  GST_TRACE_OBJECT (netsim, "TASK: end");
+static GstBuffer *
+gst_net_sim_delayed_pop (GstNetSim * netsim)
+{
+  NetSimPacket *heap = (NetSimPacket *) netsim->delayed->data;
+  GstBuffer *buf = heap[0].buf;
+  NetSimPacket last;
+  guint len, i, child;
+
+  len = netsim->delayed->len - 1;
+  last = heap[len];
+
+  for (i = 0; (child = 2 * i + 1) < len; i = child) {
+    if (child + 1 < len && net_sim_packet_before (&heap[child + 1],
+            &heap[child]))
+      child++;
+    if (!net_sim_packet_before (&heap[child], &last))
+      break;
+    heap[i] = heap[child];
+  }
+  heap[i] = last;
+
+  g_array_set_size (netsim->delayed, len);
+
+  return buf;
 }
 
-static gboolean
-_main_loop_quit_and_remove_source (gpointer user_data)
+static void
+gst_net_sim_delayed_clear (GstNetSim * netsim)
 {
-  GMainLoop *main_loop = user_data;
-  GST_DEBUG ("MAINLOOP: Quit %p", main_loop);
-  g_main_loop_quit (main_loop);
-  g_assert (!g_main_loop_is_running (main_loop));
-  return FALSE;                 /* Remove source */
+  guint i;
+
+  for (i = 0; i < netsim->delayed->len; i++)
+    gst_buffer_unref (g_array_index (netsim->delayed, NetSimPacket, i).buf);
+  g_array_set_size (netsim->delayed, 0);
 }
 
-static gboolean
-gst_net_sim_src_activatemode (GstPad * pad, GstObject * parent,
-    GstPadMode mode, gboolean active)
+/* Waits until the first delayed packets are due and pushes all of them at
+ * once, so a single wakeup handles any number of packets per tick */
+static void
+gst_net_sim_loop (GstNetSim * netsim)
 {
-  GstNetSim *netsim = GST_NET_SIM (parent);
-  gboolean result = FALSE;
+  GstBufferList *list;
+  GstFlowReturn ret;
+  gint64 now;
 
   g_mutex_lock (&netsim->loop_mutex);
-  if (active) {
-    if (netsim->main_loop == NULL) {
-      GMainContext *main_context = g_main_context_new ();
-      netsim->main_loop = g_main_loop_new (main_context, FALSE);
-      g_main_context_unref (main_context);
-
-      GST_TRACE_OBJECT (netsim, "ACT: Starting task on srcpad");
-      result = gst_pad_start_task (netsim->srcpad,
-          (GstTaskFunction) gst_net_sim_loop, netsim, NULL);
-
-      GST_TRACE_OBJECT (netsim, "ACT: Wait for task to start");
-      g_assert (!netsim->running);
-      while (!netsim->running)
-        g_cond_wait (&netsim->start_cond, &netsim->loop_mutex);
-      GST_TRACE_OBJECT (netsim, "ACT: Task on srcpad started");
-    }
-  } else {
-    if (netsim->main_loop != NULL) {
-      GSource *source;
-      guint id;
-
-      /* Adds an Idle Source which quits the main loop from within.
-       * This removes the possibility for run/quit race conditions. */
-      GST_TRACE_OBJECT (netsim, "DEACT: Stopping main loop on deactivate");
-      source = g_idle_source_new ();
-      g_source_set_callback (source, _main_loop_quit_and_remove_source,
-          g_main_loop_ref (netsim->main_loop),
-          (GDestroyNotify) g_main_loop_unref);
-      id = g_source_attach (source,
-          g_main_loop_get_context (netsim->main_loop));
-      g_source_unref (source);
-      g_assert_cmpuint (id, >, 0);
-      g_main_loop_unref (netsim->main_loop);
-      netsim->main_loop = NULL;
-
-      GST_TRACE_OBJECT (netsim, "DEACT: Wait for mainloop and task to pause");
-      g_assert (netsim->running);
-      while (netsim->running)
-        g_cond_wait (&netsim->start_cond, &netsim->loop_mutex);
-
-      GST_TRACE_OBJECT (netsim, "DEACT: Stopping task on srcpad");
-      result = gst_pad_stop_task (netsim->srcpad);
-      GST_TRACE_OBJECT (netsim, "DEACT: Mainloop and GstTask stopped");
+  while (netsim->running) {
+    if (netsim->delayed->len == 0) {
+      g_cond_wait (&netsim->loop_cond, &netsim->loop_mutex);
+      continue;
     }
+
+    now = g_get_monotonic_time ();
+    if (g_array_index (netsim->delayed, NetSimPacket, 0).ready_time <= now)
+      break;
+
+    g_cond_wait_until (&netsim->loop_cond, &netsim->loop_mutex,
+        g_array_index (netsim->delayed, NetSimPacket, 0).ready_time);
+  }
+
+  if (!netsim->running) {
+    GST_TRACE_OBJECT (netsim, "TASK: pause");
+    gst_pad_pause_task (netsim->srcpad);
+    g_mutex_unlock (&netsim->loop_mutex);
+    return;
   }
+
+  list = gst_buffer_list_new ();
+  while (netsim->delayed->len > 0 &&
+      g_array_index (netsim->delayed, NetSimPacket, 0).ready_time <= now)
+    gst_buffer_list_add (list, gst_net_sim_delayed_pop (netsim));
   g_mutex_unlock (&netsim->loop_mutex);
 
-  return result;
+  GST_DEBUG_OBJECT (netsim, "Pushing %u delayed buffers now",
+      gst_buffer_list_length (list));
+  ret = gst_pad_push_list (netsim->srcpad, list);
+  if (ret != GST_FLOW_OK)
+    GST_DEBUG_OBJECT (netsim, "Push returned %s", gst_flow_get_name (ret));
 }
 
-typedef struct
+static gboolean
+gst_net_sim_src_activatemode (GstPad * pad, GstObject * parent,
+    GstPadMode mode, gboolean active)
 {
-  GstPad *pad;
-  GstBuffer *buf;
-} PushBufferCtx;
+  GstNetSim *netsim = GST_NET_SIM (parent);
+  gboolean result;
 
-static inline PushBufferCtx *
-push_buffer_ctx_new (GstPad * pad, GstBuffer * buf)
-{
-  PushBufferCtx *ctx = g_slice_new (PushBufferCtx);
-  ctx->pad = gst_object_ref (pad);
-  ctx->buf = gst_buffer_ref (buf);
-  return ctx;
-}
+  if (active) {
+    g_mutex_lock (&netsim->loop_mutex);
+    netsim->running = TRUE;
+    g_mutex_unlock (&netsim->loop_mutex);
 
-static inline void
-push_buffer_ctx_free (PushBufferCtx * ctx)
-{
-  if (G_LIKELY (ctx != NULL)) {
-    gst_buffer_unref (ctx->buf);
-    gst_object_unref (ctx->pad);
-    g_slice_free (PushBufferCtx, ctx);
+    GST_TRACE_OBJECT (netsim, "ACT: Starting task on srcpad");
+    result = gst_pad_start_task (netsim->srcpad,
+        (GstTaskFunction) gst_net_sim_loop, netsim, NULL);
+  } else {
+    NetSimReorderedPacket *packet;
+
+    g_mutex_lock (&netsim->loop_mutex);
+    netsim->running = FALSE;
+    g_cond_signal (&netsim->loop_cond);
+    g_mutex_unlock (&netsim->loop_mutex);
+
+    GST_TRACE_OBJECT (netsim, "DEACT: Stopping task on srcpad");
+    result = gst_pad_stop_task (netsim->srcpad);
+
+    g_mutex_lock (&netsim->loop_mutex);
+    gst_net_sim_delayed_clear (netsim);
+    while ((packet = g_queue_pop_head (&netsim->reordered))) {
+      gst_buffer_unref (packet->buf);
+      g_slice_free (NetSimReorderedPacket, packet);
+    }
+    g_mutex_unlock (&netsim->loop_mutex);
   }
-}
 
-static gboolean
-push_buffer_ctx_push (PushBufferCtx * ctx)
-{
-  GST_DEBUG_OBJECT (ctx->pad, "Pushing buffer now");
-  gst_pad_push (ctx->pad, gst_buffer_ref (ctx->buf));
-  return FALSE;
+  return result;
 }
 
 static gint
@@ -332,11 +362,9 @@ gst_net_sim_delay_buffer (GstNetSim * netsim, GstBuffer * buf)
   GstFlowReturn ret = GST_FLOW_OK;
 
   g_mutex_lock (&netsim->loop_mutex);
-  if (netsim->main_loop != NULL && netsim->delay_probability > 0 &&
+  if (netsim->running && netsim->delay_probability > 0 &&
       g_rand_double (netsim->rand_seed) < netsim->delay_probability) {
     gint delay;
-    PushBufferCtx *ctx;
-    GSource *source;
     gint64 ready_time, now_time;
 
     switch (netsim->delay_distribution) {
@@ -360,9 +388,6 @@ gst_net_sim_delay_buffer (GstNetSim * netsim, GstBuffer * buf)
     if (delay < 0)
       delay = 0;
 
-    ctx = push_buffer_ctx_new (netsim->srcpad, buf);
-
-    source = g_source_new (&gst_net_sim_source_funcs, sizeof (GSource));
     now_time = g_get_monotonic_time ();
     ready_time = now_time + delay * 1000;
     if (!netsim->allow_reordering && ready_time < netsim->last_ready_time)
@@ -372,15 +397,16 @@ gst_net_sim_delay_buffer (GstNetSim * netsim, GstBuffer * buf)
     GST_DEBUG_OBJECT (netsim, "Delaying packet by %" G_GINT64_FORMAT "ms",
         (ready_time - now_time) / 1000);
 
-    g_source_set_ready_time (source, ready_time);
-    g_source_set_callback (source, (GSourceFunc) push_buffer_ctx_push,
-        ctx, (GDestroyNotify) push_buffer_ctx_free);
-    g_source_attach (source, g_main_loop_get_context (netsim->main_loop));
-    g_source_unref (source);
+    gst_net_sim_delayed_push (netsim, ready_time, gst_buffer_ref (buf));
+
+    /* only wake up the pushing thread if it has to wait less now */
+    if (g_array_index (netsim->delayed, NetSimPacket, 0).buf == buf)
+      g_cond_signal (&netsim->loop_cond);
+    g_mutex_unlock (&netsim->loop_mutex);
   } else {
+    g_mutex_unlock (&netsim->loop_mutex);
     ret = gst_pad_push (netsim->srcpad, gst_buffer_ref (buf));
   }
-  g_mutex_unlock (&netsim->loop_mutex);
 
   return ret;
 }
@@ -468,6 +494,68 @@ gst_net_sim_token_bucket (GstNetSim * netsim, GstBuffer * buf)
   return TRUE;
 }
 
+/* Gilbert-Elliott model: packets are lost with drop-probability in the good
+ * state and with burst-drop-probability in the bad one */
+static gboolean
+gst_net_sim_drop (GstNetSim * netsim)
+{
+  gfloat drop_probability;
+
+  if (netsim->in_burst) {
+    if (g_rand_double (netsim->rand_seed) <
+        (gdouble) netsim->burst_exit_probability) {
+      GST_DEBUG_OBJECT (netsim, "Leaving loss burst");
+      netsim->in_burst = FALSE;
+    }
+  } else if (netsim->burst_enter_probability > 0 &&
+      g_rand_double (netsim->rand_seed) <
+      (gdouble) netsim->burst_enter_probability) {
+    GST_DEBUG_OBJECT (netsim, "Entering loss burst");
+    netsim->in_burst = TRUE;
+  }
+
+  drop_probability = netsim->in_burst ? netsim->burst_drop_probability :
+      netsim->drop_probability;
+
+  return drop_probability > 0 &&
+      g_rand_double (netsim->rand_seed) < (gdouble) drop_probability;
+}
+
+/* Sends the packets held back by the reordering once enough packets have
+ * overtaken them */
+static GstFlowReturn
+gst_net_sim_release_reordered (GstNetSim * netsim)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  GQueue due = G_QUEUE_INIT;
+  NetSimReorderedPacket *packet;
+  GList *l, *next;
+
+  g_mutex_lock (&netsim->loop_mutex);
+  for (l = netsim->reordered.head; l; l = next) {
+    packet = l->data;
+    next = l->next;
+    if (--packet->remaining == 0) {
+      g_queue_unlink (&netsim->reordered, l);
+      g_queue_push_tail_link (&due, l);
+    }
+  }
+  g_mutex_unlock (&netsim->loop_mutex);
+
+  while ((packet = g_queue_pop_head (&due))) {
+    GstFlowReturn packet_ret;
+
+    GST_DEBUG_OBJECT (netsim, "Sending reordered packet");
+    packet_ret = gst_net_sim_delay_buffer (netsim, packet->buf);
+    if (ret == GST_FLOW_OK)
+      ret = packet_ret;
+    gst_buffer_unref (packet->buf);
+    g_slice_free (NetSimReorderedPacket, packet);
+  }
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_net_sim_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -481,10 +569,23 @@ gst_net_sim_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     netsim->drop_packets--;
     GST_DEBUG_OBJECT (netsim, "Dropping packet (%d left)",
         netsim->drop_packets);
-  } else if (netsim->drop_probability > 0
-      && g_rand_double (netsim->rand_seed) <
-      (gdouble) netsim->drop_probability) {
+    goto done;
+  } else if (gst_net_sim_drop (netsim)) {
     GST_DEBUG_OBJECT (netsim, "Dropping packet");
+    goto done;
+  } else if (netsim->reorder_probability > 0 &&
+      g_rand_double (netsim->rand_seed) <
+      (gdouble) netsim->reorder_probability) {
+    NetSimReorderedPacket *packet = g_slice_new (NetSimReorderedPacket);
+
+    GST_DEBUG_OBJECT (netsim, "Holding back packet for %u packets",
+        netsim->reorder_distance);
+    packet->buf = gst_buffer_ref (buf);
+    packet->remaining = netsim->reorder_distance;
+    g_mutex_lock (&netsim->loop_mutex);
+    g_queue_push_tail (&netsim->reordered, packet);
+    g_mutex_unlock (&netsim->loop_mutex);
+    goto done;
   } else if (netsim->duplicate_probability > 0 &&
       g_rand_double (netsim->rand_seed) <
       (gdouble) netsim->duplicate_probability) {
@@ -495,11 +596,51 @@ gst_net_sim_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     ret = gst_net_sim_delay_buffer (netsim, buf);
   }
 
+  if (!g_queue_is_empty (&netsim->reordered)) {
+    GstFlowReturn reordered_ret = gst_net_sim_release_reordered (netsim);
+
+    if (ret == GST_FLOW_OK)
+      ret = reordered_ret;
+  }
+
 done:
   gst_buffer_unref (buf);
   return ret;
 }
 
+static gboolean
+gst_net_sim_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  GstNetSim *netsim = GST_NET_SIM (parent);
+  NetSimReorderedPacket *packet;
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_EOS:
+      /* nothing is going to overtake the held back packets anymore */
+      g_mutex_lock (&netsim->loop_mutex);
+      while ((packet = g_queue_pop_head (&netsim->reordered))) {
+        g_mutex_unlock (&netsim->loop_mutex);
+        gst_net_sim_delay_buffer (netsim, packet->buf);
+        gst_buffer_unref (packet->buf);
+        g_slice_free (NetSimReorderedPacket, packet);
+        g_mutex_lock (&netsim->loop_mutex);
+      }
+      g_mutex_unlock (&netsim->loop_mutex);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      g_mutex_lock (&netsim->loop_mutex);
+      while ((packet = g_queue_pop_head (&netsim->reordered))) {
+        gst_buffer_unref (packet->buf);
+        g_slice_free (NetSimReorderedPacket, packet);
+      }
+      g_mutex_unlock (&netsim->loop_mutex);
+      break;
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
 
 static void
 gst_net_sim_set_property (GObject * object,
@@ -540,6 +681,21 @@ gst_net_sim_set_property (GObject * object,
     case PROP_ALLOW_REORDERING:
       netsim->allow_reordering = g_value_get_boolean (value);
       break;
+    case PROP_BURST_ENTER_PROBABILITY:
+      netsim->burst_enter_probability = g_value_get_float (value);
+      break;
+    case PROP_BURST_EXIT_PROBABILITY:
+      netsim->burst_exit_probability = g_value_get_float (value);
+      break;
+    case PROP_BURST_DROP_PROBABILITY:
+      netsim->burst_drop_probability = g_value_get_float (value);
+      break;
+    case PROP_REORDER_PROBABILITY:
+      netsim->reorder_probability = g_value_get_float (value);
+      break;
+    case PROP_REORDER_DISTANCE:
+      netsim->reorder_distance = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -583,6 +739,21 @@ gst_net_sim_get_property (GObject * object,
     case PROP_ALLOW_REORDERING:
       g_value_set_boolean (value, netsim->allow_reordering);
       break;
+    case PROP_BURST_ENTER_PROBABILITY:
+      g_value_set_float (value, netsim->burst_enter_probability);
+      break;
+    case PROP_BURST_EXIT_PROBABILITY:
+      g_value_set_float (value, netsim->burst_exit_probability);
+      break;
+    case PROP_BURST_DROP_PROBABILITY:
+      g_value_set_float (value, netsim->burst_drop_probability);
+      break;
+    case PROP_REORDER_PROBABILITY:
+      g_value_set_float (value, netsim->reorder_probability);
+      break;
+    case PROP_REORDER_DISTANCE:
+      g_value_set_uint (value, netsim->reorder_distance);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -602,9 +773,10 @@ gst_net_sim_init (GstNetSim * netsim)
   gst_element_add_pad (GST_ELEMENT (netsim), netsim->sinkpad);
 
   g_mutex_init (&netsim->loop_mutex);
-  g_cond_init (&netsim->start_cond);
+  g_cond_init (&netsim->loop_cond);
+  netsim->delayed = g_array_new (FALSE, FALSE, sizeof (NetSimPacket));
+  g_queue_init (&netsim->reordered);
   netsim->rand_seed = g_rand_new ();
-  netsim->main_loop = NULL;
   netsim->prev_time = GST_CLOCK_TIME_NONE;
 
   GST_OBJECT_FLAG_SET (netsim->sinkpad,
@@ -612,6 +784,8 @@ gst_net_sim_init (GstNetSim * netsim)
 
   gst_pad_set_chain_function (netsim->sinkpad,
       GST_DEBUG_FUNCPTR (gst_net_sim_chain));
+  gst_pad_set_event_function (netsim->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_net_sim_sink_event));
   gst_pad_set_activatemode_function (netsim->srcpad,
       GST_DEBUG_FUNCPTR (gst_net_sim_src_activatemode));
 }
@@ -622,8 +796,9 @@ gst_net_sim_finalize (GObject * object)
   GstNetSim *netsim = GST_NET_SIM (object);
 
   g_rand_free (netsim->rand_seed);
+  g_array_unref (netsim->delayed);
   g_mutex_clear (&netsim->loop_mutex);
-  g_cond_clear (&netsim->start_cond);
+  g_cond_clear (&netsim->loop_cond);
 
   G_OBJECT_CLASS (gst_net_sim_parent_class)->finalize (object);
 }
@@ -633,7 +808,8 @@ gst_net_sim_dispose (GObject * object)
 {
   GstNetSim *netsim = GST_NET_SIM (object);
 
-  g_assert (netsim->main_loop == NULL);
+  g_assert (!netsim->running);
+  g_assert (netsim->delayed->len == 0);
 
   G_OBJECT_CLASS (gst_net_sim_parent_class)->dispose (object);
 }
@@ -755,6 +931,79 @@ gst_net_sim_class_init (GstNetSimClass * klass)
           DEFAULT_ALLOW_REORDERING,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstNetSim:burst-enter-probability:
+   *
+   * Probability per packet of entering a loss burst. Together with
+   * "burst-exit-probability", "burst-drop-probability" and
+   * "drop-probability" this forms a Gilbert-Elliott loss model: within a
+   * burst packets are dropped with "burst-drop-probability", outside of it
+   * with "drop-probability".
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_BURST_ENTER_PROBABILITY,
+      g_param_spec_float ("burst-enter-probability",
+          "Burst Enter Probability",
+          "The Probability of entering a loss burst with a buffer",
+          0.0, 1.0, DEFAULT_BURST_ENTER_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:burst-exit-probability:
+   *
+   * Probability per packet of leaving a loss burst, the mean burst length
+   * is its inverse.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_BURST_EXIT_PROBABILITY,
+      g_param_spec_float ("burst-exit-probability", "Burst Exit Probability",
+          "The Probability of leaving a loss burst with a buffer",
+          0.0, 1.0, DEFAULT_BURST_EXIT_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:burst-drop-probability:
+   *
+   * Probability of a buffer being dropped within a loss burst.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_BURST_DROP_PROBABILITY,
+      g_param_spec_float ("burst-drop-probability", "Burst Drop Probability",
+          "The Probability a buffer is dropped within a loss burst",
+          0.0, 1.0, DEFAULT_BURST_DROP_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:reorder-probability:
+   *
+   * Probability of a buffer being held back until "reorder-distance"
+   * following buffers have been sent. Unlike reordering caused by delays,
+   * this doesn't change the timing of the other buffers.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_REORDER_PROBABILITY,
+      g_param_spec_float ("reorder-probability", "Reorder Probability",
+          "The Probability a buffer is sent after the following ones",
+          0.0, 1.0, DEFAULT_REORDER_PROBABILITY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstNetSim:reorder-distance:
+   *
+   * Number of buffers overtaking a reordered buffer.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_REORDER_DISTANCE,
+      g_param_spec_uint ("reorder-distance", "Reorder Distance",
+          "Number of buffers sent before a reordered buffer",
+          1, G_MAXUINT, DEFAULT_REORDER_DISTANCE,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
   GST_DEBUG_CATEGORY_INIT (netsim_debug, "netsim", 0, "Network simulator");
 }
 
@@ -68,9 +68,12 @@ struct _GstNetSim
   GstPad *srcpad;
 
   GMutex loop_mutex;
-  GCond start_cond;
-  GMainLoop *main_loop;
+  GCond loop_cond;
   gboolean running;
+  GArray *delayed;              /* min-heap of packets by release time */
+  guint64 delayed_seqnum;
+  GQueue reordered;             /* packets held back by the reordering */
+  gboolean in_burst;
   GRand *rand_seed;
   gsize bucket_size;
   GstClockTime prev_time;
@@ -88,6 +91,11 @@ struct _GstNetSim
   gint max_kbps;
   gint max_bucket_size;
   gboolean allow_reordering;
+  gfloat burst_enter_probability;
+  gfloat burst_exit_probability;
+  gfloat burst_drop_probability;
+  gfloat reorder_probability;
+  guint reorder_distance;
 };
 
 struct _GstNetSimClass
@@ -30,6 +30,10 @@
  * This elements replies to custom events 'GstRTPRetransmissionRequest' and
  * when available sends in RIST form the lost packet. This element is intented
  * to be used by ristsink element.
+ *
+ * Besides the "seqnum" and "ssrc" fields, the request may carry a
+ * "num-seqnums" field to ask for a run of consecutive packets at once, they
+ * are then sent out together as a buffer list.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -130,21 +134,20 @@ typedef struct
   GstBuffer *buffer;
 } BufferQueueItem;
 
-static void
-buffer_queue_item_free (BufferQueueItem * item)
-{
-  gst_buffer_unref (item->buffer);
-  g_slice_free (BufferQueueItem, item);
-}
-
 typedef struct
 {
   guint32 rtx_ssrc;
   guint16 seqnum_base, next_seqnum;
   gint clock_rate;
 
-  /* history of rtp packets */
-  GSequence *queue;
+  /* history of rtp packets, a ring of history_size items indexed by
+   * seqnum & (history_size - 1). It covers num_seqnums seqnums starting at
+   * first_seqnum, whose item is always set. Items of seqnums that were never
+   * seen and all items outside of that range are empty. */
+  BufferQueueItem *history;
+  guint history_size;
+  guint16 first_seqnum;
+  guint num_seqnums;
 } SSRCRtxData;
 
 static SSRCRtxData *
@@ -154,18 +157,78 @@ ssrc_rtx_data_new (guint32 rtx_ssrc)
 
   data->rtx_ssrc = rtx_ssrc;
   data->next_seqnum = data->seqnum_base = g_random_int_range (0, G_MAXUINT16);
-  data->queue = g_sequence_new ((GDestroyNotify) buffer_queue_item_free);
 
   return data;
 }
 
+static void
+ssrc_rtx_data_clear_history (SSRCRtxData * data)
+{
+  guint i;
+
+  for (i = 0; i < data->history_size; i++)
+    gst_buffer_replace (&data->history[i].buffer, NULL);
+  data->num_seqnums = 0;
+}
+
 static void
 ssrc_rtx_data_free (SSRCRtxData * data)
 {
-  g_sequence_free (data->queue);
+  ssrc_rtx_data_clear_history (data);
+  g_free (data->history);
   g_slice_free (SSRCRtxData, data);
 }
 
+/* Seqnums wrap at 16 bits, only half of them can be told apart as newer or
+ * older. A bigger ring would also let a wrapped seqnum land on the item of
+ * first_seqnum. */
+static guint
+ssrc_rtx_data_history_size (guint max_size_packets)
+{
+  guint size = 1;
+
+  if (max_size_packets == 0)
+    return G_MAXINT16 + 1;
+
+  while (size < max_size_packets)
+    size <<= 1;
+
+  return size;
+}
+
+static inline BufferQueueItem *
+ssrc_rtx_data_get_item (SSRCRtxData * data, guint16 seqnum)
+{
+  return &data->history[seqnum & (data->history_size - 1)];
+}
+
+static BufferQueueItem *
+ssrc_rtx_data_lookup (SSRCRtxData * data, guint16 seqnum)
+{
+  BufferQueueItem *item;
+
+  if ((guint16) (seqnum - data->first_seqnum) >= data->num_seqnums)
+    return NULL;
+
+  item = ssrc_rtx_data_get_item (data, seqnum);
+
+  return item->buffer ? item : NULL;
+}
+
+/* Drops the oldest packet, and the seqnums missing right after it */
+static void
+ssrc_rtx_data_expire_first (SSRCRtxData * data)
+{
+  gst_buffer_replace (&ssrc_rtx_data_get_item (data, data->first_seqnum)->
+      buffer, NULL);
+
+  do {
+    data->first_seqnum++;
+    data->num_seqnums--;
+  } while (data->num_seqnums > 0 &&
+      ssrc_rtx_data_get_item (data, data->first_seqnum)->buffer == NULL);
+}
+
 static void
 gst_rist_rtx_send_class_init (GstRistRtxSendClass * klass)
 {
@@ -361,16 +424,6 @@ gst_rtp_rist_buffer_new (GstRistRtxSend * rtx, GstBuffer * buffer, guint32 ssrc)
   return buffer;
 }
 
-static gint
-buffer_queue_items_cmp (BufferQueueItem * a, BufferQueueItem * b,
-    gpointer user_data)
-{
-  /* gst_rtp_buffer_compare_seqnum returns the opposite of what we want,
-   * it returns negative when seqnum1 > seqnum2 and we want negative
-   * when b > a, i.e. a is smaller, so it comes first in the sequence */
-  return gst_rtp_buffer_compare_seqnum (b->seqnum, a->seqnum);
-}
-
 static gboolean
 gst_rist_rtx_send_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
 {
@@ -384,65 +437,80 @@ gst_rist_rtx_send_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
       /* This event usually comes from the downstream gstrtpsession */
       if (gst_structure_has_name (s, "GstRTPRetransmissionRequest")) {
         guint seqnum = 0;
+        guint num_seqnums = 1;
         guint ssrc = 0;
+        GstBufferList *rtx_list = NULL;
         GstBuffer *rtx_buf = NULL;
 
         /* retrieve seqnum of the packet that need to be retransmitted */
         if (!gst_structure_get_uint (s, "seqnum", &seqnum))
           seqnum = -1;
 
+        /* retrieve how many packets, starting at seqnum, need to be
+         * retransmitted. RIST range NACKs ask for a run of them at once */
+        if (!gst_structure_get_uint (s, "num-seqnums", &num_seqnums))
+          num_seqnums = 1;
+        num_seqnums = CLAMP (num_seqnums, 1, G_MAXUINT16 + 1);
+
         /* retrieve ssrc of the packet that need to be retransmitted */
         if (!gst_structure_get_uint (s, "ssrc", &ssrc))
           ssrc = -1;
 
-        GST_DEBUG_OBJECT (rtx, "got rtx request for seqnum: %u, ssrc: %X",
-            seqnum, ssrc);
+        GST_DEBUG_OBJECT (rtx, "got rtx request for seqnum: %u (%u packets), "
+            "ssrc: %X", seqnum, num_seqnums, ssrc);
 
         GST_OBJECT_LOCK (rtx);
         /* check if request is for us */
         if (g_hash_table_contains (rtx->ssrc_data, GUINT_TO_POINTER (ssrc))) {
           SSRCRtxData *data;
-          GSequenceIter *iter;
-          BufferQueueItem search_item;
+          guint i;
 
           /* update statistics */
-          ++rtx->num_rtx_requests;
+          rtx->num_rtx_requests += num_seqnums;
 
           data = gst_rist_rtx_send_get_ssrc_data (rtx, ssrc);
 
-          search_item.seqnum = seqnum;
-          iter = g_sequence_lookup (data->queue, &search_item,
-              (GCompareDataFunc) buffer_queue_items_cmp, NULL);
-          if (iter) {
-            BufferQueueItem *item = g_sequence_get (iter);
-            GST_LOG_OBJECT (rtx, "found %u", item->seqnum);
-            rtx_buf = gst_rtp_rist_buffer_new (rtx, item->buffer, ssrc);
-          }
-#ifndef GST_DISABLE_DEBUG
-          else {
-            BufferQueueItem *item = NULL;
+          if (num_seqnums > 1)
+            rtx_list = gst_buffer_list_new_sized (num_seqnums);
 
-            iter = g_sequence_get_begin_iter (data->queue);
-            if (!g_sequence_iter_is_end (iter))
-              item = g_sequence_get (iter);
+          for (i = 0; i < num_seqnums; i++) {
+            guint16 cur_seqnum = seqnum + i;
+            BufferQueueItem *item = ssrc_rtx_data_lookup (data, cur_seqnum);
 
-            if (item && seqnum < item->seqnum) {
+            if (item) {
+              GST_LOG_OBJECT (rtx, "found %u", item->seqnum);
+              rtx_buf = gst_rtp_rist_buffer_new (rtx, item->buffer, ssrc);
+              if (rtx_list) {
+                gst_buffer_list_add (rtx_list, rtx_buf);
+                rtx_buf = NULL;
+              }
+            }
+#ifndef GST_DISABLE_DEBUG
+            else if (data->num_seqnums > 0 &&
+                gst_rtp_buffer_compare_seqnum (cur_seqnum,
+                    data->first_seqnum) > 0) {
               GST_DEBUG_OBJECT (rtx, "requested seqnum %u has already been "
                   "removed from the rtx queue; the first available is %u",
-                  seqnum, item->seqnum);
+                  cur_seqnum, data->first_seqnum);
             } else {
               GST_WARNING_OBJECT (rtx, "requested seqnum %u has not been "
                   "transmitted yet in the original stream; either the remote end "
                   "is not configured correctly, or the source is too slow",
-                  seqnum);
+                  cur_seqnum);
             }
 #endif
           }
         }
         GST_OBJECT_UNLOCK (rtx);
 
-        if (rtx_buf)
+        if (rtx_list) {
+          if (gst_buffer_list_length (rtx_list) > 0)
+            gst_rist_rtx_send_push_out (rtx, rtx_list);
+          else
+            gst_buffer_list_unref (rtx_list);
+        } else if (rtx_buf) {
           gst_rist_rtx_send_push_out (rtx, rtx_buf);
+        }
 
         gst_event_unref (event);
         return TRUE;
@@ -535,14 +603,14 @@ gst_rist_rtx_send_get_ts_diff (SSRCRtxData * data)
   BufferQueueItem *high_buf, *low_buf;
   guint32 result;
 
-  high_buf =
-      g_sequence_get (g_sequence_iter_prev (g_sequence_get_end_iter
-          (data->queue)));
-  low_buf = g_sequence_get (g_sequence_get_begin_iter (data->queue));
-
-  if (!high_buf || !low_buf || high_buf == low_buf)
+  if (data->num_seqnums < 2)
     return 0;
 
+  /* both ends of the history are always set */
+  high_buf = ssrc_rtx_data_get_item (data,
+      data->first_seqnum + data->num_seqnums - 1);
+  low_buf = ssrc_rtx_data_get_item (data, data->first_seqnum);
+
   high_ts = high_buf->timestamp;
   low_ts = low_buf->timestamp;
 
@@ -564,8 +632,9 @@ process_buffer (GstRistRtxSend * rtx, GstBuffer * buffer)
   GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
   BufferQueueItem *item;
   SSRCRtxData *data;
-  guint16 seqnum;
+  guint16 seqnum, offset;
   guint32 ssrc, rtptime;
+  guint history_size;
 
   /* read the information we want from the buffer */
   gst_rtp_buffer_map (buffer, GST_MAP_READ, &rtp);
@@ -579,21 +648,64 @@ process_buffer (GstRistRtxSend * rtx, GstBuffer * buffer)
 
   data = gst_rist_rtx_send_get_ssrc_data (rtx, ssrc);
 
+  /* (re)allocate the history when it's first used or when max-size-packets
+   * changed, the packets it held are dropped */
+  history_size = ssrc_rtx_data_history_size (rtx->max_size_packets);
+  if (data->history_size != history_size) {
+    ssrc_rtx_data_clear_history (data);
+    g_free (data->history);
+    data->history = g_new0 (BufferQueueItem, history_size);
+    data->history_size = history_size;
+  }
+
+  if (data->num_seqnums == 0) {
+    data->first_seqnum = seqnum;
+    data->num_seqnums = 1;
+  } else if (gst_rtp_buffer_compare_seqnum (data->first_seqnum, seqnum) < 0) {
+    guint16 last_seqnum = data->first_seqnum + data->num_seqnums - 1;
+
+    if ((guint16) (last_seqnum - seqnum) < history_size) {
+      GST_DEBUG_OBJECT (rtx, "seqnum %u is older than the history "
+          "(first %u), not keeping it", seqnum, data->first_seqnum);
+      return;
+    }
+
+    /* too far back to be a late packet, the sender restarted its seqnums and
+     * the packets we have will never be asked for again */
+    GST_DEBUG_OBJECT (rtx, "seqnum jumped back from %u to %u, restarting the "
+        "history", last_seqnum, seqnum);
+    ssrc_rtx_data_clear_history (data);
+    data->first_seqnum = seqnum;
+    data->num_seqnums = 1;
+  } else {
+    offset = seqnum - data->first_seqnum;
+    if (offset >= data->num_seqnums) {
+      /* newer than all we have, make room for it; the seqnums in between
+       * are missing and their items are already empty */
+      while (data->num_seqnums > 0 &&
+          (guint16) (seqnum - data->first_seqnum) >= history_size)
+        ssrc_rtx_data_expire_first (data);
+
+      if (data->num_seqnums == 0)
+        data->first_seqnum = seqnum;
+      data->num_seqnums = (guint16) (seqnum - data->first_seqnum) + 1;
+    }
+  }
+
   /* add current rtp buffer to queue history */
-  item = g_slice_new0 (BufferQueueItem);
+  item = ssrc_rtx_data_get_item (data, seqnum);
   item->seqnum = seqnum;
   item->timestamp = rtptime;
-  item->buffer = gst_buffer_ref (buffer);
-  g_sequence_append (data->queue, item);
+  gst_buffer_replace (&item->buffer, buffer);
 
   /* remove oldest packets from history if they are too many */
   if (rtx->max_size_packets) {
-    while (g_sequence_get_length (data->queue) > rtx->max_size_packets)
-      g_sequence_remove (g_sequence_get_begin_iter (data->queue));
+    while (data->num_seqnums > rtx->max_size_packets)
+      ssrc_rtx_data_expire_first (data);
   }
   if (rtx->max_size_time) {
     while (gst_rist_rtx_send_get_ts_diff (data) > rtx->max_size_time)
-      g_sequence_remove (g_sequence_get_begin_iter (data->queue));
+      ssrc_rtx_data_expire_first (data);
   }
 }
 
@@ -649,6 +761,14 @@ gst_rist_rtx_send_src_loop (GstRistRtxSend * rtx)
       GST_OBJECT_UNLOCK (rtx);
 
       gst_pad_push (rtx->srcpad, GST_BUFFER (data->object));
+    } else if (GST_IS_BUFFER_LIST (data->object)) {
+      GstBufferList *list = GST_BUFFER_LIST (data->object);
+
+      GST_OBJECT_LOCK (rtx);
+      rtx->num_rtx_packets += gst_buffer_list_length (list);
+      GST_OBJECT_UNLOCK (rtx);
+
+      gst_pad_push_list (rtx->srcpad, list);
     } else if (GST_IS_EVENT (data->object)) {
       gst_pad_push_event (rtx->srcpad, GST_EVENT (data->object));
 
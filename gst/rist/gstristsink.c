@@ -46,13 +46,18 @@
  * mapped to its own RTP session. RTX request are only replied to on the
  * link the NACK was received from.
  *
- * There are currently two bonding methods in place: "broadcast" and "round-robin".
- * In "broadcast" mode, all the packets are duplicated over all sessions.
- * While in "round-robin" mode, packets are evenly distributed over the links. One
- * can also implement its own dispatcher element and configure it using the
- * "dispatcher" property. As a reference, "broadcast" mode is implemented with
- * the "tee" element, while "round-robin" mode is implemented with the
- * "round-robin" element.
+ * There are currently three bonding methods in place: "broadcast",
+ * "round-robin" and "weighted". In "broadcast" mode, all the packets are
+ * duplicated over all sessions. While in "round-robin" mode, packets are evenly
+ * distributed over the links. The "weighted" mode distributes the packets in
+ * proportion to the capacity estimated for each link from the RTCP receiver
+ * reports: a link is given more packets for as long as it reports neither
+ * losses nor growing round-trip times, and less as soon as it does. Its share
+ * is further reduced by the reported jitter. One can also implement its own
+ * dispatcher element and configure it using the "dispatcher" property. As a
+ * reference, "broadcast" mode is implemented with the "tee" element, while
+ * "round-robin" and "weighted" modes are implemented with the "round-robin"
+ * element, the latter by updating the "weight" of its pads.
  *
  * ## Example gst-launch line for bonding
  * |[
@@ -75,6 +80,7 @@
 #include <stdlib.h>
 
 #include "gstrist.h"
+#include "gstroundrobin.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_rist_sink_debug);
 #define GST_CAT_DEFAULT gst_rist_sink_debug
@@ -101,8 +107,25 @@ typedef enum
 {
   GST_RIST_BONDING_METHOD_BROADCAST,
   GST_RIST_BONDING_METHOD_ROUND_ROBIN,
+  GST_RIST_BONDING_METHOD_WEIGHTED,
 } GstRistBondingMethod;
 
+/* For the weighted bonding method, a link is considered congested when it
+ * loses more than this fraction of the packets ... */
+#define WEIGHTED_LOSS_THRESHOLD 0.02
+/* ... or when its round-trip time is this much above the lowest seen */
+#define WEIGHTED_QUEUING_THRESHOLD (50 * GST_MSECOND)
+/* A congested link is given at most this fraction of what it was sent */
+#define WEIGHTED_BACKOFF_FACTOR 0.85
+/* An uncongested link is given up to this much more than it was sent */
+#define WEIGHTED_PROBE_FACTOR 1.1
+/* The jitter at which the weight of a link is halved */
+#define WEIGHTED_JITTER_SCALE (20 * GST_MSECOND)
+/* Weights are in per mille, every link keeps at least this many so that its
+ * capacity keeps being measured */
+#define WEIGHTED_TOTAL_WEIGHT 1000
+#define WEIGHTED_MIN_WEIGHT 20
+
 static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
@@ -120,6 +143,17 @@ typedef struct
   GstElement *rtx_send;
   GstElement *rtx_queue;
   guint32 rtcp_ssrc;
+
+  /* Link feedback, updated on each receiver report, protected by
+   * bonds_lock */
+  GstClockTime last_report;
+  guint64 last_octets_sent;
+  guint64 bitrate;
+  gdouble fraction_lost;
+  GstClockTime jitter;
+  GstClockTime min_rtt;
+  /* estimated capacity in bits/s, 0 when unknown */
+  gdouble capacity;
 } RistSenderBond;
 
 struct _GstRistSink
@@ -139,6 +173,10 @@ struct _GstRistSink
   GstClockTime min_rtcp_interval;
   gdouble max_rtcp_bandwidth;
   GstRistBondingMethod bonding_method;
+  /* bonding method the dispatcher was created for, unless the application
+   * provided its own with the dispatcher property */
+  GstRistBondingMethod dispatcher_method;
+  gboolean custom_dispatcher;
 
   /* Bonds */
   GPtrArray *bonds;
@@ -167,6 +205,8 @@ gst_rist_bonding_method_get_type (void)
         "GST_RIST_BONDING_METHOD_BROADCAST", "broadcast"},
     {GST_RIST_BONDING_METHOD_ROUND_ROBIN,
         "GST_RIST_BONDING_METHOD_ROUND_ROBIN", "round-robin"},
+    {GST_RIST_BONDING_METHOD_WEIGHTED,
+        "GST_RIST_BONDING_METHOD_WEIGHTED", "weighted"},
     {0, NULL, NULL}
   };
 
@@ -190,6 +230,8 @@ gst_rist_sink_add_bond (GstRistSink * sink)
 
   bond->session = sink->bonds->len;
   bond->address = g_strdup ("localhost");
+  bond->last_report = GST_CLOCK_TIME_NONE;
+  bond->min_rtt = GST_CLOCK_TIME_NONE;
 
   g_snprintf (name, 32, "rist_rtp_udpsink%u", bond->session);
   bond->rtp_sink = gst_element_factory_make ("udpsink", name);
@@ -312,18 +354,18 @@ on_app_rtcp (GObject * session, guint32 subtype, guint32 ssrc,
           guint32 dword = GST_READ_UINT32_BE (map.data + i);
           guint16 seqnum = dword >> 16;
           guint16 num = dword & 0x0000FFFF;
-          guint16 j;
 
           GST_DEBUG ("got RIST nack packet, #%u %u", seqnum, num);
 
-          /* num is inclusive, i.e. it can be 0, which means exactly 1 seqnum */
-          for (j = 0; j <= num; j++) {
-            event = gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
-                gst_structure_new ("GstRTPRetransmissionRequest",
-                    "seqnum", G_TYPE_UINT, (guint) seqnum + j,
-                    "ssrc", G_TYPE_UINT, (guint) ssrc, NULL));
-            gst_pad_push_event (send_rtp_sink, event);
-          }
+          /* num is inclusive, i.e. it can be 0, which means exactly 1 seqnum.
+           * The whole range is requested at once so that ristrtxsend can
+           * resend it as a single buffer list */
+          event = gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
+              gst_structure_new ("GstRTPRetransmissionRequest",
+                  "seqnum", G_TYPE_UINT, (guint) seqnum,
+                  "num-seqnums", G_TYPE_UINT, (guint) num + 1,
+                  "ssrc", G_TYPE_UINT, (guint) ssrc, NULL));
+          gst_pad_push_event (send_rtp_sink, event);
         }
 
         gst_buffer_unmap (data, &map);
@@ -372,6 +414,165 @@ gst_rist_sink_on_new_receiver_ssrc (GstRistSink * sink, guint session_id,
   bond->rtcp_ssrc = ssrc;
 }
 
+/* Must be called with bonds_lock */
+static void
+gst_rist_sink_update_capacity (RistSenderBond * bond, GstClockTime rtt)
+{
+  gboolean congested;
+
+  congested = bond->fraction_lost > WEIGHTED_LOSS_THRESHOLD ||
+      (GST_CLOCK_TIME_IS_VALID (bond->min_rtt) &&
+      rtt > bond->min_rtt + WEIGHTED_QUEUING_THRESHOLD);
+
+  if (congested) {
+    /* back off below what was sent, at least by what got lost */
+    bond->capacity = bond->bitrate * MIN (1.0 - bond->fraction_lost,
+        WEIGHTED_BACKOFF_FACTOR);
+  } else {
+    /* the link can take at least what it was sent, probe for more */
+    bond->capacity = MAX (bond->capacity,
+        bond->bitrate * WEIGHTED_PROBE_FACTOR);
+  }
+}
+
+/* Must be called with bonds_lock */
+static gdouble
+gst_rist_sink_get_effective_capacity (RistSenderBond * bond)
+{
+  return bond->capacity / (1.0 + (gdouble) bond->jitter /
+      WEIGHTED_JITTER_SCALE);
+}
+
+/* Must be called with bonds_lock */
+static void
+gst_rist_sink_update_weights (GstRistSink * sink)
+{
+  gdouble total = 0.0, mean;
+  guint i, known = 0;
+
+  for (i = 0; i < sink->bonds->len; i++) {
+    RistSenderBond *bond = g_ptr_array_index (sink->bonds, i);
+
+    if (bond->capacity > 0.0) {
+      total += gst_rist_sink_get_effective_capacity (bond);
+      known++;
+    }
+  }
+
+  if (known == 0 || total <= 0.0)
+    return;
+
+  /* links without any estimate yet are assumed to be average */
+  mean = total / known;
+  total += mean * (sink->bonds->len - known);
+
+  for (i = 0; i < sink->bonds->len; i++) {
+    RistSenderBond *bond = g_ptr_array_index (sink->bonds, i);
+    gdouble capacity = mean;
+    guint weight;
+    GstPad *pad;
+    gchar name[32];
+
+    if (bond->capacity > 0.0)
+      capacity = gst_rist_sink_get_effective_capacity (bond);
+
+    weight = MAX (capacity * WEIGHTED_TOTAL_WEIGHT / total,
+        WEIGHTED_MIN_WEIGHT);
+
+    g_snprintf (name, 32, "src_%u", bond->session);
+    pad = gst_element_get_static_pad (sink->dispatcher, name);
+    if (pad) {
+      GST_LOG_OBJECT (sink, "session %u: capacity %.0f bits/s, weight %u",
+          bond->session, capacity, weight);
+      g_object_set (pad, "weight", weight, NULL);
+      gst_object_unref (pad);
+    }
+  }
+}
+
+static void
+gst_rist_sink_on_ssrc_active (GstRistSink * sink, guint session_id,
+    guint ssrc, GstElement * rtpbin)
+{
+  GObject *session = NULL, *source = NULL;
+  GstStructure *sstats = NULL;
+  RistSenderBond *bond;
+  gboolean have_rb = FALSE;
+  guint rb_fraction_lost = 0, rb_jitter = 0, rb_rtt = 0;
+  guint64 octets_sent = 0;
+  gint clock_rate = -1;
+  GstClockTime now, rtt;
+
+  /* only the reports from the receiver tell us about the link */
+  if ((ssrc & ~1) == sink->rtp_ssrc)
+    return;
+
+  g_signal_emit_by_name (rtpbin, "get-internal-session", session_id, &session);
+  if (!session)
+    return;
+
+  g_signal_emit_by_name (session, "get-source-by-ssrc", ssrc, &source);
+  if (source) {
+    g_object_get (source, "stats", &sstats, NULL);
+    gst_structure_get_boolean (sstats, "have-rb", &have_rb);
+    gst_structure_get_uint (sstats, "rb-fractionlost", &rb_fraction_lost);
+    gst_structure_get_uint (sstats, "rb-jitter", &rb_jitter);
+    gst_structure_get_uint (sstats, "rb-round-trip", &rb_rtt);
+    gst_structure_free (sstats);
+    g_clear_object (&source);
+  }
+
+  g_signal_emit_by_name (session, "get-source-by-ssrc", sink->rtp_ssrc,
+      &source);
+  if (source) {
+    g_object_get (source, "stats", &sstats, NULL);
+    gst_structure_get_uint64 (sstats, "octets-sent", &octets_sent);
+    gst_structure_get_int (sstats, "clock-rate", &clock_rate);
+    gst_structure_free (sstats);
+    g_clear_object (&source);
+  }
+  g_object_unref (session);
+
+  if (!have_rb)
+    return;
+
+  now = gst_util_get_timestamp ();
+  /* rb_rtt is in Q16 in NTP time */
+  rtt = gst_util_uint64_scale (rb_rtt, GST_SECOND, 65536);
+
+  g_mutex_lock (&sink->bonds_lock);
+  if (session_id >= sink->bonds->len)
+    goto done;
+
+  bond = g_ptr_array_index (sink->bonds, session_id);
+
+  bond->fraction_lost = rb_fraction_lost / 256.0;
+  if (clock_rate > 0)
+    bond->jitter = gst_util_uint64_scale_int (rb_jitter, GST_SECOND,
+        clock_rate);
+  if (rtt > 0 && (!GST_CLOCK_TIME_IS_VALID (bond->min_rtt)
+          || rtt < bond->min_rtt))
+    bond->min_rtt = rtt;
+
+  if (GST_CLOCK_TIME_IS_VALID (bond->last_report) && now > bond->last_report
+      && octets_sent >= bond->last_octets_sent) {
+    bond->bitrate = gst_util_uint64_scale (octets_sent - bond->last_octets_sent,
+        8 * GST_SECOND, now - bond->last_report);
+
+    if (!sink->custom_dispatcher
+        && sink->dispatcher_method == GST_RIST_BONDING_METHOD_WEIGHTED) {
+      gst_rist_sink_update_capacity (bond, rtt);
+      gst_rist_sink_update_weights (sink);
+    }
+  }
+
+  bond->last_report = now;
+  bond->last_octets_sent = octets_sent;
+
+done:
+  g_mutex_unlock (&sink->bonds_lock);
+}
+
 static GstPadProbeReturn
 gst_rist_sink_fix_collision (GstPad * pad, GstPadProbeInfo * info,
     gpointer user_data)
@@ -488,6 +689,8 @@ gst_rist_sink_init (GstRistSink * sink)
       G_CALLBACK (gst_rist_sink_on_new_sender_ssrc), sink);
   g_signal_connect_swapped (sink->rtpbin, "on-new-ssrc",
       G_CALLBACK (gst_rist_sink_on_new_receiver_ssrc), sink);
+  g_signal_connect_swapped (sink->rtpbin, "on-ssrc-active",
+      G_CALLBACK (gst_rist_sink_on_ssrc_active), sink);
 
   sink->rtxbin = gst_bin_new ("rist_send_rtxbin");
   g_object_ref_sink (sink->rtxbin);
@@ -622,7 +825,13 @@ gst_rist_sink_start (GstRistSink * sink)
             "rist_dispatcher");
         g_assert (sink->dispatcher);
         break;
+      case GST_RIST_BONDING_METHOD_WEIGHTED:
+        sink->dispatcher = gst_element_factory_make ("roundrobin",
+            "rist_dispatcher");
+        g_assert (sink->dispatcher);
+        break;
     }
+    sink->dispatcher_method = sink->bonding_method;
   }
 
   if (sink->construct_failed) {
@@ -663,6 +872,35 @@ gst_rist_sink_start (GstRistSink * sink)
 }
 
 
+/* Returns the weight of the dispatcher pad of a bond, or -1 if the
+ * dispatcher has no notion of weight. Must be called with bonds_lock */
+static gint
+gst_rist_sink_get_bond_weight (GstRistSink * sink, RistSenderBond * bond)
+{
+  GstPad *pad;
+  gchar name[32];
+  guint weight;
+
+  if (!sink->dispatcher)
+    return -1;
+
+  g_snprintf (name, 32, "src_%u", bond->session);
+  pad = gst_element_get_static_pad (sink->dispatcher, name);
+  if (!pad)
+    return -1;
+
+  if (!GST_IS_ROUND_ROBIN_PAD (pad)) {
+    gst_object_unref (pad);
+    return -1;
+  }
+
+  g_object_get (pad, "weight", &weight, NULL);
+  gst_object_unref (pad);
+
+  return weight;
+}
+
+/* Must be called with bonds_lock */
 static GstStructure *
 gst_rist_sink_create_stats (GstRistSink * sink)
 {
@@ -670,8 +908,22 @@ gst_rist_sink_create_stats (GstRistSink * sink)
   GstStructure *ret;
   GValueArray *session_stats;
   guint64 total_pkt_sent = 0, total_rtx_sent = 0;
+  gint64 total_weight = 0;
+  gboolean broadcast;
   gint i;
 
+  broadcast = sink->dispatcher && !sink->custom_dispatcher
+      && sink->dispatcher_method == GST_RIST_BONDING_METHOD_BROADCAST;
+
+  for (i = 0; i < sink->bonds->len; i++) {
+    gint weight;
+
+    bond = g_ptr_array_index (sink->bonds, i);
+    weight = gst_rist_sink_get_bond_weight (sink, bond);
+    if (weight > 0)
+      total_weight += weight;
+  }
+
   ret = gst_structure_new_empty ("rist/x-sender-stats");
   session_stats = g_value_array_new (sink->bonds->len);
 
@@ -716,7 +968,21 @@ gst_rist_sink_create_stats (GstRistSink * sink)
     gst_structure_set (stats, "session-id", G_TYPE_INT, i,
         "sent-original-packets", G_TYPE_UINT64, pkt_sent,
         "sent-retransmitted-packets", G_TYPE_UINT64, rtx_sent,
-        "round-trip-time", G_TYPE_UINT64, rtt, NULL);
+        "round-trip-time", G_TYPE_UINT64, rtt,
+        "sent-bitrate", G_TYPE_UINT64, bond->bitrate,
+        "fraction-lost", G_TYPE_DOUBLE, bond->fraction_lost,
+        "jitter", G_TYPE_UINT64, bond->jitter, NULL);
+
+    /* the fraction of the stream sent over this link */
+    if (broadcast) {
+      gst_structure_set (stats, "share", G_TYPE_DOUBLE, 1.0, NULL);
+    } else {
+      gint weight = gst_rist_sink_get_bond_weight (sink, bond);
+
+      if (weight >= 0)
+        gst_structure_set (stats, "share", G_TYPE_DOUBLE,
+            total_weight ? (gdouble) weight / total_weight : 0.0, NULL);
+    }
 
     g_value_init (&value, GST_TYPE_STRUCTURE);
     g_value_take_boxed (&value, stats);
@@ -741,7 +1007,11 @@ gst_rist_sink_dump_stats (GstClock * clock, GstClockTime time, GstClockID id,
     gpointer user_data)
 {
   GstRistSink *sink = GST_RIST_SINK (user_data);
-  GstStructure *stats = gst_rist_sink_create_stats (sink);
+  GstStructure *stats;
+
+  g_mutex_lock (&sink->bonds_lock);
+  stats = gst_rist_sink_create_stats (sink);
+  g_mutex_unlock (&sink->bonds_lock);
 
   gst_println ("%s: %" GST_PTR_FORMAT, GST_OBJECT_NAME (sink), stats);
 
@@ -1149,6 +1419,7 @@ gst_rist_sink_set_property (GObject * object, guint prop_id,
       if (sink->dispatcher)
         g_object_unref (sink->dispatcher);
       sink->dispatcher = g_object_ref_sink (g_value_get_object (value));
+      sink->custom_dispatcher = TRUE;
       break;
 
     default:
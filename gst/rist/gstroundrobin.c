@@ -27,6 +27,11 @@
  * element, which duplicates buffers over all pads. This element 
  * can be used to distrute load across multiple branches when the buffer
  * can be processed indepently.
+ *
+ * Each src pad has a "weight" property, buffers are spread over the pads in
+ * proportion to their weight, interleaving them as evenly as possible. A pad
+ * with a weight of 0 receives nothing. Since all pads default to the same
+ * weight, buffers are by default distributed equally and in turn.
  */
 
 #include "gstroundrobin.h"
@@ -44,39 +49,148 @@ static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src_%d",
     GST_PAD_REQUEST,
     GST_STATIC_CAPS ("ANY"));
 
+#define DEFAULT_WEIGHT 1
+
+enum
+{
+  PROP_PAD_0,
+  PROP_PAD_WEIGHT,
+};
+
+struct _GstRoundRobinPad
+{
+  GstPad parent;
+
+  /* atomic, so that it can be changed without locking the streaming */
+  gint weight;
+
+  /* protected by the element object lock */
+  gint64 current;
+};
+
+G_DEFINE_TYPE (GstRoundRobinPad, gst_round_robin_pad, GST_TYPE_PAD);
+
+static void
+gst_round_robin_pad_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstRoundRobinPad *pad = GST_ROUND_ROBIN_PAD (object);
+
+  switch (prop_id) {
+    case PROP_PAD_WEIGHT:
+      g_atomic_int_set (&pad->weight, g_value_get_uint (value));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_round_robin_pad_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstRoundRobinPad *pad = GST_ROUND_ROBIN_PAD (object);
+
+  switch (prop_id) {
+    case PROP_PAD_WEIGHT:
+      g_value_set_uint (value, g_atomic_int_get (&pad->weight));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_round_robin_pad_init (GstRoundRobinPad * pad)
+{
+  pad->weight = DEFAULT_WEIGHT;
+}
+
+static void
+gst_round_robin_pad_class_init (GstRoundRobinPadClass * klass)
+{
+  GObjectClass *object_class = (GObjectClass *) klass;
+
+  object_class->set_property = gst_round_robin_pad_set_property;
+  object_class->get_property = gst_round_robin_pad_get_property;
+
+  /**
+   * GstRoundRobinPad:weight:
+   *
+   * The share of the buffers sent on this pad, relative to the weight of the
+   * other pads. A pad with a weight of 0 does not receive any buffer.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (object_class, PROP_PAD_WEIGHT,
+      g_param_spec_uint ("weight", "Weight",
+          "Share of the buffers sent on this pad, relative to the other pads",
+          0, G_MAXINT, DEFAULT_WEIGHT,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_PLAYING |
+          G_PARAM_STATIC_STRINGS));
+}
+
 struct _GstRoundRobin
 {
   GstElement parent;
-  gint index;
 };
 
 G_DEFINE_TYPE_WITH_CODE (GstRoundRobin, gst_round_robin,
     GST_TYPE_ELEMENT, GST_DEBUG_CATEGORY_INIT (gst_round_robin_debug,
         "roundrobin", 0, "Round Robin"));
 
+/* Smooth weighted round robin: each pad accumulates its weight, the one that
+ * got the most is picked and pays back the sum of all weights. With equal
+ * weights this is a plain round robin, otherwise the pads are still
+ * interleaved instead of being picked in bursts. Must be called with the
+ * object lock. */
+static GstPad *
+gst_round_robin_select_pad (GstRoundRobin * disp)
+{
+  GstRoundRobinPad *selected = NULL;
+  gint64 total = 0;
+  GList *l;
+
+  for (l = GST_ELEMENT (disp)->srcpads; l; l = l->next) {
+    GstRoundRobinPad *pad = l->data;
+    gint weight = g_atomic_int_get (&pad->weight);
+
+    if (weight == 0)
+      continue;
+
+    pad->current += weight;
+    total += weight;
+
+    if (!selected || pad->current > selected->current)
+      selected = pad;
+  }
+
+  if (!selected)
+    return NULL;
+
+  selected->current -= total;
+
+  return gst_object_ref (selected);
+}
+
 static GstFlowReturn
 gst_round_robin_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 {
   GstRoundRobin *disp = (GstRoundRobin *) parent;
-  GstElement *elem = (GstElement *) parent;
   GstPad *src_pad = NULL;
   GstFlowReturn ret;
 
   GST_OBJECT_LOCK (disp);
-  if (disp->index >= elem->numsrcpads)
-    disp->index = 0;
-
-  src_pad = g_list_nth_data (elem->srcpads, disp->index);
-
-  if (src_pad) {
-    gst_object_ref (src_pad);
-    disp->index += 1;
-  }
+  src_pad = gst_round_robin_select_pad (disp);
   GST_OBJECT_UNLOCK (disp);
 
-  if (!src_pad)
+  if (!src_pad) {
     /* no pad, that's fine */
+    gst_buffer_unref (buffer);
     return GST_FLOW_OK;
+  }
 
   ret = gst_pad_push (src_pad, buffer);
   gst_object_unref (src_pad);
@@ -96,7 +210,8 @@ gst_round_robin_request_pad (GstElement * element, GstPadTemplate * templ,
     return NULL;
   }
 
-  pad = gst_pad_new_from_static_template (&src_templ, name);
+  pad = g_object_new (GST_TYPE_ROUND_ROBIN_PAD, "name", name, "direction",
+      templ->direction, "template", templ, NULL);
   gst_element_add_pad (element, pad);
 
   return pad;
@@ -128,7 +243,8 @@ gst_round_robin_class_init (GstRoundRobinClass * klass)
       "Nicolas Dufresne <nicolas.dufresne@collabora.com");
 
   gst_element_class_add_static_pad_template (element_class, &sink_templ);
-  gst_element_class_add_static_pad_template (element_class, &src_templ);
+  gst_element_class_add_static_pad_template_with_gtype (element_class,
+      &src_templ, GST_TYPE_ROUND_ROBIN_PAD);
 
   element_class->request_new_pad =
       GST_DEBUG_FUNCPTR (gst_round_robin_request_pad);
@@ -31,4 +31,13 @@ typedef struct {
 } GstRoundRobinClass;
 GType gst_round_robin_get_type (void);
 
+#define GST_TYPE_ROUND_ROBIN_PAD    (gst_round_robin_pad_get_type())
+#define GST_ROUND_ROBIN_PAD(obj)    (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_ROUND_ROBIN_PAD,GstRoundRobinPad))
+#define GST_IS_ROUND_ROBIN_PAD(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_ROUND_ROBIN_PAD))
+typedef struct _GstRoundRobinPad GstRoundRobinPad;
+typedef struct {
+  GstPadClass parent;
+} GstRoundRobinPadClass;
+GType gst_round_robin_pad_get_type (void);
+
 #endif
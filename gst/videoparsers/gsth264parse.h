@@ -123,6 +123,8 @@ struct _GstH264Parse
   gint idr_pos, sei_pos;
   gboolean update_caps;
   GstAdapter *frame_out;
+  guint frame_out_n_mem;
+  gint frame_out_merge_pos;
   gboolean keyframe;
   gboolean predicted;
   gboolean bidirectional;
@@ -33,6 +33,11 @@ GST_DEBUG_CATEGORY (h265_parse_debug);
 
 #define DEFAULT_CONFIG_INTERVAL      (0)
 
+/* NALs at least this big are wrapped by sharing the memory they are in
+ * rather than by copying them, smaller ones are not worth the extra
+ * GstMemory */
+#define MIN_SHARED_NAL_SIZE          (1024)
+
 enum
 {
   PROP_0,
@@ -199,6 +204,8 @@ gst_h265_parse_reset_frame (GstH265Parse * h265parse)
   h265parse->have_sps_in_frame = FALSE;
   h265parse->have_pps_in_frame = FALSE;
   gst_adapter_clear (h265parse->frame_out);
+  h265parse->frame_out_n_mem = 0;
+  h265parse->frame_out_merge_pos = -1;
 }
 
 static void
@@ -417,17 +424,36 @@ gst_h265_parse_negotiate (GstH265Parse * h265parse, gint in_format,
     gst_caps_unref (caps);
 }
 
+/* number of memories of @buffer the @size bytes at @offset are in */
+static guint
+gst_h265_parse_n_memory_in_range (GstBuffer * buffer, guint offset, gsize size)
+{
+  guint idx, length;
+  gsize skip;
+
+  if (size == 0
+      || !gst_buffer_find_memory (buffer, offset, size, &idx, &length, &skip))
+    return 0;
+
+  return length;
+}
+
+/* prefixes the @size bytes of @src at @offset with a start code or NAL
+ * length as needed for @format. Large NALs share the memory of @src, so
+ * only the prefix is allocated, unless that would leave the output, which
+ * already holds @n_mem memories, without a last free memory: a GstBuffer
+ * merges all of its memories into a copy once it has too many */
 static GstBuffer *
-gst_h265_parse_wrap_nal (GstH265Parse * h265parse, guint format, guint8 * data,
-    guint size)
+gst_h265_parse_wrap_nal (GstH265Parse * h265parse, guint format,
+    GstBuffer * src, guint offset, guint size, guint n_mem)
 {
   GstBuffer *buf;
+  GstMapInfo map;
   guint nl = h265parse->nal_length_size;
   guint32 tmp;
 
   GST_DEBUG_OBJECT (h265parse, "nal length %d", size);
 
-  buf = gst_buffer_new_allocate (NULL, 4 + size, NULL);
   if (format == GST_H265_PARSE_FORMAT_HVC1
       || format == GST_H265_PARSE_FORMAT_HEV1) {
     tmp = GUINT32_TO_BE (size << (32 - 8 * nl));
@@ -439,9 +465,19 @@ gst_h265_parse_wrap_nal (GstH265Parse * h265parse, guint format, guint8 * data,
     tmp = GUINT32_TO_BE (1);
   }
 
-  gst_buffer_fill (buf, 0, &tmp, sizeof (guint32));
-  gst_buffer_fill (buf, nl, data, size);
-  gst_buffer_set_size (buf, size + nl);
+  if (size >= MIN_SHARED_NAL_SIZE && n_mem + 1 +
+      gst_h265_parse_n_memory_in_range (src, offset, size) <
+      gst_buffer_get_max_memory ()) {
+    buf = gst_buffer_new_allocate (NULL, nl, NULL);
+    gst_buffer_fill (buf, 0, &tmp, nl);
+    gst_buffer_copy_into (buf, src, GST_BUFFER_COPY_MEMORY, offset, size);
+  } else {
+    buf = gst_buffer_new_allocate (NULL, nl + size, NULL);
+    gst_buffer_map (buf, &map, GST_MAP_WRITE);
+    memcpy (map.data, &tmp, nl);
+    gst_buffer_extract (src, offset, map.data + nl, size);
+    gst_buffer_unmap (buf, &map);
+  }
 
   return buf;
 }
@@ -712,9 +748,10 @@ gst_h265_parse_process_sei_user_data (GstH265Parse * h265parse,
 
 }
 
-/* caller guarantees 2 bytes of nal payload */
+/* caller guarantees 2 bytes of nal payload, @buffer holds the nal data */
 static gboolean
-gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
+gst_h265_parse_process_nal (GstH265Parse * h265parse, GstBuffer * buffer,
+    GstH265NalUnit * nalu)
 {
   GstH265PPS pps = { 0, };
   GstH265SPS sps = { 0, };
@@ -978,8 +1015,19 @@ gst_h265_parse_process_nal (GstH265Parse * h265parse, GstH265NalUnit * nalu)
     GstBuffer *buf;
 
     GST_LOG_OBJECT (h265parse, "collecting NAL in HEVC frame");
-    buf = gst_h265_parse_wrap_nal (h265parse, h265parse->format,
-        nalu->data + nalu->offset, nalu->size);
+    buf = gst_h265_parse_wrap_nal (h265parse, h265parse->format, buffer,
+        nalu->offset, nalu->size, h265parse->frame_out_n_mem);
+    /* once only the last memory is left, all further nals go in there */
+    if (h265parse->frame_out_merge_pos < 0) {
+      if (h265parse->frame_out_n_mem + gst_buffer_n_memory (buf) <
+          gst_buffer_get_max_memory ()) {
+        h265parse->frame_out_n_mem += gst_buffer_n_memory (buf);
+      } else {
+        h265parse->frame_out_n_mem = gst_buffer_get_max_memory ();
+        h265parse->frame_out_merge_pos =
+            gst_adapter_available (h265parse->frame_out);
+      }
+    }
     gst_adapter_push (h265parse->frame_out, buf);
   }
 
@@ -1072,7 +1120,7 @@ gst_h265_parse_handle_frame_packetized (GstBaseParse * parse,
     GST_DEBUG_OBJECT (h265parse, "HEVC nal offset %d", nalu.offset + nalu.size);
 
     /* either way, have a look at it */
-    gst_h265_parse_process_nal (h265parse, &nalu);
+    gst_h265_parse_process_nal (h265parse, buffer, &nalu);
 
     /* dispatch per NALU if needed */
     if (h265parse->split_packetized) {
@@ -1290,7 +1338,7 @@ gst_h265_parse_handle_frame (GstBaseParse * parse,
       }
     }
 
-    if (!gst_h265_parse_process_nal (h265parse, &nalu)) {
+    if (!gst_h265_parse_process_nal (h265parse, buffer, &nalu)) {
       GST_WARNING_OBJECT (h265parse,
           "broken/invalid nal Type: %d %s, Size: %u will be dropped",
           nalu.type, _nal_name (nalu.type), nalu.size);
@@ -2347,7 +2395,19 @@ gst_h265_parse_parse_frame (GstBaseParse * parse, GstBaseParseFrame * frame)
   if (av) {
     GstBuffer *buf;
 
-    buf = gst_adapter_take_buffer (h265parse->frame_out, av);
+    /* keep the memories of the wrapped nals rather than merging them,
+     * except for those that did not fit anymore */
+    if (h265parse->frame_out_merge_pos > 0) {
+      buf = gst_adapter_take_buffer_fast (h265parse->frame_out,
+          h265parse->frame_out_merge_pos);
+      buf = gst_buffer_append (buf,
+          gst_adapter_take_buffer (h265parse->frame_out,
+              av - h265parse->frame_out_merge_pos));
+    } else {
+      buf = gst_adapter_take_buffer_fast (h265parse->frame_out, av);
+    }
+    h265parse->frame_out_n_mem = 0;
+    h265parse->frame_out_merge_pos = -1;
     gst_buffer_copy_into (buf, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
     gst_buffer_replace (&frame->out_buffer, buf);
     gst_buffer_unref (buf);
@@ -2370,12 +2430,8 @@ static GstFlowReturn
 gst_h265_parse_push_codec_buffer (GstH265Parse * h265parse, GstBuffer * nal,
     GstClockTime ts)
 {
-  GstMapInfo map;
-
-  gst_buffer_map (nal, &map, GST_MAP_READ);
-  nal = gst_h265_parse_wrap_nal (h265parse, h265parse->format,
-      map.data, map.size);
-  gst_buffer_unmap (nal, &map);
+  nal = gst_h265_parse_wrap_nal (h265parse, h265parse->format, nal, 0,
+      gst_buffer_get_size (nal), 0);
 
   GST_BUFFER_TIMESTAMP (nal) = ts;
   GST_BUFFER_DURATION (nal) = 0;
@@ -2524,66 +2580,53 @@ gst_h265_parse_handle_vps_sps_pps_nals (GstH265Parse * h265parse,
       }
     }
   } else {
-    /* insert config NALs into AU */
-    GstByteWriter bw;
+    /* insert config NALs into AU, sharing the memory of the frame */
     GstBuffer *new_buf;
-    const gboolean bs = h265parse->format == GST_H265_PARSE_FORMAT_BYTE;
-    const gint nls = 4 - h265parse->nal_length_size;
-    gboolean ok;
+    gboolean ok = TRUE;
+    guint n_mem;
 
-    gst_byte_writer_init_with_size (&bw, gst_buffer_get_size (buffer), FALSE);
-    ok = gst_byte_writer_put_buffer (&bw, buffer, 0, h265parse->idr_pos);
+    /* memories of the rest of the frame, appended after the config nals */
+    n_mem = gst_h265_parse_n_memory_in_range (buffer, h265parse->idr_pos,
+        gst_buffer_get_size (buffer) - h265parse->idr_pos);
+
+    new_buf = gst_buffer_new ();
+    if (h265parse->idr_pos > 0)
+      ok &= gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_MEMORY, 0,
+          h265parse->idr_pos);
     GST_DEBUG_OBJECT (h265parse, "- inserting VPS/SPS/PPS");
     for (i = 0; i < GST_H265_MAX_VPS_COUNT; i++) {
       if ((codec_nal = h265parse->vps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h265parse, "inserting VPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h265_parse_wrap_nal (h265parse, h265parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal),
+                gst_buffer_n_memory (new_buf) + n_mem));
         send_done = TRUE;
       }
     }
     for (i = 0; i < GST_H265_MAX_SPS_COUNT; i++) {
       if ((codec_nal = h265parse->sps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h265parse, "inserting SPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h265_parse_wrap_nal (h265parse, h265parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal),
+                gst_buffer_n_memory (new_buf) + n_mem));
         send_done = TRUE;
       }
     }
     for (i = 0; i < GST_H265_MAX_PPS_COUNT; i++) {
       if ((codec_nal = h265parse->pps_nals[i])) {
-        gsize nal_size = gst_buffer_get_size (codec_nal);
         GST_DEBUG_OBJECT (h265parse, "inserting PPS nal");
-        if (bs) {
-          ok &= gst_byte_writer_put_uint32_be (&bw, 1);
-        } else {
-          ok &= gst_byte_writer_put_uint32_be (&bw, (nal_size << (nls * 8)));
-          ok &= gst_byte_writer_set_pos (&bw,
-              gst_byte_writer_get_pos (&bw) - nls);
-        }
-        ok &= gst_byte_writer_put_buffer (&bw, codec_nal, 0, nal_size);
+        new_buf = gst_buffer_append (new_buf,
+            gst_h265_parse_wrap_nal (h265parse, h265parse->format, codec_nal,
+                0, gst_buffer_get_size (codec_nal),
+                gst_buffer_n_memory (new_buf) + n_mem));
         send_done = TRUE;
       }
     }
-    ok &= gst_byte_writer_put_buffer (&bw, buffer, h265parse->idr_pos, -1);
+    ok &= gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_MEMORY,
+        h265parse->idr_pos, -1);
     /* collect result and push */
-    new_buf = gst_byte_writer_reset_and_get_buffer (&bw);
     gst_buffer_copy_into (new_buf, buffer, GST_BUFFER_COPY_METADATA, 0, -1);
     /* should already be keyframe/IDR, but it may not have been,
      * so mark it as such to avoid being discarded by picky decoder */
@@ -2897,7 +2940,7 @@ gst_h265_parse_set_caps (GstBaseParse * parse, GstCaps * caps)
           goto hvcc_too_small;
         }
 
-        gst_h265_parse_process_nal (h265parse, &nalu);
+        gst_h265_parse_process_nal (h265parse, codec_data, &nalu);
         off = nalu.offset + nalu.size;
       }
     }
@@ -102,6 +102,8 @@ struct _GstH265Parse
   gint idr_pos, sei_pos;
   gboolean update_caps;
   GstAdapter *frame_out;
+  guint frame_out_n_mem;
+  gint frame_out_merge_pos;
   gboolean keyframe;
   gboolean predicted;
   gboolean bidirectional;
@@ -72,10 +72,12 @@ static GstFlowReturn gst_yadif_transform (GstBaseTransform * trans,
 enum
 {
   PROP_0,
-  PROP_MODE
+  PROP_MODE,
+  PROP_N_THREADS
 };
 
 #define DEFAULT_MODE GST_DEINTERLACE_MODE_AUTO
+#define DEFAULT_N_THREADS 1
 
 /* pad templates */
 
@@ -160,11 +162,22 @@ gst_yadif_class_init (GstYadifClass * klass)
           DEFAULT_MODE,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      g_param_spec_uint ("n-threads", "Number of threads",
+          "Number of threads to split each frame between "
+          "(0 = number of processors)", 0, G_MAXINT, DEFAULT_N_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
 }
 
 static void
 gst_yadif_init (GstYadif * yadif)
 {
+  yadif->n_threads = DEFAULT_N_THREADS;
+
+  g_mutex_init (&yadif->workers_lock);
+  g_cond_init (&yadif->workers_cond);
 }
 
 void
@@ -177,6 +190,11 @@ gst_yadif_set_property (GObject * object, guint property_id,
     case PROP_MODE:
       yadif->mode = g_value_get_enum (value);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (yadif);
+      yadif->n_threads = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (yadif);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -193,6 +211,11 @@ gst_yadif_get_property (GObject * object, guint property_id,
     case PROP_MODE:
       g_value_set_enum (value, yadif->mode);
       break;
+    case PROP_N_THREADS:
+      GST_OBJECT_LOCK (yadif);
+      g_value_set_uint (value, yadif->n_threads);
+      GST_OBJECT_UNLOCK (yadif);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, property_id, pspec);
       break;
@@ -212,9 +235,11 @@ gst_yadif_dispose (GObject * object)
 void
 gst_yadif_finalize (GObject * object)
 {
-  /* GstYadif *yadif = GST_YADIF (object); */
+  GstYadif *yadif = GST_YADIF (object);
 
   /* clean up object here */
+  g_mutex_clear (&yadif->workers_lock);
+  g_cond_clear (&yadif->workers_cond);
 
   G_OBJECT_CLASS (gst_yadif_parent_class)->finalize (object);
 }
@@ -277,9 +302,59 @@ gst_yadif_get_unit_size (GstBaseTransform * trans, GstCaps * caps, gsize * size)
   return FALSE;
 }
 
+void yadif_filter (GstYadif * yadif, int parity, int tff);
+void yadif_filter_slice (GstYadif * yadif, int parity, int tff, int slice,
+    int n_slices);
+
+/* Slice threading as libavfilter does it: the frame is cut into slices of
+ * lines, and the streaming thread and the workers keep taking the next one
+ * that is left until there are none. */
+static void
+gst_yadif_take_slices (GstYadif * yadif)
+{
+  gint slice;
+
+  while ((slice = g_atomic_int_add (&yadif->next_slice, 1)) < yadif->n_slices)
+    yadif_filter_slice (yadif, yadif->parity, yadif->tff, slice,
+        yadif->n_slices);
+}
+
+static void
+gst_yadif_worker_func (GstYadif * yadif, gpointer user_data)
+{
+  gst_yadif_take_slices (yadif);
+
+  g_mutex_lock (&yadif->workers_lock);
+  if (--yadif->workers_running == 0)
+    g_cond_signal (&yadif->workers_cond);
+  g_mutex_unlock (&yadif->workers_lock);
+}
+
 static gboolean
 gst_yadif_start (GstBaseTransform * trans)
 {
+  GstYadif *yadif = GST_YADIF (trans);
+  GError *err = NULL;
+  guint n_threads;
+
+  GST_OBJECT_LOCK (yadif);
+  n_threads = yadif->n_threads ? yadif->n_threads : g_get_num_processors ();
+  GST_OBJECT_UNLOCK (yadif);
+
+  yadif->n_workers = 0;
+  if (n_threads > 1) {
+    yadif->pool = g_thread_pool_new ((GFunc) gst_yadif_worker_func, NULL,
+        n_threads - 1, TRUE, &err);
+    if (yadif->pool) {
+      yadif->n_workers = n_threads - 1;
+    } else {
+      GST_WARNING_OBJECT (yadif, "Could not create thread pool: %s",
+          err->message);
+      g_clear_error (&err);
+    }
+  }
+  GST_DEBUG_OBJECT (yadif, "deinterlacing with up to %u threads",
+      yadif->n_workers + 1);
 
   return TRUE;
 }
@@ -287,11 +362,46 @@ gst_yadif_start (GstBaseTransform * trans)
 static gboolean
 gst_yadif_stop (GstBaseTransform * trans)
 {
+  GstYadif *yadif = GST_YADIF (trans);
+
+  if (yadif->pool) {
+    g_thread_pool_free (yadif->pool, FALSE, TRUE);
+    yadif->pool = NULL;
+  }
+  yadif->n_workers = 0;
 
   return TRUE;
 }
 
-void yadif_filter (GstYadif * yadif, int parity, int tff);
+static void
+gst_yadif_filter_slices (GstYadif * yadif, int parity, int tff)
+{
+  gint n_slices, i;
+
+  /* every slice should at least get a few lines of each field */
+  n_slices = MIN (yadif->n_workers + 1,
+      MAX (GST_VIDEO_INFO_HEIGHT (&yadif->video_info) / 16, 1));
+  if (n_slices == 1) {
+    yadif_filter (yadif, parity, tff);
+    return;
+  }
+
+  yadif->parity = parity;
+  yadif->tff = tff;
+  yadif->n_slices = n_slices;
+  yadif->workers_running = n_slices - 1;
+  g_atomic_int_set (&yadif->next_slice, 0);
+  for (i = 1; i < n_slices; i++)
+    g_thread_pool_push (yadif->pool, yadif, NULL);
+
+  gst_yadif_take_slices (yadif);
+
+  /* the workers may still be busy with the last slices */
+  g_mutex_lock (&yadif->workers_lock);
+  while (yadif->workers_running > 0)
+    g_cond_wait (&yadif->workers_cond, &yadif->workers_lock);
+  g_mutex_unlock (&yadif->workers_lock);
+}
 
 static GstFlowReturn
 gst_yadif_transform (GstBaseTransform * trans, GstBuffer * inbuf,
@@ -315,7 +425,7 @@ gst_yadif_transform (GstBaseTransform * trans, GstBuffer * inbuf,
   yadif->next_frame = yadif->cur_frame;
   yadif->prev_frame = yadif->cur_frame;
 
-  yadif_filter (yadif, parity, tff);
+  gst_yadif_filter_slices (yadif, parity, tff);
 
   gst_video_frame_unmap (&yadif->dest_frame);
   gst_video_frame_unmap (&yadif->cur_frame);
@@ -46,6 +46,7 @@ struct _GstYadif
   GstBaseTransform base_yadif;
 
   GstDeinterlaceMode mode;
+  guint n_threads;
 
   GstVideoInfo video_info;
 
@@ -53,6 +54,17 @@ struct _GstYadif
   GstVideoFrame cur_frame;
   GstVideoFrame next_frame;
   GstVideoFrame dest_frame;
+
+  /* slice threading, the slices of the current frame are taken in
+   * order through next_slice */
+  GThreadPool *pool;
+  guint n_workers;
+  gint parity, tff;
+  gint n_slices;
+  volatile gint next_slice;
+  guint workers_running;
+  GMutex workers_lock;
+  GCond workers_cond;
 };
 
 struct _GstYadifClass
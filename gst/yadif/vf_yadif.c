@@ -116,6 +116,8 @@ FILTER}
 #endif
 
 void yadif_filter (GstYadif * yadif, int parity, int tff);
+void yadif_filter_slice (GstYadif * yadif, int parity, int tff, int slice,
+    int n_slices);
 #ifdef HAVE_CPU_X86_64
 void filter_line_x86_64 (guint8 * dst,
     guint8 * prev, guint8 * cur, guint8 * next,
@@ -124,6 +126,17 @@ void filter_line_x86_64 (guint8 * dst,
 
 void
 yadif_filter (GstYadif * yadif, int parity, int tff)
+{
+  yadif_filter_slice (yadif, parity, tff, 0, 1);
+}
+
+/* Filters the lines [h * slice / n_slices, h * (slice + 1) / n_slices) of
+ * every plane. The lines above and below a slice are only read from the
+ * input frames, so slices can be done in parallel and give the same result
+ * as filtering the whole frame at once. */
+void
+yadif_filter_slice (GstYadif * yadif, int parity, int tff, int slice,
+    int n_slices)
 {
   int y, i;
   const GstVideoInfo *vi = &yadif->video_info;
@@ -138,8 +151,10 @@ yadif_filter (GstYadif * yadif, int parity, int tff)
     guint8 *cur_data = GST_VIDEO_FRAME_COMP_DATA (&yadif->cur_frame, i);
     guint8 *next_data = GST_VIDEO_FRAME_COMP_DATA (&yadif->next_frame, i);
     guint8 *dest_data = GST_VIDEO_FRAME_COMP_DATA (&yadif->dest_frame, i);
+    int y_start = (gint64) h * slice / n_slices;
+    int y_end = (gint64) h * (slice + 1) / n_slices;
 
-    for (y = 0; y < h; y++) {
+    for (y = y_start; y < y_end; y++) {
       if ((y ^ parity) & 1) {
         guint8 *prev = prev_data + y * refs;
         guint8 *cur = cur_data + y * refs;
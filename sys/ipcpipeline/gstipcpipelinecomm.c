@@ -24,11 +24,19 @@
 #  include "config.h"
 #endif
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* F_ADD_SEALS, F_GET_SEALS */
+#endif
+
 #include <unistd.h>
+#include <fcntl.h>
 #include <errno.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
 #include <gst/base/gstbytewriter.h>
 #include <gst/gstprotection.h>
+#include <gst/allocators/allocators.h>
 #include "gstipcpipelinecomm.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_ipc_pipeline_comm_debug);
@@ -36,6 +44,18 @@ GST_DEBUG_CATEGORY_STATIC (gst_ipc_pipeline_comm_debug);
 
 #define DEFAULT_ACK_TIME (10 * G_TIME_SPAN_SECOND)
 
+#define MAX_RECEIVED_FDS_PER_READ 16
+
+#ifdef MSG_CMSG_CLOEXEC
+#define RECVMSG_FLAGS MSG_CMSG_CLOEXEC
+#else
+#define RECVMSG_FLAGS 0
+#endif
+
+/* flags, maxsize, offset and size of the memory of a fd buffer */
+#define COMM_FD_MEMORY_INFO_SIZE (4 + 8 + 8 + 8)
+#define COMM_FD_MEMORY_FLAG_DMABUF (1 << 0)
+
 GQuark QUARK_ID;
 
 typedef enum
@@ -65,6 +85,24 @@ typedef struct
   GCond cond;
 } CommRequest;
 
+/* Lets the memories wrapping fds from the peer release them on the peer's
+ * side once they are freed. Shared with these memories, which can outlive
+ * the comm */
+struct _GstIpcPipelineCommReleases
+{
+  gint refcount;
+  GMutex lock;
+  /* the releases are written from the thread freeing the memories, NULL once
+   * the comm is cleared */
+  GstIpcPipelineComm *comm;
+};
+
+typedef struct
+{
+  GstIpcPipelineCommReleases *releases;
+  guint32 id;
+} CommReleaseData;
+
 static const gchar *comm_request_ret_get_name (CommRequestType type,
     guint32 ret);
 static guint32 comm_request_ret_get_failure_value (CommRequestType type);
@@ -128,6 +166,36 @@ comm_request_free (CommRequest * req)
   g_free (req);
 }
 
+static GstIpcPipelineCommReleases *
+comm_releases_new (GstIpcPipelineComm * comm)
+{
+  GstIpcPipelineCommReleases *releases;
+
+  releases = g_new0 (GstIpcPipelineCommReleases, 1);
+  releases->refcount = 1;
+  g_mutex_init (&releases->lock);
+  releases->comm = comm;
+
+  return releases;
+}
+
+static GstIpcPipelineCommReleases *
+comm_releases_ref (GstIpcPipelineCommReleases * releases)
+{
+  g_atomic_int_inc (&releases->refcount);
+  return releases;
+}
+
+static void
+comm_releases_unref (GstIpcPipelineCommReleases * releases)
+{
+  if (!g_atomic_int_dec_and_test (&releases->refcount))
+    return;
+
+  g_mutex_clear (&releases->lock);
+  g_free (releases);
+}
+
 static const gchar *
 comm_request_ret_get_name (CommRequestType type, guint32 ret)
 {
@@ -186,6 +254,10 @@ gst_ipc_pipeline_comm_data_type_get_name (GstIpcPipelineCommDataType type)
       return "MESSAGE";
     case GST_IPC_PIPELINE_COMM_DATA_TYPE_GERROR_MESSAGE:
       return "GERROR_MESSAGE";
+    case GST_IPC_PIPELINE_COMM_DATA_TYPE_FD_BUFFER:
+      return "FD_BUFFER";
+    case GST_IPC_PIPELINE_COMM_DATA_TYPE_RELEASE:
+      return "RELEASE";
     default:
       return "UNKNOWN";
   }
@@ -255,6 +327,222 @@ write_byte_writer_to_fd (GstIpcPipelineComm * comm, GstByteWriter * bw)
   return ret;
 }
 
+/* Tells the peer that the buffer it passed as an fd is not used here anymore.
+ * Takes the comm mutex, so must not be called with it held */
+static void
+comm_releases_push (GstIpcPipelineCommReleases * releases, guint32 id)
+{
+  GstIpcPipelineComm *comm;
+  const unsigned char payload_type = GST_IPC_PIPELINE_COMM_DATA_TYPE_RELEASE;
+  GstByteWriter bw;
+
+  /* the lock keeps the comm from being cleared while writing */
+  g_mutex_lock (&releases->lock);
+  comm = releases->comm;
+  if (!comm)
+    goto done;
+
+  g_mutex_lock (&comm->mutex);
+
+  gst_byte_writer_init (&bw);
+  if (comm->fdout < 0) {
+    GST_DEBUG_OBJECT (comm->element, "Not connected, dropping release of %u",
+        id);
+    goto unlock;
+  }
+
+  GST_TRACE_OBJECT (comm->element, "Writing release of buffer %u", id);
+  if (!gst_byte_writer_put_uint8 (&bw, payload_type))
+    goto write_failed;
+  if (!gst_byte_writer_put_uint32_le (&bw, 0))
+    goto write_failed;
+  if (!gst_byte_writer_put_uint32_le (&bw, sizeof (guint32)))
+    goto write_failed;
+  if (!gst_byte_writer_put_uint32_le (&bw, id))
+    goto write_failed;
+
+  if (!write_byte_writer_to_fd (comm, &bw))
+    goto write_failed;
+
+unlock:
+  g_mutex_unlock (&comm->mutex);
+  gst_byte_writer_reset (&bw);
+done:
+  g_mutex_unlock (&releases->lock);
+  return;
+
+write_failed:
+  GST_ELEMENT_ERROR (comm->element, RESOURCE, WRITE, (NULL),
+      ("Failed to write to socket"));
+  goto unlock;
+}
+
+static void
+comm_release_data_free (gpointer data, GstMiniObject * obj)
+{
+  CommReleaseData *release = data;
+
+  comm_releases_push (release->releases, release->id);
+  comm_releases_unref (release->releases);
+  g_slice_free (CommReleaseData, release);
+}
+
+static gboolean
+fd_is_socket (int fd)
+{
+  struct stat st;
+
+  return fd >= 0 && fstat (fd, &st) == 0 && S_ISSOCK (st.st_mode);
+}
+
+/* The peer maps a passed memfd, it would crash accessing the mapping if the
+ * file was shrunk afterwards, so it only accepts memfds sealed against it */
+static gboolean
+fd_seal_size (int fd)
+{
+#ifdef F_ADD_SEALS
+  int seals;
+
+  seals = fcntl (fd, F_GET_SEALS);
+  if (seals < 0)
+    return FALSE;
+  if ((seals & (F_SEAL_SHRINK | F_SEAL_GROW)) == (F_SEAL_SHRINK | F_SEAL_GROW))
+    return TRUE;
+
+  return fcntl (fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) == 0;
+#else
+  return FALSE;
+#endif
+}
+
+static gboolean
+fd_is_sealed_against_shrinking (int fd)
+{
+#ifdef F_GET_SEALS
+  int seals;
+
+  seals = fcntl (fd, F_GET_SEALS);
+  return seals >= 0 && (seals & F_SEAL_SHRINK);
+#else
+  return FALSE;
+#endif
+}
+
+/* Sends @fd along with the first bytes of the data */
+static gboolean
+write_byte_writer_with_fd_to_fd (GstIpcPipelineComm * comm,
+    GstByteWriter * bw, int fd)
+{
+  struct msghdr msg = { 0, };
+  struct iovec iov;
+  struct cmsghdr *cmsg;
+  union
+  {
+    struct cmsghdr hdr;
+    char buf[CMSG_SPACE (sizeof (int))];
+  } control;
+  guint8 *data;
+  gboolean ret;
+  ssize_t written;
+  guint size;
+
+  size = gst_byte_writer_get_size (bw);
+  data = gst_byte_writer_reset_and_get_data (bw);
+  if (!data)
+    return FALSE;
+
+  iov.iov_base = data;
+  iov.iov_len = size;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof (control.buf);
+  cmsg = CMSG_FIRSTHDR (&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN (sizeof (int));
+  memcpy (CMSG_DATA (cmsg), &fd, sizeof (int));
+
+  GST_TRACE_OBJECT (comm->element, "Writing %u bytes and fd %d to fdout", size,
+      fd);
+  do {
+    written = sendmsg (comm->fdout, &msg, 0);
+  } while (written < 0 && (errno == EAGAIN || errno == EINTR));
+
+  if (written < 0) {
+    GST_ERROR_OBJECT (comm->element, "Failed to send fd: %s",
+        strerror (errno));
+    ret = FALSE;
+  } else {
+    ret = write_to_fd_raw (comm, data + written, size - written);
+  }
+
+  g_free (data);
+  return ret;
+}
+
+/* Must be called with the mutex held */
+static void
+gst_ipc_pipeline_comm_forget_buffers_in_flight (GstIpcPipelineComm * comm)
+{
+  guint32 id;
+
+  while (!g_queue_is_empty (&comm->buffers_in_flight)) {
+    id = GPOINTER_TO_UINT (g_queue_pop_head (&comm->buffers_in_flight));
+    g_hash_table_remove (comm->waiting_ids, GINT_TO_POINTER (id));
+  }
+  comm->in_flight_ret = GST_FLOW_OK;
+}
+
+/* With more than one buffer in flight, the ack of a buffer is only waited
+ * for once the window is full, and flow returns other than OK are returned
+ * for the buffers written after it. Must be called with the mutex held */
+static GstFlowReturn
+gst_ipc_pipeline_comm_queue_buffer_ack (GstIpcPipelineComm * comm, guint32 id)
+{
+  GHashTable *waiting_ids;
+  CommRequest *req;
+  GstFlowReturn ret;
+  guint32 oldest, ret32;
+
+  req = comm_request_new (id, COMM_REQUEST_TYPE_BUFFER, NULL);
+  g_hash_table_insert (comm->waiting_ids, GINT_TO_POINTER (id), req);
+  g_queue_push_tail (&comm->buffers_in_flight, GUINT_TO_POINTER (id));
+
+  while (!g_queue_is_empty (&comm->buffers_in_flight)) {
+    oldest = GPOINTER_TO_UINT (g_queue_peek_head (&comm->buffers_in_flight));
+    waiting_ids = g_hash_table_ref (comm->waiting_ids);
+    req = g_hash_table_lookup (waiting_ids, GINT_TO_POINTER (oldest));
+
+    if (req && !req->replied &&
+        g_queue_get_length (&comm->buffers_in_flight) <
+        comm->max_buffers_in_flight) {
+      g_hash_table_unref (waiting_ids);
+      break;
+    }
+
+    if (req) {
+      ret32 = comm_request_wait (comm, req, ACK_TYPE_BLOCKING);
+      g_hash_table_remove (waiting_ids, GINT_TO_POINTER (oldest));
+    } else {
+      ret32 = GST_FLOW_FLUSHING;
+    }
+    g_hash_table_unref (waiting_ids);
+
+    /* the queue may have been reset while waiting */
+    if (GPOINTER_TO_UINT (g_queue_peek_head (&comm->buffers_in_flight)) ==
+        oldest)
+      g_queue_pop_head (&comm->buffers_in_flight);
+
+    if (ret32 != GST_FLOW_OK && comm->in_flight_ret == GST_FLOW_OK)
+      comm->in_flight_ret = ret32;
+  }
+
+  ret = comm->in_flight_ret;
+  comm->in_flight_ret = GST_FLOW_OK;
+  return ret;
+}
+
 static void
 gst_ipc_pipeline_comm_write_ack_to_fd (GstIpcPipelineComm * comm, guint32 id,
     guint32 ret, CommRequestType type)
@@ -496,11 +784,37 @@ typedef struct
   guint64 flags;
 } CommBufferMetadata;
 
+/* Returns the memory of @buffer if it can be sent to the peer as a file
+ * descriptor instead of being copied to the socket */
+static GstMemory *
+gst_ipc_pipeline_comm_get_fd_memory (GstIpcPipelineComm * comm,
+    GstBuffer * buffer)
+{
+  GstMemory *mem;
+
+  if (!comm->fd_passing || gst_buffer_n_memory (buffer) != 1)
+    return NULL;
+
+  mem = gst_buffer_peek_memory (buffer, 0);
+  if (!gst_is_fd_memory (mem) || !fd_is_socket (comm->fdout))
+    return NULL;
+
+  /* anything else than a memfd which can be sealed is copied */
+  if (!gst_is_dmabuf_memory (mem)
+      && !fd_seal_size (gst_fd_memory_get_fd (mem))) {
+    GST_LOG_OBJECT (comm->element, "Copying buffer, its fd can't be sealed");
+    return NULL;
+  }
+
+  return mem;
+}
+
 GstFlowReturn
 gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
     GstBuffer * buffer)
 {
-  const unsigned char payload_type = GST_IPC_PIPELINE_COMM_DATA_TYPE_BUFFER;
+  unsigned char payload_type = GST_IPC_PIPELINE_COMM_DATA_TYPE_BUFFER;
+  GstMemory *fd_mem;
   GstMapInfo map;
   guint32 ret32 = GST_FLOW_OK;
   guint32 size, n;
@@ -527,29 +841,58 @@ gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
   /* work out meta size */
   gst_buffer_foreach_meta (buffer, build_meta, &repr);
 
+  fd_mem = gst_ipc_pipeline_comm_get_fd_memory (comm, buffer);
+  if (fd_mem) {
+    payload_type = GST_IPC_PIPELINE_COMM_DATA_TYPE_FD_BUFFER;
+    size = COMM_FD_MEMORY_INFO_SIZE;
+  } else {
+    size = sizeof (guint32) + gst_buffer_get_size (buffer);
+  }
+
   if (!gst_byte_writer_put_uint8 (&bw, payload_type))
     goto write_failed;
   if (!gst_byte_writer_put_uint32_le (&bw, comm->send_id))
     goto write_failed;
-  size =
-      gst_buffer_get_size (buffer) + sizeof (guint32) +
-      sizeof (CommBufferMetadata) + repr.total_bytes;
+  size += sizeof (CommBufferMetadata) + repr.total_bytes;
   if (!gst_byte_writer_put_uint32_le (&bw, size))
     goto write_failed;
   if (!gst_byte_writer_put_data (&bw, (const guint8 *) &meta, sizeof (meta)))
     goto write_failed;
-  size = gst_buffer_get_size (buffer);
-  if (!gst_byte_writer_put_uint32_le (&bw, size))
-    goto write_failed;
-  if (!write_byte_writer_to_fd (comm, &bw))
-    goto write_failed;
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
-    goto map_failed;
-  ret = write_to_fd_raw (comm, map.data, map.size);
-  gst_buffer_unmap (buffer, &map);
-  if (!ret)
-    goto write_failed;
+  if (fd_mem) {
+    gsize offset, maxsize, msize;
+
+    msize = gst_memory_get_sizes (fd_mem, &offset, &maxsize);
+    if (!gst_byte_writer_put_uint32_le (&bw, gst_is_dmabuf_memory (fd_mem) ?
+            COMM_FD_MEMORY_FLAG_DMABUF : 0))
+      goto write_failed;
+    if (!gst_byte_writer_put_uint64_le (&bw, maxsize))
+      goto write_failed;
+    if (!gst_byte_writer_put_uint64_le (&bw, offset))
+      goto write_failed;
+    if (!gst_byte_writer_put_uint64_le (&bw, msize))
+      goto write_failed;
+    if (!write_byte_writer_with_fd_to_fd (comm, &bw,
+            gst_fd_memory_get_fd (fd_mem)))
+      goto write_failed;
+
+    /* the peer maps the same memory, keep it until the peer releases it */
+    g_hash_table_insert (comm->sent_buffers, GINT_TO_POINTER (comm->send_id),
+        gst_buffer_ref (buffer));
+  } else {
+    size = gst_buffer_get_size (buffer);
+    if (!gst_byte_writer_put_uint32_le (&bw, size))
+      goto write_failed;
+    if (!write_byte_writer_to_fd (comm, &bw))
+      goto write_failed;
+
+    if (!gst_buffer_map (buffer, &map, GST_MAP_READ))
+      goto map_failed;
+    ret = write_to_fd_raw (comm, map.data, map.size);
+    gst_buffer_unmap (buffer, &map);
+    if (!ret)
+      goto write_failed;
+  }
 
   /* meta */
   gst_byte_writer_init (&bw);
@@ -588,10 +931,14 @@ gst_ipc_pipeline_comm_write_buffer_to_fd (GstIpcPipelineComm * comm,
   if (!write_byte_writer_to_fd (comm, &bw))
     goto write_failed;
 
-  if (!gst_ipc_pipeline_comm_sync_fd (comm, comm->send_id, NULL, &ret32,
-          ACK_TYPE_BLOCKING, COMM_REQUEST_TYPE_BUFFER))
-    goto wait_failed;
-  ret = ret32;
+  if (comm->max_buffers_in_flight > 1) {
+    ret = gst_ipc_pipeline_comm_queue_buffer_ack (comm, comm->send_id);
+  } else {
+    if (!gst_ipc_pipeline_comm_sync_fd (comm, comm->send_id, NULL, &ret32,
+            ACK_TYPE_BLOCKING, COMM_REQUEST_TYPE_BUFFER))
+      goto wait_failed;
+    ret = ret32;
+  }
 
 done:
   g_mutex_unlock (&comm->mutex);
@@ -620,31 +967,113 @@ map_failed:
   goto done;
 }
 
+/* Wraps the next fd received from the peer, the peer is told to release
+ * its buffer once the memory is freed */
 static GstBuffer *
-gst_ipc_pipeline_comm_read_buffer (GstIpcPipelineComm * comm, guint32 size)
+gst_ipc_pipeline_comm_wrap_received_fd (GstIpcPipelineComm * comm,
+    guint32 flags, guint64 maxsize, guint64 offset, guint64 size)
+{
+  CommReleaseData *release;
+  GstBuffer *buffer;
+  GstMemory *mem;
+  struct stat st;
+  gint fd;
+
+  if (g_queue_is_empty (&comm->received_fds)) {
+    GST_ERROR_OBJECT (comm->element, "No fd received for buffer %u", comm->id);
+    return NULL;
+  }
+  fd = GPOINTER_TO_INT (g_queue_pop_head (&comm->received_fds));
+
+  if (offset > maxsize || size > maxsize - offset)
+    goto invalid;
+
+  if (flags & COMM_FD_MEMORY_FLAG_DMABUF) {
+    mem = gst_dmabuf_allocator_alloc (comm->dmabuf_allocator, fd, maxsize);
+  } else {
+    /* accessing a mapping beyond the end of the file would crash */
+    if (fstat (fd, &st) < 0 || (guint64) st.st_size < maxsize)
+      goto invalid;
+    if (!fd_is_sealed_against_shrinking (fd)) {
+      GST_ERROR_OBJECT (comm->element, "fd %d of buffer %u is not sealed", fd,
+          comm->id);
+      goto invalid;
+    }
+    mem = gst_fd_allocator_alloc (comm->fd_allocator, fd, maxsize,
+        GST_FD_MEMORY_FLAG_NONE);
+  }
+  if (!mem)
+    goto invalid;
+  gst_memory_resize (mem, offset, size);
+
+  /* the peer still holds this memory, it may be pooled or shared over there,
+   * so writers have to make a copy */
+  GST_MINI_OBJECT_FLAG_SET (mem, GST_MEMORY_FLAG_READONLY);
+
+  release = g_slice_new (CommReleaseData);
+  release->releases = comm_releases_ref (comm->releases);
+  release->id = comm->id;
+  gst_mini_object_weak_ref (GST_MINI_OBJECT_CAST (mem), comm_release_data_free,
+      release);
+
+  GST_TRACE_OBJECT (comm->element, "Wrapped fd %d for buffer %u", fd,
+      comm->id);
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, mem);
+  return buffer;
+
+invalid:
+  GST_ERROR_OBJECT (comm->element, "Invalid fd memory for buffer %u: size %"
+      G_GUINT64_FORMAT ", offset %" G_GUINT64_FORMAT ", maxsize %"
+      G_GUINT64_FORMAT, comm->id, size, offset, maxsize);
+  close (fd);
+  comm_releases_push (comm->releases, comm->id);
+  return NULL;
+}
+
+static GstBuffer *
+gst_ipc_pipeline_comm_read_buffer (GstIpcPipelineComm * comm, guint32 size,
+    gboolean has_fd)
 {
   GstBuffer *buffer;
   CommBufferMetadata meta;
   guint32 n_meta, n;
   const guint8 *payload = NULL;
-  guint32 mapped_size, buffer_data_size;
+  guint32 mapped_size, buffer_data_size = 0;
+  guint32 fd_flags = 0;
+  guint64 fd_maxsize = 0, fd_offset = 0, fd_size = 0;
+
+  mapped_size = sizeof (CommBufferMetadata) +
+      (has_fd ? COMM_FD_MEMORY_INFO_SIZE : sizeof (buffer_data_size));
 
   /* this should not be called if we don't have enough yet */
   g_return_val_if_fail (gst_adapter_available (comm->adapter) >= size, NULL);
-  g_return_val_if_fail (size >= sizeof (CommBufferMetadata), NULL);
+  g_return_val_if_fail (size >= mapped_size, NULL);
 
-  mapped_size = sizeof (CommBufferMetadata) + sizeof (buffer_data_size);
   payload = gst_adapter_map (comm->adapter, mapped_size);
   if (!payload)
     return NULL;
   memcpy (&meta, payload, sizeof (CommBufferMetadata));
   payload += sizeof (CommBufferMetadata);
-  memcpy (&buffer_data_size, payload, sizeof (buffer_data_size));
+  if (has_fd) {
+    memcpy (&fd_flags, payload, sizeof (fd_flags));
+    memcpy (&fd_maxsize, payload + 4, sizeof (fd_maxsize));
+    memcpy (&fd_offset, payload + 12, sizeof (fd_offset));
+    memcpy (&fd_size, payload + 20, sizeof (fd_size));
+  } else {
+    memcpy (&buffer_data_size, payload, sizeof (buffer_data_size));
+  }
   size -= mapped_size;
   gst_adapter_unmap (comm->adapter);
   gst_adapter_flush (comm->adapter, mapped_size);
 
-  if (buffer_data_size == 0) {
+  if (has_fd) {
+    buffer = gst_ipc_pipeline_comm_wrap_received_fd (comm, fd_flags,
+        fd_maxsize, fd_offset, fd_size);
+    if (!buffer)
+      return NULL;
+  } else if (buffer_data_size == 0) {
     buffer = gst_buffer_new ();
   } else {
     buffer = gst_adapter_get_buffer (comm->adapter, buffer_data_size);
@@ -1607,11 +2036,36 @@ gst_ipc_pipeline_comm_init (GstIpcPipelineComm * comm, GstElement * element)
   comm->adapter = gst_adapter_new ();
   comm->poll = gst_poll_new (TRUE);
   gst_poll_fd_init (&comm->pollFDin);
+
+  g_queue_init (&comm->received_fds);
+  comm->sent_buffers =
+      g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
+      (GDestroyNotify) gst_buffer_unref);
+  comm->releases = comm_releases_new (comm);
+  comm->fd_allocator = gst_fd_allocator_new ();
+  comm->dmabuf_allocator = gst_dmabuf_allocator_new ();
+
+  comm->max_buffers_in_flight = 1;
+  g_queue_init (&comm->buffers_in_flight);
+  comm->in_flight_ret = GST_FLOW_OK;
 }
 
 void
 gst_ipc_pipeline_comm_clear (GstIpcPipelineComm * comm)
 {
+  /* memories still using fds from the peer will not release them anymore */
+  g_mutex_lock (&comm->releases->lock);
+  comm->releases->comm = NULL;
+  g_mutex_unlock (&comm->releases->lock);
+  comm_releases_unref (comm->releases);
+
+  while (!g_queue_is_empty (&comm->received_fds))
+    close (GPOINTER_TO_INT (g_queue_pop_head (&comm->received_fds)));
+  g_hash_table_destroy (comm->sent_buffers);
+  g_queue_clear (&comm->buffers_in_flight);
+  gst_object_unref (comm->fd_allocator);
+  gst_object_unref (comm->dmabuf_allocator);
+
   g_hash_table_destroy (comm->waiting_ids);
   gst_object_unref (comm->adapter);
   gst_poll_free (comm->poll);
@@ -1652,10 +2106,35 @@ gst_ipc_pipeline_comm_cancel (GstIpcPipelineComm * comm, gboolean cleanup)
     comm->waiting_ids =
         g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL,
         (GDestroyNotify) comm_request_free);
+    g_queue_clear (&comm->buffers_in_flight);
+    comm->in_flight_ret = GST_FLOW_OK;
+    g_hash_table_remove_all (comm->sent_buffers);
   }
   g_mutex_unlock (&comm->mutex);
 }
 
+/* Forgets about the buffers whose ack was not waited for yet, so that they
+ * don't affect the flow return of buffers after a flush */
+void
+gst_ipc_pipeline_comm_reset_buffers_in_flight (GstIpcPipelineComm * comm)
+{
+  g_mutex_lock (&comm->mutex);
+  gst_ipc_pipeline_comm_forget_buffers_in_flight (comm);
+  g_mutex_unlock (&comm->mutex);
+}
+
+gboolean
+gst_ipc_pipeline_comm_can_pass_fds (GstIpcPipelineComm * comm)
+{
+  gboolean ret;
+
+  g_mutex_lock (&comm->mutex);
+  ret = comm->fd_passing && fd_is_socket (comm->fdout);
+  g_mutex_unlock (&comm->mutex);
+
+  return ret;
+}
+
 static gboolean
 set_field (GQuark field_id, const GValue * value, gpointer user_data)
 {
@@ -1699,6 +2178,82 @@ gst_ipc_pipeline_comm_reply_request (GstIpcPipelineComm * comm, guint32 id,
   return TRUE;
 }
 
+static gboolean
+gst_ipc_pipeline_comm_read_release (GstIpcPipelineComm * comm, guint32 size)
+{
+  const guint8 *payload;
+  guint32 id, n;
+
+  if (size % sizeof (id))
+    return FALSE;
+  if (size == 0)
+    return TRUE;
+
+  payload = gst_adapter_map (comm->adapter, size);
+  if (!payload)
+    return FALSE;
+
+  g_mutex_lock (&comm->mutex);
+  for (n = 0; n < size / sizeof (id); n++) {
+    memcpy (&id, payload + n * sizeof (id), sizeof (id));
+    GST_TRACE_OBJECT (comm->element, "Peer released buffer %u", id);
+    if (!g_hash_table_remove (comm->sent_buffers, GINT_TO_POINTER (id)))
+      GST_DEBUG_OBJECT (comm->element, "Release of unknown buffer %u", id);
+  }
+  g_mutex_unlock (&comm->mutex);
+
+  gst_adapter_unmap (comm->adapter);
+  gst_adapter_flush (comm->adapter, size);
+  return TRUE;
+}
+
+/* Reads from fdin, keeping the fds the peer sends along with the data */
+static ssize_t
+read_from_fd (GstIpcPipelineComm * comm, void *data, size_t size)
+{
+  struct msghdr msg = { 0, };
+  struct iovec iov;
+  struct cmsghdr *cmsg;
+  union
+  {
+    struct cmsghdr hdr;
+    char buf[CMSG_SPACE (sizeof (int) * MAX_RECEIVED_FDS_PER_READ)];
+  } control;
+  ssize_t sz;
+  gint fd;
+  guint n;
+
+  if (!comm->fdin_is_socket)
+    return read (comm->pollFDin.fd, data, size);
+
+  iov.iov_base = data;
+  iov.iov_len = size;
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof (control.buf);
+
+  sz = recvmsg (comm->pollFDin.fd, &msg, RECVMSG_FLAGS);
+  if (sz <= 0)
+    return sz;
+
+  for (cmsg = CMSG_FIRSTHDR (&msg); cmsg; cmsg = CMSG_NXTHDR (&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS)
+      continue;
+
+    for (n = 0; n < (cmsg->cmsg_len - CMSG_LEN (0)) / sizeof (int); n++) {
+      memcpy (&fd, CMSG_DATA (cmsg) + n * sizeof (int), sizeof (int));
+      GST_TRACE_OBJECT (comm->element, "Received fd %d", fd);
+      g_queue_push_tail (&comm->received_fds, GINT_TO_POINTER (fd));
+    }
+  }
+
+  if (msg.msg_flags & MSG_CTRUNC)
+    GST_WARNING_OBJECT (comm->element, "Some fds sent by the peer were lost");
+
+  return sz;
+}
+
 static gint
 update_adapter (GstIpcPipelineComm * comm)
 {
@@ -1724,6 +2279,7 @@ again:
     if (comm->fdin != -1 && GST_OBJECT_PARENT (comm->element)) {
       GST_DEBUG_OBJECT (comm->element, "Start watching fd %d", comm->fdin);
       comm->pollFDin.fd = comm->fdin;
+      comm->fdin_is_socket = fd_is_socket (comm->fdin);
       gst_poll_add_fd (comm->poll, &comm->pollFDin);
       gst_poll_fd_ctl_read (comm->poll, &comm->pollFDin, TRUE);
     }
@@ -1745,7 +2301,7 @@ again:
       mem = gst_allocator_alloc (NULL, comm->read_chunk_size, NULL);
 
     gst_memory_map (mem, &map, GST_MAP_WRITE);
-    sz = read (comm->pollFDin.fd, map.data, map.size);
+    sz = read_from_fd (comm, map.data, map.size);
     gst_memory_unmap (mem, &map);
 
     if (sz <= 0) {
@@ -1810,6 +2366,8 @@ read_many (GstIpcPipelineComm * comm)
           case GST_IPC_PIPELINE_COMM_DATA_TYPE_STATE_LOST:
           case GST_IPC_PIPELINE_COMM_DATA_TYPE_MESSAGE:
           case GST_IPC_PIPELINE_COMM_DATA_TYPE_GERROR_MESSAGE:
+          case GST_IPC_PIPELINE_COMM_DATA_TYPE_FD_BUFFER:
+          case GST_IPC_PIPELINE_COMM_DATA_TYPE_RELEASE:
             GST_TRACE_OBJECT (comm->element, "switching to state %s",
                 gst_ipc_pipeline_comm_data_type_get_name (type));
             comm->state = type;
@@ -1874,6 +2432,7 @@ read_many (GstIpcPipelineComm * comm)
         break;
       }
       case GST_IPC_PIPELINE_COMM_DATA_TYPE_BUFFER:
+      case GST_IPC_PIPELINE_COMM_DATA_TYPE_FD_BUFFER:
       {
         GstBuffer *buf;
 
@@ -1881,7 +2440,8 @@ read_many (GstIpcPipelineComm * comm)
         if (available < comm->payload_length)
           goto done;
 
-        buf = gst_ipc_pipeline_comm_read_buffer (comm, comm->payload_length);
+        buf = gst_ipc_pipeline_comm_read_buffer (comm, comm->payload_length,
+            comm->state == GST_IPC_PIPELINE_COMM_DATA_TYPE_FD_BUFFER);
         if (!buf)
           goto buffer_failed;
 
@@ -2075,6 +2635,19 @@ read_many (GstIpcPipelineComm * comm)
         comm->state = GST_IPC_PIPELINE_COMM_STATE_TYPE;
         break;
       }
+      case GST_IPC_PIPELINE_COMM_DATA_TYPE_RELEASE:
+      {
+        available = gst_adapter_available (comm->adapter);
+        if (available < comm->payload_length)
+          goto done;
+
+        if (!gst_ipc_pipeline_comm_read_release (comm, comm->payload_length))
+          goto release_failed;
+
+        GST_TRACE_OBJECT (comm->element, "switching to state TYPE");
+        comm->state = GST_IPC_PIPELINE_COMM_STATE_TYPE;
+        break;
+      }
     }
 
 done:
@@ -2130,6 +2703,13 @@ query_failed:
     ret = FALSE;
     goto done;
   }
+release_failed:
+  {
+    GST_ELEMENT_ERROR (comm->element, STREAM, DECODE, (NULL),
+        ("could not read buffer release from fd"));
+    ret = FALSE;
+    goto done;
+  }
 }
 
 static gpointer
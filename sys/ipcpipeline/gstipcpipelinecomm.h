@@ -51,8 +51,12 @@ typedef enum {
   GST_IPC_PIPELINE_COMM_DATA_TYPE_STATE_LOST,
   GST_IPC_PIPELINE_COMM_DATA_TYPE_MESSAGE,
   GST_IPC_PIPELINE_COMM_DATA_TYPE_GERROR_MESSAGE,
+  GST_IPC_PIPELINE_COMM_DATA_TYPE_FD_BUFFER,
+  GST_IPC_PIPELINE_COMM_DATA_TYPE_RELEASE,
 } GstIpcPipelineCommDataType;
 
+typedef struct _GstIpcPipelineCommReleases GstIpcPipelineCommReleases;
+
 typedef struct
 {
   GstElement *element;
@@ -76,6 +80,20 @@ typedef struct
   guint read_chunk_size;
   GstClockTime ack_time;
 
+  /* file descriptor passing */
+  gboolean fd_passing;
+  gboolean fdin_is_socket;
+  GQueue received_fds;
+  GHashTable *sent_buffers;
+  GstIpcPipelineCommReleases *releases;
+  GstAllocator *fd_allocator;
+  GstAllocator *dmabuf_allocator;
+
+  /* asynchronous buffer acks */
+  guint max_buffers_in_flight;
+  GQueue buffers_in_flight;
+  GstFlowReturn in_flight_ret;
+
   void (*on_buffer) (guint32, GstBuffer *, gpointer);
   void (*on_event) (guint32, GstEvent *, gboolean, gpointer);
   void (*on_query) (guint32, GstQuery *, gboolean, gpointer);
@@ -92,6 +110,8 @@ void gst_ipc_pipeline_comm_init (GstIpcPipelineComm *comm, GstElement *e);
 void gst_ipc_pipeline_comm_clear (GstIpcPipelineComm *comm);
 void gst_ipc_pipeline_comm_cancel (GstIpcPipelineComm * comm,
     gboolean flushing);
+void gst_ipc_pipeline_comm_reset_buffers_in_flight (GstIpcPipelineComm * comm);
+gboolean gst_ipc_pipeline_comm_can_pass_fds (GstIpcPipelineComm * comm);
 
 void gst_ipc_pipeline_comm_write_flow_ack_to_fd (GstIpcPipelineComm * comm,
     guint32 id, GstFlowReturn ret);
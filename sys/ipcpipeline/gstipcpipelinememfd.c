@@ -0,0 +1,124 @@
+/* GStreamer
+ *
+ * gstipcpipelinememfd.c:
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE             /* memfd_create */
+#endif
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include "gstipcpipelinememfd.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_ipc_pipeline_memfd_debug);
+#define GST_CAT_DEFAULT gst_ipc_pipeline_memfd_debug
+
+#define gst_ipc_pipeline_memfd_allocator_parent_class parent_class
+G_DEFINE_TYPE (GstIpcPipelineMemfdAllocator, gst_ipc_pipeline_memfd_allocator,
+    GST_TYPE_FD_ALLOCATOR);
+
+static GstMemory *
+gst_ipc_pipeline_memfd_allocator_alloc (GstAllocator * allocator, gsize size,
+    GstAllocationParams * params)
+{
+#ifdef HAVE_MEMFD_CREATE
+  GstMemory *mem;
+  gsize offset, maxsize;
+  gint fd;
+
+  /* the mapping is page aligned, so only the prefix can misalign the data */
+  offset = (params->prefix + params->align) & ~params->align;
+  maxsize = offset + size + params->padding;
+
+  fd = memfd_create ("ipcpipeline", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    GST_WARNING_OBJECT (allocator, "memfd_create failed: %s",
+        g_strerror (errno));
+    return NULL;
+  }
+
+  if (ftruncate (fd, maxsize) < 0) {
+    GST_WARNING_OBJECT (allocator, "Failed to resize memfd to %"
+        G_GSIZE_FORMAT " bytes: %s", maxsize, g_strerror (errno));
+    close (fd);
+    return NULL;
+  }
+
+  /* the peer refuses memfds which could be resized under its mapping */
+  if (fcntl (fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW) < 0) {
+    GST_WARNING_OBJECT (allocator, "Failed to seal memfd: %s",
+        g_strerror (errno));
+    close (fd);
+    return NULL;
+  }
+
+  mem = gst_fd_allocator_alloc (allocator, fd, maxsize,
+      GST_FD_MEMORY_FLAG_NONE);
+  if (!mem) {
+    close (fd);
+    return NULL;
+  }
+  gst_memory_resize (mem, offset, size);
+
+  GST_LOG_OBJECT (allocator, "Allocated memfd %d of %" G_GSIZE_FORMAT
+      " bytes", fd, maxsize);
+
+  return mem;
+#else
+  GST_WARNING_OBJECT (allocator, "memfd_create is not available");
+  return NULL;
+#endif
+}
+
+static void
+gst_ipc_pipeline_memfd_allocator_class_init (GstIpcPipelineMemfdAllocatorClass
+    * klass)
+{
+  GstAllocatorClass *allocator_class = GST_ALLOCATOR_CLASS (klass);
+
+  allocator_class->alloc = gst_ipc_pipeline_memfd_allocator_alloc;
+
+  GST_DEBUG_CATEGORY_INIT (gst_ipc_pipeline_memfd_debug, "ipcpipelinememfd",
+      0, "ipcpipeline memfd allocator");
+}
+
+static void
+gst_ipc_pipeline_memfd_allocator_init (GstIpcPipelineMemfdAllocator * self)
+{
+  /* GstFdAllocator only wraps existing fds, we can allocate new ones */
+  GST_OBJECT_FLAG_UNSET (self, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
+}
+
+GstAllocator *
+gst_ipc_pipeline_memfd_allocator_new (void)
+{
+  GstAllocator *allocator;
+
+  allocator = g_object_new (GST_TYPE_IPC_PIPELINE_MEMFD_ALLOCATOR, NULL);
+  gst_object_ref_sink (allocator);
+
+  return allocator;
+}
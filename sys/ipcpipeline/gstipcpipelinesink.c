@@ -66,7 +66,16 @@
  * GError are serialized differently).
  *
  * Buffers are transported by writing their content directly on the socket.
- * More efficient ways for memory sharing could be implemented in the future.
+ * When #GstIpcPipelineSink:fd-passing is enabled and the socket is a unix
+ * domain socket, buffers made of a single memfd or dmabuf backed memory are
+ * instead passed as file descriptors, which the peer maps without copying
+ * the data. Upstream is then offered to allocate its buffers from memfds.
+ * Such buffers are kept alive until the peer does not use them anymore.
+ *
+ * By default, each buffer waits for the peer to push it and return its flow
+ * return. #GstIpcPipelineSink:max-buffers-in-flight lets more buffers be sent
+ * before waiting, in which case a flow return other than %GST_FLOW_OK is only
+ * returned for a later buffer.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -74,6 +83,7 @@
 #endif
 
 #include "gstipcpipelinesink.h"
+#include "gstipcpipelinememfd.h"
 
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
     GST_PAD_SINK,
@@ -98,11 +108,15 @@ enum
   PROP_FDOUT,
   PROP_READ_CHUNK_SIZE,
   PROP_ACK_TIME,
+  PROP_FD_PASSING,
+  PROP_MAX_BUFFERS_IN_FLIGHT,
 };
 
 
 #define DEFAULT_READ_CHUNK_SIZE 4096
 #define DEFAULT_ACK_TIME (10 * G_TIME_SPAN_SECOND)
+#define DEFAULT_FD_PASSING FALSE
+#define DEFAULT_MAX_BUFFERS_IN_FLIGHT 1
 
 #define _do_init \
     GST_DEBUG_CATEGORY_INIT (gst_ipc_pipeline_sink_debug, "ipcpipelinesink", 0, "ipcpipelinesink element");
@@ -174,6 +188,36 @@ gst_ipc_pipeline_sink_class_init (GstIpcPipelineSinkClass * klass)
           "Maximum time to wait for a response to a message",
           0, G_MAXUINT64, DEFAULT_ACK_TIME,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstIpcPipelineSink:fd-passing:
+   *
+   * Pass buffers backed by a memfd or dmabuf to the peer as file descriptors
+   * instead of copying their data to the socket. This requires fdout to be
+   * a unix domain socket.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_FD_PASSING,
+      g_param_spec_boolean ("fd-passing", "FD passing",
+          "Pass fd backed buffers as file descriptors",
+          DEFAULT_FD_PASSING,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+  /**
+   * GstIpcPipelineSink:max-buffers-in-flight:
+   *
+   * Maximum number of buffers sent to the peer before waiting for the flow
+   * return of the oldest one. With more than one, flow returns are reported
+   * asynchronously.
+   *
+   * Since: 1.18
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS_IN_FLIGHT,
+      g_param_spec_uint ("max-buffers-in-flight", "Max buffers in flight",
+          "Maximum number of buffers sent without waiting for their flow return",
+          1, 1024, DEFAULT_MAX_BUFFERS_IN_FLIGHT,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
 
   gst_ipc_pipeline_sink_signals[SIGNAL_DISCONNECT] =
       g_signal_new ("disconnect",
@@ -210,8 +254,11 @@ gst_ipc_pipeline_sink_init (GstIpcPipelineSink * sink)
   gst_ipc_pipeline_comm_init (&sink->comm, GST_ELEMENT (sink));
   sink->comm.read_chunk_size = DEFAULT_READ_CHUNK_SIZE;
   sink->comm.ack_time = DEFAULT_ACK_TIME;
+  sink->comm.fd_passing = DEFAULT_FD_PASSING;
+  sink->comm.max_buffers_in_flight = DEFAULT_MAX_BUFFERS_IN_FLIGHT;
   sink->comm.fdin = -1;
   sink->comm.fdout = -1;
+  sink->memfd_allocator = gst_ipc_pipeline_memfd_allocator_new ();
   sink->threads = g_thread_pool_new (pusher, sink, -1, FALSE, NULL);
   gst_ipc_pipeline_sink_start_reader_thread (sink);
 
@@ -248,6 +295,7 @@ gst_ipc_pipeline_sink_finalize (GObject * obj)
 
   gst_ipc_pipeline_comm_clear (&sink->comm);
   g_thread_pool_free (sink->threads, TRUE, TRUE);
+  gst_object_unref (sink->memfd_allocator);
 
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
@@ -271,6 +319,12 @@ gst_ipc_pipeline_sink_set_property (GObject * object, guint prop_id,
     case PROP_ACK_TIME:
       sink->comm.ack_time = g_value_get_uint64 (value);
       break;
+    case PROP_FD_PASSING:
+      sink->comm.fd_passing = g_value_get_boolean (value);
+      break;
+    case PROP_MAX_BUFFERS_IN_FLIGHT:
+      sink->comm.max_buffers_in_flight = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -296,6 +350,12 @@ gst_ipc_pipeline_sink_get_property (GObject * object, guint prop_id,
     case PROP_ACK_TIME:
       g_value_set_uint64 (value, sink->comm.ack_time);
       break;
+    case PROP_FD_PASSING:
+      g_value_set_boolean (value, sink->comm.fd_passing);
+      break;
+    case PROP_MAX_BUFFERS_IN_FLIGHT:
+      g_value_set_uint (value, sink->comm.max_buffers_in_flight);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -312,6 +372,11 @@ gst_ipc_pipeline_sink_event (GstPad * pad, GstObject * parent, GstEvent * event)
       event, gst_event_type_get_name (event->type), event->type);
 
   ret = gst_ipc_pipeline_comm_write_event_to_fd (&sink->comm, FALSE, event);
+
+  /* the buffers in flight were flushed by the peer */
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP)
+    gst_ipc_pipeline_comm_reset_buffers_in_flight (&sink->comm);
+
   gst_event_unref (event);
   return ret;
 }
@@ -344,6 +409,14 @@ gst_ipc_pipeline_sink_query (GstPad * pad, GstObject * parent, GstQuery * query)
 
   switch (GST_QUERY_TYPE (query)) {
     case GST_QUERY_ALLOCATION:
+#ifdef HAVE_MEMFD_CREATE
+      /* memfd buffers are passed to the peer without copying them */
+      if (gst_ipc_pipeline_comm_can_pass_fds (&sink->comm)) {
+        GST_DEBUG_OBJECT (sink, "Proposing memfd allocator");
+        gst_query_add_allocation_param (query, sink->memfd_allocator, NULL);
+        return TRUE;
+      }
+#endif
       GST_DEBUG_OBJECT (sink, "Rejecting ALLOCATION query");
       return FALSE;
     case GST_QUERY_CAPS:
@@ -679,6 +752,10 @@ gst_ipc_pipeline_sink_change_state (GstElement * element,
     }
   }
 
+  /* the pad is deactivated, stale flow returns must not affect a restart */
+  if (transition == GST_STATE_CHANGE_PAUSED_TO_READY)
+    gst_ipc_pipeline_comm_reset_buffers_in_flight (&sink->comm);
+
   GST_DEBUG_OBJECT (sink, "For %s -> %s: Peer ret: %s, parent ret: %s",
       gst_element_state_get_name (GST_STATE_TRANSITION_CURRENT (transition)),
       gst_element_state_get_name (GST_STATE_TRANSITION_NEXT (transition)),
@@ -52,6 +52,7 @@ struct _GstIpcPipelineSink {
   GThreadPool *threads;
   gboolean pass_next_async_done;
   GstPad *sinkpad;
+  GstAllocator *memfd_allocator;
 };
 
 struct _GstIpcPipelineSinkClass {
@@ -31,7 +31,17 @@
  * ! shmsink socket-path=/tmp/blah shm-size=2000000
  * ]| Send video to shm buffers.
  *
+ * By default every connected client gets every buffer, and a client that
+ * holds on to its buffers eventually blocks the stream for everybody once the
+ * shared memory area is full. Setting #GstShmSink:max-pending-buffers and
+ * #GstShmSink:client-policy limits how many buffers each client may hold at
+ * once and selects what happens to a client that goes over that limit.
+ *
  */
+
+/* using GValueArray, which has not replacement */
+#define GLIB_DISABLE_DEPRECATION_WARNINGS
+
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
@@ -58,17 +68,27 @@ enum
   PROP_PERMS,
   PROP_SHM_SIZE,
   PROP_WAIT_FOR_CONNECTION,
-  PROP_BUFFER_TIME
+  PROP_BUFFER_TIME,
+  PROP_CLIENT_POLICY,
+  PROP_MAX_PENDING_BUFFERS,
+  PROP_STATS
 };
 
 struct GstShmClient
 {
   ShmClient *client;
   GstPollFD pollfd;
+
+  /* Protected by the object lock */
+  gboolean skipping;
+  gboolean disconnecting;
+  guint64 dropped;
 };
 
 #define DEFAULT_SIZE ( 64 * 1024 * 1024 )
 #define DEFAULT_WAIT_FOR_CONNECTION (TRUE)
+#define DEFAULT_CLIENT_POLICY GST_SHM_SINK_CLIENT_POLICY_NONE
+#define DEFAULT_MAX_PENDING_BUFFERS 0
 /* Default is user read/write, group read */
 #define DEFAULT_PERMS ( S_IRUSR | S_IWUSR | S_IRGRP )
 
@@ -104,6 +124,32 @@ static gpointer pollthread_func (gpointer data);
 
 static guint signals[LAST_SIGNAL] = { 0 };
 
+#define GST_TYPE_SHM_SINK_CLIENT_POLICY \
+  (gst_shm_sink_client_policy_get_type())
+static GType
+gst_shm_sink_client_policy_get_type (void)
+{
+  static GType type = 0;
+
+  static const GEnumValue values[] = {
+    {GST_SHM_SINK_CLIENT_POLICY_NONE,
+        "Send every buffer to every client", "none"},
+    {GST_SHM_SINK_CLIENT_POLICY_DROP,
+        "Drop buffers for clients with too many pending buffers", "drop"},
+    {GST_SHM_SINK_CLIENT_POLICY_SKIP_TO_KEYFRAME,
+          "Drop buffers for clients with too many pending buffers and resume "
+          "at the next keyframe", "skip-to-keyframe"},
+    {GST_SHM_SINK_CLIENT_POLICY_DISCONNECT,
+        "Disconnect clients with too many pending buffers", "disconnect"},
+    {0, NULL, NULL}
+  };
+
+  if (!type) {
+    type = g_enum_register_static ("GstShmSinkClientPolicy", values);
+  }
+  return type;
+}
+
 
 
 /********************
@@ -355,6 +401,8 @@ gst_shm_sink_init (GstShmSink * self)
   self->unlock = FALSE;
   self->wait_for_connection = DEFAULT_WAIT_FOR_CONNECTION;
   self->perms = DEFAULT_PERMS;
+  self->client_policy = DEFAULT_CLIENT_POLICY;
+  self->max_pending_buffers = DEFAULT_MAX_PENDING_BUFFERS;
 
   gst_allocation_params_init (&self->params);
 }
@@ -417,6 +465,40 @@ gst_shm_sink_class_init (GstShmSinkClass * klass)
           -1, G_MAXINT64, -1,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstShmSink:client-policy:
+   *
+   * What to do with a client that holds #GstShmSink:max-pending-buffers
+   * buffers when a new buffer is rendered. Buffers that were already sent to
+   * a client are never taken back, as the client may still be reading them.
+   */
+  g_object_class_install_property (gobject_class, PROP_CLIENT_POLICY,
+      g_param_spec_enum ("client-policy", "Client policy",
+          "What to do with clients that have too many pending buffers",
+          GST_TYPE_SHM_SINK_CLIENT_POLICY, DEFAULT_CLIENT_POLICY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_PENDING_BUFFERS,
+      g_param_spec_uint ("max-pending-buffers",
+          "Maximum pending buffers per client",
+          "Number of buffers a client may hold before the client-policy "
+          "applies (0 = unlimited)",
+          0, G_MAXUINT, DEFAULT_MAX_PENDING_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstShmSink:stats:
+   *
+   * Allocation statistics of the shared memory area. The "clients" field
+   * contains one structure per connected client, with the number of buffers
+   * and bytes it has not released yet and the number of buffers that were
+   * not sent to it because of the #GstShmSink:client-policy.
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Allocation statistics of the shared memory area",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   signals[SIGNAL_CLIENT_CONNECTED] = g_signal_new ("client-connected",
       GST_TYPE_SHM_SINK, G_SIGNAL_RUN_LAST, 0, NULL, NULL,
       g_cclosure_marshal_VOID__INT, G_TYPE_NONE, 1, G_TYPE_INT);
@@ -505,11 +587,73 @@ gst_shm_sink_set_property (GObject * object, guint prop_id,
       GST_OBJECT_UNLOCK (object);
       g_cond_broadcast (&self->cond);
       break;
+    case PROP_CLIENT_POLICY:
+      GST_OBJECT_LOCK (object);
+      self->client_policy = g_value_get_enum (value);
+      GST_OBJECT_UNLOCK (object);
+      break;
+    case PROP_MAX_PENDING_BUFFERS:
+      GST_OBJECT_LOCK (object);
+      self->max_pending_buffers = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (object);
+      break;
     default:
       break;
   }
 }
 
+/* Must be called with the object lock */
+static GstStructure *
+gst_shm_sink_create_stats (GstShmSink * self)
+{
+  ShmAllocStats stats = { 0, };
+  GstStructure *s;
+  GValueArray *clients_stats;
+  GList *item;
+  gsize free_size;
+  gdouble fragmentation = 0.0;
+
+  if (self->pipe)
+    sp_writer_get_alloc_stats (self->pipe, &stats);
+
+  /* Share of the free space that can not be used for the largest possible
+   * allocation */
+  free_size = stats.size - stats.used;
+  if (free_size > 0)
+    fragmentation = 1.0 - (gdouble) stats.largest_free / free_size;
+
+  s = gst_structure_new ("GstShmSinkStats",
+      "shm-size", G_TYPE_UINT64, (guint64) stats.size,
+      "used", G_TYPE_UINT64, (guint64) stats.used,
+      "high-water", G_TYPE_UINT64, (guint64) stats.high_water,
+      "largest-free", G_TYPE_UINT64, (guint64) stats.largest_free,
+      "fragmentation", G_TYPE_DOUBLE, fragmentation,
+      "allocated-blocks", G_TYPE_UINT, stats.num_blocks,
+      "failed-allocations", G_TYPE_UINT64, (guint64) stats.num_failed, NULL);
+
+  clients_stats = g_value_array_new (g_list_length (self->clients));
+  for (item = self->clients; item; item = item->next) {
+    struct GstShmClient *gclient = item->data;
+    GValue value = G_VALUE_INIT;
+
+    g_value_init (&value, GST_TYPE_STRUCTURE);
+    g_value_take_boxed (&value, gst_structure_new ("GstShmSinkClientStats",
+            "fd", G_TYPE_INT, gclient->pollfd.fd,
+            "pending-buffers", G_TYPE_UINT,
+            sp_writer_client_get_pending_buffers (gclient->client),
+            "pending-bytes", G_TYPE_UINT64,
+            (guint64) sp_writer_client_get_pending_bytes (gclient->client),
+            "dropped-buffers", G_TYPE_UINT64, gclient->dropped, NULL));
+    g_value_array_append (clients_stats, &value);
+    g_value_unset (&value);
+  }
+
+  gst_structure_set (s, "clients", G_TYPE_VALUE_ARRAY, clients_stats, NULL);
+  g_value_array_free (clients_stats);
+
+  return s;
+}
+
 static void
 gst_shm_sink_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec)
@@ -534,6 +678,15 @@ gst_shm_sink_get_property (GObject * object, guint prop_id,
     case PROP_BUFFER_TIME:
       g_value_set_int64 (value, self->buffer_time);
       break;
+    case PROP_CLIENT_POLICY:
+      g_value_set_enum (value, self->client_policy);
+      break;
+    case PROP_MAX_PENDING_BUFFERS:
+      g_value_set_uint (value, self->max_pending_buffers);
+      break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_shm_sink_create_stats (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -658,6 +811,75 @@ gst_shm_sink_can_render (GstShmSink * self, GstClockTime time)
   return TRUE;
 }
 
+struct GstShmSendInfo
+{
+  GstShmSink *self;
+  GstBuffer *buf;
+};
+
+/* Called with the object lock, decides whether the buffer is sent to
+ * @client */
+static int
+gst_shm_sink_filter_client (ShmClient * client, struct GstShmSendInfo *info)
+{
+  struct GstShmClient *gclient = sp_writer_client_get_data (client);
+  GstShmSink *self = info->self;
+  gboolean over_limit;
+
+  if (gclient == NULL)
+    return 1;
+
+  if (gclient->disconnecting)
+    return 0;
+
+  if (self->client_policy == GST_SHM_SINK_CLIENT_POLICY_NONE ||
+      self->max_pending_buffers == 0)
+    return 1;
+
+  over_limit = sp_writer_client_get_pending_buffers (client) >=
+      self->max_pending_buffers;
+
+  switch (self->client_policy) {
+    case GST_SHM_SINK_CLIENT_POLICY_DROP:
+      if (over_limit)
+        goto drop;
+      break;
+    case GST_SHM_SINK_CLIENT_POLICY_SKIP_TO_KEYFRAME:
+      if (over_limit) {
+        if (!gclient->skipping)
+          GST_DEBUG_OBJECT (self, "Client %d is too slow, skipping to the "
+              "next keyframe", gclient->pollfd.fd);
+        gclient->skipping = TRUE;
+        goto drop;
+      }
+      if (gclient->skipping) {
+        if (GST_BUFFER_FLAG_IS_SET (info->buf, GST_BUFFER_FLAG_DELTA_UNIT))
+          goto drop;
+        gclient->skipping = FALSE;
+      }
+      break;
+    case GST_SHM_SINK_CLIENT_POLICY_DISCONNECT:
+      if (over_limit) {
+        GST_WARNING_OBJECT (self, "Client %d has %u pending buffers, "
+            "disconnecting", gclient->pollfd.fd,
+            sp_writer_client_get_pending_buffers (client));
+        gclient->disconnecting = TRUE;
+        /* The poll thread closes the client when it sees the hang up */
+        sp_writer_shutdown_client (client);
+        goto drop;
+      }
+      break;
+    default:
+      break;
+  }
+
+  return 1;
+
+drop:
+  gclient->dropped++;
+  return 0;
+}
+
 static GstFlowReturn
 gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 {
@@ -668,6 +890,7 @@ gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   GstFlowReturn ret = GST_FLOW_OK;
   GstMemory *memory = NULL;
   GstBuffer *sendbuf = NULL;
+  struct GstShmSendInfo info;
   gsize written_bytes;
 
   GST_OBJECT_LOCK (self);
@@ -788,7 +1011,10 @@ gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
    * We know it's not mapped for writing anywhere as we just mapped it for
    * reading
    */
-  rv = sp_writer_send_buf (self->pipe, (char *) map.data, map.size, sendbuf);
+  info.self = self;
+  info.buf = buf;
+  rv = sp_writer_send_buf_full (self->pipe, (char *) map.data, map.size,
+      sendbuf, (sp_client_filter_callback) gst_shm_sink_filter_client, &info);
   if (rv == -1) {
     GST_ELEMENT_ERROR (self, STREAM, FAILED,
         (NULL), ("Failed to send data over SHM"));
@@ -801,7 +1027,7 @@ gst_shm_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   GST_OBJECT_UNLOCK (self);
 
   if (rv == 0) {
-    GST_DEBUG_OBJECT (self, "No clients connected, unreffing buffer");
+    GST_DEBUG_OBJECT (self, "No clients to send to, unreffing buffer");
     gst_buffer_unref (sendbuf);
   }
 
@@ -866,22 +1092,25 @@ pollthread_func (gpointer data)
 
       GST_OBJECT_LOCK (self);
       client = sp_writer_accept_client (self->pipe);
-      GST_OBJECT_UNLOCK (self);
 
       if (!client) {
+        GST_OBJECT_UNLOCK (self);
         GST_ELEMENT_ERROR (self, RESOURCE, READ,
             ("Failed to read from shmsink"),
             ("Control socket returns wrong data"));
         return NULL;
       }
 
-      gclient = g_slice_new (struct GstShmClient);
+      gclient = g_slice_new0 (struct GstShmClient);
       gclient->client = client;
+      sp_writer_client_set_data (client, gclient);
       gst_poll_fd_init (&gclient->pollfd);
       gclient->pollfd.fd = sp_writer_get_client_fd (client);
+      self->clients = g_list_prepend (self->clients, gclient);
+      GST_OBJECT_UNLOCK (self);
+
       gst_poll_add_fd (self->poll, &gclient->pollfd);
       gst_poll_fd_ctl_read (self->poll, &gclient->pollfd, TRUE);
-      self->clients = g_list_prepend (self->clients, gclient);
       g_signal_emit (self, signals[SIGNAL_CLIENT_CONNECTED], 0,
           gclient->pollfd.fd);
       /* we need to call gst_poll_wait before calling gst_poll_* status
@@ -932,12 +1161,12 @@ pollthread_func (gpointer data)
         GST_OBJECT_LOCK (self);
         sp_writer_close_client (self->pipe, gclient->client,
             (sp_buffer_free_callback) free_buffer_locked, (void **) &list);
+        self->clients = g_list_remove (self->clients, gclient);
         GST_OBJECT_UNLOCK (self);
         g_slist_free_full (list, (GDestroyNotify) gst_buffer_unref);
       }
 
       gst_poll_remove_fd (self->poll, &gclient->pollfd);
-      self->clients = g_list_remove (self->clients, gclient);
 
       g_signal_emit (self, signals[SIGNAL_CLIENT_DISCONNECTED], 0,
           gclient->pollfd.fd);
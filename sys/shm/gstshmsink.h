@@ -42,6 +42,28 @@ typedef struct _GstShmSink GstShmSink;
 typedef struct _GstShmSinkClass GstShmSinkClass;
 typedef struct _GstShmSinkAllocator GstShmSinkAllocator;
 
+/**
+ * GstShmSinkClientPolicy:
+ * @GST_SHM_SINK_CLIENT_POLICY_NONE: every client gets every buffer, a slow
+ *   client blocks the stream once the shared memory area is full
+ * @GST_SHM_SINK_CLIENT_POLICY_DROP: buffers are not sent to a client that
+ *   has reached the maximum of pending buffers
+ * @GST_SHM_SINK_CLIENT_POLICY_SKIP_TO_KEYFRAME: like
+ *   @GST_SHM_SINK_CLIENT_POLICY_DROP, but once buffers were dropped for a
+ *   client, it only gets buffers again starting from the next keyframe
+ * @GST_SHM_SINK_CLIENT_POLICY_DISCONNECT: a client that reaches the maximum
+ *   of pending buffers is disconnected
+ *
+ * What to do with a client that does not release its buffers fast enough.
+ */
+typedef enum
+{
+  GST_SHM_SINK_CLIENT_POLICY_NONE,
+  GST_SHM_SINK_CLIENT_POLICY_DROP,
+  GST_SHM_SINK_CLIENT_POLICY_SKIP_TO_KEYFRAME,
+  GST_SHM_SINK_CLIENT_POLICY_DISCONNECT
+} GstShmSinkClientPolicy;
+
 struct _GstShmSink
 {
   GstBaseSink element;
@@ -63,6 +85,8 @@ struct _GstShmSink
   gboolean stop;
   gboolean unlock;
   GstClockTimeDiff buffer_time;
+  GstShmSinkClientPolicy client_policy;
+  guint max_pending_buffers;
 
   GCond cond;
 
@@ -33,19 +33,74 @@
 #include <string.h>
 #include <assert.h>
 
+#ifndef MAX
+#define MAX(a, b) (((a) > (b)) ? (a) : (b))
+#endif
+
+/*
+ * The space is managed as a two level segregated fit allocator: every free
+ * block is kept in a list per size class, and two levels of bitmaps record
+ * which of these lists are non-empty. The first level splits sizes in powers
+ * of two, the second level splits each power of two linearly in
+ * SL_INDEX_COUNT classes. Finding a free block that is large enough, as
+ * well as releasing a block and merging it with its free neighbours, are
+ * constant time operations.
+ *
+ * All blocks, free or not, are also chained in address order so that the
+ * neighbours of a block can be found when it is released. A small directory
+ * pointing to the block that covers the start of each page of the space
+ * allows looking up the block containing an offset without walking all of
+ * them.
+ */
+
+/* Blocks start at multiples of this, a cache line */
+#define ALIGN_SIZE_LOG2 6
+#define ALIGN_SIZE (1 << ALIGN_SIZE_LOG2)
+
+#define SL_INDEX_COUNT_LOG2 4
+#define SL_INDEX_COUNT (1 << SL_INDEX_COUNT_LOG2)
+#define FL_INDEX_SHIFT (SL_INDEX_COUNT_LOG2 + ALIGN_SIZE_LOG2)
+/* Enough for blocks, and so areas, of less than 4GB: the largest first
+ * level index is bit_fls (size) - (FL_INDEX_SHIFT - 1) < FL_INDEX_COUNT */
+#define FL_INDEX_MAX 32
+#define FL_INDEX_COUNT (FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE (1 << FL_INDEX_SHIFT)
+
+/* Maximum number of directory entries */
+#define DIR_MAX_ENTRIES_LOG2 12
+#define DIR_MIN_SHIFT 12
+
 /* This is the allocated space to hold multiple blocks */
 struct _ShmAllocSpace
 {
   /* The total size of this space */
   size_t size;
 
-  /* chained list of the blocks contained in this space */
+  /* chained list of all the blocks contained in this space, in address
+   * order */
   ShmAllocBlock *blocks;
+
+  /* free lists of every size class, and bitmaps of the non-empty ones */
+  unsigned int fl_bitmap;
+  unsigned int sl_bitmap[FL_INDEX_COUNT];
+  ShmAllocBlock *free_blocks[FL_INDEX_COUNT][SL_INDEX_COUNT];
+
+  /* block covering the first byte of each 1 << dir_shift bytes page */
+  ShmAllocBlock **dir;
+  size_t dir_len;
+  unsigned int dir_shift;
+
+  /* statistics */
+  size_t used;
+  size_t high_water;
+  unsigned int num_blocks;
+  unsigned long num_failed;
 };
 
 /* A single block of data */
 struct _ShmAllocBlock
 {
+  /* 0 if the block is free */
   int use_count;
 
   /* Pointer back to the AllocSpace where this block is */
@@ -56,27 +111,223 @@ struct _ShmAllocBlock
   /* The size of the block */
   unsigned long size;
 
-  /* Pointer to the next block in the chain */
+  /* Neighbouring blocks in address order */
+  ShmAllocBlock *prev;
   ShmAllocBlock *next;
+
+  /* Neighbouring blocks in the free list, only used while free */
+  ShmAllocBlock *prev_free;
+  ShmAllocBlock *next_free;
 };
 
+/* Index of the least significant bit set, @word must be non-zero */
+static inline int
+bit_ffs (unsigned int word)
+{
+#ifdef __GNUC__
+  return __builtin_ctz (word);
+#else
+  int bit = 0;
+
+  while (!(word & 1)) {
+    word >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+/* Index of the most significant bit set, @size must be non-zero */
+static inline int
+bit_fls (size_t size)
+{
+#ifdef __GNUC__
+  return (int) (sizeof (unsigned long long) * 8 - 1) -
+      __builtin_clzll ((unsigned long long) size);
+#else
+  int bit = -1;
+
+  while (size) {
+    size >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+static void
+mapping_insert (size_t size, int *fli, int *sli)
+{
+  int fl, sl;
+
+  if (size < SMALL_BLOCK_SIZE) {
+    fl = 0;
+    sl = size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+  } else {
+    fl = bit_fls (size);
+    sl = (size >> (fl - SL_INDEX_COUNT_LOG2)) ^ (1 << SL_INDEX_COUNT_LOG2);
+    fl -= FL_INDEX_SHIFT - 1;
+  }
+
+  *fli = fl;
+  *sli = sl;
+}
+
+/* Like mapping_insert(), but rounds up to the next size class so that any
+ * block of the returned class is large enough */
+static void
+mapping_search (size_t size, int *fli, int *sli)
+{
+  if (size >= SMALL_BLOCK_SIZE)
+    size += ((size_t) 1 << (bit_fls (size) - SL_INDEX_COUNT_LOG2)) - 1;
+
+  mapping_insert (size, fli, sli);
+}
+
+static void
+insert_free_block (ShmAllocSpace * self, ShmAllocBlock * block)
+{
+  int fl, sl;
+
+  mapping_insert (block->size, &fl, &sl);
+  assert (fl < FL_INDEX_COUNT);
+
+  block->prev_free = NULL;
+  block->next_free = self->free_blocks[fl][sl];
+  if (block->next_free)
+    block->next_free->prev_free = block;
+  self->free_blocks[fl][sl] = block;
+
+  self->fl_bitmap |= 1U << fl;
+  self->sl_bitmap[fl] |= 1U << sl;
+}
+
+static void
+remove_free_block (ShmAllocSpace * self, ShmAllocBlock * block)
+{
+  int fl, sl;
+
+  mapping_insert (block->size, &fl, &sl);
+
+  if (block->prev_free)
+    block->prev_free->next_free = block->next_free;
+  else
+    self->free_blocks[fl][sl] = block->next_free;
+  if (block->next_free)
+    block->next_free->prev_free = block->prev_free;
+
+  if (self->free_blocks[fl][sl] == NULL) {
+    self->sl_bitmap[fl] &= ~(1U << sl);
+    if (self->sl_bitmap[fl] == 0)
+      self->fl_bitmap &= ~(1U << fl);
+  }
+
+  block->prev_free = block->next_free = NULL;
+}
+
+/* Finds a free block of at least @asize bytes, or failing that one of at
+ * least @size bytes */
+static ShmAllocBlock *
+find_free_block (ShmAllocSpace * self, size_t asize, size_t size)
+{
+  ShmAllocBlock *block;
+  unsigned int sl_map, fl_map;
+  int fl, sl;
+
+  mapping_search (asize, &fl, &sl);
+
+  if (fl < FL_INDEX_COUNT) {
+    sl_map = self->sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+      fl_map = fl + 1 < FL_INDEX_COUNT ? self->fl_bitmap & (~0U << (fl + 1)) : 0;
+      if (fl_map) {
+        fl = bit_ffs (fl_map);
+        sl_map = self->sl_bitmap[fl];
+      }
+    }
+    if (sl_map)
+      return self->free_blocks[fl][bit_ffs (sl_map)];
+  }
+
+  /* All the blocks that are guaranteed to fit are taken, but the class
+   * that @size itself falls in may still have a block that is large
+   * enough, like the unaligned one at the end of the space */
+  mapping_insert (size, &fl, &sl);
+  if (fl >= FL_INDEX_COUNT)
+    return NULL;
+
+  for (block = self->free_blocks[fl][sl]; block; block = block->next_free) {
+    if (block->size >= size)
+      return block;
+  }
+
+  return NULL;
+}
+
+/* Points the directory entries of all the pages starting inside @block
+ * to it */
+static void
+update_dir (ShmAllocSpace * self, ShmAllocBlock * block)
+{
+  size_t page_size = (size_t) 1 << self->dir_shift;
+  size_t i, end;
+
+  i = (block->offset + page_size - 1) >> self->dir_shift;
+  end = (block->offset + block->size + page_size - 1) >> self->dir_shift;
+
+  for (; i < end && i < self->dir_len; i++)
+    self->dir[i] = block;
+}
 
 ShmAllocSpace *
 shm_alloc_space_new (size_t size)
 {
   ShmAllocSpace *self = spalloc_new (ShmAllocSpace);
+  ShmAllocBlock *block;
 
   memset (self, 0, sizeof (ShmAllocSpace));
 
   self->size = size;
 
+  if (size == 0)
+    return self;
+
+  self->dir_shift = DIR_MIN_SHIFT;
+  while ((size >> self->dir_shift) >= (1 << DIR_MAX_ENTRIES_LOG2))
+    self->dir_shift++;
+  self->dir_len = (size + ((size_t) 1 << self->dir_shift) - 1) >>
+      self->dir_shift;
+  self->dir = spalloc_alloc (sizeof (ShmAllocBlock *) * self->dir_len);
+
+  /* Start with one free block covering everything */
+  block = spalloc_new (ShmAllocBlock);
+  memset (block, 0, sizeof (ShmAllocBlock));
+  block->space = self;
+  block->offset = 0;
+  block->size = size;
+  self->blocks = block;
+
+  insert_free_block (self, block);
+  update_dir (self, block);
+
   return self;
 }
 
 void
 shm_alloc_space_free (ShmAllocSpace * self)
 {
-  assert (self && self->blocks == NULL);
+  ShmAllocBlock *block;
+
+  assert (self && self->num_blocks == 0);
+
+  /* Only the free blocks are left */
+  while ((block = self->blocks)) {
+    self->blocks = block->next;
+    spalloc_free (ShmAllocBlock, block);
+  }
+
+  if (self->dir)
+    spalloc_free1 (sizeof (ShmAllocBlock *) * self->dir_len, self->dir);
   spalloc_free (ShmAllocSpace, self);
 }
 
@@ -85,42 +336,44 @@ ShmAllocBlock *
 shm_alloc_space_alloc_block (ShmAllocSpace * self, unsigned long size)
 {
   ShmAllocBlock *block;
-  ShmAllocBlock *item = NULL;
-  ShmAllocBlock *prev_item = NULL;
-  unsigned long prev_end_offset = 0;
-
-
-  for (item = self->blocks; item; item = item->next) {
-    unsigned long max_size = 0;
+  ShmAllocBlock *rest;
+  unsigned long asize;
 
-    max_size = item->offset - prev_end_offset;
+  /* Keep blocks aligned, except for a block that ends the space */
+  asize = (MAX (size, 1) + ALIGN_SIZE - 1) & ~((unsigned long) ALIGN_SIZE - 1);
 
-    if (max_size >= size)
-      break;
-
-    prev_end_offset = item->offset + item->size;
-    prev_item = item;
+  block = find_free_block (self, asize, size);
+  if (!block) {
+    self->num_failed++;
+    return NULL;
   }
 
-  /* Return NULL if there is no big enough space, otherwise, there is space
-   * at the end */
-  assert (prev_end_offset <= self->size);
-  if (!item && self->size - prev_end_offset < size)
-    return NULL;
+  remove_free_block (self, block);
+
+  /* Give the remainder back to the free lists */
+  if (block->size >= asize + ALIGN_SIZE) {
+    rest = spalloc_new (ShmAllocBlock);
+    memset (rest, 0, sizeof (ShmAllocBlock));
+    rest->space = self;
+    rest->offset = block->offset + asize;
+    rest->size = block->size - asize;
+    rest->prev = block;
+    rest->next = block->next;
+    if (rest->next)
+      rest->next->prev = rest;
+    block->next = rest;
+    block->size = asize;
+
+    insert_free_block (self, rest);
+    update_dir (self, rest);
+  }
 
-  block = spalloc_new (ShmAllocBlock);
-  memset (block, 0, sizeof (ShmAllocBlock));
-  block->offset = prev_end_offset;
-  block->size = size;
   block->use_count = 1;
-  block->space = self;
-
-  if (prev_item)
-    prev_item->next = block;
-  else
-    self->blocks = block;
 
-  block->next = item;
+  self->used += block->size;
+  if (self->used > self->high_water)
+    self->high_water = self->used;
+  self->num_blocks++;
 
   return block;
 }
@@ -131,40 +384,86 @@ shm_alloc_space_alloc_block_get_offset (ShmAllocBlock * block)
   return block->offset;
 }
 
+/* Merges @next into @block, both must be free and out of the free lists */
+static void
+merge_blocks (ShmAllocBlock * block, ShmAllocBlock * next)
+{
+  block->size += next->size;
+  block->next = next->next;
+  if (block->next)
+    block->next->prev = block;
+
+  spalloc_free (ShmAllocBlock, next);
+}
+
 static void
 shm_alloc_space_free_block (ShmAllocBlock * block)
 {
-  ShmAllocBlock *item = NULL;
-  ShmAllocBlock *prev_item = NULL;
   ShmAllocSpace *self = block->space;
 
-  for (item = self->blocks; item; item = item->next) {
-    if (item == block) {
-      if (prev_item)
-        prev_item->next = item->next;
-      else
-        self->blocks = item->next;
-      break;
-    }
-    prev_item = item;
+  self->used -= block->size;
+  self->num_blocks--;
+
+  if (block->next && block->next->use_count == 0) {
+    remove_free_block (self, block->next);
+    merge_blocks (block, block->next);
   }
 
-  spalloc_free (ShmAllocBlock, block);
+  if (block->prev && block->prev->use_count == 0) {
+    ShmAllocBlock *prev = block->prev;
+
+    remove_free_block (self, prev);
+    merge_blocks (prev, block);
+    block = prev;
+  }
+
+  insert_free_block (self, block);
+  update_dir (self, block);
 }
 
 ShmAllocBlock *
 shm_alloc_space_block_get (ShmAllocSpace * self, unsigned long offset)
 {
-  ShmAllocBlock *block = NULL;
+  ShmAllocBlock *block;
 
-  for (block = self->blocks; block; block = block->next) {
-    if (block->offset <= offset && (block->offset + block->size) > offset)
-      return block;
+  if (offset >= self->size)
+    return NULL;
+
+  /* Start from the block covering the start of the page, the wanted one
+   * is at most a few blocks further */
+  block = self->dir[offset >> self->dir_shift];
+
+  for (; block; block = block->next) {
+    if ((block->offset + block->size) > offset)
+      return block->use_count > 0 ? block : NULL;
   }
 
   return NULL;
 }
 
+void
+shm_alloc_space_get_stats (ShmAllocSpace * self, ShmAllocStats * stats)
+{
+  ShmAllocBlock *block;
+  int fl, sl;
+
+  memset (stats, 0, sizeof (ShmAllocStats));
+
+  stats->size = self->size;
+  stats->used = self->used;
+  stats->high_water = self->high_water;
+  stats->num_blocks = self->num_blocks;
+  stats->num_failed = self->num_failed;
+
+  /* The largest free block is in the highest non-empty size class */
+  if (self->fl_bitmap) {
+    fl = bit_fls (self->fl_bitmap);
+    sl = bit_fls (self->sl_bitmap[fl]);
+    for (block = self->free_blocks[fl][sl]; block; block = block->next_free)
+      stats->largest_free = MAX (stats->largest_free, block->size);
+  }
+}
+
 
 void
 shm_alloc_space_block_inc (ShmAllocBlock * block)
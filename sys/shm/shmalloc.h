@@ -52,6 +52,22 @@ extern "C" {
 
 typedef struct _ShmAllocSpace ShmAllocSpace;
 typedef struct _ShmAllocBlock ShmAllocBlock;
+typedef struct _ShmAllocStats ShmAllocStats;
+
+struct _ShmAllocStats
+{
+  /* Size of the space */
+  size_t size;
+  /* Bytes currently allocated, and the most ever allocated at once */
+  size_t used;
+  size_t high_water;
+  /* Largest block that could currently be allocated */
+  size_t largest_free;
+  /* Number of allocated blocks */
+  unsigned int num_blocks;
+  /* Number of allocations that could not be satisfied */
+  unsigned long num_failed;
+};
 
 ShmAllocSpace *shm_alloc_space_new (size_t size);
 void shm_alloc_space_free (ShmAllocSpace * self);
@@ -66,6 +82,8 @@ void shm_alloc_space_block_dec (ShmAllocBlock * block);
 ShmAllocBlock * shm_alloc_space_block_get (ShmAllocSpace * space,
     unsigned long offset);
 
+void shm_alloc_space_get_stats (ShmAllocSpace * self, ShmAllocStats * stats);
+
 
 #ifdef __cplusplus
 }
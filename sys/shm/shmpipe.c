@@ -147,6 +147,12 @@ struct _ShmClient
 {
   int fd;
 
+  /* Buffers sent to this client that it has not acked yet */
+  unsigned int pending_buffers;
+  size_t pending_bytes;
+
+  void *data;
+
   ShmClient *next;
 };
 
@@ -576,6 +582,16 @@ sp_writer_free_block (ShmBlock * block)
 
 int
 sp_writer_send_buf (ShmPipe * self, char *buf, size_t size, void *tag)
+{
+  return sp_writer_send_buf_full (self, buf, size, tag, NULL, NULL);
+}
+
+/* Same as sp_writer_send_buf(), but the buffer is only sent to the clients
+ * for which @filter returns non-zero */
+
+int
+sp_writer_send_buf_full (ShmPipe * self, char *buf, size_t size, void *tag,
+    sp_client_filter_callback filter, void *user_data)
 {
   ShmArea *area = NULL;
   unsigned long offset = 0;
@@ -614,11 +630,17 @@ sp_writer_send_buf (ShmPipe * self, char *buf, size_t size, void *tag)
 
   for (client = self->clients; client; client = client->next) {
     struct CommandBuffer cb = { 0 };
+
+    if (filter && !filter (client, user_data))
+      continue;
+
     cb.payload.buffer.offset = offset;
     cb.payload.buffer.size = bsize;
     if (!send_command (client->fd, &cb, COMMAND_NEW_BUFFER, self->shm_area->id))
       continue;
     sb->clients[i++] = client->fd;
+    client->pending_buffers++;
+    client->pending_bytes += size;
     c++;
   }
 
@@ -834,6 +856,7 @@ sp_writer_accept_client (ShmPipe * self)
   }
 
   client = spalloc_new (ShmClient);
+  memset (client, 0, sizeof (ShmClient));
   client->fd = fd;
 
   /* Prepend ot linked list */
@@ -870,6 +893,10 @@ sp_shmbuf_dec (ShmPipe * self, ShmBuffer * buf, ShmBuffer * prev_buf,
   }
   assert (had_client);
 
+  assert (client->pending_buffers > 0);
+  client->pending_buffers--;
+  client->pending_bytes -= buf->size;
+
   buf->use_count--;
 
   if (buf->use_count == 0) {
@@ -955,6 +982,40 @@ sp_writer_get_client_fd (ShmClient * client)
   return client->fd;
 }
 
+void *
+sp_writer_client_get_data (ShmClient * client)
+{
+  return client->data;
+}
+
+void
+sp_writer_client_set_data (ShmClient * client, void *data)
+{
+  client->data = data;
+}
+
+unsigned int
+sp_writer_client_get_pending_buffers (ShmClient * client)
+{
+  return client->pending_buffers;
+}
+
+size_t
+sp_writer_client_get_pending_bytes (ShmClient * client)
+{
+  return client->pending_bytes;
+}
+
+/* Shuts the client connection down without releasing anything, the
+ * application will then get a hang up on the client fd and is expected to
+ * call sp_writer_close_client() from there */
+
+void
+sp_writer_shutdown_client (ShmClient * client)
+{
+  shutdown (client->fd, SHUT_RDWR);
+}
+
 int
 sp_writer_pending_writes (ShmPipe * self)
 {
@@ -993,3 +1054,14 @@ sp_writer_get_max_buf_size (ShmPipe * self)
 
   return self->shm_area->shm_area_len;
 }
+
+void
+sp_writer_get_alloc_stats (ShmPipe * self, ShmAllocStats * stats)
+{
+  if (self->shm_area == NULL || self->shm_area->allocspace == NULL) {
+    memset (stats, 0, sizeof (ShmAllocStats));
+    return;
+  }
+
+  shm_alloc_space_get_stats (self->shm_area->allocspace, stats);
+}
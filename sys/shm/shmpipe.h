@@ -68,6 +68,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 
+#include "shmalloc.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -79,6 +80,8 @@ typedef struct _ShmBlock ShmBlock;
 typedef struct _ShmBuffer ShmBuffer;
 
 typedef void (*sp_buffer_free_callback) (void * tag, void * user_data);
+typedef int (*sp_client_filter_callback) (ShmClient * client,
+    void * user_data);
 
 ShmPipe *sp_writer_create (const char *path, size_t size, mode_t perms);
 const char *sp_writer_get_path (ShmPipe *pipe);
@@ -97,14 +100,23 @@ int sp_writer_get_client_fd (ShmClient * client);
 ShmBlock *sp_writer_alloc_block (ShmPipe * self, size_t size);
 void sp_writer_free_block (ShmBlock *block);
 int sp_writer_send_buf (ShmPipe * self, char *buf, size_t size, void * tag);
+int sp_writer_send_buf_full (ShmPipe * self, char *buf, size_t size,
+    void * tag, sp_client_filter_callback filter, void * user_data);
 char *sp_writer_block_get_buf (ShmBlock *block);
 ShmPipe *sp_writer_block_get_pipe (ShmBlock *block);
 size_t sp_writer_get_max_buf_size (ShmPipe * self);
+void sp_writer_get_alloc_stats (ShmPipe * self, ShmAllocStats * stats);
 
 ShmClient * sp_writer_accept_client (ShmPipe * self);
 void sp_writer_close_client (ShmPipe *self, ShmClient * client,
     sp_buffer_free_callback callback, void * user_data);
 int sp_writer_recv (ShmPipe * self, ShmClient * client, void ** tag);
+void sp_writer_shutdown_client (ShmClient * client);
+
+void *sp_writer_client_get_data (ShmClient * client);
+void sp_writer_client_set_data (ShmClient * client, void *data);
+unsigned int sp_writer_client_get_pending_buffers (ShmClient * client);
+size_t sp_writer_client_get_pending_bytes (ShmClient * client);
 
 int sp_writer_pending_writes (ShmPipe * self);
 
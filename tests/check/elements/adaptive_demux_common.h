@@ -115,6 +115,10 @@ typedef struct _GstAdaptiveDemuxTestCase
   GstEvent *seek_event;
   gboolean seeked;
 
+  /* properties set on the demux before the pipeline is started by
+   * gst_adaptive_demux_test_seek() (optional) */
+  GstStructure *demux_properties;
+
   gpointer signal_context;
 } GstAdaptiveDemuxTestCase;
 
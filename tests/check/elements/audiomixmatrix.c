@@ -0,0 +1,222 @@
+/* GStreamer
+ *
+ * unit test for audiomixmatrix
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/audio/audio.h>
+
+#define IN_CHANNELS 3
+#define OUT_CHANNELS 2
+/* not a multiple of any vector size */
+#define N_SAMPLES 37
+
+/* The first output channel is a copy of the first input channel, the second
+ * one mixes the two others */
+static const gdouble matrix[OUT_CHANNELS][IN_CHANNELS] = {
+  {1.0, 0.0, 0.0},
+  {0.0, 0.5, 0.25},
+};
+
+static void
+set_matrix (GstElement * element)
+{
+  GValue value = G_VALUE_INIT;
+  guint in, out;
+
+  g_value_init (&value, GST_TYPE_ARRAY);
+  for (out = 0; out < OUT_CHANNELS; out++) {
+    GValue row = G_VALUE_INIT;
+
+    g_value_init (&row, GST_TYPE_ARRAY);
+    for (in = 0; in < IN_CHANNELS; in++) {
+      GValue v = G_VALUE_INIT;
+
+      g_value_init (&v, G_TYPE_DOUBLE);
+      g_value_set_double (&v, matrix[out][in]);
+      gst_value_array_append_value (&row, &v);
+      g_value_unset (&v);
+    }
+    gst_value_array_append_value (&value, &row);
+    g_value_unset (&row);
+  }
+
+  g_object_set_property (G_OBJECT (element), "matrix", &value);
+  g_value_unset (&value);
+}
+
+static GstHarness *
+create_harness (GstAudioFormat format, GstAudioInfo * in_info,
+    GstAudioInfo * out_info)
+{
+  GstHarness *h = gst_harness_new ("audiomixmatrix");
+  GstCaps *caps;
+
+  g_object_set (h->element, "in-channels", IN_CHANNELS, "out-channels",
+      OUT_CHANNELS, "channel-mask", G_GUINT64_CONSTANT (0), NULL);
+  set_matrix (h->element);
+
+  gst_audio_info_set_format (in_info, format, 48000, IN_CHANNELS, NULL);
+  in_info->layout = GST_AUDIO_LAYOUT_NON_INTERLEAVED;
+  gst_audio_info_set_format (out_info, format, 48000, OUT_CHANNELS, NULL);
+  out_info->layout = GST_AUDIO_LAYOUT_NON_INTERLEAVED;
+
+  caps = gst_audio_info_to_caps (in_info);
+  gst_harness_set_src_caps (h, caps);
+
+  return h;
+}
+
+static GstBuffer *
+new_planar_buffer (GstAudioInfo * info)
+{
+  GstBuffer *buf;
+
+  buf = gst_buffer_new_allocate (NULL, N_SAMPLES * GST_AUDIO_INFO_BPF (info),
+      NULL);
+  gst_buffer_add_audio_meta (buf, info, N_SAMPLES, NULL);
+
+  return buf;
+}
+
+/* Checks that the output is non-interleaved as well and maps it */
+static GstBuffer *
+pull_planar_buffer (GstHarness * h, GstAudioInfo * info,
+    GstAudioBuffer * abuf)
+{
+  GstBuffer *buf = gst_harness_pull (h);
+  GstAudioMeta *meta;
+
+  fail_unless (buf != NULL);
+  meta = gst_buffer_get_audio_meta (buf);
+  fail_unless (meta != NULL);
+  fail_unless_equals_int (meta->samples, N_SAMPLES);
+  fail_unless_equals_int (GST_AUDIO_INFO_CHANNELS (&meta->info), OUT_CHANNELS);
+  fail_unless_equals_int (GST_AUDIO_INFO_LAYOUT (&meta->info),
+      GST_AUDIO_LAYOUT_NON_INTERLEAVED);
+
+  fail_unless (gst_audio_buffer_map (abuf, info, buf, GST_MAP_READ));
+
+  return buf;
+}
+
+GST_START_TEST (test_planar_f32)
+{
+  GstAudioInfo in_info, out_info;
+  GstHarness *h = create_harness (GST_AUDIO_FORMAT_F32, &in_info, &out_info);
+  GstAudioBuffer abuf;
+  GstBuffer *buf;
+  gfloat **planes;
+  guint i;
+
+  buf = new_planar_buffer (&in_info);
+  fail_unless (gst_audio_buffer_map (&abuf, &in_info, buf, GST_MAP_WRITE));
+  planes = (gfloat **) abuf.planes;
+  for (i = 0; i < N_SAMPLES; i++) {
+    planes[0][i] = i / 64.0;
+    planes[1][i] = -(gfloat) i / 128.0;
+    planes[2][i] = 0.5;
+  }
+  gst_audio_buffer_unmap (&abuf);
+
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+  buf = pull_planar_buffer (h, &out_info, &abuf);
+  planes = (gfloat **) abuf.planes;
+  for (i = 0; i < N_SAMPLES; i++) {
+    fail_unless_equals_float (planes[0][i], i / 64.0);
+    fail_unless_equals_float (planes[1][i], -(gfloat) i / 256.0 + 0.125);
+  }
+  gst_audio_buffer_unmap (&abuf);
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_planar_s16)
+{
+  GstAudioInfo in_info, out_info;
+  GstHarness *h = create_harness (GST_AUDIO_FORMAT_S16, &in_info, &out_info);
+  GstAudioBuffer abuf;
+  GstBuffer *buf;
+  gint16 **planes;
+  gint i;
+
+  buf = new_planar_buffer (&in_info);
+  fail_unless (gst_audio_buffer_map (&abuf, &in_info, buf, GST_MAP_WRITE));
+  planes = (gint16 **) abuf.planes;
+  for (i = 0; i < N_SAMPLES; i++) {
+    planes[0][i] = i * 100;
+    planes[1][i] = -i * 50;
+    planes[2][i] = 1000;
+  }
+  gst_audio_buffer_unmap (&abuf);
+
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+  buf = pull_planar_buffer (h, &out_info, &abuf);
+  planes = (gint16 **) abuf.planes;
+  for (i = 0; i < N_SAMPLES; i++) {
+    fail_unless_equals_int (planes[0][i], i * 100);
+    fail_unless_equals_int (planes[1][i], -i * 25 + 250);
+  }
+  gst_audio_buffer_unmap (&abuf);
+  gst_buffer_unref (buf);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_planar_without_meta)
+{
+  GstAudioInfo in_info, out_info;
+  GstHarness *h = create_harness (GST_AUDIO_FORMAT_F32, &in_info, &out_info);
+  GstBuffer *buf;
+
+  /* the planes can't be found without the meta */
+  buf = gst_buffer_new_allocate (NULL,
+      N_SAMPLES * GST_AUDIO_INFO_BPF (&in_info), NULL);
+  gst_buffer_memset (buf, 0, 0, gst_buffer_get_size (buf));
+
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_ERROR);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+audiomixmatrix_suite (void)
+{
+  Suite *s = suite_create ("audiomixmatrix");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_planar_f32);
+  tcase_add_test (tc_chain, test_planar_s16);
+  tcase_add_test (tc_chain, test_planar_without_meta);
+
+  return s;
+}
+
+GST_CHECK_MAIN (audiomixmatrix);
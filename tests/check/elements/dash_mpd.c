@@ -4934,6 +4934,349 @@ GST_START_TEST (dash_mpdparser_segment_timeline)
 
 GST_END_TEST;
 
+/*
+ * Test updating the segment list of an active stream from a refreshed
+ * manifest where segments expired and new ones were added to the timeline
+ *
+ */
+GST_START_TEST (dash_mpdparser_segment_timeline_update)
+{
+  GList *adaptationSets;
+  GstAdaptationSetNode *adapt_set;
+  GstActiveStream *activeStream;
+  GstMediaSegment *segment, *kept_segment;
+
+  const gchar *xml =
+      "<?xml version=\"1.0\"?>"
+      "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\""
+      "     profiles=\"urn:mpeg:dash:profile:isoff-live:2011\""
+      "     type=\"dynamic\""
+      "     availabilityStartTime=\"2015-03-24T0:0:0\">"
+      "  <Period id=\"p\" start=\"PT0S\">"
+      "    <AdaptationSet mimeType=\"video/mp4\">"
+      "      <SegmentTemplate media=\"$Number$.m4s\" startNumber=\"1\""
+      "                       timescale=\"1\">"
+      "        <SegmentTimeline>"
+      "          <S t=\"0\" d=\"2\" r=\"2\"/>"
+      "          <S t=\"6\" d=\"3\"/>"
+      "        </SegmentTimeline>"
+      "      </SegmentTemplate>"
+      "      <Representation id=\"1\" bandwidth=\"250000\"/>"
+      "    </AdaptationSet></Period></MPD>";
+
+  const gchar *xml_update =
+      "<?xml version=\"1.0\"?>"
+      "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\""
+      "     profiles=\"urn:mpeg:dash:profile:isoff-live:2011\""
+      "     type=\"dynamic\""
+      "     availabilityStartTime=\"2015-03-24T0:0:0\">"
+      "  <Period id=\"p\" start=\"PT0S\">"
+      "    <AdaptationSet mimeType=\"video/mp4\">"
+      "      <SegmentTemplate media=\"$Number$.m4s\" startNumber=\"4\""
+      "                       timescale=\"1\">"
+      "        <SegmentTimeline>"
+      "          <S t=\"6\" d=\"3\" r=\"1\"/>"
+      "          <S t=\"12\" d=\"2\"/>"
+      "        </SegmentTimeline>"
+      "      </SegmentTemplate>"
+      "      <Representation id=\"1\" bandwidth=\"250000\"/>"
+      "    </AdaptationSet></Period></MPD>";
+
+  gboolean ret;
+  GstMpdClient *mpdclient = gst_mpd_client_new ();
+  GstMpdClient *new_client = gst_mpd_client_new ();
+
+  ret = gst_mpd_parse (mpdclient, xml, (gint) strlen (xml));
+  assert_equals_int (ret, TRUE);
+  ret =
+      gst_mpd_client_setup_media_presentation (mpdclient, GST_CLOCK_TIME_NONE,
+      -1, NULL);
+  assert_equals_int (ret, TRUE);
+
+  adaptationSets = gst_mpd_client_get_adaptation_sets (mpdclient);
+  adapt_set = (GstAdaptationSetNode *) g_list_nth_data (adaptationSets, 0);
+  fail_if (adapt_set == NULL);
+  ret = gst_mpd_client_setup_streaming (mpdclient, adapt_set);
+  assert_equals_int (ret, TRUE);
+
+  activeStream = gst_mpdparser_get_active_stream_by_index (mpdclient, 0);
+  fail_if (activeStream == NULL);
+  assert_equals_int (activeStream->segments->len, 2);
+  kept_segment = g_ptr_array_index (activeStream->segments, 1);
+
+  ret = gst_mpd_parse (new_client, xml_update, (gint) strlen (xml_update));
+  assert_equals_int (ret, TRUE);
+  ret =
+      gst_mpd_client_setup_media_presentation (new_client, GST_CLOCK_TIME_NONE,
+      -1, "p");
+  assert_equals_int (ret, TRUE);
+
+  ret = gst_mpd_client_update_active_streams (new_client, mpdclient);
+  assert_equals_int (ret, TRUE);
+
+  /* the stream moved over to the new client */
+  assert_equals_int (gst_mpdparser_get_nb_active_stream (mpdclient), 0);
+  assert_equals_int (gst_mpdparser_get_nb_active_stream (new_client), 1);
+  fail_unless (gst_mpdparser_get_active_stream_by_index (new_client,
+          0) == activeStream);
+  gst_mpd_client_free (mpdclient);
+
+  /* the first S expired, the second one got a repeat and a new one was
+   * added */
+  assert_equals_int (activeStream->segments->len, 2);
+
+  segment = g_ptr_array_index (activeStream->segments, 0);
+  fail_unless (segment == kept_segment);
+  assert_equals_int (segment->number, 4);
+  assert_equals_int (segment->repeat, 1);
+  assert_equals_uint64 (segment->scale_start, 6);
+  assert_equals_uint64 (segment->start, 6 * GST_SECOND);
+  assert_equals_uint64 (segment->duration, 3 * GST_SECOND);
+
+  segment = g_ptr_array_index (activeStream->segments, 1);
+  assert_equals_int (segment->number, 6);
+  assert_equals_int (segment->repeat, 0);
+  assert_equals_uint64 (segment->scale_start, 12);
+  assert_equals_uint64 (segment->start, 12 * GST_SECOND);
+  assert_equals_uint64 (segment->duration, 2 * GST_SECOND);
+
+  gst_mpd_client_free (new_client);
+}
+
+GST_END_TEST;
+
+/*
+ * Test resuming the segment list of an active stream from a refreshed
+ * manifest whose timeline starts within a known run of segments and only
+ * has a @t on its first S node
+ *
+ */
+GST_START_TEST (dash_mpdparser_segment_timeline_update_resume)
+{
+  GList *adaptationSets;
+  GstAdaptationSetNode *adapt_set;
+  GstActiveStream *activeStream;
+  GstMediaSegment *segment, *known_segments[3];
+  guint i;
+
+  const gchar *xml =
+      "<?xml version=\"1.0\"?>"
+      "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\""
+      "     profiles=\"urn:mpeg:dash:profile:isoff-live:2011\""
+      "     type=\"dynamic\""
+      "     availabilityStartTime=\"2015-03-24T0:0:0\">"
+      "  <Period id=\"p\" start=\"PT0S\">"
+      "    <AdaptationSet mimeType=\"video/mp4\">"
+      "      <SegmentTemplate media=\"$Number$.m4s\" startNumber=\"1\""
+      "                       timescale=\"1\">"
+      "        <SegmentTimeline>"
+      "          <S t=\"0\" d=\"2\" r=\"1\"/>"
+      "          <S t=\"4\" d=\"3\"/>"
+      "          <S t=\"7\" d=\"2\"/>"
+      "        </SegmentTimeline>"
+      "      </SegmentTemplate>"
+      "      <Representation id=\"1\" bandwidth=\"250000\"/>"
+      "    </AdaptationSet></Period></MPD>";
+
+  const gchar *xml_update =
+      "<?xml version=\"1.0\"?>"
+      "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\""
+      "     profiles=\"urn:mpeg:dash:profile:isoff-live:2011\""
+      "     type=\"dynamic\""
+      "     availabilityStartTime=\"2015-03-24T0:0:0\">"
+      "  <Period id=\"p\" start=\"PT0S\">"
+      "    <AdaptationSet mimeType=\"video/mp4\">"
+      "      <SegmentTemplate media=\"$Number$.m4s\" startNumber=\"2\""
+      "                       timescale=\"1\">"
+      "        <SegmentTimeline>"
+      "          <S t=\"2\" d=\"2\"/>"
+      "          <S d=\"3\"/>"
+      "          <S d=\"2\" r=\"2\"/>"
+      "        </SegmentTimeline>"
+      "      </SegmentTemplate>"
+      "      <Representation id=\"1\" bandwidth=\"250000\"/>"
+      "    </AdaptationSet></Period></MPD>";
+
+  gboolean ret;
+  GstMpdClient *mpdclient = gst_mpd_client_new ();
+  GstMpdClient *new_client = gst_mpd_client_new ();
+
+  ret = gst_mpd_parse (mpdclient, xml, (gint) strlen (xml));
+  assert_equals_int (ret, TRUE);
+  ret =
+      gst_mpd_client_setup_media_presentation (mpdclient, GST_CLOCK_TIME_NONE,
+      -1, NULL);
+  assert_equals_int (ret, TRUE);
+
+  adaptationSets = gst_mpd_client_get_adaptation_sets (mpdclient);
+  adapt_set = (GstAdaptationSetNode *) g_list_nth_data (adaptationSets, 0);
+  fail_if (adapt_set == NULL);
+  ret = gst_mpd_client_setup_streaming (mpdclient, adapt_set);
+  assert_equals_int (ret, TRUE);
+
+  activeStream = gst_mpdparser_get_active_stream_by_index (mpdclient, 0);
+  fail_if (activeStream == NULL);
+  assert_equals_int (activeStream->segments->len, 3);
+  for (i = 0; i < 3; i++)
+    known_segments[i] = g_ptr_array_index (activeStream->segments, i);
+
+  ret = gst_mpd_parse (new_client, xml_update, (gint) strlen (xml_update));
+  assert_equals_int (ret, TRUE);
+  ret =
+      gst_mpd_client_setup_media_presentation (new_client, GST_CLOCK_TIME_NONE,
+      -1, "p");
+  assert_equals_int (ret, TRUE);
+
+  ret = gst_mpd_client_update_active_streams (new_client, mpdclient);
+  assert_equals_int (ret, TRUE);
+  gst_mpd_client_free (mpdclient);
+
+  /* the first run lost its first repeat and the last one got two more, all
+   * known segments were kept */
+  assert_equals_int (activeStream->segments->len, 3);
+  for (i = 0; i < 3; i++)
+    fail_unless (g_ptr_array_index (activeStream->segments,
+            i) == known_segments[i]);
+
+  segment = g_ptr_array_index (activeStream->segments, 0);
+  assert_equals_int (segment->number, 2);
+  assert_equals_int (segment->repeat, 0);
+  assert_equals_uint64 (segment->scale_start, 2);
+  assert_equals_uint64 (segment->start, 2 * GST_SECOND);
+  assert_equals_uint64 (segment->duration, 2 * GST_SECOND);
+
+  segment = g_ptr_array_index (activeStream->segments, 1);
+  assert_equals_int (segment->number, 3);
+  assert_equals_int (segment->repeat, 0);
+  assert_equals_uint64 (segment->scale_start, 4);
+  assert_equals_uint64 (segment->start, 4 * GST_SECOND);
+  assert_equals_uint64 (segment->duration, 3 * GST_SECOND);
+
+  segment = g_ptr_array_index (activeStream->segments, 2);
+  assert_equals_int (segment->number, 4);
+  assert_equals_int (segment->repeat, 2);
+  assert_equals_uint64 (segment->scale_start, 7);
+  assert_equals_uint64 (segment->start, 7 * GST_SECOND);
+  assert_equals_uint64 (segment->duration, 2 * GST_SECOND);
+
+  /* a position that expired from the timeline maps to its first segment */
+  activeStream->segment_index = 2;
+  activeStream->segment_repeat_index = 1;
+  ret = gst_mpd_client_stream_seek (new_client, activeStream, TRUE, 0,
+      GST_SECOND, NULL);
+  assert_equals_int (ret, TRUE);
+  assert_equals_int (activeStream->segment_index, 0);
+  assert_equals_int (activeStream->segment_repeat_index, 0);
+
+  /* one after its end isn't in it, but leaves the stream after the last
+   * segment to wait for the next one */
+  ret = gst_mpd_client_stream_seek (new_client, activeStream, TRUE, 0,
+      14 * GST_SECOND, NULL);
+  assert_equals_int (ret, FALSE);
+  assert_equals_int (gst_mpd_client_has_next_segment (new_client,
+          activeStream, TRUE), FALSE);
+
+  gst_mpd_client_free (new_client);
+}
+
+GST_END_TEST;
+
+/*
+ * Test that contiguous S nodes of the same duration are folded into a single
+ * run of segments and that seeking inside such a run works
+ *
+ */
+GST_START_TEST (dash_mpdparser_segment_timeline_runs)
+{
+  GList *adaptationSets;
+  GstAdaptationSetNode *adapt_set;
+  GstActiveStream *activeStream;
+  GstMediaSegment *segment;
+  GstClockTime ts;
+
+  const gchar *xml =
+      "<?xml version=\"1.0\"?>"
+      "<MPD xmlns=\"urn:mpeg:dash:schema:mpd:2011\""
+      "     profiles=\"urn:mpeg:dash:profile:isoff-on-demand:2011\""
+      "     availabilityStartTime=\"2015-03-24T0:0:0\""
+      "     mediaPresentationDuration=\"P0Y0M0DT0H0M11S\">"
+      "  <Period start=\"P0Y0M0DT0H0M0S\">"
+      "    <AdaptationSet mimeType=\"video/mp4\">"
+      "      <SegmentTemplate media=\"$Number$.m4s\" startNumber=\"1\""
+      "                       timescale=\"1\">"
+      "        <SegmentTimeline>"
+      "          <S t=\"0\" d=\"2\"/>"
+      "          <S d=\"2\"/>"
+      "          <S t=\"4\" d=\"2\" r=\"1\"/>"
+      "          <S d=\"3\"/>"
+      "        </SegmentTimeline>"
+      "      </SegmentTemplate>"
+      "      <Representation id=\"1\" bandwidth=\"250000\"/>"
+      "    </AdaptationSet></Period></MPD>";
+
+  gboolean ret;
+  GstMpdClient *mpdclient = gst_mpd_client_new ();
+
+  ret = gst_mpd_parse (mpdclient, xml, (gint) strlen (xml));
+  assert_equals_int (ret, TRUE);
+  ret =
+      gst_mpd_client_setup_media_presentation (mpdclient, GST_CLOCK_TIME_NONE,
+      -1, NULL);
+  assert_equals_int (ret, TRUE);
+
+  adaptationSets = gst_mpd_client_get_adaptation_sets (mpdclient);
+  adapt_set = (GstAdaptationSetNode *) g_list_nth_data (adaptationSets, 0);
+  fail_if (adapt_set == NULL);
+  ret = gst_mpd_client_setup_streaming (mpdclient, adapt_set);
+  assert_equals_int (ret, TRUE);
+
+  activeStream = gst_mpdparser_get_active_stream_by_index (mpdclient, 0);
+  fail_if (activeStream == NULL);
+
+  /* the first three S make a single run of four segments */
+  assert_equals_int (activeStream->segments->len, 2);
+  segment = g_ptr_array_index (activeStream->segments, 0);
+  assert_equals_int (segment->number, 1);
+  assert_equals_int (segment->repeat, 3);
+  assert_equals_uint64 (segment->start, 0);
+  assert_equals_uint64 (segment->duration, 2 * GST_SECOND);
+  segment = g_ptr_array_index (activeStream->segments, 1);
+  assert_equals_int (segment->number, 5);
+  assert_equals_int (segment->repeat, 0);
+  assert_equals_uint64 (segment->start, 8 * GST_SECOND);
+  assert_equals_uint64 (segment->duration, 3 * GST_SECOND);
+
+  ret = gst_mpd_client_stream_seek (mpdclient, activeStream, TRUE, 0,
+      5 * GST_SECOND, &ts);
+  assert_equals_int (ret, TRUE);
+  assert_equals_int (activeStream->segment_index, 0);
+  assert_equals_int (activeStream->segment_repeat_index, 2);
+  assert_equals_uint64 (ts, 4 * GST_SECOND);
+
+  /* the last segment of a run snaps to the next run */
+  ret = gst_mpd_client_stream_seek (mpdclient, activeStream, TRUE,
+      GST_SEEK_FLAG_SNAP_AFTER, 7 * GST_SECOND, &ts);
+  assert_equals_int (ret, TRUE);
+  assert_equals_int (activeStream->segment_index, 1);
+  assert_equals_int (activeStream->segment_repeat_index, 0);
+  assert_equals_uint64 (ts, 8 * GST_SECOND);
+
+  ret = gst_mpd_client_stream_seek (mpdclient, activeStream, TRUE,
+      GST_SEEK_FLAG_SNAP_AFTER, 5 * GST_SECOND, &ts);
+  assert_equals_int (ret, TRUE);
+  assert_equals_int (activeStream->segment_index, 0);
+  assert_equals_int (activeStream->segment_repeat_index, 3);
+  assert_equals_uint64 (ts, 6 * GST_SECOND);
+
+  ret = gst_mpd_client_stream_seek (mpdclient, activeStream, TRUE, 0,
+      12 * GST_SECOND, &ts);
+  assert_equals_int (ret, FALSE);
+
+  gst_mpd_client_free (mpdclient);
+}
+
+GST_END_TEST;
+
 /*
  * Test SegmentList with multiple inherited segmentURLs
  *
@@ -6094,6 +6437,10 @@ dash_suite (void)
   tcase_add_test (tc_complexMPD, dash_mpdparser_segment_list);
   tcase_add_test (tc_complexMPD, dash_mpdparser_segment_template);
   tcase_add_test (tc_complexMPD, dash_mpdparser_segment_timeline);
+  tcase_add_test (tc_complexMPD, dash_mpdparser_segment_timeline_update);
+  tcase_add_test (tc_complexMPD,
+      dash_mpdparser_segment_timeline_update_resume);
+  tcase_add_test (tc_complexMPD, dash_mpdparser_segment_timeline_runs);
   tcase_add_test (tc_complexMPD, dash_mpdparser_multiple_inherited_segmentURL);
 
   /* tests checking the parsing of missing/incomplete attributes of xml */
@@ -0,0 +1,223 @@
+/* GStreamer
+ *
+ * unit test for the geometrictransform elements
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
+#include <math.h>
+
+/* odd sizes, so that the RGB rows are padded */
+#define WIDTH 61
+#define HEIGHT 47
+#define ANGLE 0.3
+
+static void
+fill_frame (const GstVideoInfo * info, guint8 * data)
+{
+  gint x, y, c;
+
+  for (y = 0; y < HEIGHT; y++) {
+    guint8 *row = data + y * GST_VIDEO_INFO_PLANE_STRIDE (info, 0);
+
+    for (x = 0; x < WIDTH; x++)
+      for (c = 0; c < GST_VIDEO_INFO_COMP_PSTRIDE (info, 0); c++)
+        row[x * GST_VIDEO_INFO_COMP_PSTRIDE (info, 0) + c] =
+            x * 3 + y * 5 + c * 50;
+  }
+}
+
+/* gst_gm_mod_float() */
+static gdouble
+mod_float (gdouble a, gdouble b)
+{
+  gint n = (gint) (a / b);
+
+  a -= n * b;
+  if (a < 0)
+    return a + b;
+  return a;
+}
+
+/* What rotate output before the map was made of fixed-point entries: the
+ * inverse map in doubles, the off edge pixels handled when applying it,
+ * and the input position truncated */
+static void
+reference_rotate (const GstVideoInfo * info, const gchar * off_edge_pixels,
+    const guint8 * in_data, guint8 * out_data)
+{
+  gint stride = GST_VIDEO_INFO_PLANE_STRIDE (info, 0);
+  gint ps = GST_VIDEO_INFO_COMP_PSTRIDE (info, 0);
+  gdouble cx = 0.5 * WIDTH, cy = 0.5 * HEIGHT;
+  gint x, y;
+
+  memset (out_data, 0, GST_VIDEO_INFO_SIZE (info));
+
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x++) {
+      gdouble xo = x - cx, yo = y - cy;
+      gdouble ai = atan2 (yo, xo) + ANGLE;
+      gdouble r = sqrt (xo * xo + yo * yo);
+      gdouble in_x = r * cos (ai) + cx;
+      gdouble in_y = r * sin (ai) + cy;
+      gint trunc_x, trunc_y;
+
+      if (g_str_equal (off_edge_pixels, "clamp")) {
+        in_x = CLAMP (in_x, 0, WIDTH - 1);
+        in_y = CLAMP (in_y, 0, HEIGHT - 1);
+      } else if (g_str_equal (off_edge_pixels, "wrap")) {
+        in_x = mod_float (in_x, WIDTH);
+        in_y = mod_float (in_y, HEIGHT);
+        if (in_x < 0)
+          in_x += WIDTH;
+        if (in_y < 0)
+          in_y += HEIGHT;
+      }
+
+      trunc_x = (gint) in_x;
+      trunc_y = (gint) in_y;
+      if (trunc_x >= 0 && trunc_x < WIDTH && trunc_y >= 0 && trunc_y < HEIGHT)
+        memcpy (out_data + y * stride + x * ps,
+            in_data + trunc_y * stride + trunc_x * ps, ps);
+    }
+  }
+}
+
+/* Runs the fixed frame through rotate and returns the output */
+static GstBuffer *
+rotate_frame (const GstVideoInfo * info, const guint8 * in_data,
+    const gchar * off_edge_pixels, const gchar * interpolation,
+    guint n_threads)
+{
+  GstHarness *h = gst_harness_new ("rotate");
+  GstBuffer *buf;
+
+  g_object_set (h->element, "angle", ANGLE, "n-threads", n_threads, NULL);
+  gst_util_set_object_arg (G_OBJECT (h->element), "off-edge-pixels",
+      off_edge_pixels);
+  gst_util_set_object_arg (G_OBJECT (h->element), "interpolation",
+      interpolation);
+  gst_harness_set_src_caps (h, gst_video_info_to_caps ((GstVideoInfo *) info));
+
+  buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (info), NULL);
+  gst_buffer_fill (buf, 0, in_data, GST_VIDEO_INFO_SIZE (info));
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+  buf = gst_harness_pull (h);
+  fail_unless (buf != NULL);
+  fail_unless_equals_int (gst_buffer_get_size (buf), GST_VIDEO_INFO_SIZE (info));
+
+  gst_harness_teardown (h);
+
+  return buf;
+}
+
+static void
+check_nearest (GstVideoFormat format)
+{
+  const gchar *modes[] = { "ignore", "clamp", "wrap" };
+  GstVideoInfo info;
+  guint8 *in_data, *ref_data;
+  guint i, n_threads;
+
+  gst_video_info_set_format (&info, format, WIDTH, HEIGHT);
+  in_data = g_malloc0 (GST_VIDEO_INFO_SIZE (&info));
+  ref_data = g_malloc (GST_VIDEO_INFO_SIZE (&info));
+  fill_frame (&info, in_data);
+
+  for (i = 0; i < G_N_ELEMENTS (modes); i++) {
+    reference_rotate (&info, modes[i], in_data, ref_data);
+
+    for (n_threads = 1; n_threads <= 3; n_threads += 2) {
+      GstBuffer *buf =
+          rotate_frame (&info, in_data, modes[i], "nearest", n_threads);
+
+      fail_unless (gst_buffer_memcmp (buf, 0, ref_data,
+              GST_VIDEO_INFO_SIZE (&info)) == 0,
+          "%s output differs with %u threads", modes[i], n_threads);
+      gst_buffer_unref (buf);
+    }
+  }
+
+  g_free (in_data);
+  g_free (ref_data);
+}
+
+GST_START_TEST (test_nearest_unchanged_4_bytes)
+{
+  check_nearest (GST_VIDEO_FORMAT_BGRx);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_nearest_unchanged_3_bytes)
+{
+  check_nearest (GST_VIDEO_FORMAT_RGB);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_bilinear_threads)
+{
+  const GstVideoFormat formats[] = { GST_VIDEO_FORMAT_BGRx,
+    GST_VIDEO_FORMAT_RGB
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    GstVideoInfo info;
+    GstBuffer *single, *threaded;
+    GstMapInfo map;
+    guint8 *in_data;
+
+    gst_video_info_set_format (&info, formats[i], WIDTH, HEIGHT);
+    in_data = g_malloc0 (GST_VIDEO_INFO_SIZE (&info));
+    fill_frame (&info, in_data);
+
+    /* the bands of rows are interpolated exactly like the whole frame */
+    single = rotate_frame (&info, in_data, "clamp", "bilinear", 1);
+    threaded = rotate_frame (&info, in_data, "clamp", "bilinear", 4);
+
+    fail_unless (gst_buffer_map (single, &map, GST_MAP_READ));
+    fail_unless (gst_buffer_memcmp (threaded, 0, map.data, map.size) == 0);
+    gst_buffer_unmap (single, &map);
+
+    gst_buffer_unref (single);
+    gst_buffer_unref (threaded);
+    g_free (in_data);
+  }
+}
+
+GST_END_TEST;
+
+static Suite *
+geometrictransform_suite (void)
+{
+  Suite *s = suite_create ("geometrictransform");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_nearest_unchanged_4_bytes);
+  tcase_add_test (tc_chain, test_nearest_unchanged_3_bytes);
+  tcase_add_test (tc_chain, test_bilinear_threads);
+
+  return s;
+}
+
+GST_CHECK_MAIN (geometrictransform);
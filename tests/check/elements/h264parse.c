@@ -566,6 +566,179 @@ GST_START_TEST (test_parse_sei_closedcaptions)
 
 GST_END_TEST;
 
+/* large enough for h264parse to share the NAL instead of copying it */
+#define LARGE_NAL_SIZE 4096
+
+#define H264_AVC_CAPS "video/x-h264, stream-format=(string)avc," \
+    " alignment=(string)au," \
+    " codec_data=(buffer)014d4015ffe10017674d4015eca4bf2e0220000003002ee6b28001e2c5b2c001000468ebecb2"
+
+/* a LARGE_NAL_SIZE IDR slice, or filler data NAL, behind a start code or,
+ * for avc, a NAL length */
+static GstBuffer *
+create_large_nal_buffer (gboolean avc, gboolean filler)
+{
+  GstBuffer *buf = gst_buffer_new_and_alloc (4 + LARGE_NAL_SIZE);
+  GstMapInfo map;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  if (filler) {
+    memcpy (map.data, h264_idrframe, 4);
+    map.data[4] = 0x0c;
+    memset (map.data + 5, 0xff, map.size - 5);
+  } else {
+    memcpy (map.data, h264_idrframe, sizeof (h264_idrframe));
+    memset (map.data + sizeof (h264_idrframe), 0x55,
+        map.size - sizeof (h264_idrframe));
+  }
+  map.data[map.size - 1] = 0x80;
+  if (avc)
+    GST_WRITE_UINT32_BE (map.data, LARGE_NAL_SIZE);
+  gst_buffer_unmap (buf, &map);
+
+  return buf;
+}
+
+/* whether some memory of @buf is @mem or a share of it */
+static gboolean
+buffer_shares_memory (GstBuffer * buf, GstMemory * mem)
+{
+  guint i;
+
+  for (i = 0; i < gst_buffer_n_memory (buf); i++) {
+    GstMemory *m = gst_buffer_peek_memory (buf, i);
+
+    if (m == mem || m->parent == mem)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/* whether @buf ends with the data of @expected */
+static gboolean
+buffer_ends_with (GstBuffer * buf, GstBuffer * expected)
+{
+  gsize size = gst_buffer_get_size (buf);
+  GstMapInfo map;
+  gboolean ret;
+
+  fail_unless (gst_buffer_map (expected, &map, GST_MAP_READ));
+  ret = size >= map.size
+      && gst_buffer_memcmp (buf, size - map.size, map.data, map.size) == 0;
+  gst_buffer_unmap (expected, &map);
+
+  return ret;
+}
+
+GST_START_TEST (test_parse_config_interval_shares_memory)
+{
+  GstHarness *h;
+  GstBuffer *buf, *pps, *idr;
+  GstMemory *mem;
+
+  h = gst_harness_new_parse ("h264parse config-interval=-1");
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-h264, stream-format=(string)byte-stream, alignment=(string)au");
+  gst_harness_set_sink_caps_str (h,
+      "video/x-h264, stream-format=(string)byte-stream, alignment=(string)au");
+
+  buf = gst_buffer_new_and_alloc (sizeof (h264_sps));
+  gst_buffer_fill (buf, 0, h264_sps, sizeof (h264_sps));
+  pps = gst_buffer_new_and_alloc (sizeof (h264_pps));
+  gst_buffer_fill (pps, 0, h264_pps, sizeof (h264_pps));
+  buf = gst_buffer_append (buf, pps);
+  buf = gst_buffer_append (buf, create_large_nal_buffer (FALSE, FALSE));
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  gst_buffer_unref (gst_harness_pull (h));
+
+  /* SPS and PPS are inserted in front of this one */
+  idr = create_large_nal_buffer (FALSE, FALSE);
+  mem = gst_memory_ref (gst_buffer_peek_memory (idr, 0));
+  fail_unless_equals_int (gst_harness_push (h, gst_buffer_ref (idr)),
+      GST_FLOW_OK);
+
+  buf = gst_harness_pull (h);
+  fail_unless (gst_buffer_get_size (buf) >= sizeof (h264_sps) +
+      sizeof (h264_pps) + gst_buffer_get_size (idr));
+  fail_unless (buffer_ends_with (buf, idr));
+  fail_unless (buffer_shares_memory (buf, mem));
+  gst_buffer_unref (buf);
+
+  gst_memory_unref (mem);
+  gst_buffer_unref (idr);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_parse_avc_to_bs_shares_memory)
+{
+  GstHarness *h;
+  GstBuffer *buf, *in, *expected;
+  GstMemory *mem;
+
+  h = gst_harness_new ("h264parse");
+
+  gst_harness_set_src_caps_str (h, H264_AVC_CAPS);
+  gst_harness_set_sink_caps_str (h,
+      "video/x-h264, stream-format=(string)byte-stream, alignment=(string)au");
+
+  in = create_large_nal_buffer (TRUE, FALSE);
+  mem = gst_memory_ref (gst_buffer_peek_memory (in, 0));
+  fail_unless_equals_int (gst_harness_push (h, in), GST_FLOW_OK);
+
+  /* the codec_data SPS and PPS come in front of the converted slice */
+  buf = gst_harness_pull (h);
+  expected = create_large_nal_buffer (FALSE, FALSE);
+  fail_unless (gst_buffer_get_size (buf) >= sizeof (h264_sps) +
+      sizeof (h264_pps) + gst_buffer_get_size (expected));
+  fail_unless (buffer_ends_with (buf, expected));
+  fail_unless (buffer_shares_memory (buf, mem));
+  gst_buffer_unref (expected);
+  gst_buffer_unref (buf);
+
+  gst_memory_unref (mem);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_parse_many_nals_shares_memory)
+{
+  GstHarness *h;
+  GstBuffer *buf, *in;
+  GstMemory *mem;
+  guint i;
+
+  h = gst_harness_new ("h264parse");
+
+  gst_harness_set_src_caps_str (h, H264_AVC_CAPS);
+  gst_harness_set_sink_caps_str (h, H264_AVC_CAPS);
+
+  /* more large NALs than a buffer can hold memories: sharing all of them
+   * would have the output merged into a single copy */
+  in = create_large_nal_buffer (TRUE, FALSE);
+  for (i = 0; i < gst_buffer_get_max_memory (); i++)
+    in = gst_buffer_append (in, create_large_nal_buffer (TRUE, TRUE));
+  mem = gst_memory_ref (gst_buffer_peek_memory (in, 0));
+  fail_unless_equals_int (gst_harness_push (h, gst_buffer_ref (in)),
+      GST_FLOW_OK);
+
+  buf = gst_harness_pull (h);
+  fail_unless_equals_int (gst_buffer_get_size (buf), gst_buffer_get_size (in));
+  fail_unless (buffer_ends_with (buf, in));
+  fail_unless (buffer_shares_memory (buf, mem));
+  gst_buffer_unref (buf);
+
+  gst_memory_unref (mem);
+  gst_buffer_unref (in);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 /*
  * TODO:
  *   - Both push- and pull-modes need to be tested
@@ -669,6 +842,9 @@ main (int argc, char **argv)
     s = suite_create ("h264parse");
     suite_add_tcase (s, tc_chain);
     tcase_add_test (tc_chain, test_parse_sei_closedcaptions);
+    tcase_add_test (tc_chain, test_parse_config_interval_shares_memory);
+    tcase_add_test (tc_chain, test_parse_avc_to_bs_shares_memory);
+    tcase_add_test (tc_chain, test_parse_many_nals_shares_memory);
     nf += gst_check_run_suite (s, "h264parse", __FILE__);
   }
 
@@ -0,0 +1,252 @@
+/* GStreamer
+ *
+ * unit test for h265parse
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/check.h>
+#include <gst/codecparsers/gsth265parser.h>
+
+/* 64x64 main profile */
+
+/* VPS */
+static guint8 h265_vps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x40, 0x01, 0x0c, 0x01,
+  0xff, 0xff, 0x01, 0x60, 0x00, 0x00, 0x03, 0x00,
+  0x90, 0x00, 0x00, 0x03, 0x00, 0x00, 0x03, 0x00,
+  0x5d, 0xac, 0x09
+};
+
+/* SPS */
+static guint8 h265_sps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x42, 0x01, 0x01, 0x01,
+  0x60, 0x00, 0x00, 0x03, 0x00, 0x90, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x03, 0x00, 0x5d, 0xa0, 0x20,
+  0x81, 0x05, 0x96, 0xb9, 0x24, 0xc2, 0x08
+};
+
+/* PPS */
+static guint8 h265_pps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x44, 0x01, 0xc0, 0x71,
+  0x80, 0x12
+};
+
+/* IDR_W_RADL slice header, the slice data is made up by the tests */
+static guint8 h265_idr_slice_header[] = {
+  0x00, 0x00, 0x00, 0x01, 0x26, 0x01, 0xaf
+};
+
+/* the VPS, SPS and PPS above as codec-data */
+#define H265_HVC1_CAPS "video/x-h265, stream-format=(string)hvc1," \
+    " alignment=(string)au," \
+    " codec_data=(buffer)0101600000009000000000005df000fcfdf8f800000f03a00001001740010c01ffff01600000030090000003000003005dac09a10001001b42010101600000030090000003000003005da020810596b924c208a2000100064401c0718012"
+
+/* large enough for h265parse to share the NAL instead of copying it */
+#define LARGE_NAL_SIZE 4096
+
+/* a LARGE_NAL_SIZE IDR slice, or filler data NAL, behind a start code or,
+ * for hvc1, a NAL length */
+static GstBuffer *
+create_large_nal_buffer (gboolean hvc1, gboolean filler)
+{
+  GstBuffer *buf = gst_buffer_new_and_alloc (4 + LARGE_NAL_SIZE);
+  GstMapInfo map;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  if (filler) {
+    memcpy (map.data, h265_idr_slice_header, 4);
+    map.data[4] = GST_H265_NAL_FD << 1;
+    map.data[5] = 0x01;
+    memset (map.data + 6, 0xff, map.size - 6);
+  } else {
+    memcpy (map.data, h265_idr_slice_header, sizeof (h265_idr_slice_header));
+    memset (map.data + sizeof (h265_idr_slice_header), 0x55,
+        map.size - sizeof (h265_idr_slice_header));
+  }
+  map.data[map.size - 1] = 0x80;
+  if (hvc1)
+    GST_WRITE_UINT32_BE (map.data, LARGE_NAL_SIZE);
+  gst_buffer_unmap (buf, &map);
+
+  return buf;
+}
+
+static GstBuffer *
+create_buffer (const guint8 * data, gsize size)
+{
+  GstBuffer *buf = gst_buffer_new_and_alloc (size);
+
+  gst_buffer_fill (buf, 0, data, size);
+
+  return buf;
+}
+
+/* whether some memory of @buf is @mem or a share of it */
+static gboolean
+buffer_shares_memory (GstBuffer * buf, GstMemory * mem)
+{
+  guint i;
+
+  for (i = 0; i < gst_buffer_n_memory (buf); i++) {
+    GstMemory *m = gst_buffer_peek_memory (buf, i);
+
+    if (m == mem || m->parent == mem)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
+/* whether @buf ends with the data of @expected */
+static gboolean
+buffer_ends_with (GstBuffer * buf, GstBuffer * expected)
+{
+  gsize size = gst_buffer_get_size (buf);
+  GstMapInfo map;
+  gboolean ret;
+
+  fail_unless (gst_buffer_map (expected, &map, GST_MAP_READ));
+  ret = size >= map.size
+      && gst_buffer_memcmp (buf, size - map.size, map.data, map.size) == 0;
+  gst_buffer_unmap (expected, &map);
+
+  return ret;
+}
+
+GST_START_TEST (test_parse_config_interval_shares_memory)
+{
+  GstHarness *h;
+  GstBuffer *buf, *idr;
+  GstMemory *mem;
+
+  h = gst_harness_new_parse ("h265parse config-interval=-1");
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-h265, stream-format=(string)byte-stream, alignment=(string)au");
+  gst_harness_set_sink_caps_str (h,
+      "video/x-h265, stream-format=(string)byte-stream, alignment=(string)au");
+
+  buf = create_buffer (h265_vps, sizeof (h265_vps));
+  buf = gst_buffer_append (buf, create_buffer (h265_sps, sizeof (h265_sps)));
+  buf = gst_buffer_append (buf, create_buffer (h265_pps, sizeof (h265_pps)));
+  buf = gst_buffer_append (buf, create_large_nal_buffer (FALSE, FALSE));
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+
+  /* VPS, SPS and PPS are inserted in front of this one */
+  idr = create_large_nal_buffer (FALSE, FALSE);
+  mem = gst_memory_ref (gst_buffer_peek_memory (idr, 0));
+  fail_unless_equals_int (gst_harness_push (h, gst_buffer_ref (idr)),
+      GST_FLOW_OK);
+  /* the end of the last AU is only known once drained */
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+
+  gst_buffer_unref (gst_harness_pull (h));
+  buf = gst_harness_pull (h);
+  fail_unless_equals_int (gst_buffer_get_size (buf), sizeof (h265_vps) +
+      sizeof (h265_sps) + sizeof (h265_pps) + gst_buffer_get_size (idr));
+  fail_unless (buffer_ends_with (buf, idr));
+  fail_unless (buffer_shares_memory (buf, mem));
+  gst_buffer_unref (buf);
+
+  gst_memory_unref (mem);
+  gst_buffer_unref (idr);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_parse_hvc1_to_bs_shares_memory)
+{
+  GstHarness *h;
+  GstBuffer *buf, *in, *expected;
+  GstMemory *mem;
+
+  h = gst_harness_new ("h265parse");
+
+  gst_harness_set_src_caps_str (h, H265_HVC1_CAPS);
+  gst_harness_set_sink_caps_str (h,
+      "video/x-h265, stream-format=(string)byte-stream, alignment=(string)au");
+
+  in = create_large_nal_buffer (TRUE, FALSE);
+  mem = gst_memory_ref (gst_buffer_peek_memory (in, 0));
+  fail_unless_equals_int (gst_harness_push (h, in), GST_FLOW_OK);
+
+  /* the codec_data VPS, SPS and PPS come in front of the converted slice */
+  buf = gst_harness_pull (h);
+  expected = create_large_nal_buffer (FALSE, FALSE);
+  fail_unless_equals_int (gst_buffer_get_size (buf), sizeof (h265_vps) +
+      sizeof (h265_sps) + sizeof (h265_pps) + gst_buffer_get_size (expected));
+  fail_unless (buffer_ends_with (buf, expected));
+  fail_unless (buffer_shares_memory (buf, mem));
+  gst_buffer_unref (expected);
+  gst_buffer_unref (buf);
+
+  gst_memory_unref (mem);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_parse_many_nals_shares_memory)
+{
+  GstHarness *h;
+  GstBuffer *buf, *in;
+  GstMemory *mem;
+  guint i;
+
+  h = gst_harness_new ("h265parse");
+
+  gst_harness_set_src_caps_str (h, H265_HVC1_CAPS);
+  gst_harness_set_sink_caps_str (h, H265_HVC1_CAPS);
+
+  /* more large NALs than a buffer can hold memories: sharing all of them
+   * would have the output merged into a single copy */
+  in = create_large_nal_buffer (TRUE, FALSE);
+  for (i = 0; i < gst_buffer_get_max_memory (); i++)
+    in = gst_buffer_append (in, create_large_nal_buffer (TRUE, TRUE));
+  mem = gst_memory_ref (gst_buffer_peek_memory (in, 0));
+  fail_unless_equals_int (gst_harness_push (h, gst_buffer_ref (in)),
+      GST_FLOW_OK);
+
+  buf = gst_harness_pull (h);
+  fail_unless_equals_int (gst_buffer_get_size (buf), gst_buffer_get_size (in));
+  fail_unless (buffer_ends_with (buf, in));
+  fail_unless (buffer_shares_memory (buf, mem));
+  gst_buffer_unref (buf);
+
+  gst_memory_unref (mem);
+  gst_buffer_unref (in);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+h265parse_suite (void)
+{
+  Suite *s = suite_create ("h265parse");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_parse_config_interval_shares_memory);
+  tcase_add_test (tc_chain, test_parse_hvc1_to_bs_shares_memory);
+  tcase_add_test (tc_chain, test_parse_many_nals_shares_memory);
+
+  return s;
+}
+
+GST_CHECK_MAIN (h265parse);
@@ -726,6 +726,286 @@ GST_START_TEST (testFragmentDownloadError)
 
 GST_END_TEST;
 
+typedef struct _GstHlsDemuxTestPrefetchContext
+{
+  GstHlsDemuxTestCase *hls_test_case;
+  GstAdaptiveDemuxTestCase *engine_test_data;
+  GstAdaptiveDemuxTestExpectedOutput *output;
+
+  /* protects the request list in hls_test_case->state, the http source
+   * callbacks are called from the prefetch threads too */
+  GMutex lock;
+  GCond cond;
+  gboolean prefetch_requested;
+  gboolean requested_ahead;
+} GstHlsDemuxTestPrefetchContext;
+
+static guint
+gst_hlsdemux_test_count_requests (const GstHlsDemuxTestCase * test_case,
+    const gchar * uri)
+{
+  const GValue *requests;
+  guint i, count = 0;
+
+  requests = gst_structure_get_value (test_case->state, "requests");
+  if (!requests)
+    return 0;
+
+  for (i = 0; i < gst_value_array_get_size (requests); ++i) {
+    const GValue *request = gst_value_array_get_value (requests, i);
+
+    if (g_strcmp0 (g_value_get_string (request), uri) == 0)
+      count++;
+  }
+  return count;
+}
+
+static gboolean
+gst_hlsdemux_test_prefetch_src_start (GstTestHTTPSrc * src,
+    const gchar * uri, GstTestHTTPSrcInput * input_data, gpointer user_data)
+{
+  GstHlsDemuxTestPrefetchContext *context =
+      (GstHlsDemuxTestPrefetchContext *) user_data;
+  gboolean ret;
+
+  g_mutex_lock (&context->lock);
+  ret = gst_hlsdemux_test_src_start (src, uri, input_data,
+      context->hls_test_case);
+  if (gst_hlsdemux_test_count_requests (context->hls_test_case,
+          "http://unit.test/002.ts") > 0
+      && gst_hlsdemux_test_count_requests (context->hls_test_case,
+          "http://unit.test/003.ts") > 0) {
+    context->prefetch_requested = TRUE;
+    g_cond_broadcast (&context->cond);
+  }
+  g_mutex_unlock (&context->lock);
+
+  return ret;
+}
+
+static GstFlowReturn
+gst_hlsdemux_test_prefetch_src_create (GstTestHTTPSrc * src,
+    guint64 offset,
+    guint length, GstBuffer ** retbuf, gpointer context, gpointer user_data)
+{
+  GstHlsDemuxTestPrefetchContext *prefetch_context =
+      (GstHlsDemuxTestPrefetchContext *) user_data;
+  GstHlsDemuxTestInputData *input = (GstHlsDemuxTestInputData *) context;
+
+  /* Hold back the first fragment until the following two were requested,
+   * so they are known to be downloaded ahead of their turn */
+  if (offset == 0 && g_str_has_suffix (input->uri, "/001.ts")) {
+    gint64 end_time = g_get_monotonic_time () + 5 * G_TIME_SPAN_SECOND;
+
+    g_mutex_lock (&prefetch_context->lock);
+    while (!prefetch_context->prefetch_requested) {
+      if (!g_cond_wait_until (&prefetch_context->cond, &prefetch_context->lock,
+              end_time))
+        break;
+    }
+    prefetch_context->requested_ahead = prefetch_context->prefetch_requested;
+    g_mutex_unlock (&prefetch_context->lock);
+  }
+
+  return gst_hlsdemux_test_src_create (src, offset, length, retbuf, context,
+      prefetch_context->hls_test_case);
+}
+
+static void
+gst_hlsdemux_test_prefetch_pre_test (GstAdaptiveDemuxTestEngine * engine,
+    gpointer user_data)
+{
+  g_object_set (engine->demux, "prefetch-fragments", 2, NULL);
+}
+
+/* The fragments differ in the continuity counters of their packets and the
+ * expected data is all of them concatenated, so fragments pushed out of
+ * order don't match. The offset is counted over the whole stream as the
+ * segment_start of the engine only restarts for regular downloads, not for
+ * prefetched fragments */
+static gboolean
+gst_hlsdemux_test_prefetch_check_received_data (GstAdaptiveDemuxTestEngine *
+    engine, GstAdaptiveDemuxTestOutputStream * stream, GstBuffer * buffer,
+    gpointer user_data)
+{
+  GstHlsDemuxTestPrefetchContext *context =
+      (GstHlsDemuxTestPrefetchContext *) user_data;
+  guint64 offset = stream->total_received_size + stream->segment_received_size;
+  gsize size = gst_buffer_get_size (buffer);
+
+  fail_unless (offset + size <= context->output->expected_size);
+  fail_unless (gst_buffer_memcmp (buffer, 0,
+          context->output->expected_data + offset, size) == 0,
+      "Received data at offset %" G_GUINT64_FORMAT " doesn't match", offset);
+
+  return TRUE;
+}
+
+static void
+gst_hlsdemux_test_prefetch_eos (GstAdaptiveDemuxTestEngine * engine,
+    GstAdaptiveDemuxTestOutputStream * stream, gpointer user_data)
+{
+  GstHlsDemuxTestPrefetchContext *context =
+      (GstHlsDemuxTestPrefetchContext *) user_data;
+
+  gst_adaptive_demux_test_check_size_of_received_data (engine, stream,
+      context->engine_test_data);
+}
+
+/*
+ * Test that the following fragments are downloaded while the current one is
+ * and that all of them are pushed in order, each downloaded only once
+ */
+GST_START_TEST (testPrefetchFragments)
+{
+  const guint segment_size = 30 * TS_PACKET_LEN;
+  const gchar *manifest =
+      "#EXTM3U \n"
+      "#EXT-X-TARGETDURATION:1\n"
+      "#EXTINF:1,Test\n" "001.ts\n"
+      "#EXTINF:1,Test\n" "002.ts\n"
+      "#EXTINF:1,Test\n" "003.ts\n"
+      "#EXTINF:1,Test\n" "004.ts\n" "#EXT-X-ENDLIST\n";
+  GstHlsDemuxTestInputData inputTestData[] = {
+    {"http://unit.test/media.m3u8", (guint8 *) manifest, 0},
+    {"http://unit.test/001.ts", NULL, segment_size},
+    {"http://unit.test/002.ts", NULL, segment_size},
+    {"http://unit.test/003.ts", NULL, segment_size},
+    {"http://unit.test/004.ts", NULL, segment_size},
+    {NULL, NULL, 0},
+  };
+  GstAdaptiveDemuxTestExpectedOutput outputTestData[] = {
+    {"src_0", 4 * segment_size, NULL},
+    {NULL, 0, NULL}
+  };
+  GstHlsDemuxTestPrefetchContext context = { 0 };
+  guint i;
+  TESTCASE_INIT_BOILERPLATE (0);
+
+  mpeg_ts = generate_transport_stream (4 * segment_size);
+  fail_unless (mpeg_ts != NULL);
+  for (i = 0; i < 4; ++i)
+    inputTestData[i + 1].payload = mpeg_ts->data + i * segment_size;
+  outputTestData[0].expected_data = mpeg_ts->data;
+  engineTestData->output_streams =
+      g_list_append (engineTestData->output_streams, &outputTestData[0]);
+
+  context.hls_test_case = &hlsTestCase;
+  context.engine_test_data = engineTestData;
+  context.output = &outputTestData[0];
+  g_mutex_init (&context.lock);
+  g_cond_init (&context.cond);
+
+  http_src_callbacks.src_start = gst_hlsdemux_test_prefetch_src_start;
+  http_src_callbacks.src_create = gst_hlsdemux_test_prefetch_src_create;
+  engine_callbacks.pre_test = gst_hlsdemux_test_prefetch_pre_test;
+  engine_callbacks.appsink_received_data =
+      gst_hlsdemux_test_prefetch_check_received_data;
+  engine_callbacks.appsink_eos = gst_hlsdemux_test_prefetch_eos;
+
+  gst_test_http_src_install_callbacks (&http_src_callbacks, &context);
+  gst_adaptive_demux_test_run (DEMUX_ELEMENT_NAME,
+      inputTestData[0].uri, &engine_callbacks, &context);
+
+  fail_unless (context.requested_ahead,
+      "The following fragments were not requested ahead of time");
+  for (i = 1; inputTestData[i].uri; ++i) {
+    assert_equals_int (gst_hlsdemux_test_count_requests (&hlsTestCase,
+            inputTestData[i].uri), 1);
+  }
+
+  g_cond_clear (&context.cond);
+  g_mutex_clear (&context.lock);
+  TESTCASE_UNREF_BOILERPLATE;
+}
+
+GST_END_TEST;
+
+/*
+ * Test that prefetched fragments are dropped on seek: the fragments after
+ * the seek position are downloaded again, even those that were prefetched
+ * before the seek
+ */
+GST_START_TEST (testPrefetchFragmentsSeek)
+{
+  const guint segment_size = 60 * TS_PACKET_LEN;
+  const gchar *manifest =
+      "#EXTM3U \n"
+      "#EXT-X-TARGETDURATION:1\n"
+      "#EXTINF:1,Test\n" "001.ts\n"
+      "#EXTINF:1,Test\n" "002.ts\n"
+      "#EXTINF:1,Test\n" "003.ts\n"
+      "#EXTINF:1,Test\n" "004.ts\n" "#EXT-X-ENDLIST\n";
+  GstHlsDemuxTestInputData inputTestData[] = {
+    {"http://unit.test/media.m3u8", (guint8 *) manifest, 0},
+    {"http://unit.test/001.ts", NULL, segment_size},
+    {"http://unit.test/002.ts", NULL, segment_size},
+    {"http://unit.test/003.ts", NULL, segment_size},
+    {"http://unit.test/004.ts", NULL, segment_size},
+    {NULL, NULL, 0},
+  };
+  GstAdaptiveDemuxTestExpectedOutput outputTestData[] = {
+    {"src_0", 3 * segment_size, NULL},
+    {NULL, 0, NULL}
+  };
+  GstTestHTTPSrcCallbacks http_src_callbacks = { 0 };
+  GstAdaptiveDemuxTestCase *engineTestData;
+  GstHlsDemuxTestCase hlsTestCase = { 0 };
+  GstHlsDemuxTestPrefetchContext context = { 0 };
+  GByteArray *mpeg_ts = NULL;
+
+  engineTestData = gst_adaptive_demux_test_case_new ();
+  mpeg_ts = setup_test_variables (__FUNCTION__, inputTestData, outputTestData,
+      &hlsTestCase, engineTestData, segment_size);
+
+  context.hls_test_case = &hlsTestCase;
+  g_mutex_init (&context.lock);
+  g_cond_init (&context.cond);
+
+  http_src_callbacks.src_start = gst_hlsdemux_test_prefetch_src_start;
+  http_src_callbacks.src_create = gst_hlsdemux_test_prefetch_src_create;
+
+  /* FIXME hack to avoid having a 0 seqnum */
+  gst_util_seqnum_next ();
+
+  /* Seek to 1.5s while the first fragment is pushed, with the next two
+   * prefetched. It should start again from the 1s fragment */
+  engineTestData->demux_properties = gst_structure_new ("properties",
+      "prefetch-fragments", G_TYPE_UINT, 2, NULL);
+  engineTestData->threshold_for_seek = 20 * TS_PACKET_LEN;
+  engineTestData->seek_event =
+      gst_event_new_seek (1.0, GST_FORMAT_TIME,
+      GST_SEEK_FLAG_FLUSH | GST_SEEK_FLAG_KEY_UNIT, GST_SEEK_TYPE_SET,
+      1500 * GST_MSECOND, GST_SEEK_TYPE_NONE, 0);
+  gst_segment_init (&outputTestData[0].post_seek_segment, GST_FORMAT_TIME);
+  outputTestData[0].post_seek_segment.rate = 1.0;
+  outputTestData[0].post_seek_segment.start = 1000 * GST_MSECOND;
+  outputTestData[0].post_seek_segment.time = 1000 * GST_MSECOND;
+  outputTestData[0].post_seek_segment.stop = -1;
+  outputTestData[0].segment_verification_needed = TRUE;
+
+  gst_test_http_src_install_callbacks (&http_src_callbacks, &context);
+  gst_adaptive_demux_test_seek (DEMUX_ELEMENT_NAME,
+      inputTestData[0].uri, engineTestData);
+
+  fail_unless (context.requested_ahead,
+      "The following fragments were not requested ahead of time");
+  assert_equals_int (gst_hlsdemux_test_count_requests (&hlsTestCase,
+          "http://unit.test/001.ts"), 1);
+  assert_equals_int (gst_hlsdemux_test_count_requests (&hlsTestCase,
+          "http://unit.test/002.ts"), 2);
+  assert_equals_int (gst_hlsdemux_test_count_requests (&hlsTestCase,
+          "http://unit.test/003.ts"), 2);
+  assert_equals_int (gst_hlsdemux_test_count_requests (&hlsTestCase,
+          "http://unit.test/004.ts"), 1);
+
+  g_cond_clear (&context.cond);
+  g_mutex_clear (&context.lock);
+  TESTCASE_UNREF_BOILERPLATE;
+}
+
+GST_END_TEST;
+
 static Suite *
 hls_demux_suite (void)
 {
@@ -745,6 +1025,8 @@ hls_demux_suite (void)
   tcase_add_test (tc_basicTest, testSeekSnapAfterPosition);
   tcase_add_test (tc_basicTest, testReverseSeekSnapBeforePosition);
   tcase_add_test (tc_basicTest, testReverseSeekSnapAfterPosition);
+  tcase_add_test (tc_basicTest, testPrefetchFragments);
+  tcase_add_test (tc_basicTest, testPrefetchFragmentsSeek);
 
   tcase_add_unchecked_fixture (tc_basicTest, gst_adaptive_demux_test_setup,
       gst_adaptive_demux_test_teardown);
@@ -366,7 +366,7 @@ GST_START_TEST (test_load_main_playlist_rendition)
   master = load_playlist (ON_DEMAND_PLAYLIST);
   variant = master->default_variant;
 
-  assert_equals_int (g_list_length (variant->m3u8->files), 4);
+  assert_equals_int (variant->m3u8->files->len, 4);
   assert_equals_int (master->version, 0);
 
   gst_hls_master_playlist_unref (master);
@@ -476,13 +476,14 @@ check_on_demand_playlist (const gchar * data)
   /* Check that we are not live */
   assert_equals_int (gst_m3u8_is_live (pl), FALSE);
   /* Check number of entries */
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_string (file->uri, "http://media.example.com/001.ts");
   assert_equals_int (file->sequence, 0);
   /* Check last media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_last (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files,
+          pl->files->len - 1));
   assert_equals_string (file->uri, "http://media.example.com/004.ts");
   assert_equals_int (file->sequence, 3);
 
@@ -532,14 +533,15 @@ GST_START_TEST (test_live_playlist)
   assert_equals_int (gst_m3u8_is_live (pl), TRUE);
   assert_equals_int (pl->sequence, 2680);
   /* Check number of entries */
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_string (file->uri,
       "https://priv.example.com/fileSequence2680.ts");
   assert_equals_int (file->sequence, 2680);
   /* Check last media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_last (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files,
+          pl->files->len - 1));
   assert_equals_string (file->uri,
       "https://priv.example.com/fileSequence2683.ts");
   assert_equals_int (file->sequence, 2683);
@@ -567,7 +569,7 @@ GST_START_TEST (test_live_playlist_rotated)
 
   assert_equals_int (pl->sequence, 2680);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_int (file->sequence, 2680);
 
   ret = gst_m3u8_update (pl, g_strdup (LIVE_ROTATED_PLAYLIST));
@@ -579,7 +581,7 @@ GST_START_TEST (test_live_playlist_rotated)
   /* FIXME: Sequence should last - 3. Should it? */
   assert_equals_int (pl->sequence, 3001);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_int (file->sequence, 3001);
 
   gst_hls_master_playlist_unref (master);
@@ -599,13 +601,13 @@ GST_START_TEST (test_playlist_with_doubles_duration)
   pl = master->default_variant->m3u8;
 
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 0));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_float (file->duration / (double) GST_SECOND, 10.321);
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 1));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 1));
   assert_equals_float (file->duration / (double) GST_SECOND, 9.6789);
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 2));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 2));
   assert_equals_float (file->duration / (double) GST_SECOND, 10.2344);
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 3));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 3));
   assert_equals_float (file->duration / (double) GST_SECOND, 9.92);
   fail_unless (gst_m3u8_get_seek_range (pl, &start, &stop));
   assert_equals_int64 (start, 0);
@@ -631,26 +633,26 @@ GST_START_TEST (test_playlist_with_encryption)
   master = load_playlist (AES_128_ENCRYPTED_PLAYLIST);
   pl = master->default_variant->m3u8;
 
-  assert_equals_int (g_list_length (pl->files), 5);
+  assert_equals_int (pl->files->len, 5);
 
   /* Check all media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 0));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   fail_unless (file->key == NULL);
 
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 1));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 1));
   fail_unless (file->key == NULL);
 
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 2));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 2));
   fail_unless (file->key != NULL);
   assert_equals_string (file->key, "https://priv.example.com/key.bin");
   fail_unless (memcmp (&file->iv, iv2, 16) == 0);
 
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 3));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 3));
   fail_unless (file->key != NULL);
   assert_equals_string (file->key, "https://priv.example.com/key2.bin");
   fail_unless (memcmp (&file->iv, iv1, 16) == 0);
 
-  file = GST_M3U8_MEDIA_FILE (g_list_nth_data (pl->files, 4));
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 4));
   fail_unless (file->key != NULL);
   assert_equals_string (file->key, "https://priv.example.com/key2.bin");
   fail_unless (memcmp (&file->iv, iv1, 16) == 0);
@@ -670,7 +672,7 @@ GST_START_TEST (test_update_invalid_playlist)
   /* Test updates in on-demand playlists */
   master = load_playlist (ON_DEMAND_PLAYLIST);
   pl = master->default_variant->m3u8;
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   ret = gst_m3u8_update (pl, g_strdup ("#INVALID"));
   assert_equals_int (ret, FALSE);
 
@@ -689,26 +691,102 @@ GST_START_TEST (test_update_playlist)
   /* Test updates in on-demand playlists */
   master = load_playlist (ON_DEMAND_PLAYLIST);
   pl = master->default_variant->m3u8;
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   ret = gst_m3u8_update (pl, g_strdup (ON_DEMAND_PLAYLIST));
   assert_equals_int (ret, TRUE);
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   gst_hls_master_playlist_unref (master);
 
   /* Test updates in live playlists */
   master = load_playlist (LIVE_PLAYLIST);
   pl = master->default_variant->m3u8;
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   /* Add a new entry to the playlist and check the update */
   live_pl = g_strdup_printf ("%s\n%s\n%s", LIVE_PLAYLIST, "#EXTINF:8",
       "https://priv.example.com/fileSequence2683.ts");
   ret = gst_m3u8_update (pl, live_pl);
   assert_equals_int (ret, TRUE);
-  assert_equals_int (g_list_length (pl->files), 5);
+  assert_equals_int (pl->files->len, 5);
   /* Test sliding window */
   ret = gst_m3u8_update (pl, g_strdup (LIVE_PLAYLIST));
   assert_equals_int (ret, TRUE);
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
+  gst_hls_master_playlist_unref (master);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_update_playlist_incremental)
+{
+  GstHLSMasterPlaylist *master;
+  GstM3U8 *pl;
+  GstM3U8MediaFile *files[4], *file;
+  gboolean ret;
+  guint i;
+
+  master = load_playlist (LIVE_PLAYLIST);
+  pl = master->default_variant->m3u8;
+  assert_equals_int (pl->files->len, 4);
+  for (i = 0; i < 4; i++)
+    files[i] = g_ptr_array_index (pl->files, i);
+
+  /* Slide the window by one fragment, the known ones are taken over */
+  ret = gst_m3u8_update (pl, g_strdup ("#EXTM3U\n"
+          "#EXT-X-TARGETDURATION:8\n"
+          "#EXT-X-MEDIA-SEQUENCE:2681\n"
+          "#EXTINF:8,\n"
+          "https://priv.example.com/fileSequence2681.ts\n"
+          "#EXTINF:8,\n"
+          "https://priv.example.com/fileSequence2682.ts\n"
+          "#EXTINF:8,\n"
+          "https://priv.example.com/fileSequence2683.ts\n"
+          "#EXTINF:8,\n" "fileSequence2684.ts\n"));
+  assert_equals_int (ret, TRUE);
+  assert_equals_int (pl->files->len, 4);
+  for (i = 0; i < 3; i++)
+    fail_unless (g_ptr_array_index (pl->files, i) == files[i + 1]);
+  file = g_ptr_array_index (pl->files, 3);
+  assert_equals_int (file->sequence, 2684);
+  assert_equals_string (file->uri,
+      "http://localhost/fileSequence2684.ts");
+
+  /* A known sequence number with a different URI is an error */
+  ret = gst_m3u8_update (pl, g_strdup ("#EXTM3U\n"
+          "#EXT-X-TARGETDURATION:8\n"
+          "#EXT-X-MEDIA-SEQUENCE:2683\n"
+          "#EXTINF:8,\n"
+          "https://priv.example.com/ileSequence2683.ts\n"
+          "#EXTINF:8,\n" "fileSequence2684.ts\n"));
+  assert_equals_int (ret, FALSE);
+
+  /* and leaves the previous files in place */
+  assert_equals_int (pl->files->len, 4);
+  for (i = 0; i < 3; i++)
+    fail_unless (g_ptr_array_index (pl->files, i) == files[i + 1]);
+  fail_unless (g_ptr_array_index (pl->files, 3) == file);
+
+  /* After a redirect relative URIs resolve differently, so nothing is
+   * taken over */
+  gst_m3u8_set_uri (pl, "http://redirect.example.com/live/playlist.m3u8",
+      NULL, pl->name);
+  ret = gst_m3u8_update (pl, g_strdup ("#EXTM3U\n"
+          "#EXT-X-TARGETDURATION:8\n"
+          "#EXT-X-MEDIA-SEQUENCE:2682\n"
+          "#EXTINF:8,\n"
+          "https://priv.example.com/fileSequence2682.ts\n"
+          "#EXTINF:8,\n"
+          "https://priv.example.com/fileSequence2683.ts\n"
+          "#EXTINF:8,\n" "fileSequence2684.ts\n"));
+  assert_equals_int (ret, TRUE);
+  assert_equals_int (pl->files->len, 3);
+  fail_if (g_ptr_array_index (pl->files, 0) == files[2]);
+  fail_if (g_ptr_array_index (pl->files, 1) == files[3]);
+  fail_if (g_ptr_array_index (pl->files, 2) == file);
+  file = g_ptr_array_index (pl->files, 2);
+  assert_equals_int (file->sequence, 2684);
+  assert_equals_string (file->uri,
+      "http://redirect.example.com/live/fileSequence2684.ts");
+
   gst_hls_master_playlist_unref (master);
 }
 
@@ -724,9 +802,9 @@ GST_START_TEST (test_playlist_media_files)
   pl = master->default_variant->m3u8;
 
   /* Check number of entries */
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_string (file->uri, "http://media.example.com/001.ts");
   assert_equals_int (file->sequence, 0);
   assert_equals_float (file->duration, 10 * (double) GST_SECOND);
@@ -749,16 +827,17 @@ GST_START_TEST (test_playlist_byte_range_media_files)
   pl = master->default_variant->m3u8;
 
   /* Check number of entries */
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_string (file->uri, "http://media.example.com/all.ts");
   assert_equals_int (file->sequence, 0);
   assert_equals_float (file->duration, 10 * (double) GST_SECOND);
   assert_equals_int (file->offset, 100);
   assert_equals_int (file->size, 1000);
   /* Check last media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_last (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files,
+          pl->files->len - 1));
   assert_equals_string (file->uri, "http://media.example.com/all.ts");
   assert_equals_int (file->sequence, 3);
   assert_equals_float (file->duration, 10 * (double) GST_SECOND);
@@ -772,16 +851,17 @@ GST_START_TEST (test_playlist_byte_range_media_files)
   pl = master->default_variant->m3u8;
 
   /* Check number of entries */
-  assert_equals_int (g_list_length (pl->files), 4);
+  assert_equals_int (pl->files->len, 4);
   /* Check first media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_first (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files, 0));
   assert_equals_string (file->uri, "http://media.example.com/all.ts");
   assert_equals_int (file->sequence, 0);
   assert_equals_float (file->duration, 10 * (double) GST_SECOND);
   assert_equals_int (file->offset, 0);
   assert_equals_int (file->size, 1000);
   /* Check last media segments */
-  file = GST_M3U8_MEDIA_FILE (g_list_last (pl->files)->data);
+  file = GST_M3U8_MEDIA_FILE (g_ptr_array_index (pl->files,
+          pl->files->len - 1));
   assert_equals_string (file->uri, "http://media.example.com/all.ts");
   assert_equals_int (file->sequence, 3);
   assert_equals_float (file->duration, 10 * (double) GST_SECOND);
@@ -1413,8 +1493,9 @@ GST_START_TEST (test_map_tag)
   GstHLSMasterPlaylist *master;
   GstHLSVariantStream *stream;
   GstM3U8 *m3u8;
-  GList *files, *walk;
+  GPtrArray *files;
   GstM3U8MediaFile *seg1, *seg2, *seg3;
+  guint i;
   GstM3U8InitFile *init1, *init2;
 
   /* Test EXT-X-MAP tag
@@ -1434,18 +1515,18 @@ GST_START_TEST (test_map_tag)
 
   files = m3u8->files;
   fail_unless (m3u8 != NULL);
-  assert_equals_int (g_list_length (files), 3);
-  for (walk = files; walk; walk = g_list_next (walk)) {
-    GstM3U8MediaFile *file = (GstM3U8MediaFile *) walk->data;
+  assert_equals_int (files->len, 3);
+  for (i = 0; i < files->len; i++) {
+    GstM3U8MediaFile *file = g_ptr_array_index (files, i);
 
     GstM3U8InitFile *init_file = file->init_file;
     fail_unless (init_file != NULL);
     fail_unless (init_file->uri != NULL);
   }
 
-  seg1 = g_list_nth_data (files, 0);
-  seg2 = g_list_nth_data (files, 1);
-  seg3 = g_list_nth_data (files, 2);
+  seg1 = g_ptr_array_index (files, 0);
+  seg2 = g_ptr_array_index (files, 1);
+  seg3 = g_ptr_array_index (files, 2);
 
   /* Segment 1 and 2 share the identical init segment */
   fail_unless (seg1->init_file == seg2->init_file);
@@ -1495,6 +1576,7 @@ hlsdemux_suite (void)
   tcase_add_test (tc_m3u8, test_playlist_with_encryption);
   tcase_add_test (tc_m3u8, test_update_invalid_playlist);
   tcase_add_test (tc_m3u8, test_update_playlist);
+  tcase_add_test (tc_m3u8, test_update_playlist_incremental);
   tcase_add_test (tc_m3u8, test_playlist_media_files);
   tcase_add_test (tc_m3u8, test_playlist_byte_range_media_files);
   tcase_add_test (tc_m3u8, test_get_next_fragment);
@@ -0,0 +1,210 @@
+/* GStreamer
+ *
+ * unit test for the inter elements' video frame ring
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+
+#include "../../../gst/inter/gstintersurface.c"
+
+#define N_BUFFERS 10
+#define FRAME_DURATION (40 * GST_MSECOND)
+
+static GstInterSurface *surface;
+static GstBuffer *buffers_in[N_BUFFERS];
+
+static void
+setup (guint max_frames)
+{
+  guint i;
+
+  surface = gst_inter_surface_get ("test");
+  surface->video_max_frames = max_frames;
+
+  for (i = 0; i < N_BUFFERS; i++)
+    buffers_in[i] = gst_buffer_new ();
+}
+
+static void
+teardown (void)
+{
+  guint i;
+
+  g_mutex_lock (&surface->mutex);
+  gst_inter_surface_clear_video_frames (surface);
+  fail_unless_equals_int (surface->video_n_frames, 0);
+  g_mutex_unlock (&surface->mutex);
+
+  /* the surface doesn't keep any reference after being cleared */
+  for (i = 0; i < N_BUFFERS; i++) {
+    ASSERT_BUFFER_REFCOUNT (buffers_in[i], "buffer", 1);
+    gst_buffer_unref (buffers_in[i]);
+  }
+
+  gst_inter_surface_unref (surface);
+  surface = NULL;
+}
+
+static void
+push_frames (guint first, guint last)
+{
+  guint i;
+
+  g_mutex_lock (&surface->mutex);
+  for (i = first; i <= last; i++)
+    gst_inter_surface_push_video_frame (surface, buffers_in[i],
+        i * FRAME_DURATION);
+  g_mutex_unlock (&surface->mutex);
+}
+
+/* Checks that the ring holds exactly the frames @first to @last, oldest
+ * first */
+static void
+check_frames (guint first, guint last)
+{
+  guint i;
+
+  g_mutex_lock (&surface->mutex);
+  fail_unless_equals_int (surface->video_n_frames, last - first + 1);
+  for (i = first; i <= last; i++) {
+    GstInterSurfaceFrame *frame =
+        &surface->video_frames[(surface->video_head + i - first) %
+        GST_INTER_SURFACE_VIDEO_FRAMES];
+
+    fail_unless (frame->buffer == buffers_in[i]);
+    fail_unless_equals_uint64 (frame->time, i * FRAME_DURATION);
+  }
+  g_mutex_unlock (&surface->mutex);
+
+  /* the frames that were dropped are not referenced anymore */
+  for (i = 0; i < N_BUFFERS; i++) {
+    if (i < first || i > last)
+      ASSERT_BUFFER_REFCOUNT (buffers_in[i], "buffer", 1);
+    else
+      ASSERT_BUFFER_REFCOUNT (buffers_in[i], "buffer", 2);
+  }
+}
+
+static GstBuffer *
+select_frame (GstClockTime time)
+{
+  GstBuffer *buf;
+
+  g_mutex_lock (&surface->mutex);
+  buf = gst_inter_surface_select_video_frame (surface, time);
+  g_mutex_unlock (&surface->mutex);
+
+  fail_unless (buf != NULL);
+  /* only the caller's reference is returned */
+  gst_buffer_unref (buf);
+
+  return buf;
+}
+
+GST_START_TEST (test_latest_frame_overrun)
+{
+  setup (1);
+
+  /* a single frame is kept, each new one replaces it */
+  push_frames (0, 0);
+  check_frames (0, 0);
+  push_frames (1, 5);
+  check_frames (5, 5);
+
+  fail_unless (select_frame (GST_CLOCK_TIME_NONE) == buffers_in[5]);
+  check_frames (5, 5);
+
+  teardown ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_ring_wrap_around)
+{
+  setup (GST_INTER_SURFACE_VIDEO_FRAMES);
+
+  push_frames (0, 2);
+  check_frames (0, 2);
+
+  /* full, the oldest frames are dropped and the ring wraps around */
+  push_frames (3, 6);
+  check_frames (3, 6);
+  fail_unless (surface->video_head != 0);
+
+  /* taking the newest one drops all the others */
+  fail_unless (select_frame (GST_CLOCK_TIME_NONE) == buffers_in[6]);
+  check_frames (6, 6);
+
+  /* and filling up again wraps around once more */
+  push_frames (7, 9);
+  check_frames (6, 9);
+
+  teardown ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_select_nearest)
+{
+  setup (GST_INTER_SURFACE_VIDEO_FRAMES);
+
+  /* wraps around before selecting */
+  push_frames (0, 5);
+  check_frames (2, 5);
+
+  /* nearest to 3.4 frames is frame 3, frame 2 is dropped */
+  fail_unless (select_frame (3 * FRAME_DURATION + 16 * GST_MSECOND) ==
+      buffers_in[3]);
+  check_frames (3, 5);
+  fail_unless_equals_int (surface->video_buffer_count, 0);
+
+  /* the same frame again doesn't count as new */
+  surface->video_buffer_count = 3;
+  fail_unless (select_frame (3 * FRAME_DURATION) == buffers_in[3]);
+  fail_unless_equals_int (surface->video_buffer_count, 3);
+
+  /* a time past all frames gives the newest one */
+  fail_unless (select_frame (100 * FRAME_DURATION) == buffers_in[5]);
+  check_frames (5, 5);
+  fail_unless_equals_int (surface->video_buffer_count, 0);
+
+  /* frames are never taken back, even when asking for an older time */
+  push_frames (6, 7);
+  fail_unless (select_frame (0) == buffers_in[5]);
+  check_frames (5, 7);
+
+  teardown ();
+}
+
+GST_END_TEST;
+
+static Suite *
+intersurface_suite (void)
+{
+  Suite *s = suite_create ("intersurface");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_latest_frame_overrun);
+  tcase_add_test (tc_chain, test_ring_wrap_around);
+  tcase_add_test (tc_chain, test_select_nearest);
+
+  return s;
+}
+
+GST_CHECK_MAIN (intersurface);
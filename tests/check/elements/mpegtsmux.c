@@ -449,6 +449,112 @@ GST_START_TEST (test_align)
 
 GST_END_TEST;
 
+/* Output of mux_video(), copied and released right away so that the
+ * muxer can reuse its output chunks */
+static GByteArray *output_data;
+static GHashTable *output_chunks;
+static guint reused_chunks;
+
+static GstFlowReturn
+collect_output_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstMapInfo map;
+
+  fail_unless (gst_buffer_map (buffer, &map, GST_MAP_READ));
+  g_byte_array_append (output_data, map.data, map.size);
+  if (!g_hash_table_add (output_chunks, map.data))
+    reused_chunks++;
+  gst_buffer_unmap (buffer, &map);
+  gst_buffer_unref (buffer);
+
+  return GST_FLOW_OK;
+}
+
+/* Muxes the same video input with @alignment and returns the output */
+static GByteArray *
+mux_video (gint alignment)
+{
+  GstElement *mux;
+  GstClockTime ts = 0;
+  GstCaps *caps;
+  GstQuery *drain;
+  gchar *padname;
+  guint i;
+
+  output_data = g_byte_array_new ();
+  output_chunks = g_hash_table_new (NULL, NULL);
+  reused_chunks = 0;
+
+  mux = setup_tsmux (&video_src_template, "sink_%d", &padname);
+  gst_pad_set_chain_function (mysinkpad, collect_output_chain);
+  g_object_set (mux, "alignment", alignment, NULL);
+
+  fail_unless (gst_element_set_state (mux,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (VIDEO_CAPS_STRING);
+  gst_check_setup_events (mysrcpad, mux, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  for (i = 0; i < 200; i++) {
+    gsize size = 1 + (i * 7919) % 20000;
+    GstBuffer *inbuffer = gst_buffer_new_and_alloc (size);
+    GstMapInfo map;
+    gsize j;
+
+    gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+    for (j = 0; j < size; j++)
+      map.data[j] = (i + j) & 0xff;
+    gst_buffer_unmap (inbuffer, &map);
+
+    GST_BUFFER_PTS (inbuffer) = ts;
+    if (i % KEYFRAME_DISTANCE != 0)
+      GST_BUFFER_FLAG_SET (inbuffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    fail_unless_equals_int (gst_pad_push (mysrcpad, inbuffer), GST_FLOW_OK);
+    ts += 40 * GST_MSECOND;
+  }
+
+  drain = gst_query_new_drain ();
+  gst_pad_peer_query (mysrcpad, drain);
+  gst_query_unref (drain);
+
+  cleanup_tsmux (mux, padname);
+  g_free (padname);
+  g_hash_table_unref (output_chunks);
+  output_chunks = NULL;
+
+  return output_data;
+}
+
+GST_START_TEST (test_align_pooled_output)
+{
+  GByteArray *unaligned, *aligned;
+  gsize offset;
+
+  unaligned = mux_video (0);
+  aligned = mux_video (7);
+
+  /* the chunks went back to the pool and were used again */
+  fail_unless (reused_chunks > 0);
+
+  /* same packets, the last chunk filled up with null packets */
+  fail_unless (aligned->len >= unaligned->len);
+  fail_unless (memcmp (aligned->data, unaligned->data, unaligned->len) == 0);
+  fail_unless_equals_int (aligned->len % (7 * 188), 0);
+  fail_unless (aligned->len - unaligned->len < 7 * 188);
+  for (offset = unaligned->len; offset < aligned->len; offset += 188) {
+    fail_unless_equals_int (aligned->data[offset], 0x47);
+    fail_unless_equals_int (GST_READ_UINT16_BE (aligned->data + offset + 1) &
+        0x1fff, 0x1fff);
+  }
+
+  g_byte_array_unref (unaligned);
+  g_byte_array_unref (aligned);
+}
+
+GST_END_TEST;
+
 static void
 test_keyframe_propagation_check_output (GList * bufs)
 {
@@ -490,6 +596,7 @@ mpegtsmux_suite (void)
   tcase_add_test (tc_chain, test_video);
   tcase_add_test (tc_chain, test_multiple_state_change);
   tcase_add_test (tc_chain, test_align);
+  tcase_add_test (tc_chain, test_align_pooled_output);
   tcase_add_test (tc_chain, test_keyframe_flag_propagation);
 
   return s;
@@ -29,6 +29,17 @@ static GMainLoop *loop = NULL;
 static gboolean have_eos = FALSE;
 static gboolean have_data = FALSE;
 
+/* The file served by _src_getrange() */
+static const guint8 *src_data = NULL;
+static gsize src_size = 0;
+
+/* Buffers received by _sink_chain_collect() since the last flush */
+static GMutex collect_lock;
+static GCond collect_cond;
+static GList *collected = NULL;
+static gboolean block_first_buffer = FALSE;
+static gboolean flushing = FALSE;
+
 static GstStaticPadTemplate mysrctemplate =
 GST_STATIC_PAD_TEMPLATE ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
     GST_STATIC_CAPS ("application/mxf"));
@@ -134,11 +145,11 @@ static GstFlowReturn
 _src_getrange (GstPad * pad, GstObject * parent, guint64 offset, guint length,
     GstBuffer ** buffer)
 {
-  if (offset + length > sizeof (mxf_file))
+  if (offset + length > src_size)
     return GST_FLOW_EOS;
 
   *buffer = gst_buffer_new_wrapped_full (GST_MEMORY_FLAG_READONLY,
-      (guint8 *) (mxf_file + offset), length, 0, length, NULL, NULL);
+      (guint8 *) (src_data + offset), length, 0, length, NULL, NULL);
 
   return GST_FLOW_OK;
 }
@@ -156,7 +167,7 @@ _src_query (GstPad * pad, GstObject * parent, GstQuery * query)
       if (fmt != GST_FORMAT_BYTES)
         break;
 
-      gst_query_set_duration (query, fmt, sizeof (mxf_file));
+      gst_query_set_duration (query, fmt, src_size);
       res = TRUE;
       break;
     }
@@ -193,6 +204,8 @@ GST_START_TEST (test_pull)
   have_eos = FALSE;
   have_data = FALSE;
   loop = g_main_loop_new (NULL, FALSE);
+  src_data = mxf_file;
+  src_size = sizeof (mxf_file);
 
   mxfdemux = gst_element_factory_make ("mxfdemux", NULL);
   fail_unless (mxfdemux != NULL);
@@ -287,6 +300,241 @@ GST_START_TEST (test_push)
 
 GST_END_TEST;
 
+static GstFlowReturn
+_sink_chain_collect (GstPad * pad, GstObject * parent, GstBuffer * buffer)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&collect_lock);
+  collected = g_list_append (collected, buffer);
+  have_data = TRUE;
+  g_cond_broadcast (&collect_cond);
+
+  /* Keep the streaming thread busy until the seek flushes it */
+  if (block_first_buffer) {
+    block_first_buffer = FALSE;
+    while (!flushing)
+      g_cond_wait (&collect_cond, &collect_lock);
+    ret = GST_FLOW_FLUSHING;
+  }
+  g_mutex_unlock (&collect_lock);
+
+  return ret;
+}
+
+static gboolean
+_sink_event_collect (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+      g_mutex_lock (&collect_lock);
+      flushing = TRUE;
+      g_cond_broadcast (&collect_cond);
+      g_mutex_unlock (&collect_lock);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      g_mutex_lock (&collect_lock);
+      flushing = FALSE;
+      g_list_free_full (collected, (GDestroyNotify) gst_buffer_unref);
+      collected = NULL;
+      g_mutex_unlock (&collect_lock);
+      break;
+    default:
+      break;
+  }
+
+  return _sink_event (pad, parent, event);
+}
+
+static GByteArray *
+_create_clip_file (const guint8 * header, gsize header_size,
+    gsize essence_size, const guint8 * footer, gsize footer_size)
+{
+  GByteArray *file;
+  gsize i;
+
+  file = g_byte_array_sized_new (header_size + essence_size + footer_size);
+  g_byte_array_append (file, header, header_size);
+  for (i = 0; i < essence_size; i++) {
+    guint8 b = MXF_CLIP_ESSENCE_BYTE (i);
+
+    g_byte_array_append (file, &b, 1);
+  }
+  g_byte_array_append (file, footer, footer_size);
+
+  return file;
+}
+
+static GstElement *
+_start_clip_pull (GByteArray * file)
+{
+  GstStateChangeReturn sret;
+  GstElement *mxfdemux;
+  GstPad *sinkpad;
+
+  have_eos = FALSE;
+  have_data = FALSE;
+  flushing = FALSE;
+  loop = g_main_loop_new (NULL, FALSE);
+  src_data = file->data;
+  src_size = file->len;
+
+  mxfdemux = gst_element_factory_make ("mxfdemux", NULL);
+  fail_unless (mxfdemux != NULL);
+  g_signal_connect (mxfdemux, "pad-added", G_CALLBACK (_pad_added), NULL);
+  sinkpad = gst_element_get_static_pad (mxfdemux, "sink");
+  fail_unless (sinkpad != NULL);
+
+  mysinkpad = gst_pad_new_from_static_template (&mysinktemplate, "sink");
+  gst_pad_set_chain_function (mysinkpad, _sink_chain_collect);
+  gst_pad_set_event_function (mysinkpad, _sink_event_collect);
+  mysrcpad = _create_src_pad_pull ();
+  fail_unless (mysrcpad != NULL);
+
+  fail_unless (gst_pad_link (mysrcpad, sinkpad) == GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+
+  gst_pad_set_active (mysinkpad, TRUE);
+  gst_pad_set_active (mysrcpad, TRUE);
+
+  sret = gst_element_set_state (mxfdemux, GST_STATE_PLAYING);
+  fail_unless_equals_int (sret, GST_STATE_CHANGE_SUCCESS);
+
+  return mxfdemux;
+}
+
+static void
+_stop_clip_pull (GstElement * mxfdemux)
+{
+  gst_element_set_state (mxfdemux, GST_STATE_NULL);
+  gst_pad_set_active (mysinkpad, FALSE);
+  gst_pad_set_active (mysrcpad, FALSE);
+
+  gst_object_unref (mxfdemux);
+  gst_object_unref (mysinkpad);
+  gst_object_unref (mysrcpad);
+  g_main_loop_unref (loop);
+  loop = NULL;
+
+  g_list_free_full (collected, (GDestroyNotify) gst_buffer_unref);
+  collected = NULL;
+}
+
+static void
+_check_clip_buffer (GstBuffer * buffer, GstClockTime pts,
+    GstClockTime duration, const guint8 * data, gsize size)
+{
+  fail_unless_equals_uint64 (GST_BUFFER_PTS (buffer), pts);
+  fail_unless_equals_uint64 (GST_BUFFER_DURATION (buffer), duration);
+  fail_unless_equals_int (gst_buffer_get_size (buffer), size);
+  fail_unless (gst_buffer_memcmp (buffer, 0, data, size) == 0);
+}
+
+GST_START_TEST (test_pull_clip_wrapped)
+{
+  GstElement *mxfdemux;
+  GByteArray *file;
+  const guint8 *essence;
+
+  file = _create_clip_file (mxf_clip_file_header,
+      sizeof (mxf_clip_file_header),
+      MXF_CLIP_N_EDIT_UNITS * MXF_CLIP_EDIT_UNIT_SIZE, mxf_clip_file_footer,
+      sizeof (mxf_clip_file_footer));
+  essence = file->data + sizeof (mxf_clip_file_header);
+
+  mxfdemux = _start_clip_pull (file);
+  g_main_loop_run (loop);
+  fail_unless (have_eos == TRUE);
+
+  /* Sound is read in chunks of at most 64kB, here 29 edit units of 200ms.
+   * The second chunk ends with the last edit unit of the clip */
+  fail_unless_equals_int (g_list_length (collected), 2);
+  _check_clip_buffer (collected->data, 0, 29 * 200 * GST_MSECOND,
+      essence, 29 * MXF_CLIP_EDIT_UNIT_SIZE);
+  _check_clip_buffer (collected->next->data, 29 * 200 * GST_MSECOND,
+      6 * 200 * GST_MSECOND, essence + 29 * MXF_CLIP_EDIT_UNIT_SIZE,
+      6 * MXF_CLIP_EDIT_UNIT_SIZE);
+
+  _stop_clip_pull (mxfdemux);
+  g_byte_array_unref (file);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_pull_clip_wrapped_vbr)
+{
+  GstElement *mxfdemux;
+  GByteArray *file;
+  const guint8 *essence;
+  gsize offset = 0;
+  GList *l;
+  guint i;
+
+  file = _create_clip_file (mxf_vbr_clip_file_header,
+      sizeof (mxf_vbr_clip_file_header), MXF_VBR_CLIP_ESSENCE_SIZE,
+      mxf_vbr_clip_file_footer, sizeof (mxf_vbr_clip_file_footer));
+  essence = file->data + sizeof (mxf_vbr_clip_file_header);
+
+  mxfdemux = _start_clip_pull (file);
+  g_main_loop_run (loop);
+  fail_unless (have_eos == TRUE);
+
+  /* Without a constant edit unit size every edit unit is output on its own,
+   * with the size given by the index entries */
+  fail_unless_equals_int (g_list_length (collected),
+      MXF_VBR_CLIP_N_EDIT_UNITS);
+  for (l = collected, i = 0; l; l = l->next, i++) {
+    _check_clip_buffer (l->data, i * 200 * GST_MSECOND, 200 * GST_MSECOND,
+        essence + offset, MXF_VBR_CLIP_EDIT_UNIT_SIZE (i));
+    offset += MXF_VBR_CLIP_EDIT_UNIT_SIZE (i);
+  }
+  fail_unless_equals_int (offset, MXF_VBR_CLIP_ESSENCE_SIZE);
+
+  _stop_clip_pull (mxfdemux);
+  g_byte_array_unref (file);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_seek_clip_wrapped)
+{
+  GstElement *mxfdemux;
+  GByteArray *file;
+  const guint8 *essence;
+
+  file = _create_clip_file (mxf_clip_file_header,
+      sizeof (mxf_clip_file_header),
+      MXF_CLIP_N_EDIT_UNITS * MXF_CLIP_EDIT_UNIT_SIZE, mxf_clip_file_footer,
+      sizeof (mxf_clip_file_footer));
+  essence = file->data + sizeof (mxf_clip_file_header);
+
+  block_first_buffer = TRUE;
+  mxfdemux = _start_clip_pull (file);
+
+  /* Seek into the middle of the clip while the first chunk is pushed */
+  g_mutex_lock (&collect_lock);
+  while (!have_data)
+    g_cond_wait (&collect_cond, &collect_lock);
+  g_mutex_unlock (&collect_lock);
+
+  fail_unless (gst_pad_push_event (mysinkpad,
+          gst_event_new_seek (1.0, GST_FORMAT_TIME, GST_SEEK_FLAG_FLUSH,
+              GST_SEEK_TYPE_SET, 3 * GST_SECOND, GST_SEEK_TYPE_NONE, -1)));
+
+  g_main_loop_run (loop);
+  fail_unless (have_eos == TRUE);
+
+  /* Everything from edit unit 15 until the end of the clip in one chunk */
+  fail_unless_equals_int (g_list_length (collected), 1);
+  _check_clip_buffer (collected->data, 3 * GST_SECOND, 4 * GST_SECOND,
+      essence + 15 * MXF_CLIP_EDIT_UNIT_SIZE, 20 * MXF_CLIP_EDIT_UNIT_SIZE);
+
+  _stop_clip_pull (mxfdemux);
+  g_byte_array_unref (file);
+}
+
+GST_END_TEST;
+
 static Suite *
 mxfdemux_suite (void)
 {
@@ -302,6 +550,9 @@ mxfdemux_suite (void)
   tcase_set_timeout (tc_chain, 180);
   tcase_add_test (tc_chain, test_pull);
   tcase_add_test (tc_chain, test_push);
+  tcase_add_test (tc_chain, test_pull_clip_wrapped);
+  tcase_add_test (tc_chain, test_pull_clip_wrapped_vbr);
+  tcase_add_test (tc_chain, test_seek_clip_wrapped);
 
   return s;
 }
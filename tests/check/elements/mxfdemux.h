@@ -2550,3 +2550,1164 @@ static const guint8 mxf_file[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
   0x00, 0x4e, 0x3f, 0x00, 0x00, 0x00, 0x30,
 };
+
+/* Clip-wrapped versions of the file above, with the header metadata
+   durations, the descriptor's essence container and the essence element
+   key changed accordingly and the fill item removed. The value of the
+   essence element is not included, the header arrays end with its key
+   and length and the footer arrays follow the value. The essence is
+   generated with MXF_CLIP_ESSENCE_BYTE().
+
+   The first file has 35 edit units of 2205 bytes (7 seconds) and a
+   constant edit unit byte count index table segment, the second has 10
+   edit units of 1000, 1100, ..., 1900 bytes and an index table segment
+   with an index entry per edit unit.
+ */
+#define MXF_CLIP_ESSENCE_BYTE(i) ((guint8) ((i) % 251))
+
+#define MXF_CLIP_EDIT_UNIT_SIZE 2205
+#define MXF_CLIP_N_EDIT_UNITS 35
+
+#define MXF_VBR_CLIP_EDIT_UNIT_SIZE(i) (1000 + 100 * (i))
+#define MXF_VBR_CLIP_N_EDIT_UNITS 10
+#define MXF_VBR_CLIP_ESSENCE_SIZE 14500
+
+static const guint8 mxf_clip_file_header[] = {
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x05, 0x01, 0x01,
+  0x0d, 0x01, 0x02, 0x01, 0x01, 0x02, 0x04, 0x00,
+  0x83, 0x00, 0x00, 0x78, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x3d, 0xb4, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x9d, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x03, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x7f, 0x01, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x02, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x06, 0x02, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x02, 0x05, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x01, 0x05, 0x01, 0x00, 0x83, 0x00, 0x03, 0xb0,
+  0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x12,
+  0x01, 0x02, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x05, 0x20, 0x07, 0x01, 0x08, 0x00,
+  0x00, 0x00, 0x02, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x04, 0x07, 0x01, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x02, 0x02, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x07, 0x02,
+  0x02, 0x01, 0x01, 0x03, 0x00, 0x00, 0x10, 0x01,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x06, 0x01, 0x01, 0x04, 0x06, 0x09, 0x00, 0x00,
+  0x11, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x03, 0x01, 0x00,
+  0x00, 0x00, 0x11, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x06, 0x01, 0x01, 0x03,
+  0x02, 0x00, 0x00, 0x00, 0x12, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x07, 0x02,
+  0x01, 0x03, 0x01, 0x04, 0x00, 0x00, 0x15, 0x01,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x07, 0x02, 0x01, 0x03, 0x01, 0x05, 0x00, 0x00,
+  0x15, 0x02, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x04, 0x04, 0x01, 0x01, 0x02, 0x06,
+  0x00, 0x00, 0x15, 0x03, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x01, 0x04, 0x04, 0x01, 0x01,
+  0x05, 0x00, 0x00, 0x00, 0x19, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x06, 0x01,
+  0x01, 0x04, 0x05, 0x01, 0x00, 0x00, 0x19, 0x02,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x06, 0x01, 0x01, 0x04, 0x05, 0x02, 0x00, 0x00,
+  0x27, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x06, 0x01, 0x00,
+  0x00, 0x00, 0x30, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x01, 0x04, 0x06, 0x01, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x30, 0x02, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x01, 0x04, 0x06,
+  0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x30, 0x04,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x06, 0x01, 0x01, 0x04, 0x01, 0x02, 0x00, 0x00,
+  0x30, 0x06, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x05, 0x06, 0x01, 0x01, 0x03, 0x05, 0x00,
+  0x00, 0x00, 0x3b, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x07, 0x02, 0x01, 0x10,
+  0x02, 0x04, 0x00, 0x00, 0x3b, 0x03, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x06, 0x01,
+  0x01, 0x04, 0x02, 0x01, 0x00, 0x00, 0x3b, 0x05,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x03, 0x01, 0x02, 0x01, 0x05, 0x00, 0x00, 0x00,
+  0x3b, 0x06, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x04, 0x06, 0x04,
+  0x00, 0x00, 0x3b, 0x08, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x04, 0x06, 0x01, 0x01, 0x04,
+  0x01, 0x08, 0x00, 0x00, 0x3b, 0x09, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x05, 0x01, 0x02,
+  0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x3b, 0x0a,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x05,
+  0x01, 0x02, 0x02, 0x10, 0x02, 0x01, 0x00, 0x00,
+  0x3b, 0x0b, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x05, 0x01, 0x02, 0x02, 0x10, 0x02, 0x02,
+  0x00, 0x00, 0x3c, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x05, 0x20, 0x07, 0x01,
+  0x02, 0x01, 0x00, 0x00, 0x3c, 0x02, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x05, 0x20,
+  0x07, 0x01, 0x03, 0x01, 0x00, 0x00, 0x3c, 0x04,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x05, 0x20, 0x07, 0x01, 0x05, 0x01, 0x00, 0x00,
+  0x3c, 0x05, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x05, 0x20, 0x07, 0x01, 0x07, 0x00,
+  0x00, 0x00, 0x3c, 0x06, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x07, 0x02, 0x01, 0x10,
+  0x02, 0x03, 0x00, 0x00, 0x3c, 0x09, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x05, 0x20,
+  0x07, 0x01, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x0a,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x01, 0x15, 0x02, 0x00, 0x00, 0x00, 0x00,
+  0x3d, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x04, 0x04, 0x02, 0x03, 0x03, 0x04, 0x00,
+  0x00, 0x00, 0x3d, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x04, 0x04, 0x02, 0x03, 0x01,
+  0x04, 0x00, 0x00, 0x00, 0x3d, 0x03, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x05, 0x04, 0x02,
+  0x03, 0x01, 0x01, 0x01, 0x00, 0x00, 0x3d, 0x07,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x05,
+  0x04, 0x02, 0x01, 0x01, 0x04, 0x00, 0x00, 0x00,
+  0x3d, 0x09, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x05, 0x04, 0x02, 0x03, 0x03, 0x05, 0x00,
+  0x00, 0x00, 0x3d, 0x0a, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x05, 0x04, 0x02, 0x03, 0x02,
+  0x01, 0x00, 0x00, 0x00, 0x3f, 0x06, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x04, 0x01, 0x03,
+  0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x07,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x04,
+  0x01, 0x03, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00,
+  0x44, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x15, 0x10, 0x00, 0x00,
+  0x00, 0x00, 0x44, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x03, 0x03, 0x02,
+  0x01, 0x00, 0x00, 0x00, 0x44, 0x03, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x06, 0x01,
+  0x01, 0x04, 0x06, 0x05, 0x00, 0x00, 0x44, 0x04,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x07, 0x02, 0x01, 0x10, 0x02, 0x05, 0x00, 0x00,
+  0x44, 0x05, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x07, 0x02, 0x01, 0x10, 0x01, 0x03,
+  0x00, 0x00, 0x47, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x06, 0x01, 0x01, 0x04,
+  0x02, 0x03, 0x00, 0x00, 0x48, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x01, 0x07,
+  0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x48, 0x02,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x01, 0x07, 0x01, 0x02, 0x01, 0x00, 0x00, 0x00,
+  0x48, 0x03, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x04, 0x02, 0x04,
+  0x00, 0x00, 0x48, 0x04, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x01, 0x04, 0x01, 0x03,
+  0x00, 0x00, 0x00, 0x00, 0x4b, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x05, 0x30,
+  0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x02,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x07, 0x02, 0x01, 0x03, 0x01, 0x03, 0x00, 0x00,
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01, 0x01,
+  0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x2f, 0x00,
+  0x83, 0x00, 0x00, 0xda, 0x3c, 0x0a, 0x00, 0x10,
+  0x5d, 0xce, 0xec, 0x07, 0x72, 0xe0, 0x4b, 0xfd,
+  0x95, 0xde, 0x33, 0x15, 0x18, 0x9c, 0x0c, 0x38,
+  0x3b, 0x02, 0x00, 0x08, 0x07, 0xd4, 0x04, 0x1a,
+  0x0e, 0x12, 0x1d, 0x5c, 0x3b, 0x05, 0x00, 0x02,
+  0x01, 0x02, 0x3b, 0x06, 0x00, 0x28, 0x00, 0x00,
+  0x00, 0x02, 0x00, 0x00, 0x00, 0x10, 0x1b, 0xe6,
+  0x28, 0xa1, 0xa1, 0x47, 0x4c, 0x87, 0xad, 0xc6,
+  0x6a, 0xce, 0x8a, 0x93, 0x51, 0xb3, 0x2c, 0xf4,
+  0xbc, 0x4e, 0x65, 0x7f, 0x4e, 0x05, 0x87, 0xb4,
+  0x4c, 0xfd, 0xaa, 0xe3, 0x0a, 0x2b, 0x3b, 0x0a,
+  0x00, 0x28, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01,
+  0x01, 0x03, 0x0d, 0x01, 0x03, 0x01, 0x02, 0x7f,
+  0x01, 0x00, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01,
+  0x01, 0x02, 0x0d, 0x01, 0x03, 0x01, 0x02, 0x06,
+  0x02, 0x00, 0x3b, 0x0b, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x3b, 0x03,
+  0x00, 0x10, 0x89, 0x8a, 0x44, 0x70, 0x32, 0x7a,
+  0x40, 0xaa, 0x9c, 0x41, 0xc6, 0xc6, 0x3a, 0x64,
+  0x77, 0x18, 0x3b, 0x09, 0x00, 0x10, 0x06, 0x0e,
+  0x2b, 0x34, 0x04, 0x01, 0x01, 0x01, 0x0d, 0x01,
+  0x02, 0x01, 0x10, 0x00, 0x00, 0x00, 0x3b, 0x08,
+  0x00, 0x10, 0x08, 0x7c, 0x01, 0x83, 0xbe, 0xde,
+  0x4f, 0x1e, 0x8b, 0x1e, 0x16, 0x33, 0x6e, 0x35,
+  0xc4, 0x5e, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac,
+  0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf,
+  0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x30, 0x00, 0x83, 0x00,
+  0x00, 0xc4, 0x3c, 0x01, 0x00, 0x16, 0x00, 0x46,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x65, 0x00, 0x4d,
+  0x00, 0x58, 0x00, 0x46, 0x00, 0x2e, 0x00, 0x6f,
+  0x00, 0x72, 0x00, 0x67, 0x3c, 0x02, 0x00, 0x28,
+  0x00, 0x6d, 0x00, 0x78, 0x00, 0x66, 0x00, 0x77,
+  0x00, 0x72, 0x00, 0x61, 0x00, 0x70, 0x00, 0x20,
+  0x00, 0x66, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x20, 0x00, 0x77, 0x00, 0x72, 0x00, 0x61,
+  0x00, 0x70, 0x00, 0x70, 0x00, 0x65, 0x00, 0x72,
+  0x3c, 0x04, 0x00, 0x32, 0x00, 0x55, 0x00, 0x6e,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x61, 0x00, 0x73, 0x00, 0x65, 0x00, 0x64,
+  0x00, 0x20, 0x00, 0x6d, 0x00, 0x78, 0x00, 0x66,
+  0x00, 0x6c, 0x00, 0x69, 0x00, 0x62, 0x00, 0x20,
+  0x00, 0x30, 0x00, 0x2e, 0x00, 0x33, 0x00, 0x2e,
+  0x00, 0x33, 0x00, 0x2e, 0x00, 0x31, 0x3c, 0x05,
+  0x00, 0x10, 0x84, 0x66, 0x14, 0xf3, 0x27, 0xdd,
+  0xde, 0x40, 0x86, 0xdc, 0xe0, 0x99, 0xda, 0x7f,
+  0xd0, 0x52, 0x3c, 0x06, 0x00, 0x08, 0x07, 0xd4,
+  0x04, 0x1a, 0x0e, 0x12, 0x1d, 0x57, 0x3c, 0x0a,
+  0x00, 0x10, 0x1b, 0xe6, 0x28, 0xa1, 0xa1, 0x47,
+  0x4c, 0x87, 0xad, 0xc6, 0x6a, 0xce, 0x8a, 0x93,
+  0x51, 0xb3, 0x3c, 0x09, 0x00, 0x10, 0x3f, 0x12,
+  0xad, 0x30, 0x44, 0xea, 0x40, 0xe2, 0xbe, 0x1c,
+  0x1a, 0x48, 0xe6, 0x0c, 0xc7, 0x13, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x30, 0x00, 0x83, 0x00,
+  0x00, 0xc4, 0x3c, 0x01, 0x00, 0x16, 0x00, 0x46,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x65, 0x00, 0x4d,
+  0x00, 0x58, 0x00, 0x46, 0x00, 0x2e, 0x00, 0x6f,
+  0x00, 0x72, 0x00, 0x67, 0x3c, 0x02, 0x00, 0x28,
+  0x00, 0x6d, 0x00, 0x78, 0x00, 0x66, 0x00, 0x77,
+  0x00, 0x72, 0x00, 0x61, 0x00, 0x70, 0x00, 0x20,
+  0x00, 0x66, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x20, 0x00, 0x77, 0x00, 0x72, 0x00, 0x61,
+  0x00, 0x70, 0x00, 0x70, 0x00, 0x65, 0x00, 0x72,
+  0x3c, 0x04, 0x00, 0x32, 0x00, 0x55, 0x00, 0x6e,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x61, 0x00, 0x73, 0x00, 0x65, 0x00, 0x64,
+  0x00, 0x20, 0x00, 0x6d, 0x00, 0x78, 0x00, 0x66,
+  0x00, 0x6c, 0x00, 0x69, 0x00, 0x62, 0x00, 0x20,
+  0x00, 0x30, 0x00, 0x2e, 0x00, 0x33, 0x00, 0x2e,
+  0x00, 0x33, 0x00, 0x2e, 0x00, 0x31, 0x3c, 0x05,
+  0x00, 0x10, 0x84, 0x66, 0x14, 0xf3, 0x27, 0xdd,
+  0xde, 0x40, 0x86, 0xdc, 0xe0, 0x99, 0xda, 0x7f,
+  0xd0, 0x52, 0x3c, 0x06, 0x00, 0x08, 0x07, 0xd4,
+  0x04, 0x1a, 0x0e, 0x12, 0x1d, 0x5c, 0x3c, 0x0a,
+  0x00, 0x10, 0x2c, 0xf4, 0xbc, 0x4e, 0x65, 0x7f,
+  0x4e, 0x05, 0x87, 0xb4, 0x4c, 0xfd, 0xaa, 0xe3,
+  0x0a, 0x2b, 0x3c, 0x09, 0x00, 0x10, 0x35, 0xac,
+  0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf,
+  0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x18, 0x00, 0x83, 0x00,
+  0x00, 0x5c, 0x19, 0x01, 0x00, 0x28, 0x00, 0x00,
+  0x00, 0x02, 0x00, 0x00, 0x00, 0x10, 0xc0, 0x7c,
+  0x8b, 0x06, 0x0e, 0xe3, 0x4b, 0x75, 0x9f, 0xfb,
+  0x89, 0x05, 0xa4, 0x6f, 0xda, 0x18, 0x08, 0x7c,
+  0x01, 0x83, 0xbe, 0xde, 0x4f, 0x1e, 0x8b, 0x1e,
+  0x16, 0x33, 0x6e, 0x35, 0xc4, 0x5e, 0x19, 0x02,
+  0x00, 0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+  0x00, 0x10, 0x0f, 0x46, 0xb4, 0x10, 0x8b, 0xa9,
+  0x45, 0xa2, 0xa4, 0x0a, 0x17, 0x5b, 0x0b, 0x62,
+  0x50, 0xf3, 0x3c, 0x0a, 0x00, 0x10, 0x89, 0x8a,
+  0x44, 0x70, 0x32, 0x7a, 0x40, 0xaa, 0x9c, 0x41,
+  0xc6, 0xc6, 0x3a, 0x64, 0x77, 0x18, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x36, 0x00, 0x83, 0x00,
+  0x00, 0xa4, 0x44, 0x02, 0x00, 0x24, 0x00, 0x41,
+  0x00, 0x20, 0x00, 0x4d, 0x00, 0x61, 0x00, 0x74,
+  0x00, 0x65, 0x00, 0x72, 0x00, 0x69, 0x00, 0x61,
+  0x00, 0x6c, 0x00, 0x20, 0x00, 0x50, 0x00, 0x61,
+  0x00, 0x63, 0x00, 0x6b, 0x00, 0x61, 0x00, 0x67,
+  0x00, 0x65, 0x44, 0x01, 0x00, 0x20, 0x06, 0x0a,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x05, 0x01, 0x01,
+  0x0d, 0x20, 0x13, 0x00, 0x00, 0x00, 0x9a, 0xb6,
+  0x5c, 0xc0, 0xf9, 0x54, 0x41, 0x20, 0xa4, 0x2d,
+  0xa5, 0xf3, 0x4b, 0x6c, 0x3d, 0xd7, 0x44, 0x05,
+  0x00, 0x08, 0x07, 0xd4, 0x04, 0x1a, 0x0e, 0x12,
+  0x1d, 0x57, 0x44, 0x04, 0x00, 0x08, 0x07, 0xd4,
+  0x04, 0x1a, 0x0e, 0x12, 0x1d, 0x57, 0x44, 0x03,
+  0x00, 0x28, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x10, 0x9e, 0x69, 0xd9, 0x47, 0x1a, 0x63,
+  0x45, 0xd7, 0xa3, 0x85, 0xc5, 0x79, 0xfa, 0x48,
+  0x3f, 0xcf, 0x3a, 0x21, 0x3b, 0xc8, 0x7b, 0xb9,
+  0x40, 0xbd, 0xa0, 0x54, 0x14, 0x4f, 0x38, 0x34,
+  0xe8, 0x08, 0x3c, 0x0a, 0x00, 0x10, 0xc0, 0x7c,
+  0x8b, 0x06, 0x0e, 0xe3, 0x4b, 0x75, 0x9f, 0xfb,
+  0x89, 0x05, 0xa4, 0x6f, 0xda, 0x18, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x3b, 0x00, 0x83, 0x00,
+  0x00, 0x70, 0x48, 0x02, 0x00, 0x1c, 0x00, 0x54,
+  0x00, 0x69, 0x00, 0x6d, 0x00, 0x65, 0x00, 0x63,
+  0x00, 0x6f, 0x00, 0x64, 0x00, 0x65, 0x00, 0x20,
+  0x00, 0x54, 0x00, 0x72, 0x00, 0x61, 0x00, 0x63,
+  0x00, 0x6b, 0x48, 0x04, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x00, 0x4b, 0x02, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x01,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00,
+  0x00, 0x01, 0x48, 0x01, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x01, 0x48, 0x03, 0x00, 0x10, 0xb1, 0x5d,
+  0x1a, 0xad, 0x9e, 0x13, 0x4f, 0x9d, 0x89, 0xa6,
+  0x28, 0x00, 0x6f, 0x0b, 0x23, 0xd7, 0x3c, 0x0a,
+  0x00, 0x10, 0x9e, 0x69, 0xd9, 0x47, 0x1a, 0x63,
+  0x45, 0xd7, 0xa3, 0x85, 0xc5, 0x79, 0xfa, 0x48,
+  0x3f, 0xcf, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53,
+  0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x0f, 0x00, 0x83, 0x00, 0x00, 0x64, 0x02, 0x01,
+  0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01,
+  0x01, 0x01, 0x01, 0x03, 0x02, 0x01, 0x01, 0x00,
+  0x00, 0x00, 0x02, 0x02, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x10, 0x01,
+  0x00, 0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+  0x00, 0x10, 0xa4, 0x5f, 0x10, 0x3a, 0x63, 0x79,
+  0x45, 0x56, 0xb6, 0x65, 0x17, 0x2d, 0xf2, 0xf0,
+  0x0e, 0x6e, 0x3c, 0x0a, 0x00, 0x10, 0xb1, 0x5d,
+  0x1a, 0xad, 0x9e, 0x13, 0x4f, 0x9d, 0x89, 0xa6,
+  0x28, 0x00, 0x6f, 0x0b, 0x23, 0xd7, 0x01, 0x02,
+  0x00, 0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7,
+  0x4e, 0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5,
+  0x24, 0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53,
+  0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x14, 0x00, 0x83, 0x00, 0x00, 0x5f, 0x15, 0x02,
+  0x00, 0x02, 0x00, 0x05, 0x15, 0x03, 0x00, 0x01,
+  0x00, 0x15, 0x01, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x23, 0x3c, 0x0a, 0x00, 0x10, 0xa4, 0x5f, 0x10,
+  0x3a, 0x63, 0x79, 0x45, 0x56, 0xb6, 0x65, 0x17,
+  0x2d, 0xf2, 0xf0, 0x0e, 0x6e, 0x02, 0x01, 0x00,
+  0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01, 0x01,
+  0x01, 0x01, 0x03, 0x02, 0x01, 0x01, 0x00, 0x00,
+  0x00, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac, 0x10,
+  0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf, 0x0d,
+  0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e, 0x2b,
+  0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x3b, 0x00, 0x83, 0x00, 0x00,
+  0x6a, 0x48, 0x02, 0x00, 0x16, 0x00, 0x53, 0x00,
+  0x6f, 0x00, 0x75, 0x00, 0x6e, 0x00, 0x64, 0x00,
+  0x20, 0x00, 0x54, 0x00, 0x72, 0x00, 0x61, 0x00,
+  0x63, 0x00, 0x6b, 0x48, 0x04, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x00, 0x4b, 0x02, 0x00, 0x08, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b,
+  0x01, 0x00, 0x08, 0x00, 0x00, 0x00, 0x05, 0x00,
+  0x00, 0x00, 0x01, 0x48, 0x01, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x02, 0x48, 0x03, 0x00, 0x10, 0xbf,
+  0x20, 0x73, 0x31, 0xe2, 0xc5, 0x45, 0x47, 0x9b,
+  0xe1, 0x1a, 0x07, 0x89, 0x94, 0x97, 0xef, 0x3c,
+  0x0a, 0x00, 0x10, 0x3a, 0x21, 0x3b, 0xc8, 0x7b,
+  0xb9, 0x40, 0xbd, 0xa0, 0x54, 0x14, 0x4f, 0x38,
+  0x34, 0xe8, 0x08, 0x06, 0x0e, 0x2b, 0x34, 0x02,
+  0x53, 0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x0f, 0x00, 0x83, 0x00, 0x00, 0x64, 0x02,
+  0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04,
+  0x01, 0x01, 0x01, 0x01, 0x03, 0x02, 0x02, 0x02,
+  0x00, 0x00, 0x00, 0x02, 0x02, 0x00, 0x08, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x10,
+  0x01, 0x00, 0x18, 0x00, 0x00, 0x00, 0x01, 0x00,
+  0x00, 0x00, 0x10, 0x9b, 0x27, 0xfe, 0xda, 0x8d,
+  0x2f, 0x45, 0x72, 0xaf, 0x06, 0xf6, 0x99, 0xb8,
+  0xc8, 0x9e, 0xb5, 0x3c, 0x0a, 0x00, 0x10, 0xbf,
+  0x20, 0x73, 0x31, 0xe2, 0xc5, 0x45, 0x47, 0x9b,
+  0xe1, 0x1a, 0x07, 0x89, 0x94, 0x97, 0xef, 0x01,
+  0x02, 0x00, 0x10, 0x35, 0xac, 0x10, 0x04, 0x0e,
+  0xe7, 0x4e, 0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4,
+  0xe5, 0x24, 0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02,
+  0x53, 0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x11, 0x00, 0x83, 0x00, 0x00, 0x80, 0x02,
+  0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x23, 0x11, 0x01, 0x00, 0x20, 0x06,
+  0x0a, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x02, 0x20, 0x13, 0x00, 0x00, 0x00, 0x14,
+  0x5d, 0x1e, 0x9f, 0x7a, 0x3f, 0x41, 0x03, 0xad,
+  0xb6, 0x24, 0x9c, 0x87, 0x0d, 0x7e, 0xc3, 0x11,
+  0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x12,
+  0x01, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x3c, 0x0a, 0x00, 0x10, 0x9b,
+  0x27, 0xfe, 0xda, 0x8d, 0x2f, 0x45, 0x72, 0xaf,
+  0x06, 0xf6, 0x99, 0xb8, 0xc8, 0x9e, 0xb5, 0x02,
+  0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04,
+  0x01, 0x01, 0x01, 0x01, 0x03, 0x02, 0x02, 0x02,
+  0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x10, 0x35,
+  0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94,
+  0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06,
+  0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x37, 0x00, 0x83,
+  0x00, 0x00, 0xfe, 0x44, 0x02, 0x00, 0x6a, 0x00,
+  0x46, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65, 0x00,
+  0x20, 0x00, 0x50, 0x00, 0x61, 0x00, 0x63, 0x00,
+  0x6b, 0x00, 0x61, 0x00, 0x67, 0x00, 0x65, 0x00,
+  0x3a, 0x00, 0x20, 0x00, 0x53, 0x00, 0x4d, 0x00,
+  0x50, 0x00, 0x54, 0x00, 0x45, 0x00, 0x20, 0x00,
+  0x33, 0x00, 0x38, 0x00, 0x32, 0x00, 0x4d, 0x00,
+  0x20, 0x00, 0x66, 0x00, 0x72, 0x00, 0x61, 0x00,
+  0x6d, 0x00, 0x65, 0x00, 0x20, 0x00, 0x77, 0x00,
+  0x72, 0x00, 0x61, 0x00, 0x70, 0x00, 0x70, 0x00,
+  0x69, 0x00, 0x6e, 0x00, 0x67, 0x00, 0x20, 0x00,
+  0x6f, 0x00, 0x66, 0x00, 0x20, 0x00, 0x77, 0x00,
+  0x61, 0x00, 0x76, 0x00, 0x65, 0x00, 0x20, 0x00,
+  0x61, 0x00, 0x75, 0x00, 0x64, 0x00, 0x69, 0x00,
+  0x6f, 0x44, 0x01, 0x00, 0x20, 0x06, 0x0a, 0x2b,
+  0x34, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02,
+  0x20, 0x13, 0x00, 0x00, 0x00, 0x14, 0x5d, 0x1e,
+  0x9f, 0x7a, 0x3f, 0x41, 0x03, 0xad, 0xb6, 0x24,
+  0x9c, 0x87, 0x0d, 0x7e, 0xc3, 0x44, 0x05, 0x00,
+  0x08, 0x07, 0xd4, 0x04, 0x1a, 0x0e, 0x12, 0x1d,
+  0x57, 0x44, 0x04, 0x00, 0x08, 0x07, 0xd4, 0x04,
+  0x1a, 0x0e, 0x12, 0x1d, 0x57, 0x44, 0x03, 0x00,
+  0x28, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x10, 0xf2, 0xbf, 0xb3, 0x60, 0x10, 0xb7, 0x49,
+  0xa7, 0xaf, 0x2e, 0xc4, 0xfa, 0x62, 0x19, 0xbc,
+  0x01, 0x2a, 0xae, 0x1e, 0xb3, 0xc5, 0xa0, 0x4d,
+  0xa5, 0xb1, 0x78, 0xf1, 0xeb, 0x9a, 0x68, 0xf0,
+  0x8c, 0x3c, 0x0a, 0x00, 0x10, 0x08, 0x7c, 0x01,
+  0x83, 0xbe, 0xde, 0x4f, 0x1e, 0x8b, 0x1e, 0x16,
+  0x33, 0x6e, 0x35, 0xc4, 0x5e, 0x47, 0x01, 0x00,
+  0x10, 0xc4, 0xe1, 0xba, 0xb5, 0x66, 0x8d, 0x4f,
+  0x3c, 0xb4, 0x16, 0x78, 0x06, 0x26, 0x4d, 0xc6,
+  0xe8, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01,
+  0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x3b,
+  0x00, 0x83, 0x00, 0x00, 0x70, 0x48, 0x02, 0x00,
+  0x1c, 0x00, 0x54, 0x00, 0x69, 0x00, 0x6d, 0x00,
+  0x65, 0x00, 0x63, 0x00, 0x6f, 0x00, 0x64, 0x00,
+  0x65, 0x00, 0x20, 0x00, 0x54, 0x00, 0x72, 0x00,
+  0x61, 0x00, 0x63, 0x00, 0x6b, 0x48, 0x04, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x02, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x4b, 0x01, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x05, 0x00, 0x00, 0x00, 0x01, 0x48, 0x01, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x01, 0x48, 0x03, 0x00,
+  0x10, 0x77, 0xb2, 0x7d, 0x53, 0xcb, 0xef, 0x43,
+  0x1c, 0x84, 0xbd, 0xe6, 0x42, 0x59, 0x0e, 0x92,
+  0xcc, 0x3c, 0x0a, 0x00, 0x10, 0xf2, 0xbf, 0xb3,
+  0x60, 0x10, 0xb7, 0x49, 0xa7, 0xaf, 0x2e, 0xc4,
+  0xfa, 0x62, 0x19, 0xbc, 0x01, 0x06, 0x0e, 0x2b,
+  0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x0f, 0x00, 0x83, 0x00, 0x00,
+  0x64, 0x02, 0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b,
+  0x34, 0x04, 0x01, 0x01, 0x01, 0x01, 0x03, 0x02,
+  0x01, 0x01, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x23, 0x10, 0x01, 0x00, 0x18, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x10, 0x6d, 0x85, 0x87,
+  0x23, 0xb9, 0x0e, 0x4d, 0x67, 0x8d, 0xd8, 0xe1,
+  0x28, 0xf2, 0x4b, 0xbc, 0xf5, 0x3c, 0x0a, 0x00,
+  0x10, 0x77, 0xb2, 0x7d, 0x53, 0xcb, 0xef, 0x43,
+  0x1c, 0x84, 0xbd, 0xe6, 0x42, 0x59, 0x0e, 0x92,
+  0xcc, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac, 0x10,
+  0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf, 0x0d,
+  0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e, 0x2b,
+  0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x14, 0x00, 0x83, 0x00, 0x00,
+  0x5f, 0x15, 0x02, 0x00, 0x02, 0x00, 0x05, 0x15,
+  0x03, 0x00, 0x01, 0x00, 0x15, 0x01, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x50,
+  0x02, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x23, 0x3c, 0x0a, 0x00, 0x10,
+  0x6d, 0x85, 0x87, 0x23, 0xb9, 0x0e, 0x4d, 0x67,
+  0x8d, 0xd8, 0xe1, 0x28, 0xf2, 0x4b, 0xbc, 0xf5,
+  0x02, 0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x01, 0x01, 0x03, 0x02, 0x01,
+  0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x10,
+  0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21,
+  0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14,
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01, 0x01,
+  0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x3b, 0x00,
+  0x83, 0x00, 0x00, 0x6a, 0x48, 0x02, 0x00, 0x16,
+  0x00, 0x53, 0x00, 0x6f, 0x00, 0x75, 0x00, 0x6e,
+  0x00, 0x64, 0x00, 0x20, 0x00, 0x54, 0x00, 0x72,
+  0x00, 0x61, 0x00, 0x63, 0x00, 0x6b, 0x48, 0x04,
+  0x00, 0x04, 0x16, 0x01, 0x02, 0x01, 0x4b, 0x02,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x4b, 0x01, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 0x48, 0x01,
+  0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x48, 0x03,
+  0x00, 0x10, 0xf2, 0x67, 0xd5, 0x27, 0x0f, 0xbd,
+  0x45, 0x55, 0xa0, 0x3e, 0x35, 0x52, 0xae, 0x31,
+  0x7c, 0x4a, 0x3c, 0x0a, 0x00, 0x10, 0x2a, 0xae,
+  0x1e, 0xb3, 0xc5, 0xa0, 0x4d, 0xa5, 0xb1, 0x78,
+  0xf1, 0xeb, 0x9a, 0x68, 0xf0, 0x8c, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x0f, 0x00, 0x83, 0x00,
+  0x00, 0x64, 0x02, 0x01, 0x00, 0x10, 0x06, 0x0e,
+  0x2b, 0x34, 0x04, 0x01, 0x01, 0x01, 0x01, 0x03,
+  0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x02, 0x02,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x23, 0x10, 0x01, 0x00, 0x18, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0xdf, 0x85,
+  0x49, 0x8b, 0x72, 0x43, 0x4b, 0xa4, 0xa2, 0x4e,
+  0xfa, 0xed, 0xd8, 0x7a, 0xa0, 0x0d, 0x3c, 0x0a,
+  0x00, 0x10, 0xf2, 0x67, 0xd5, 0x27, 0x0f, 0xbd,
+  0x45, 0x55, 0xa0, 0x3e, 0x35, 0x52, 0xae, 0x31,
+  0x7c, 0x4a, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac,
+  0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf,
+  0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x11, 0x00, 0x83, 0x00,
+  0x00, 0x80, 0x02, 0x02, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x11, 0x01,
+  0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x11, 0x02, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x00, 0x12, 0x01, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x0a,
+  0x00, 0x10, 0xdf, 0x85, 0x49, 0x8b, 0x72, 0x43,
+  0x4b, 0xa4, 0xa2, 0x4e, 0xfa, 0xed, 0xd8, 0x7a,
+  0xa0, 0x0d, 0x02, 0x01, 0x00, 0x10, 0x06, 0x0e,
+  0x2b, 0x34, 0x04, 0x01, 0x01, 0x01, 0x01, 0x03,
+  0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x01, 0x02,
+  0x00, 0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7,
+  0x4e, 0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5,
+  0x24, 0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53,
+  0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x48, 0x00, 0x83, 0x00, 0x00, 0x8b, 0x30, 0x01,
+  0x00, 0x08, 0x00, 0x00, 0x2b, 0x11, 0x00, 0x00,
+  0x00, 0x01, 0x3d, 0x03, 0x00, 0x08, 0x00, 0x00,
+  0x2b, 0x11, 0x00, 0x00, 0x00, 0x01, 0x3d, 0x02,
+  0x00, 0x01, 0x00, 0x3d, 0x07, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x01, 0x3d, 0x01, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x08, 0x3d, 0x0a, 0x00, 0x02, 0x00,
+  0x01, 0x3d, 0x09, 0x00, 0x04, 0x00, 0x00, 0x2b,
+  0x11, 0x30, 0x04, 0x00, 0x10, 0x06, 0x0e, 0x2b,
+  0x34, 0x04, 0x01, 0x01, 0x02, 0x0d, 0x01, 0x03,
+  0x01, 0x02, 0x06, 0x02, 0x00, 0x30, 0x06, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x02, 0x3c, 0x0a, 0x00,
+  0x10, 0xc4, 0xe1, 0xba, 0xb5, 0x66, 0x8d, 0x4f,
+  0x3c, 0xb4, 0x16, 0x78, 0x06, 0x26, 0x4d, 0xc6,
+  0xe8, 0x30, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x23, 0x01, 0x02, 0x00,
+  0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e,
+  0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24,
+  0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01,
+  0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x23,
+  0x00, 0x83, 0x00, 0x00, 0x5c, 0x27, 0x01, 0x00,
+  0x20, 0x06, 0x0a, 0x2b, 0x34, 0x01, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x02, 0x20, 0x13, 0x00, 0x00,
+  0x00, 0x14, 0x5d, 0x1e, 0x9f, 0x7a, 0x3f, 0x41,
+  0x03, 0xad, 0xb6, 0x24, 0x9c, 0x87, 0x0d, 0x7e,
+  0xc3, 0x3f, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x01, 0x3c, 0x0a, 0x00, 0x10, 0x0f, 0x46, 0xb4,
+  0x10, 0x8b, 0xa9, 0x45, 0xa2, 0xa4, 0x0a, 0x17,
+  0x5b, 0x0b, 0x62, 0x50, 0xf3, 0x3f, 0x06, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x81, 0x01, 0x02, 0x00,
+  0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e,
+  0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24,
+  0x14, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x02, 0x01,
+  0x01, 0x0d, 0x01, 0x03, 0x01, 0x16, 0x01, 0x02,
+  0x01, 0x83, 0x01, 0x2d, 0x77,
+};
+
+static const guint8 mxf_clip_file_footer[] = {
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x05, 0x01, 0x01,
+  0x0d, 0x01, 0x02, 0x01, 0x01, 0x04, 0x04, 0x00,
+  0x83, 0x00, 0x00, 0x78, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x3d, 0xb4, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x3d, 0xb4, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x64, 0x00, 0x00, 0x00, 0x81,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x03, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x7f, 0x01, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x02, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x06, 0x02, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x01, 0x10, 0x01, 0x00, 0x83, 0x00, 0x00, 0x50,
+  0x3c, 0x0a, 0x00, 0x10, 0xba, 0xc8, 0x72, 0x86,
+  0xb4, 0xc4, 0x43, 0x30, 0x95, 0x5c, 0x3d, 0x89,
+  0x2a, 0x7a, 0xfc, 0x01, 0x3f, 0x0b, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01,
+  0x3f, 0x0c, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3f, 0x0d, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23,
+  0x3f, 0x05, 0x00, 0x04, 0x00, 0x00, 0x08, 0x9d,
+  0x3f, 0x06, 0x00, 0x04, 0x00, 0x00, 0x00, 0x81,
+  0x3f, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01,
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x05, 0x01, 0x01,
+  0x0d, 0x01, 0x02, 0x01, 0x01, 0x11, 0x01, 0x00,
+  0x83, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x3d, 0xb4, 0x00, 0x00, 0x00, 0x30,
+};
+
+static const guint8 mxf_vbr_clip_file_header[] = {
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x05, 0x01, 0x01,
+  0x0d, 0x01, 0x02, 0x01, 0x01, 0x02, 0x04, 0x00,
+  0x83, 0x00, 0x00, 0x78, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x48, 0xe1, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0f, 0x9d, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x03, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x7f, 0x01, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x02, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x06, 0x02, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x02, 0x05, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x01, 0x05, 0x01, 0x00, 0x83, 0x00, 0x03, 0xb0,
+  0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x12,
+  0x01, 0x02, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x05, 0x20, 0x07, 0x01, 0x08, 0x00,
+  0x00, 0x00, 0x02, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x04, 0x07, 0x01, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x02, 0x02, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x07, 0x02,
+  0x02, 0x01, 0x01, 0x03, 0x00, 0x00, 0x10, 0x01,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x06, 0x01, 0x01, 0x04, 0x06, 0x09, 0x00, 0x00,
+  0x11, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x03, 0x01, 0x00,
+  0x00, 0x00, 0x11, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x06, 0x01, 0x01, 0x03,
+  0x02, 0x00, 0x00, 0x00, 0x12, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x07, 0x02,
+  0x01, 0x03, 0x01, 0x04, 0x00, 0x00, 0x15, 0x01,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x07, 0x02, 0x01, 0x03, 0x01, 0x05, 0x00, 0x00,
+  0x15, 0x02, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x04, 0x04, 0x01, 0x01, 0x02, 0x06,
+  0x00, 0x00, 0x15, 0x03, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x01, 0x04, 0x04, 0x01, 0x01,
+  0x05, 0x00, 0x00, 0x00, 0x19, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x06, 0x01,
+  0x01, 0x04, 0x05, 0x01, 0x00, 0x00, 0x19, 0x02,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x06, 0x01, 0x01, 0x04, 0x05, 0x02, 0x00, 0x00,
+  0x27, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x06, 0x01, 0x00,
+  0x00, 0x00, 0x30, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x01, 0x04, 0x06, 0x01, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x30, 0x02, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x01, 0x04, 0x06,
+  0x01, 0x02, 0x00, 0x00, 0x00, 0x00, 0x30, 0x04,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x06, 0x01, 0x01, 0x04, 0x01, 0x02, 0x00, 0x00,
+  0x30, 0x06, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x05, 0x06, 0x01, 0x01, 0x03, 0x05, 0x00,
+  0x00, 0x00, 0x3b, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x07, 0x02, 0x01, 0x10,
+  0x02, 0x04, 0x00, 0x00, 0x3b, 0x03, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x06, 0x01,
+  0x01, 0x04, 0x02, 0x01, 0x00, 0x00, 0x3b, 0x05,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x03, 0x01, 0x02, 0x01, 0x05, 0x00, 0x00, 0x00,
+  0x3b, 0x06, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x04, 0x06, 0x04,
+  0x00, 0x00, 0x3b, 0x08, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x04, 0x06, 0x01, 0x01, 0x04,
+  0x01, 0x08, 0x00, 0x00, 0x3b, 0x09, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x05, 0x01, 0x02,
+  0x02, 0x03, 0x00, 0x00, 0x00, 0x00, 0x3b, 0x0a,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x05,
+  0x01, 0x02, 0x02, 0x10, 0x02, 0x01, 0x00, 0x00,
+  0x3b, 0x0b, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x05, 0x01, 0x02, 0x02, 0x10, 0x02, 0x02,
+  0x00, 0x00, 0x3c, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x05, 0x20, 0x07, 0x01,
+  0x02, 0x01, 0x00, 0x00, 0x3c, 0x02, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x05, 0x20,
+  0x07, 0x01, 0x03, 0x01, 0x00, 0x00, 0x3c, 0x04,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x05, 0x20, 0x07, 0x01, 0x05, 0x01, 0x00, 0x00,
+  0x3c, 0x05, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x05, 0x20, 0x07, 0x01, 0x07, 0x00,
+  0x00, 0x00, 0x3c, 0x06, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x07, 0x02, 0x01, 0x10,
+  0x02, 0x03, 0x00, 0x00, 0x3c, 0x09, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x05, 0x20,
+  0x07, 0x01, 0x01, 0x00, 0x00, 0x00, 0x3c, 0x0a,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x01, 0x15, 0x02, 0x00, 0x00, 0x00, 0x00,
+  0x3d, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x04, 0x04, 0x02, 0x03, 0x03, 0x04, 0x00,
+  0x00, 0x00, 0x3d, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x04, 0x04, 0x02, 0x03, 0x01,
+  0x04, 0x00, 0x00, 0x00, 0x3d, 0x03, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x05, 0x04, 0x02,
+  0x03, 0x01, 0x01, 0x01, 0x00, 0x00, 0x3d, 0x07,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x05,
+  0x04, 0x02, 0x01, 0x01, 0x04, 0x00, 0x00, 0x00,
+  0x3d, 0x09, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x05, 0x04, 0x02, 0x03, 0x03, 0x05, 0x00,
+  0x00, 0x00, 0x3d, 0x0a, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x05, 0x04, 0x02, 0x03, 0x02,
+  0x01, 0x00, 0x00, 0x00, 0x3f, 0x06, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x04, 0x01, 0x03,
+  0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x3f, 0x07,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x04,
+  0x01, 0x03, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00,
+  0x44, 0x01, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x15, 0x10, 0x00, 0x00,
+  0x00, 0x00, 0x44, 0x02, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x03, 0x03, 0x02,
+  0x01, 0x00, 0x00, 0x00, 0x44, 0x03, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x06, 0x01,
+  0x01, 0x04, 0x06, 0x05, 0x00, 0x00, 0x44, 0x04,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x07, 0x02, 0x01, 0x10, 0x02, 0x05, 0x00, 0x00,
+  0x44, 0x05, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x07, 0x02, 0x01, 0x10, 0x01, 0x03,
+  0x00, 0x00, 0x47, 0x01, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x06, 0x01, 0x01, 0x04,
+  0x02, 0x03, 0x00, 0x00, 0x48, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x01, 0x07,
+  0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x48, 0x02,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x01, 0x07, 0x01, 0x02, 0x01, 0x00, 0x00, 0x00,
+  0x48, 0x03, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01,
+  0x01, 0x02, 0x06, 0x01, 0x01, 0x04, 0x02, 0x04,
+  0x00, 0x00, 0x48, 0x04, 0x06, 0x0e, 0x2b, 0x34,
+  0x01, 0x01, 0x01, 0x02, 0x01, 0x04, 0x01, 0x03,
+  0x00, 0x00, 0x00, 0x00, 0x4b, 0x01, 0x06, 0x0e,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x02, 0x05, 0x30,
+  0x04, 0x05, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x02,
+  0x06, 0x0e, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x02,
+  0x07, 0x02, 0x01, 0x03, 0x01, 0x03, 0x00, 0x00,
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01, 0x01,
+  0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x2f, 0x00,
+  0x83, 0x00, 0x00, 0xda, 0x3c, 0x0a, 0x00, 0x10,
+  0x5d, 0xce, 0xec, 0x07, 0x72, 0xe0, 0x4b, 0xfd,
+  0x95, 0xde, 0x33, 0x15, 0x18, 0x9c, 0x0c, 0x38,
+  0x3b, 0x02, 0x00, 0x08, 0x07, 0xd4, 0x04, 0x1a,
+  0x0e, 0x12, 0x1d, 0x5c, 0x3b, 0x05, 0x00, 0x02,
+  0x01, 0x02, 0x3b, 0x06, 0x00, 0x28, 0x00, 0x00,
+  0x00, 0x02, 0x00, 0x00, 0x00, 0x10, 0x1b, 0xe6,
+  0x28, 0xa1, 0xa1, 0x47, 0x4c, 0x87, 0xad, 0xc6,
+  0x6a, 0xce, 0x8a, 0x93, 0x51, 0xb3, 0x2c, 0xf4,
+  0xbc, 0x4e, 0x65, 0x7f, 0x4e, 0x05, 0x87, 0xb4,
+  0x4c, 0xfd, 0xaa, 0xe3, 0x0a, 0x2b, 0x3b, 0x0a,
+  0x00, 0x28, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01,
+  0x01, 0x03, 0x0d, 0x01, 0x03, 0x01, 0x02, 0x7f,
+  0x01, 0x00, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01,
+  0x01, 0x02, 0x0d, 0x01, 0x03, 0x01, 0x02, 0x06,
+  0x02, 0x00, 0x3b, 0x0b, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x3b, 0x03,
+  0x00, 0x10, 0x89, 0x8a, 0x44, 0x70, 0x32, 0x7a,
+  0x40, 0xaa, 0x9c, 0x41, 0xc6, 0xc6, 0x3a, 0x64,
+  0x77, 0x18, 0x3b, 0x09, 0x00, 0x10, 0x06, 0x0e,
+  0x2b, 0x34, 0x04, 0x01, 0x01, 0x01, 0x0d, 0x01,
+  0x02, 0x01, 0x10, 0x00, 0x00, 0x00, 0x3b, 0x08,
+  0x00, 0x10, 0x08, 0x7c, 0x01, 0x83, 0xbe, 0xde,
+  0x4f, 0x1e, 0x8b, 0x1e, 0x16, 0x33, 0x6e, 0x35,
+  0xc4, 0x5e, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac,
+  0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf,
+  0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x30, 0x00, 0x83, 0x00,
+  0x00, 0xc4, 0x3c, 0x01, 0x00, 0x16, 0x00, 0x46,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x65, 0x00, 0x4d,
+  0x00, 0x58, 0x00, 0x46, 0x00, 0x2e, 0x00, 0x6f,
+  0x00, 0x72, 0x00, 0x67, 0x3c, 0x02, 0x00, 0x28,
+  0x00, 0x6d, 0x00, 0x78, 0x00, 0x66, 0x00, 0x77,
+  0x00, 0x72, 0x00, 0x61, 0x00, 0x70, 0x00, 0x20,
+  0x00, 0x66, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x20, 0x00, 0x77, 0x00, 0x72, 0x00, 0x61,
+  0x00, 0x70, 0x00, 0x70, 0x00, 0x65, 0x00, 0x72,
+  0x3c, 0x04, 0x00, 0x32, 0x00, 0x55, 0x00, 0x6e,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x61, 0x00, 0x73, 0x00, 0x65, 0x00, 0x64,
+  0x00, 0x20, 0x00, 0x6d, 0x00, 0x78, 0x00, 0x66,
+  0x00, 0x6c, 0x00, 0x69, 0x00, 0x62, 0x00, 0x20,
+  0x00, 0x30, 0x00, 0x2e, 0x00, 0x33, 0x00, 0x2e,
+  0x00, 0x33, 0x00, 0x2e, 0x00, 0x31, 0x3c, 0x05,
+  0x00, 0x10, 0x84, 0x66, 0x14, 0xf3, 0x27, 0xdd,
+  0xde, 0x40, 0x86, 0xdc, 0xe0, 0x99, 0xda, 0x7f,
+  0xd0, 0x52, 0x3c, 0x06, 0x00, 0x08, 0x07, 0xd4,
+  0x04, 0x1a, 0x0e, 0x12, 0x1d, 0x57, 0x3c, 0x0a,
+  0x00, 0x10, 0x1b, 0xe6, 0x28, 0xa1, 0xa1, 0x47,
+  0x4c, 0x87, 0xad, 0xc6, 0x6a, 0xce, 0x8a, 0x93,
+  0x51, 0xb3, 0x3c, 0x09, 0x00, 0x10, 0x3f, 0x12,
+  0xad, 0x30, 0x44, 0xea, 0x40, 0xe2, 0xbe, 0x1c,
+  0x1a, 0x48, 0xe6, 0x0c, 0xc7, 0x13, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x30, 0x00, 0x83, 0x00,
+  0x00, 0xc4, 0x3c, 0x01, 0x00, 0x16, 0x00, 0x46,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x65, 0x00, 0x4d,
+  0x00, 0x58, 0x00, 0x46, 0x00, 0x2e, 0x00, 0x6f,
+  0x00, 0x72, 0x00, 0x67, 0x3c, 0x02, 0x00, 0x28,
+  0x00, 0x6d, 0x00, 0x78, 0x00, 0x66, 0x00, 0x77,
+  0x00, 0x72, 0x00, 0x61, 0x00, 0x70, 0x00, 0x20,
+  0x00, 0x66, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x20, 0x00, 0x77, 0x00, 0x72, 0x00, 0x61,
+  0x00, 0x70, 0x00, 0x70, 0x00, 0x65, 0x00, 0x72,
+  0x3c, 0x04, 0x00, 0x32, 0x00, 0x55, 0x00, 0x6e,
+  0x00, 0x72, 0x00, 0x65, 0x00, 0x6c, 0x00, 0x65,
+  0x00, 0x61, 0x00, 0x73, 0x00, 0x65, 0x00, 0x64,
+  0x00, 0x20, 0x00, 0x6d, 0x00, 0x78, 0x00, 0x66,
+  0x00, 0x6c, 0x00, 0x69, 0x00, 0x62, 0x00, 0x20,
+  0x00, 0x30, 0x00, 0x2e, 0x00, 0x33, 0x00, 0x2e,
+  0x00, 0x33, 0x00, 0x2e, 0x00, 0x31, 0x3c, 0x05,
+  0x00, 0x10, 0x84, 0x66, 0x14, 0xf3, 0x27, 0xdd,
+  0xde, 0x40, 0x86, 0xdc, 0xe0, 0x99, 0xda, 0x7f,
+  0xd0, 0x52, 0x3c, 0x06, 0x00, 0x08, 0x07, 0xd4,
+  0x04, 0x1a, 0x0e, 0x12, 0x1d, 0x5c, 0x3c, 0x0a,
+  0x00, 0x10, 0x2c, 0xf4, 0xbc, 0x4e, 0x65, 0x7f,
+  0x4e, 0x05, 0x87, 0xb4, 0x4c, 0xfd, 0xaa, 0xe3,
+  0x0a, 0x2b, 0x3c, 0x09, 0x00, 0x10, 0x35, 0xac,
+  0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf,
+  0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x18, 0x00, 0x83, 0x00,
+  0x00, 0x5c, 0x19, 0x01, 0x00, 0x28, 0x00, 0x00,
+  0x00, 0x02, 0x00, 0x00, 0x00, 0x10, 0xc0, 0x7c,
+  0x8b, 0x06, 0x0e, 0xe3, 0x4b, 0x75, 0x9f, 0xfb,
+  0x89, 0x05, 0xa4, 0x6f, 0xda, 0x18, 0x08, 0x7c,
+  0x01, 0x83, 0xbe, 0xde, 0x4f, 0x1e, 0x8b, 0x1e,
+  0x16, 0x33, 0x6e, 0x35, 0xc4, 0x5e, 0x19, 0x02,
+  0x00, 0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+  0x00, 0x10, 0x0f, 0x46, 0xb4, 0x10, 0x8b, 0xa9,
+  0x45, 0xa2, 0xa4, 0x0a, 0x17, 0x5b, 0x0b, 0x62,
+  0x50, 0xf3, 0x3c, 0x0a, 0x00, 0x10, 0x89, 0x8a,
+  0x44, 0x70, 0x32, 0x7a, 0x40, 0xaa, 0x9c, 0x41,
+  0xc6, 0xc6, 0x3a, 0x64, 0x77, 0x18, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x36, 0x00, 0x83, 0x00,
+  0x00, 0xa4, 0x44, 0x02, 0x00, 0x24, 0x00, 0x41,
+  0x00, 0x20, 0x00, 0x4d, 0x00, 0x61, 0x00, 0x74,
+  0x00, 0x65, 0x00, 0x72, 0x00, 0x69, 0x00, 0x61,
+  0x00, 0x6c, 0x00, 0x20, 0x00, 0x50, 0x00, 0x61,
+  0x00, 0x63, 0x00, 0x6b, 0x00, 0x61, 0x00, 0x67,
+  0x00, 0x65, 0x44, 0x01, 0x00, 0x20, 0x06, 0x0a,
+  0x2b, 0x34, 0x01, 0x01, 0x01, 0x05, 0x01, 0x01,
+  0x0d, 0x20, 0x13, 0x00, 0x00, 0x00, 0x9a, 0xb6,
+  0x5c, 0xc0, 0xf9, 0x54, 0x41, 0x20, 0xa4, 0x2d,
+  0xa5, 0xf3, 0x4b, 0x6c, 0x3d, 0xd7, 0x44, 0x05,
+  0x00, 0x08, 0x07, 0xd4, 0x04, 0x1a, 0x0e, 0x12,
+  0x1d, 0x57, 0x44, 0x04, 0x00, 0x08, 0x07, 0xd4,
+  0x04, 0x1a, 0x0e, 0x12, 0x1d, 0x57, 0x44, 0x03,
+  0x00, 0x28, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x10, 0x9e, 0x69, 0xd9, 0x47, 0x1a, 0x63,
+  0x45, 0xd7, 0xa3, 0x85, 0xc5, 0x79, 0xfa, 0x48,
+  0x3f, 0xcf, 0x3a, 0x21, 0x3b, 0xc8, 0x7b, 0xb9,
+  0x40, 0xbd, 0xa0, 0x54, 0x14, 0x4f, 0x38, 0x34,
+  0xe8, 0x08, 0x3c, 0x0a, 0x00, 0x10, 0xc0, 0x7c,
+  0x8b, 0x06, 0x0e, 0xe3, 0x4b, 0x75, 0x9f, 0xfb,
+  0x89, 0x05, 0xa4, 0x6f, 0xda, 0x18, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x3b, 0x00, 0x83, 0x00,
+  0x00, 0x70, 0x48, 0x02, 0x00, 0x1c, 0x00, 0x54,
+  0x00, 0x69, 0x00, 0x6d, 0x00, 0x65, 0x00, 0x63,
+  0x00, 0x6f, 0x00, 0x64, 0x00, 0x65, 0x00, 0x20,
+  0x00, 0x54, 0x00, 0x72, 0x00, 0x61, 0x00, 0x63,
+  0x00, 0x6b, 0x48, 0x04, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x00, 0x4b, 0x02, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x01,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00,
+  0x00, 0x01, 0x48, 0x01, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x01, 0x48, 0x03, 0x00, 0x10, 0xb1, 0x5d,
+  0x1a, 0xad, 0x9e, 0x13, 0x4f, 0x9d, 0x89, 0xa6,
+  0x28, 0x00, 0x6f, 0x0b, 0x23, 0xd7, 0x3c, 0x0a,
+  0x00, 0x10, 0x9e, 0x69, 0xd9, 0x47, 0x1a, 0x63,
+  0x45, 0xd7, 0xa3, 0x85, 0xc5, 0x79, 0xfa, 0x48,
+  0x3f, 0xcf, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53,
+  0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x0f, 0x00, 0x83, 0x00, 0x00, 0x64, 0x02, 0x01,
+  0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01,
+  0x01, 0x01, 0x01, 0x03, 0x02, 0x01, 0x01, 0x00,
+  0x00, 0x00, 0x02, 0x02, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x10, 0x01,
+  0x00, 0x18, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+  0x00, 0x10, 0xa4, 0x5f, 0x10, 0x3a, 0x63, 0x79,
+  0x45, 0x56, 0xb6, 0x65, 0x17, 0x2d, 0xf2, 0xf0,
+  0x0e, 0x6e, 0x3c, 0x0a, 0x00, 0x10, 0xb1, 0x5d,
+  0x1a, 0xad, 0x9e, 0x13, 0x4f, 0x9d, 0x89, 0xa6,
+  0x28, 0x00, 0x6f, 0x0b, 0x23, 0xd7, 0x01, 0x02,
+  0x00, 0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7,
+  0x4e, 0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5,
+  0x24, 0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53,
+  0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x14, 0x00, 0x83, 0x00, 0x00, 0x5f, 0x15, 0x02,
+  0x00, 0x02, 0x00, 0x05, 0x15, 0x03, 0x00, 0x01,
+  0x00, 0x15, 0x01, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0a, 0x3c, 0x0a, 0x00, 0x10, 0xa4, 0x5f, 0x10,
+  0x3a, 0x63, 0x79, 0x45, 0x56, 0xb6, 0x65, 0x17,
+  0x2d, 0xf2, 0xf0, 0x0e, 0x6e, 0x02, 0x01, 0x00,
+  0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04, 0x01, 0x01,
+  0x01, 0x01, 0x03, 0x02, 0x01, 0x01, 0x00, 0x00,
+  0x00, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac, 0x10,
+  0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf, 0x0d,
+  0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e, 0x2b,
+  0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x3b, 0x00, 0x83, 0x00, 0x00,
+  0x6a, 0x48, 0x02, 0x00, 0x16, 0x00, 0x53, 0x00,
+  0x6f, 0x00, 0x75, 0x00, 0x6e, 0x00, 0x64, 0x00,
+  0x20, 0x00, 0x54, 0x00, 0x72, 0x00, 0x61, 0x00,
+  0x63, 0x00, 0x6b, 0x48, 0x04, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x00, 0x4b, 0x02, 0x00, 0x08, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b,
+  0x01, 0x00, 0x08, 0x00, 0x00, 0x00, 0x05, 0x00,
+  0x00, 0x00, 0x01, 0x48, 0x01, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x02, 0x48, 0x03, 0x00, 0x10, 0xbf,
+  0x20, 0x73, 0x31, 0xe2, 0xc5, 0x45, 0x47, 0x9b,
+  0xe1, 0x1a, 0x07, 0x89, 0x94, 0x97, 0xef, 0x3c,
+  0x0a, 0x00, 0x10, 0x3a, 0x21, 0x3b, 0xc8, 0x7b,
+  0xb9, 0x40, 0xbd, 0xa0, 0x54, 0x14, 0x4f, 0x38,
+  0x34, 0xe8, 0x08, 0x06, 0x0e, 0x2b, 0x34, 0x02,
+  0x53, 0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x0f, 0x00, 0x83, 0x00, 0x00, 0x64, 0x02,
+  0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04,
+  0x01, 0x01, 0x01, 0x01, 0x03, 0x02, 0x02, 0x02,
+  0x00, 0x00, 0x00, 0x02, 0x02, 0x00, 0x08, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x10,
+  0x01, 0x00, 0x18, 0x00, 0x00, 0x00, 0x01, 0x00,
+  0x00, 0x00, 0x10, 0x9b, 0x27, 0xfe, 0xda, 0x8d,
+  0x2f, 0x45, 0x72, 0xaf, 0x06, 0xf6, 0x99, 0xb8,
+  0xc8, 0x9e, 0xb5, 0x3c, 0x0a, 0x00, 0x10, 0xbf,
+  0x20, 0x73, 0x31, 0xe2, 0xc5, 0x45, 0x47, 0x9b,
+  0xe1, 0x1a, 0x07, 0x89, 0x94, 0x97, 0xef, 0x01,
+  0x02, 0x00, 0x10, 0x35, 0xac, 0x10, 0x04, 0x0e,
+  0xe7, 0x4e, 0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4,
+  0xe5, 0x24, 0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02,
+  0x53, 0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x11, 0x00, 0x83, 0x00, 0x00, 0x80, 0x02,
+  0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x0a, 0x11, 0x01, 0x00, 0x20, 0x06,
+  0x0a, 0x2b, 0x34, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x01, 0x02, 0x20, 0x13, 0x00, 0x00, 0x00, 0x14,
+  0x5d, 0x1e, 0x9f, 0x7a, 0x3f, 0x41, 0x03, 0xad,
+  0xb6, 0x24, 0x9c, 0x87, 0x0d, 0x7e, 0xc3, 0x11,
+  0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x12,
+  0x01, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x3c, 0x0a, 0x00, 0x10, 0x9b,
+  0x27, 0xfe, 0xda, 0x8d, 0x2f, 0x45, 0x72, 0xaf,
+  0x06, 0xf6, 0x99, 0xb8, 0xc8, 0x9e, 0xb5, 0x02,
+  0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34, 0x04,
+  0x01, 0x01, 0x01, 0x01, 0x03, 0x02, 0x02, 0x02,
+  0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x10, 0x35,
+  0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94,
+  0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06,
+  0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x37, 0x00, 0x83,
+  0x00, 0x00, 0xfe, 0x44, 0x02, 0x00, 0x6a, 0x00,
+  0x46, 0x00, 0x69, 0x00, 0x6c, 0x00, 0x65, 0x00,
+  0x20, 0x00, 0x50, 0x00, 0x61, 0x00, 0x63, 0x00,
+  0x6b, 0x00, 0x61, 0x00, 0x67, 0x00, 0x65, 0x00,
+  0x3a, 0x00, 0x20, 0x00, 0x53, 0x00, 0x4d, 0x00,
+  0x50, 0x00, 0x54, 0x00, 0x45, 0x00, 0x20, 0x00,
+  0x33, 0x00, 0x38, 0x00, 0x32, 0x00, 0x4d, 0x00,
+  0x20, 0x00, 0x66, 0x00, 0x72, 0x00, 0x61, 0x00,
+  0x6d, 0x00, 0x65, 0x00, 0x20, 0x00, 0x77, 0x00,
+  0x72, 0x00, 0x61, 0x00, 0x70, 0x00, 0x70, 0x00,
+  0x69, 0x00, 0x6e, 0x00, 0x67, 0x00, 0x20, 0x00,
+  0x6f, 0x00, 0x66, 0x00, 0x20, 0x00, 0x77, 0x00,
+  0x61, 0x00, 0x76, 0x00, 0x65, 0x00, 0x20, 0x00,
+  0x61, 0x00, 0x75, 0x00, 0x64, 0x00, 0x69, 0x00,
+  0x6f, 0x44, 0x01, 0x00, 0x20, 0x06, 0x0a, 0x2b,
+  0x34, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02,
+  0x20, 0x13, 0x00, 0x00, 0x00, 0x14, 0x5d, 0x1e,
+  0x9f, 0x7a, 0x3f, 0x41, 0x03, 0xad, 0xb6, 0x24,
+  0x9c, 0x87, 0x0d, 0x7e, 0xc3, 0x44, 0x05, 0x00,
+  0x08, 0x07, 0xd4, 0x04, 0x1a, 0x0e, 0x12, 0x1d,
+  0x57, 0x44, 0x04, 0x00, 0x08, 0x07, 0xd4, 0x04,
+  0x1a, 0x0e, 0x12, 0x1d, 0x57, 0x44, 0x03, 0x00,
+  0x28, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+  0x10, 0xf2, 0xbf, 0xb3, 0x60, 0x10, 0xb7, 0x49,
+  0xa7, 0xaf, 0x2e, 0xc4, 0xfa, 0x62, 0x19, 0xbc,
+  0x01, 0x2a, 0xae, 0x1e, 0xb3, 0xc5, 0xa0, 0x4d,
+  0xa5, 0xb1, 0x78, 0xf1, 0xeb, 0x9a, 0x68, 0xf0,
+  0x8c, 0x3c, 0x0a, 0x00, 0x10, 0x08, 0x7c, 0x01,
+  0x83, 0xbe, 0xde, 0x4f, 0x1e, 0x8b, 0x1e, 0x16,
+  0x33, 0x6e, 0x35, 0xc4, 0x5e, 0x47, 0x01, 0x00,
+  0x10, 0xc4, 0xe1, 0xba, 0xb5, 0x66, 0x8d, 0x4f,
+  0x3c, 0xb4, 0x16, 0x78, 0x06, 0x26, 0x4d, 0xc6,
+  0xe8, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01,
+  0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x3b,
+  0x00, 0x83, 0x00, 0x00, 0x70, 0x48, 0x02, 0x00,
+  0x1c, 0x00, 0x54, 0x00, 0x69, 0x00, 0x6d, 0x00,
+  0x65, 0x00, 0x63, 0x00, 0x6f, 0x00, 0x64, 0x00,
+  0x65, 0x00, 0x20, 0x00, 0x54, 0x00, 0x72, 0x00,
+  0x61, 0x00, 0x63, 0x00, 0x6b, 0x48, 0x04, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x02, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x4b, 0x01, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x05, 0x00, 0x00, 0x00, 0x01, 0x48, 0x01, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x01, 0x48, 0x03, 0x00,
+  0x10, 0x77, 0xb2, 0x7d, 0x53, 0xcb, 0xef, 0x43,
+  0x1c, 0x84, 0xbd, 0xe6, 0x42, 0x59, 0x0e, 0x92,
+  0xcc, 0x3c, 0x0a, 0x00, 0x10, 0xf2, 0xbf, 0xb3,
+  0x60, 0x10, 0xb7, 0x49, 0xa7, 0xaf, 0x2e, 0xc4,
+  0xfa, 0x62, 0x19, 0xbc, 0x01, 0x06, 0x0e, 0x2b,
+  0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x0f, 0x00, 0x83, 0x00, 0x00,
+  0x64, 0x02, 0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b,
+  0x34, 0x04, 0x01, 0x01, 0x01, 0x01, 0x03, 0x02,
+  0x01, 0x01, 0x00, 0x00, 0x00, 0x02, 0x02, 0x00,
+  0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0a, 0x10, 0x01, 0x00, 0x18, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x10, 0x6d, 0x85, 0x87,
+  0x23, 0xb9, 0x0e, 0x4d, 0x67, 0x8d, 0xd8, 0xe1,
+  0x28, 0xf2, 0x4b, 0xbc, 0xf5, 0x3c, 0x0a, 0x00,
+  0x10, 0x77, 0xb2, 0x7d, 0x53, 0xcb, 0xef, 0x43,
+  0x1c, 0x84, 0xbd, 0xe6, 0x42, 0x59, 0x0e, 0x92,
+  0xcc, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac, 0x10,
+  0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf, 0x0d,
+  0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e, 0x2b,
+  0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x14, 0x00, 0x83, 0x00, 0x00,
+  0x5f, 0x15, 0x02, 0x00, 0x02, 0x00, 0x05, 0x15,
+  0x03, 0x00, 0x01, 0x00, 0x15, 0x01, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46, 0x50,
+  0x02, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0a, 0x3c, 0x0a, 0x00, 0x10,
+  0x6d, 0x85, 0x87, 0x23, 0xb9, 0x0e, 0x4d, 0x67,
+  0x8d, 0xd8, 0xe1, 0x28, 0xf2, 0x4b, 0xbc, 0xf5,
+  0x02, 0x01, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x01, 0x01, 0x03, 0x02, 0x01,
+  0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 0x00, 0x10,
+  0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21,
+  0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14,
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01, 0x01,
+  0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x3b, 0x00,
+  0x83, 0x00, 0x00, 0x6a, 0x48, 0x02, 0x00, 0x16,
+  0x00, 0x53, 0x00, 0x6f, 0x00, 0x75, 0x00, 0x6e,
+  0x00, 0x64, 0x00, 0x20, 0x00, 0x54, 0x00, 0x72,
+  0x00, 0x61, 0x00, 0x63, 0x00, 0x6b, 0x48, 0x04,
+  0x00, 0x04, 0x16, 0x01, 0x02, 0x01, 0x4b, 0x02,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x4b, 0x01, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x05, 0x00, 0x00, 0x00, 0x01, 0x48, 0x01,
+  0x00, 0x04, 0x00, 0x00, 0x00, 0x02, 0x48, 0x03,
+  0x00, 0x10, 0xf2, 0x67, 0xd5, 0x27, 0x0f, 0xbd,
+  0x45, 0x55, 0xa0, 0x3e, 0x35, 0x52, 0xae, 0x31,
+  0x7c, 0x4a, 0x3c, 0x0a, 0x00, 0x10, 0x2a, 0xae,
+  0x1e, 0xb3, 0xc5, 0xa0, 0x4d, 0xa5, 0xb1, 0x78,
+  0xf1, 0xeb, 0x9a, 0x68, 0xf0, 0x8c, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x0f, 0x00, 0x83, 0x00,
+  0x00, 0x64, 0x02, 0x01, 0x00, 0x10, 0x06, 0x0e,
+  0x2b, 0x34, 0x04, 0x01, 0x01, 0x01, 0x01, 0x03,
+  0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x02, 0x02,
+  0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x0a, 0x10, 0x01, 0x00, 0x18, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0xdf, 0x85,
+  0x49, 0x8b, 0x72, 0x43, 0x4b, 0xa4, 0xa2, 0x4e,
+  0xfa, 0xed, 0xd8, 0x7a, 0xa0, 0x0d, 0x3c, 0x0a,
+  0x00, 0x10, 0xf2, 0x67, 0xd5, 0x27, 0x0f, 0xbd,
+  0x45, 0x55, 0xa0, 0x3e, 0x35, 0x52, 0xae, 0x31,
+  0x7c, 0x4a, 0x01, 0x02, 0x00, 0x10, 0x35, 0xac,
+  0x10, 0x04, 0x0e, 0xe7, 0x4e, 0x21, 0x94, 0xbf,
+  0x0d, 0xf4, 0xe4, 0xe5, 0x24, 0x14, 0x06, 0x0e,
+  0x2b, 0x34, 0x02, 0x53, 0x01, 0x01, 0x0d, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x11, 0x00, 0x83, 0x00,
+  0x00, 0x80, 0x02, 0x02, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x11, 0x01,
+  0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x11, 0x02, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x00, 0x12, 0x01, 0x00, 0x08, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x0a,
+  0x00, 0x10, 0xdf, 0x85, 0x49, 0x8b, 0x72, 0x43,
+  0x4b, 0xa4, 0xa2, 0x4e, 0xfa, 0xed, 0xd8, 0x7a,
+  0xa0, 0x0d, 0x02, 0x01, 0x00, 0x10, 0x06, 0x0e,
+  0x2b, 0x34, 0x04, 0x01, 0x01, 0x01, 0x01, 0x03,
+  0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x01, 0x02,
+  0x00, 0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7,
+  0x4e, 0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5,
+  0x24, 0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53,
+  0x01, 0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01,
+  0x48, 0x00, 0x83, 0x00, 0x00, 0x8b, 0x30, 0x01,
+  0x00, 0x08, 0x00, 0x00, 0x2b, 0x11, 0x00, 0x00,
+  0x00, 0x01, 0x3d, 0x03, 0x00, 0x08, 0x00, 0x00,
+  0x2b, 0x11, 0x00, 0x00, 0x00, 0x01, 0x3d, 0x02,
+  0x00, 0x01, 0x00, 0x3d, 0x07, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x01, 0x3d, 0x01, 0x00, 0x04, 0x00,
+  0x00, 0x00, 0x08, 0x3d, 0x0a, 0x00, 0x02, 0x00,
+  0x01, 0x3d, 0x09, 0x00, 0x04, 0x00, 0x00, 0x2b,
+  0x11, 0x30, 0x04, 0x00, 0x10, 0x06, 0x0e, 0x2b,
+  0x34, 0x04, 0x01, 0x01, 0x02, 0x0d, 0x01, 0x03,
+  0x01, 0x02, 0x06, 0x02, 0x00, 0x30, 0x06, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x02, 0x3c, 0x0a, 0x00,
+  0x10, 0xc4, 0xe1, 0xba, 0xb5, 0x66, 0x8d, 0x4f,
+  0x3c, 0xb4, 0x16, 0x78, 0x06, 0x26, 0x4d, 0xc6,
+  0xe8, 0x30, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x0a, 0x01, 0x02, 0x00,
+  0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e,
+  0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24,
+  0x14, 0x06, 0x0e, 0x2b, 0x34, 0x02, 0x53, 0x01,
+  0x01, 0x0d, 0x01, 0x01, 0x01, 0x01, 0x01, 0x23,
+  0x00, 0x83, 0x00, 0x00, 0x5c, 0x27, 0x01, 0x00,
+  0x20, 0x06, 0x0a, 0x2b, 0x34, 0x01, 0x01, 0x01,
+  0x01, 0x01, 0x01, 0x02, 0x20, 0x13, 0x00, 0x00,
+  0x00, 0x14, 0x5d, 0x1e, 0x9f, 0x7a, 0x3f, 0x41,
+  0x03, 0xad, 0xb6, 0x24, 0x9c, 0x87, 0x0d, 0x7e,
+  0xc3, 0x3f, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x01, 0x3c, 0x0a, 0x00, 0x10, 0x0f, 0x46, 0xb4,
+  0x10, 0x8b, 0xa9, 0x45, 0xa2, 0xa4, 0x0a, 0x17,
+  0x5b, 0x0b, 0x62, 0x50, 0xf3, 0x3f, 0x06, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x81, 0x01, 0x02, 0x00,
+  0x10, 0x35, 0xac, 0x10, 0x04, 0x0e, 0xe7, 0x4e,
+  0x21, 0x94, 0xbf, 0x0d, 0xf4, 0xe4, 0xe5, 0x24,
+  0x14, 0x06, 0x0e, 0x2b, 0x34, 0x01, 0x02, 0x01,
+  0x01, 0x0d, 0x01, 0x03, 0x01, 0x16, 0x01, 0x02,
+  0x01, 0x83, 0x00, 0x38, 0xa4,
+};
+
+static const guint8 mxf_vbr_clip_file_footer[] = {
+  0x06, 0x0e, 0x2b, 0x34, 0x02, 0x05, 0x01, 0x01,
+  0x0d, 0x01, 0x02, 0x01, 0x01, 0x04, 0x04, 0x00,
+  0x83, 0x00, 0x00, 0x78, 0x00, 0x01, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x48, 0xe1, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x48, 0xe1, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xe3, 0x00, 0x00, 0x00, 0x81,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+  0x00, 0x00, 0x00, 0x10, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x03, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x7f, 0x01, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x04, 0x01, 0x01, 0x02, 0x0d, 0x01, 0x03, 0x01,
+  0x02, 0x06, 0x02, 0x00, 0x06, 0x0e, 0x2b, 0x34,
+  0x02, 0x53, 0x01, 0x01, 0x0d, 0x01, 0x02, 0x01,
+  0x01, 0x10, 0x01, 0x00, 0x83, 0x00, 0x00, 0xcf,
+  0x3c, 0x0a, 0x00, 0x10, 0xba, 0xc8, 0x72, 0x86,
+  0xb4, 0xc4, 0x43, 0x30, 0x95, 0x5c, 0x3d, 0x89,
+  0x2a, 0x7a, 0xfc, 0x01, 0x3f, 0x0b, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x01,
+  0x3f, 0x0c, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3f, 0x0d, 0x00, 0x08,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0a,
+  0x3f, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00,
+  0x3f, 0x06, 0x00, 0x04, 0x00, 0x00, 0x00, 0x81,
+  0x3f, 0x07, 0x00, 0x04, 0x00, 0x00, 0x00, 0x01,
+  0x3f, 0x08, 0x00, 0x01, 0x00, 0x3f, 0x0a, 0x00,
+  0x76, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+  0x0b, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xe8, 0x00,
+  0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x08, 0x34, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x0c, 0xe4, 0x00, 0x00, 0x80,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0xf8,
+  0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x17, 0x70, 0x00, 0x00, 0x80, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x1d, 0x4c, 0x00, 0x00,
+  0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23,
+  0x8c, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x2a, 0x30, 0x00, 0x00, 0x80, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x38, 0x06,
+  0x0e, 0x2b, 0x34, 0x02, 0x05, 0x01, 0x01, 0x0d,
+  0x01, 0x02, 0x01, 0x01, 0x11, 0x01, 0x00, 0x83,
+  0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x01, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x48, 0xe1, 0x00, 0x00, 0x00, 0x30,
+};
@@ -0,0 +1,317 @@
+/* GStreamer
+ *
+ * unit test for the mxfdemux index cache
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <glib/gstdio.h>
+
+#include "../../../gst/mxf/mxfindexcache.c"
+
+GST_DEBUG_CATEGORY (mxf_debug);
+
+/* the only thing needed from mxftypes.c */
+gboolean
+mxf_umid_is_equal (const MXFUMID * a, const MXFUMID * b)
+{
+  return (memcmp (a, b, 32) == 0);
+}
+
+#define FILE_SIZE (1024 * 1024)
+#define MTIME 1234567890
+#define N_OFFSETS 100
+
+static gchar *tmpdir = NULL;
+
+static void
+setup (void)
+{
+  tmpdir = g_dir_make_tmp ("mxfindexcache-XXXXXX", NULL);
+  fail_unless (tmpdir != NULL);
+}
+
+static void
+teardown (void)
+{
+  GDir *dir = g_dir_open (tmpdir, 0, NULL);
+  const gchar *name;
+
+  while (dir && (name = g_dir_read_name (dir))) {
+    gchar *path = g_build_filename (tmpdir, name, NULL);
+    g_unlink (path);
+    g_free (path);
+  }
+  if (dir)
+    g_dir_close (dir);
+  g_rmdir (tmpdir);
+  g_free (tmpdir);
+  tmpdir = NULL;
+}
+
+static void
+fill_umid (MXFUMID * umid)
+{
+  guint i;
+
+  for (i = 0; i < 32; i++)
+    umid->u[i] = i;
+}
+
+static MXFIndexCache *
+create_cache (void)
+{
+  MXFIndexCache *cache = mxf_index_cache_new (FILE_SIZE, MTIME);
+  GArray *offsets;
+  MXFUMID umid;
+  guint i;
+
+  fill_umid (&umid);
+
+  /* every third edit unit known, with some holes in the middle */
+  offsets = g_array_new (FALSE, TRUE, sizeof (GstMXFDemuxIndex));
+  g_array_set_size (offsets, N_OFFSETS);
+  for (i = 0; i < N_OFFSETS; i += 3) {
+    GstMXFDemuxIndex *index = &g_array_index (offsets, GstMXFDemuxIndex, i);
+
+    if (i > 30 && i < 60)
+      continue;
+
+    index->offset = 4096 + i * 1000;
+    index->pts = (i % 2) ? G_MAXUINT64 : i + 2;
+    index->dts = (i % 2) ? G_MAXUINT64 : i;
+    index->keyframe = (i % 12) == 0;
+    index->initialized = TRUE;
+  }
+  mxf_index_cache_add_track (cache, &umid, 1, 2, 3, N_OFFSETS, offsets);
+  g_array_free (offsets, TRUE);
+
+  return cache;
+}
+
+static gchar *
+save_cache (const MXFIndexCache * cache)
+{
+  gchar *filename = g_build_filename (tmpdir, "test.mxfindex", NULL);
+  GError *err = NULL;
+
+  fail_unless (mxf_index_cache_save (cache, filename, &err));
+  fail_unless (err == NULL);
+
+  return filename;
+}
+
+GST_START_TEST (test_save_load)
+{
+  MXFIndexCache *cache, *loaded;
+  const MXFIndexCacheTrack *orig, *track;
+  gchar *filename;
+  MXFUMID umid;
+  guint i;
+
+  cache = create_cache ();
+  filename = save_cache (cache);
+
+  loaded = mxf_index_cache_load (filename, FILE_SIZE, MTIME);
+  fail_unless (loaded != NULL);
+  fail_unless_equals_int (mxf_index_cache_get_n_entries (loaded),
+      mxf_index_cache_get_n_entries (cache));
+
+  fill_umid (&umid);
+  orig = mxf_index_cache_find_track (cache, &umid, 1, 2, 3);
+  track = mxf_index_cache_find_track (loaded, &umid, 1, 2, 3);
+  fail_unless (track != NULL);
+  fail_unless (mxf_index_cache_find_track (loaded, &umid, 1, 2, 4) == NULL);
+  fail_unless_equals_int64 (track->duration, N_OFFSETS);
+  fail_unless (track->offsets->len <= orig->offsets->len);
+
+  for (i = 0; i < orig->offsets->len; i++) {
+    const GstMXFDemuxIndex *a = &g_array_index (orig->offsets,
+        GstMXFDemuxIndex, i);
+    const GstMXFDemuxIndex *b;
+
+    if (i >= track->offsets->len) {
+      fail_if (a->initialized);
+      continue;
+    }
+
+    b = &g_array_index (track->offsets, GstMXFDemuxIndex, i);
+    fail_unless_equals_int (a->initialized, b->initialized);
+    if (!a->initialized)
+      continue;
+    fail_unless_equals_uint64 (a->offset, b->offset);
+    fail_unless_equals_uint64 (a->pts, b->pts);
+    fail_unless_equals_uint64 (a->dts, b->dts);
+    fail_unless_equals_int (a->keyframe, b->keyframe);
+  }
+  mxf_index_cache_free (loaded);
+
+  /* a cache of another version of the file is ignored */
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME + 1) == NULL);
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE + 1, MTIME) == NULL);
+
+  mxf_index_cache_free (cache);
+  g_free (filename);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_load_truncated)
+{
+  MXFIndexCache *cache;
+  gchar *filename, *contents;
+  gsize length, i;
+
+  cache = create_cache ();
+  filename = save_cache (cache);
+  mxf_index_cache_free (cache);
+
+  fail_unless (g_file_get_contents (filename, &contents, &length, NULL));
+  for (i = 0; i < length; i++) {
+    fail_unless (g_file_set_contents (filename, contents, i, NULL));
+    fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  }
+
+  g_free (contents);
+  g_free (filename);
+}
+
+GST_END_TEST;
+
+static gchar *
+write_track_header (guint32 n_offsets, guint32 n_entries,
+    const guint8 * entries, guint entries_size)
+{
+  gchar *filename = g_build_filename (tmpdir, "corrupt.mxfindex", NULL);
+  GstByteWriter writer;
+  MXFUMID umid;
+  guint size;
+  guint8 *data;
+
+  fill_umid (&umid);
+
+  gst_byte_writer_init (&writer);
+  gst_byte_writer_put_data (&writer, (const guint8 *) MXF_INDEX_CACHE_MAGIC,
+      8);
+  gst_byte_writer_put_uint32_be (&writer, MXF_INDEX_CACHE_VERSION);
+  gst_byte_writer_put_uint64_be (&writer, FILE_SIZE);
+  gst_byte_writer_put_int64_be (&writer, MTIME);
+  gst_byte_writer_put_uint32_be (&writer, 1);
+  gst_byte_writer_put_data (&writer, (const guint8 *) &umid, sizeof (umid));
+  gst_byte_writer_put_uint32_be (&writer, 1);
+  gst_byte_writer_put_uint32_be (&writer, 2);
+  gst_byte_writer_put_uint32_be (&writer, 3);
+  gst_byte_writer_put_int64_be (&writer, N_OFFSETS);
+  gst_byte_writer_put_uint32_be (&writer, n_offsets);
+  gst_byte_writer_put_uint32_be (&writer, n_entries);
+  gst_byte_writer_put_data (&writer, entries, entries_size);
+
+  size = gst_byte_writer_get_size (&writer);
+  data = gst_byte_writer_reset_and_get_data (&writer);
+  fail_unless (g_file_set_contents (filename, (const gchar *) data, size,
+          NULL));
+  g_free (data);
+
+  return filename;
+}
+
+GST_START_TEST (test_load_corrupt)
+{
+  MXFIndexCache *cache;
+  gchar *filename;
+  /* skip 0, offset +4096, keyframe */
+  const guint8 entry[] = { 0x00, 0x80, 0x40, 0x01 };
+  /* skip 2^63, offset +4096, keyframe */
+  const guint8 huge_skip[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x01, 0x80, 0x40, 0x01
+  };
+  /* skip 0, offset +FILE_SIZE, keyframe */
+  const guint8 past_end[] = { 0x00, 0x80, 0x80, 0x80, 0x01, 0x01 };
+  /* skip 0, offset -1, keyframe */
+  const guint8 negative[] = { 0x00, 0x01, 0x01 };
+  /* skip 0, offset +4096, keyframe, then skip 0, offset -8192, keyframe */
+  const guint8 backwards[] = { 0x00, 0x80, 0x40, 0x01, 0x00, 0xff, 0x7f,
+    0x01
+  };
+
+  /* sane */
+  filename = write_track_header (10, 1, entry, sizeof (entry));
+  cache = mxf_index_cache_load (filename, FILE_SIZE, MTIME);
+  fail_unless (cache != NULL);
+  fail_unless_equals_int (mxf_index_cache_get_n_entries (cache), 1);
+  mxf_index_cache_free (cache);
+  g_free (filename);
+
+  /* more edit units than the file could contain, which must fail before
+   * anything is allocated for them */
+  filename = write_track_header (G_MAXUINT32, 1, entry, sizeof (entry));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  filename = write_track_header (FILE_SIZE / 17 + 1, 1, entry, sizeof (entry));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  /* more entries than edit units */
+  filename = write_track_header (0, 1, entry, sizeof (entry));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  /* more entries than data */
+  filename = write_track_header (10, 2, entry, sizeof (entry));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  /* an entry after the last edit unit */
+  filename = write_track_header (10, 1, huge_skip, sizeof (huge_skip));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  /* offsets outside of the file */
+  filename = write_track_header (10, 1, past_end, sizeof (past_end));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  filename = write_track_header (10, 1, negative, sizeof (negative));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+
+  filename = write_track_header (10, 2, backwards, sizeof (backwards));
+  fail_unless (mxf_index_cache_load (filename, FILE_SIZE, MTIME) == NULL);
+  g_free (filename);
+}
+
+GST_END_TEST;
+
+static Suite *
+mxfindexcache_suite (void)
+{
+  Suite *s = suite_create ("mxfindexcache");
+  TCase *tc_chain = tcase_create ("general");
+
+  GST_DEBUG_CATEGORY_INIT (mxf_debug, "mxf", 0, "mxf");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_checked_fixture (tc_chain, setup, teardown);
+  tcase_add_test (tc_chain, test_save_load);
+  tcase_add_test (tc_chain, test_load_truncated);
+  tcase_add_test (tc_chain, test_load_corrupt);
+
+  return s;
+}
+
+GST_CHECK_MAIN (mxfindexcache);
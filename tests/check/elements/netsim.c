@@ -49,6 +49,96 @@ GST_START_TEST (netsim_stress_delayed)
 
 GST_END_TEST;
 
+GST_START_TEST (netsim_delay_keeps_order)
+{
+  GstHarness *h = gst_harness_new_parse ("netsim delay-probability=1.0 "
+      "min-delay=10 max-delay=10 allow-reordering=false");
+  guint i;
+
+  gst_harness_set_src_caps_str (h, "mycaps");
+
+  for (i = 0; i < 100; i++) {
+    GstBuffer *buf = gst_harness_create_buffer (h, 100);
+    GST_BUFFER_OFFSET (buf) = i;
+    fail_unless_equals_int (GST_FLOW_OK, gst_harness_push (h, buf));
+  }
+
+  for (i = 0; i < 100; i++) {
+    GstBuffer *buf = gst_harness_pull (h);
+    fail_unless_equals_uint64 (i, GST_BUFFER_OFFSET (buf));
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (netsim_burst_loss)
+{
+  GstHarness *h = gst_harness_new_parse ("netsim burst-enter-probability=1.0 "
+      "burst-exit-probability=1.0");
+  guint i;
+
+  gst_harness_set_src_caps_str (h, "mycaps");
+
+  /* entering and leaving a burst of one buffer on every other buffer */
+  for (i = 0; i < 10; i++)
+    gst_harness_push (h, gst_harness_create_buffer (h, 100));
+  fail_unless_equals_int (5, gst_harness_buffers_received (h));
+
+  /* never leaving the burst again */
+  g_object_set (h->element, "burst-exit-probability", 0.0, NULL);
+  for (i = 0; i < 10; i++)
+    gst_harness_push (h, gst_harness_create_buffer (h, 100));
+  fail_unless_equals_int (5, gst_harness_buffers_received (h));
+
+  /* and not dropping within the burst */
+  g_object_set (h->element, "burst-drop-probability", 0.0, NULL);
+  for (i = 0; i < 10; i++)
+    gst_harness_push (h, gst_harness_create_buffer (h, 100));
+  fail_unless_equals_int (15, gst_harness_buffers_received (h));
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (netsim_reorder)
+{
+  GstHarness *h = gst_harness_new_parse ("netsim reorder-distance=2");
+  guint expected[] = { 1, 2, 0, 3 };
+  GstBuffer *buf;
+  guint i;
+
+  gst_harness_set_src_caps_str (h, "mycaps");
+
+  for (i = 0; i < 4; i++) {
+    g_object_set (h->element, "reorder-probability", i == 0 ? 1.0 : 0.0, NULL);
+    buf = gst_harness_create_buffer (h, 100);
+    GST_BUFFER_OFFSET (buf) = i;
+    fail_unless_equals_int (GST_FLOW_OK, gst_harness_push (h, buf));
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (expected); i++) {
+    buf = gst_harness_pull (h);
+    fail_unless_equals_uint64 (expected[i], GST_BUFFER_OFFSET (buf));
+    gst_buffer_unref (buf);
+  }
+
+  /* a held back buffer is sent on EOS */
+  g_object_set (h->element, "reorder-probability", 1.0, NULL);
+  fail_unless_equals_int (GST_FLOW_OK, gst_harness_push (h,
+          gst_harness_create_buffer (h, 100)));
+  fail_unless_equals_int (4, gst_harness_buffers_received (h));
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  fail_unless_equals_int (5, gst_harness_buffers_received (h));
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static Suite *
 netsim_suite (void)
 {
@@ -58,6 +148,9 @@ netsim_suite (void)
   suite_add_tcase (s, (tc_chain = tcase_create ("general")));
   tcase_add_test (tc_chain, netsim_stress);
   tcase_add_test (tc_chain, netsim_stress_delayed);
+  tcase_add_test (tc_chain, netsim_delay_keeps_order);
+  tcase_add_test (tc_chain, netsim_burst_loss);
+  tcase_add_test (tc_chain, netsim_reorder);
 
   return s;
 }
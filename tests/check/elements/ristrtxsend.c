@@ -0,0 +1,251 @@
+/* GStreamer
+ *
+ * unit test for ristrtxsend
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/rtp/gstrtpbuffer.h>
+
+#define SSRC 0x1000
+#define RTX_SSRC (SSRC + 1)
+#define CLOCK_RATE 90000
+
+static GstHarness *
+create_harness (guint max_size_packets, guint max_size_time)
+{
+  GstHarness *h = gst_harness_new ("ristrtxsend");
+
+  g_object_set (h->element, "max-size-packets", max_size_packets,
+      "max-size-time", max_size_time, NULL);
+  gst_harness_set_src_caps_str (h, "application/x-rtp, media=(string)video, "
+      "payload=(int)96, clock-rate=(int)90000, ssrc=(uint)4096");
+
+  return h;
+}
+
+/* Pushes a packet and drops the original that is passed through */
+static void
+push_packet (GstHarness * h, guint16 seqnum, guint32 rtptime)
+{
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf = gst_rtp_buffer_new_allocate (10, 0, 0);
+
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp));
+  gst_rtp_buffer_set_ssrc (&rtp, SSRC);
+  gst_rtp_buffer_set_payload_type (&rtp, 96);
+  gst_rtp_buffer_set_seq (&rtp, seqnum);
+  gst_rtp_buffer_set_timestamp (&rtp, rtptime);
+  gst_rtp_buffer_unmap (&rtp);
+
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  gst_buffer_unref (gst_harness_pull (h));
+}
+
+static void
+request_rtx (GstHarness * h, guint16 seqnum, guint num_seqnums)
+{
+  fail_unless (gst_harness_push_upstream_event (h,
+          gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
+              gst_structure_new ("GstRTPRetransmissionRequest",
+                  "seqnum", G_TYPE_UINT, (guint) seqnum,
+                  "num-seqnums", G_TYPE_UINT, num_seqnums,
+                  "ssrc", G_TYPE_UINT, (guint) SSRC, NULL))));
+}
+
+/* Retransmissions are pushed from the source pad task, in the order they
+ * were requested */
+static void
+pull_rtx (GstHarness * h, guint16 seqnum)
+{
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstBuffer *buf = gst_harness_pull (h);
+
+  fail_unless (buf != NULL);
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_ssrc (&rtp), RTX_SSRC);
+  fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), seqnum);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+}
+
+/* Checks that nothing is retransmitted for a request, by following it with
+ * one that is known to be answered */
+static void
+request_none (GstHarness * h, guint16 seqnum, guint num_seqnums,
+    guint16 known_seqnum)
+{
+  request_rtx (h, seqnum, num_seqnums);
+  request_rtx (h, known_seqnum, 1);
+  pull_rtx (h, known_seqnum);
+}
+
+/* EOS is queued behind the retransmissions, nothing may be left before it */
+static void
+finish (GstHarness * h)
+{
+  GstEvent *event;
+
+  fail_unless (gst_harness_push_event (h, gst_event_new_eos ()));
+  while ((event = gst_harness_pull_event (h))) {
+    GstEventType type = GST_EVENT_TYPE (event);
+
+    gst_event_unref (event);
+    if (type == GST_EVENT_EOS)
+      break;
+  }
+  fail_unless_equals_int (gst_harness_buffers_in_queue (h), 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_START_TEST (test_rtx_range)
+{
+  GstHarness *h = create_harness (100, 0);
+  guint rtx_requests, rtx_packets;
+  guint16 i;
+
+  /* 5 is lost before it reaches us */
+  for (i = 0; i < 10; i++) {
+    if (i != 5)
+      push_packet (h, i, i * 3000);
+  }
+
+  request_rtx (h, 2, 6);
+  pull_rtx (h, 2);
+  pull_rtx (h, 3);
+  pull_rtx (h, 4);
+  pull_rtx (h, 6);
+  pull_rtx (h, 7);
+
+  /* single packet, and a range reaching past the newest packet */
+  request_rtx (h, 9, 1);
+  pull_rtx (h, 9);
+  request_rtx (h, 8, 4);
+  pull_rtx (h, 8);
+  pull_rtx (h, 9);
+
+  /* only the lost one, and only packets that were not sent yet */
+  request_none (h, 5, 1, 0);
+  request_none (h, 10, 20, 1);
+
+  g_object_get (h->element, "num-rtx-requests", &rtx_requests,
+      "num-rtx-packets", &rtx_packets, NULL);
+  fail_unless_equals_int (rtx_requests, 6 + 1 + 4 + 1 + 1 + 20 + 1);
+  fail_unless_equals_int (rtx_packets, 5 + 1 + 2 + 1 + 1);
+
+  finish (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtx_history_wrap)
+{
+  GstHarness *h = create_harness (4, 0);
+  guint16 seqnum = 65530;
+  guint i;
+
+  /* wraps the ring several times, and the seqnums once */
+  for (i = 0; i < 10; i++, seqnum++)
+    push_packet (h, seqnum, i * 3000);
+
+  /* only the last 4 are kept */
+  request_rtx (h, 65534, 6);
+  pull_rtx (h, 0);
+  pull_rtx (h, 1);
+  pull_rtx (h, 2);
+  pull_rtx (h, 3);
+
+  request_none (h, 65530, 6, 0);
+
+  /* a gap as big as the history drops all of it */
+  push_packet (h, 8, 30000);
+  request_none (h, 0, 8, 8);
+  push_packet (h, 9, 33000);
+  request_rtx (h, 8, 2);
+  pull_rtx (h, 8);
+  pull_rtx (h, 9);
+
+  finish (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtx_history_expire_time)
+{
+  /* 100ms per packet, at most 250ms between the oldest and the newest */
+  GstHarness *h = create_harness (0, 250);
+  guint16 i;
+
+  for (i = 0; i < 10; i++)
+    push_packet (h, i, i * CLOCK_RATE / 10);
+
+  request_rtx (h, 5, 5);
+  pull_rtx (h, 7);
+  pull_rtx (h, 8);
+  pull_rtx (h, 9);
+
+  request_none (h, 0, 7, 7);
+
+  finish (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtx_history_seqnum_jump)
+{
+  GstHarness *h = create_harness (100, 0);
+  guint16 i;
+
+  for (i = 1000; i < 1010; i++)
+    push_packet (h, i, i * 3000);
+
+  /* a late packet just before the history is not kept */
+  push_packet (h, 995, 995 * 3000);
+  request_none (h, 995, 1, 1000);
+
+  /* but a jump further back than the history can reach restarts it */
+  push_packet (h, 10, 10 * 3000);
+  push_packet (h, 11, 11 * 3000);
+  request_rtx (h, 10, 2);
+  pull_rtx (h, 10);
+  pull_rtx (h, 11);
+
+  request_none (h, 1000, 10, 11);
+
+  finish (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+ristrtxsend_suite (void)
+{
+  Suite *s = suite_create ("ristrtxsend");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_rtx_range);
+  tcase_add_test (tc_chain, test_rtx_history_wrap);
+  tcase_add_test (tc_chain, test_rtx_history_expire_time);
+  tcase_add_test (tc_chain, test_rtx_history_seqnum_jump);
+
+  return s;
+}
+
+GST_CHECK_MAIN (ristrtxsend);
@@ -0,0 +1,200 @@
+/* GStreamer
+ *
+ * unit test for roundrobin
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+
+#define N_PADS 2
+
+typedef struct
+{
+  /* h[0] pushes into the element and takes the output of src_0, the
+   * others take the output of the other src pads */
+  GstHarness *h[N_PADS];
+  guint64 offset;
+} TestRoundRobin;
+
+static void
+setup_roundrobin (TestRoundRobin * t)
+{
+  guint i;
+
+  t->h[0] = gst_harness_new_with_padnames ("roundrobin", "sink", "src_0");
+  for (i = 1; i < N_PADS; i++) {
+    gchar *name = g_strdup_printf ("src_%u", i);
+
+    t->h[i] = gst_harness_new_with_element (t->h[0]->element, NULL, name);
+    g_free (name);
+  }
+  gst_harness_set_src_caps_str (t->h[0], "application/x-test");
+  t->offset = 0;
+}
+
+static void
+teardown_roundrobin (TestRoundRobin * t)
+{
+  guint i;
+
+  for (i = N_PADS; i > 0; i--)
+    gst_harness_teardown (t->h[i - 1]);
+}
+
+static GstPad *
+get_src_pad (TestRoundRobin * t, guint pad)
+{
+  gchar *name = g_strdup_printf ("src_%u", pad);
+  GstPad *srcpad = gst_element_get_static_pad (t->h[0]->element, name);
+
+  fail_unless (srcpad != NULL);
+  g_free (name);
+
+  return srcpad;
+}
+
+static void
+set_weight (TestRoundRobin * t, guint pad, guint weight)
+{
+  GstPad *srcpad = get_src_pad (t, pad);
+
+  g_object_set (srcpad, "weight", weight, NULL);
+  gst_object_unref (srcpad);
+}
+
+/* Pushes a buffer and returns the pad it came out of, or -1 if it was
+ * dropped */
+static gint
+push_one (TestRoundRobin * t)
+{
+  GstBuffer *buf = gst_buffer_new ();
+  gint pad = -1;
+  guint i;
+
+  GST_BUFFER_OFFSET (buf) = t->offset++;
+  fail_unless_equals_int (gst_harness_push (t->h[0], buf), GST_FLOW_OK);
+
+  for (i = 0; i < N_PADS; i++) {
+    if (gst_harness_buffers_in_queue (t->h[i]) == 0)
+      continue;
+
+    fail_unless (pad == -1, "buffer came out of several pads");
+    pad = i;
+    buf = gst_harness_pull (t->h[i]);
+    fail_unless_equals_int (GST_BUFFER_OFFSET (buf), t->offset - 1);
+    gst_buffer_unref (buf);
+  }
+
+  return pad;
+}
+
+/* Checks that the next buffers are dispatched following @pattern, a
+ * repeating sequence of pad indices */
+static void
+check_pattern (TestRoundRobin * t, const gint * pattern, guint length,
+    guint repeat)
+{
+  guint i;
+
+  for (i = 0; i < length * repeat; i++)
+    fail_unless_equals_int (push_one (t), pattern[i % length]);
+}
+
+GST_START_TEST (test_default_weights)
+{
+  TestRoundRobin t;
+  const gint pattern[] = { 0, 1 };
+  guint i;
+
+  setup_roundrobin (&t);
+
+  for (i = 0; i < N_PADS; i++) {
+    GstPad *srcpad = get_src_pad (&t, i);
+    guint weight;
+
+    g_object_get (srcpad, "weight", &weight, NULL);
+    fail_unless_equals_int (weight, 1);
+    gst_object_unref (srcpad);
+  }
+
+  /* equal weights, plain round robin */
+  check_pattern (&t, pattern, G_N_ELEMENTS (pattern), 10);
+
+  teardown_roundrobin (&t);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_weights)
+{
+  TestRoundRobin t;
+  const gint pattern[] = { 0, 1, 0 };
+
+  setup_roundrobin (&t);
+
+  /* twice as many buffers on src_0, interleaved rather than in bursts */
+  set_weight (&t, 0, 2);
+  set_weight (&t, 1, 1);
+  check_pattern (&t, pattern, G_N_ELEMENTS (pattern), 10);
+
+  teardown_roundrobin (&t);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_zero_weight)
+{
+  TestRoundRobin t;
+  const gint only_first[] = { 0 };
+  const gint only_second[] = { 1 };
+  const gint dropped[] = { -1 };
+
+  setup_roundrobin (&t);
+
+  set_weight (&t, 1, 0);
+  check_pattern (&t, only_first, 1, 5);
+
+  /* changing the weights while streaming */
+  set_weight (&t, 0, 0);
+  set_weight (&t, 1, 3);
+  check_pattern (&t, only_second, 1, 5);
+
+  /* nothing to send to, the buffers are dropped */
+  set_weight (&t, 1, 0);
+  check_pattern (&t, dropped, 1, 5);
+
+  teardown_roundrobin (&t);
+}
+
+GST_END_TEST;
+
+static Suite *
+roundrobin_suite (void)
+{
+  Suite *s = suite_create ("roundrobin");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_default_weights);
+  tcase_add_test (tc_chain, test_weights);
+  tcase_add_test (tc_chain, test_zero_weight);
+
+  return s;
+}
+
+GST_CHECK_MAIN (roundrobin);
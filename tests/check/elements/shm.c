@@ -20,6 +20,9 @@
  * Boston, MA 02110-1301, USA.
  */
 
+/* using GValueArray, which has not replacement */
+#define GLIB_DISABLE_DEPRECATION_WARNINGS
+
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
@@ -229,6 +232,106 @@ GST_START_TEST (test_shm_live)
 
 GST_END_TEST;
 
+GST_START_TEST (test_shm_stats)
+{
+  GstBuffer *buf;
+  GstQuery *query;
+  GstCaps *caps = gst_caps_new_empty_simple ("application/x-test");
+  GstAllocator *alloc;
+  GstAllocationParams params;
+  GstStructure *stats;
+  guint64 used, high_water, largest_free, size;
+  GstSegment segment;
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("test"));
+  gst_pad_push_event (srcpad, gst_event_new_caps (caps));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  query = gst_query_new_allocation (caps, FALSE);
+  gst_caps_unref (caps);
+  fail_unless (gst_pad_peer_query (srcpad, query));
+  gst_query_parse_nth_allocation_param (query, 0, &alloc, &params);
+  fail_unless (alloc != NULL);
+  gst_query_unref (query);
+
+  buf = gst_buffer_new_allocate (alloc, 1000, &params);
+  gst_object_unref (alloc);
+
+  g_object_get (sink, "stats", &stats, NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "shm-size", &size));
+  fail_unless (gst_structure_get_uint64 (stats, "used", &used));
+  fail_unless (gst_structure_get_uint64 (stats, "largest-free", &largest_free));
+  fail_unless (used >= 1000);
+  fail_unless (largest_free <= size - used);
+  gst_structure_free (stats);
+
+  gst_buffer_unref (buf);
+
+  g_object_get (sink, "stats", &stats, NULL);
+  fail_unless (gst_structure_get_uint64 (stats, "used", &used));
+  fail_unless (gst_structure_get_uint64 (stats, "high-water", &high_water));
+  fail_unless (gst_structure_get_uint64 (stats, "largest-free", &largest_free));
+  fail_unless_equals_uint64 (used, 0);
+  fail_unless (high_water >= 1000);
+  fail_unless_equals_uint64 (largest_free, size);
+  gst_structure_free (stats);
+
+  teardown_shm ();
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_shm_client_policy_drop)
+{
+  GstStructure *stats, *client_stats;
+  const GValue *clients;
+  GstSegment segment;
+  guint pending = 0;
+  guint64 dropped = 0;
+  gint i;
+
+  g_object_set (sink, "client-policy", 1 /* drop */ ,
+      "max-pending-buffers", 1, NULL);
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("test"));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  /* The buffers the client receives are kept in the check buffer list, so
+   * it never releases the first one and everything after it is dropped */
+  for (i = 0; i < 3; i++)
+    fail_unless (gst_pad_push (srcpad,
+            gst_buffer_new_allocate (NULL, 1000, NULL)) == GST_FLOW_OK);
+
+  g_mutex_lock (&check_mutex);
+  while (buffers == NULL)
+    g_cond_wait (&check_cond, &check_mutex);
+  g_mutex_unlock (&check_mutex);
+
+  g_object_get (sink, "stats", &stats, NULL);
+  clients = gst_structure_get_value (stats, "clients");
+  fail_unless (clients != NULL);
+  fail_unless_equals_int (((GValueArray *) g_value_get_boxed (clients))->
+      n_values, 1);
+  client_stats = g_value_get_boxed (g_value_array_get_nth (g_value_get_boxed
+          (clients), 0));
+  fail_unless (gst_structure_get_uint (client_stats, "pending-buffers",
+          &pending));
+  fail_unless (gst_structure_get_uint64 (client_stats, "dropped-buffers",
+          &dropped));
+  fail_unless_equals_int (pending, 1);
+  fail_unless_equals_uint64 (dropped, 2);
+  gst_structure_free (stats);
+
+  fail_unless_equals_int (g_list_length (buffers), 1);
+
+  gst_check_drop_buffers ();
+  teardown_shm ();
+}
+
+GST_END_TEST;
+
 static Suite *
 shm_suite (void)
 {
@@ -239,6 +342,8 @@ shm_suite (void)
   tcase_add_checked_fixture (tc, setup_shm, NULL);
   tcase_add_test (tc, test_shm_sysmem_alloc);
   tcase_add_test (tc, test_shm_alloc);
+  tcase_add_test (tc, test_shm_stats);
+  tcase_add_test (tc, test_shm_client_policy_drop);
   suite_add_tcase (s, tc);
 
   tc = tcase_create ("shm2");
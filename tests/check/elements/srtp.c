@@ -207,6 +207,103 @@ GST_START_TEST (test_roc)
 
 GST_END_TEST;
 
+#define RTP_PACKET_SIZE 172
+
+static GstBuffer *
+create_rtp_packet (guint32 ssrc, guint16 seqnum, gsize tailroom)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint i;
+
+  buf = gst_buffer_new_allocate (NULL, RTP_PACKET_SIZE + tailroom, NULL);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  map.data[0] = 0x80;
+  map.data[1] = 8;
+  GST_WRITE_UINT16_BE (map.data + 2, seqnum);
+  GST_WRITE_UINT32_BE (map.data + 4, seqnum * 160);
+  GST_WRITE_UINT32_BE (map.data + 8, ssrc);
+  for (i = 12; i < RTP_PACKET_SIZE; i++)
+    map.data[i] = i + seqnum;
+  gst_buffer_unmap (buf, &map);
+  gst_buffer_set_size (buf, RTP_PACKET_SIZE);
+
+  return buf;
+}
+
+GST_START_TEST (test_srtpenc_srtpdec_list_sessions)
+{
+  static const guint8 key_data[] = {
+    0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45, 0x67, 0x89,
+    0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45, 0x67, 0x89,
+    0x01, 0x23, 0x45, 0x67, 0x89, 0x01, 0x23, 0x45, 0x67, 0x89
+  };
+  GstElement *enc;
+  GstHarness *henc, *hdec;
+  GstBufferList *list;
+  GstBuffer *key;
+  GstStructure *stats;
+  guint i;
+
+  enc = gst_element_factory_make ("srtpenc", NULL);
+  key = gst_buffer_new_wrapped (g_memdup (key_data, sizeof (key_data)),
+      sizeof (key_data));
+  g_object_set (enc, "key", key, "n-sessions", 4, NULL);
+  gst_buffer_unref (key);
+
+  henc = gst_harness_new_with_element (enc, "rtp_sink_0", "rtp_src_0");
+  gst_object_unref (enc);
+  gst_harness_set_src_caps_str (henc, "application/x-rtp, payload=(int)8");
+
+  hdec = gst_harness_new_with_padnames ("srtpdec", "rtp_sink", "rtp_src");
+  g_signal_connect (hdec->element, "request-key", G_CALLBACK (request_key),
+      NULL);
+  gst_harness_set_src_caps_str (hdec, "application/x-srtp, payload=(int)8");
+
+  /* Two streams ending up in different sessions, half of the packets have
+   * room to be protected in place */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 8; i++)
+    gst_buffer_list_add (list, create_rtp_packet (1 + i % 2, i / 2,
+            (i & 2) ? 64 : 0));
+  fail_unless_equals_int (gst_pad_push_list (henc->srcpad, list), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (henc), 8);
+
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 8; i++) {
+    GstBuffer *buf = gst_harness_pull (henc);
+
+    fail_unless (gst_buffer_get_size (buf) > RTP_PACKET_SIZE);
+    gst_buffer_list_add (list, buf);
+  }
+  fail_unless_equals_int (gst_pad_push_list (hdec->srcpad, list), GST_FLOW_OK);
+  fail_unless_equals_int (gst_harness_buffers_in_queue (hdec), 8);
+
+  for (i = 0; i < 8; i++) {
+    GstBuffer *buf = gst_harness_pull (hdec);
+    GstBuffer *expected = create_rtp_packet (1 + i % 2, i / 2, 0);
+    GstMapInfo map;
+
+    gst_buffer_map (expected, &map, GST_MAP_READ);
+    fail_unless_equals_int (gst_buffer_get_size (buf), map.size);
+    fail_unless (gst_buffer_memcmp (buf, 0, map.data, map.size) == 0);
+    gst_buffer_unmap (expected, &map);
+
+    gst_buffer_unref (expected);
+    gst_buffer_unref (buf);
+  }
+
+  g_object_get (henc->element, "stats", &stats, NULL);
+  fail_unless_equals_int (gst_value_array_get_size (gst_structure_get_value
+          (stats, "streams")), 2);
+  gst_structure_free (stats);
+
+  gst_harness_teardown (henc);
+  gst_harness_teardown (hdec);
+}
+
+GST_END_TEST;
+
 #ifdef HAVE_SRTP2
 
 GST_START_TEST (test_simple_mki)
@@ -352,6 +449,7 @@ srtp_suite (void)
   tcase_add_test (tc_chain, test_create_and_unref);
   tcase_add_test (tc_chain, test_play);
   tcase_add_test (tc_chain, test_roc);
+  tcase_add_test (tc_chain, test_srtpenc_srtpdec_list_sessions);
 #ifdef HAVE_SRTP2
   tcase_add_test (tc_chain, test_simple_mki);
   tcase_add_test (tc_chain, test_srtpdec_multiple_mki);
@@ -0,0 +1,302 @@
+/* GStreamer
+ *
+ * unit test for tsdemux
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+
+#define PACKET_SIZE 188
+#define PMT_PID 0x1000
+#define ES_PID 0x100
+
+static GstPad *mysrcpad, *mysinkpad;
+
+static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC, GST_PAD_ALWAYS,
+    GST_STATIC_CAPS ("video/mpegts, systemstream=(boolean)true, "
+        "packetsize=(int)188"));
+
+static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS_ANY);
+
+/* The PES payloads of the test stream: one that fits in a few packets and
+ * has its length in the header, one that needs more packets than a buffer
+ * can have memories and has none, and a last one in a single packet */
+static const gsize payload_sizes[] = { 400, 6000, 50 };
+
+static guint32
+crc32_mpeg (const guint8 * data, gsize size)
+{
+  guint32 crc = 0xffffffff;
+  gsize i;
+  gint j;
+
+  for (i = 0; i < size; i++) {
+    crc ^= (guint32) data[i] << 24;
+    for (j = 0; j < 8; j++)
+      crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04c11db7 : crc << 1;
+  }
+
+  return crc;
+}
+
+static guint8
+payload_byte (guint pes, gsize i)
+{
+  return (i * 7 + pes) & 0xff;
+}
+
+/* Splits @data into packets, the first one starting the unit and the last
+ * one padded with an adaptation field */
+static void
+append_packets (GByteArray * ts, guint16 pid, guint8 * cc,
+    const guint8 * data, gsize size)
+{
+  gboolean first = TRUE;
+
+  while (size > 0) {
+    guint8 packet[PACKET_SIZE];
+    gsize len = MIN (size, PACKET_SIZE - 4);
+    guint8 *p = packet + 4;
+
+    packet[0] = 0x47;
+    packet[1] = (first ? 0x40 : 0x00) | (pid >> 8);
+    packet[2] = pid & 0xff;
+    packet[3] = (len < PACKET_SIZE - 4 ? 0x30 : 0x10) | (*cc & 0x0f);
+
+    if (len < PACKET_SIZE - 4) {
+      guint8 af_len = PACKET_SIZE - 4 - 1 - len;
+
+      *p++ = af_len;
+      if (af_len > 0) {
+        *p++ = 0x00;
+        memset (p, 0xff, af_len - 1);
+        p += af_len - 1;
+      }
+    }
+    memcpy (p, data, len);
+
+    g_byte_array_append (ts, packet, PACKET_SIZE);
+    data += len;
+    size -= len;
+    *cc += 1;
+    first = FALSE;
+  }
+}
+
+static void
+append_section (GByteArray * ts, guint16 pid, guint8 * section, gsize size)
+{
+  guint8 data[1024];
+  guint8 cc = 0;
+  guint32 crc;
+
+  /* pointer field, section, CRC */
+  data[0] = 0;
+  memcpy (data + 1, section, size);
+  crc = crc32_mpeg (section, size);
+  GST_WRITE_UINT32_BE (data + 1 + size, crc);
+
+  append_packets (ts, pid, &cc, data, 1 + size + 4);
+}
+
+static void
+append_pes (GByteArray * ts, guint8 * cc, guint pes, gboolean bounded)
+{
+  gsize size = payload_sizes[pes];
+  guint8 *data = g_malloc (14 + size);
+  guint64 pts = 90000 + pes * 3000;
+  gsize i;
+
+  data[0] = 0x00;
+  data[1] = 0x00;
+  data[2] = 0x01;
+  data[3] = 0xc0;
+  GST_WRITE_UINT16_BE (data + 4, bounded ? 8 + size : 0);
+  data[6] = 0x80;
+  /* PTS only */
+  data[7] = 0x80;
+  data[8] = 5;
+  data[9] = 0x21 | ((pts >> 29) & 0x0e);
+  GST_WRITE_UINT16_BE (data + 10, ((pts >> 14) & 0xfffe) | 1);
+  GST_WRITE_UINT16_BE (data + 12, ((pts << 1) & 0xfffe) | 1);
+  for (i = 0; i < size; i++)
+    data[14 + i] = payload_byte (pes, i);
+
+  append_packets (ts, ES_PID, cc, data, 14 + size);
+  g_free (data);
+}
+
+static GByteArray *
+create_stream (void)
+{
+  GByteArray *ts = g_byte_array_new ();
+  guint8 cc = 0;
+  /* program 1 in PMT_PID */
+  guint8 pat[] = {
+    0x00, 0xb0, 13, 0x00, 0x01, 0xc1, 0x00, 0x00,
+    0x00, 0x01, 0xe0 | (PMT_PID >> 8), PMT_PID & 0xff
+  };
+  /* no PCR, MPEG audio in ES_PID */
+  guint8 pmt[] = {
+    0x02, 0xb0, 18, 0x00, 0x01, 0xc1, 0x00, 0x00,
+    0xff, 0xff, 0xf0, 0x00,
+    0x03, 0xe0 | (ES_PID >> 8), ES_PID & 0xff, 0xf0, 0x00
+  };
+
+  append_section (ts, 0, pat, sizeof (pat));
+  append_section (ts, PMT_PID, pmt, sizeof (pmt));
+  append_pes (ts, &cc, 0, TRUE);
+  append_pes (ts, &cc, 1, FALSE);
+  append_pes (ts, &cc, 2, TRUE);
+
+  return ts;
+}
+
+static void
+pad_added (GstElement * element, GstPad * pad, gpointer user_data)
+{
+  fail_unless (mysinkpad == NULL);
+
+  mysinkpad = gst_pad_new_from_static_template (&sinktemplate, "sink");
+  gst_pad_set_chain_function (mysinkpad, gst_check_chain_func);
+  gst_pad_set_active (mysinkpad, TRUE);
+  fail_unless_equals_int (gst_pad_link (pad, mysinkpad), GST_PAD_LINK_OK);
+}
+
+static GstElement *
+setup_tsdemux (void)
+{
+  GstElement *demux = gst_check_setup_element ("tsdemux");
+  GstCaps *caps;
+
+  g_signal_connect (demux, "pad-added", G_CALLBACK (pad_added), NULL);
+  mysrcpad = gst_check_setup_src_pad (demux, &srctemplate);
+  gst_pad_set_active (mysrcpad, TRUE);
+  fail_unless_equals_int (gst_element_set_state (demux, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_static_pad_template_get_caps (&srctemplate);
+  gst_check_setup_events (mysrcpad, demux, caps, GST_FORMAT_BYTES);
+  gst_caps_unref (caps);
+
+  return demux;
+}
+
+static void
+cleanup_tsdemux (GstElement * demux)
+{
+  GstPad *peer;
+
+  gst_element_set_state (demux, GST_STATE_NULL);
+
+  /* the source pad it was linked to is gone with the stream, if not
+   * released already */
+  peer = gst_pad_get_peer (mysinkpad);
+  if (peer) {
+    gst_pad_unlink (peer, mysinkpad);
+    gst_object_unref (peer);
+  }
+  gst_pad_set_active (mysinkpad, FALSE);
+  gst_object_unref (mysinkpad);
+  mysinkpad = NULL;
+
+  gst_check_teardown_src_pad (demux);
+  gst_check_teardown_element (demux);
+  gst_check_drop_buffers ();
+}
+
+/* Pushes the stream in chunks of @chunk_size bytes and checks that each
+ * PES comes out whole */
+static void
+check_reassembly (gsize chunk_size)
+{
+  GstElement *demux = setup_tsdemux ();
+  GByteArray *ts = create_stream ();
+  GList *l;
+  gsize offset;
+  guint pes;
+
+  for (offset = 0; offset < ts->len; offset += chunk_size) {
+    gsize size = MIN (chunk_size, ts->len - offset);
+    GstBuffer *buf = gst_buffer_new_allocate (NULL, size, NULL);
+
+    gst_buffer_fill (buf, 0, ts->data + offset, size);
+    fail_unless_equals_int (gst_pad_push (mysrcpad, buf), GST_FLOW_OK);
+  }
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+
+  fail_unless (mysinkpad != NULL);
+  fail_unless_equals_int (g_list_length (buffers),
+      G_N_ELEMENTS (payload_sizes));
+
+  for (l = buffers, pes = 0; l; l = l->next, pes++) {
+    GstBuffer *buf = l->data;
+    GstMapInfo map;
+    gsize i;
+
+    fail_unless (gst_buffer_map (buf, &map, GST_MAP_READ));
+    fail_unless_equals_int (map.size, payload_sizes[pes]);
+    for (i = 0; i < map.size; i++)
+      fail_unless_equals_int (map.data[i], payload_byte (pes, i));
+    gst_buffer_unmap (buf, &map);
+  }
+
+  g_byte_array_unref (ts);
+  cleanup_tsdemux (demux);
+}
+
+GST_START_TEST (test_pes_reassembly)
+{
+  /* all packets in a single memory */
+  check_reassembly (G_MAXSIZE);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_pes_reassembly_split)
+{
+  /* packets straddling the input buffers */
+  check_reassembly (1000);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_pes_reassembly_packets)
+{
+  /* a buffer per packet */
+  check_reassembly (PACKET_SIZE);
+}
+
+GST_END_TEST;
+
+static Suite *
+tsdemux_suite (void)
+{
+  Suite *s = suite_create ("tsdemux");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_pes_reassembly);
+  tcase_add_test (tc_chain, test_pes_reassembly_split);
+  tcase_add_test (tc_chain, test_pes_reassembly_packets);
+
+  return s;
+}
+
+GST_CHECK_MAIN (tsdemux);
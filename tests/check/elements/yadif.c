@@ -0,0 +1,168 @@
+/* GStreamer
+ *
+ * unit test for yadif
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
+
+#define WIDTH 46
+
+static GstBuffer *
+create_frame (const GstVideoInfo * info)
+{
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (info),
+      NULL);
+  GRand *rand = g_rand_new_with_seed (GST_VIDEO_INFO_HEIGHT (info));
+  GstMapInfo map;
+  gsize i;
+
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < map.size; i++)
+    map.data[i] = g_rand_int_range (rand, 0, 256);
+  gst_buffer_unmap (buf, &map);
+  g_rand_free (rand);
+
+  return buf;
+}
+
+static GstBuffer *
+deinterlace (const GstVideoInfo * info, GstBuffer * in, guint n_threads)
+{
+  GstElement *yadif = gst_element_factory_make ("yadif", NULL);
+  GstHarness *h;
+  GstBuffer *out;
+
+  /* only picked up when starting */
+  g_object_set (yadif, "n-threads", n_threads, NULL);
+  h = gst_harness_new_with_element (yadif, "sink", "src");
+  gst_object_unref (yadif);
+
+  gst_harness_set_src_caps (h, gst_video_info_to_caps ((GstVideoInfo *) info));
+  fail_unless_equals_int (gst_harness_push (h, gst_buffer_ref (in)),
+      GST_FLOW_OK);
+  out = gst_harness_pull (h);
+  fail_unless (out != NULL);
+
+  gst_harness_teardown (h);
+
+  return out;
+}
+
+static void
+check_rows (const GstVideoInfo * info, GstVideoFrame * expected,
+    GstVideoFrame * frame, guint n_threads)
+{
+  gint c, y;
+
+  for (c = 0; c < GST_VIDEO_INFO_N_COMPONENTS (info); c++) {
+    gint w = GST_VIDEO_INFO_COMP_WIDTH (info, c);
+    gint h = GST_VIDEO_INFO_COMP_HEIGHT (info, c);
+    gint stride = GST_VIDEO_INFO_COMP_STRIDE (info, c);
+    guint8 *expected_data = GST_VIDEO_FRAME_COMP_DATA (expected, c);
+    guint8 *data = GST_VIDEO_FRAME_COMP_DATA (frame, c);
+
+    for (y = 0; y < h; y++)
+      fail_unless (memcmp (expected_data + y * stride, data + y * stride,
+              w) == 0, "%ux%u %s: row %d of component %d differs with "
+          "%u threads", GST_VIDEO_INFO_WIDTH (info),
+          GST_VIDEO_INFO_HEIGHT (info), GST_VIDEO_INFO_NAME (info), y, c,
+          n_threads);
+  }
+}
+
+/* The output of several threads has to be the same as the output of one,
+ * including the first and last rows, which are filtered with the lines
+ * around them mirrored, and the slice boundaries */
+static void
+check_threads (GstVideoFormat format, gint height)
+{
+  GstVideoInfo info;
+  GstBuffer *in, *expected;
+  GstVideoFrame in_frame, expected_frame;
+  guint n_threads;
+  gint c;
+
+  gst_video_info_set_interlaced_format (&info, format,
+      GST_VIDEO_INTERLACE_MODE_INTERLEAVED, WIDTH, height);
+  in = create_frame (&info);
+  expected = deinterlace (&info, in, 1);
+
+  fail_unless (gst_video_frame_map (&in_frame, &info, in, GST_MAP_READ));
+  fail_unless (gst_video_frame_map (&expected_frame, &info, expected,
+          GST_MAP_READ));
+
+  /* the first row belongs to the field that is kept */
+  for (c = 0; c < GST_VIDEO_INFO_N_COMPONENTS (&info); c++)
+    fail_unless (memcmp (GST_VIDEO_FRAME_COMP_DATA (&in_frame, c),
+            GST_VIDEO_FRAME_COMP_DATA (&expected_frame, c),
+            GST_VIDEO_INFO_COMP_WIDTH (&info, c)) == 0);
+
+  for (n_threads = 2; n_threads <= 5; n_threads++) {
+    GstBuffer *out = deinterlace (&info, in, n_threads);
+    GstVideoFrame frame;
+
+    fail_unless (gst_video_frame_map (&frame, &info, out, GST_MAP_READ));
+    check_rows (&info, &expected_frame, &frame, n_threads);
+    gst_video_frame_unmap (&frame);
+
+    /* the padding as well */
+    fail_unless (gst_buffer_memcmp (out, 0, expected_frame.map[0].data,
+            expected_frame.map[0].size) == 0);
+    gst_buffer_unref (out);
+  }
+
+  gst_video_frame_unmap (&expected_frame);
+  gst_video_frame_unmap (&in_frame);
+  gst_buffer_unref (expected);
+  gst_buffer_unref (in);
+}
+
+GST_START_TEST (test_threads_odd_height)
+{
+  check_threads (GST_VIDEO_FORMAT_I420, 67);
+  check_threads (GST_VIDEO_FORMAT_Y42B, 35);
+  check_threads (GST_VIDEO_FORMAT_Y444, 33);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_threads_even_height)
+{
+  check_threads (GST_VIDEO_FORMAT_I420, 64);
+  check_threads (GST_VIDEO_FORMAT_Y42B, 34);
+  check_threads (GST_VIDEO_FORMAT_Y444, 96);
+}
+
+GST_END_TEST;
+
+static Suite *
+yadif_suite (void)
+{
+  Suite *s = suite_create ("yadif");
+  TCase *tc_chain = tcase_create ("general");
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_threads_odd_height);
+  tcase_add_test (tc_chain, test_threads_even_height);
+
+  return s;
+}
+
+GST_CHECK_MAIN (yadif);
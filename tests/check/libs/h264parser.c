@@ -229,6 +229,78 @@ GST_START_TEST (test_h264_parse_slice_5bytes)
 
 GST_END_TEST;
 
+/* SPS with an emulation prevention byte, PPS */
+static guint8 sps_epb_pps[] = {
+  0x00, 0x00, 0x00, 0x01, 0x67, 0x42, 0x00, 0x00, 0x03, 0x01, 0x80,
+  0x00, 0x00, 0x01, 0x68, 0xce, 0x38, 0x80
+};
+
+GST_START_TEST (test_h264_index_nalus)
+{
+  GstH264ParserResult res;
+  GstH264NalUnitEntry entries[4];
+  GstH264NalParser *const parser = gst_h264_nal_parser_new ();
+  guint n;
+
+  res = gst_h264_parser_index_nalus (parser, slice_eoseq_slice, 0,
+      sizeof (slice_eoseq_slice), entries, G_N_ELEMENTS (entries), &n);
+
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (n, 4);
+  assert_equals_int (entries[0].type, GST_H264_NAL_SLICE_IDR);
+  /* only SPS, PPS and AU delimiters get the 4 byte start code */
+  assert_equals_int (entries[0].sc_offset, 1);
+  assert_equals_int (entries[0].offset, 4);
+  assert_equals_int (entries[0].size, 20);
+  assert_equals_int (entries[0].ref_idc, 3);
+  assert_equals_int (entries[1].type, GST_H264_NAL_SEQ_END);
+  assert_equals_int (entries[1].offset, 28);
+  assert_equals_int (entries[1].size, 1);
+  assert_equals_int (entries[2].type, GST_H264_NAL_SLICE_IDR);
+  assert_equals_int (entries[2].offset, 33);
+  assert_equals_int (entries[2].size, 20);
+  assert_equals_int (entries[3].type, GST_H264_NAL_STREAM_END);
+  assert_equals_int (entries[3].offset, 57);
+  assert_equals_int (entries[3].size, 1);
+
+  /* continue after running out of entries */
+  res = gst_h264_parser_index_nalus (parser, slice_eoseq_slice, 0,
+      sizeof (slice_eoseq_slice), entries, 3, &n);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (n, 3);
+
+  res = gst_h264_parser_index_nalus (parser, slice_eoseq_slice,
+      entries[2].offset + entries[2].size, sizeof (slice_eoseq_slice),
+      entries, G_N_ELEMENTS (entries), &n);
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (n, 1);
+  assert_equals_int (entries[0].type, GST_H264_NAL_STREAM_END);
+  assert_equals_int (entries[0].offset, 57);
+
+  res = gst_h264_parser_index_nalus (parser, sps_epb_pps, 0,
+      sizeof (sps_epb_pps), entries, G_N_ELEMENTS (entries), &n);
+
+  assert_equals_int (res, GST_H264_PARSER_OK);
+  assert_equals_int (n, 2);
+  assert_equals_int (entries[0].type, GST_H264_NAL_SPS);
+  assert_equals_int (entries[0].size, 7);
+  assert_equals_int (entries[0].n_epb, 1);
+  assert_equals_int (entries[1].type, GST_H264_NAL_PPS);
+  assert_equals_int (entries[1].sc_offset, 11);
+  assert_equals_int (entries[1].size, 4);
+  assert_equals_int (entries[1].n_epb, 0);
+
+  /* no start code */
+  res = gst_h264_parser_index_nalus (parser, sps_epb_pps, 4,
+      sizeof (sps_epb_pps) - 7, entries, G_N_ELEMENTS (entries), &n);
+  assert_equals_int (res, GST_H264_PARSER_NO_NAL);
+  assert_equals_int (n, 0);
+
+  gst_h264_nal_parser_free (parser);
+}
+
+GST_END_TEST;
+
 static guint8 nalu_sps_with_vui[] = {
   0x00, 0x00, 0x00, 0x01, 0x67, 0x64, 0x00, 0x28,
   0xac, 0xd9, 0x40, 0x78, 0x04, 0x4f, 0xde, 0x03,
@@ -324,6 +396,7 @@ h264parser_suite (void)
   tcase_add_test (tc_chain, test_h264_parse_slice_dpa);
   tcase_add_test (tc_chain, test_h264_parse_slice_eoseq_slice);
   tcase_add_test (tc_chain, test_h264_parse_slice_5bytes);
+  tcase_add_test (tc_chain, test_h264_index_nalus);
   tcase_add_test (tc_chain, test_h264_parse_invalid_sei);
 
   return s;
@@ -151,6 +151,43 @@ GST_START_TEST (test_h265_parse_slice_6bytes)
 
 GST_END_TEST;
 
+GST_START_TEST (test_h265_index_nalus)
+{
+  GstH265ParserResult res;
+  GstH265NalUnitEntry entries[8];
+  GstH265Parser *const parser = gst_h265_parser_new ();
+  guint n;
+
+  res = gst_h265_parser_index_nalus (parser, slice_eos_slice_eob, 0,
+      sizeof (slice_eos_slice_eob), entries, G_N_ELEMENTS (entries), &n);
+
+  assert_equals_int (res, GST_H265_PARSER_OK);
+  assert_equals_int (n, 4);
+  assert_equals_int (entries[0].type, GST_H265_NAL_SLICE_IDR_W_RADL);
+  assert_equals_int (entries[0].sc_offset, 0);
+  assert_equals_int (entries[0].offset, 4);
+  assert_equals_int (entries[0].size, 43);
+  assert_equals_int (entries[0].n_epb, 2);
+  assert_equals_int (entries[0].layer_id, 0);
+  assert_equals_int (entries[0].temporal_id_plus1, 1);
+  assert_equals_int (entries[1].type, GST_H265_NAL_EOS);
+  assert_equals_int (entries[1].sc_offset, 47);
+  assert_equals_int (entries[1].offset, 51);
+  assert_equals_int (entries[1].size, 2);
+  assert_equals_int (entries[1].n_epb, 0);
+  assert_equals_int (entries[2].type, GST_H265_NAL_SLICE_IDR_W_RADL);
+  assert_equals_int (entries[2].offset, 57);
+  assert_equals_int (entries[2].size, 43);
+  assert_equals_int (entries[2].n_epb, 2);
+  assert_equals_int (entries[3].type, GST_H265_NAL_EOB);
+  assert_equals_int (entries[3].offset, 104);
+  assert_equals_int (entries[3].size, 2);
+
+  gst_h265_parser_free (parser);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_h265_base_profiles)
 {
   GstH265ProfileTierLevel ptl;
@@ -466,6 +503,7 @@ h265parser_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_h265_parse_slice_eos_slice_eob);
   tcase_add_test (tc_chain, test_h265_parse_slice_6bytes);
+  tcase_add_test (tc_chain, test_h265_index_nalus);
   tcase_add_test (tc_chain, test_h265_base_profiles);
   tcase_add_test (tc_chain, test_h265_base_profiles_compat);
   tcase_add_test (tc_chain, test_h265_format_range_profiles_exact_match);
@@ -163,6 +163,34 @@ GST_START_TEST (test_mis_identified_datas)
 
 GST_END_TEST;
 
+GST_START_TEST (test_start_code_positions)
+{
+  GstMpegVideoPacket packet = { 0, };
+  guint8 data[64];
+  guint i, pos;
+
+  /* start codes at each position of and across the vectorized blocks, with
+   * almost start codes all around */
+  for (pos = 0; pos <= sizeof (data) - 4; pos++) {
+    for (i = 0; i < sizeof (data); i++)
+      data[i] = i % 3 == 2 ? 0x02 : 0x00;
+    data[pos] = 0x00;
+    data[pos + 1] = 0x00;
+    data[pos + 2] = 0x01;
+    data[pos + 3] = GST_MPEG_VIDEO_PACKET_SEQUENCE;
+
+    fail_unless (gst_mpeg_video_parse (&packet, data, sizeof (data), 0));
+    assert_equals_int (packet.offset, pos + 4);
+    assert_equals_int (packet.type, GST_MPEG_VIDEO_PACKET_SEQUENCE);
+    fail_unless (packet.size < 0);
+  }
+
+  /* the byte after the start code must be there */
+  fail_if (gst_mpeg_video_parse (&packet, data, sizeof (data) - 1, 0));
+}
+
+GST_END_TEST;
+
 static Suite *
 mpegvideoparsers_suite (void)
 {
@@ -175,6 +203,7 @@ mpegvideoparsers_suite (void)
   tcase_add_test (tc_chain, test_mpeg_parse_sequence_header);
   tcase_add_test (tc_chain, test_mpeg_parse_sequence_extension);
   tcase_add_test (tc_chain, test_mis_identified_datas);
+  tcase_add_test (tc_chain, test_start_code_positions);
 
   return s;
 }
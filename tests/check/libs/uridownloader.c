@@ -0,0 +1,260 @@
+/* GStreamer
+ *
+ * unit test for GstUriDownloader
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/uridownloader/gsturidownloader.h>
+
+#include "../elements/test_http_src.h"
+
+#define FRAGMENT_SIZE 1000
+
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  /* source element that served the last fetch of each URI */
+  GHashTable *sources;
+  guint starts;
+  gboolean streaming;
+} TestData;
+
+static gboolean
+test_src_start (GstTestHTTPSrc * src, const gchar * uri,
+    GstTestHTTPSrcInput * input_data, gpointer user_data)
+{
+  TestData *data = user_data;
+
+  g_mutex_lock (&data->lock);
+  data->starts++;
+  g_hash_table_insert (data->sources, g_strdup (uri), gst_object_ref (src));
+  g_mutex_unlock (&data->lock);
+
+  if (g_str_has_suffix (uri, "/missing")) {
+    input_data->status_code = 404;
+    return FALSE;
+  }
+
+  if (g_str_has_suffix (uri, "/endless"))
+    input_data->size = G_MAXUINT32;
+  else
+    input_data->size = FRAGMENT_SIZE;
+  input_data->status_code = 200;
+
+  return TRUE;
+}
+
+static GstFlowReturn
+test_src_create (GstTestHTTPSrc * src, guint64 offset, guint length,
+    GstBuffer ** retbuf, gpointer context, gpointer user_data)
+{
+  TestData *data = user_data;
+  GstBuffer *buf = gst_buffer_new_allocate (NULL, length, NULL);
+
+  gst_buffer_memset (buf, 0, 0xa5, length);
+  *retbuf = buf;
+
+  g_mutex_lock (&data->lock);
+  data->streaming = TRUE;
+  g_cond_broadcast (&data->cond);
+  g_mutex_unlock (&data->lock);
+
+  return GST_FLOW_OK;
+}
+
+static const GstTestHTTPSrcCallbacks test_callbacks = {
+  test_src_start,
+  test_src_create,
+};
+
+static TestData *
+setup_test_data (void)
+{
+  TestData *data = g_new0 (TestData, 1);
+
+  g_mutex_init (&data->lock);
+  g_cond_init (&data->cond);
+  data->sources = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+      gst_object_unref);
+  gst_test_http_src_install_callbacks (&test_callbacks, data);
+
+  return data;
+}
+
+static void
+teardown_test_data (TestData * data)
+{
+  gst_test_http_src_install_callbacks (NULL, NULL);
+  g_hash_table_unref (data->sources);
+  g_cond_clear (&data->cond);
+  g_mutex_clear (&data->lock);
+  g_free (data);
+}
+
+static gpointer
+get_source (TestData * data, const gchar * uri)
+{
+  gpointer src;
+
+  g_mutex_lock (&data->lock);
+  src = g_hash_table_lookup (data->sources, uri);
+  g_mutex_unlock (&data->lock);
+
+  fail_unless (src != NULL);
+  return src;
+}
+
+static void
+fetch_ok (GstUriDownloader * downloader, const gchar * uri)
+{
+  GstFragment *fragment;
+  GstBuffer *buf;
+  GError *err = NULL;
+
+  fragment = gst_uri_downloader_fetch_uri (downloader, uri, NULL, FALSE, FALSE,
+      TRUE, &err);
+  fail_unless (fragment != NULL);
+  fail_unless (err == NULL);
+
+  buf = gst_fragment_get_buffer (fragment);
+  fail_unless_equals_int (gst_buffer_get_size (buf), FRAGMENT_SIZE);
+  gst_buffer_unref (buf);
+  g_object_unref (fragment);
+}
+
+static void
+fetch_fail (GstUriDownloader * downloader, const gchar * uri)
+{
+  GstFragment *fragment;
+  GError *err = NULL;
+
+  fragment = gst_uri_downloader_fetch_uri (downloader, uri, NULL, FALSE, FALSE,
+      TRUE, &err);
+  fail_unless (fragment == NULL);
+  fail_unless (err != NULL);
+  g_clear_error (&err);
+}
+
+GST_START_TEST (test_reuse_per_host)
+{
+  TestData *data = setup_test_data ();
+  GstUriDownloader *downloader = gst_uri_downloader_new ();
+
+  /* each host keeps its own source between the fetches */
+  fetch_ok (downloader, "http://host-a/1");
+  fetch_ok (downloader, "http://host-b/1");
+  fetch_ok (downloader, "http://host-a/2");
+  fetch_ok (downloader, "http://host-b/2");
+  fetch_ok (downloader, "http://host-a:8080/1");
+
+  fail_unless_equals_int (data->starts, 5);
+  fail_unless (get_source (data, "http://host-a/1") != get_source (data,
+          "http://host-b/1"));
+  fail_unless (get_source (data, "http://host-a/1") == get_source (data,
+          "http://host-a/2"));
+  fail_unless (get_source (data, "http://host-b/1") == get_source (data,
+          "http://host-b/2"));
+  fail_unless (get_source (data, "http://host-a/1") != get_source (data,
+          "http://host-a:8080/1"));
+
+  gst_object_unref (downloader);
+  teardown_test_data (data);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_reuse_after_error)
+{
+  TestData *data = setup_test_data ();
+  GstUriDownloader *downloader = gst_uri_downloader_new ();
+
+  fetch_ok (downloader, "http://host-a/1");
+  fetch_fail (downloader, "http://host-a/missing");
+  fetch_ok (downloader, "http://host-a/2");
+
+  /* the failed fetch leaves a source that works for the next one */
+  fail_unless_equals_int (data->starts, 3);
+  fail_unless (get_source (data, "http://host-a/1") == get_source (data,
+          "http://host-a/missing"));
+  fail_unless (get_source (data, "http://host-a/1") == get_source (data,
+          "http://host-a/2"));
+
+  gst_object_unref (downloader);
+  teardown_test_data (data);
+}
+
+GST_END_TEST;
+
+static gpointer
+fetch_endless (GstUriDownloader * downloader)
+{
+  GstFragment *fragment;
+  GError *err = NULL;
+
+  fragment = gst_uri_downloader_fetch_uri (downloader,
+      "http://host-a/endless", NULL, FALSE, FALSE, TRUE, &err);
+  fail_unless (fragment == NULL);
+  g_clear_error (&err);
+
+  return NULL;
+}
+
+GST_START_TEST (test_dispose_during_fetch)
+{
+  TestData *data = setup_test_data ();
+  GstUriDownloader *downloader = gst_uri_downloader_new ();
+  GThread *thread;
+
+  /* leaves an idle source in the pool as well */
+  fetch_ok (downloader, "http://host-b/1");
+
+  thread = g_thread_new ("fetch", (GThreadFunc) fetch_endless, downloader);
+  g_mutex_lock (&data->lock);
+  while (!data->streaming)
+    g_cond_wait (&data->cond, &data->lock);
+  g_mutex_unlock (&data->lock);
+
+  /* cancels the fetch and waits for it to give its source back */
+  g_object_run_dispose (G_OBJECT (downloader));
+  g_thread_join (thread);
+
+  gst_object_unref (downloader);
+  teardown_test_data (data);
+}
+
+GST_END_TEST;
+
+static Suite *
+uridownloader_suite (void)
+{
+  Suite *s = suite_create ("uridownloader");
+  TCase *tc_chain = tcase_create ("general");
+
+  fail_unless (gst_test_http_src_register_plugin (gst_registry_get (),
+          "testhttpsrc"));
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_reuse_per_host);
+  tcase_add_test (tc_chain, test_reuse_after_error);
+  tcase_add_test (tc_chain, test_dispose_during_fetch);
+
+  return s;
+}
+
+GST_CHECK_MAIN (uridownloader);
@@ -5804,6 +5804,204 @@ GST_START_TEST (test_wavparse_master_process_crash)
 
 GST_END_TEST;
 
+/**** fd passing test ****/
+
+/* This test does not use test_base: both pipelines live in this process and
+ * the buffers are pushed from the test, so that the flow return of each of
+ * them can be checked */
+
+#define FD_PASSING_BUFFER_SIZE 4096
+#define FD_PASSING_MAX_BUFFERS_IN_FLIGHT 4
+#define FD_PASSING_N_BUFFERS 16
+#define FD_PASSING_N_BUFFERS_AFTER_FLUSH 8
+/* buffers from this offset on are refused by the slave */
+#define FD_PASSING_ERROR_AT 8
+
+static gint fd_passing_received;
+static gint fd_passing_freed;
+
+static GstPadProbeReturn
+fd_passing_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+  GstMemory *mem;
+  GstMapInfo map;
+
+  /* received as an fd, not copied on the socket */
+  FAIL_UNLESS_EQUALS_INT (gst_buffer_n_memory (buffer), 1);
+  mem = gst_buffer_peek_memory (buffer, 0);
+  FAIL_UNLESS (gst_memory_is_type (mem, "fd"));
+  /* the sender still holds the memory */
+  FAIL_UNLESS (GST_MEMORY_IS_READONLY (mem));
+
+  FAIL_UNLESS (gst_buffer_map (buffer, &map, GST_MAP_READ));
+  FAIL_UNLESS_EQUALS_INT (map.size, FD_PASSING_BUFFER_SIZE);
+  FAIL_UNLESS_EQUALS_INT (map.data[0], GST_BUFFER_OFFSET (buffer));
+  FAIL_UNLESS_EQUALS_INT (map.data[map.size - 1], GST_BUFFER_OFFSET (buffer));
+  gst_buffer_unmap (buffer, &map);
+
+  g_atomic_int_inc (&fd_passing_received);
+
+  if (GST_BUFFER_OFFSET (buffer) >= FD_PASSING_ERROR_AT) {
+    gst_buffer_unref (buffer);
+    GST_PAD_PROBE_INFO_FLOW_RETURN (info) = GST_FLOW_NOT_LINKED;
+    return GST_PAD_PROBE_HANDLED;
+  }
+
+  return GST_PAD_PROBE_OK;
+}
+
+static void
+fd_passing_buffer_freed (gpointer user_data, GstMiniObject * obj)
+{
+  g_atomic_int_inc (&fd_passing_freed);
+}
+
+static GstFlowReturn
+fd_passing_push (GstPad * srcpad, GstAllocator * allocator, guint64 offset)
+{
+  GstBuffer *buffer;
+  GstMemory *mem;
+  GstMapInfo map;
+
+  mem = gst_allocator_alloc (allocator, FD_PASSING_BUFFER_SIZE, NULL);
+  FAIL_UNLESS (mem);
+  FAIL_UNLESS (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  memset (map.data, offset, map.size);
+  gst_memory_unmap (mem, &map);
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, mem);
+  GST_BUFFER_OFFSET (buffer) = offset;
+  gst_mini_object_weak_ref (GST_MINI_OBJECT_CAST (buffer),
+      fd_passing_buffer_freed, NULL);
+
+  return gst_pad_push (srcpad, buffer);
+}
+
+GST_START_TEST (test_fd_passing_buffers_in_flight)
+{
+  GstElement *master, *slave, *ipcpipelinesink, *ipcpipelinesrc, *fakesink;
+  GstPad *srcpad, *sinkpad;
+  GstAllocator *allocator = NULL;
+  GstSegment segment;
+  GstQuery *query;
+  GstCaps *caps;
+  GstFlowReturn ret;
+  gint64 end_time;
+  guint n, error_at = 0;
+  int sockets[2];
+
+  fd_passing_received = 0;
+  fd_passing_freed = 0;
+
+  FAIL_IF (socketpair (PF_UNIX, SOCK_STREAM, 0, sockets) < 0);
+
+  master = create_pipeline ("pipeline");
+  ipcpipelinesink = gst_element_factory_make ("ipcpipelinesink", NULL);
+  g_object_set (ipcpipelinesink, "fdin", sockets[0], "fdout", sockets[0],
+      "fd-passing", TRUE, "max-buffers-in-flight",
+      FD_PASSING_MAX_BUFFERS_IN_FLIGHT, NULL);
+  gst_bin_add (GST_BIN (master), ipcpipelinesink);
+
+  slave = create_pipeline ("ipcslavepipeline");
+  ipcpipelinesrc = gst_element_factory_make ("ipcpipelinesrc", NULL);
+  g_object_set (ipcpipelinesrc, "fdin", sockets[1], "fdout", sockets[1], NULL);
+  fakesink = gst_element_factory_make ("fakesink", NULL);
+  /* the last sample would keep the last fd from being released */
+  g_object_set (fakesink, "sync", FALSE, "async", FALSE,
+      "enable-last-sample", FALSE, NULL);
+  gst_bin_add_many (GST_BIN (slave), ipcpipelinesrc, fakesink, NULL);
+  FAIL_UNLESS (gst_element_link (ipcpipelinesrc, fakesink));
+
+  sinkpad = gst_element_get_static_pad (fakesink, "sink");
+  gst_pad_add_probe (sinkpad, GST_PAD_PROBE_TYPE_BUFFER, fd_passing_probe,
+      NULL, NULL);
+  gst_object_unref (sinkpad);
+
+  srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  sinkpad = gst_element_get_static_pad (ipcpipelinesink, "sink");
+  FAIL_UNLESS (gst_pad_link (srcpad, sinkpad) == GST_PAD_LINK_OK);
+  gst_object_unref (sinkpad);
+  FAIL_UNLESS (gst_pad_set_active (srcpad, TRUE));
+
+  /* state changes are forwarded to the slave */
+  FAIL_IF (gst_element_set_state (master, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_FAILURE);
+  FAIL_UNLESS (gst_element_get_state (master, NULL, NULL,
+          5 * GST_SECOND) == GST_STATE_CHANGE_SUCCESS);
+
+  caps = gst_caps_new_empty_simple ("application/x-ipcpipeline-test");
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  FAIL_UNLESS (gst_pad_push_event (srcpad,
+          gst_event_new_stream_start ("fd-passing")));
+  FAIL_UNLESS (gst_pad_push_event (srcpad, gst_event_new_caps (caps)));
+  FAIL_UNLESS (gst_pad_push_event (srcpad, gst_event_new_segment (&segment)));
+
+  /* the sink offers memfds to write into */
+  query = gst_query_new_allocation (caps, TRUE);
+  FAIL_UNLESS (gst_pad_peer_query (srcpad, query));
+  FAIL_UNLESS (gst_query_get_n_allocation_params (query) > 0);
+  gst_query_parse_nth_allocation_param (query, 0, &allocator, NULL);
+  FAIL_UNLESS (allocator);
+  gst_query_unref (query);
+  gst_caps_unref (caps);
+
+  /* the flow return of a buffer comes back with one of the next
+   * FD_PASSING_MAX_BUFFERS_IN_FLIGHT - 1 buffers at the latest */
+  for (n = 0; n < FD_PASSING_N_BUFFERS; n++) {
+    ret = fd_passing_push (srcpad, allocator, n);
+    if (n < FD_PASSING_ERROR_AT) {
+      FAIL_UNLESS_EQUALS_INT (ret, GST_FLOW_OK);
+    } else if (ret != GST_FLOW_OK) {
+      FAIL_UNLESS_EQUALS_INT (ret, GST_FLOW_NOT_LINKED);
+      if (!error_at)
+        error_at = n;
+    }
+  }
+  FAIL_UNLESS (error_at >= FD_PASSING_ERROR_AT);
+  FAIL_UNLESS (error_at <
+      FD_PASSING_ERROR_AT + FD_PASSING_MAX_BUFFERS_IN_FLIGHT);
+
+  /* a flush forgets the buffers in flight and their flow return */
+  FAIL_UNLESS (gst_pad_push_event (srcpad, gst_event_new_flush_start ()));
+  FAIL_UNLESS (gst_pad_push_event (srcpad, gst_event_new_flush_stop (TRUE)));
+  FAIL_UNLESS (gst_pad_push_event (srcpad, gst_event_new_segment (&segment)));
+
+  for (n = 0; n < FD_PASSING_N_BUFFERS_AFTER_FLUSH; n++) {
+    ret = fd_passing_push (srcpad, allocator, n);
+    FAIL_UNLESS_EQUALS_INT (ret, GST_FLOW_OK);
+  }
+
+  /* the sink keeps each buffer until the slave released its fd, which it
+   * does as soon as it freed it */
+  end_time = g_get_monotonic_time () + 5 * G_TIME_SPAN_SECOND;
+  while (g_atomic_int_get (&fd_passing_freed) <
+      FD_PASSING_N_BUFFERS + FD_PASSING_N_BUFFERS_AFTER_FLUSH &&
+      g_get_monotonic_time () < end_time)
+    g_usleep (1000);
+  FAIL_UNLESS_EQUALS_INT (g_atomic_int_get (&fd_passing_freed),
+      FD_PASSING_N_BUFFERS + FD_PASSING_N_BUFFERS_AFTER_FLUSH);
+  /* the buffers queued on the slave when it refused them never reached the
+   * probe, all the others did */
+  FAIL_UNLESS (g_atomic_int_get (&fd_passing_received) >=
+      FD_PASSING_ERROR_AT + 1 + FD_PASSING_N_BUFFERS_AFTER_FLUSH);
+
+  FAIL_UNLESS (gst_element_set_state (master, GST_STATE_NULL) ==
+      GST_STATE_CHANGE_SUCCESS);
+  gst_element_set_state (slave, GST_STATE_NULL);
+
+  gst_pad_set_active (srcpad, FALSE);
+  gst_object_unref (srcpad);
+  gst_object_unref (allocator);
+  gst_object_unref (master);
+  gst_object_unref (slave);
+  close (sockets[0]);
+  close (sockets[1]);
+}
+
+GST_END_TEST;
+
 static Suite *
 ipcpipeline_suite (void)
 {
@@ -6061,6 +6259,14 @@ ipcpipeline_suite (void)
      with the master pipeline. */
   tcase_add_test (tc_chain, test_wavparse_master_process_crash);
 
+  /* fd_passing tests pass buffers as fds over a socketpair, with
+     several buffers in flight. They check that flow returns are
+     reported on later buffers, that a flush resets them, and that
+     the slave releases all the fds. */
+#ifdef HAVE_MEMFD_CREATE
+  tcase_add_test (tc_chain, test_fd_passing_buffers_in_flight);
+#endif
+
   return s;
 }
 
@@ -0,0 +1,229 @@
+/* GStreamer
+ *
+ * mixmatrix-bench.c: micro-benchmark for audiomixmatrix
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Pushes one second worth of 48kHz audio through audiomixmatrix for a few
+ * typical matrix shapes and reports how many times faster than real time
+ * each of them runs:
+ *
+ *  - stereo to mono and 5.1 to stereo downmixes
+ *  - 64 channels (e.g. a MADI feed) mixed down to 2 and to 16 channels
+ *  - 64 channels routed 1:1 to 64 channels in a different order
+ *  - 64 channels to 16, with only a few inputs contributing to each output
+ *
+ * Run it against two builds of the plugin to compare versions.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+#define RATE 48000
+#define SAMPLES_PER_BUFFER 1024
+
+typedef enum
+{
+  MATRIX_DENSE,
+  MATRIX_ROUTING,
+  MATRIX_SPARSE
+} MatrixType;
+
+typedef struct
+{
+  const gchar *name;
+  guint in_channels;
+  guint out_channels;
+  MatrixType type;
+} Scenario;
+
+static const Scenario scenarios[] = {
+  {"2 -> 1 dense", 2, 1, MATRIX_DENSE},
+  {"6 -> 2 dense", 6, 2, MATRIX_DENSE},
+  {"64 -> 2 dense", 64, 2, MATRIX_DENSE},
+  {"64 -> 16 dense", 64, 16, MATRIX_DENSE},
+  {"64 -> 64 routing", 64, 64, MATRIX_ROUTING},
+  {"64 -> 16 sparse", 64, 16, MATRIX_SPARSE},
+};
+
+static gchar *format = NULL;
+static gboolean planar = FALSE;
+static guint seconds = 10;
+
+static GOptionEntry entries[] = {
+  {"format", 'f', 0, G_OPTION_ARG_STRING, &format,
+      "Sample format (F32LE, F64LE, S16LE, S32LE, default F32LE)", "FORMAT"},
+  {"planar", 'p', 0, G_OPTION_ARG_NONE, &planar,
+      "Use non-interleaved samples", NULL},
+  {"seconds", 's', 0, G_OPTION_ARG_INT, &seconds,
+      "Seconds of audio to process per scenario", "N"},
+  {NULL}
+};
+
+static void
+set_matrix (GstElement * mixmatrix, const Scenario * scenario)
+{
+  GValue matrix = G_VALUE_INIT;
+  guint in, out;
+
+  g_value_init (&matrix, GST_TYPE_ARRAY);
+
+  for (out = 0; out < scenario->out_channels; out++) {
+    GValue row = G_VALUE_INIT;
+
+    g_value_init (&row, GST_TYPE_ARRAY);
+    for (in = 0; in < scenario->in_channels; in++) {
+      GValue v = G_VALUE_INIT;
+      gdouble coef = 0;
+
+      switch (scenario->type) {
+        case MATRIX_DENSE:
+          coef = 1.0 / scenario->in_channels;
+          break;
+        case MATRIX_ROUTING:
+          coef = (in == scenario->in_channels - 1 - out) ? 1.0 : 0.0;
+          break;
+        case MATRIX_SPARSE:
+          coef = (in % scenario->out_channels == out) ? 0.25 : 0.0;
+          break;
+      }
+
+      g_value_init (&v, G_TYPE_DOUBLE);
+      g_value_set_double (&v, coef);
+      gst_value_array_append_value (&row, &v);
+      g_value_unset (&v);
+    }
+    gst_value_array_append_value (&matrix, &row);
+    g_value_unset (&row);
+  }
+
+  g_object_set_property (G_OBJECT (mixmatrix), "matrix", &matrix);
+  g_value_unset (&matrix);
+}
+
+static void
+run_scenario (const Scenario * scenario)
+{
+  GstElement *pipeline, *mixmatrix, *sink;
+  GstPad *srcpad, *sinkpad;
+  GstSegment segment;
+  GstAudioInfo info;
+  GstBuffer *buffer;
+  GstCaps *caps;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gint64 start, elapsed;
+  guint i, n_buffers;
+
+  pipeline = gst_pipeline_new (NULL);
+  mixmatrix = gst_element_factory_make ("audiomixmatrix", NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+  if (!mixmatrix || !sink) {
+    g_printerr ("Could not create audiomixmatrix and fakesink\n");
+    return;
+  }
+  g_object_set (sink, "sync", FALSE, "async", FALSE, NULL);
+  g_object_set (mixmatrix, "in-channels", scenario->in_channels,
+      "out-channels", scenario->out_channels, "channel-mask",
+      G_GUINT64_CONSTANT (0), NULL);
+  set_matrix (mixmatrix, scenario);
+
+  gst_bin_add_many (GST_BIN (pipeline), mixmatrix, sink, NULL);
+  gst_element_link (mixmatrix, sink);
+
+  srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  sinkpad = gst_element_get_static_pad (mixmatrix, "sink");
+  gst_pad_link (srcpad, sinkpad);
+  gst_object_unref (sinkpad);
+  gst_pad_set_active (srcpad, TRUE);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  gst_audio_info_init (&info);
+  gst_audio_info_set_format (&info,
+      gst_audio_format_from_string (format ? format : "F32LE"), RATE,
+      scenario->in_channels, NULL);
+  if (planar)
+    info.layout = GST_AUDIO_LAYOUT_NON_INTERLEAVED;
+  caps = gst_audio_info_to_caps (&info);
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("mixmatrix-bench"));
+  gst_pad_push_event (srcpad, gst_event_new_caps (caps));
+  gst_caps_unref (caps);
+  gst_segment_init (&segment, GST_FORMAT_TIME);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  buffer = gst_buffer_new_allocate (NULL,
+      SAMPLES_PER_BUFFER * GST_AUDIO_INFO_BPF (&info), NULL);
+  gst_buffer_memset (buffer, 0, 0x10, gst_buffer_get_size (buffer));
+  if (planar)
+    gst_buffer_add_audio_meta (buffer, &info, SAMPLES_PER_BUFFER, NULL);
+
+  n_buffers = seconds * RATE / SAMPLES_PER_BUFFER;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < n_buffers && ret == GST_FLOW_OK; i++)
+    ret = gst_pad_push (srcpad, gst_buffer_ref (buffer));
+  elapsed = g_get_monotonic_time () - start;
+
+  gst_pad_push_event (srcpad, gst_event_new_eos ());
+  gst_buffer_unref (buffer);
+
+  if (ret != GST_FLOW_OK) {
+    g_printerr ("%-18s failed: %s\n", scenario->name,
+        gst_flow_get_name (ret));
+  } else {
+    g_print ("%-18s %8.2f ms  %8.1fx real time\n", scenario->name,
+        elapsed / 1000.0,
+        (gdouble) n_buffers * SAMPLES_PER_BUFFER / RATE * G_USEC_PER_SEC /
+        MAX (elapsed, 1));
+  }
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_pad_set_active (srcpad, FALSE);
+  gst_object_unref (srcpad);
+  gst_object_unref (pipeline);
+}
+
+int
+main (int argc, gchar ** argv)
+{
+  GOptionContext *ctx;
+  GError *error = NULL;
+  guint i;
+
+  ctx = g_option_context_new ("- audiomixmatrix benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("Error initializing: %s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  for (i = 0; i < G_N_ELEMENTS (scenarios); i++)
+    run_scenario (&scenarios[i]);
+
+  g_free (format);
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+/* GStreamer
+ *
+ * scan-start-codes.c: measure start code scanning speed of the codecparsers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Splits elementary stream files into packets with the codecparsers a
+ * number of times and prints how fast that went. Most of the time is spent
+ * looking for start codes, so high bitrate intra-only streams (e.g. 100+
+ * Mbit/s AVC-Intra, XAVC or I-frame only MPEG-2) show the scanning speed
+ * best.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/codecparsers/gsth264parser.h>
+#include <gst/codecparsers/gsth265parser.h>
+#include <gst/codecparsers/gstmpegvideoparser.h>
+#include <gst/codecparsers/gstmpeg4parser.h>
+
+static gchar *codec = NULL;
+static gint iterations = 10;
+
+static GOptionEntry entries[] = {
+  {"codec", 'c', 0, G_OPTION_ARG_STRING, &codec,
+      "Codec of the files: h264 (default), h265, mpegvideo or mpeg4", "CODEC"},
+  {"iterations", 'n', 0, G_OPTION_ARG_INT, &iterations,
+      "How many times to parse each file (default: 10)", "N"},
+  {NULL}
+};
+
+static guint
+split_h264 (const guint8 * data, gsize size)
+{
+  GstH264NalParser *parser = gst_h264_nal_parser_new ();
+  GstH264ParserResult res;
+  GstH264NalUnit nalu;
+  guint offset = 0, n = 0;
+
+  while (TRUE) {
+    res = gst_h264_parser_identify_nalu (parser, data, offset, size, &nalu);
+    if (res != GST_H264_PARSER_OK && res != GST_H264_PARSER_NO_NAL_END
+        && res != GST_H264_PARSER_BROKEN_DATA)
+      break;
+    n++;
+    if (res == GST_H264_PARSER_NO_NAL_END)
+      break;
+    offset = nalu.offset + nalu.size;
+  }
+
+  gst_h264_nal_parser_free (parser);
+
+  return n;
+}
+
+static guint
+split_h265 (const guint8 * data, gsize size)
+{
+  GstH265Parser *parser = gst_h265_parser_new ();
+  GstH265ParserResult res;
+  GstH265NalUnit nalu;
+  guint offset = 0, n = 0;
+
+  while (TRUE) {
+    res = gst_h265_parser_identify_nalu (parser, data, offset, size, &nalu);
+    if (res != GST_H265_PARSER_OK && res != GST_H265_PARSER_NO_NAL_END
+        && res != GST_H265_PARSER_BROKEN_DATA)
+      break;
+    n++;
+    if (res == GST_H265_PARSER_NO_NAL_END)
+      break;
+    offset = nalu.offset + nalu.size;
+  }
+
+  gst_h265_parser_free (parser);
+
+  return n;
+}
+
+static guint
+split_mpegvideo (const guint8 * data, gsize size)
+{
+  GstMpegVideoPacket packet;
+  guint offset = 0, n = 0;
+
+  while (gst_mpeg_video_parse (&packet, data, size, offset)) {
+    n++;
+    if (packet.size < 0)
+      break;
+    offset = packet.offset + packet.size;
+  }
+
+  return n;
+}
+
+static guint
+split_mpeg4 (const guint8 * data, gsize size)
+{
+  GstMpeg4Packet packet;
+  guint offset = 0, n = 0;
+
+  while (offset + 4 < size && gst_mpeg4_parse (&packet, FALSE, NULL, data,
+          offset, size) == GST_MPEG4_PARSER_OK) {
+    n++;
+    offset = packet.offset + packet.size;
+  }
+
+  return n;
+}
+
+static gboolean
+scan_file (const gchar * location, guint (*split) (const guint8 *, gsize))
+{
+  GError *err = NULL;
+  gchar *contents;
+  gsize size;
+  gint64 start, elapsed;
+  guint packets = 0;
+  gint i;
+
+  if (!g_file_get_contents (location, &contents, &size, &err)) {
+    g_printerr ("%s: %s\n", location, err->message);
+    g_clear_error (&err);
+    return FALSE;
+  }
+
+  /* once to warm up the caches */
+  split ((const guint8 *) contents, size);
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++)
+    packets = split ((const guint8 *) contents, size);
+  elapsed = MAX (g_get_monotonic_time () - start, 1);
+
+  g_print ("%s: %" G_GSIZE_FORMAT " bytes, %u packets, %.2f ms per pass, "
+      "%.1f MB/s (%.0f Mbit/s)\n", location, size, packets,
+      elapsed / 1000.0 / iterations,
+      (gdouble) size * iterations / elapsed,
+      (gdouble) size * 8 * iterations / elapsed);
+
+  g_free (contents);
+
+  return TRUE;
+}
+
+int
+main (int argc, gchar ** argv)
+{
+  GOptionContext *ctx;
+  GError *error = NULL;
+  guint (*split) (const guint8 *, gsize);
+  gint i, failed = 0;
+
+  ctx = g_option_context_new ("FILE... - measure start code scanning speed");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("Error initializing: %s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (argc < 2 || iterations < 1) {
+    g_printerr ("Usage: %s [--codec CODEC] [--iterations N] FILE...\n",
+        argv[0]);
+    return 1;
+  }
+
+  if (!codec || g_str_equal (codec, "h264")) {
+    split = split_h264;
+  } else if (g_str_equal (codec, "h265")) {
+    split = split_h265;
+  } else if (g_str_equal (codec, "mpegvideo")) {
+    split = split_mpegvideo;
+  } else if (g_str_equal (codec, "mpeg4")) {
+    split = split_mpeg4;
+  } else {
+    g_printerr ("Unknown codec %s\n", codec);
+    return 1;
+  }
+
+  for (i = 1; i < argc; i++) {
+    if (!scan_file (argv[i], split))
+      failed++;
+  }
+
+  g_free (codec);
+
+  return failed ? 1 : 0;
+}
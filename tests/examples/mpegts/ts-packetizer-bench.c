@@ -0,0 +1,290 @@
+/* GStreamer
+ *
+ * ts-packetizer-bench.c: micro-benchmark for the MPEG-TS packetizer
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Pushes a synthetic transport stream through tsparse, chunked in a few
+ * different ways, and reports the throughput of each scenario:
+ *
+ *  - aligned:   7 packets per buffer, as received from UDP
+ *  - unaligned: 1000 bytes per buffer, most packets straddle two buffers
+ *  - resync:    aligned, but with garbage regularly inserted between
+ *               packets, which exercises the sync byte scanning
+ *
+ * Run it against two builds of the plugin to compare packetizer versions.
+ *
+ * The sync byte scan itself is also timed in-process, with the scalar loop
+ * the packetizer used to run and with the vectorized one it runs now, which
+ * is shared with it through mpegtsscan.h, over the same input:
+ *
+ *  - no sync:   random data without any sync byte, the worst case
+ *  - resync:    the resync stream, finding every packet start
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#include "../../../gst/mpegtsdemux/mpegtsscan.h"
+
+#define TS_PACKET_SIZE 188
+#define STREAM_SIZE (16 * 1024 * 1024)
+#define GARBAGE_INTERVAL 100
+#define GARBAGE_SIZE 57
+
+static guint iterations = 8;
+
+static GOptionEntry entries[] = {
+  {"iterations", 'i', 0, G_OPTION_ARG_INT, &iterations,
+      "Number of times the generated stream is pushed", "N"},
+  {NULL}
+};
+
+static GByteArray *
+generate_stream (gboolean garbage)
+{
+  GByteArray *stream = g_byte_array_sized_new (STREAM_SIZE);
+  guint8 packet[TS_PACKET_SIZE];
+  guint8 junk[GARBAGE_SIZE];
+  guint n = 0, i;
+
+  memset (junk, 0xff, sizeof (junk));
+
+  while (stream->len + TS_PACKET_SIZE + GARBAGE_SIZE < STREAM_SIZE) {
+    packet[0] = 0x47;
+    packet[1] = 0x01;           /* PID 0x100 */
+    packet[2] = 0x00;
+    packet[3] = 0x10 | (n & 0x0f);      /* payload only, continuity */
+    for (i = 4; i < TS_PACKET_SIZE; i++)
+      packet[i] = g_random_int_range (0, 256);
+    g_byte_array_append (stream, packet, TS_PACKET_SIZE);
+
+    n++;
+
+    if (garbage && n % GARBAGE_INTERVAL == 0)
+      g_byte_array_append (stream, junk, GARBAGE_SIZE);
+  }
+
+  return stream;
+}
+
+/* Every chunk gets its own memory so that the adapter can never merge
+ * neighbouring buffers for free */
+static GPtrArray *
+split_stream (GByteArray * stream, gsize chunk_size)
+{
+  GPtrArray *chunks = g_ptr_array_new_with_free_func (
+      (GDestroyNotify) gst_buffer_unref);
+  gsize offset, size;
+
+  for (offset = 0; offset < stream->len; offset += size) {
+    size = MIN (chunk_size, stream->len - offset);
+    g_ptr_array_add (chunks,
+        gst_buffer_new_wrapped (g_memdup (stream->data + offset, size), size));
+  }
+
+  return chunks;
+}
+
+/* The sync scan of mpegtspacketizer before it was vectorized */
+static gsize
+scan_sync_scalar (const guint8 * data, gsize end, guint packet_size)
+{
+  gsize i;
+
+  for (i = 0; i < end; i++) {
+    if (data[i] == PACKET_SYNC_BYTE &&
+        data[i + packet_size] == PACKET_SYNC_BYTE &&
+        data[i + 2 * packet_size] == PACKET_SYNC_BYTE)
+      return i;
+  }
+
+  return end;
+}
+
+typedef gsize (*ScanSyncFunc) (const guint8 * data, gsize end,
+    guint packet_size);
+
+/* Finds every sync position of @stream, like repeated resyncs would, and
+ * returns how many there are */
+static guint
+time_scan (ScanSyncFunc scan, GByteArray * stream, gint64 * elapsed)
+{
+  gsize end = stream->len - 2 * TS_PACKET_SIZE;
+  gsize pos;
+  gint64 start;
+  guint found = 0, i;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++) {
+    found = 0;
+    for (pos = 0; pos < end; pos++) {
+      pos += scan (stream->data + pos, end - pos, TS_PACKET_SIZE);
+      if (pos < end)
+        found++;
+    }
+  }
+  *elapsed = g_get_monotonic_time () - start;
+
+  return found;
+}
+
+static void
+run_scan_scenario (const gchar * name, GByteArray * stream)
+{
+  gint64 scalar_elapsed, vector_elapsed;
+  guint scalar_found, vector_found;
+
+  scalar_found = time_scan (scan_sync_scalar, stream, &scalar_elapsed);
+  vector_found =
+      time_scan (mpegts_packetizer_scan_sync, stream, &vector_elapsed);
+
+  if (scalar_found != vector_found)
+    g_printerr ("%s: scalar scan found %u syncs, vectorized scan %u\n", name,
+        scalar_found, vector_found);
+
+  g_print ("%-10s %6u syncs/pass    scalar %8.2f ms  %8.1f MB/s  "
+      "vectorized %8.2f ms  %8.1f MB/s  (x%.2f)\n", name, vector_found,
+      scalar_elapsed / 1000.0,
+      (gdouble) stream->len * iterations / MAX (scalar_elapsed, 1),
+      vector_elapsed / 1000.0,
+      (gdouble) stream->len * iterations / MAX (vector_elapsed, 1),
+      (gdouble) scalar_elapsed / MAX (vector_elapsed, 1));
+}
+
+static GByteArray *
+generate_noise (void)
+{
+  GByteArray *stream = g_byte_array_sized_new (STREAM_SIZE);
+  guint8 byte;
+  guint i;
+
+  for (i = 0; i < STREAM_SIZE; i++) {
+    byte = g_random_int_range (0, 256);
+    if (byte == PACKET_SYNC_BYTE)
+      byte++;
+    g_byte_array_append (stream, &byte, 1);
+  }
+
+  return stream;
+}
+
+static void
+run_scenario (const gchar * name, GPtrArray * chunks, gsize stream_size)
+{
+  GstElement *pipeline, *tsparse, *sink;
+  GstPad *srcpad, *sinkpad;
+  GstSegment segment;
+  gint64 start, elapsed;
+  guint i, j;
+
+  pipeline = gst_pipeline_new (NULL);
+  tsparse = gst_element_factory_make ("tsparse", NULL);
+  sink = gst_element_factory_make ("fakesink", NULL);
+  if (!tsparse || !sink) {
+    g_printerr ("Could not create tsparse and fakesink\n");
+    return;
+  }
+  g_object_set (sink, "sync", FALSE, "async", FALSE, NULL);
+
+  gst_bin_add_many (GST_BIN (pipeline), tsparse, sink, NULL);
+  gst_element_link (tsparse, sink);
+
+  srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  sinkpad = gst_element_get_static_pad (tsparse, "sink");
+  gst_pad_link (srcpad, sinkpad);
+  gst_object_unref (sinkpad);
+  gst_pad_set_active (srcpad, TRUE);
+
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("ts-bench"));
+  gst_pad_push_event (srcpad,
+      gst_event_new_caps (gst_caps_from_string
+          ("video/mpegts, systemstream=(boolean)true")));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < iterations; i++) {
+    for (j = 0; j < chunks->len; j++)
+      gst_pad_push (srcpad, gst_buffer_ref (g_ptr_array_index (chunks, j)));
+  }
+  elapsed = g_get_monotonic_time () - start;
+
+  gst_pad_push_event (srcpad, gst_event_new_eos ());
+
+  g_print ("%-10s %6u buffers/pass  %8.2f ms  %8.1f MB/s\n", name,
+      chunks->len, elapsed / 1000.0,
+      (gdouble) stream_size * iterations / MAX (elapsed, 1));
+
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_pad_set_active (srcpad, FALSE);
+  gst_object_unref (srcpad);
+  gst_object_unref (pipeline);
+}
+
+int
+main (int argc, gchar ** argv)
+{
+  GOptionContext *ctx;
+  GError *error = NULL;
+  GByteArray *stream;
+  GPtrArray *chunks;
+
+  ctx = g_option_context_new ("- MPEG-TS packetizer benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("Error initializing: %s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  stream = generate_stream (FALSE);
+
+  chunks = split_stream (stream, 7 * TS_PACKET_SIZE);
+  run_scenario ("aligned", chunks, stream->len);
+  g_ptr_array_unref (chunks);
+
+  chunks = split_stream (stream, 1000);
+  run_scenario ("unaligned", chunks, stream->len);
+  g_ptr_array_unref (chunks);
+
+  g_byte_array_unref (stream);
+
+  stream = generate_stream (TRUE);
+  chunks = split_stream (stream, 7 * TS_PACKET_SIZE);
+  run_scenario ("resync", chunks, stream->len);
+  g_ptr_array_unref (chunks);
+
+  g_print ("\nsync scan:\n");
+  run_scan_scenario ("resync", stream);
+  g_byte_array_unref (stream);
+
+  stream = generate_noise ();
+  run_scan_scenario ("no sync", stream);
+  g_byte_array_unref (stream);
+
+  return 0;
+}
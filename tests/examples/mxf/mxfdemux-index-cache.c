@@ -0,0 +1,140 @@
+/* GStreamer
+ *
+ * mxfdemux-index-cache.c: prepare the mxfdemux index cache for files
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Reads every file once through mxfdemux with the index-cache-directory
+ * property set, which leaves an index cache for each of them behind. Later
+ * playback of the files with the same cache directory can then seek
+ * without scanning the files.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+
+static gchar *cache_directory = NULL;
+
+static GOptionEntry entries[] = {
+  {"cache-directory", 'd', 0, G_OPTION_ARG_FILENAME, &cache_directory,
+      "Directory to store the index caches in", "DIR"},
+  {NULL}
+};
+
+static void
+on_pad_added (GstElement * demux, GstPad * pad, GstBin * pipeline)
+{
+  GstElement *sink = gst_element_factory_make ("fakesink", NULL);
+  GstPad *sinkpad;
+
+  g_object_set (sink, "sync", FALSE, NULL);
+  gst_bin_add (pipeline, sink);
+  sinkpad = gst_element_get_static_pad (sink, "sink");
+  gst_pad_link (pad, sinkpad);
+  gst_object_unref (sinkpad);
+  gst_element_sync_state_with_parent (sink);
+}
+
+static gboolean
+prepare_index_cache (const gchar * location)
+{
+  GstElement *pipeline, *src, *demux;
+  GstBus *bus;
+  GstMessage *msg;
+  gboolean ret = FALSE;
+  gint64 start;
+
+  pipeline = gst_pipeline_new (NULL);
+  src = gst_element_factory_make ("filesrc", NULL);
+  demux = gst_element_factory_make ("mxfdemux", NULL);
+  if (!src || !demux) {
+    g_printerr ("Could not create filesrc and mxfdemux\n");
+    gst_object_unref (pipeline);
+    return FALSE;
+  }
+
+  g_object_set (src, "location", location, NULL);
+  g_object_set (demux, "index-cache-directory", cache_directory, NULL);
+  g_signal_connect (demux, "pad-added", G_CALLBACK (on_pad_added), pipeline);
+
+  gst_bin_add_many (GST_BIN (pipeline), src, demux, NULL);
+  gst_element_link (src, demux);
+
+  start = g_get_monotonic_time ();
+  gst_element_set_state (pipeline, GST_STATE_PLAYING);
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_ERROR) {
+    GError *err = NULL;
+
+    gst_message_parse_error (msg, &err, NULL);
+    g_printerr ("%s: %s\n", location, err->message);
+    g_clear_error (&err);
+  } else {
+    ret = TRUE;
+  }
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  /* The cache is written when the demuxer is stopped */
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (pipeline);
+
+  if (ret)
+    g_print ("%s: indexed in %.2f s\n", location,
+        (g_get_monotonic_time () - start) / (gdouble) G_USEC_PER_SEC);
+
+  return ret;
+}
+
+int
+main (int argc, gchar ** argv)
+{
+  GOptionContext *ctx;
+  GError *error = NULL;
+  gint i, failed = 0;
+
+  ctx = g_option_context_new ("FILE... - prepare mxfdemux index caches");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("Error initializing: %s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (!cache_directory || argc < 2) {
+    g_printerr ("Usage: %s --cache-directory DIR FILE...\n", argv[0]);
+    return 1;
+  }
+
+  for (i = 1; i < argc; i++) {
+    if (!prepare_index_cache (argv[i]))
+      failed++;
+  }
+
+  g_free (cache_directory);
+
+  return failed ? 1 : 0;
+}
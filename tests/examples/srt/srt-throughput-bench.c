@@ -0,0 +1,242 @@
+/* GStreamer
+ *
+ * srt-throughput-bench.c: loopback throughput benchmark for srtsink/srtsrc
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Sends 1316 byte messages from srtsink to srtsrc over the loopback
+ * interface and reports the throughput seen by the receiver, together with
+ * how the received messages were grouped into buffer lists.
+ *
+ * The messages are pushed into srtsink in buffer lists of --list-size
+ * buffers, a size of 1 pushes plain buffers instead.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+
+#define MESSAGE_SIZE 1316
+
+static guint num_messages = 100000;
+static guint list_size = 32;
+static guint port = 7005;
+
+static GOptionEntry entries[] = {
+  {"messages", 'n', 0, G_OPTION_ARG_INT, &num_messages,
+      "Number of messages to send", "N"},
+  {"list-size", 'l', 0, G_OPTION_ARG_INT, &list_size,
+      "Number of messages per buffer list pushed into srtsink", "N"},
+  {"port", 'p', 0, G_OPTION_ARG_INT, &port, "Loopback port to use", "PORT"},
+  {NULL}
+};
+
+typedef struct
+{
+  GMutex lock;
+  guint64 bytes;
+  guint messages;
+  guint lists;
+  gint64 first_time;
+  gint64 last_time;
+} ReceiveStats;
+
+static void
+count_buffer (ReceiveStats * stats, GstBuffer * buffer)
+{
+  stats->bytes += gst_buffer_get_size (buffer);
+  stats->messages++;
+}
+
+static GstPadProbeReturn
+receive_probe (GstPad * pad, GstPadProbeInfo * info, ReceiveStats * stats)
+{
+  g_mutex_lock (&stats->lock);
+  if (stats->messages == 0)
+    stats->first_time = g_get_monotonic_time ();
+
+  if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST) {
+    GstBufferList *list = GST_PAD_PROBE_INFO_BUFFER_LIST (info);
+    guint i, len = gst_buffer_list_length (list);
+
+    for (i = 0; i < len; i++)
+      count_buffer (stats, gst_buffer_list_get (list, i));
+    stats->lists++;
+  } else {
+    count_buffer (stats, GST_PAD_PROBE_INFO_BUFFER (info));
+  }
+
+  stats->last_time = g_get_monotonic_time ();
+  g_mutex_unlock (&stats->lock);
+
+  return GST_PAD_PROBE_OK;
+}
+
+static GstBuffer *
+make_message (guint n)
+{
+  GstBuffer *buffer = gst_buffer_new_allocate (NULL, MESSAGE_SIZE, NULL);
+  GstMapInfo map;
+
+  gst_buffer_map (buffer, &map, GST_MAP_WRITE);
+  memset (map.data, n & 0xff, map.size);
+  gst_buffer_unmap (buffer, &map);
+
+  return buffer;
+}
+
+static gboolean
+send_messages (GstPad * srcpad)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint sent = 0;
+
+  while (sent < num_messages && ret == GST_FLOW_OK) {
+    if (list_size <= 1) {
+      ret = gst_pad_push (srcpad, make_message (sent));
+      sent++;
+    } else {
+      GstBufferList *list = gst_buffer_list_new_sized (list_size);
+
+      while (gst_buffer_list_length (list) < list_size && sent < num_messages)
+        gst_buffer_list_add (list, make_message (sent++));
+
+      ret = gst_pad_push_list (srcpad, list);
+    }
+  }
+
+  if (ret != GST_FLOW_OK) {
+    g_printerr ("Sending failed after %u messages: %s\n", sent,
+        gst_flow_get_name (ret));
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+int
+main (int argc, gchar ** argv)
+{
+  GOptionContext *ctx;
+  GError *error = NULL;
+  GstElement *receiver, *sender, *srtsink, *fakesink;
+  GstPad *srcpad, *sinkpad;
+  ReceiveStats stats = { {0}, };
+  GstSegment segment;
+  gchar *desc, *uri;
+  gint64 elapsed;
+  guint waited;
+
+  ctx = g_option_context_new ("- SRT loopback throughput benchmark");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &error)) {
+    g_printerr ("Error initializing: %s\n", error->message);
+    g_clear_error (&error);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  g_mutex_init (&stats.lock);
+
+  desc = g_strdup_printf ("srtsrc uri=srt://127.0.0.1:%u?mode=listener ! "
+      "fakesink name=sink sync=false async=false", port);
+  receiver = gst_parse_launch (desc, &error);
+  g_free (desc);
+  if (!receiver) {
+    g_printerr ("Could not create the receiver: %s\n", error->message);
+    g_clear_error (&error);
+    return 1;
+  }
+
+  fakesink = gst_bin_get_by_name (GST_BIN (receiver), "sink");
+  sinkpad = gst_element_get_static_pad (fakesink, "sink");
+  gst_pad_add_probe (sinkpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      (GstPadProbeCallback) receive_probe, &stats, NULL);
+  gst_object_unref (sinkpad);
+  gst_object_unref (fakesink);
+
+  gst_element_set_state (receiver, GST_STATE_PLAYING);
+
+  sender = gst_pipeline_new (NULL);
+  srtsink = gst_element_factory_make ("srtsink", NULL);
+  if (!srtsink) {
+    g_printerr ("Could not create srtsink\n");
+    return 1;
+  }
+  uri = g_strdup_printf ("srt://127.0.0.1:%u", port);
+  g_object_set (srtsink, "uri", uri, "sync", FALSE, "async", FALSE, NULL);
+  g_free (uri);
+  gst_bin_add (GST_BIN (sender), srtsink);
+
+  srcpad = gst_pad_new ("src", GST_PAD_SRC);
+  sinkpad = gst_element_get_static_pad (srtsink, "sink");
+  gst_pad_link (srcpad, sinkpad);
+  gst_object_unref (sinkpad);
+  gst_pad_set_active (srcpad, TRUE);
+
+  if (gst_element_set_state (sender,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+    g_printerr ("Could not connect to the receiver\n");
+    return 1;
+  }
+
+  gst_pad_push_event (srcpad, gst_event_new_stream_start ("srt-bench"));
+  gst_pad_push_event (srcpad,
+      gst_event_new_caps (gst_caps_new_empty_simple ("video/mpegts")));
+  gst_segment_init (&segment, GST_FORMAT_BYTES);
+  gst_pad_push_event (srcpad, gst_event_new_segment (&segment));
+
+  send_messages (srcpad);
+
+  /* give the receiver some time to get the tail of the stream */
+  for (waited = 0; waited < 200; waited++) {
+    guint received;
+
+    g_mutex_lock (&stats.lock);
+    received = stats.messages;
+    g_mutex_unlock (&stats.lock);
+
+    if (received >= num_messages)
+      break;
+    g_usleep (10 * G_TIME_SPAN_MILLISECOND);
+  }
+
+  g_mutex_lock (&stats.lock);
+  elapsed = stats.last_time - stats.first_time;
+  g_print ("list size %u: received %u/%u messages, %u lists "
+      "(%.1f messages/list), %.2f ms, %.1f Mbit/s\n", list_size,
+      stats.messages, num_messages, stats.lists,
+      stats.lists ? (gdouble) stats.messages / stats.lists : 0.0,
+      elapsed / 1000.0, stats.bytes * 8.0 / MAX (elapsed, 1));
+  g_mutex_unlock (&stats.lock);
+
+  gst_element_set_state (sender, GST_STATE_NULL);
+  gst_element_set_state (receiver, GST_STATE_NULL);
+  gst_pad_set_active (srcpad, FALSE);
+  gst_object_unref (srcpad);
+  gst_object_unref (sender);
+  gst_object_unref (receiver);
+  g_mutex_clear (&stats.lock);
+
+  return 0;
+}